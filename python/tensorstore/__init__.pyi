@@ -5557,6 +5557,7 @@ class KvStore:
               >>> spec.to_json(include_defaults=True)
               {'context': {},
                'driver': 'file',
+               'file_io_batch_read_coalescing': 'file_io_batch_read_coalescing',
                'file_io_concurrency': 'file_io_concurrency',
                'file_io_locking': 'file_io_locking',
                'file_io_mode': 'file_io_mode',
@@ -5818,6 +5819,7 @@ class KvStore:
             >>> store + '/abc'
             KvStore({
               'context': {
+                'file_io_batch_read_coalescing': {},
                 'file_io_concurrency': {},
                 'file_io_locking': {},
                 'file_io_mode': {},
@@ -5829,6 +5831,7 @@ class KvStore:
             >>> store + 'abc'
             KvStore({
               'context': {
+                'file_io_batch_read_coalescing': {},
                 'file_io_concurrency': {},
                 'file_io_locking': {},
                 'file_io_mode': {},
@@ -5989,6 +5992,7 @@ class KvStore:
             >>> kvstore
             KvStore({
               'context': {
+                'file_io_batch_read_coalescing': {},
                 'file_io_concurrency': {},
                 'file_io_locking': {},
                 'file_io_mode': {},
@@ -6064,6 +6068,7 @@ class KvStore:
             >>> store / 'abc'
             KvStore({
               'context': {
+                'file_io_batch_read_coalescing': {},
                 'file_io_concurrency': {},
                 'file_io_locking': {},
                 'file_io_mode': {},
@@ -6075,6 +6080,7 @@ class KvStore:
             >>> store / '/abc'
             KvStore({
               'context': {
+                'file_io_batch_read_coalescing': {},
                 'file_io_concurrency': {},
                 'file_io_locking': {},
                 'file_io_mode': {},
@@ -6100,6 +6106,7 @@ class KvStore:
           >>> a
           KvStore({
             'context': {
+              'file_io_batch_read_coalescing': {},
               'file_io_concurrency': {},
               'file_io_locking': {},
               'file_io_mode': {},
@@ -6111,6 +6118,7 @@ class KvStore:
           >>> b
           KvStore({
             'context': {
+              'file_io_batch_read_coalescing': {},
               'file_io_concurrency': {},
               'file_io_locking': {},
               'file_io_mode': {},
@@ -9944,6 +9952,48 @@ class TensorStore(Indexable):
 
     def __copy__(self) -> typing.Any: ...
 
+    def __dlpack__(self, **kwargs) -> typing.Any:
+        """
+        Exports the data within the current domain as a DLPack capsule.
+
+        *Synchronously* reads from the current domain, like :py:obj:`.__array__`, and
+        exports the newly-allocated result without copying, for interoperability with
+        frameworks that support the `DLPack <https://dmlc.github.io/dlpack/latest/>`__
+        protocol:
+
+            >>> dataset = await ts.open(
+            ...     {
+            ...         'driver': 'zarr',
+            ...         'kvstore': {
+            ...             'driver': 'memory'
+            ...         }
+            ...     },
+            ...     dtype=ts.uint32,
+            ...     shape=[70, 80],
+            ...     create=True)
+            >>> np.from_dlpack(dataset[5:7, 8:12])
+            array([[0, 0, 0, 0],
+                   [0, 0, 0, 0]], dtype=uint32)
+
+        Arrays returned by :py:obj:`.read` are :py:obj:`numpy.ndarray` objects, which
+        also support the DLPack protocol directly.
+
+        Only numeric data types may be exported.  The keyword arguments defined by the
+        DLPack protocol, such as :python:`stream` and :python:`max_version`, are
+        forwarded to :py:obj:`numpy.ndarray.__dlpack__`.
+
+        Group:
+          I/O
+        """
+
+    def __dlpack_device__(self) -> tuple[int, int]:
+        """
+        Returns the DLPack device of arrays exported by :py:obj:`.__dlpack__`.
+
+        Group:
+          I/O
+        """
+
     @typing.overload
     def __getitem__(self, transform: IndexTransform) -> TensorStore:
         """
@@ -10526,7 +10576,11 @@ class TensorStore(Indexable):
         """
 
     def read(
-        self, *, order: typing.Literal["C", "F"] = "C", batch: Batch | None = None
+        self,
+        *,
+        order: typing.Literal["C", "F"] = "C",
+        batch: Batch | None = None,
+        out: numpy.typing.ArrayLike | None = None,
     ) -> Future[numpy.ndarray]:
         """
         Reads the data within the current domain.
@@ -10571,6 +10625,8 @@ class TensorStore(Indexable):
             :python:`'F'`
               Specifies Fortran order, i.e. colexicographic/column-major order.
 
+            Ignored if :python:`out` is specified.
+
           batch: Batch to use for the read operation.
 
             .. warning::
@@ -10579,8 +10635,22 @@ class TensorStore(Indexable):
                ready until the batch is submitted.  Therefore, immediately awaiting the
                returned future will lead to deadlock.
 
+          out: Existing writable array into which the data is read, instead of
+            allocating a new array.  May be a :py:obj:`numpy.ndarray` or any object
+            supporting the writable buffer protocol, with a shape matching
+            :python:`self.shape` and a data type to which :python:`self.dtype` can be
+            converted.  The memory must not be modified or released until the returned
+            future becomes ready.
+
+            >>> out = np.zeros([5, 4], dtype=np.uint32)
+            >>> result = await dataset[5:10, 8:12].read(out=out)
+            >>> np.shares_memory(result, out)
+            True
+
         Returns:
-          A future representing the asynchronous read result.
+          A future representing the asynchronous read result.  If :python:`out` is
+          specified, the result is an array that refers to the same memory as
+          :python:`out`.
 
         .. tip::
 
@@ -13043,7 +13113,9 @@ def open(
           'context': {
             'cache_pool': {},
             'data_copy_concurrency': {},
+            'gcs_batch_read_coalescing': {},
             'gcs_request_concurrency': {},
+            'gcs_request_hedging': {},
             'gcs_request_retries': {},
             'gcs_user_project': {},
           },
@@ -378,6 +378,7 @@ Example:
     >>> store + '/abc'
     KvStore({
       'context': {
+        'file_io_batch_read_coalescing': {},
         'file_io_concurrency': {},
         'file_io_locking': {},
         'file_io_mode': {},
@@ -389,6 +390,7 @@ Example:
     >>> store + 'abc'
     KvStore({
       'context': {
+        'file_io_batch_read_coalescing': {},
         'file_io_concurrency': {},
         'file_io_locking': {},
         'file_io_mode': {},
@@ -421,6 +423,7 @@ Example:
     >>> store / 'abc'
     KvStore({
       'context': {
+        'file_io_batch_read_coalescing': {},
         'file_io_concurrency': {},
         'file_io_locking': {},
         'file_io_mode': {},
@@ -432,6 +435,7 @@ Example:
     >>> store / '/abc'
     KvStore({
       'context': {
+        'file_io_batch_read_coalescing': {},
         'file_io_concurrency': {},
         'file_io_locking': {},
         'file_io_mode': {},
@@ -1256,6 +1260,7 @@ Example:
     >>> kvstore
     KvStore({
       'context': {
+        'file_io_batch_read_coalescing': {},
         'file_io_concurrency': {},
         'file_io_locking': {},
         'file_io_mode': {},
@@ -1284,6 +1289,7 @@ Example:
   >>> a
   KvStore({
     'context': {
+      'file_io_batch_read_coalescing': {},
       'file_io_concurrency': {},
       'file_io_locking': {},
       'file_io_mode': {},
@@ -1295,6 +1301,7 @@ Example:
   >>> b
   KvStore({
     'context': {
+      'file_io_batch_read_coalescing': {},
       'file_io_concurrency': {},
       'file_io_locking': {},
       'file_io_mode': {},
@@ -1521,6 +1528,7 @@ Example:
   >>> spec.to_json(include_defaults=True)
   {'context': {},
    'driver': 'file',
+   'file_io_batch_read_coalescing': 'file_io_batch_read_coalescing',
    'file_io_concurrency': 'file_io_concurrency',
    'file_io_locking': 'file_io_locking',
    'file_io_mode': 'file_io_mode',
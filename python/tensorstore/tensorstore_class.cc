@@ -23,6 +23,7 @@
 // Other headers
 #include <optional>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -81,6 +82,7 @@
 #include "tensorstore/transaction.h"
 #include "tensorstore/util/executor.h"
 #include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
 #include "tensorstore/util/unit.h"
 
 // specializations
@@ -485,12 +487,32 @@ Group:
 
   cls.def(
       "read",
-      [](Self& self, ContiguousLayoutOrder order,
-         std::optional<Batch> batch) -> PythonFutureWrapper<SharedArray<void>> {
+      [](Self& self, ContiguousLayoutOrder order, std::optional<Batch> batch,
+         std::optional<ArrayArgumentPlaceholder> out)
+          -> PythonFutureWrapper<SharedArray<void>> {
+        if (!out) {
+          return PythonFutureWrapper<SharedArray<void>>(
+              tensorstore::Read<zero_origin>(
+                  self.value, order,
+                  internal_python::ValidateOptionalBatch(std::move(batch))),
+              self.reference_manager());
+        }
+        // Refers directly to the memory of `out`, which must be writable.
+        SharedArray<void> target;
+        ConvertToArray<void, dynamic_rank, /*nothrow=*/false,
+                       /*AllowCopy=*/false>(out->value, &target);
+        auto future = tensorstore::Read(
+            self.value, target,
+            internal_python::ValidateOptionalBatch(std::move(batch)));
         return PythonFutureWrapper<SharedArray<void>>(
-            tensorstore::Read<zero_origin>(
-                self.value, order,
-                internal_python::ValidateOptionalBatch(std::move(batch))),
+            MapFuture(
+                InlineExecutor{},
+                [target = std::move(target)](const Result<void>& result)
+                    -> Result<SharedArray<void>> {
+                  if (!result.ok()) return result.status();
+                  return target;
+                },
+                std::move(future)),
             self.reference_manager());
       },
       R"(
@@ -536,6 +558,8 @@ Args:
     :python:`'F'`
       Specifies Fortran order, i.e. colexicographic/column-major order.
 
+    Ignored if :python:`out` is specified.
+
   batch: Batch to use for the read operation.
 
     .. warning::
@@ -544,8 +568,22 @@ Args:
        ready until the batch is submitted.  Therefore, immediately awaiting the
        returned future will lead to deadlock.
 
+  out: Existing writable array into which the data is read, instead of
+    allocating a new array.  May be a :py:obj:`numpy.ndarray` or any object
+    supporting the writable buffer protocol, with a shape matching
+    :python:`self.shape` and a data type to which :python:`self.dtype` can be
+    converted.  The memory must not be modified or released until the returned
+    future becomes ready.
+
+    >>> out = np.zeros([5, 4], dtype=np.uint32)
+    >>> result = await dataset[5:10, 8:12].read(out=out)
+    >>> np.shares_memory(result, out)
+    True
+
 Returns:
-  A future representing the asynchronous read result.
+  A future representing the asynchronous read result.  If :python:`out` is
+  specified, the result is an array that refers to the same memory as
+  :python:`out`.
 
 .. tip::
 
@@ -567,7 +605,8 @@ Group:
   I/O
 
 )",
-      py::kw_only(), py::arg("order") = "C", py::arg("batch") = std::nullopt);
+      py::kw_only(), py::arg("order") = "C", py::arg("batch") = std::nullopt,
+      py::arg("out") = std::nullopt);
 
   ForwardWriteSetters([&](auto... param_def) {
     std::string doc = R"(
@@ -926,6 +965,63 @@ Group:
       py::arg("dtype") = std::nullopt, py::arg("copy") = std::nullopt,
       py::arg("context") = std::nullopt);
 
+  cls.def(
+      "__dlpack__",
+      [](Self& self, py::kwargs kwargs) {
+        auto array = ValueOrThrow(internal_python::InterruptibleWait(
+            tensorstore::Read<zero_origin>(self.value)));
+        // The newly-allocated array is exported without a further copy.
+        return GetNumpyArray(array).attr("__dlpack__")(**kwargs);
+      },
+      R"(
+Exports the data within the current domain as a DLPack capsule.
+
+*Synchronously* reads from the current domain, like :py:obj:`.__array__`, and
+exports the newly-allocated result without copying, for interoperability with
+frameworks that support the `DLPack <https://dmlc.github.io/dlpack/latest/>`__
+protocol:
+
+    >>> dataset = await ts.open(
+    ...     {
+    ...         'driver': 'zarr',
+    ...         'kvstore': {
+    ...             'driver': 'memory'
+    ...         }
+    ...     },
+    ...     dtype=ts.uint32,
+    ...     shape=[70, 80],
+    ...     create=True)
+    >>> np.from_dlpack(dataset[5:7, 8:12])
+    array([[0, 0, 0, 0],
+           [0, 0, 0, 0]], dtype=uint32)
+
+Arrays returned by :py:obj:`.read` are :py:obj:`numpy.ndarray` objects, which
+also support the DLPack protocol directly.
+
+Only numeric data types may be exported.  The keyword arguments defined by the
+DLPack protocol, such as :python:`stream` and :python:`max_version`, are
+forwarded to :py:obj:`numpy.ndarray.__dlpack__`.
+
+Group:
+  I/O
+
+)");
+
+  cls.def(
+      "__dlpack_device__",
+      [](Self& self) -> std::tuple<int, int> {
+        // Data is always read into host memory, i.e. `kDLCPU`.
+        constexpr int kDLCPU = 1;
+        return {kDLCPU, 0};
+      },
+      R"(
+Returns the DLPack device of arrays exported by :py:obj:`.__dlpack__`.
+
+Group:
+  I/O
+
+)");
+
   cls.def(
       "resolve",
       [](Self& self, bool fix_resizable_bounds,
@@ -2452,7 +2548,9 @@ like the data type, domain, and chunk layout, may be omitted:
       'context': {
         'cache_pool': {},
         'data_copy_concurrency': {},
+        'gcs_batch_read_coalescing': {},
         'gcs_request_concurrency': {},
+        'gcs_request_hedging': {},
         'gcs_request_retries': {},
         'gcs_user_project': {},
       },
@@ -628,6 +628,56 @@ async def test_zero_copy(writable: bool) -> None:
   np.testing.assert_equal(43, await store.read())
 
 
+async def test_read_out() -> None:
+  store = await ts.open(
+      {"driver": "zarr3", "kvstore": "memory://"},
+      dtype=ts.uint32,
+      shape=[4, 5],
+      create=True,
+  )
+  await store.write(np.arange(20, dtype=np.uint32).reshape(4, 5))
+
+  out = np.zeros([4, 5], dtype=np.uint32)
+  result = await store.read(out=out)
+  assert np.shares_memory(result, out)
+  np.testing.assert_equal(np.arange(20).reshape(4, 5), out)
+
+  # Non-contiguous output and data type conversion.
+  out = np.zeros([5, 4], dtype=np.int64).T
+  await store.read(out=out)
+  np.testing.assert_equal(np.arange(20).reshape(4, 5), out)
+
+  # Buffer protocol objects are written in place.
+  buf = bytearray(5)
+  await store[1].astype(ts.uint8).read(out=buf)
+  assert buf == bytearray([5, 6, 7, 8, 9])
+
+  with pytest.raises(ValueError):
+    await store.read(out=np.zeros([4, 6], dtype=np.uint32))
+
+  readonly = np.zeros([4, 5], dtype=np.uint32)
+  readonly.setflags(write=False)
+  with pytest.raises(ValueError):
+    await store.read(out=readonly)
+
+
+async def test_dlpack() -> None:
+  store = await ts.open(
+      {"driver": "zarr3", "kvstore": "memory://"},
+      dtype=ts.uint16,
+      shape=[3, 4],
+      create=True,
+  )
+  await store.write(np.arange(12, dtype=np.uint16).reshape(3, 4))
+  assert store.__dlpack_device__() == (1, 0)
+  np.testing.assert_equal(
+      np.arange(12).reshape(3, 4)[1:], np.from_dlpack(store[1:])
+  )
+  np.testing.assert_equal(
+      np.arange(12).reshape(3, 4), np.from_dlpack(await store.read())
+  )
+
+
 def test_issue_168() -> None:
   t = ts.array(np.zeros((0,)))
   assert t.spec().to_json(include_defaults=False) == {
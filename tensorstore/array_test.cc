@@ -1047,6 +1047,27 @@ TEST(ArrayTest, Identical) {
           std::numeric_limits<float>::signaling_NaN())));
 }
 
+TEST(ArrayTest, CompareToBroadcastScalar) {
+  const auto fill_value = [](auto value) {
+    return BroadcastArray(MakeScalarArray(value),
+                          tensorstore::span<const Index>({2, 3}))
+        .value();
+  };
+  EXPECT_TRUE(MakeArrayView({{7, 7, 7}, {7, 7, 7}}) == fill_value(7));
+  EXPECT_FALSE(MakeArrayView({{1, 1, 1}, {1, 1, 1}}) == fill_value(7));
+  EXPECT_FALSE(MakeArrayView({{1, 7, 7}, {7, 7, 7}}) == fill_value(7));
+  EXPECT_FALSE(MakeArrayView({{7, 7, 7}, {7, 7, 1}}) == fill_value(7));
+
+  EXPECT_TRUE(MakeArrayView<float>({{0.0, -0.0, 0.0}, {0.0, 0.0, 0.0}}) ==
+              fill_value(0.0f));
+  EXPECT_FALSE(AreArraysIdenticallyEqual(
+      MakeArrayView<float>({{0.0, -0.0, 0.0}, {0.0, 0.0, 0.0}}),
+      fill_value(0.0f)));
+  EXPECT_TRUE(AreArraysIdenticallyEqual(
+      MakeArrayView<float>({{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}}),
+      fill_value(0.0f)));
+}
+
 TEST(ArrayTest, SharedArrayAccessors) {
   SharedArray<int, 2> array = MakeArray<int>({{1, 2, 3}, {4, 5, 6}});
   SharedArrayView<int, 2> view = array;
@@ -1098,6 +1098,22 @@ struct CompareToScalarImpl {
   ABSL_ATTRIBUTE_ALWAYS_INLINE bool operator()(const T* a, void* b) const {
     return CompareImpl{}(a, static_cast<T*>(b), nullptr);
   }
+
+#ifndef TENSORSTORE_DATA_TYPE_DISABLE_MEMCMP_OPTIMIZATION
+  // Checks whether a contiguous buffer is uniformly equal to the scalar, as is
+  // done for every chunk written back to determine if it is equal to the fill
+  // value.  All elements are equal to `*b` if, and only if, `a[0] == *b` and
+  // the buffer is equal to itself shifted by one element, which allows the
+  // comparison to be done by two `memcmp` calls rather than element by
+  // element.
+  template <size_t Size, size_t Alignment>
+  ABSL_ATTRIBUTE_ALWAYS_INLINE static bool ApplyContiguous(
+      Index count, const TrivialObj<Size, Alignment>* a, void* b) {
+    if (count == 0) return true;
+    return std::memcmp(a, b, Size) == 0 &&
+           std::memcmp(a, a + 1, Size * (count - 1)) == 0;
+  }
+#endif  // TENSORSTORE_DATA_TYPE_DISABLE_MEMCMP_OPTIMIZATION
 };
 
 /// Elementwise functions referenced by `DataTypeOperations`.
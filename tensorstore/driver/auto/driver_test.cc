@@ -127,6 +127,7 @@ TEST(AutoTest, UnbindContextSimple) {
                 {"memory_key_value_store", ::nlohmann::json::object_t()},
                 {"data_copy_concurrency", ::nlohmann::json::object_t()},
                 {"cache_pool", {{"total_bytes_limit", 1000}}},
+                {"file_io_batch_read_coalescing", ::nlohmann::json::object_t()},
                 {"file_io_concurrency", ::nlohmann::json::object_t()},
                 {"file_io_locking", ::nlohmann::json::object_t()},
                 {"file_io_mode", ::nlohmann::json::object_t()},
@@ -164,6 +165,7 @@ TEST(AutoTest, UnbindContext1) {
                 {"memory_key_value_store#1", ::nlohmann::json::object_t()},
                 {"data_copy_concurrency", ::nlohmann::json::object_t()},
                 {"cache_pool", {{"total_bytes_limit", 1000}}},
+                {"file_io_batch_read_coalescing", ::nlohmann::json::object_t()},
                 {"file_io_concurrency", ::nlohmann::json::object_t()},
                 {"file_io_locking", ::nlohmann::json::object_t()},
                 {"file_io_mode", ::nlohmann::json::object_t()},
@@ -36,6 +36,7 @@
 #include "tensorstore/internal/nditerable_util.h"
 #include "tensorstore/internal/tagged_ptr.h"
 #include "tensorstore/internal/tracing/operation_trace_span.h"
+#include "tensorstore/internal/tracing/trace_context.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/progress.h"
 #include "tensorstore/read_write_options.h"
@@ -356,6 +357,7 @@ WriteFutures DriverCopy(Executor executor, DriverHandle source,
       internal::ValidateSupportsWrite(target.driver.read_write_mode()))
       .BuildStatus();
   IntrusivePtr<CopyState> state(new CopyState);
+  internal_tracing::ScopedTraceContext trace_scope(state->tspan.context());
   state->executor = executor;
   TENSORSTORE_ASSIGN_OR_RETURN(
       state->data_type_conversion,
@@ -19,10 +19,12 @@
 #include <algorithm>
 #include <cassert>
 #include <mutex>
+#include <numeric>
 #include <utility>
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
@@ -56,11 +58,14 @@
 #include "tensorstore/index_space/index_transform_builder.h"
 #include "tensorstore/index_space/transformed_array.h"
 #include "tensorstore/internal/arena.h"
+#include "tensorstore/internal/grid_partition_iterator.h"
+#include "tensorstore/internal/integer_overflow.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/json_binding/std_array.h"
 #include "tensorstore/internal/lock_collection.h"
 #include "tensorstore/internal/nditerable_transformed_array.h"
+#include "tensorstore/internal/regular_grid.h"
 #include "tensorstore/json_serialization_options.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/spec.h"
@@ -165,10 +170,11 @@ class DownsampleDriverSpec
   TransformedDriverSpec base;
   std::vector<Index> downsample_factors;
   DownsampleMethod downsample_method;
+  bool streaming = false;
 
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
     return f(internal::BaseCast<internal::DriverSpec>(x), x.base,
-             x.downsample_factors, x.downsample_method);
+             x.downsample_factors, x.downsample_method, x.streaming);
   };
 
   absl::Status InitializeFromBase() {
@@ -243,6 +249,10 @@ class DownsampleDriverSpec
                 return obj->ValidateDownsampleMethod();
               },
               jb::Projection<&DownsampleDriverSpec::downsample_method>())),
+      jb::Member("streaming",
+                 jb::Projection<&DownsampleDriverSpec::streaming>(
+                     jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                         [](auto* v) { *v = false; }))),
       jb::Initialize([](auto* obj) {
         SpecOptions base_options;
         static_cast<Schema&>(base_options) = std::exchange(obj->schema, {});
@@ -330,7 +340,7 @@ class DownsampleDriverSpec
           TENSORSTORE_ASSIGN_OR_RETURN(
               auto downsampled_handle,
               MakeDownsampleDriver(std::move(handle), spec->downsample_factors,
-                                   spec->downsample_method));
+                                   spec->downsample_method, spec->streaming));
           // Validate the domain constraint specified by the schema, if any.
           // All other schema constraints are propagated to the base driver, and
           // therefore aren't checked here.
@@ -360,6 +370,7 @@ class DownsampleDriver
         base_driver_->GetBoundSpec(std::move(transaction), base_transform_));
     driver_spec->downsample_factors = downsample_factors_;
     driver_spec->downsample_method = downsample_method_;
+    driver_spec->streaming = streaming_;
     TENSORSTORE_RETURN_IF_ERROR(driver_spec->InitializeFromBase());
     TransformedDriverSpec spec;
     spec.transform = transform;
@@ -435,12 +446,14 @@ class DownsampleDriver
 
   explicit DownsampleDriver(DriverPtr base, IndexTransform<> base_transform,
                             tensorstore::span<const Index> downsample_factors,
-                            DownsampleMethod downsample_method)
+                            DownsampleMethod downsample_method,
+                            bool streaming)
       : base_driver_(std::move(base)),
         base_transform_(std::move(base_transform)),
         downsample_factors_(downsample_factors.begin(),
                             downsample_factors.end()),
-        downsample_method_(downsample_method) {}
+        downsample_method_(downsample_method),
+        streaming_(streaming) {}
 
   DataType dtype() override { return base_driver_->dtype(); }
   DimensionIndex rank() override { return base_transform_.input_rank(); }
@@ -459,13 +472,17 @@ class DownsampleDriver
 
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
     return f(x.base_driver_, x.base_transform_, x.downsample_factors_,
-             x.downsample_method_);
+             x.downsample_method_, x.streaming_);
   };
 
   DriverPtr base_driver_;
   IndexTransform<> base_transform_;
   std::vector<Index> downsample_factors_;
   DownsampleMethod downsample_method_;
+
+  /// Indicates that base chunks are not retained in the cache after they are
+  /// downsampled.
+  bool streaming_;
 };
 
 Future<IndexTransform<>> DownsampleDriver::ResolveBounds(
@@ -489,6 +506,44 @@ Future<IndexTransform<>> DownsampleDriver::ResolveBounds(
                                    std::move(request.options)}));
 }
 
+/// Target size in bytes of the cells in which `ReadState` buffers chunks that
+/// cannot be emitted independently.
+constexpr Index kTargetBufferCellBytes = Index{1} << 20;
+
+/// Computes the shape of the cells in which `ReadState` buffers chunks that
+/// cannot be emitted independently.
+///
+/// Each cell consists of whole downsample blocks, and is grown from a single
+/// block, cycling over the dimensions starting from the last, until it
+/// reaches approximately `kTargetBufferCellBytes` or covers `base_domain`.
+void GetBufferCellShape(BoxView<> base_domain,
+                        tensorstore::span<const Index> downsample_factors,
+                        Index element_size, tensorstore::span<Index> shape) {
+  const DimensionIndex rank = base_domain.rank();
+  assert(downsample_factors.size() == rank);
+  assert(shape.size() == rank);
+  element_size = std::max(Index{1}, element_size);
+  const Index target_elements =
+      std::max(Index{1}, kTargetBufferCellBytes / element_size);
+  Index num_elements = 1;
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    shape[i] = downsample_factors[i];
+    if (internal::MulOverflow(num_elements, shape[i], &num_elements)) {
+      num_elements = kInfIndex;
+    }
+  }
+  for (bool grew = true; grew;) {
+    grew = false;
+    for (DimensionIndex i = rank; i--;) {
+      if (num_elements > target_elements / 2) return;
+      if (shape[i] >= base_domain.shape()[i]) continue;
+      shape[i] *= 2;
+      num_elements *= 2;
+      grew = true;
+    }
+  }
+}
+
 /// Asynchronous operation state for `DownsampleDriver::Read`.
 ///
 /// Reading proceeds as follows:
@@ -514,32 +569,37 @@ Future<IndexTransform<>> DownsampleDriver::ResolveBounds(
 ///        All such chunks are recorded in the `independently_emitted_chunks_`
 ///        tracker in case not all chunks can be independently downsampled.
 ///
-///    4b. If the chunk cannot be independently downsampled, `data_buffer_` is
-///        allocated with a domain equal to the domain of the
-///        `base_request_transform` if it has not already been, and the chunk is
-///        copied to it (without downsampling yet).
+///    4b. If the chunk cannot be independently downsampled, it is partitioned
+///        by a regular grid of `buffer_cell_shape_` aligned to downsample
+///        block boundaries, and each piece is copied (without downsampling
+///        yet) to the `BufferCell` for its grid cell, which is allocated when
+///        first needed.
 ///
 ///    Ideally, we would either emit all chunks independently (4a) or copy all
-///    chunks to `data_buffer_` (4b).  Unfortunately, we receive chunks from the
+///    chunks to buffer cells (4b).  Unfortunately, we receive chunks from the
 ///    base driver as a stream and cannot know in advance whether it will be
 ///    possible to emit all of them independently.  For that reason, it is
 ///    necessary to record the bounds of all chunks emitted independently.
 ///
-/// 5. Once all chunks have been received from the `base_driver_`, if
-///    `data_buffer_` has been allocated:
+/// 5. Once every element of a buffer cell has been either copied to it or
+///    emitted independently, the cell is emitted and released:
 ///
-///    5a. If no chunks have been emitted independently, just emit a single
-///        downsampled view of the entire `data_buffer_`.
+///    5a. If no chunks overlapping the cell have been emitted independently,
+///        just emit a single downsampled view of the entire cell.
 ///
 ///    5b. If some chunks have been emitted independently, they need to be
 ///        excluded.  To do that, given that there is no guarantee that the
 ///        independently emitted chunks are in a regular grid, we divide the
-///        domain of `data_buffer_` into a non-regular grid, adding grid lines
-///        to each dimension as needed to include all chunk boundaries, and
-///        compute a `bool` array indicating which grid cells are covered by
-///        independently-emitted chunks.  Then for each non-covered grid cell,
-///        we emit a separate chunk that provides a downsampled view of that
-///        cell of `data_buffer_`.
+///        cell into a non-regular grid, adding grid lines to each dimension as
+///        needed to include all chunk boundaries, and compute a `bool` array
+///        indicating which grid cells are covered by independently-emitted
+///        chunks.  Then for each non-covered grid cell, we emit a separate
+///        chunk that provides a downsampled view of that part of the cell.
+///
+///    Because cells contain whole downsample blocks, each cell can be emitted
+///    as soon as the chunks covering it have been received, and the memory
+///    used for buffering is bounded by the cells that are partially received,
+///    rather than by the size of the entire request.
 struct ReadState : public internal::AtomicReferenceCount<ReadState> {
   IntrusivePtr<DownsampleDriver> self_;
 
@@ -549,22 +609,39 @@ struct ReadState : public internal::AtomicReferenceCount<ReadState> {
   /// Protects access to most other members.
   absl::Mutex mutex_;
 
-  /// Array with domain `base_transform_domain_.box()` with data type
-  /// `self_->base_driver_->dtype()`.  The layout and data pointer must not
-  /// be changed except while holding `mutex_`.  However, disjoint portions of
-  /// the array itself, once allocated, may be written concurrently by multiple
-  /// threads.  This is only allocated once the first chunk that cannot be
-  /// emitted independently is received.  In many cases it will not need to be
-  /// allocated at all.
-  SharedOffsetArray<void> data_buffer_;
+  /// Buffer for one cell of the regular grid with cell shape
+  /// `buffer_cell_shape_`, holding the portions of chunks that cannot be
+  /// emitted independently.
+  struct BufferCell {
+    /// Array with domain equal to the intersection of the grid cell with
+    /// `base_transform_domain_.box()`, with data type
+    /// `self_->base_driver_->dtype()`.  Disjoint portions of the array may be
+    /// written concurrently by multiple threads.
+    SharedOffsetArray<void> data;
+
+    /// Number of elements of `data` not yet copied or emitted independently.
+    /// Once this reaches 0, the cell is emitted.
+    Index remaining_elements;
+
+    /// Portions of the cell that were emitted independently (and are not
+    /// copied to `data`).
+    internal_downsample::GridOccupancyTracker independently_emitted_chunks;
+  };
+
+  /// Buffer cells that have been allocated but not yet emitted, keyed by
+  /// grid cell indices.  In many cases no cells need to be allocated at all.
+  absl::flat_hash_map<std::vector<Index>, BufferCell> buffer_cells_;
+
+  /// Shape of the buffer cells.  Each element is a multiple of the
+  /// corresponding element of `downsample_factors_`.  Constant.
+  absl::InlinedVector<Index, internal::kNumInlinedDims> buffer_cell_shape_;
 
   /// Number of elements out of `base_transform_domain_.num_elements()` not yet
-  /// emitted as independent chunks or copied to `data_buffer_`.  Once this
-  /// reaches 0, any chunks from `data_buffer_` will be emitted.
+  /// emitted as independent chunks or copied to a buffer cell.
   Index remaining_elements_;
 
-  /// List of chunks that were emitted independently (not copied to
-  /// `data_buffer_`).
+  /// List of chunks that were emitted independently, recorded while buffer
+  /// cells that have not yet been allocated may still be needed.
   internal_downsample::GridOccupancyTracker independently_emitted_chunks_;
 
   /// Downsample factors for each dimension of `base_transform_domain_`.
@@ -642,29 +719,49 @@ struct ReadState : public internal::AtomicReferenceCount<ReadState> {
     canceled_ = true;
   }
 
+  /// Returns the buffer cell with the specified grid cell indices, allocating
+  /// it if necessary.
+  BufferCell& GetBufferCell(tensorstore::span<const Index> grid_cell_indices)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  /// Records that `box` was emitted independently in any allocated buffer
+  /// cells it intersects.  Completed cells are moved to `completed_cells`.
+  void MarkIndependentlyEmitted(BoxView<> box,
+                                std::vector<BufferCell>& completed_cells)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  /// Copies `chunk`, which cannot be emitted independently, to the buffer
+  /// cells it intersects, and emits any cells that are completed.
+  ///
+  /// The caller must own a `chunks_in_progress_` reference.
+  absl::Status CopyToBufferCells(ReadChunk& chunk,
+                                 IndexTransformView<> cell_transform);
+
   /// Emits a `ReadChunk` containing a downsample view of the `base_domain`
-  /// region of `data_buffer_`.
+  /// region of `data`.
   ///
   /// The caller must own a `chunks_in_progress_` reference.
-  void EmitBufferedChunkForBox(BoxView<> base_domain);
+  void EmitBufferedChunkForBox(SharedOffsetArray<const void> data,
+                               BoxView<> base_domain);
 
   /// Emits read chunks containing downsampled views of the portions of
-  /// `data_buffer_` that have been written (i.e. not emitted as independent
-  /// chunks).
+  /// `cell` that have been written (i.e. not emitted as independent chunks).
   ///
-  /// The caller implicitly transfers ownership of a `chunks_in_progress_`
-  /// reference.
-  void EmitBufferedChunks();
+  /// The caller must own a `chunks_in_progress_` reference.
+  void EmitBufferCell(BufferCell cell);
 };
 
 /// Implementation of the `internal::ReadChunk::Impl` Poly interface that
-/// provides a downsampled view of `ReadState::data_buffer_`.
+/// provides a downsampled view of a `ReadState::BufferCell`.
 struct BufferedReadChunkImpl {
   internal::IntrusivePtr<ReadState> state_;
 
+  /// Data of the buffer cell.
+  SharedOffsetArray<const void> data_;
+
   absl::Status operator()(LockCollection& lock_collection) const {
-    // No locks required, since `data_buffer_` is immutable by the time this
-    // chunk is emitted.
+    // No locks required, since `data_` is immutable by the time this chunk is
+    // emitted.
     return absl::OkStatus();
   }
 
@@ -676,19 +773,17 @@ struct BufferedReadChunkImpl {
     TENSORSTORE_ASSIGN_OR_RETURN(
         auto propagated,
         internal_downsample::PropagateIndexTransformDownsampling(
-            chunk_transform, state_->data_buffer_.domain(),
-            state_->downsample_factors_));
+            chunk_transform, data_.domain(), state_->downsample_factors_));
     // The domain of `propagated.transform`, when downsampled by
     // `propagated.input_downsample_factors`, matches
     // `chunk_transform.domain()`.
     TENSORSTORE_ASSIGN_OR_RETURN(
         auto transformed_array,
-        MakeTransformedArray(state_->data_buffer_,
-                             std::move(propagated.transform)));
+        MakeTransformedArray(data_, std::move(propagated.transform)));
     TENSORSTORE_ASSIGN_OR_RETURN(
         auto base_nditerable,
         GetTransformedArrayNDIterable(transformed_array, arena));
-    // Return a downsampled view of `state_->base_buffer_`.  Note that
+    // Return a downsampled view of `data_`.  Note that
     // `propagated.transform` may have additional synthetic input dimensions
     // beyond `chunk_transform.input_rank()`, but those are truncated by
     // `DownsampleNDIterable`.
@@ -723,48 +818,170 @@ IndexTransform<> GetDownsampledRequestIdentityTransform(
   return builder.Finalize().value();
 }
 
-void ReadState::EmitBufferedChunkForBox(BoxView<> base_domain) {
+void ReadState::EmitBufferedChunkForBox(SharedOffsetArray<const void> data,
+                                        BoxView<> base_domain) {
   auto request_transform = GetDownsampledRequestIdentityTransform(
       base_domain, downsample_factors_, self_->downsample_method_,
       original_input_rank_);
   ReadChunk downsampled_chunk;
   downsampled_chunk.transform =
       IdentityTransform(request_transform.domain().box());
-  downsampled_chunk.impl = BufferedReadChunkImpl{IntrusivePtr<ReadState>(this)};
+  downsampled_chunk.impl =
+      BufferedReadChunkImpl{IntrusivePtr<ReadState>(this), std::move(data)};
   execution::set_value(receiver_, std::move(downsampled_chunk),
                        std::move(request_transform));
 }
 
-void ReadState::EmitBufferedChunks() {
-  if (independently_emitted_chunks_.occupied_chunks.empty()) {
+void ReadState::EmitBufferCell(BufferCell cell) {
+  SharedOffsetArray<const void> data = std::move(cell.data);
+  BoxView<> cell_domain = data.domain();
+  if (cell.independently_emitted_chunks.occupied_chunks.empty()) {
     // No independently-emitted chunks, can just emit a single chunk for the
-    // entire `data_buffer_`.
-    EmitBufferedChunkForBox(base_transform_domain_.box());
-  } else {
-    // Need to partition domain to skip chunks that have already been emitted
-    // (and aren't present in `state.data_buffer_`).
-    internal_downsample::GridOccupancyMap emitted_chunk_map(
-        std::move(independently_emitted_chunks_), base_transform_domain_.box());
-
-    // Iterate over grid cells that haven't been independently emitted.
-    const DimensionIndex rank = emitted_chunk_map.rank();
-    Index grid_cell[kMaxRank];
-    tensorstore::span<Index> grid_cell_span(&grid_cell[0], rank);
-    Box<dynamic_rank(internal::kNumInlinedDims)> grid_cell_domain;
-    grid_cell_domain.set_rank(rank);
-    emitted_chunk_map.InitializeCellIterator(grid_cell_span);
-    do {
-      if (!emitted_chunk_map.GetGridCellDomain(grid_cell_span,
-                                               grid_cell_domain)) {
-        continue;
+    // entire cell.
+    EmitBufferedChunkForBox(data, cell_domain);
+    return;
+  }
+  // Need to partition the cell to skip chunks that have already been emitted
+  // (and aren't present in `data`).
+  internal_downsample::GridOccupancyMap emitted_chunk_map(
+      std::move(cell.independently_emitted_chunks), cell_domain);
+  // Iterate over grid cells that haven't been independently emitted.
+  const DimensionIndex rank = emitted_chunk_map.rank();
+  Index grid_cell[kMaxRank];
+  tensorstore::span<Index> grid_cell_span(&grid_cell[0], rank);
+  Box<dynamic_rank(internal::kNumInlinedDims)> grid_cell_domain;
+  grid_cell_domain.set_rank(rank);
+  emitted_chunk_map.InitializeCellIterator(grid_cell_span);
+  do {
+    if (!emitted_chunk_map.GetGridCellDomain(grid_cell_span,
+                                             grid_cell_domain)) {
+      continue;
+    }
+    EmitBufferedChunkForBox(data, grid_cell_domain);
+  } while (emitted_chunk_map.AdvanceCellIterator(grid_cell_span));
+}
+
+/// Returns the number of elements in the intersection of `a` and `b`, and
+/// assigns the intersection to `intersection`.
+Index IntersectBoxes(BoxView<> a, BoxView<> b,
+                     Box<dynamic_rank(internal::kNumInlinedDims)>&
+                         intersection) {
+  const DimensionIndex rank = a.rank();
+  assert(b.rank() == rank);
+  intersection.set_rank(rank);
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    intersection[i] = Intersect(a[i], b[i]);
+  }
+  return intersection.num_elements();
+}
+
+ReadState::BufferCell& ReadState::GetBufferCell(
+    tensorstore::span<const Index> grid_cell_indices) {
+  auto [it, inserted] = buffer_cells_.try_emplace(std::vector<Index>(
+      grid_cell_indices.begin(), grid_cell_indices.end()));
+  auto& cell = it->second;
+  if (!inserted) return cell;
+  const DimensionIndex rank = grid_cell_indices.size();
+  Box<dynamic_rank(internal::kNumInlinedDims)> cell_domain(rank);
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    cell_domain[i] = Intersect(
+        IndexInterval::UncheckedSized(
+            grid_cell_indices[i] * buffer_cell_shape_[i],
+            buffer_cell_shape_[i]),
+        base_transform_domain_.box()[i]);
+  }
+  cell.remaining_elements = cell_domain.num_elements();
+  // Exclude the portions of chunks emitted independently before the cell was
+  // allocated.
+  const auto& occupied = independently_emitted_chunks_.occupied_chunks;
+  Box<dynamic_rank(internal::kNumInlinedDims)> intersection;
+  for (size_t i = 0; i < occupied.size(); i += 2 * rank) {
+    BoxView<> box(rank, &occupied[i], &occupied[i + rank]);
+    Index num_elements = IntersectBoxes(box, cell_domain, intersection);
+    if (num_elements == 0) continue;
+    cell.remaining_elements -= num_elements;
+    cell.independently_emitted_chunks.MarkOccupied(intersection);
+  }
+  cell.data = AllocateArray(cell_domain, c_order, default_init,
+                            self_->base_driver_->dtype());
+  return cell;
+}
+
+void ReadState::MarkIndependentlyEmitted(
+    BoxView<> box, std::vector<BufferCell>& completed_cells) {
+  Box<dynamic_rank(internal::kNumInlinedDims)> intersection;
+  for (auto it = buffer_cells_.begin(); it != buffer_cells_.end();) {
+    auto& cell = it->second;
+    Index num_elements = IntersectBoxes(box, cell.data.domain(), intersection);
+    if (num_elements == 0) {
+      ++it;
+      continue;
+    }
+    cell.independently_emitted_chunks.MarkOccupied(intersection);
+    if ((cell.remaining_elements -= num_elements) != 0) {
+      ++it;
+      continue;
+    }
+    completed_cells.push_back(std::move(cell));
+    buffer_cells_.erase(it++);
+  }
+}
+
+absl::Status ReadState::CopyToBufferCells(ReadChunk& chunk,
+                                          IndexTransformView<> cell_transform) {
+  const DimensionIndex rank = cell_transform.output_rank();
+  DimensionIndex grid_output_dimensions[kMaxRank];
+  std::iota(grid_output_dimensions, grid_output_dimensions + rank,
+            DimensionIndex(0));
+  internal_grid_partition::RegularGridRef regular_grid{buffer_cell_shape_};
+  internal_grid_partition::PartitionIndexTransformIterator iterator(
+      tensorstore::span<const DimensionIndex>(&grid_output_dimensions[0],
+                                              rank),
+      regular_grid, cell_transform);
+  TENSORSTORE_RETURN_IF_ERROR(iterator.Init());
+  std::vector<BufferCell> completed_cells;
+  for (; !iterator.AtEnd(); iterator.Advance()) {
+    auto piece_transform = iterator.cell_transform();
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto piece_chunk_transform,
+        ComposeTransforms(chunk.transform, piece_transform));
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto piece_cell_transform,
+        ComposeTransforms(cell_transform, piece_transform));
+    const Index num_elements = piece_transform.domain().num_elements();
+    SharedOffsetArray<void> data;
+    {
+      absl::MutexLock lock(mutex_);
+      if (canceled_) return absl::OkStatus();
+      data = GetBufferCell(iterator.output_grid_cell_indices()).data;
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto transformed_data,
+        MakeTransformedArray(std::move(data), std::move(piece_cell_transform)));
+    TENSORSTORE_RETURN_IF_ERROR(internal::CopyReadChunk(
+        chunk.impl, std::move(piece_chunk_transform), transformed_data));
+    {
+      absl::MutexLock lock(mutex_);
+      remaining_elements_ -= num_elements;
+      auto it = buffer_cells_.find(std::vector<Index>(
+          iterator.output_grid_cell_indices().begin(),
+          iterator.output_grid_cell_indices().end()));
+      assert(it != buffer_cells_.end());
+      if ((it->second.remaining_elements -= num_elements) == 0) {
+        completed_cells.push_back(std::move(it->second));
+        buffer_cells_.erase(it);
       }
-      EmitBufferedChunkForBox(grid_cell_domain);
-    } while (emitted_chunk_map.AdvanceCellIterator(grid_cell_span));
+    }
   }
+  if (completed_cells.empty()) return absl::OkStatus();
   {
-    std::lock_guard<ReadState> guard(*this);
-    --chunks_in_progress_;
+    absl::MutexLock lock(mutex_);
+    if (canceled_) return absl::OkStatus();
+  }
+  for (auto& cell : completed_cells) {
+    EmitBufferCell(std::move(cell));
   }
+  return absl::OkStatus();
 }
 
 /// Implementation of the `internal::ReadChunk::Impl` Poly interface that
@@ -775,8 +992,8 @@ struct IndependentReadChunkImpl {
   /// sub-region of `state_.base_transform_domain_`.  Note that the
   /// `base_driver_` did not necessarily provide `base_chunk_.transform` in this
   /// form, but we only use `IndependentReadChunkImpl` with chunks that can be
-  /// converted to that.  Otherwise, the chunk is copied to
-  /// `state_.data_buffer_`.
+  /// converted to that.  Otherwise, the chunk is copied to buffer cells of
+  /// `state_`.
   internal::ReadChunk base_chunk_;
 
   absl::Status operator()(LockCollection& lock_collection) {
@@ -843,20 +1060,16 @@ bool MaybeEmitIndependentReadChunk(
       ComposeTransforms(base_chunk.transform, inverse_request_transform),
       false);
   const Index num_elements = base_chunk.transform.domain().num_elements();
-  bool emit_buffered_chunk;
+  std::vector<ReadState::BufferCell> completed_cells;
   {
     absl::MutexLock lock(state.mutex_);
-    bool has_data_buffer =
-        state.data_buffer_.byte_strided_origin_pointer() != nullptr;
-    bool remaining_data = (state.remaining_elements_ -= num_elements) != 0;
-    emit_buffered_chunk = (!remaining_data && has_data_buffer);
-    // If there may potentially be non-independently-emitted chunks copied to
-    // `state.data_buffer_`, we need to record this chunk in
-    // `independently_emitted_chunks_`.
-    if (has_data_buffer || remaining_data) {
-      state.independently_emitted_chunks_.MarkOccupied(
-          base_chunk.transform.domain().box());
+    BoxView<> box = base_chunk.transform.domain().box();
+    // If buffer cells may still be allocated for non-independently-emitted
+    // chunks, we need to record this chunk in `independently_emitted_chunks_`.
+    if ((state.remaining_elements_ -= num_elements) != 0) {
+      state.independently_emitted_chunks_.MarkOccupied(box);
     }
+    state.MarkIndependentlyEmitted(box, completed_cells);
   }
 
   internal::ReadChunk downsampled_chunk;
@@ -869,15 +1082,20 @@ bool MaybeEmitIndependentReadChunk(
       IdentityTransform(request_transform.domain().box());
   execution::set_value(state.receiver_, std::move(downsampled_chunk),
                        request_transform);
-  if (emit_buffered_chunk) {
+  if (!completed_cells.empty()) {
     // This method is not called from the `data_copy_executor`.  Because it may
     // involve a significant amount of computation to exclude the
-    // independently-emitted chunks, we ensure `EmitBufferedChunks` is run on
-    // the executor.  We implicitly transfer ownership of a
-    // `chunks_in_progress_` reference.
+    // independently-emitted chunks, we ensure `EmitBufferCell` is run on the
+    // executor.  We implicitly transfer ownership of a `chunks_in_progress_`
+    // reference.
     state.self_->data_copy_executor()(
-        [state = internal::IntrusivePtr<ReadState>(&state)] {
-          state->EmitBufferedChunks();
+        [state = internal::IntrusivePtr<ReadState>(&state),
+         completed_cells = std::move(completed_cells)]() mutable {
+          for (auto& cell : completed_cells) {
+            state->EmitBufferCell(std::move(cell));
+          }
+          std::lock_guard<ReadState> guard(*state);
+          --state->chunks_in_progress_;
         });
   } else {
     std::lock_guard<ReadState> guard(state);
@@ -917,38 +1135,13 @@ struct ReadReceiverImpl {
                                          chunk = std::move(chunk),
                                          cell_transform = std::move(
                                              cell_transform)]() mutable {
-      const Index num_elements = cell_transform.domain().num_elements();
-      {
-        std::lock_guard<ReadState> guard(*state);
-        if (state->canceled_) {
-          --state->chunks_in_progress_;
-          return;
-        }
-        if (state->data_buffer_.byte_strided_origin_pointer() == nullptr) {
-          state->data_buffer_ =
-              AllocateArray(state->base_transform_domain_.box(), c_order,
-                            default_init, state->self_->base_driver_->dtype());
-        }
-      }
-      TENSORSTORE_ASSIGN_OR_RETURN(
-          auto transformed_data_buffer,
-          MakeTransformedArray(state->data_buffer_, std::move(cell_transform)),
-          state->SetError(_, 1));
       TENSORSTORE_RETURN_IF_ERROR(
-          internal::CopyReadChunk(chunk.impl, chunk.transform,
-                                  transformed_data_buffer))
+          state->CopyToBufferCells(chunk, cell_transform))
           .With([&](absl::Status error) {
             state->SetError(std::move(error), 1);
           });
-      {
-        std::lock_guard<ReadState> guard(*state);
-        bool elements_done = (state->remaining_elements_ -= num_elements) == 0;
-        if (state->canceled_ || !elements_done) {
-          --state->chunks_in_progress_;
-          return;
-        }
-      }
-      state->EmitBufferedChunks();
+      std::lock_guard<ReadState> guard(*state);
+      --state->chunks_in_progress_;
     });
   }
 
@@ -966,6 +1159,12 @@ struct ReadReceiverImpl {
 };
 
 void DownsampleDriver::Read(ReadRequest request, ReadChunkReceiver receiver) {
+  if (streaming_) {
+    // Full-resolution base chunks are downsampled (or copied to the
+    // `ReadState` buffer cells) as they are received, and are not needed
+    // after the read completes.
+    request.retain_cached_chunks = false;
+  }
   if (downsample_method_ == DownsampleMethod::kStride) {
     // Stride-based downsampling just relies on the normal `IndexTransform`
     // machinery.
@@ -1010,6 +1209,11 @@ void DownsampleDriver::Read(ReadRequest request, ReadChunkReceiver receiver) {
         state->downsample_factors_ =
             std::move(propagated.input_downsample_factors);
         state->base_transform_domain_ = propagated.transform.domain();
+        state->buffer_cell_shape_.resize(state->downsample_factors_.size());
+        GetBufferCellShape(state->base_transform_domain_.box(),
+                           state->downsample_factors_,
+                           state->self_->base_driver_->dtype().size(),
+                           state->buffer_cell_shape_);
         auto* state_ptr = state.get();
         request.transform = std::move(propagated.transform);
         state_ptr->self_->base_driver_->Read(
@@ -1069,7 +1273,7 @@ namespace internal {
 
 Result<Driver::Handle> MakeDownsampleDriver(
     Driver::Handle base, tensorstore::span<const Index> downsample_factors,
-    DownsampleMethod downsample_method) {
+    DownsampleMethod downsample_method, bool streaming) {
   if (downsample_factors.size() != base.transform.input_rank()) {
     return absl::InvalidArgumentError(absl::StrFormat(
         "Number of downsample factors (%d) does not match "
@@ -1094,7 +1298,8 @@ Result<Driver::Handle> MakeDownsampleDriver(
   base.driver =
       internal::MakeReadWritePtr<internal_downsample::DownsampleDriver>(
           ReadWriteMode::read, std::move(base.driver),
-          std::move(base.transform), downsample_factors, downsample_method);
+          std::move(base.transform), downsample_factors, downsample_method,
+          streaming);
   base.transform = std::move(downsampled_domain);
   return base;
 }
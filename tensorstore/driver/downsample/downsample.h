@@ -23,9 +23,14 @@
 namespace tensorstore {
 namespace internal {
 
+/// Returns a read-only driver handle that downsamples `base`.
+///
+/// If `streaming` is `true`, chunks of `base` read in order to compute the
+/// downsampled data are not retained in the cache once they have been
+/// downsampled.
 Result<Driver::Handle> MakeDownsampleDriver(
     Driver::Handle base, span<const Index> downsample_factors,
-    DownsampleMethod downsample_method);
+    DownsampleMethod downsample_method, bool streaming = false);
 
 }  // namespace internal
 }  // namespace tensorstore
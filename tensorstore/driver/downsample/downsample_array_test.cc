@@ -16,6 +16,8 @@
 
 #include <stdint.h>
 
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
@@ -27,6 +29,7 @@
 #include "tensorstore/index_space/dim_expression.h"
 #include "tensorstore/index_space/transformed_array.h"
 #include "tensorstore/util/span.h"
+#include "tensorstore/util/status_testutil.h"
 
 namespace {
 
@@ -407,4 +410,46 @@ TEST(DownsampleArrayTest, MultipleBlocks) {
               Optional(tensorstore::MatchesArray(expected_downsampled)));
 }
 
+// Tests that the contiguous fast path used for an inner downsample factor of 1
+// or 2 computes the same result as the generic strided path, including for
+// partial blocks at both ends.
+template <typename T>
+void TestContiguousMatchesStrided(T (*get_value)(Index)) {
+  auto base = tensorstore::AllocateArray<T>({5, 7, 2 * 11});
+  for (Index i = 0; i < base.num_elements(); ++i) {
+    base.data()[i] = get_value(i);
+  }
+  // Inner byte stride of `2 * sizeof(T)`, which does not use the fast path.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto strided,
+      base | Dims(2).Stride(2) | Dims(0, 1, 2).TranslateBy({1, 3, 1}));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto contiguous,
+                                   tensorstore::MakeCopy(strided));
+  for (const DownsampleMethod method :
+       {DownsampleMethod::kMean, DownsampleMethod::kMin,
+        DownsampleMethod::kMax}) {
+    for (const auto& factors :
+         {std::vector<Index>{2, 2, 2}, std::vector<Index>{2, 2, 1},
+          std::vector<Index>{1, 3, 2}, std::vector<Index>{3, 1, 2}}) {
+      SCOPED_TRACE(::testing::Message()
+                   << "method=" << method << ", factors=" << factors[0] << ","
+                   << factors[1] << "," << factors[2]);
+      TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+          auto expected, DownsampleTransformedArray(strided, factors, method));
+      EXPECT_THAT(DownsampleArray(contiguous, factors, method),
+                  Optional(expected));
+    }
+  }
+}
+
+TEST(DownsampleArrayTest, ContiguousMatchesStridedUint8) {
+  TestContiguousMatchesStrided<uint8_t>(
+      [](Index i) { return static_cast<uint8_t>(i * 37 % 251); });
+}
+
+TEST(DownsampleArrayTest, ContiguousMatchesStridedFloat) {
+  TestContiguousMatchesStrided<float>(
+      [](Index i) { return static_cast<float>(i % 17) * 0.1f - 0.7f; });
+}
+
 }  // namespace
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <stdint.h>
+
+#include <initializer_list>
 #include <vector>
 
 #include <benchmark/benchmark.h>
@@ -42,9 +45,9 @@ using ::tensorstore::internal_downsample::DownsampleBounds;
 
 void BenchmarkDownsample(::benchmark::State& state, DataType dtype,
                          DownsampleMethod downsample_method,
-                         DimensionIndex rank, Index downsample_factor,
+                         std::vector<Index> downsample_factors,
                          Index block_size) {
-  std::vector<Index> downsample_factors(rank, downsample_factor);
+  const DimensionIndex rank = downsample_factors.size();
   std::vector<Index> block_shape(rank, block_size);
   absl::BitGen gen;
   BoxView<> base_domain(block_shape);
@@ -65,6 +68,7 @@ void BenchmarkDownsample(::benchmark::State& state, DataType dtype,
     total_elements += num_elements;
   }
   state.SetItemsProcessed(total_elements);
+  state.SetBytesProcessed(total_elements * dtype.size());
 }
 
 TENSORSTORE_GLOBAL_INITIALIZER {
@@ -88,14 +92,43 @@ TENSORSTORE_GLOBAL_INITIALIZER {
                              "_BlockSize", block_size)
                     .c_str(),
                 [=](auto& state) {
-                  BenchmarkDownsample(state, dtype, downsample_method, rank,
-                                      downsample_factor, block_size);
+                  BenchmarkDownsample(
+                      state, dtype, downsample_method,
+                      std::vector<Index>(rank, downsample_factor), block_size);
                 });
           }
         }
       }
     }
   }
+
+  // Multiscale pyramid construction of 3-d volumes, which typically uses
+  // 2x2x2 or (anisotropic) 1x2x2 downsampling of C-order chunks.
+  for (const DataType dtype : std::initializer_list<DataType>{
+           tensorstore::dtype_v<uint8_t>, tensorstore::dtype_v<uint16_t>,
+           tensorstore::dtype_v<uint32_t>, tensorstore::dtype_v<float>}) {
+    for (const DownsampleMethod downsample_method :
+         {DownsampleMethod::kMean, DownsampleMethod::kMin,
+          DownsampleMethod::kMax}) {
+      for (const std::vector<Index>& downsample_factors :
+           {std::vector<Index>{2, 2, 2}, std::vector<Index>{1, 2, 2},
+            std::vector<Index>{2, 2, 1}}) {
+        for (const Index block_size : {64, 128, 256}) {
+          ::benchmark::RegisterBenchmark(
+              absl::StrCat("DownsamplePyramid_", dtype, "_",
+                           downsample_method, "_Factor",
+                           downsample_factors[0], "x", downsample_factors[1],
+                           "x", downsample_factors[2], "_BlockSize",
+                           block_size)
+                  .c_str(),
+              [=](auto& state) {
+                BenchmarkDownsample(state, dtype, downsample_method,
+                                    downsample_factors, block_size);
+              });
+        }
+      }
+    }
+  }
 }
 
 }  // namespace
@@ -36,6 +36,7 @@
 #include "tensorstore/box.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/downsample_method.h"
+#include "tensorstore/driver/downsample/downsample_simd.h"
 #include "tensorstore/index.h"
 #include "tensorstore/internal/arena.h"
 #include "tensorstore/internal/elementwise_function.h"
@@ -485,6 +486,57 @@ struct DownsampleImpl {
     }
   }
 
+  /// Accumulates a prefix of a contiguous row using the vectorized kernels
+  /// for `Method`, and returns the number of source elements processed.
+  static Index AccumulateRowSimd(AccumulateElement* acc, const Element* source,
+                                 Index n, Index factor) {
+    if constexpr (Method == DownsampleMethod::kMean) {
+      return AccumulateSumRow(acc, source, n, factor);
+    } else if constexpr (Method == DownsampleMethod::kMin) {
+      return AccumulateMinRow(acc, source, n, factor);
+    } else if constexpr (Method == DownsampleMethod::kMax) {
+      return AccumulateMaxRow(acc, source, n, factor);
+    } else {
+      return 0;
+    }
+  }
+
+  /// Accumulates a contiguous row of `n` source elements, where the row is
+  /// downsampled by `factor`, which must be 1 or 2, and `offset` is the
+  /// position of `source[0]` within its downsample block.
+  ///
+  /// This computes the same result as the generic per-element loop in
+  /// `ProcessInput`, with each output element updated by its source elements
+  /// in the same order, but without callbacks or index computations.  The
+  /// vectorized kernels in `downsample_simd.h` process as much of the row as
+  /// they support, and fixed-stride loops process the remainder.
+  static void AccumulateContiguousRow(AccumulateElement* acc,
+                                     const Element* source, Index n,
+                                     Index factor, Index offset) {
+    if (factor == 1) {
+      for (Index i = AccumulateRowSimd(acc, source, n, 1); i < n; ++i) {
+        Traits::Accumulate(acc[i], source[i]);
+      }
+      return;
+    }
+    assert(factor == 2);
+    if (offset != 0 && n > 0) {
+      Traits::Accumulate(acc[0], source[0]);
+      ++acc;
+      ++source;
+      --n;
+    }
+    const Index num_pairs = n / 2;
+    for (Index i = AccumulateRowSimd(acc, source, 2 * num_pairs, 2) / 2;
+         i < num_pairs; ++i) {
+      Traits::Accumulate(acc[i], source[2 * i]);
+      Traits::Accumulate(acc[i], source[2 * i + 1]);
+    }
+    if (n % 2) {
+      Traits::Accumulate(acc[num_pairs], source[n - 1]);
+    }
+  }
+
   /// ElementwiseFunction LoopTemplate implementation for accumulating the
   /// total.
   struct ProcessInput {
@@ -578,6 +630,27 @@ struct DownsampleImpl {
                       element_i * num_outer_elements);
             });
       };
+      if constexpr (!Traits::kStoreAllElements &&
+                    ArrayAccessor::buffer_kind ==
+                        IterationBufferKind::kContiguous &&
+                    !TENSORSTORE_INTERNAL_DOWNSAMPLE_DEBUG) {
+        // Fast path for the common case of an inner downsample factor of 1 or
+        // 2 (e.g. 2x2x2 and 2x2x1 downsampling of C-order arrays).
+        if (downsample_factor[1] <= 2) {
+          for_each_source_index(
+              std::integral_constant<Index, 0>{},
+              [&](Index output_outer_i, Index source_outer_i, Index element_i,
+                  Index num_source_elements) {
+                AccumulateContiguousRow(
+                    acc + output_outer_i * output_block_shape[1],
+                    ArrayAccessor::template GetPointerAtPosition<Element>(
+                        source_pointer, source_outer_i, 0),
+                    base_block_shape[1], downsample_factor[1],
+                    base_block_offset[1]);
+              });
+          return true;
+        }
+      }
       for_each_source_index(
           std::integral_constant<Index, 0>{},
           [&](Index output_outer_i, Index source_outer_i, Index element_i,
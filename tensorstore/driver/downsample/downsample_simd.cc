@@ -0,0 +1,360 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/downsample/downsample_simd.h"
+
+#include <stdint.h>
+
+#include <cstring>
+
+#include "tensorstore/index.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define TENSORSTORE_INTERNAL_DOWNSAMPLE_AVX2 1
+#include <immintrin.h>
+#else
+#define TENSORSTORE_INTERNAL_DOWNSAMPLE_AVX2 0
+#endif
+
+namespace tensorstore {
+namespace internal_downsample {
+namespace {
+
+#if TENSORSTORE_INTERNAL_DOWNSAMPLE_AVX2
+
+#define TENSORSTORE_INTERNAL_TARGET_AVX2 __attribute__((target("avx2")))
+
+bool HasAvx2() {
+  static const bool has_avx2 = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }();
+  return has_avx2;
+}
+
+TENSORSTORE_INTERNAL_TARGET_AVX2 inline __m256i Load(const void* p) {
+  return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+}
+
+TENSORSTORE_INTERNAL_TARGET_AVX2 inline void Store(void* p, __m256i v) {
+  _mm256_storeu_si256(static_cast<__m256i*>(p), v);
+}
+
+// Adds `v` to the 4 `uint64_t` accumulators at `acc`.
+TENSORSTORE_INTERNAL_TARGET_AVX2 inline void AddTo(uint64_t* acc, __m256i v) {
+  Store(acc, _mm256_add_epi64(Load(acc), v));
+}
+
+// Concatenates the lanes of the results of a 256-bit pack instruction, which
+// packs within each 128-bit lane.
+TENSORSTORE_INTERNAL_TARGET_AVX2 inline __m256i Unpermute(__m256i v) {
+  return _mm256_permute4x64_epi64(v, 0xd8);
+}
+
+// Returns the even- and odd-indexed elements of the 16 32-bit elements at `p`.
+TENSORSTORE_INTERNAL_TARGET_AVX2 inline void Deinterleave(const void* p,
+                                                          __m256& even,
+                                                          __m256& odd) {
+  const __m256 x0 = _mm256_loadu_ps(static_cast<const float*>(p));
+  const __m256 x1 = _mm256_loadu_ps(static_cast<const float*>(p) + 8);
+  even = _mm256_castsi256_ps(
+      Unpermute(_mm256_castps_si256(_mm256_shuffle_ps(x0, x1, 0x88))));
+  odd = _mm256_castsi256_ps(
+      Unpermute(_mm256_castps_si256(_mm256_shuffle_ps(x0, x1, 0xdd))));
+}
+
+TENSORSTORE_INTERNAL_TARGET_AVX2 inline void Deinterleave(const void* p,
+                                                          __m256i& even,
+                                                          __m256i& odd) {
+  __m256 even_ps, odd_ps;
+  Deinterleave(p, even_ps, odd_ps);
+  even = _mm256_castps_si256(even_ps);
+  odd = _mm256_castps_si256(odd_ps);
+}
+
+// Each kernel defines `kBlock`, the number of source elements processed by
+// `Accumulate` (factor 1) and `AccumulatePairs` (factor 2).
+
+struct Uint8Sum {
+  static constexpr Index kBlock = 32;
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void Accumulate(
+      uint64_t* acc, const uint8_t* source) {
+    for (Index i = 0; i < kBlock; i += 4) {
+      int32_t x;
+      std::memcpy(&x, source + i, 4);
+      AddTo(acc + i, _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(x)));
+    }
+  }
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void AccumulatePairs(
+      uint64_t* acc, const uint8_t* source) {
+    // 16 pair sums, which do not saturate.
+    const __m256i sums =
+        _mm256_maddubs_epi16(Load(source), _mm256_set1_epi8(1));
+    const __m128i lo = _mm256_castsi256_si128(sums);
+    const __m128i hi = _mm256_extracti128_si256(sums, 1);
+    AddTo(acc, _mm256_cvtepu16_epi64(lo));
+    AddTo(acc + 4, _mm256_cvtepu16_epi64(_mm_srli_si128(lo, 8)));
+    AddTo(acc + 8, _mm256_cvtepu16_epi64(hi));
+    AddTo(acc + 12, _mm256_cvtepu16_epi64(_mm_srli_si128(hi, 8)));
+  }
+};
+
+struct Uint16Sum {
+  static constexpr Index kBlock = 16;
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void Accumulate(
+      uint64_t* acc, const uint16_t* source) {
+    const __m256i x = Load(source);
+    const __m128i lo = _mm256_castsi256_si128(x);
+    const __m128i hi = _mm256_extracti128_si256(x, 1);
+    AddTo(acc, _mm256_cvtepu16_epi64(lo));
+    AddTo(acc + 4, _mm256_cvtepu16_epi64(_mm_srli_si128(lo, 8)));
+    AddTo(acc + 8, _mm256_cvtepu16_epi64(hi));
+    AddTo(acc + 12, _mm256_cvtepu16_epi64(_mm_srli_si128(hi, 8)));
+  }
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void AccumulatePairs(
+      uint64_t* acc, const uint16_t* source) {
+    const __m256i x = Load(source);
+    const __m256i sums =
+        _mm256_add_epi32(_mm256_and_si256(x, _mm256_set1_epi32(0xffff)),
+                         _mm256_srli_epi32(x, 16));
+    AddTo(acc, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(sums)));
+    AddTo(acc + 4, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(sums, 1)));
+  }
+};
+
+struct Uint32Sum {
+  static constexpr Index kBlock = 16;
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void Accumulate(
+      uint64_t* acc, const uint32_t* source) {
+    for (Index i = 0; i < kBlock; i += 8) {
+      const __m256i x = Load(source + i);
+      AddTo(acc + i, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(x)));
+      AddTo(acc + i + 4,
+            _mm256_cvtepu32_epi64(_mm256_extracti128_si256(x, 1)));
+    }
+  }
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void AccumulatePairs(
+      uint64_t* acc, const uint32_t* source) {
+    __m256i even, odd;
+    Deinterleave(source, even, odd);
+    AddTo(acc, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(even)));
+    AddTo(acc, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(odd)));
+    AddTo(acc + 4, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(even, 1)));
+    AddTo(acc + 4, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(odd, 1)));
+  }
+};
+
+struct FloatSum {
+  static constexpr Index kBlock = 16;
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void Accumulate(float* acc,
+                                                          const float* source) {
+    for (Index i = 0; i < kBlock; i += 8) {
+      _mm256_storeu_ps(acc + i, _mm256_add_ps(_mm256_loadu_ps(acc + i),
+                                              _mm256_loadu_ps(source + i)));
+    }
+  }
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void AccumulatePairs(
+      float* acc, const float* source) {
+    __m256 even, odd;
+    Deinterleave(source, even, odd);
+    // Add in the same order as the scalar reduction.
+    _mm256_storeu_ps(
+        acc, _mm256_add_ps(_mm256_add_ps(_mm256_loadu_ps(acc), even), odd));
+  }
+};
+
+// Integer min/max operations.  The 8-bit and 16-bit operations are also
+// applied to zero-extended elements in wider lanes.
+#define TENSORSTORE_INTERNAL_DEFINE_INT_OP(NAME, INSTRUCTION)          \
+  struct NAME {                                                        \
+    TENSORSTORE_INTERNAL_TARGET_AVX2 static __m256i Apply(__m256i a,   \
+                                                          __m256i b) { \
+      return INSTRUCTION(a, b);                                        \
+    }                                                                  \
+  };                                                                   \
+  /**/
+TENSORSTORE_INTERNAL_DEFINE_INT_OP(MinEpu8, _mm256_min_epu8)
+TENSORSTORE_INTERNAL_DEFINE_INT_OP(MaxEpu8, _mm256_max_epu8)
+TENSORSTORE_INTERNAL_DEFINE_INT_OP(MinEpu16, _mm256_min_epu16)
+TENSORSTORE_INTERNAL_DEFINE_INT_OP(MaxEpu16, _mm256_max_epu16)
+TENSORSTORE_INTERNAL_DEFINE_INT_OP(MinEpu32, _mm256_min_epu32)
+TENSORSTORE_INTERNAL_DEFINE_INT_OP(MaxEpu32, _mm256_max_epu32)
+#undef TENSORSTORE_INTERNAL_DEFINE_INT_OP
+
+// `Apply(input, acc)` returns `std::min(acc, input)`, i.e. `input < acc ? input
+// : acc`, which retains `acc` if either is NaN.
+struct MinPs {
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static __m256 Apply(__m256 input,
+                                                       __m256 acc) {
+    return _mm256_min_ps(input, acc);
+  }
+};
+
+// `Apply(input, acc)` returns `std::max(acc, input)`, i.e. `acc < input ? input
+// : acc`.
+struct MaxPs {
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static __m256 Apply(__m256 input,
+                                                       __m256 acc) {
+    return _mm256_max_ps(input, acc);
+  }
+};
+
+// Kernels for integer min/max, for which the order in which elements are
+// reduced does not matter.  Each reduces 64 bytes of pairs to 32 bytes.
+template <typename Op>
+struct Uint8MinMax {
+  static constexpr Index kBlock = 64;
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void Accumulate(
+      uint8_t* acc, const uint8_t* source) {
+    for (Index i = 0; i < kBlock; i += 32) {
+      Store(acc + i, Op::Apply(Load(source + i), Load(acc + i)));
+    }
+  }
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void AccumulatePairs(
+      uint8_t* acc, const uint8_t* source) {
+    const __m256i mask = _mm256_set1_epi16(0xff);
+    const __m256i x0 = Load(source);
+    const __m256i x1 = Load(source + 32);
+    const __m256i r0 =
+        Op::Apply(_mm256_and_si256(x0, mask), _mm256_srli_epi16(x0, 8));
+    const __m256i r1 =
+        Op::Apply(_mm256_and_si256(x1, mask), _mm256_srli_epi16(x1, 8));
+    Store(acc,
+          Op::Apply(Unpermute(_mm256_packus_epi16(r0, r1)), Load(acc)));
+  }
+};
+
+template <typename Op>
+struct Uint16MinMax {
+  static constexpr Index kBlock = 32;
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void Accumulate(
+      uint16_t* acc, const uint16_t* source) {
+    for (Index i = 0; i < kBlock; i += 16) {
+      Store(acc + i, Op::Apply(Load(source + i), Load(acc + i)));
+    }
+  }
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void AccumulatePairs(
+      uint16_t* acc, const uint16_t* source) {
+    const __m256i mask = _mm256_set1_epi32(0xffff);
+    const __m256i x0 = Load(source);
+    const __m256i x1 = Load(source + 16);
+    const __m256i r0 =
+        Op::Apply(_mm256_and_si256(x0, mask), _mm256_srli_epi32(x0, 16));
+    const __m256i r1 =
+        Op::Apply(_mm256_and_si256(x1, mask), _mm256_srli_epi32(x1, 16));
+    Store(acc,
+          Op::Apply(Unpermute(_mm256_packus_epi32(r0, r1)), Load(acc)));
+  }
+};
+
+template <typename Op>
+struct Uint32MinMax {
+  static constexpr Index kBlock = 16;
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void Accumulate(
+      uint32_t* acc, const uint32_t* source) {
+    for (Index i = 0; i < kBlock; i += 8) {
+      Store(acc + i, Op::Apply(Load(source + i), Load(acc + i)));
+    }
+  }
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void AccumulatePairs(
+      uint32_t* acc, const uint32_t* source) {
+    __m256i even, odd;
+    Deinterleave(source, even, odd);
+    Store(acc, Op::Apply(Op::Apply(even, odd), Load(acc)));
+  }
+};
+
+// Floating-point min/max reduces each element into the accumulator in order,
+// so that NaN inputs are handled as by the scalar reduction.
+template <typename Op>
+struct FloatMinMax {
+  static constexpr Index kBlock = 16;
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void Accumulate(float* acc,
+                                                          const float* source) {
+    for (Index i = 0; i < kBlock; i += 8) {
+      _mm256_storeu_ps(acc + i, Op::Apply(_mm256_loadu_ps(source + i),
+                                          _mm256_loadu_ps(acc + i)));
+    }
+  }
+  TENSORSTORE_INTERNAL_TARGET_AVX2 static void AccumulatePairs(
+      float* acc, const float* source) {
+    __m256 even, odd;
+    Deinterleave(source, even, odd);
+    _mm256_storeu_ps(
+        acc, Op::Apply(odd, Op::Apply(even, _mm256_loadu_ps(acc))));
+  }
+};
+
+template <typename Kernel, typename AccumulateElement, typename Element>
+TENSORSTORE_INTERNAL_TARGET_AVX2 Index
+AccumulateRowAvx2(AccumulateElement* acc, const Element* source, Index n,
+                  Index factor) {
+  Index i = 0;
+  if (factor == 1) {
+    for (; i + Kernel::kBlock <= n; i += Kernel::kBlock) {
+      Kernel::Accumulate(acc + i, source + i);
+    }
+  } else {
+    for (; i + Kernel::kBlock <= n; i += Kernel::kBlock) {
+      Kernel::AccumulatePairs(acc + i / 2, source + i);
+    }
+  }
+  return i;
+}
+
+#undef TENSORSTORE_INTERNAL_TARGET_AVX2
+
+#endif  // TENSORSTORE_INTERNAL_DOWNSAMPLE_AVX2
+
+}  // namespace
+
+// Row kernels: function, accumulator type, element type and kernel.
+#define TENSORSTORE_INTERNAL_DOWNSAMPLE_FOR_EACH_ROW_KERNEL(X)    \
+  X(AccumulateSumRow, uint64_t, uint8_t, Uint8Sum)                \
+  X(AccumulateSumRow, uint64_t, uint16_t, Uint16Sum)              \
+  X(AccumulateSumRow, uint64_t, uint32_t, Uint32Sum)              \
+  X(AccumulateSumRow, float, float, FloatSum)                     \
+  X(AccumulateMinRow, uint8_t, uint8_t, Uint8MinMax<MinEpu8>)     \
+  X(AccumulateMinRow, uint16_t, uint16_t, Uint16MinMax<MinEpu16>) \
+  X(AccumulateMinRow, uint32_t, uint32_t, Uint32MinMax<MinEpu32>) \
+  X(AccumulateMinRow, float, float, FloatMinMax<MinPs>)           \
+  X(AccumulateMaxRow, uint8_t, uint8_t, Uint8MinMax<MaxEpu8>)     \
+  X(AccumulateMaxRow, uint16_t, uint16_t, Uint16MinMax<MaxEpu16>) \
+  X(AccumulateMaxRow, uint32_t, uint32_t, Uint32MinMax<MaxEpu32>) \
+  X(AccumulateMaxRow, float, float, FloatMinMax<MaxPs>)           \
+  /**/
+
+#if TENSORSTORE_INTERNAL_DOWNSAMPLE_AVX2
+#define TENSORSTORE_INTERNAL_DEFINE_ROW_KERNEL(NAME, ACC, ELEMENT, KERNEL) \
+  Index NAME(ACC* acc, const ELEMENT* source, Index n, Index factor) {     \
+    if (!HasAvx2()) return 0;                                              \
+    return AccumulateRowAvx2<KERNEL>(acc, source, n, factor);              \
+  }                                                                        \
+  /**/
+#else
+#define TENSORSTORE_INTERNAL_DEFINE_ROW_KERNEL(NAME, ACC, ELEMENT, KERNEL) \
+  Index NAME(ACC* acc, const ELEMENT* source, Index n, Index factor) {     \
+    return 0;                                                              \
+  }                                                                        \
+  /**/
+#endif
+
+TENSORSTORE_INTERNAL_DOWNSAMPLE_FOR_EACH_ROW_KERNEL(
+    TENSORSTORE_INTERNAL_DEFINE_ROW_KERNEL)
+
+#undef TENSORSTORE_INTERNAL_DEFINE_ROW_KERNEL
+#undef TENSORSTORE_INTERNAL_DOWNSAMPLE_FOR_EACH_ROW_KERNEL
+
+}  // namespace internal_downsample
+}  // namespace tensorstore
@@ -0,0 +1,86 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_DRIVER_DOWNSAMPLE_DOWNSAMPLE_SIMD_H_
+#define TENSORSTORE_DRIVER_DOWNSAMPLE_DOWNSAMPLE_SIMD_H_
+
+/// \file
+/// Vectorized kernels for accumulating contiguous rows of source elements for
+/// the mean, min and max downsampling methods.
+///
+/// Each kernel accumulates a prefix of the `n` elements of `source` into `acc`
+/// and returns the length of the prefix; the caller accumulates the remaining
+/// elements.  With `factor == 1`, `source[i]` is accumulated into `acc[i]`;
+/// with `factor == 2` (and `n` even), `source[2*i]` and then `source[2*i+1]`
+/// are accumulated into `acc[i]`.  The result is identical to accumulating
+/// each element in that order with the scalar reduction.
+///
+/// The kernels use AVX2 when the CPU supports it, as determined at run time,
+/// and otherwise return 0.  Overloads are provided for the accumulator and
+/// element types used for `uint8`, `uint16`, `uint32` and `float32`; the
+/// templates handle all other types by returning 0.
+
+#include <stdint.h>
+
+#include "tensorstore/index.h"
+
+namespace tensorstore {
+namespace internal_downsample {
+
+/// Accumulates `acc[i] += source[j]`.
+template <typename AccumulateElement, typename Element>
+Index AccumulateSumRow(AccumulateElement* acc, const Element* source, Index n,
+                       Index factor) {
+  return 0;
+}
+Index AccumulateSumRow(uint64_t* acc, const uint8_t* source, Index n,
+                       Index factor);
+Index AccumulateSumRow(uint64_t* acc, const uint16_t* source, Index n,
+                       Index factor);
+Index AccumulateSumRow(uint64_t* acc, const uint32_t* source, Index n,
+                       Index factor);
+Index AccumulateSumRow(float* acc, const float* source, Index n, Index factor);
+
+/// Accumulates `acc[i] = std::min(acc[i], source[j])`.
+template <typename AccumulateElement, typename Element>
+Index AccumulateMinRow(AccumulateElement* acc, const Element* source, Index n,
+                       Index factor) {
+  return 0;
+}
+Index AccumulateMinRow(uint8_t* acc, const uint8_t* source, Index n,
+                       Index factor);
+Index AccumulateMinRow(uint16_t* acc, const uint16_t* source, Index n,
+                       Index factor);
+Index AccumulateMinRow(uint32_t* acc, const uint32_t* source, Index n,
+                       Index factor);
+Index AccumulateMinRow(float* acc, const float* source, Index n, Index factor);
+
+/// Accumulates `acc[i] = std::max(acc[i], source[j])`.
+template <typename AccumulateElement, typename Element>
+Index AccumulateMaxRow(AccumulateElement* acc, const Element* source, Index n,
+                       Index factor) {
+  return 0;
+}
+Index AccumulateMaxRow(uint8_t* acc, const uint8_t* source, Index n,
+                       Index factor);
+Index AccumulateMaxRow(uint16_t* acc, const uint16_t* source, Index n,
+                       Index factor);
+Index AccumulateMaxRow(uint32_t* acc, const uint32_t* source, Index n,
+                       Index factor);
+Index AccumulateMaxRow(float* acc, const float* source, Index n, Index factor);
+
+}  // namespace internal_downsample
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_DRIVER_DOWNSAMPLE_DOWNSAMPLE_SIMD_H_
@@ -0,0 +1,138 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/downsample/downsample_simd.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tensorstore/index.h"
+
+namespace {
+
+using ::tensorstore::Index;
+using ::tensorstore::internal_downsample::AccumulateMaxRow;
+using ::tensorstore::internal_downsample::AccumulateMinRow;
+using ::tensorstore::internal_downsample::AccumulateSumRow;
+
+template <typename T>
+std::vector<T> RandomValues(std::minstd_rand& gen, size_t n) {
+  std::vector<T> values(n);
+  for (auto& x : values) {
+    if constexpr (std::is_floating_point_v<T>) {
+      switch (gen() % 8) {
+        case 0:
+          x = std::numeric_limits<T>::quiet_NaN();
+          break;
+        case 1:
+          x = -0.0f;
+          break;
+        default:
+          x = std::uniform_real_distribution<T>(-100, 100)(gen);
+      }
+    } else {
+      x = static_cast<T>(gen());
+    }
+  }
+  return values;
+}
+
+// Returns `true` if `a` and `b` have the same representation.
+template <typename T>
+bool SameBits(const std::vector<T>& a, const std::vector<T>& b) {
+  return a.size() == b.size() &&
+         std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+// Checks that `kernel` followed by `op` on the remaining elements computes
+// the same result as `op` on all elements.
+template <typename AccumulateElement, typename Element, typename Kernel,
+          typename Op>
+void TestKernel(Kernel kernel, Op op) {
+  std::minstd_rand gen(42);
+  for (Index factor : {1, 2}) {
+    for (Index n = 0; n < 300; n += factor) {
+      SCOPED_TRACE(testing::Message() << "factor=" << factor << ", n=" << n);
+      const auto source = RandomValues<Element>(gen, n);
+      const auto initial = RandomValues<AccumulateElement>(gen, n / factor);
+      auto expected = initial;
+      for (Index i = 0; i < n; ++i) {
+        op(expected[i / factor], source[i]);
+      }
+      auto acc = initial;
+      const Index done = kernel(acc.data(), source.data(), n, factor);
+      ASSERT_GE(done, 0);
+      ASSERT_LE(done, n);
+      ASSERT_EQ(0, done % factor);
+      for (Index i = done; i < n; ++i) {
+        op(acc[i / factor], source[i]);
+      }
+      EXPECT_TRUE(SameBits(expected, acc));
+    }
+  }
+}
+
+constexpr auto kSum = [](auto& acc, auto x) { acc += x; };
+constexpr auto kMin = [](auto& acc, auto x) { acc = std::min(acc, x); };
+constexpr auto kMax = [](auto& acc, auto x) { acc = std::max(acc, x); };
+
+TEST(DownsampleSimdTest, Sum) {
+  TestKernel<uint64_t, uint8_t>(
+      [](auto... args) { return AccumulateSumRow(args...); }, kSum);
+  TestKernel<uint64_t, uint16_t>(
+      [](auto... args) { return AccumulateSumRow(args...); }, kSum);
+  TestKernel<uint64_t, uint32_t>(
+      [](auto... args) { return AccumulateSumRow(args...); }, kSum);
+  TestKernel<float, float>(
+      [](auto... args) { return AccumulateSumRow(args...); }, kSum);
+}
+
+TEST(DownsampleSimdTest, Min) {
+  TestKernel<uint8_t, uint8_t>(
+      [](auto... args) { return AccumulateMinRow(args...); }, kMin);
+  TestKernel<uint16_t, uint16_t>(
+      [](auto... args) { return AccumulateMinRow(args...); }, kMin);
+  TestKernel<uint32_t, uint32_t>(
+      [](auto... args) { return AccumulateMinRow(args...); }, kMin);
+  TestKernel<float, float>(
+      [](auto... args) { return AccumulateMinRow(args...); }, kMin);
+}
+
+TEST(DownsampleSimdTest, Max) {
+  TestKernel<uint8_t, uint8_t>(
+      [](auto... args) { return AccumulateMaxRow(args...); }, kMax);
+  TestKernel<uint16_t, uint16_t>(
+      [](auto... args) { return AccumulateMaxRow(args...); }, kMax);
+  TestKernel<uint32_t, uint32_t>(
+      [](auto... args) { return AccumulateMaxRow(args...); }, kMax);
+  TestKernel<float, float>(
+      [](auto... args) { return AccumulateMaxRow(args...); }, kMax);
+}
+
+TEST(DownsampleSimdTest, UnsupportedTypes) {
+  int8_t source[64] = {};
+  int64_t acc[64] = {};
+  EXPECT_EQ(0, AccumulateSumRow(acc, source, 64, 1));
+  EXPECT_EQ(0, AccumulateMinRow(source, source, 64, 2));
+}
+
+}  // namespace
@@ -19,6 +19,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -60,6 +61,7 @@ using ::tensorstore::Context;
 using ::tensorstore::DimensionIndex;
 using ::tensorstore::DownsampleMethod;
 using ::tensorstore::Index;
+using ::tensorstore::IndexTransform;
 using ::tensorstore::MakeArray;
 using ::tensorstore::MakeOffsetArray;
 using ::tensorstore::MatchesJson;
@@ -155,6 +157,69 @@ TEST(DownsampleTest, Rank1MeanChunked) {
               Optional(MakeArray<uint8_t>({1, 6, 3, 5, 2, 5})));
 }
 
+// Tests that base chunks read by a streaming downsample driver are not
+// retained in the cache.
+TEST(DownsampleTest, StreamingDoesNotRetainBaseChunks) {
+  ::nlohmann::json base_spec{{"driver", "n5"},
+                             {"kvstore", {{"driver", "memory"}}},
+                             {"recheck_cached_data", false},
+                             {"metadata",
+                              {{"dataType", "uint8"},
+                               {"dimensions", {4}},
+                               {"blockSize", {2}},
+                               {"compression", {{"type", "raw"}}}}}};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto context_spec,
+      Context::Spec::FromJson(
+          {{"cache_pool", {{"total_bytes_limit", 1000000}}}}));
+  Context context(context_spec);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base_store,
+      tensorstore::Open(base_spec, context, tensorstore::OpenMode::create)
+          .result());
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(MakeArray<uint8_t>({1, 3, 5, 7}), base_store));
+
+  // Writes to the memory kvstore without going through the cache of `context`.
+  auto uncached_spec = base_spec;
+  uncached_spec["cache_pool"] = {{"total_bytes_limit", 0}};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto uncached_store, tensorstore::Open(uncached_spec, context).result());
+
+  const auto open_downsampled = [&](bool streaming) {
+    return tensorstore::Open({{"driver", "downsample"},
+                              {"base", base_spec},
+                              {"downsample_factors", {2}},
+                              {"downsample_method", "mean"},
+                              {"streaming", streaming}},
+                             context)
+        .result();
+  };
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto streaming_store,
+                                   open_downsampled(true));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto cached_store, open_downsampled(false));
+
+  EXPECT_THAT(tensorstore::Read(streaming_store).result(),
+              Optional(MakeArray<uint8_t>({2, 6})));
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(MakeArray<uint8_t>({3, 5, 7, 9}), uncached_store));
+  // The base chunks were not retained, so are read again.
+  EXPECT_THAT(tensorstore::Read(streaming_store).result(),
+              Optional(MakeArray<uint8_t>({4, 8})));
+
+  EXPECT_THAT(tensorstore::Read(cached_store).result(),
+              Optional(MakeArray<uint8_t>({4, 8})));
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(MakeArray<uint8_t>({1, 3, 5, 7}), uncached_store));
+  // The base chunks were retained, so the stale data is returned.
+  EXPECT_THAT(tensorstore::Read(cached_store).result(),
+              Optional(MakeArray<uint8_t>({4, 8})));
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto spec, streaming_store.spec());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto spec_json, spec.ToJson());
+  EXPECT_EQ(true, spec_json.value("streaming", false));
+}
+
 TEST(DownsampleTest, Rank1MeanChunkedTranslated) {
   ::nlohmann::json base_spec{{"driver", "n5"},
                              {"kvstore", {{"driver", "memory"}}},
@@ -525,6 +590,70 @@ TEST(DownsampleTest, IndependentChunkCompletesBufferedChunk) {
   EXPECT_THAT(read_future.result(), Optional(MakeArray<float>({0.5, 2.5})));
 }
 
+// Tests that chunks that cannot be downsampled independently are buffered in
+// separate block-aligned cells, which are each emitted once complete.
+TEST(DownsampleTest, BufferedChunksSpanMultipleCells) {
+  // With `float` data, a buffer cell holds `1 << 18` elements, so the domain
+  // spans 1.5 buffer cells.
+  constexpr Index kSize = 3 << 17;
+  constexpr Index kSplit = 300000;
+  auto mock_driver = MockDriver::Make(tensorstore::ReadWriteMode::dynamic,
+                                      tensorstore::dtype_v<float>, 1);
+  auto mock_store =
+      mock_driver->Wrap(tensorstore::IdentityTransform<1>({kSize}));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto downsampled_store,
+      tensorstore::Downsample(mock_store, {2}, DownsampleMethod::kMean));
+  auto first = tensorstore::AllocateArray<float>({kSplit});
+  auto indices = tensorstore::AllocateArray<Index>({kSplit});
+  for (Index i = 0; i < kSplit; ++i) {
+    first(i) = i % 7;
+    indices(i) = i;
+  }
+  auto second = tensorstore::AllocateArray<float>(
+      BoxView<1>({kSplit}, {kSize - kSplit}));
+  for (Index i = kSplit; i < kSize; ++i) second(i) = i % 7;
+  auto expected = tensorstore::AllocateArray<float>({kSize / 2});
+  for (Index i = 0; i < kSize / 2; ++i) {
+    expected(i) = ((2 * i) % 7 + (2 * i + 1) % 7) / 2.0f;
+  }
+  const auto respond = [&] {
+    auto read_req = mock_driver->read_requests.pop();
+    tensorstore::execution::set_starting(read_req.receiver, [] {});
+    // Send chunk with index transform that won't be downsampled independently,
+    // spanning the boundary between the two buffer cells.
+    tensorstore::execution::set_value(
+        read_req.receiver, MakeArrayBackedReadChunk(first),
+        (tensorstore::IdentityTransform(1) |
+         tensorstore::Dims(0).IndexArraySlice(indices))
+            .value());
+    // Send chunk that can be downsampled independently, completing the second
+    // buffer cell.
+    tensorstore::execution::set_value(
+        read_req.receiver, MakeArrayBackedReadChunk(second),
+        tensorstore::IdentityTransform(second.domain()));
+    tensorstore::execution::set_done(read_req.receiver);
+    tensorstore::execution::set_stopping(read_req.receiver);
+  };
+
+  auto chunks_future = CollectReadChunks(downsampled_store);
+  respond();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto chunks, chunks_future.result());
+  std::vector<IndexTransform<>> chunk_transforms;
+  for (auto& chunk : chunks) chunk_transforms.push_back(chunk.second);
+  EXPECT_THAT(chunk_transforms,
+              ::testing::UnorderedElementsAre(
+                  tensorstore::IdentityTransform(BoxView<1>({0}, {1 << 17})),
+                  tensorstore::IdentityTransform(
+                      BoxView<1>({1 << 17}, {kSplit / 2 - (1 << 17)})),
+                  tensorstore::IdentityTransform(
+                      BoxView<1>({kSplit / 2}, {(kSize - kSplit) / 2}))));
+
+  auto read_future = tensorstore::Read(downsampled_store);
+  respond();
+  EXPECT_THAT(read_future.result(), Optional(expected));
+}
+
 // Tests that a read error from the base TensorStore is handled correctly.
 TEST(DownsampleTest, EmptyChunk) {
   auto mock_driver = MockDriver::Make(tensorstore::ReadWriteMode::dynamic,
@@ -39,6 +39,7 @@
 #include "tensorstore/internal/json_binding/bindable.h"
 #include "tensorstore/internal/tagged_ptr.h"
 #include "tensorstore/internal/tracing/operation_trace_span.h"
+#include "tensorstore/internal/tracing/trace_context.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/open_options.h"
@@ -94,6 +95,7 @@ Future<Driver::Handle> OpenDriver(TransformedDriverSpec bound_spec,
   DriverSpecPtr ptr = bound_spec.driver_spec;
   auto open_span = std::make_unique<internal_tracing::OperationTraceSpan>(
       "tensorstore.Open");
+  internal_tracing::ScopedTraceContext trace_scope(open_span->context());
   return MapFuture(
       InlineExecutor{},
       [bound_spec = std::move(bound_spec), open_span = std::move(open_span)](
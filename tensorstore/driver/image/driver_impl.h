@@ -24,7 +24,9 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
@@ -34,6 +36,7 @@
 #include "absl/time/time.h"
 #include "tensorstore/array.h"
 #include "tensorstore/array_storage_statistics.h"
+#include "tensorstore/box.h"
 #include "tensorstore/chunk_layout.h"
 #include "tensorstore/codec_spec.h"
 #include "tensorstore/context.h"
@@ -49,24 +52,30 @@
 #include "tensorstore/index_space/index_domain_builder.h"
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/internal/arena.h"
+#include "tensorstore/internal/async_write_array.h"
 #include "tensorstore/internal/cache/async_cache.h"
 #include "tensorstore/internal/cache/async_initialized_cache_mixin.h"
 #include "tensorstore/internal/cache/cache.h"
 #include "tensorstore/internal/cache/cache_pool_resource.h"
+#include "tensorstore/internal/cache/chunk_cache.h"
 #include "tensorstore/internal/cache/kvs_backed_cache.h"
 #include "tensorstore/internal/cache_key/cache_key.h"
+#include "tensorstore/internal/cache_key/std_vector.h"  // IWYU pragma: keep
+#include "tensorstore/internal/chunk_grid_specification.h"
 #include "tensorstore/internal/concurrency_resource.h"
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/json_binding/staleness_bound.h"  // IWYU pragma: keep
 #include "tensorstore/internal/lock_collection.h"
+#include "tensorstore/internal/memory.h"
 #include "tensorstore/internal/meta/type_traits.h"
 #include "tensorstore/internal/nditerable.h"
 #include "tensorstore/internal/nditerable_transformed_array.h"
 #include "tensorstore/internal/uri/parse.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_result.h"
@@ -78,6 +87,7 @@
 #include "tensorstore/schema.h"
 #include "tensorstore/serialization/absl_time.h"  // IWYU pragma: keep
 #include "tensorstore/staleness_bound.h"
+#include "tensorstore/strided_layout.h"
 #include "tensorstore/transaction.h"
 #include "tensorstore/util/execution/any_receiver.h"
 #include "tensorstore/util/execution/execution.h"
@@ -93,6 +103,49 @@ namespace tensorstore {
 namespace internal_image_driver {
 namespace {
 
+// By default the image cache holds the fully decoded image.
+//
+// A specialization may instead define an `EncodedImage` type, returned by
+// `DecodeImage`, which holds the encoded image along with its parsed header
+// and which provides `BoxView<> domain()` and `span<const Index>
+// chunk_shape()` accessors.  Pixels are
+// then decoded on demand by `Specialization::DecodeRegion`, one chunk at a
+// time, and cached by `ImageChunkCache`, so that a read decodes only the
+// chunks that it intersects.
+template <typename Specialization, typename = void>
+struct ImageReadDataTraits {
+  static constexpr bool kDecodeByChunk = false;
+  using ReadData = tensorstore::SharedArray<const uint8_t, 3>;
+};
+
+template <typename Specialization>
+struct ImageReadDataTraits<Specialization,
+                           std::void_t<typename Specialization::EncodedImage>> {
+  static constexpr bool kDecodeByChunk = true;
+  using ReadData = typename Specialization::EncodedImage;
+};
+
+template <typename Specialization, typename = void>
+constexpr bool kHasImageRank = false;
+
+template <typename Specialization>
+constexpr bool kHasImageRank<
+    Specialization,
+    std::void_t<decltype(std::declval<const Specialization&>().rank())>> =
+    true;
+
+// Returns the rank of the array read by `specialization`, which is 3
+// (y, x, channel) unless the specialization defines a `rank()` method, for
+// example to expose multiple images as additional leading dimensions.
+template <typename Specialization>
+DimensionIndex GetImageRank(const Specialization& specialization) {
+  if constexpr (kHasImageRank<Specialization>) {
+    return specialization.rank();
+  } else {
+    return 3;
+  }
+}
+
 template <typename Specialization>
 class ImageDriverSpec
     : public internal::RegisteredDriverSpec<ImageDriverSpec<Specialization>,
@@ -115,9 +168,9 @@ class ImageDriverSpec
              x.specialization);
   };
 
-  static absl::Status ValidateSchema(Schema& schema) {
+  static absl::Status ValidateSchema(Schema& schema, DimensionIndex rank) {
     TENSORSTORE_RETURN_IF_ERROR(schema.Set(dtype_v<uint8_t>));
-    TENSORSTORE_RETURN_IF_ERROR(schema.Set(RankConstraint{3}));
+    TENSORSTORE_RETURN_IF_ERROR(schema.Set(RankConstraint{rank}));
     if (schema.codec().valid()) {
       return absl::InvalidArgumentError(
           absl::StrFormat("codec not supported by %v driver", QuoteString(id)));
@@ -136,8 +189,11 @@ class ImageDriverSpec
         return absl::InvalidArgumentError("image domain must have 0-origin");
       }
     } else {
-      TENSORSTORE_RETURN_IF_ERROR(schema.Set(
-          IndexDomainBuilder<3>().origin({0, 0, 0}).Finalize().value()));
+      TENSORSTORE_RETURN_IF_ERROR(
+          schema.Set(IndexDomainBuilder(rank)
+                         .origin(std::vector<Index>(rank, 0))
+                         .Finalize()
+                         .value()));
     }
 
     // TODO: validate schema fields:
@@ -148,10 +204,6 @@ class ImageDriverSpec
 
   constexpr static auto default_json_binder =
       tensorstore::internal_json_binding::Sequence(
-          tensorstore::internal_json_binding::Initialize(
-              [](auto* obj) -> absl::Status {
-                return ValidateSchema(obj->schema);
-              }),
           tensorstore::internal_json_binding::Member(
               internal::DataCopyConcurrencyResource::id,
               tensorstore::internal_json_binding::Projection<
@@ -169,8 +221,14 @@ class ImageDriverSpec
                   tensorstore::internal_json_binding::DefaultValue(
                       [](auto* obj) { obj->bounded_by_open_time = true; }))),
           tensorstore::internal_json_binding::Projection<
-              &SpecType::specialization>()  //
-      );
+              &SpecType::specialization>(),
+          // The rank depends on the specialization, so the schema is
+          // validated last.
+          tensorstore::internal_json_binding::Initialize(
+              [](auto* obj) -> absl::Status {
+                return ValidateSchema(obj->schema,
+                                      GetImageRank(obj->specialization));
+              }));
 
   absl::Status ApplyOptions(SpecOptions&& options) override {
     // An image file contains both the data and the metadata, so set the
@@ -191,7 +249,7 @@ class ImageDriverSpec
       }
       store = std::move(options.kvstore);
     }
-    return ValidateSchema(options);
+    return ValidateSchema(options, GetImageRank(specialization));
   }
 
   kvstore::Spec GetKvstore() const override { return store; }
@@ -210,8 +268,8 @@ class ImageDriverSpec
     TENSORSTORE_RETURN_IF_ERROR(EnsureNoPathOrQueryOrFragment(parsed));
 
     auto driver_spec = internal::MakeIntrusivePtr<SpecType>();
-    TENSORSTORE_RETURN_IF_ERROR(
-        driver_spec->ValidateSchema(driver_spec->schema));
+    TENSORSTORE_RETURN_IF_ERROR(driver_spec->ValidateSchema(
+        driver_spec->schema, GetImageRank(driver_spec->specialization)));
     driver_spec->store = std::move(base);
     driver_spec->data_copy_concurrency =
         decltype(driver_spec->data_copy_concurrency)::DefaultSpec();
@@ -238,7 +296,7 @@ class ImageCache : public internal::KvsBackedCache<ImageCache<Specialization>,
                                                  internal::AsyncCache>;
 
  public:
-  using ReadData = tensorstore::SharedArray<const uint8_t, 3>;
+  using ReadData = typename ImageReadDataTraits<Specialization>::ReadData;
   using CacheType = ImageCache<Specialization>;
   using LockType = internal::AsyncCache::ReadLock<typename CacheType::ReadData>;
   using EncodeOptions = typename Base::EncodeOptions;
@@ -314,6 +372,119 @@ class ImageCache : public internal::KvsBackedCache<ImageCache<Specialization>,
   Specialization specialization_;
 };
 
+// Cache of the decoded chunks of a single image entry, used by
+// specializations which decode by chunk (see `ImageReadDataTraits`).  The
+// chunk grid is fixed when the cache is created; a chunk read fails if the
+// layout of the underlying image has since changed.
+template <typename Specialization>
+class ImageChunkCache : public internal::ConcreteChunkCache {
+  using Base = internal::ConcreteChunkCache;
+
+ public:
+  using ImageCacheType = ImageCache<Specialization>;
+  using ImageLockType =
+      internal::AsyncCache::ReadLock<typename ImageCacheType::ReadData>;
+
+  using Base::Base;
+
+  class Entry : public internal::ChunkCache::Entry {
+   public:
+    using OwningCache = ImageChunkCache;
+    using internal::ChunkCache::Entry::Entry;
+
+    void DoRead(internal::AsyncCache::AsyncCacheReadRequest request) override {
+      internal::AsyncCache::AsyncCacheReadRequest image_request;
+      image_request.staleness_bound = request.staleness_bound;
+      image_request.batch = std::move(request.batch);
+      // `this` is guaranteed to remain valid until `ReadSuccess` or
+      // `ReadError` is called.
+      GetOwningCache(*this)
+          .image_entry_->Read(std::move(image_request))
+          .ExecuteWhenReady([this](ReadyFuture<const void> future) {
+            if (auto& r = future.result(); !r.ok()) {
+              this->ReadError(r.status());
+              return;
+            }
+            GetOwningCache(*this).executor()([this] { DecodeChunk(); });
+          });
+    }
+
+   private:
+    void DecodeChunk() {
+      auto& cache = GetOwningCache(*this);
+      std::shared_ptr<const typename ImageCacheType::ReadData> image;
+      TimestampedStorageGeneration stamp;
+      {
+        ImageLockType lock{*cache.image_entry_};
+        image = lock.shared_data();
+        stamp = lock.stamp();
+      }
+      const auto& component_spec = cache.grid().components.front();
+      tensorstore::span<const Index> cell_shape = component_spec.shape();
+      if (!image ||
+          BoxView<>(image->domain()) !=
+              component_spec.array_spec.valid_data_bounds ||
+          !std::equal(cell_shape.begin(), cell_shape.end(),
+                      image->chunk_shape().begin())) {
+        this->ReadError(absl::FailedPreconditionError(
+            "Image layout changed after it was opened"));
+        return;
+      }
+      auto decoded = cache.specialization_.DecodeRegion(
+          *image, cache.grid().GetValidCellDomain(0, this->cell_indices()));
+      if (!decoded.ok()) {
+        this->ReadError(std::move(decoded).status());
+        return;
+      }
+      // `ChunkCache` requires arrays of the full chunk shape; chunks at the
+      // edge of the image are zero-padded.
+      SharedArray<const void> full_array = *decoded;
+      if (!std::equal(cell_shape.begin(), cell_shape.end(),
+                      decoded->shape().begin())) {
+        auto padded = AllocateArray<uint8_t>(cell_shape, c_order, value_init);
+        CopyArray(*decoded,
+                  ArrayView<uint8_t>(
+                      padded.data(), StridedLayoutView<>(
+                                         decoded->shape(),
+                                         padded.byte_strides())));
+        full_array = std::move(padded);
+      }
+      auto read_data = internal::make_shared_for_overwrite<
+          internal::ChunkCache::ReadData[]>(1);
+      read_data.get()[0] = std::move(full_array);
+      this->ReadSuccess({std::move(read_data), std::move(stamp)});
+    }
+  };
+
+  class TransactionNode : public internal::ChunkCache::TransactionNode {
+   public:
+    using OwningCache = ImageChunkCache;
+    using internal::ChunkCache::TransactionNode::TransactionNode;
+
+    void DoRead(internal::AsyncCache::AsyncCacheReadRequest request) override {
+      this->ReadError(
+          absl::UnimplementedError(Specialization::kTransactionError));
+    }
+
+    void Commit() override {
+      this->SetError(
+          absl::UnimplementedError(Specialization::kTransactionError));
+      this->WritebackError();
+    }
+  };
+
+  Entry* DoAllocateEntry() final { return new Entry; }
+  size_t DoGetSizeofEntry() final { return sizeof(Entry); }
+  TransactionNode* DoAllocateTransactionNode(
+      internal::AsyncCache::Entry& entry) final {
+    return new TransactionNode(static_cast<Entry&>(entry));
+  }
+
+  // Entry holding the encoded image.
+  internal::PinnedCacheEntry<ImageCacheType> image_entry_;
+  Specialization specialization_;
+};
+
 template <typename Specialization>
 class ImageDriver
     : public internal::RegisteredDriver<ImageDriver<Specialization>,
@@ -334,11 +505,12 @@ class ImageDriver
                    std::string(cache_entry_->key()), transaction);
   }
 
-  // FIXME: Current image formats are restricted to rank3 (y,x,channels) and
-  // uint8_t data, but there are image types which support a much wider array
-  // of dtype(), and some which support multiple z levels encoded as one image.
+  // FIXME: Current image formats are restricted to uint8_t data, but there
+  // are image types which support a much wider array of dtype().
   DataType dtype() override { return dtype_v<uint8_t>; }
-  DimensionIndex rank() override { return 3; }  // COV_NF_LINE
+  DimensionIndex rank() override {
+    return GetImageRank(GetOwningCache(*cache_entry_).specialization_);
+  }
 
   Executor data_copy_executor() override {
     return GetOwningCache(*cache_entry_).executor();
@@ -346,7 +518,7 @@ class ImageDriver
 
   Result<ChunkLayout> GetChunkLayout(IndexTransformView<> transform) override {
     ChunkLayout layout;
-    layout.Set(RankConstraint{3}).IgnoreError();
+    layout.Set(RankConstraint{rank()}).IgnoreError();
     return layout | transform;
   }
 
@@ -363,6 +535,10 @@ class ImageDriver
             AnyFlowReceiver<absl::Status, internal::ReadChunk, IndexTransform<>>
                 receiver) override;
 
+  // Returns the chunk cache for the current layout of the image.  Must only
+  // be called once `cache_entry_` has been read successfully.
+  internal::CachePtr<ImageChunkCache<Specialization>> GetChunkCache();
+
   internal::PinnedCacheEntry<CacheType> cache_entry_;
   StalenessBound data_staleness_;
 };
@@ -470,9 +646,10 @@ ImageDriver<Specialization>::GetBoundSpec(
   driver_spec->store.path = cache_entry_->key();
   driver_spec->data_copy_concurrency = cache.data_copy_concurrency_;
   driver_spec->cache_pool = cache.cache_pool_;
+  driver_spec->specialization = cache.specialization_;
   /// TODO: Fill from pinned entry.
   driver_spec->data_staleness = data_staleness_;
-  driver_spec->schema.Set(RankConstraint{3}).IgnoreError();
+  driver_spec->schema.Set(RankConstraint{rank()}).IgnoreError();
   driver_spec->schema.Set(dtype_v<uint8_t>).IgnoreError();
   internal::TransformedDriverSpec spec;
   spec.driver_spec = std::move(driver_spec);
@@ -584,31 +761,100 @@ void ImageDriver<Specialization>::Read(
     return;
   }
 
-  internal::ReadChunk chunk;
-  chunk.impl = ReadChunkImpl<Specialization>{
-      internal::IntrusivePtr<ImageDriver>(this), cache_entry_};
-  chunk.transform = std::move(request.transform);
+  if constexpr (ImageReadDataTraits<Specialization>::kDecodeByChunk) {
+    // Read the encoded image first, since the chunk grid depends on its
+    // layout; only the chunks that intersect the request are then decoded.
+    internal::AsyncCache::AsyncCacheReadRequest read_request;
+    read_request.staleness_bound = data_staleness_.time;
+    read_request.batch = request.batch;
+    auto read_future = cache_entry_->Read(std::move(read_request));
+    read_future.ExecuteWhenReady(
+        [self = internal::IntrusivePtr<ImageDriver>(this),
+         request = std::move(request), receiver = std::move(receiver)](
+            ReadyFuture<const void> future) mutable {
+          auto& r = future.result();
+          if (!r.ok()) {
+            execution::set_starting(receiver, [] {});
+            execution::set_error(receiver, r.status());
+            execution::set_stopping(receiver);
+            return;
+          }
+          self->GetChunkCache()->Read(
+              {std::move(request), /*component_index=*/0,
+               self->data_staleness_.time},
+              std::move(receiver));
+        });
+  } else {
+    internal::ReadChunk chunk;
+    chunk.impl = ReadChunkImpl<Specialization>{
+        internal::IntrusivePtr<ImageDriver>(this), cache_entry_};
+    chunk.transform = std::move(request.transform);
+
+    // TODO: Wire in execution::set_cancel correctly.
+    execution::set_starting(receiver, [] {});
+    internal::AsyncCache::AsyncCacheReadRequest read_request;
+    read_request.staleness_bound = data_staleness_.time;
+    read_request.batch = request.batch;
+    auto read_future = cache_entry_->Read(std::move(read_request));
+    read_future.ExecuteWhenReady([chunk = std::move(chunk),
+                                  receiver = std::move(receiver)](
+                                     ReadyFuture<const void> future) mutable {
+      auto& r = future.result();
+      if (!r.ok()) {
+        execution::set_error(receiver, r.status());
+      } else {
+        auto cell_transform =
+            IdentityTransform(chunk.transform.input_domain());
+        execution::set_value(receiver, std::move(chunk),
+                             std::move(cell_transform));
+        execution::set_done(receiver);
+      }
+      execution::set_stopping(receiver);
+    });
+  }
+}
 
-  // TODO: Wire in execution::set_cancel correctly.
-  execution::set_starting(receiver, [] {});
-  internal::AsyncCache::AsyncCacheReadRequest read_request;
-  read_request.staleness_bound = data_staleness_.time;
-  read_request.batch = request.batch;
-  auto read_future = cache_entry_->Read(std::move(read_request));
-  read_future.ExecuteWhenReady([chunk = std::move(chunk),
-                                receiver = std::move(receiver)](
-                                   ReadyFuture<const void> future) mutable {
-    auto& r = future.result();
-    if (!r.ok()) {
-      execution::set_error(receiver, r.status());
-    } else {
-      auto cell_transform = IdentityTransform(chunk.transform.input_domain());
-      execution::set_value(receiver, std::move(chunk),
-                           std::move(cell_transform));
-      execution::set_done(receiver);
-    }
-    execution::set_stopping(receiver);
-  });
+template <typename Specialization>
+internal::CachePtr<ImageChunkCache<Specialization>>
+ImageDriver<Specialization>::GetChunkCache() {
+  using ChunkCacheType = ImageChunkCache<Specialization>;
+  std::shared_ptr<const typename CacheType::ReadData> image;
+  {
+    LockType lock{*cache_entry_};
+    image = lock.shared_data();
+  }
+  assert(image);
+  auto& cache = GetOwningCache(*cache_entry_);
+  const BoxView<> domain = image->domain();
+  const tensorstore::span<const Index> chunk_shape = image->chunk_shape();
+  std::string cache_identifier;
+  internal::EncodeCacheKey(
+      &cache_identifier, cache.cache_identifier(), cache_entry_->key(),
+      std::vector<Index>(domain.shape().begin(), domain.shape().end()),
+      std::vector<Index>(chunk_shape.begin(), chunk_shape.end()));
+  return internal::GetCache<ChunkCacheType>(
+      cache.cache_pool_->get(), cache_identifier, [&] {
+        // The fill value is never observed, since every chunk within the
+        // image bounds is decoded, but the chunk cache requires one.
+        auto fill_value =
+            BroadcastArray(AllocateArray(/*shape=*/tensorstore::span<
+                                             const Index>{},
+                                         c_order, value_init,
+                                         dtype_v<uint8_t>),
+                           BoxView<>(domain.rank()))
+                .value();
+        internal::ChunkGridSpecification::ComponentList components;
+        components.emplace_back(
+            internal::AsyncWriteArray::Spec{std::move(fill_value),
+                                            Box<>(domain)},
+            std::vector<Index>(chunk_shape.begin(), chunk_shape.end()));
+        auto chunk_cache = std::make_unique<ChunkCacheType>(
+            internal::ChunkGridSpecification(std::move(components)),
+            cache.executor());
+        chunk_cache->image_entry_ = cache_entry_;
+        chunk_cache->specialization_ = cache.specialization_;
+        return chunk_cache;
+      });
 }
 
 }  // namespace
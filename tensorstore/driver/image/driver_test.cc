@@ -20,11 +20,14 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/flags/flag.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include <nlohmann/json.hpp>
+#include "riegeli/bytes/fd_reader.h"
+#include "riegeli/bytes/read_all.h"
 #include "tensorstore/array.h"
 #include "tensorstore/box.h"
 #include "tensorstore/context.h"
@@ -32,6 +35,7 @@
 #include "tensorstore/driver/image/test_image.h"
 #include "tensorstore/index.h"
 #include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/internal/path.h"
 #include "tensorstore/internal/testing/json_gtest.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/operations.h"
@@ -44,6 +48,9 @@
 #include "tensorstore/util/status.h"
 #include "tensorstore/util/status_testutil.h"
 
+ABSL_FLAG(std::string, tensorstore_test_data_dir, ".",
+          "Path to directory containing test data.");
+
 namespace {
 
 using ::tensorstore::Context;
@@ -306,6 +313,23 @@ TEST_P(ImageDriverReadTest, ReadWithTransform) {
   EXPECT_THAT(array[0][0], tensorstore::MakeArray<uint8_t>(GetParam().b));
 }
 
+TEST_P(ImageDriverReadTest, ReadRegionMatchesFullRead) {
+  auto spec = GetSpec();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto context, PrepareTest(spec));
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store,
+                                   tensorstore::Open(spec, context).result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto full,
+                                   tensorstore::Read(store).result());
+
+  // Read a region which is not aligned to any tile or strip boundary.
+  auto region = tensorstore::Dims(0, 1).SizedInterval({37, 61}, {101, 150});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto array, tensorstore::Read(store | region).result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto expected, full | region);
+  EXPECT_EQ(expected, array);
+}
+
 TEST_P(ImageDriverReadTest, ReadTransactionError) {
   auto spec = GetSpec();
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto context, PrepareTest(spec));
@@ -400,4 +424,93 @@ TEST(ImageDriverErrors, DimensionUnits) {
 
 // TODO: schema.fill_value
 
+class TiffStackTest : public ::testing::Test {
+ public:
+  ::nlohmann::json GetSpec(::nlohmann::json options) {
+    ::nlohmann::json spec{
+        {"driver", "tiff"},
+        {"kvstore", {{"driver", "memory"}, {"path", "stack.tiff"}}},
+    };
+    spec.update(options);
+    return spec;
+  }
+
+  void SetUp() override {
+    absl::Cord file_data;
+    std::string filename = tensorstore::internal::JoinPath(
+        absl::GetFlag(FLAGS_tensorstore_test_data_dir),
+        "tiff/D75_08b_3page.tiff");
+    TENSORSTORE_ASSERT_OK(
+        riegeli::ReadAll(riegeli::FdReader(filename), file_data));
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto kvs,
+        tensorstore::kvstore::Open(GetSpec({}).at("kvstore"), context_)
+            .result());
+    TENSORSTORE_ASSERT_OK(tensorstore::kvstore::Write(kvs, {}, file_data));
+  }
+
+  Context context_ = Context::Default();
+};
+
+TEST_F(TiffStackTest, OpenAndResolveBounds) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(GetSpec({{"stack_pages", true}}), context_).result());
+  EXPECT_EQ(4, store.rank());
+  EXPECT_EQ(tensorstore::Box({3, 172, 306, 3}), store.domain().box());
+}
+
+TEST_F(TiffStackTest, ReadMatchesPage) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(GetSpec({{"stack_pages", true}}), context_).result());
+  for (Index z : {2, 0, 1}) {
+    SCOPED_TRACE(absl::StrCat("page=", z));
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto page_store,
+        tensorstore::Open(GetSpec({{"page", z}}), context_).result());
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto expected,
+        tensorstore::Read(page_store | tensorstore::Dims(0, 1).SizedInterval(
+                                           {10, 20}, {100, 200}))
+            .result());
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto actual,
+        tensorstore::Read(store | tensorstore::Dims(0).IndexSlice(z) |
+                          tensorstore::Dims(0, 1).SizedInterval({10, 20},
+                                                                {100, 200}))
+            .result());
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+TEST_F(TiffStackTest, MultiPageRequiresPageOrStack) {
+  EXPECT_THAT(tensorstore::Open(GetSpec({}), context_).result(),
+              StatusIs(absl::StatusCode::kDataLoss, HasSubstr("stack_pages")));
+}
+
+TEST_F(TiffStackTest, PageAndStackPagesConflict) {
+  EXPECT_THAT(
+      tensorstore::Open(GetSpec({{"page", 0}, {"stack_pages", true}}), context_)
+          .result(),
+      StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("stack_pages")));
+}
+
+TEST_F(TiffStackTest, SpecRoundtrip) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(GetSpec({{"stack_pages", true}}), context_).result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto spec, store.spec());
+  EXPECT_THAT(spec.ToJson(),
+              ::testing::Optional(MatchesJson(::nlohmann::json{
+                  {"driver", "tiff"},
+                  {"dtype", "uint8"},
+                  {"kvstore", {{"driver", "memory"}, {"path", "stack.tiff"}}},
+                  {"stack_pages", true},
+                  {"transform",
+                   {{"input_exclusive_max", {3, 172, 306, 3}},
+                    {"input_inclusive_min", {0, 0, 0, 0}}}},
+              })));
+}
+
 }  // namespace
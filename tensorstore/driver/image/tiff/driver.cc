@@ -15,26 +15,31 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <array>
+#include <algorithm>
+#include <memory>
 #include <optional>
 #include <utility>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
 #include "riegeli/bytes/cord_reader.h"
-#include "riegeli/bytes/cord_writer.h"
 #include "tensorstore/array.h"
+#include "tensorstore/box.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/driver/image/driver_impl.h"
 #include "tensorstore/driver/registry.h"
 #include "tensorstore/index.h"
 #include "tensorstore/internal/image/image_info.h"
 #include "tensorstore/internal/image/tiff_reader.h"
-#include "tensorstore/internal/image/tiff_writer.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/json_binding/std_optional.h"  // IWYU pragma: keep
 #include "tensorstore/kvstore/auto_detect.h"
 #include "tensorstore/serialization/std_optional.h"  // IWYU pragma: keep
+#include "tensorstore/util/division.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
@@ -46,20 +51,90 @@ namespace {
 
 using ::tensorstore::internal_image::ImageInfo;
 using ::tensorstore::internal_image::TiffReader;
-using ::tensorstore::internal_image::TiffWriter;
+using ::tensorstore::internal_image::TiffReaderOptions;
 
 namespace jb = tensorstore::internal_json_binding;
 
 // NOTE: There are quite a few improvements to be made to the tiff driver,
 // such as:
-// * The driver should allow reading "all" image pages, and
-//   perhaps even listing them. This would require that they
-//   all have the same dimensions and data types.
+// * The driver should allow listing image pages.
 // * The driver should expose more than just uint8.
 
 struct TiffReadOptions {
   // The TIFF directory to read.
   std::optional<int> page;
+
+  // Read all TIFF directories as a stack of pages, indexed by an additional
+  // leading dimension.
+  bool stack_pages = false;
+};
+
+// Minimum number of decoded bytes in a chunk of an image stored as strips.
+// Strips commonly hold a single row, so consecutive strips are grouped into
+// chunks of at least this size (or of the whole page).
+constexpr Index kMinStripChunkBytes = Index{1} << 20;
+
+// A `TiffReader` whose header and current directory have been parsed.
+struct PooledTiffReader {
+  explicit PooledTiffReader(absl::Cord encoded)
+      : buffer_reader(std::move(encoded)) {}
+
+  // `reader` refers to `buffer_reader`, so neither may be moved.
+  PooledTiffReader(const PooledTiffReader&) = delete;
+  PooledTiffReader& operator=(const PooledTiffReader&) = delete;
+
+  riegeli::CordReader<absl::Cord> buffer_reader;
+  TiffReader reader;
+
+  // For a stack, the directory offset of the page selected in `reader`.
+  std::optional<uint64_t> page_offset;
+};
+
+// Idle readers of a single encoded image.  Parsing a directory reads its
+// strip or tile offset and byte count arrays, which may be large, so readers
+// are reused across chunks rather than re-parsed for every chunk decoded.
+class TiffReaderPool {
+ public:
+  std::unique_ptr<PooledTiffReader> Acquire() {
+    absl::MutexLock lock(mutex_);
+    if (readers_.empty()) return nullptr;
+    auto reader = std::move(readers_.back());
+    readers_.pop_back();
+    return reader;
+  }
+
+  void Release(std::unique_ptr<PooledTiffReader> reader) {
+    absl::MutexLock lock(mutex_);
+    readers_.push_back(std::move(reader));
+  }
+
+ private:
+  absl::Mutex mutex_;
+  std::vector<std::unique_ptr<PooledTiffReader>> readers_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+// A TIFF page, or stack of pages, whose header has been parsed, but whose
+// pixels are decoded on demand, one chunk at a time.
+struct TiffImage {
+  absl::Cord encoded;
+
+  // Domain of the (y, x, c) image, or of the (z, y, x, c) stack of pages.
+  Box<> domain_box;
+
+  // Shape of each chunk of a single page: one tile, or a group of
+  // consecutive strips.
+  std::vector<Index> tile_shape;
+
+  // For a stack, the file offset of each page's directory, indexed by z, so
+  // that decoding a page does not read the directories that precede it.
+  std::vector<uint64_t> page_offsets;
+
+  // Readers shared by the chunks decoded from `encoded`.
+  std::shared_ptr<TiffReaderPool> readers;
+
+  BoxView<> domain() const { return domain_box; }
+  tensorstore::span<const Index> chunk_shape() const { return tile_shape; }
 };
 
 struct TiffSpecialization : public TiffReadOptions {
@@ -67,74 +142,172 @@ struct TiffSpecialization : public TiffReadOptions {
   constexpr static char kTransactionError[] =
       "\"tiff\" driver does not support transactions";
 
+  using EncodedImage = TiffImage;
+
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
-    return f(x.page);
+    return f(x.page, x.stack_pages);
   };
 
-  constexpr static auto default_json_binder =
-      jb::Member("page", jb::Projection(&TiffReadOptions::page));
+  constexpr static auto default_json_binder = jb::Sequence(
+      jb::Member("page", jb::Projection(&TiffReadOptions::page)),
+      jb::Member("stack_pages",
+                 jb::Projection(&TiffReadOptions::stack_pages,
+                                jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                                    [](auto* v) { *v = false; }))),
+      jb::Initialize([](auto* obj) -> absl::Status {
+        if (obj->page.has_value() && obj->stack_pages) {
+          return absl::InvalidArgumentError(
+              "\"page\" and \"stack_pages\" cannot both be specified");
+        }
+        return absl::OkStatus();
+      }));
 
-  Result<absl::Cord> EncodeImage(ArrayView<const void, 3> array_yxc) const {
-    if (page != 1) {
-      return absl::InvalidArgumentError(
-          "\"tiff\" driver cannot write to specified page");
-    }
+  DimensionIndex rank() const { return stack_pages ? 4 : 3; }
 
-    auto shape_yxc = array_yxc.shape();
-    ImageInfo info{/*.height =*/static_cast<int32_t>(shape_yxc[0]),
-                   /*.width =*/static_cast<int32_t>(shape_yxc[1]),
-                   /*.num_components =*/static_cast<int32_t>(shape_yxc[2])};
-
-    absl::Cord output;
-    riegeli::CordWriter riegeli_writer(&output);
-
-    TiffWriter writer;
-    TENSORSTORE_RETURN_IF_ERROR(writer.Initialize(&riegeli_writer));
-    TENSORSTORE_RETURN_IF_ERROR(writer.Encode(
-        info, tensorstore::span(
-                  reinterpret_cast<const unsigned char*>(array_yxc.data()),
-                  array_yxc.num_elements() * array_yxc.dtype().size())));
-    TENSORSTORE_RETURN_IF_ERROR(writer.Done());
-    return output;
+  Result<absl::Cord> EncodeImage(const TiffImage& image) const {
+    // Writing is not supported; the encoded image is returned unchanged.
+    return image.encoded;
   }
 
-  Result<SharedArray<uint8_t, 3>> DecodeImage(absl::Cord value) {
-    SharedArray<uint8_t, 3> array_yxc;
+  // Parses the header of the selected page, or builds the index of all pages
+  // when stacking, without decoding any pixels.
+  Result<TiffImage> DecodeImage(absl::Cord value) {
+    TiffImage image;
+    auto pooled = std::make_unique<PooledTiffReader>(value);
     auto status = [&]() -> absl::Status {
-      riegeli::CordReader<> buffer_reader(&value);
-      TiffReader reader;
-
-      TENSORSTORE_RETURN_IF_ERROR(reader.Initialize(&buffer_reader));
-
-      if (page.has_value()) {
-        TENSORSTORE_RETURN_IF_ERROR(reader.SeekFrame(*page));
-      } else if (reader.GetFrameCount() > 1) {
-        // TIFF files often have embedded thumbnails, etc. This driver doesn't
-        // attempt to guess which pages are the correct one.
-        return absl::DataLossError(
-            "Multi-page TIFF image encountered without a \"page\" specifier. ");
+      TiffReader& reader = pooled->reader;
+      TENSORSTORE_RETURN_IF_ERROR(reader.Initialize(&pooled->buffer_reader));
+      if (stack_pages) {
+        TENSORSTORE_ASSIGN_OR_RETURN(image.page_offsets,
+                                     reader.GetFrameOffsets());
+        TENSORSTORE_RETURN_IF_ERROR(
+            reader.SeekFrameOffset(image.page_offsets[0]));
+        pooled->page_offset = image.page_offsets[0];
+      } else {
+        TENSORSTORE_RETURN_IF_ERROR(SelectPage(reader));
       }
       ImageInfo info = reader.GetImageInfo();
       if (info.dtype != dtype_v<uint8_t>) {
         return absl::UnimplementedError(
             "\"tiff\" driver only supports uint8 images");
       }
-      std::array<Index, 3> shape_yxc = {
-          static_cast<Index>(info.height), static_cast<Index>(info.width),
-          static_cast<Index>(info.num_components)};
-      array_yxc = AllocateArray<uint8_t>(shape_yxc);
-      return reader.Decode(tensorstore::span(
-          reinterpret_cast<unsigned char*>(array_yxc.data()),
-          array_yxc.num_elements() * array_yxc.dtype().size()));
+      TENSORSTORE_ASSIGN_OR_RETURN(auto layout, reader.GetTileLayout());
+      std::vector<Index> shape = {static_cast<Index>(info.height),
+                                  static_cast<Index>(info.width),
+                                  static_cast<Index>(info.num_components)};
+      Index chunk_height = layout.tile_height;
+      if (!layout.tiled) {
+        const Index strip_bytes = std::max<Index>(
+            1, chunk_height * shape[1] * shape[2]);
+        chunk_height = std::clamp<Index>(
+            chunk_height * CeilOfRatio(kMinStripChunkBytes, strip_bytes), 1,
+            std::max<Index>(1, shape[0]));
+      }
+      image.tile_shape = {chunk_height,
+                          static_cast<Index>(layout.tile_width),
+                          static_cast<Index>(info.num_components)};
+      if (stack_pages) {
+        // Each chunk holds a single page; the other pages are not validated
+        // until they are decoded.
+        shape.insert(shape.begin(),
+                     static_cast<Index>(image.page_offsets.size()));
+        image.tile_shape.insert(image.tile_shape.begin(), 1);
+      }
+      image.domain_box = Box<>(shape);
+      return absl::OkStatus();
     }();
-    if (!status.ok()) {
-      if (status.code() == absl::StatusCode::kInvalidArgument) {
-        return StatusBuilder(std::move(status))
-            .SetCode(absl::StatusCode::kDataLoss);
+    TENSORSTORE_RETURN_IF_ERROR(ToDataLoss(std::move(status)));
+    image.encoded = std::move(value);
+    image.readers = std::make_shared<TiffReaderPool>();
+    image.readers->Release(std::move(pooled));
+    return image;
+  }
+
+  // Decodes `region` of `image`, reading only the tiles or strips which
+  // intersect it.
+  Result<SharedArray<uint8_t>> DecodeRegion(const TiffImage& image,
+                                            BoxView<> region) const {
+    SharedArray<uint8_t> array;
+    auto pooled = image.readers->Acquire();
+    auto status = [&]() -> absl::Status {
+      if (!pooled) {
+        // All existing readers are in use by concurrent decodes.
+        pooled = std::make_unique<PooledTiffReader>(image.encoded);
+        TENSORSTORE_RETURN_IF_ERROR(
+            pooled->reader.Initialize(&pooled->buffer_reader));
+        if (!stack_pages) {
+          TENSORSTORE_RETURN_IF_ERROR(SelectPage(pooled->reader));
+        }
       }
-      return status;
+      TiffReader& reader = pooled->reader;
+      array = AllocateArray<uint8_t>(region.shape());
+
+      // The last three dimensions are (y, x, c).
+      const DimensionIndex y_dim = region.rank() - 3;
+      TiffReaderOptions options;
+      options.region = TiffReaderOptions::Region{
+          /*.x=*/static_cast<int32_t>(region.origin()[y_dim + 1]),
+          /*.y=*/static_cast<int32_t>(region.origin()[y_dim]),
+          /*.width=*/static_cast<int32_t>(region.shape()[y_dim + 1]),
+          /*.height=*/static_cast<int32_t>(region.shape()[y_dim])};
+      const Index page_bytes = region.shape()[y_dim] *
+                               region.shape()[y_dim + 1] *
+                               region.shape()[y_dim + 2];
+      const Index num_pages = stack_pages ? region.shape()[0] : 1;
+      for (Index i = 0; i < num_pages; ++i) {
+        if (stack_pages) {
+          const Index z = region.origin()[0] + i;
+          if (pooled->page_offset != image.page_offsets[z]) {
+            pooled->page_offset = std::nullopt;
+            TENSORSTORE_RETURN_IF_ERROR(
+                reader.SeekFrameOffset(image.page_offsets[z]));
+            ImageInfo info = reader.GetImageInfo();
+            if (info.height != image.domain_box.shape()[1] ||
+                info.width != image.domain_box.shape()[2] ||
+                info.num_components != image.domain_box.shape()[3] ||
+                info.dtype != dtype_v<uint8_t>) {
+              return absl::DataLossError(absl::StrFormat(
+                  "TIFF page %d has image info %v, which differs from page 0",
+                  z, info));
+            }
+            pooled->page_offset = image.page_offsets[z];
+          }
+        }
+        TENSORSTORE_RETURN_IF_ERROR(reader.Decode(
+            tensorstore::span(
+                reinterpret_cast<unsigned char*>(array.data()) +
+                    i * page_bytes,
+                page_bytes),
+            options));
+      }
+      return absl::OkStatus();
+    }();
+    // A reader that failed is in an unknown state and is discarded.
+    TENSORSTORE_RETURN_IF_ERROR(ToDataLoss(std::move(status)));
+    image.readers->Release(std::move(pooled));
+    return array;
+  }
+
+ private:
+  absl::Status SelectPage(TiffReader& reader) const {
+    if (page.has_value()) {
+      TENSORSTORE_RETURN_IF_ERROR(reader.SeekFrame(*page));
+    } else if (reader.GetFrameCount() > 1) {
+      // TIFF files often have embedded thumbnails, etc. This driver doesn't
+      // attempt to guess which pages are the correct one.
+      return absl::DataLossError(
+          "Multi-page TIFF image encountered without a \"page\" or "
+          "\"stack_pages\" specifier. ");
+    }
+    return absl::OkStatus();
+  }
+
+  static absl::Status ToDataLoss(absl::Status status) {
+    if (status.code() == absl::StatusCode::kInvalidArgument) {
+      return StatusBuilder(std::move(status))
+          .SetCode(absl::StatusCode::kDataLoss);
     }
-    return array_yxc;
+    return status;
   }
 };
 
@@ -43,6 +43,7 @@
 #include "tensorstore/internal/nditerable_util.h"
 #include "tensorstore/internal/tagged_ptr.h"
 #include "tensorstore/internal/tracing/operation_trace_span.h"
+#include "tensorstore/internal/tracing/trace_context.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/progress.h"
 #include "tensorstore/rank.h"
@@ -234,6 +235,61 @@ struct DriverReadIntoNewInitiateOp {
   }
 };
 
+/// Local state for the asynchronous operation initiated by `DriverPrefetch`.
+///
+/// Like `ReadState`, `promise` becomes ready once all references to the state
+/// are released.  The chunks received from `Driver::Read` are discarded: by
+/// the time a chunk is received, its data has been loaded into the cache.
+struct PrefetchState : public internal::AtomicReferenceCount<PrefetchState> {
+  DriverPtr source_driver;
+  internal::OpenTransactionPtr source_transaction;
+  Batch source_batch{no_batch};
+  Promise<void> promise;
+  internal_tracing::OperationTraceSpan tspan{"tensorstore.Prefetch"};
+};
+
+/// FlowReceiver used by `DriverPrefetch`.
+struct PrefetchChunkReceiver {
+  IntrusivePtr<PrefetchState> state;
+  FutureCallbackRegistration cancel_registration;
+  void set_starting(AnyCancelReceiver cancel) {
+    cancel_registration =
+        state->promise.ExecuteWhenNotNeeded(std::move(cancel));
+  }
+  void set_stopping() { cancel_registration(); }
+  void set_done() {}
+  void set_error(absl::Status error) {
+    SetDeferredResult(state->promise, std::move(error));
+  }
+  void set_value(ReadChunk chunk, IndexTransform<> cell_transform) {}
+};
+
+/// Callback used by `DriverPrefetch` to initiate the read once the source
+/// transform bounds have been resolved.
+struct DriverPrefetchInitiateOp {
+  IntrusivePtr<PrefetchState> state;
+  void operator()(Promise<void> promise,
+                  ReadyFuture<IndexTransform<>> source_transform_future) {
+    IndexTransform<> source_transform =
+        std::move(source_transform_future.value());
+    if (!IsFinite(source_transform.domain())) {
+      promise.SetResult(absl::InvalidArgumentError(
+          absl::StrFormat("Prefetch requires a finite domain, got %v",
+                          source_transform.domain())));
+      return;
+    }
+    state->promise = std::move(promise);
+
+    auto source_driver = std::move(state->source_driver);
+    Driver::ReadRequest request;
+    request.transaction = std::move(state->source_transaction);
+    request.batch = std::move(state->source_batch);
+    request.transform = std::move(source_transform);
+    source_driver->Read(std::move(request),
+                        PrefetchChunkReceiver{std::move(state)});
+  }
+};
+
 }  // namespace
 
 Future<void> DriverRead(Executor executor, DriverHandle source,
@@ -243,6 +299,7 @@ Future<void> DriverRead(Executor executor, DriverHandle source,
       internal::ValidateSupportsRead(source.driver.read_write_mode()));
   using State = ReadState<void>;
   IntrusivePtr<State> state(new State);
+  internal_tracing::ScopedTraceContext trace_scope(state->tspan.context());
   state->executor = executor;
   TENSORSTORE_ASSIGN_OR_RETURN(
       state->data_type_conversion,
@@ -290,6 +347,7 @@ Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
       internal::ValidateSupportsRead(source.driver.read_write_mode()));
   using State = ReadState<SharedOffsetArray<void>>;
   IntrusivePtr<State> state(new State);
+  internal_tracing::ScopedTraceContext trace_scope(state->tspan.context());
   TENSORSTORE_ASSIGN_OR_RETURN(
       state->data_type_conversion,
       GetDataTypeConverterOrError(source.driver->dtype(),
@@ -332,6 +390,37 @@ Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
       std::move(executor), std::move(source), {std::move(options), dtype});
 }
 
+Future<void> DriverPrefetch(DriverHandle source, PrefetchOptions options) {
+  if (!source.valid()) {
+    return absl::InvalidArgumentError("TensorStore is not valid");
+  }
+  TENSORSTORE_RETURN_IF_ERROR(
+      internal::ValidateSupportsRead(source.driver.read_write_mode()));
+  IntrusivePtr<PrefetchState> state(new PrefetchState);
+  internal_tracing::ScopedTraceContext trace_scope(state->tspan.context());
+  auto executor = source.driver->data_copy_executor();
+  state->source_driver = std::move(source.driver);
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      state->source_transaction,
+      internal::AcquireOpenTransactionPtrOrError(source.transaction));
+  state->source_batch = std::move(options.batch);
+  auto pair = PromiseFuturePair<void>::Make(MakeResult());
+
+  // Resolve the bounds for `source.transform`.
+  Driver::ResolveBoundsRequest request;
+  request.transaction = state->source_transaction;
+  request.transform = std::move(source.transform);
+  request.options.Set(fix_resizable_bounds).IgnoreError();
+  auto transform_future =
+      state->source_driver->ResolveBounds(std::move(request));
+
+  // Initiate the read once the bounds have been resolved.
+  LinkValue(WithExecutor(std::move(executor),
+                         DriverPrefetchInitiateOp{std::move(state)}),
+            std::move(pair.promise), std::move(transform_future));
+  return std::move(pair.future);
+}
+
 absl::Status CopyReadChunk(
     ReadChunk::Impl& chunk, IndexTransform<> chunk_transform,
     const DataTypeConversionLookupResult& chunk_conversion,
@@ -85,6 +85,17 @@ Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
 Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
     DriverHandle source, ReadIntoNewArrayOptions options);
 
+/// Reads data from a TensorStore driver without copying it, in order to load
+/// it into any cache used by the driver.
+///
+/// \param source Source TensorStore.
+/// \param options Specifies options.
+/// \returns A future that becomes ready when all chunks have been read or an
+///     error occurs.
+/// \error `absl::StatusCode::kInvalidArgument` if the resolved domain of
+///     `source.transform` is not finite.
+Future<void> DriverPrefetch(DriverHandle source, PrefetchOptions options);
+
 /// Copies `chunk` transformed by `chunk_transform` to `target`.
 absl::Status CopyReadChunk(
     ReadChunk::Impl& chunk, IndexTransform<> chunk_transform,
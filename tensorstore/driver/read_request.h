@@ -27,6 +27,13 @@ struct DriverReadRequest {
   internal::OpenTransactionPtr transaction;
   IndexTransform<> transform;
   Batch batch{no_batch};
+
+  /// Indicates whether chunks cached in order to satisfy this request are
+  /// retained by the cache pool once they are no longer in use.  Specifying
+  /// `false` is a hint that the data will not be read again, for example
+  /// because each chunk is reduced as it is read; full-resolution chunks then
+  /// do not displace other cached data.
+  bool retain_cached_chunks = true;
 };
 
 }  // namespace internal
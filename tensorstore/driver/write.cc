@@ -38,6 +38,7 @@
 #include "tensorstore/internal/nditerable_util.h"
 #include "tensorstore/internal/tagged_ptr.h"
 #include "tensorstore/internal/tracing/operation_trace_span.h"
+#include "tensorstore/internal/tracing/trace_context.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/progress.h"
 #include "tensorstore/read_write_options.h"
@@ -285,6 +286,7 @@ WriteFutures DriverWrite(Executor executor,
       internal::ValidateSupportsWrite(target.driver.read_write_mode()))
       .BuildStatus();
   IntrusivePtr<WriteState> state(new WriteState);
+  internal_tracing::ScopedTraceContext trace_scope(state->tspan.context());
   state->executor = executor;
   TENSORSTORE_ASSIGN_OR_RETURN(
       state->data_type_conversion,
@@ -205,6 +205,9 @@ Result<IndexDomain<>> ZarrDriverSpec::GetDomain() const {
 Result<CodecSpec> ZarrDriverSpec::GetCodec() const {
   auto codec_spec = internal::CodecDriverSpec::Make<ZarrCodecSpec>();
   codec_spec->compressor = partial_metadata.compressor;
+  if (partial_metadata.filters) {
+    codec_spec->filters = ::nlohmann::json(*partial_metadata.filters);
+  }
   TENSORSTORE_RETURN_IF_ERROR(codec_spec->MergeFrom(schema.codec()));
   return codec_spec;
 }
@@ -0,0 +1,749 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+/// Defines the numcodecs "delta", "fixedscaleoffset", "quantize", "bitround",
+/// "shuffle" and "astype" filters for zarr.
+///
+/// The kernels operate on contiguous arrays of native-endian values and are
+/// written as simple loops without loop-carried dependencies (except for the
+/// inherently sequential "delta" decoding) so that they are auto-vectorized.
+
+#include "tensorstore/driver/zarr/filter.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/base/no_destructor.h"
+#include "absl/base/optimization.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/zarr/dtype.h"
+#include "tensorstore/internal/flat_cord_builder.h"
+#include "tensorstore/internal/json/value_as.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/json_binding/std_array.h"
+#include "tensorstore/internal/json_binding/std_optional.h"
+#include "tensorstore/internal/json_registry.h"
+#include "tensorstore/internal/meta/type_traits.h"
+#include "tensorstore/util/endian.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+
+namespace tensorstore {
+namespace internal_zarr {
+
+ZarrFilter::~ZarrFilter() = default;
+
+namespace {
+
+namespace jb = tensorstore::internal_json_binding;
+
+ZarrFilter::Registry& GetFilterRegistry() {
+  static absl::NoDestructor<ZarrFilter::Registry> registry;
+  return *registry;
+}
+
+// Data types supported by the filters that interpret their input as numbers.
+#define TENSORSTORE_INTERNAL_ZARR_FOR_EACH_FILTER_DATA_TYPE(X, ...) \
+  X(int8_t, ##__VA_ARGS__)                                          \
+  X(uint8_t, ##__VA_ARGS__)                                         \
+  X(int16_t, ##__VA_ARGS__)                                         \
+  X(uint16_t, ##__VA_ARGS__)                                        \
+  X(int32_t, ##__VA_ARGS__)                                         \
+  X(uint32_t, ##__VA_ARGS__)                                        \
+  X(int64_t, ##__VA_ARGS__)                                         \
+  X(uint64_t, ##__VA_ARGS__)                                        \
+  X(float32_t, ##__VA_ARGS__)                                       \
+  X(float64_t, ##__VA_ARGS__)                                       \
+  /**/
+
+bool IsSupportedFilterDataType(DataType dtype) {
+  switch (dtype.id()) {
+#define TENSORSTORE_INTERNAL_DO_CASE(T, ...) case DataTypeId::T:
+    TENSORSTORE_INTERNAL_ZARR_FOR_EACH_FILTER_DATA_TYPE(
+        TENSORSTORE_INTERNAL_DO_CASE)
+#undef TENSORSTORE_INTERNAL_DO_CASE
+    return true;
+    default:
+      return false;
+  }
+}
+
+bool IsFloatDataType(DataType dtype) {
+  return dtype.id() == DataTypeId::float32_t ||
+         dtype.id() == DataTypeId::float64_t;
+}
+
+/// Invokes `func(internal::type_identity<T>{})`, where `T` is the C++ type
+/// corresponding to `dtype`.
+///
+/// \pre `IsSupportedFilterDataType(dtype)`
+template <typename Func>
+Result<absl::Cord> DispatchDataType(DataType dtype, Func&& func) {
+  switch (dtype.id()) {
+#define TENSORSTORE_INTERNAL_DO_DISPATCH(T, ...) \
+  case DataTypeId::T:                            \
+    return func(internal::type_identity<::tensorstore::dtypes::T>{});
+    TENSORSTORE_INTERNAL_ZARR_FOR_EACH_FILTER_DATA_TYPE(
+        TENSORSTORE_INTERNAL_DO_DISPATCH)
+#undef TENSORSTORE_INTERNAL_DO_DISPATCH
+    default:
+      ABSL_UNREACHABLE();
+  }
+}
+
+/// JSON binder for a NumPy typestr, such as `"<f8"`, specifying one of the
+/// data types supported by the filters.
+constexpr auto FilterDTypeBinder = [](auto is_loading, const auto& options,
+                                      auto* obj, auto* j) -> absl::Status {
+  if constexpr (is_loading) {
+    std::string value;
+    TENSORSTORE_RETURN_IF_ERROR(
+        internal_json::JsonRequireValueAs(*j, &value, /*strict=*/true));
+    TENSORSTORE_ASSIGN_OR_RETURN(*obj, ParseBaseDType(value));
+    if (!obj->flexible_shape.empty() ||
+        !IsSupportedFilterDataType(obj->dtype)) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Data type not supported by filter: %s", value));
+    }
+  } else {
+    *j = obj->encoded_dtype;
+  }
+  return absl::OkStatus();
+};
+
+// Conversion of values between the supported data types, equivalent to the
+// NumPy `astype` conversion except that out-of-range floating-point values
+// saturate when converted to an integer type, rather than being undefined.
+template <typename To, typename From>
+To ConvertValue(From value) {
+  if constexpr (std::is_floating_point_v<From> && std::is_integral_v<To>) {
+    constexpr From kMin = static_cast<From>(std::numeric_limits<To>::min());
+    constexpr From kMax = static_cast<From>(std::numeric_limits<To>::max());
+    if (std::isnan(value)) return 0;
+    if (value <= kMin) return std::numeric_limits<To>::min();
+    if (value >= kMax) return std::numeric_limits<To>::max();
+    return static_cast<To>(value);
+  } else {
+    return static_cast<To>(value);
+  }
+}
+
+// Integer arithmetic wraps, as in NumPy.
+template <typename T>
+T WrappingSubtract(T a, T b) {
+  if constexpr (std::is_integral_v<T>) {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<T>(
+        static_cast<U>(static_cast<U>(a) - static_cast<U>(b)));
+  } else {
+    return a - b;
+  }
+}
+
+template <typename T>
+T WrappingAdd(T a, T b) {
+  if constexpr (std::is_integral_v<T>) {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<T>(
+        static_cast<U>(static_cast<U>(a) + static_cast<U>(b)));
+  } else {
+    return a + b;
+  }
+}
+
+// Type used for scaling computations on values of type `T`.  As in NumPy,
+// `float32` values are scaled in single precision, and all other types are
+// scaled in double precision.
+template <typename T>
+using ScaleComputationType =
+    std::conditional_t<std::is_same_v<T, float>, float, double>;
+
+template <typename T>
+void SwapBytes(T* values, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    auto* bytes = reinterpret_cast<unsigned char*>(values + i);
+    std::reverse(bytes, bytes + sizeof(T));
+  }
+}
+
+/// Returns the elements of `input`, interpreted as values of type `T` with
+/// the specified byte order, in native byte order.
+template <typename T>
+Result<std::vector<T>> ReadValues(const absl::Cord& input,
+                                  tensorstore::endian endian) {
+  if (input.size() % sizeof(T) != 0) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Filter input of %d bytes is not a multiple of the element size %d",
+        input.size(), sizeof(T)));
+  }
+  std::vector<T> values(input.size() / sizeof(T));
+  auto* output = reinterpret_cast<char*>(values.data());
+  for (std::string_view chunk : input.Chunks()) {
+    std::memcpy(output, chunk.data(), chunk.size());
+    output += chunk.size();
+  }
+  if (endian != endian::native) SwapBytes(values.data(), values.size());
+  return values;
+}
+
+/// Allocates an output buffer of `n` values of type `T`, invokes
+/// `func(T* output)` to fill it with native-endian values, and returns the
+/// values encoded with the specified byte order.
+template <typename T, typename Func>
+absl::Cord WriteValues(size_t n, tensorstore::endian endian, Func&& func) {
+  internal::FlatCordBuilder builder(n * sizeof(T));
+  T* output = reinterpret_cast<T*>(builder.data());
+  func(output);
+  if (endian != endian::native) SwapBytes(output, n);
+  return std::move(builder).Build();
+}
+
+// Filter that interprets its input according to an explicitly-specified
+// `dtype`, and produces output of type `astype`.
+struct TypedFilter : public ZarrFilter {
+  ZarrDType::BaseDType dtype;
+  std::optional<ZarrDType::BaseDType> astype;
+
+  const ZarrDType::BaseDType& encoded_dtype() const {
+    return astype ? *astype : dtype;
+  }
+
+  Result<ZarrDType::BaseDType> GetEncodedDType(
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    return encoded_dtype();
+  }
+
+  // Invokes `func(type_identity<T>, type_identity<U>)`, where `T` and `U` are
+  // the decoded and encoded C++ types, respectively.
+  template <typename Func>
+  Result<absl::Cord> Dispatch(Func&& func) const {
+    return DispatchDataType(dtype.dtype, [&](auto t) {
+      return DispatchDataType(encoded_dtype().dtype,
+                              [&](auto u) { return func(t, u); });
+    });
+  }
+};
+
+// numcodecs "delta": encodes the first value followed by the differences
+// between adjacent values.
+struct DeltaFilter : public TypedFilter {
+  Result<absl::Cord> Encode(
+      const absl::Cord& input,
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    return Dispatch([&](auto t, auto u) -> Result<absl::Cord> {
+      using T = typename decltype(t)::type;
+      using U = typename decltype(u)::type;
+      TENSORSTORE_ASSIGN_OR_RETURN(auto values,
+                                   ReadValues<T>(input, dtype.endian));
+      const size_t n = values.size();
+      const T* in = values.data();
+      return WriteValues<U>(n, encoded_dtype().endian, [&](U* out) {
+        if (n == 0) return;
+        out[0] = ConvertValue<U>(in[0]);
+        for (size_t i = 1; i < n; ++i) {
+          out[i] = ConvertValue<U>(WrappingSubtract(in[i], in[i - 1]));
+        }
+      });
+    });
+  }
+
+  Result<absl::Cord> Decode(
+      const absl::Cord& input,
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    return Dispatch([&](auto t, auto u) -> Result<absl::Cord> {
+      using T = typename decltype(t)::type;
+      using U = typename decltype(u)::type;
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto values, ReadValues<U>(input, encoded_dtype().endian));
+      const size_t n = values.size();
+      const U* in = values.data();
+      return WriteValues<T>(n, dtype.endian, [&](T* out) {
+        T sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+          sum = WrappingAdd(sum, ConvertValue<T>(in[i]));
+          out[i] = sum;
+        }
+      });
+    });
+  }
+};
+
+// numcodecs "fixedscaleoffset": encodes `round((x - offset) * scale)`.
+struct FixedScaleOffsetFilter : public TypedFilter {
+  double offset;
+  double scale;
+
+  Result<absl::Cord> Encode(
+      const absl::Cord& input,
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    return Dispatch([&](auto t, auto u) -> Result<absl::Cord> {
+      using T = typename decltype(t)::type;
+      using U = typename decltype(u)::type;
+      using C = ScaleComputationType<T>;
+      TENSORSTORE_ASSIGN_OR_RETURN(auto values,
+                                   ReadValues<T>(input, dtype.endian));
+      const size_t n = values.size();
+      const T* in = values.data();
+      const C c_offset = static_cast<C>(offset);
+      const C c_scale = static_cast<C>(scale);
+      return WriteValues<U>(n, encoded_dtype().endian, [&](U* out) {
+        for (size_t i = 0; i < n; ++i) {
+          out[i] = ConvertValue<U>(
+              std::nearbyint((static_cast<C>(in[i]) - c_offset) * c_scale));
+        }
+      });
+    });
+  }
+
+  Result<absl::Cord> Decode(
+      const absl::Cord& input,
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    return Dispatch([&](auto t, auto u) -> Result<absl::Cord> {
+      using T = typename decltype(t)::type;
+      using U = typename decltype(u)::type;
+      using C = ScaleComputationType<U>;
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto values, ReadValues<U>(input, encoded_dtype().endian));
+      const size_t n = values.size();
+      const U* in = values.data();
+      const C c_offset = static_cast<C>(offset);
+      const C c_scale = static_cast<C>(scale);
+      return WriteValues<T>(n, dtype.endian, [&](T* out) {
+        for (size_t i = 0; i < n; ++i) {
+          out[i] = ConvertValue<T>(static_cast<C>(in[i]) / c_scale + c_offset);
+        }
+      });
+    });
+  }
+};
+
+// numcodecs "quantize": rounds floating-point values to a power-of-2
+// precision corresponding to the specified number of decimal `digits`.
+struct QuantizeFilter : public TypedFilter {
+  int digits;
+
+  // Same computation as numcodecs.
+  double GetScale() const {
+    double precision = std::pow(10.0, -digits);
+    double exponent = std::log10(precision);
+    exponent = exponent < 0 ? std::floor(exponent) : std::ceil(exponent);
+    double bits = std::ceil(std::log2(std::pow(10.0, -exponent)));
+    return std::pow(2.0, bits);
+  }
+
+  Result<absl::Cord> Encode(
+      const absl::Cord& input,
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    return Dispatch([&](auto t, auto u) -> Result<absl::Cord> {
+      using T = typename decltype(t)::type;
+      using U = typename decltype(u)::type;
+      using C = ScaleComputationType<T>;
+      TENSORSTORE_ASSIGN_OR_RETURN(auto values,
+                                   ReadValues<T>(input, dtype.endian));
+      const size_t n = values.size();
+      const T* in = values.data();
+      const C scale = static_cast<C>(GetScale());
+      return WriteValues<U>(n, encoded_dtype().endian, [&](U* out) {
+        for (size_t i = 0; i < n; ++i) {
+          out[i] = ConvertValue<U>(
+              std::nearbyint(scale * static_cast<C>(in[i])) / scale);
+        }
+      });
+    });
+  }
+
+  Result<absl::Cord> Decode(
+      const absl::Cord& input,
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    return Dispatch([&](auto t, auto u) -> Result<absl::Cord> {
+      using T = typename decltype(t)::type;
+      using U = typename decltype(u)::type;
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto values, ReadValues<U>(input, encoded_dtype().endian));
+      const size_t n = values.size();
+      const U* in = values.data();
+      return WriteValues<T>(n, dtype.endian, [&](T* out) {
+        for (size_t i = 0; i < n; ++i) out[i] = ConvertValue<T>(in[i]);
+      });
+    });
+  }
+};
+
+// numcodecs "astype": converts values from `decode_dtype` to `encode_dtype`.
+struct AsTypeFilter : public ZarrFilter {
+  ZarrDType::BaseDType encode_dtype;
+  ZarrDType::BaseDType decode_dtype;
+
+  Result<ZarrDType::BaseDType> GetEncodedDType(
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    return encode_dtype;
+  }
+
+  static Result<absl::Cord> Convert(const absl::Cord& input,
+                                    const ZarrDType::BaseDType& from,
+                                    const ZarrDType::BaseDType& to) {
+    return DispatchDataType(from.dtype, [&](auto t) {
+      return DispatchDataType(to.dtype, [&](auto u) -> Result<absl::Cord> {
+        using T = typename decltype(t)::type;
+        using U = typename decltype(u)::type;
+        TENSORSTORE_ASSIGN_OR_RETURN(auto values,
+                                     ReadValues<T>(input, from.endian));
+        const size_t n = values.size();
+        const T* in = values.data();
+        return WriteValues<U>(n, to.endian, [&](U* out) {
+          for (size_t i = 0; i < n; ++i) out[i] = ConvertValue<U>(in[i]);
+        });
+      });
+    });
+  }
+
+  Result<absl::Cord> Encode(
+      const absl::Cord& input,
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    return Convert(input, decode_dtype, encode_dtype);
+  }
+
+  Result<absl::Cord> Decode(
+      const absl::Cord& input,
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    return Convert(input, encode_dtype, decode_dtype);
+  }
+};
+
+// Rounds the mantissa of IEEE 754 values, represented as unsigned integers of
+// type `Bits`, to `keepbits` bits using round-half-to-even.
+template <typename Bits>
+void BitRoundValues(Bits* values, size_t n, int maskbits) {
+  if (maskbits == 0) return;
+  const Bits mask =
+      static_cast<Bits>(std::numeric_limits<Bits>::max() << maskbits);
+  const Bits half_quantum1 =
+      static_cast<Bits>((static_cast<Bits>(1) << (maskbits - 1)) - 1);
+  for (size_t i = 0; i < n; ++i) {
+    Bits b = values[i];
+    b = static_cast<Bits>(b + ((b >> maskbits) & 1) + half_quantum1);
+    values[i] = static_cast<Bits>(b & mask);
+  }
+}
+
+// numcodecs "bitround": reduces the number of mantissa bits of floating-point
+// values to `keepbits`, which improves subsequent compression.  Decoding is a
+// no-op.
+struct BitRoundFilter : public ZarrFilter {
+  int keepbits;
+
+  static int GetMantissaBits(DataType dtype) {
+    switch (dtype.id()) {
+      case DataTypeId::float16_t:
+        return 10;
+      case DataTypeId::float32_t:
+        return 23;
+      case DataTypeId::float64_t:
+        return 52;
+      default:
+        return 0;
+    }
+  }
+
+  Result<ZarrDType::BaseDType> GetEncodedDType(
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    const int mantissa_bits = GetMantissaBits(decoded_dtype.dtype);
+    if (mantissa_bits == 0 || !decoded_dtype.flexible_shape.empty()) {
+      return absl::InvalidArgumentError(
+          absl::StrFormat("\"bitround\" filter requires a floating-point data "
+                          "type, but received: %s",
+                          decoded_dtype.encoded_dtype));
+    }
+    if (keepbits > mantissa_bits) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "\"bitround\" filter keepbits=%d exceeds the %d mantissa bits of %s",
+          keepbits, mantissa_bits, decoded_dtype.encoded_dtype));
+    }
+    return decoded_dtype;
+  }
+
+  template <typename Bits>
+  Result<absl::Cord> Round(const absl::Cord& input,
+                           const ZarrDType::BaseDType& dtype,
+                           int maskbits) const {
+    TENSORSTORE_ASSIGN_OR_RETURN(auto values,
+                                 ReadValues<Bits>(input, dtype.endian));
+    BitRoundValues(values.data(), values.size(), maskbits);
+    return WriteValues<Bits>(values.size(), dtype.endian, [&](Bits* out) {
+      std::memcpy(out, values.data(), values.size() * sizeof(Bits));
+    });
+  }
+
+  Result<absl::Cord> Encode(
+      const absl::Cord& input,
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    TENSORSTORE_RETURN_IF_ERROR(GetEncodedDType(decoded_dtype));
+    const int maskbits = GetMantissaBits(decoded_dtype.dtype) - keepbits;
+    if (maskbits == 0) return input;
+    switch (decoded_dtype.dtype->size) {
+      case 2:
+        return Round<uint16_t>(input, decoded_dtype, maskbits);
+      case 4:
+        return Round<uint32_t>(input, decoded_dtype, maskbits);
+      case 8:
+        return Round<uint64_t>(input, decoded_dtype, maskbits);
+      default:
+        ABSL_UNREACHABLE();
+    }
+  }
+
+  Result<absl::Cord> Decode(
+      const absl::Cord& input,
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    return input;
+  }
+};
+
+// Byte shuffle with a compile-time element size, which allows the compiler to
+// generate better code for the common cases.
+template <size_t ElementSize>
+void ShuffleBytes(const char* input, char* output, size_t n,
+                  size_t element_size = ElementSize) {
+  const size_t stride = ElementSize ? ElementSize : element_size;
+  for (size_t j = 0; j < stride; ++j) {
+    char* out = output + j * n;
+    const char* in = input + j;
+    for (size_t i = 0; i < n; ++i) out[i] = in[i * stride];
+  }
+}
+
+template <size_t ElementSize>
+void UnshuffleBytes(const char* input, char* output, size_t n,
+                    size_t element_size = ElementSize) {
+  const size_t stride = ElementSize ? ElementSize : element_size;
+  for (size_t j = 0; j < stride; ++j) {
+    const char* in = input + j * n;
+    char* out = output + j;
+    for (size_t i = 0; i < n; ++i) out[i * stride] = in[i];
+  }
+}
+
+// numcodecs "shuffle": groups the bytes of each element by significance, i.e.
+// stores the first byte of every element, followed by the second byte of
+// every element, etc.  Trailing bytes that do not form a complete element are
+// stored unchanged.
+struct ShuffleFilter : public ZarrFilter {
+  int element_size;
+
+  Result<ZarrDType::BaseDType> GetEncodedDType(
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    return decoded_dtype;
+  }
+
+  Result<absl::Cord> Apply(const absl::Cord& input, bool shuffle) const {
+    const size_t stride = element_size;
+    if (stride <= 1 || input.size() < stride) return input;
+    const size_t n = input.size() / stride;
+    internal::FlatCordBuilder builder(input.size());
+    absl::Cord flat_input = input;
+    const char* in = flat_input.Flatten().data();
+    char* out = builder.data();
+    if (shuffle) {
+      switch (stride) {
+        case 2:
+          ShuffleBytes<2>(in, out, n);
+          break;
+        case 4:
+          ShuffleBytes<4>(in, out, n);
+          break;
+        case 8:
+          ShuffleBytes<8>(in, out, n);
+          break;
+        default:
+          ShuffleBytes<0>(in, out, n, stride);
+          break;
+      }
+    } else {
+      switch (stride) {
+        case 2:
+          UnshuffleBytes<2>(in, out, n);
+          break;
+        case 4:
+          UnshuffleBytes<4>(in, out, n);
+          break;
+        case 8:
+          UnshuffleBytes<8>(in, out, n);
+          break;
+        default:
+          UnshuffleBytes<0>(in, out, n, stride);
+          break;
+      }
+    }
+    std::memcpy(out + n * stride, in + n * stride, input.size() - n * stride);
+    return std::move(builder).Build();
+  }
+
+  Result<absl::Cord> Encode(
+      const absl::Cord& input,
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    return Apply(input, /*shuffle=*/true);
+  }
+
+  Result<absl::Cord> Decode(
+      const absl::Cord& input,
+      const ZarrDType::BaseDType& decoded_dtype) const override {
+    return Apply(input, /*shuffle=*/false);
+  }
+};
+
+constexpr auto TypedFilterBinder = [](auto... member_binders) {
+  return jb::Object(
+      member_binders...,
+      jb::Member("dtype", jb::Projection(&TypedFilter::dtype,
+                                         FilterDTypeBinder)),
+      jb::Member("astype", jb::Projection(&TypedFilter::astype,
+                                          jb::Optional(FilterDTypeBinder))));
+};
+
+struct Registration {
+  Registration() {
+    auto& registry = GetFilterRegistry();
+    registry.Register<DeltaFilter>("delta", TypedFilterBinder());
+    registry.Register<FixedScaleOffsetFilter>(
+        "fixedscaleoffset",
+        TypedFilterBinder(
+            jb::Member("offset",
+                       jb::Projection(&FixedScaleOffsetFilter::offset)),
+            jb::Member("scale",
+                       jb::Projection(&FixedScaleOffsetFilter::scale))));
+    registry.Register<QuantizeFilter>(
+        "quantize",
+        jb::Validate(
+            [](const auto& options, auto* obj) -> absl::Status {
+              if (!IsFloatDataType(obj->dtype.dtype) ||
+                  !IsFloatDataType(obj->encoded_dtype().dtype)) {
+                return absl::InvalidArgumentError(
+                    "\"quantize\" filter requires floating-point data types");
+              }
+              return absl::OkStatus();
+            },
+            TypedFilterBinder(jb::Member(
+                "digits", jb::Projection(&QuantizeFilter::digits,
+                                         jb::Integer<int>(-300, 300))))));
+    registry.Register<BitRoundFilter>(
+        "bitround",
+        jb::Object(jb::Member(
+            "keepbits",
+            jb::Projection(&BitRoundFilter::keepbits, jb::Integer<int>(0)))));
+    registry.Register<ShuffleFilter>(
+        "shuffle",
+        jb::Object(jb::Member(
+            "elementsize",
+            jb::Projection(&ShuffleFilter::element_size,
+                           jb::DefaultValue<jb::kAlwaysIncludeDefaults>(
+                               [](auto* v) { *v = 4; },
+                               jb::Integer<int>(1))))));
+    registry.Register<AsTypeFilter>(
+        "astype",
+        jb::Object(jb::Member("encode_dtype",
+                              jb::Projection(&AsTypeFilter::encode_dtype,
+                                             FilterDTypeBinder)),
+                   jb::Member("decode_dtype",
+                              jb::Projection(&AsTypeFilter::decode_dtype,
+                                             FilterDTypeBinder))));
+  }
+} registration;
+
+}  // namespace
+
+TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
+    ZarrFilters, [](auto is_loading, const auto& options, auto* obj,
+                    ::nlohmann::json* j) -> absl::Status {
+      // An empty sequence of filters is represented as `null`.  An empty array
+      // is also accepted when parsing.
+      if constexpr (is_loading) {
+        if (j->is_null()) {
+          obj->clear();
+          return absl::OkStatus();
+        }
+        if (!j->is_array()) {
+          return internal_json::ExpectedError(*j, "null or array");
+        }
+      } else {
+        if (obj->empty()) {
+          *j = nullptr;
+          return absl::OkStatus();
+        }
+      }
+      return jb::Array(jb::Object(GetFilterRegistry().MemberBinder("id")))(
+          is_loading, options, obj, j);
+    })
+
+ZarrDType::BaseDType GetFilterInputDType(const ZarrDType& dtype) {
+  if (!dtype.has_fields) return dtype.fields[0];
+  return *dtype.GetVoidField();
+}
+
+absl::Status ValidateFilters(const ZarrFilters& filters,
+                             const ZarrDType::BaseDType& input_dtype) {
+  ZarrDType::BaseDType dtype = input_dtype;
+  for (const auto& filter : filters) {
+    TENSORSTORE_ASSIGN_OR_RETURN(dtype, filter->GetEncodedDType(dtype));
+  }
+  return absl::OkStatus();
+}
+
+Result<absl::Cord> EncodeFilters(const ZarrFilters& filters,
+                                 const ZarrDType::BaseDType& input_dtype,
+                                 absl::Cord input) {
+  ZarrDType::BaseDType dtype = input_dtype;
+  for (const auto& filter : filters) {
+    TENSORSTORE_ASSIGN_OR_RETURN(input, filter->Encode(input, dtype));
+    TENSORSTORE_ASSIGN_OR_RETURN(dtype, filter->GetEncodedDType(dtype));
+  }
+  return input;
+}
+
+Result<absl::Cord> DecodeFilters(const ZarrFilters& filters,
+                                 const ZarrDType::BaseDType& input_dtype,
+                                 absl::Cord input) {
+  // Compute the decoded data type of each filter.
+  std::vector<ZarrDType::BaseDType> dtypes;
+  dtypes.reserve(filters.size());
+  dtypes.push_back(input_dtype);
+  for (size_t i = 0; i + 1 < filters.size(); ++i) {
+    TENSORSTORE_ASSIGN_OR_RETURN(auto dtype,
+                                 filters[i]->GetEncodedDType(dtypes.back()));
+    dtypes.push_back(std::move(dtype));
+  }
+  for (size_t i = filters.size(); i-- > 0;) {
+    TENSORSTORE_ASSIGN_OR_RETURN(input, filters[i]->Decode(input, dtypes[i]));
+  }
+  return input;
+}
+
+}  // namespace internal_zarr
+}  // namespace tensorstore
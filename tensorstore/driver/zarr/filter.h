@@ -0,0 +1,117 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_DRIVER_ZARR_FILTER_H_
+#define TENSORSTORE_DRIVER_ZARR_FILTER_H_
+
+/// \file
+/// Support for the zarr v2 "filters" chunk encoding stages, as defined by
+/// numcodecs.
+///
+/// When encoding a chunk, the filters are applied in order to the encoded
+/// chunk bytes before the compressor.  When decoding, they are applied in
+/// reverse order after the compressor.  Each filter interprets its input
+/// according to a NumPy data type, which is either specified explicitly by the
+/// filter (e.g. the "dtype" member of "delta") or is the output data type of
+/// the preceding filter.
+
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/driver/zarr/dtype.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_registry_fwd.h"
+#include "tensorstore/json_serialization_options.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_zarr {
+
+/// Abstract base class for zarr filters.
+class ZarrFilter : public internal::AtomicReferenceCount<ZarrFilter> {
+ public:
+  using Ptr = internal::IntrusivePtr<const ZarrFilter>;
+
+  virtual ~ZarrFilter();
+
+  /// Returns the data type of the encoded representation produced by this
+  /// filter.
+  ///
+  /// \param decoded_dtype Data type of the decoded input to this filter.
+  /// \error `absl::StatusCode::kInvalidArgument` if this filter does not
+  ///     support `decoded_dtype`.
+  virtual Result<ZarrDType::BaseDType> GetEncodedDType(
+      const ZarrDType::BaseDType& decoded_dtype) const = 0;
+
+  /// Encodes `input`, with data type `decoded_dtype`.
+  virtual Result<absl::Cord> Encode(
+      const absl::Cord& input,
+      const ZarrDType::BaseDType& decoded_dtype) const = 0;
+
+  /// Decodes `input`, producing data with data type `decoded_dtype`.
+  ///
+  /// \error `absl::StatusCode::kInvalidArgument` if `input` is invalid.
+  virtual Result<absl::Cord> Decode(
+      const absl::Cord& input,
+      const ZarrDType::BaseDType& decoded_dtype) const = 0;
+
+  using ToJsonOptions = JsonSerializationOptions;
+  using FromJsonOptions = JsonSerializationOptions;
+
+  using Registry =
+      internal::JsonRegistry<ZarrFilter, FromJsonOptions, ToJsonOptions, Ptr>;
+};
+
+/// Sequence of filters, in the order in which they are applied when encoding.
+///
+/// An empty sequence is represented in JSON as `null`.
+class ZarrFilters : public std::vector<ZarrFilter::Ptr> {
+ public:
+  TENSORSTORE_DECLARE_JSON_DEFAULT_BINDER(ZarrFilters,
+                                          ZarrFilter::FromJsonOptions,
+                                          ZarrFilter::ToJsonOptions);
+};
+
+/// Returns the data type of the input to the first filter for an array with
+/// the specified `dtype`.
+///
+/// For an array with a single field, this is the data type of the field.  For
+/// an array with multiple fields, filters operate on raw bytes.
+ZarrDType::BaseDType GetFilterInputDType(const ZarrDType& dtype);
+
+/// Validates that `filters` may be applied to `input_dtype`.
+///
+/// \error `absl::StatusCode::kInvalidArgument` if a filter does not support
+///     its input data type.
+absl::Status ValidateFilters(const ZarrFilters& filters,
+                             const ZarrDType::BaseDType& input_dtype);
+
+/// Applies `filters` in order to `input`.
+Result<absl::Cord> EncodeFilters(const ZarrFilters& filters,
+                                 const ZarrDType::BaseDType& input_dtype,
+                                 absl::Cord input);
+
+/// Applies `filters` in reverse order to `input`.
+///
+/// \error `absl::StatusCode::kInvalidArgument` if `input` is invalid.
+Result<absl::Cord> DecodeFilters(const ZarrFilters& filters,
+                                 const ZarrDType::BaseDType& input_dtype,
+                                 absl::Cord input);
+
+}  // namespace internal_zarr
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_DRIVER_ZARR_FILTER_H_
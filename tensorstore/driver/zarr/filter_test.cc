@@ -0,0 +1,290 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/zarr/filter.h"
+
+#include <stdint.h>
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/driver/zarr/dtype.h"
+#include "tensorstore/internal/testing/json_gtest.h"
+#include "tensorstore/util/endian.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal_zarr::DecodeFilters;
+using ::tensorstore::internal_zarr::EncodeFilters;
+using ::tensorstore::internal_zarr::ParseBaseDType;
+using ::tensorstore::internal_zarr::ValidateFilters;
+using ::tensorstore::internal_zarr::ZarrDType;
+using ::tensorstore::internal_zarr::ZarrFilters;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+// Returns the NumPy typestr with native byte order for the specified type
+// `code`, e.g. "i4".
+std::string Native(std::string_view code) {
+  return (tensorstore::endian::native == tensorstore::endian::little ? "<"
+                                                                     : ">") +
+         std::string(code);
+}
+
+template <typename T>
+absl::Cord MakeCord(std::vector<T> values) {
+  std::string s(values.size() * sizeof(T), '\0');
+  std::memcpy(s.data(), values.data(), s.size());
+  return absl::Cord(std::move(s));
+}
+
+template <typename T>
+std::vector<T> GetValues(const absl::Cord& cord) {
+  std::string s(cord);
+  std::vector<T> values(s.size() / sizeof(T));
+  std::memcpy(values.data(), s.data(), values.size() * sizeof(T));
+  return values;
+}
+
+ZarrDType::BaseDType GetDType(const std::string& typestr) {
+  return ParseBaseDType(typestr).value();
+}
+
+TEST(ZarrFiltersTest, JsonNull) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto filters,
+                                   ZarrFilters::FromJson(nullptr));
+  EXPECT_TRUE(filters.empty());
+  EXPECT_EQ(nullptr, ::nlohmann::json(filters));
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(filters,
+                                   ZarrFilters::FromJson(::nlohmann::json(
+                                       ::nlohmann::json::array_t())));
+  EXPECT_TRUE(filters.empty());
+  EXPECT_EQ(nullptr, ::nlohmann::json(filters));
+}
+
+TEST(ZarrFiltersTest, JsonRoundTrip) {
+  ::nlohmann::json j{
+      {{"id", "delta"}, {"dtype", "<i4"}},
+      {{"id", "delta"}, {"dtype", "<i8"}, {"astype", "<i2"}},
+      {{"id", "fixedscaleoffset"},
+       {"dtype", "<f8"},
+       {"astype", "|u1"},
+       {"offset", 1000},
+       {"scale", 10}},
+      {{"id", "quantize"}, {"dtype", "<f8"}, {"digits", 2}},
+      {{"id", "bitround"}, {"keepbits", 5}},
+      {{"id", "shuffle"}, {"elementsize", 8}},
+      {{"id", "astype"}, {"encode_dtype", "<f4"}, {"decode_dtype", "<f8"}},
+  };
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto filters, ZarrFilters::FromJson(j));
+  EXPECT_EQ(7, filters.size());
+  EXPECT_EQ(j, ::nlohmann::json(filters));
+}
+
+TEST(ZarrFiltersTest, ShuffleDefaultElementSize) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto filters, ZarrFilters::FromJson({{{"id", "shuffle"}}}));
+  EXPECT_EQ((::nlohmann::json{{{"id", "shuffle"}, {"elementsize", 4}}}),
+            ::nlohmann::json(filters));
+}
+
+TEST(ZarrFiltersTest, JsonErrors) {
+  EXPECT_THAT(ZarrFilters::FromJson(5),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("Expected null or array, but received: 5")));
+  EXPECT_THAT(ZarrFilters::FromJson({{{"id", "invalid"}}}),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("\"invalid\" is not registered")));
+  EXPECT_THAT(
+      ZarrFilters::FromJson({{{"id", "delta"}, {"dtype", "<c8"}}}),
+      StatusIs(absl::StatusCode::kInvalidArgument, HasSubstr("\"dtype\"")));
+  EXPECT_THAT(ZarrFilters::FromJson({{{"id", "delta"}}}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(
+      ZarrFilters::FromJson({{{"id", "quantize"}, {"dtype", "<i4"},
+                              {"digits", 2}}}),
+      StatusIs(absl::StatusCode::kInvalidArgument,
+               HasSubstr("requires floating-point data types")));
+  EXPECT_THAT(ZarrFilters::FromJson({{{"id", "shuffle"}, {"elementsize", 0}}}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(ZarrFiltersTest, ValidateBitRound) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto filters, ZarrFilters::FromJson({{{"id", "bitround"},
+                                            {"keepbits", 10}}}));
+  TENSORSTORE_EXPECT_OK(ValidateFilters(filters, GetDType("<f4")));
+  TENSORSTORE_EXPECT_OK(ValidateFilters(filters, GetDType("<f2")));
+  EXPECT_THAT(ValidateFilters(filters, GetDType("<i4")),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("requires a floating-point data type")));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      filters, ZarrFilters::FromJson({{{"id", "bitround"}, {"keepbits", 11}}}));
+  EXPECT_THAT(ValidateFilters(filters, GetDType("<f2")),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("exceeds the 10 mantissa bits")));
+}
+
+TEST(ZarrFiltersTest, Delta) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto filters,
+      ZarrFilters::FromJson({{{"id", "delta"},
+                              {"dtype", Native("i4")},
+                              {"astype", Native("i2")}}}));
+  auto dtype = GetDType(Native("i4"));
+  auto decoded = MakeCord<int32_t>({100, 101, 103, 99, 99});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded,
+                                   EncodeFilters(filters, dtype, decoded));
+  EXPECT_THAT(GetValues<int16_t>(encoded), ElementsAre(100, 1, 2, -4, 0));
+  EXPECT_THAT(DecodeFilters(filters, dtype, encoded),
+              ::testing::Optional(decoded));
+}
+
+TEST(ZarrFiltersTest, DeltaWraps) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto filters,
+      ZarrFilters::FromJson({{{"id", "delta"}, {"dtype", "|u1"}}}));
+  auto dtype = GetDType("|u1");
+  auto decoded = MakeCord<uint8_t>({250, 5, 0});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded,
+                                   EncodeFilters(filters, dtype, decoded));
+  EXPECT_THAT(GetValues<uint8_t>(encoded), ElementsAre(250, 11, 251));
+  EXPECT_THAT(DecodeFilters(filters, dtype, encoded),
+              ::testing::Optional(decoded));
+}
+
+TEST(ZarrFiltersTest, FixedScaleOffset) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto filters, ZarrFilters::FromJson({{{"id", "fixedscaleoffset"},
+                                            {"dtype", Native("f8")},
+                                            {"astype", "|u1"},
+                                            {"offset", 1000},
+                                            {"scale", 10}}}));
+  auto dtype = GetDType(Native("f8"));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto encoded, EncodeFilters(filters, dtype,
+                                  MakeCord<double>({1000, 1000.1, 1025.5})));
+  EXPECT_THAT(GetValues<uint8_t>(encoded), ElementsAre(0, 1, 255));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto decoded,
+                                   DecodeFilters(filters, dtype, encoded));
+  EXPECT_THAT(GetValues<double>(decoded),
+              ElementsAre(1000, ::testing::DoubleNear(1000.1, 1e-9), 1025.5));
+}
+
+TEST(ZarrFiltersTest, Quantize) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto filters,
+      ZarrFilters::FromJson(
+          {{{"id", "quantize"}, {"dtype", Native("f8")}, {"digits", 1}}}));
+  auto dtype = GetDType(Native("f8"));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto encoded,
+      EncodeFilters(filters, dtype, MakeCord<double>({1.23, -0.5, 3.0})));
+  EXPECT_THAT(GetValues<double>(encoded), ElementsAre(1.25, -0.5, 3.0));
+  EXPECT_THAT(DecodeFilters(filters, dtype, encoded),
+              ::testing::Optional(encoded));
+}
+
+TEST(ZarrFiltersTest, BitRound) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto filters,
+      ZarrFilters::FromJson({{{"id", "bitround"}, {"keepbits", 1}}}));
+  auto dtype = GetDType(Native("f4"));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto encoded,
+      EncodeFilters(filters, dtype,
+                    MakeCord<float>({1.0f, 1.25f, 1.5f, 1.75f, -3.5f})));
+  // Ties are rounded to even.
+  EXPECT_THAT(GetValues<float>(encoded),
+              ElementsAre(1.0f, 1.0f, 1.5f, 2.0f, -4.0f));
+  EXPECT_THAT(DecodeFilters(filters, dtype, encoded),
+              ::testing::Optional(encoded));
+}
+
+TEST(ZarrFiltersTest, Shuffle) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto filters,
+      ZarrFilters::FromJson({{{"id", "shuffle"}, {"elementsize", 2}}}));
+  auto dtype = GetDType("|V7");
+  absl::Cord decoded("abcdefg");
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded,
+                                   EncodeFilters(filters, dtype, decoded));
+  EXPECT_EQ("acebdfg", encoded);
+  EXPECT_THAT(DecodeFilters(filters, dtype, encoded),
+              ::testing::Optional(decoded));
+}
+
+TEST(ZarrFiltersTest, ShuffleGenericElementSize) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto filters,
+      ZarrFilters::FromJson({{{"id", "shuffle"}, {"elementsize", 3}}}));
+  auto dtype = GetDType("|V8");
+  absl::Cord decoded("abcdefgh");
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded,
+                                   EncodeFilters(filters, dtype, decoded));
+  EXPECT_EQ("adbecfgh", encoded);
+  EXPECT_THAT(DecodeFilters(filters, dtype, encoded),
+              ::testing::Optional(decoded));
+}
+
+TEST(ZarrFiltersTest, AsTypeByteOrder) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto filters, ZarrFilters::FromJson({{{"id", "astype"},
+                                            {"encode_dtype", ">u2"},
+                                            {"decode_dtype", "<u2"}}}));
+  auto dtype = GetDType("<u2");
+  absl::Cord decoded(std::string_view("\x01\x02\x03\x04", 4));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded,
+                                   EncodeFilters(filters, dtype, decoded));
+  EXPECT_EQ(std::string_view("\x02\x01\x04\x03", 4), encoded);
+  EXPECT_THAT(DecodeFilters(filters, dtype, encoded),
+              ::testing::Optional(decoded));
+}
+
+TEST(ZarrFiltersTest, Chain) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto filters,
+      ZarrFilters::FromJson({{{"id", "delta"}, {"dtype", Native("i4")}},
+                             {{"id", "shuffle"}, {"elementsize", 4}}}));
+  auto dtype = GetDType(Native("i4"));
+  TENSORSTORE_ASSERT_OK(ValidateFilters(filters, dtype));
+  std::vector<int32_t> values;
+  for (int i = 0; i < 100; ++i) values.push_back(i * i - 1000);
+  auto decoded = MakeCord<int32_t>(values);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded,
+                                   EncodeFilters(filters, dtype, decoded));
+  EXPECT_NE(decoded, encoded);
+  EXPECT_THAT(DecodeFilters(filters, dtype, encoded),
+              ::testing::Optional(decoded));
+}
+
+TEST(ZarrFiltersTest, InvalidEncodedSize) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto filters,
+      ZarrFilters::FromJson({{{"id", "delta"}, {"dtype", Native("i4")}}}));
+  EXPECT_THAT(DecodeFilters(filters, GetDType(Native("i4")), absl::Cord("abc")),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
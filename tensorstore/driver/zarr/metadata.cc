@@ -49,6 +49,7 @@
 #include "tensorstore/contiguous_layout.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/driver/zarr/dtype.h"
+#include "tensorstore/driver/zarr/filter.h"
 #include "tensorstore/driver/zarr3/default_nan.h"
 #include "tensorstore/index.h"
 #include "tensorstore/internal/data_type_endian_conversion.h"
@@ -402,13 +403,17 @@ ZarrMetadataPtr CreateVoidMetadataImpl(const ZarrMetadata& original) {
     metadata->fill_value[0] = byte_fill;
   }
 
-  // Recompute chunk_layout using existing ValidateMetadata.
+  // Recompute chunk_layout.
   // ComputeChunkLayout handles the void field correctly because
   // void_field.num_bytes == bytes_per_outer_element, producing
   // matching encoded/decoded layouts as required by DecodeChunk.
-  // ValidateMetadata should never fail here since we're using the same chunks
-  // and bytes_per_outer_element as the original validated metadata.
-  TENSORSTORE_CHECK_OK(ValidateMetadata(*metadata));
+  // ComputeChunkLayout should never fail here since we're using the same
+  // chunks and bytes_per_outer_element as the original validated metadata.
+  // `filter_input_dtype` is inherited from the original metadata, since the
+  // filters still operate on the original data type.
+  metadata->chunk_layout =
+      ComputeChunkLayout(metadata->dtype, metadata->order, metadata->chunks)
+          .value();
 
   return metadata;
 }
@@ -471,28 +476,7 @@ constexpr auto MetadataJsonBinder = [](auto maybe_optional) {
                        }))),
         jb::Member("order",
                    jb::Projection(&T::order, maybe_optional(OrderJsonBinder))),
-        jb::Member(
-            "filters",
-            jb::Projection<&T::filters>(maybe_optional(
-                [](auto is_loading, const auto& options, auto* obj, auto* j) {
-                  if constexpr (is_loading) {
-                    if (!j->is_null()) {
-                      if (auto* a = j->template get_ptr<
-                                    const ::nlohmann::json::array_t*>()) {
-                        if (a->size() != 0) {
-                          return absl::InvalidArgumentError(
-                              "filters are not supported");
-                        }
-                      } else {
-                        return internal_json::ExpectedError(*j,
-                                                            "null or array");
-                      }
-                    }
-                  } else {
-                    *j = nullptr;
-                  }
-                  return absl::OkStatus();
-                }))),
+        jb::Member("filters", jb::Projection(&T::filters)),
         jb::Member("dimension_separator",
                    jb::Projection(&T::dimension_separator,
                                   jb::Optional(DimensionSeparatorJsonBinder))),
@@ -511,6 +495,10 @@ absl::Status ValidateMetadata(ZarrMetadata& metadata) {
   TENSORSTORE_ASSIGN_OR_RETURN(
       metadata.chunk_layout,
       ComputeChunkLayout(metadata.dtype, metadata.order, metadata.chunks));
+  metadata.filter_input_dtype = GetFilterInputDType(metadata.dtype);
+  TENSORSTORE_RETURN_IF_ERROR(
+      ValidateFilters(metadata.filters, metadata.filter_input_dtype),
+      _.Format("Invalid \"filters\""));
   return absl::OkStatus();
 }
 
@@ -531,7 +519,7 @@ Result<absl::InlinedVector<SharedArray<const void>, 1>> DecodeChunk(
     const ZarrMetadata& metadata, absl::Cord buffer) {
   const size_t num_fields = metadata.dtype.fields.size();
   absl::InlinedVector<SharedArray<const void>, 1> field_arrays(num_fields);
-  if (num_fields == 1) {
+  if (num_fields == 1 && metadata.filters.empty()) {
     // Optimized code path, decompress directly into output array.
     const auto& dtype_field = metadata.dtype.fields[0];
     const auto& chunk_layout_field = metadata.chunk_layout.fields[0];
@@ -586,6 +574,11 @@ Result<absl::InlinedVector<SharedArray<const void>, 1>> DecodeChunk(
         riegeli::ReadAll(std::move(compressed_reader), buffer));
     if (!base_reader.VerifyEndAndClose()) return base_reader.status();
   }
+  if (!metadata.filters.empty()) {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        buffer, DecodeFilters(metadata.filters, metadata.filter_input_dtype,
+                              std::move(buffer)));
+  }
   if (static_cast<Index>(buffer.size()) !=
       metadata.chunk_layout.bytes_per_chunk) {
     return absl::InvalidArgumentError(absl::StrFormat(
@@ -667,6 +660,11 @@ Result<absl::Cord> EncodeChunk(
   } else {
     output = CopyComponentsToEncodedLayout(metadata, components);
   }
+  if (!metadata.filters.empty()) {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        output, EncodeFilters(metadata.filters, metadata.filter_input_dtype,
+                              std::move(output)));
+  }
   if (metadata.compressor) {
     absl::Cord encoded;
     riegeli::CordWriter<absl::Cord*> base_writer(&encoded);
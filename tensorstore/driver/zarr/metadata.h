@@ -21,7 +21,6 @@
 
 #include <stddef.h>
 
-#include <cstddef>  // std::nullptr_t
 #include <memory>
 #include <optional>
 #include <string>
@@ -36,6 +35,7 @@
 #include "tensorstore/contiguous_layout.h"
 #include "tensorstore/driver/zarr/compressor.h"
 #include "tensorstore/driver/zarr/dtype.h"
+#include "tensorstore/driver/zarr/filter.h"
 #include "tensorstore/index.h"
 #include "tensorstore/internal/json_binding/bindable.h"
 #include "tensorstore/json_serialization_options_base.h"
@@ -130,7 +130,9 @@ struct ZarrMetadata {
 
   /// Encoded layout of chunk.
   ContiguousLayoutOrder order;
-  std::nullptr_t filters;
+
+  /// Filters applied to the encoded chunk before the compressor.
+  ZarrFilters filters;
 
   /// Fill values for each of the fields.  Must have same length as
   /// `dtype.fields`.
@@ -145,6 +147,12 @@ struct ZarrMetadata {
 
   ZarrChunkLayout chunk_layout;
 
+  /// Data type of the input to the first filter, computed from `dtype`.
+  ///
+  /// This is retained by `CreateVoidMetadata`, since filters always operate
+  /// on the original data type.
+  ZarrDType::BaseDType filter_input_dtype;
+
   /// Returns a cached void metadata derived from this metadata.
   /// The returned pointer is valid for the lifetime of this ZarrMetadata.
   /// Thread-safe and lazily initialized on first access.
@@ -177,7 +185,8 @@ struct ZarrMetadata {
   mutable LazyVoidMetadata lazy_void_metadata_;
 };
 
-/// Validates chunk layout and computes `metadata.chunk_layout`.
+/// Validates chunk layout and filters, and computes `metadata.chunk_layout`
+/// and `metadata.filter_input_dtype`.
 absl::Status ValidateMetadata(ZarrMetadata& metadata);
 
 /// Partially-specified zarr metadata used either to validate existing metadata
@@ -202,7 +211,7 @@ struct ZarrPartialMetadata {
 
   /// Encoded layout of chunk.
   std::optional<ContiguousLayoutOrder> order;
-  std::optional<std::nullptr_t> filters;
+  std::optional<ZarrFilters> filters;
 
   /// Fill values for each of the fields.  Must have same length as
   /// `dtype.fields`.
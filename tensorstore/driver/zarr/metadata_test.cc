@@ -39,6 +39,7 @@
 #include "tensorstore/internal/json_binding/gtest.h"
 #include "tensorstore/strided_layout.h"
 #include "tensorstore/util/endian.h"
+#include "tensorstore/util/span.h"
 #include "tensorstore/util/status_testutil.h"
 
 namespace {
@@ -51,8 +52,10 @@ using ::tensorstore::dtypes::bfloat16_t;
 using ::tensorstore::dtypes::float16_t;
 using ::tensorstore::dtypes::int2_t;
 using ::tensorstore::dtypes::int4_t;
+using ::tensorstore::internal_zarr::DecodeChunk;
 using ::tensorstore::internal_zarr::DimensionSeparator;
 using ::tensorstore::internal_zarr::DimensionSeparatorJsonBinder;
+using ::tensorstore::internal_zarr::EncodeChunk;
 using ::tensorstore::internal_zarr::EncodeFillValue;
 using ::tensorstore::internal_zarr::OrderJsonBinder;
 using ::tensorstore::internal_zarr::ParseDType;
@@ -791,6 +794,44 @@ TEST(ParseMetadataTest, InvalidFilters) {
   });
 }
 
+TEST(ParseMetadataTest, FilterNotSupportedByDType) {
+  EXPECT_THAT(
+      ZarrMetadata::FromJson(
+          {{"chunks", {10}},
+           {"compressor", nullptr},
+           {"dtype", "<i4"},
+           {"fill_value", 0},
+           {"filters", {{{"id", "bitround"}, {"keepbits", 3}}}},
+           {"order", "C"},
+           {"shape", {100}},
+           {"zarr_format", 2}}),
+      StatusIs(absl::StatusCode::kInvalidArgument,
+               HasSubstr("Invalid \"filters\"")));
+}
+
+TEST(EncodeDecodeChunkTest, Filters) {
+  ::nlohmann::json j{{"chunks", {4}},
+                     {"compressor", {{"id", "zlib"}, {"level", 1}}},
+                     {"dtype", "<i4"},
+                     {"fill_value", 0},
+                     {"filters",
+                      {{{"id", "delta"}, {"dtype", "<i4"}, {"astype", "|i1"}},
+                       {{"id", "shuffle"}, {"elementsize", 1}}}},
+                     {"order", "C"},
+                     {"shape", {100}},
+                     {"zarr_format", 2}};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto metadata, ZarrMetadata::FromJson(j));
+  EXPECT_EQ(j, ::nlohmann::json(metadata));
+  tensorstore::SharedArray<const void> array =
+      MakeArray<int32_t>({100, 101, 103, 106});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto encoded, EncodeChunk(metadata, tensorstore::span(&array, 1)));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto decoded,
+                                   DecodeChunk(metadata, encoded));
+  ASSERT_EQ(1, decoded.size());
+  EXPECT_EQ(array, decoded[0]);
+}
+
 TEST(DimensionSeparatorTest, JsonBinderTest) {
   tensorstore::TestJsonBinderRoundTrip<DimensionSeparator>(
       {
@@ -37,6 +37,7 @@
 #include "tensorstore/data_type.h"
 #include "tensorstore/driver/zarr/compressor.h"
 #include "tensorstore/driver/zarr/dtype.h"
+#include "tensorstore/driver/zarr/filter.h"
 #include "tensorstore/driver/zarr/metadata.h"
 #include "tensorstore/index.h"
 #include "tensorstore/index_space/index_domain.h"
@@ -140,6 +141,11 @@ absl::Status ValidateMetadata(const ZarrMetadata& metadata,
     return MetadataMismatchError("compressor", *constraints.compressor,
                                  metadata.compressor);
   }
+  if (constraints.filters && ::nlohmann::json(*constraints.filters) !=
+                                 ::nlohmann::json(metadata.filters)) {
+    return MetadataMismatchError("filters", *constraints.filters,
+                                 metadata.filters);
+  }
   if (constraints.order && *constraints.order != metadata.order) {
     return MetadataMismatchError(
         "order", absl::StrFormat("%v", GenericStringify(*constraints.order)),
@@ -261,6 +267,9 @@ Result<ZarrMetadataPtr> GetNewMetadata(
   if (partial_metadata.compressor) {
     codec_spec->compressor = partial_metadata.compressor;
   }
+  if (partial_metadata.filters) {
+    codec_spec->filters = ::nlohmann::json(*partial_metadata.filters);
+  }
   TENSORSTORE_RETURN_IF_ERROR(codec_spec->MergeFrom(schema.codec()));
   if (codec_spec->compressor) {
     metadata->compressor = *std::move(codec_spec->compressor);
@@ -269,7 +278,10 @@ Result<ZarrMetadataPtr> GetNewMetadata(
                                  Compressor::FromJson({{"id", "blosc"}}));
   }
 
-  metadata->filters = nullptr;
+  // Determine filters.
+  TENSORSTORE_ASSIGN_OR_RETURN(metadata->filters,
+                               ZarrFilters::FromJson(codec_spec->filters),
+                               _.Format("Invalid \"filters\""));
 
   // Determine storage order within chunk.
   {
@@ -480,7 +492,7 @@ absl::Status SetChunkLayoutFromMetadata(
 CodecSpec GetCodecSpecFromMetadata(const ZarrMetadata& metadata) {
   auto codec = internal::CodecDriverSpec::Make<ZarrCodecSpec>();
   codec->compressor = metadata.compressor;
-  codec->filters = nullptr;
+  codec->filters = ::nlohmann::json(metadata.filters);
   return codec;
 }
 
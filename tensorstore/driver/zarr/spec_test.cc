@@ -460,6 +460,41 @@ TEST(GetNewMetadataTest, SchemaDtypeShapeCodec) {
               })));
 }
 
+TEST(GetNewMetadataTest, SchemaDtypeShapeCodecFilters) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto codec,
+      CodecSpec::FromJson(
+          {{"driver", "zarr"},
+           {"compressor", nullptr},
+           {"filters", {{{"id", "delta"}, {"dtype", "<i4"}}}}}));
+  EXPECT_THAT(GetNewMetadataFromOptions(::nlohmann::json::object_t(),
+                                        /*selected_field=*/{},
+                                        Schema::Shape({100, 200}),
+                                        dtype_v<int32_t>, codec),
+              ::testing::Optional(MatchesJson({
+                  {"fill_value", nullptr},
+                  {"filters", {{{"id", "delta"}, {"dtype", "<i4"}}}},
+                  {"zarr_format", 2},
+                  {"order", "C"},
+                  {"shape", {100, 200}},
+                  {"chunks", {100, 200}},
+                  {"dtype", "<i4"},
+                  {"compressor", nullptr},
+                  {"dimension_separator", "."},
+              })));
+}
+
+TEST(GetNewMetadataTest, InvalidFilters) {
+  EXPECT_THAT(GetNewMetadataFromOptions(
+                  {{"shape", {2, 3}},
+                   {"dtype", "<i4"},
+                   {"filters", {{{"id", "bitround"}, {"keepbits", 3}}}}},
+                  /*selected_field=*/{}),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("\"bitround\" filter requires a "
+                                 "floating-point data type")));
+}
+
 TEST(GetNewMetadataTest, SchemaDtypeInnerOrderC) {
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(
       auto codec,
@@ -593,6 +593,7 @@ void ZarrShardedChunkCache::Read(
       *this, std::move(request.transform), std::move(receiver),
       [transaction = std::move(request.transaction),
        batch = std::move(request.batch),
+       retain_cached_chunks = request.retain_cached_chunks,
        staleness_bound = request.staleness_bound,
        fill_missing_data_reads = request.fill_missing_data_reads,
        component_index = request.component_index](auto entry) {
@@ -606,7 +607,8 @@ void ZarrShardedChunkCache::Read(
                 AnyFlowReceiver<absl::Status, internal::ReadChunk,
                                 IndexTransform<>>&& receiver) {
               entry->sub_chunk_cache.get()->Read(
-                  {{transaction, std::move(transform), shard_batch},
+                  {{transaction, std::move(transform), shard_batch,
+                    retain_cached_chunks},
                    component_index,
                    staleness_bound,
                    fill_missing_data_reads},
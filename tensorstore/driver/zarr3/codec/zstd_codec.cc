@@ -26,6 +26,7 @@
 #include "tensorstore/driver/zarr3/codec/codec.h"
 #include "tensorstore/driver/zarr3/codec/codec_spec.h"
 #include "tensorstore/driver/zarr3/codec/registry.h"
+#include "tensorstore/internal/compression/zstd_compressor.h"
 #include "tensorstore/internal/global_initializer.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/bindable.h"
@@ -49,14 +50,8 @@ class ZstdCodec : public ZarrBytesToBytesCodec {
    public:
     Result<std::unique_ptr<riegeli::Writer>> GetEncodeWriter(
         riegeli::Writer& encoded_writer) const final {
-      using Writer = riegeli::ZstdWriter<riegeli::Writer*>;
-      Writer::Options options;
-      options.set_compression_level(level_);
-      options.set_store_checksum(checksum_);
-      if (decoded_size_ != -1) {
-        options.set_pledged_size(decoded_size_);
-      }
-      return std::make_unique<Writer>(&encoded_writer, options);
+      return internal::GetZstdWriter(encoded_writer, level_, checksum_,
+                                     decoded_size_);
     }
 
     Result<std::unique_ptr<riegeli::Reader>> GetDecodeReader(
@@ -17,6 +17,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <bitset>
@@ -79,9 +80,14 @@ using LruListAccessor =
 CachePoolImpl::CachePoolImpl(const CachePool::Limits& limits)
     : limits_(limits),
       total_bytes_(0),
+      num_lru_shards_(std::clamp<size_t>(
+          limits.total_bytes_limit / kMinBytesPerLruShard, 1, kMaxLruShards)),
       strong_references_(1),
       weak_references_(1) {
-  Initialize(LruListAccessor{}, &eviction_queue_);
+  for (auto& shard : lru_shards_) {
+    Initialize(LruListAccessor{}, &shard.eviction_queue);
+    Initialize(LruListAccessor{}, &shard.protected_queue);
+  }
 }
 
 namespace {
@@ -127,26 +133,105 @@ void UnlinkListNode(LruListNode* node) noexcept {
   Initialize(LruListAccessor{}, node);
 }
 
-void UnregisterEntryFromPool(CacheEntryImpl* entry,
-                             CachePoolImpl* pool) noexcept {
-  DebugAssertMutexHeld(&pool->lru_mutex_);
+using LruShard = CachePoolImpl::LruShard;
+
+// Removes `entry` from whichever eviction queue segment of `shard` it is in,
+// if any.
+void UnlinkFromEvictionQueue(LruShard& shard, CacheEntryImpl* entry) noexcept
+    ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  DebugAssertMutexHeld(&shard.mutex);
   UnlinkListNode(entry);
+  shard.protected_bytes -= std::exchange(entry->protected_num_bytes_, 0);
+}
+
+void UnregisterEntryFromPool(CacheEntryImpl* entry, CachePoolImpl* pool,
+                             LruShard& shard) noexcept {
+  UnlinkFromEvictionQueue(shard, entry);
   pool->total_bytes_.fetch_sub(entry->num_bytes_, std::memory_order_relaxed);
 }
 
-void AddToEvictionQueue(CachePoolImpl* pool, CacheEntryImpl* entry) noexcept {
-  DebugAssertMutexHeld(&pool->lru_mutex_);
-  auto* eviction_queue = &pool->eviction_queue_;
+// Fraction of `total_bytes_limit` that may be occupied by the protected
+// segment of the segmented LRU policy.
+constexpr size_t kProtectedSegmentNumerator = 4;
+constexpr size_t kProtectedSegmentDenominator = 5;
+
+void AddToEvictionQueue(CachePoolImpl* pool, LruShard& shard,
+                        CacheEntryImpl* entry) noexcept
+    ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  DebugAssertMutexHeld(&shard.mutex);
   if (!OnlyContainsNode(LruListAccessor{}, entry)) {
-    Remove(LruListAccessor{}, entry);
+    UnlinkFromEvictionQueue(shard, entry);
+  }
+  if (pool->limits_.eviction_policy != CacheEvictionPolicy::kSegmentedLru ||
+      !entry->requested_while_unused_.exchange(false,
+                                               std::memory_order_relaxed)) {
+    InsertBefore(LruListAccessor{}, &shard.eviction_queue, entry);
+    return;
+  }
+  // The entry was reused after it was last released: promote it to the
+  // protected segment.
+  InsertBefore(LruListAccessor{}, &shard.protected_queue, entry);
+  entry->protected_num_bytes_ = entry->num_bytes_;
+  shard.protected_bytes += entry->num_bytes_;
+  // Demote the least-recently used protected entries to the most-recently
+  // used end of the probationary segment until the protected segment fits
+  // within its share of the limit.
+  const size_t protected_limit = pool->limits_.total_bytes_limit /
+                                 kProtectedSegmentDenominator *
+                                 kProtectedSegmentNumerator /
+                                 pool->num_lru_shards_;
+  while (shard.protected_bytes > protected_limit &&
+         shard.protected_queue.next != entry) {
+    auto* demoted = static_cast<CacheEntryImpl*>(shard.protected_queue.next);
+    UnlinkFromEvictionQueue(shard, demoted);
+    InsertBefore(LruListAccessor{}, &shard.eviction_queue, demoted);
   }
-  InsertBefore(LruListAccessor{}, eviction_queue, entry);
 }
 
 void DestroyCache(CachePoolImpl* pool, CacheImpl* cache);
 
-void MaybeEvictEntries(CachePoolImpl* pool) noexcept {
-  DebugAssertMutexHeld(&pool->lru_mutex_);
+// Removes `entry`, which has just become unused, from its cache and from the
+// pool ahead of the other entries in the eviction queue.  `shard`, the LRU
+// shard of `entry`, must be locked, and the caller must hold a strong
+// reference to the cache.
+//
+// Returns `false` if `entry` was concurrently acquired again, in which case it
+// remains in the cache.
+bool UnregisterUnusedEntry(CachePoolImpl* pool, LruShard& shard,
+                           CacheEntryImpl* entry) noexcept {
+  DebugAssertMutexHeld(&shard.mutex);
+  auto* cache = entry->cache_;
+  auto& cache_shard = cache->ShardForKey(entry->key_);
+  absl::MutexLock lock(cache_shard.mutex);
+  // The reference count cannot increase from zero except while holding
+  // `cache_shard.mutex`.
+  if (entry->reference_count_.load(std::memory_order_acquire) != 0) {
+    return false;
+  }
+  [[maybe_unused]] size_t erase_count = cache_shard.entries.erase(entry);
+  assert(erase_count == 1);
+  if (cache_shard.entries.empty()) {
+    // Note: There is no need to check `ShouldDelete` conditions here because
+    // the caller holds a strong reference to the cache.
+    cache->reference_count_.fetch_sub(CacheImpl::kNonEmptyShardIncrement,
+                                      std::memory_order_relaxed);
+  }
+  UnregisterEntryFromPool(entry, pool, shard);
+  evict_count.Increment();
+  return true;
+}
+
+bool IsOverLimit(CachePoolImpl* pool) {
+  return pool->total_bytes_.load(std::memory_order_acquire) >
+         pool->limits_.total_bytes_limit;
+}
+
+// Evicts unused entries from `shard`, which must be locked, until the pool is
+// within its limit or `shard` has no more entries.  Entries in the protected
+// segment are only evicted if `evict_protected` is `true`.
+void EvictEntriesFromShard(CachePoolImpl* pool, LruShard& shard,
+                           bool evict_protected) noexcept {
+  DebugAssertMutexHeld(&shard.mutex);
 
   constexpr size_t kBufferSize = 64;
   std::array<CacheEntryImpl*, kBufferSize> entries_to_delete;
@@ -156,7 +241,7 @@ void MaybeEvictEntries(CachePoolImpl* pool) noexcept {
   size_t num_entries_to_delete = 0;
 
   const auto destroy_entries = [&] {
-    internal::ScopedUnlock unlock(pool->lru_mutex_);
+    internal::ScopedUnlock unlock(shard.mutex);
     for (size_t i = 0; i < num_entries_to_delete; ++i) {
       auto* entry = entries_to_delete[i];
       if (should_delete_cache_for_entry[i]) {
@@ -168,9 +253,13 @@ void MaybeEvictEntries(CachePoolImpl* pool) noexcept {
     }
   };
 
-  while (pool->total_bytes_.load(std::memory_order_acquire) >
-         pool->limits_.total_bytes_limit) {
-    auto* queue = &pool->eviction_queue_;
+  while (IsOverLimit(pool)) {
+    auto* queue = &shard.eviction_queue;
+    if (queue->next == queue) {
+      if (!evict_protected) break;
+      // Probationary segment empty, fall back to the protected segment.
+      queue = &shard.protected_queue;
+    }
     if (queue->next == queue) {
       // Queue empty.
       break;
@@ -179,12 +268,12 @@ void MaybeEvictEntries(CachePoolImpl* pool) noexcept {
     auto* cache = entry->cache_;
     bool evict = false;
     bool should_delete_cache = false;
-    auto& shard = cache->ShardForKey(entry->key_);
-    if (absl::MutexLock lock(shard.mutex);
+    auto& cache_shard = cache->ShardForKey(entry->key_);
+    if (absl::MutexLock lock(cache_shard.mutex);
         entry->reference_count_.load(std::memory_order_acquire) == 0) {
-      [[maybe_unused]] size_t erase_count = shard.entries.erase(entry);
+      [[maybe_unused]] size_t erase_count = cache_shard.entries.erase(entry);
       assert(erase_count == 1);
-      if (shard.entries.empty()) {
+      if (cache_shard.entries.empty()) {
         if (DecrementCacheReferenceCount(cache,
                                          CacheImpl::kNonEmptyShardIncrement)
                 .should_delete()) {
@@ -198,17 +287,17 @@ void MaybeEvictEntries(CachePoolImpl* pool) noexcept {
       // efficiency, entries aren't removed from the eviction list when the
       // reference count increases.  It will be put back on the eviction list
       // the next time the reference count becomes 0.  There is no race
-      // condition here because both `cache->entries_mutex_` and
-      // `pool->lru_mutex_` are held, and the reference count cannot increase
-      // from zero except while holding `cache->entries_mutex_`, and the
-      // reference count cannot decrease to zero except while holding
-      // `pool->lru_mutex_`.
-      UnlinkListNode(entry);
+      // condition here because both `cache_shard.mutex` and the LRU
+      // `shard.mutex` are held, and the reference count cannot increase from
+      // zero except while holding `cache_shard.mutex`, and the reference
+      // count cannot decrease to zero except while holding the mutex of the
+      // entry's LRU shard.
+      UnlinkFromEvictionQueue(shard, entry);
       continue;
     }
-    UnregisterEntryFromPool(entry, pool);
+    UnregisterEntryFromPool(entry, pool, shard);
     evict_count.Increment();
-    // Enqueue entry to be destroyed with `pool->lru_mutex_` released.
+    // Enqueue entry to be destroyed with `shard.mutex` released.
     should_delete_cache_for_entry[num_entries_to_delete] = should_delete_cache;
     entries_to_delete[num_entries_to_delete++] = entry;
     if (num_entries_to_delete == entries_to_delete.size()) {
@@ -219,6 +308,37 @@ void MaybeEvictEntries(CachePoolImpl* pool) noexcept {
   destroy_entries();
 }
 
+// Evicts entries from the LRU shards, in round-robin order, until the pool is
+// within its limit.  The probationary segments of all shards are evicted
+// before any protected segment, except that of `probationary_evicted_shard`,
+// which the caller has already evicted.  No LRU shard mutex may be held by the
+// caller.
+void EvictEntriesFromShards(
+    CachePoolImpl* pool,
+    LruShard* probationary_evicted_shard = nullptr) noexcept {
+  const size_t num_shards = pool->num_lru_shards_;
+  const size_t start =
+      pool->next_eviction_shard_.fetch_add(1, std::memory_order_relaxed);
+  for (bool evict_protected : {false, true}) {
+    for (size_t i = 0; i < num_shards && IsOverLimit(pool); ++i) {
+      auto& shard = pool->lru_shards_[(start + i) % num_shards];
+      if (!evict_protected && &shard == probationary_evicted_shard) continue;
+      absl::MutexLock lock(shard.mutex);
+      EvictEntriesFromShard(pool, shard, evict_protected);
+    }
+  }
+}
+
+// Evicts entries until the pool is within its limit, starting with the
+// probationary segment of `locked_shard`, which must be locked by the caller.
+void MaybeEvictEntries(CachePoolImpl* pool, LruShard& locked_shard) noexcept {
+  const bool single_shard = pool->num_lru_shards_ == 1;
+  EvictEntriesFromShard(pool, locked_shard, /*evict_protected=*/single_shard);
+  if (single_shard || !IsOverLimit(pool)) return;
+  internal::ScopedUnlock unlock(locked_shard.mutex);
+  EvictEntriesFromShards(pool, &locked_shard);
+}
+
 void InitializeNewEntry(CacheEntryImpl* entry, CacheImpl* cache) noexcept {
   entry->cache_ = cache;
   entry->reference_count_.store(2, std::memory_order_relaxed);
@@ -241,7 +361,12 @@ void DestroyCache(CachePoolImpl* pool,
       }
     }
     if (HasLruCache(pool)) {
-      absl::MutexLock lru_lock(pool->lru_mutex_);
+      std::array<std::unique_lock<absl::Mutex>, CachePoolImpl::kMaxLruShards>
+          lru_locks;
+      for (size_t i = 0; i < pool->num_lru_shards_; ++i) {
+        lru_locks[i] =
+            std::unique_lock<absl::Mutex>(pool->lru_shards_[i].mutex);
+      }
       for (auto& shard : cache->shards_) {
         absl::MutexLock lock(shard.mutex);
         for (CacheEntryImpl* entry : shard.entries) {
@@ -250,7 +375,7 @@ void DestroyCache(CachePoolImpl* pool,
           // concurrent attempt to return `entry` back to the eviction list.
           entry->reference_count_.fetch_add(2, std::memory_order_acq_rel);
           // Ensure entry is not on LRU list.
-          UnregisterEntryFromPool(entry, pool);
+          UnregisterEntryFromPool(entry, pool, pool->LruShardForEntry(entry));
         }
       }
       // At this point, no external references to any entry are possible, and
@@ -370,17 +495,33 @@ void StrongPtrTraitsCacheEntry::decrement_impl(
         delete entry_impl;
       }
     } else {
+      auto& lru_shard = pool_impl->LruShardForEntry(entry_impl);
       auto lock = DecrementReferenceCountWithLock(
           entry_impl->reference_count_,
-          [pool_impl]() -> absl::Mutex& { return pool_impl->lru_mutex_; },
+          [&lru_shard]() -> absl::Mutex& { return lru_shard.mutex; },
           new_count,
           /*decrease_amount=*/2, /*lock_threshold=*/1);
       TENSORSTORE_INTERNAL_CACHE_DEBUG_REFCOUNT("CacheEntry:decrement",
                                                 entry_impl, new_count);
       if (!lock) return;
       if (new_count == 0) {
-        AddToEvictionQueue(pool_impl, entry_impl);
-        MaybeEvictEntries(pool_impl);
+        CacheEntryImpl::Retention retention =
+            CacheEntryImpl::kRetentionUnspecified;
+        if (!entry_impl->retention_.compare_exchange_strong(
+                retention, CacheEntryImpl::kRetainWhenUnused,
+                std::memory_order_relaxed) &&
+            retention == CacheEntryImpl::kEvictWhenUnused &&
+            UnregisterUnusedEntry(pool_impl, lru_shard, entry_impl)) {
+          // Release lock before invoking entry destructor, as that may be
+          // expensive.
+          lock = {};
+          delete entry_impl;
+        } else {
+          // Once retained, later requests not to retain the entry are
+          // ignored.
+          AddToEvictionQueue(pool_impl, lru_shard, entry_impl);
+          MaybeEvictEntries(pool_impl, lru_shard);
+        }
       }
     }
     // `entry` may not be valid at this point.
@@ -515,6 +656,10 @@ PinnedCacheEntry<Cache> GetCacheEntryInternal(internal::Cache* cache,
         // This ensures the Cache object is not destroyed while any of its
         // entries are referenced.
         StrongPtrTraitsCache::increment(cache);
+        if (HasSegmentedLruCache(cache_impl->pool_)) {
+          entry_impl->requested_while_unused_.store(true,
+                                                    std::memory_order_relaxed);
+        }
       }
       // Adopt reference added via `fetch_add` above.
       returned_entry =
@@ -674,9 +819,10 @@ void intrusive_ptr_decrement(CacheEntryWeakState* p)
     }
     return;
   }
+  auto& lru_shard = pool->LruShardForEntry(entry);
   auto pool_lock = DecrementReferenceCountWithLock(
       entry->reference_count_,
-      [pool]() -> absl::Mutex& { return pool->lru_mutex_; }, new_count,
+      [&lru_shard]() -> absl::Mutex& { return lru_shard.mutex; }, new_count,
       /*decrease_amount=*/1,
       /*lock_threshold=*/0);
   TENSORSTORE_INTERNAL_CACHE_DEBUG_REFCOUNT("CacheEntry:decrement", entry,
@@ -686,8 +832,8 @@ void intrusive_ptr_decrement(CacheEntryWeakState* p)
   // There are also no remaining strong references.  Update the entry's queue
   // state if applicable.
   weak_lock = {};
-  AddToEvictionQueue(pool, entry);
-  MaybeEvictEntries(pool);
+  AddToEvictionQueue(pool, lru_shard, entry);
+  MaybeEvictEntries(pool, lru_shard);
 }
 
 internal::IntrusivePtr<CacheEntryWeakState> AcquireWeakCacheEntryReference(
@@ -733,8 +879,7 @@ void UpdateTotalBytes(CachePoolImpl& pool, ptrdiff_t change) {
       change <= 0) {
     return;
   }
-  absl::MutexLock lock(pool.lru_mutex_);
-  MaybeEvictEntries(&pool);
+  EvictEntriesFromShards(&pool);
 }
 
 }  // namespace internal_cache
@@ -790,6 +935,35 @@ void CacheEntry::unlock() {
   internal_cache::UpdateTotalBytes(*pool_impl, change);
 }
 
+namespace {
+size_t GetPrefetchBudget(const CachePool::Limits& limits) {
+  return static_cast<size_t>(limits.prefetch_fraction *
+                             static_cast<double>(limits.total_bytes_limit));
+}
+}  // namespace
+
+size_t CachePool::available_prefetch_bytes() const {
+  const size_t budget = GetPrefetchBudget(limits_);
+  const size_t reserved = prefetch_bytes_.load(std::memory_order_relaxed);
+  return reserved >= budget ? 0 : budget - reserved;
+}
+
+bool CachePool::TryReservePrefetchBytes(size_t num_bytes) {
+  const size_t budget = GetPrefetchBudget(limits_);
+  size_t reserved = prefetch_bytes_.load(std::memory_order_relaxed);
+  do {
+    if (reserved > budget || num_bytes > budget - reserved) return false;
+  } while (!prefetch_bytes_.compare_exchange_weak(
+      reserved, reserved + num_bytes, std::memory_order_relaxed));
+  return true;
+}
+
+void CachePool::ReleasePrefetchBytes(size_t num_bytes) {
+  [[maybe_unused]] const size_t old_bytes =
+      prefetch_bytes_.fetch_sub(num_bytes, std::memory_order_relaxed);
+  assert(old_bytes >= num_bytes);
+}
+
 CachePool::StrongPtr CachePool::Make(const CachePool::Limits& cache_limits) {
   CachePool::StrongPtr pool;
   internal_cache::Access::StaticCast<internal_cache::CachePoolStrongPtr>(&pool)
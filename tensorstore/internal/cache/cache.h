@@ -97,8 +97,9 @@ using CachePtr = internal_cache::CachePtr<CacheType>;
 /// cache pool maintains a least-recently-used eviction queue of the entries;
 /// once the user-specified `CachePool:Limits` are reached, entries are evicted
 /// in order to attempt to free memory.  The limits apply to the aggregate
-/// memory usage of all caches managed by the pool, and a single LRU eviction
-/// queue is used for all managed caches.
+/// memory usage of all caches managed by the pool, and a single eviction queue
+/// (ordered according to `CachePool::Limits::eviction_policy`) is used for all
+/// managed caches.
 class CachePool : private internal_cache::CachePoolImpl {
  public:
   using Limits = CachePoolLimits;
@@ -106,6 +107,21 @@ class CachePool : private internal_cache::CachePoolImpl {
   /// Returns the limits of this cache pool.
   const Limits& limits() const { return limits_; }
 
+  /// Returns the number of bytes of the prefetch budget,
+  /// `limits().prefetch_fraction * limits().total_bytes_limit`, that are not
+  /// reserved by outstanding prefetches.
+  size_t available_prefetch_bytes() const;
+
+  /// Reserves `num_bytes` of the prefetch budget for a prefetch.
+  ///
+  /// \returns `false`, without reserving anything, if fewer than `num_bytes`
+  ///     are available.
+  bool TryReservePrefetchBytes(size_t num_bytes);
+
+  /// Releases bytes reserved by `TryReservePrefetchBytes` once the prefetch
+  /// completes.
+  void ReleasePrefetchBytes(size_t num_bytes);
+
   class WeakPtr;
 
   /// Reference-counted pointer to a cache pool that keeps in-use and recently
@@ -209,6 +225,29 @@ class ABSL_LOCKABLE CacheEntry : private internal_cache::CacheEntryImpl {
     flags_ |= kSizeChanged;
   }
 
+  /// Specifies whether this entry is retained by the cache pool once it is no
+  /// longer in use, until it is evicted due to memory pressure.
+  ///
+  /// If `false`, the entry is instead destroyed as soon as the last strong
+  /// reference is released, as if the pool had a `total_bytes_limit` of 0,
+  /// without displacing other entries.  This is a hint for entries that are
+  /// not expected to be requested again.
+  ///
+  /// Retention is sticky: a request to retain the entry always takes effect,
+  /// while a request not to retain it is ignored if the entry was previously
+  /// requested to be retained, or was already retained by the pool after an
+  /// earlier use.  This ensures that a user of the entry that does not need
+  /// it does not cause it to be evicted from under another user that does.
+  void SetRetainWhenUnused(bool retain) {
+    if (retain) {
+      retention_.store(kRetainWhenUnused, std::memory_order_relaxed);
+      return;
+    }
+    Retention expected = kRetentionUnspecified;
+    retention_.compare_exchange_strong(expected, kEvictWhenUnused,
+                                       std::memory_order_relaxed);
+  }
+
   /// Initializes an entry after it is allocated.
   ///
   /// Derived classes may override this method if initialization is required.
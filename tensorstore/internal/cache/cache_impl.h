@@ -52,6 +52,7 @@ class CachePool;
 namespace internal_cache {
 using internal::Cache;
 using internal::CacheEntry;
+using internal::CacheEvictionPolicy;
 using internal::CachePool;
 using internal::CachePoolLimits;
 
@@ -79,8 +80,8 @@ struct CacheEntryWeakState {
   // of `entry->reference_count_` is set to 1.
   std::atomic<size_t> weak_references;
 
-  // Mutex that protects access to `entry`.  If locked along with the cache
-  // pool's mutex, this mutex must be locked first.
+  // Mutex that protects access to `entry`.  If locked along with a cache
+  // pool LRU shard mutex, this mutex must be locked first.
   absl::Mutex mutex;
 
   // Pointer to the entry for which this is a weak reference.
@@ -143,6 +144,32 @@ class CacheEntryImpl : public internal_cache::LruListNode {
   // Set if the return value of `DoGetSizeInBytes` may have changed.
   constexpr static Flags kSizeChanged = 1;
 
+  // Set when the entry is requested while not in use, with the
+  // `CacheEvictionPolicy::kSegmentedLru` policy.  Consumed when the entry is
+  // next added to the eviction queue, to promote it to the protected segment.
+  std::atomic<bool> requested_while_unused_{false};
+
+  // Retention of the entry once it is no longer in use.  See
+  // `CacheEntry::SetRetainWhenUnused`.
+  using Retention = uint8_t;
+
+  // Neither requested explicitly, nor yet retained in the eviction queue.
+  constexpr static Retention kRetentionUnspecified = 0;
+
+  // Evict as soon as the entry is no longer in use, rather than adding it to
+  // the eviction queue.
+  constexpr static Retention kEvictWhenUnused = 1;
+
+  // Retain in the eviction queue.  Once set, this is never changed.
+  constexpr static Retention kRetainWhenUnused = 2;
+
+  std::atomic<Retention> retention_{kRetentionUnspecified};
+
+  // Number of bytes charged to `CachePoolImpl::LruShard::protected_bytes`, or
+  // 0 if the entry is not in the protected segment.  Protected by the mutex of
+  // the entry's LRU shard.
+  size_t protected_num_bytes_ = 0;
+
   // Initially set to `nullptr`.  Allocated when the first weak reference is
   // obtained, and remains until the entry is destroyed even if all weak
   // references are released.
@@ -218,12 +245,12 @@ class CacheImpl {
   /// If a thread causes the reference count to reach a ``ShouldDelete == true`
   /// state from a `ShouldDelete == false` state, then the thread must destroy
   /// the cache immediately. However, because of the use of multiple mutexes
-  /// (per shard mutexes on the cache entries hash table, `pool_->lru mutex_`,
-  /// `pool_->caches_mutex_`), it is possible for another thread that is
-  /// modifying `reference_count` to encounter a cache already in the
-  /// `ShouldDelete == true`. In this case, the other thread is NOT responsible
-  /// for destroying the cache, but can safely access it as long as it holds the
-  /// mutex.
+  /// (per shard mutexes on the cache entries hash table, per shard mutexes on
+  /// the pool's LRU lists, `pool_->caches_mutex_`), it is possible for another
+  /// thread that is modifying `reference_count` to encounter a cache already
+  /// in the `ShouldDelete == true`. In this case, the other thread is NOT
+  /// responsible for destroying the cache, but can safely access it as long as
+  /// it holds the mutex.
   constexpr static bool ShouldDelete(size_t reference_count) {
     return (reference_count & ~kCachePoolStrongReferenceIncrement) == 0 ||
            (reference_count & ~(kStrongReferenceIncrement - 1 -
@@ -273,14 +300,59 @@ class CachePoolImpl {
   CachePoolLimits limits_;
   std::atomic<size_t> total_bytes_;
 
-  // Protects access to `eviction_queue_`.  If `lru_mutex_` is held at the same
-  // time as `caches_mutex_`, `caches_mutex_` must be acquired first.  If
-  // `lru_mutex_` is held at the same time as `entries_mutex_`, `lru_mutex_`
-  // must be acquired first.
-  absl::Mutex lru_mutex_;
+  // Number of bytes reserved by outstanding prefetches, see
+  // `CachePool::TryReservePrefetchBytes`.
+  std::atomic<size_t> prefetch_bytes_{0};
+
+  /// Shard of the eviction queue.
+  ///
+  /// Each entry is assigned to a single shard by `LruShardForEntry`, so that
+  /// releasing the last reference to an entry only contends with other
+  /// entries assigned to the same shard.  `total_bytes_` is shared by all
+  /// shards, so the pool limit remains exact; only the eviction order is
+  /// approximate (least-recently used within each shard).
+  struct ABSL_CACHELINE_ALIGNED LruShard {
+    // Protects access to the queues of this shard.  If held at the same time
+    // as `caches_mutex_`, `caches_mutex_` must be acquired first.  If held at
+    // the same time as a `CacheImpl::Shard::mutex`, this must be acquired
+    // first.  At most one `LruShard::mutex` is held at a time, except by
+    // `DestroyCache`, which acquires them all in index order.
+    absl::Mutex mutex;
+
+    // next points to the front of the queue, which is the first to be
+    // evicted.
+    //
+    // With `CacheEvictionPolicy::kSegmentedLru`, this is the probationary
+    // segment.
+    LruListNode eviction_queue;
 
-  // next points to the front of the queue, which is the first to be evicted.
-  LruListNode eviction_queue_;
+    // Protected segment used by `CacheEvictionPolicy::kSegmentedLru`.  Entries
+    // in this queue are evicted only once the `eviction_queue` of every shard
+    // is empty.
+    LruListNode protected_queue;
+
+    // Total of `protected_num_bytes_` over entries in `protected_queue`.
+    size_t protected_bytes ABSL_GUARDED_BY(mutex) = 0;
+  };
+
+  constexpr static size_t kMaxLruShards = 16;
+
+  // Minimum portion of `total_bytes_limit` per LRU shard.  Small pools use a
+  // single shard, and therefore exact LRU order.
+  constexpr static size_t kMinBytesPerLruShard = 8 * 1024 * 1024;
+
+  // Number of elements of `lru_shards_` in use.
+  size_t num_lru_shards_;
+
+  LruShard lru_shards_[kMaxLruShards];
+
+  // Shard from which `UpdateTotalBytes` next starts evicting.
+  std::atomic<size_t> next_eviction_shard_{0};
+
+  LruShard& LruShardForEntry(const CacheEntryImpl* entry) {
+    if (num_lru_shards_ == 1) return lru_shards_[0];
+    return lru_shards_[absl::Hash<const void*>{}(entry) % num_lru_shards_];
+  }
 
   // Protects access to `caches_`.
   absl::Mutex caches_mutex_;
@@ -395,6 +467,11 @@ inline bool HasLruCache(CachePoolImpl* pool) {
   return pool && pool->limits_.total_bytes_limit != 0;
 }
 
+inline bool HasSegmentedLruCache(CachePoolImpl* pool) {
+  return HasLruCache(pool) && pool->limits_.eviction_policy ==
+                                  CacheEvictionPolicy::kSegmentedLru;
+}
+
 void UpdateTotalBytes(CachePoolImpl& pool, ptrdiff_t change);
 
 }  // namespace internal_cache
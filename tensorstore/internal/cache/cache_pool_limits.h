@@ -20,12 +20,37 @@
 namespace tensorstore {
 namespace internal {
 
+/// Policy used to choose which unused entries to evict once the memory limit
+/// of a cache pool is reached.
+enum class CacheEvictionPolicy : unsigned char {
+  /// Evicts the least-recently used entry.
+  kLru = 0,
+
+  /// Segmented LRU.  Newly-cached entries are admitted to a probationary
+  /// segment, and are promoted to a protected segment only when they are
+  /// requested again after becoming unused.  Entries in the probationary
+  /// segment are evicted first, which prevents a single large sequential scan
+  /// from evicting a frequently-used working set.
+  kSegmentedLru,
+};
+
 /// Memory limit parameters for a cache pool.
 struct CachePoolLimits {
   size_t total_bytes_limit = 0;
+  CacheEvictionPolicy eviction_policy = CacheEvictionPolicy::kLru;
+
+  /// Number of rows of chunks, beyond those requested, that are prefetched
+  /// when reads of a chunked array are detected to proceed sequentially
+  /// along one grid dimension.  Zero disables sequential prefetching.
+  size_t prefetch_chunk_rows = 0;
+
+  /// Maximum fraction of `total_bytes_limit` that may be reserved by
+  /// outstanding sequential prefetches.
+  double prefetch_fraction = 0.25;
 
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-    return f(x.total_bytes_limit);
+    return f(x.total_bytes_limit, x.eviction_policy, x.prefetch_chunk_rows,
+             x.prefetch_fraction);
   };
 };
 
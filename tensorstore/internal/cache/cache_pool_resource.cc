@@ -14,12 +14,17 @@
 
 #include "tensorstore/internal/cache/cache_pool_resource.h"
 
+#include <string_view>
+
+#include "absl/status/status.h"
 #include <nlohmann/json.hpp>
 #include "tensorstore/context.h"
 #include "tensorstore/context_resource_provider.h"
 #include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/internal/cache/cache_pool_limits.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/enum.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/util/result.h"
 
@@ -37,7 +42,35 @@ struct CachePoolResourceTraits
     return jb::Object(
         jb::Member("total_bytes_limit",
                    jb::Projection(&Spec::total_bytes_limit,
-                                  jb::DefaultValue([](auto* v) { *v = 0; }))));
+                                  jb::DefaultValue([](auto* v) { *v = 0; }))),
+        jb::Member(
+            "eviction_policy",
+            jb::Projection(
+                &Spec::eviction_policy,
+                jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                    [](auto* v) { *v = CacheEvictionPolicy::kLru; },
+                    jb::Enum<CacheEvictionPolicy, std::string_view>({
+                        {CacheEvictionPolicy::kLru, "lru"},
+                        {CacheEvictionPolicy::kSegmentedLru, "segmented_lru"},
+                    })))),
+        jb::Member("prefetch_chunk_rows",
+                   jb::Projection(&Spec::prefetch_chunk_rows,
+                                  jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                                      [](auto* v) { *v = 0; }))),
+        jb::Member("prefetch_fraction",
+                   jb::Projection(
+                       &Spec::prefetch_fraction,
+                       jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                           [](auto* v) { *v = 0.25; },
+                           jb::Validate(
+                               [](const auto& options, const double* x) {
+                                 if (*x >= 0 && *x <= 1) {
+                                   return absl::OkStatus();
+                                 }
+                                 return absl::InvalidArgumentError(
+                                     "Expected a value in the range [0, 1]");
+                               },
+                               jb::LooseFloatBinder)))));
   }
   static Result<Resource> Create(const Spec& limits,
                                  ContextResourceCreationContext context) {
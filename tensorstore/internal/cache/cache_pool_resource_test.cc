@@ -17,9 +17,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
+#include "absl/status/status.h"
 #include "tensorstore/context.h"
 #include "tensorstore/internal/cache/cache.h"
 #include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/testing/json_gtest.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/status.h"
 #include "tensorstore/util/status_testutil.h"
@@ -27,6 +29,10 @@
 namespace {
 
 using ::tensorstore::Context;
+using ::tensorstore::IsOkAndHolds;
+using ::tensorstore::MatchesJson;
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal::CacheEvictionPolicy;
 using ::tensorstore::internal::CachePoolResource;
 
 TEST(CachePoolResourceTest, Default) {
@@ -49,6 +55,49 @@ TEST(CachePoolResourceTest, TotalBytesLimitOnly) {
                               {{"total_bytes_limit", 100}}));
   auto cache = Context::Default().GetResource(resource_spec).value();
   EXPECT_EQ(100u, (*cache)->limits().total_bytes_limit);
+  EXPECT_EQ(CacheEvictionPolicy::kLru, (*cache)->limits().eviction_policy);
+}
+
+TEST(CachePoolResourceTest, SegmentedLru) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto resource_spec,
+      Context::Resource<CachePoolResource>::FromJson(
+          {{"total_bytes_limit", 100}, {"eviction_policy", "segmented_lru"}}));
+  auto cache = Context::Default().GetResource(resource_spec).value();
+  EXPECT_EQ(100u, (*cache)->limits().total_bytes_limit);
+  EXPECT_EQ(CacheEvictionPolicy::kSegmentedLru,
+            (*cache)->limits().eviction_policy);
+  EXPECT_THAT(resource_spec.ToJson(),
+              IsOkAndHolds(MatchesJson({{"total_bytes_limit", 100},
+                                        {"eviction_policy", "segmented_lru"}})));
+}
+
+TEST(CachePoolResourceTest, Prefetch) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto resource_spec,
+      Context::Resource<CachePoolResource>::FromJson(
+          {{"total_bytes_limit", 100},
+           {"prefetch_chunk_rows", 2},
+           {"prefetch_fraction", 0.5}}));
+  auto cache = Context::Default().GetResource(resource_spec).value();
+  EXPECT_EQ(2u, (*cache)->limits().prefetch_chunk_rows);
+  EXPECT_EQ(0.5, (*cache)->limits().prefetch_fraction);
+  EXPECT_THAT(resource_spec.ToJson(),
+              IsOkAndHolds(MatchesJson({{"total_bytes_limit", 100},
+                                        {"prefetch_chunk_rows", 2},
+                                        {"prefetch_fraction", 0.5}})));
+}
+
+TEST(CachePoolResourceTest, InvalidPrefetchFraction) {
+  EXPECT_THAT(Context::Resource<CachePoolResource>::FromJson(
+                  {{"prefetch_fraction", 1.5}}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(CachePoolResourceTest, InvalidEvictionPolicy) {
+  EXPECT_THAT(Context::Resource<CachePoolResource>::FromJson(
+                  {{"eviction_policy", "mru"}}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
 }
 
 }  // namespace
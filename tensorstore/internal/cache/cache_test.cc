@@ -23,11 +23,13 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/mutex.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/mutex.h"
@@ -163,7 +165,15 @@ void AssertInvariants(const CachePool::StrongPtr& pool,
                       absl::flat_hash_set<Cache*> expected_caches)
     ABSL_NO_THREAD_SAFETY_ANALYSIS {
   auto* pool_impl = GetPoolImpl(pool);
-  auto eviction_queue_entries = GetEntrySet(&pool_impl->eviction_queue_);
+  absl::flat_hash_set<EntryIdentifier> eviction_queue_entries;
+  for (size_t i = 0; i < pool_impl->num_lru_shards_; ++i) {
+    auto& shard = pool_impl->lru_shards_[i];
+    for (auto* queue : {&shard.eviction_queue, &shard.protected_queue}) {
+      for (auto& entry : GetEntrySet(queue)) {
+        EXPECT_TRUE(eviction_queue_entries.insert(entry).second);
+      }
+    }
+  }
 
   absl::flat_hash_set<EntryIdentifier> expected_eviction_queue_entries;
 
@@ -1103,6 +1113,155 @@ TEST(CacheTest, PoolWithNonZeroBytesLimit) {
   EXPECT_THAT(log->entry_destroy_log, ElementsAre(Pair("cache", "a")));
 }
 
+// Returns the data of each of `keys` that remains cached after a sequential
+// scan over many entries that are each used only once.
+std::vector<std::string> GetDataAfterScan(
+    tensorstore::internal::CacheEvictionPolicy eviction_policy,
+    std::vector<std::string> keys) {
+  CachePool::Limits limits;
+  limits.total_bytes_limit = 10;
+  limits.eviction_policy = eviction_policy;
+  auto pool = CachePool::Make(limits);
+  auto cache = GetTestCache(pool.get(), "cache");
+  // Use each key twice, with the entry released in between.
+  for (const auto& key : keys) {
+    GetCacheEntry(cache, key)->data = key;
+  }
+  for (const auto& key : keys) {
+    EXPECT_EQ(key, GetCacheEntry(cache, key)->data);
+  }
+  for (int i = 0; i < 100; ++i) {
+    GetCacheEntry(cache, absl::StrCat("scan", i))->data = "scan";
+    TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(pool, {cache.get()});
+  }
+  std::vector<std::string> data;
+  for (const auto& key : keys) {
+    data.push_back(GetCacheEntry(cache, key)->data);
+  }
+  return data;
+}
+
+TEST(CacheTest, LruEvictedByScan) {
+  EXPECT_THAT(
+      GetDataAfterScan(tensorstore::internal::CacheEvictionPolicy::kLru,
+                       {"a", "b"}),
+      ElementsAre("", ""));
+}
+
+TEST(CacheTest, SegmentedLruRetainedDuringScan) {
+  EXPECT_THAT(GetDataAfterScan(
+                  tensorstore::internal::CacheEvictionPolicy::kSegmentedLru,
+                  {"a", "b"}),
+              ElementsAre("a", "b"));
+}
+
+TEST(CacheTest, SegmentedLruProtectedSegmentBounded) {
+  // The protected segment is limited to 8 of the 10 bytes, so the first
+  // promoted entries are demoted and then evicted by the scan.
+  std::vector<std::string> keys;
+  for (int i = 0; i < 10; ++i) keys.push_back(absl::StrCat("k", i));
+  auto data = GetDataAfterScan(
+      tensorstore::internal::CacheEvictionPolicy::kSegmentedLru, keys);
+  EXPECT_THAT(data, ElementsAre("", "", "k2", "k3", "k4", "k5", "k6", "k7",
+                                "k8", "k9"));
+}
+
+TEST(CacheTest, ShardedEvictionQueueRespectsLimit) {
+  CachePool::Limits limits;
+  limits.total_bytes_limit = size_t(1) << 30;
+  auto pool = CachePool::Make(limits);
+  EXPECT_EQ(CachePoolImpl::kMaxLruShards, GetPoolImpl(pool)->num_lru_shards_);
+  auto log = std::make_shared<TestCache::RequestLog>();
+  auto cache = GetTestCache(pool.get(), "cache", log);
+  constexpr size_t kEntrySize = size_t(100) << 20;
+  for (int i = 0; i < 100; ++i) {
+    GetCacheEntry(cache, absl::StrCat(i))->ChangeSize(kEntrySize);
+    EXPECT_LE(GetPoolImpl(pool)->total_bytes_.load(), limits.total_bytes_limit);
+    TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(pool, {cache.get()});
+  }
+  // Every entry beyond what fits within the limit has been evicted, regardless
+  // of which shard it was assigned to.
+  absl::MutexLock lock(log->mutex);
+  EXPECT_EQ(100 - limits.total_bytes_limit / kEntrySize,
+            log->entry_destroy_log.size());
+}
+
+TEST(CacheTest, ShardedSegmentedLruEvictsProbationaryEntriesFirst) {
+  CachePool::Limits limits;
+  limits.total_bytes_limit = size_t(1) << 30;
+  limits.eviction_policy =
+      tensorstore::internal::CacheEvictionPolicy::kSegmentedLru;
+  auto pool = CachePool::Make(limits);
+  ASSERT_EQ(CachePoolImpl::kMaxLruShards, GetPoolImpl(pool)->num_lru_shards_);
+  auto cache = GetTestCache(pool.get(), "cache");
+  constexpr size_t kEntrySize = size_t(1) << 20;
+  // Promote the hot entries, spread over all shards, to the protected segment.
+  std::vector<std::string> hot_keys;
+  for (int i = 0; i < 64; ++i) {
+    hot_keys.push_back(absl::StrCat("hot", i));
+    auto entry = GetCacheEntry(cache, hot_keys.back());
+    entry->data = hot_keys.back();
+    entry->ChangeSize(kEntrySize);
+  }
+  for (const auto& key : hot_keys) {
+    EXPECT_EQ(key, GetCacheEntry(cache, key)->data);
+  }
+  // Fill the probationary segments.
+  for (int i = 0; i < 1024; ++i) {
+    GetCacheEntry(cache, absl::StrCat("scan", i))->ChangeSize(kEntrySize);
+  }
+  // Growing an entry beyond the probationary entries of any single shard
+  // evicts probationary entries of the other shards before protected ones.
+  GetCacheEntry(cache, "large")->ChangeSize(200 * kEntrySize);
+  TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(pool, {cache.get()});
+  for (const auto& key : hot_keys) {
+    EXPECT_EQ(key, GetCacheEntry(cache, key)->data);
+  }
+}
+
+TEST(CacheTest, EntryNotRetainedWhenUnused) {
+  auto log = std::make_shared<TestCache::RequestLog>();
+  auto pool = CachePool::Make(kSmallCacheLimits);
+  auto cache = GetTestCache(pool.get(), "cache", log);
+  GetCacheEntry(cache, "a")->data = "a";
+  {
+    auto entry = GetCacheEntry(cache, "b");
+    entry->data = "b";
+    entry->SetRetainWhenUnused(false);
+    TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(pool, {cache.get()});
+  }
+  // Only the entry that is not retained is destroyed once released.
+  EXPECT_THAT(log->entry_destroy_log, ElementsAre(Pair("cache", "b")));
+  TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(pool, {cache.get()});
+  EXPECT_EQ("a", GetCacheEntry(cache, "a")->data);
+  EXPECT_EQ("", GetCacheEntry(cache, "b")->data);
+
+  // A request to retain the entry takes precedence, regardless of order.
+  {
+    auto entry = GetCacheEntry(cache, "c");
+    entry->data = "c";
+    entry->SetRetainWhenUnused(false);
+    entry->SetRetainWhenUnused(true);
+  }
+  EXPECT_EQ("c", GetCacheEntry(cache, "c")->data);
+  {
+    auto entry = GetCacheEntry(cache, "d");
+    entry->data = "d";
+    entry->SetRetainWhenUnused(true);
+    entry->SetRetainWhenUnused(false);
+  }
+  EXPECT_EQ("d", GetCacheEntry(cache, "d")->data);
+
+  // An entry already retained by the pool is not evicted by a later user that
+  // does not need it.
+  {
+    auto entry = GetCacheEntry(cache, "a");
+    entry->SetRetainWhenUnused(false);
+  }
+  EXPECT_EQ("a", GetCacheEntry(cache, "a")->data);
+  EXPECT_THAT(log->entry_destroy_log, ElementsAre(Pair("cache", "b")));
+}
+
 TEST(CacheTest, WeakRefOwnedByEntry) {
   auto log = std::make_shared<TestCache::RequestLog>();
   auto pool = CachePool::Make(kSmallCacheLimits);
@@ -17,10 +17,12 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <memory>
 #include <mutex>  // NOLINT
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -34,12 +36,15 @@
 #include "tensorstore/box.h"
 #include "tensorstore/driver/chunk.h"
 #include "tensorstore/index.h"
+#include "tensorstore/index_interval.h"
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/index_space/transformed_array.h"
 #include "tensorstore/internal/arena.h"
 #include "tensorstore/internal/async_write_array.h"
 #include "tensorstore/internal/cache/async_cache.h"
 #include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/internal/cache/cache_pool_limits.h"
+#include "tensorstore/internal/cache/sequential_access_detector.h"
 #include "tensorstore/internal/chunk_grid_specification.h"
 #include "tensorstore/internal/grid_partition_iterator.h"
 #include "tensorstore/internal/intrusive_ptr.h"
@@ -49,15 +54,19 @@
 #include "tensorstore/internal/metrics/registration.h"
 #include "tensorstore/internal/nditerable.h"
 #include "tensorstore/internal/regular_grid.h"
+#include "tensorstore/internal/tracing/local_trace_span.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/rank.h"
 #include "tensorstore/read_write_options.h"
 #include "tensorstore/transaction.h"
+#include "tensorstore/util/division.h"
 #include "tensorstore/util/execution/execution.h"
 #include "tensorstore/util/execution/flow_sender_operation_state.h"
 #include "tensorstore/util/executor.h"
+#include "tensorstore/util/extents.h"
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/generic_stringify.h"
+#include "tensorstore/util/iterate_over_index_range.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
@@ -72,6 +81,11 @@ TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
     MetricMetadata("/tensorstore/cache/chunk_cache/reads",
                    "Number of reads from ChunkCache."));
 
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    num_prefetch_reads, Counter<int64_t>,
+    MetricMetadata("/tensorstore/cache/chunk_cache/prefetch_reads",
+                   "Number of chunks prefetched by ChunkCache."));
+
 #ifndef TENSORSTORE_INTERNAL_CHUNK_CACHE_DEBUG
 #define TENSORSTORE_INTERNAL_CHUNK_CACHE_DEBUG 0
 #endif
@@ -99,6 +113,34 @@ bool IsFullyOverwritten(ChunkCache::TransactionNode& node) {
   return true;
 }
 
+/// Returns the bounding box of the grid cells that intersect the valid data
+/// bounds of at least one component.
+Box<> GetValidGridCellBounds(const ChunkGridSpecification& grid) {
+  Box<> cell_bounds(grid.grid_rank());
+  for (DimensionIndex grid_dim = 0; grid_dim < grid.grid_rank(); ++grid_dim) {
+    const Index chunk_size = grid.chunk_shape[grid_dim];
+    IndexInterval bounds = IndexInterval::UncheckedSized(0, 0);
+    for (const auto& component : grid.components) {
+      const IndexInterval data_bounds =
+          component.array_spec.valid_data_bounds
+              [component.chunked_to_cell_dimensions[grid_dim]];
+      if (data_bounds.empty()) continue;
+      const Index inclusive_min =
+          data_bounds.inclusive_min() == -kInfIndex
+              ? -kInfIndex
+              : FloorOfRatio(data_bounds.inclusive_min(), chunk_size);
+      const Index inclusive_max =
+          data_bounds.inclusive_max() == kInfIndex
+              ? kInfIndex
+              : FloorOfRatio(data_bounds.inclusive_max(), chunk_size);
+      bounds = Hull(
+          bounds, IndexInterval::UncheckedClosed(inclusive_min, inclusive_max));
+    }
+    cell_bounds[grid_dim] = bounds;
+  }
+  return cell_bounds;
+}
+
 /// TensorStore Driver ReadChunk implementation for the chunk cache, for the
 /// case of a non-transactional read.
 ///
@@ -434,13 +476,15 @@ class ReadOperationState : public AtomicReferenceCount<ReadOperationState> {
         iterator_(self_.grid()
                       .components[request_.component_index]
                       .chunked_to_cell_dimensions,
-                  regular_grid_, request_.transform) {}
+                  regular_grid_, request_.transform),
+        read_cells_(self_.grid().grid_rank()) {}
 
   absl::Status InitiateRead() {
     num_reads.Increment();
     TENSORSTORE_ASSIGN_OR_RETURN(
         auto cell_to_source,
         ComposeTransforms(request_.transform, iterator_.cell_transform()));
+    ExtendReadCells(iterator_.output_grid_cell_indices());
     auto entry =
         GetEntryForGridCell(self_, iterator_.output_grid_cell_indices());
     // Arrange to call `set_value` on the receiver with a `ReadChunk`
@@ -465,6 +509,7 @@ class ReadOperationState : public AtomicReferenceCount<ReadOperationState> {
           ReadChunkTransactionImpl{request_.component_index, std::move(node),
                                    request_.fill_missing_data_reads};
     } else {
+      entry->SetRetainWhenUnused(request_.retain_cached_chunks);
       read_future = entry->Read(get_cache_read_request());
       chunk.impl = ReadChunkImpl{request_.component_index, std::move(entry),
                                  request_.fill_missing_data_reads};
@@ -498,12 +543,32 @@ class ReadOperationState : public AtomicReferenceCount<ReadOperationState> {
     completion_->SetError(std::move(status));
   }
 
+  const ChunkCache::ReadRequest& request() const { return request_; }
+
+  /// Returns the bounding box of the grid cells read, or `std::nullopt` if no
+  /// grid cells were read.
+  std::optional<BoxView<>> read_cells() const {
+    if (num_read_cells_ == 0) return std::nullopt;
+    return read_cells_;
+  }
+
  private:
+  void ExtendReadCells(tensorstore::span<const Index> cell_indices) {
+    for (DimensionIndex i = 0; i < read_cells_.rank(); ++i) {
+      const auto cell = IndexInterval::UncheckedSized(cell_indices[i], 1);
+      read_cells_[i] =
+          num_read_cells_ == 0 ? cell : Hull(read_cells_[i], cell);
+    }
+    ++num_read_cells_;
+  }
+
   IntrusivePtr<ReadCompletionState> completion_;
   ChunkCache& self_;
   ChunkCache::ReadRequest request_;
   internal_grid_partition::RegularGridRef regular_grid_;
   internal_grid_partition::PartitionIndexTransformIterator iterator_;
+  Box<> read_cells_;
+  Index num_read_cells_ = 0;
 };
 
 }  // namespace
@@ -515,12 +580,69 @@ void ChunkCache::Read(ReadRequest request, ReadChunkReceiver receiver) {
   assert(grid.components[request.component_index]
              .chunked_to_cell_dimensions.size() == grid.chunk_shape.size());
 
+  internal_tracing::LocalTraceSpan trace_span("ChunkCache::Read");
   auto state = MakeIntrusivePtr<ReadOperationState>(std::move(receiver), *this,
                                                     std::move(request));
   auto status = state->IteratorLoop();
   if (!status.ok()) {
     state->SetError(std::move(status));
+    return;
   }
+  if (auto read_cells = state->read_cells()) {
+    MaybePrefetch(state->request(), *read_cells);
+  }
+}
+
+void ChunkCache::MaybePrefetch(const ReadRequest& request, BoxView<> cells) {
+  auto* pool = this->pool();
+  if (!pool || request.transaction || !request.retain_cached_chunks) return;
+  const auto& limits = pool->limits();
+  if (limits.prefetch_chunk_rows == 0 || limits.total_bytes_limit == 0) {
+    return;
+  }
+
+  // All components of a grid cell are loaded together.
+  Index chunk_bytes = 0;
+  for (const auto& component : grid().components) {
+    chunk_bytes += ProductOfExtents(tensorstore::span(component.chunk_shape)) *
+                   component.dtype().size();
+  }
+  chunk_bytes = std::max(chunk_bytes, Index(1));
+  // Prefetches that are still outstanding count against the budget, so that
+  // prefetching cannot outpace the reads that consume it.
+  const Index max_cells =
+      static_cast<Index>(pool->available_prefetch_bytes()) / chunk_bytes;
+  auto prefetch_cells = sequential_access_detectors_.Observe(
+      cells, static_cast<Index>(limits.prefetch_chunk_rows), max_cells);
+  if (!prefetch_cells) return;
+
+  // Rows past the end of the array resolve to missing chunks, and are not
+  // prefetched.
+  const Box<> valid_cells = GetValidGridCellBounds(grid());
+  for (DimensionIndex i = 0; i < prefetch_cells->rank(); ++i) {
+    (*prefetch_cells)[i] = Intersect((*prefetch_cells)[i], valid_cells[i]);
+  }
+  const Index num_cells = prefetch_cells->num_elements();
+  if (num_cells == 0 ||
+      !pool->TryReservePrefetchBytes(num_cells * chunk_bytes)) {
+    return;
+  }
+
+  AsyncCache::AsyncCacheReadRequest cache_request;
+  cache_request.staleness_bound = request.staleness_bound;
+  IterateOverIndexRange(
+      *prefetch_cells, [&](tensorstore::span<const Index> cell_indices) {
+        num_prefetch_reads.Increment();
+        auto entry = GetEntryForGridCell(*this, cell_indices);
+        // The read is cancelled if its future is released before it
+        // completes, so the callback retains it.
+        entry->Read(cache_request)
+            .ExecuteWhenReady([entry = std::move(entry),
+                               pool = CachePool::WeakPtr(pool),
+                               chunk_bytes](ReadyFuture<const void> future) {
+              pool->ReleasePrefetchBytes(chunk_bytes);
+            });
+      });
 }
 
 void ChunkCache::Write(WriteRequest request, WriteChunkReceiver receiver) {
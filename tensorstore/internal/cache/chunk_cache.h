@@ -57,6 +57,7 @@
 #include "absl/status/status.h"
 #include "absl/time/time.h"
 #include "tensorstore/array.h"
+#include "tensorstore/box.h"
 #include "tensorstore/driver/chunk.h"
 #include "tensorstore/driver/read_request.h"
 #include "tensorstore/driver/write_request.h"
@@ -64,6 +65,7 @@
 #include "tensorstore/internal/async_write_array.h"
 #include "tensorstore/internal/cache/async_cache.h"
 #include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/internal/cache/sequential_access_detector.h"
 #include "tensorstore/internal/chunk_grid_specification.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/transaction.h"
@@ -244,6 +246,18 @@ class ChunkCache : public AsyncCache {
   Future<const void> DeleteCell(
       tensorstore::span<const Index> grid_cell_indices,
       internal::OpenTransactionPtr transaction);
+
+  /// Records a read of the grid cells within `cells`, and prefetches
+  /// subsequent rows of grid cells if reads are sequential, as configured by
+  /// `CachePoolLimits::prefetch_chunk_rows`.
+  ///
+  /// Only grid cells that intersect the valid data bounds of some component
+  /// are prefetched, and the total size of outstanding prefetches is limited
+  /// by `CachePoolLimits::prefetch_fraction`.
+  void MaybePrefetch(const ReadRequest& request, BoxView<> cells);
+
+ private:
+  SequentialAccessDetectorSet sequential_access_detectors_;
 };
 
 class ConcreteChunkCache : public ChunkCache {
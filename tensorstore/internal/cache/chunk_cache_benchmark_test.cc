@@ -17,6 +17,7 @@
 #include <cassert>
 #include <memory>
 #include <ostream>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -84,6 +85,7 @@ using ::tensorstore::internal::DriverWrite;
 using ::tensorstore::internal::DriverWriteOptions;
 using ::tensorstore::internal::ElementCopyFunction;
 using ::tensorstore::internal::GetCache;
+using ::tensorstore::internal::GetCacheEntry;
 using ::tensorstore::internal::GetOwningCache;
 
 /// Benchmark configuration for read/write benchmark.
@@ -391,4 +393,61 @@ struct RegisterBenchmarks {
   }
 } register_benchmarks_;
 
+/// Minimal cache used to measure the cost of concurrent cache hits, which is
+/// dominated by the eviction queue bookkeeping performed when an entry
+/// transitions between in-use and unused.
+class HitBenchmarkCache : public tensorstore::internal::Cache {
+ public:
+  class Entry : public tensorstore::internal::Cache::Entry {
+   public:
+    using OwningCache = HitBenchmarkCache;
+  };
+  Entry* DoAllocateEntry() final { return new Entry; }
+  size_t DoGetSizeofEntry() final { return sizeof(Entry); }
+};
+
+constexpr size_t kNumHitBenchmarkKeys = 4096;
+
+/// Repeatedly acquires and releases cached entries from `state.threads()`
+/// threads.  `state.range(0)` specifies the total bytes limit of the pool,
+/// which determines the number of eviction queue shards.
+void BenchmarkConcurrentCacheHit(::benchmark::State& state) {
+  static CachePool::StrongPtr pool;
+  static CachePtr<HitBenchmarkCache> cache;
+  static std::vector<std::string> keys;
+  if (state.thread_index() == 0) {
+    CachePool::Limits limits;
+    limits.total_bytes_limit = state.range(0);
+    pool = CachePool::Make(limits);
+    cache = GetCache<HitBenchmarkCache>(
+        pool.get(), "", [] { return std::make_unique<HitBenchmarkCache>(); });
+    keys.clear();
+    for (size_t i = 0; i < kNumHitBenchmarkKeys; ++i) {
+      keys.push_back(absl::StrCat(i));
+      // Populate the cache; the entry is retained in the eviction queue once
+      // the reference is released.
+      GetCacheEntry(cache, keys.back());
+    }
+  }
+  size_t i = state.thread_index() * 7919;
+  for (auto s : state) {
+    auto entry = GetCacheEntry(cache, keys[i++ % kNumHitBenchmarkKeys]);
+    ::benchmark::DoNotOptimize(entry);
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    cache.reset();
+    pool.reset();
+  }
+}
+
+BENCHMARK(BenchmarkConcurrentCacheHit)
+    ->Arg(1 << 20)
+    ->Arg(1 << 30)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16)
+    ->Threads(64)
+    ->UseRealTime();
+
 }  // namespace
@@ -101,6 +101,7 @@ using ::tensorstore::Executor;
 using ::tensorstore::Future;
 using ::tensorstore::Index;
 using ::tensorstore::IndexTransform;
+using ::tensorstore::InlineExecutor;
 using ::tensorstore::MakeArray;
 using ::tensorstore::no_transaction;
 using ::tensorstore::Result;
@@ -470,6 +471,191 @@ TEST_F(ChunkCacheTest, ReadSingleComponentOneDimensionalFill) {
   }
 }
 
+// Tests that `Prefetch` loads chunks that are then used by `Read`.
+TEST_F(ChunkCacheTest, Prefetch) {
+  grid = GetSimple1DGrid();
+  auto cache = MakeChunkCache();
+  auto store = GetTensorStore(cache, absl::InfinitePast()) |
+               tensorstore::Dims(0).TranslateSizedInterval(3, 3);
+  {
+    auto prefetch_future = tensorstore::Prefetch(store);
+    std::vector<std::vector<Index>> read_requests;
+    for (size_t i = 0; i < 2; ++i) {
+      auto r = mock_store->read_requests.pop();
+      read_requests.emplace_back(ParseKey(r.key));
+      r(memory_store);
+    }
+    EXPECT_THAT(read_requests, ::testing::UnorderedElementsAre(
+                                   ElementsAre(1), ElementsAre(2)));
+    TENSORSTORE_EXPECT_OK(prefetch_future.result());
+  }
+  EXPECT_THAT(tensorstore::Read(store).result(),
+              ::testing::Optional(tensorstore::MakeArray({3, 4, 5})));
+  EXPECT_TRUE(mock_store->read_requests.empty());
+}
+
+// Tests that sequential reads prefetch subsequent chunks.
+TEST_F(ChunkCacheTest, SequentialPrefetch) {
+  grid = GetSimple1DGrid();
+  CachePool::Limits limits;
+  limits.total_bytes_limit = 10000000;
+  limits.prefetch_chunk_rows = 2;
+  auto cache = MakeChunkCache({}, CachePool::Make(limits));
+  auto read_chunk = [&](Index cell) {
+    return tensorstore::Read(
+        GetTensorStore(cache, absl::InfinitePast()) |
+        tensorstore::Dims(0).TranslateSizedInterval(cell * 2, 2));
+  };
+  const auto pop_keys = [&](size_t n) {
+    std::vector<std::vector<Index>> read_requests;
+    for (size_t i = 0; i < n; ++i) {
+      auto r = mock_store->read_requests.pop();
+      read_requests.emplace_back(ParseKey(r.key));
+      r(memory_store);
+    }
+    return read_requests;
+  };
+
+  // The first read does not indicate a direction.
+  {
+    auto read_future = read_chunk(0);
+    EXPECT_THAT(pop_keys(1), ElementsAre(ElementsAre(0)));
+    EXPECT_THAT(read_future.result(),
+                ::testing::Optional(tensorstore::MakeArray({0, 1})));
+  }
+
+  // The second read prefetches the following two chunks.
+  {
+    auto read_future = read_chunk(1);
+    EXPECT_THAT(pop_keys(3), ::testing::UnorderedElementsAre(ElementsAre(1),
+                                                             ElementsAre(2),
+                                                             ElementsAre(3)));
+    EXPECT_THAT(read_future.result(),
+                ::testing::Optional(tensorstore::MakeArray({2, 3})));
+  }
+
+  // The third read is satisfied by the cache, and prefetches one more chunk.
+  {
+    auto read_future = read_chunk(2);
+    EXPECT_THAT(pop_keys(1), ElementsAre(ElementsAre(4)));
+    EXPECT_THAT(read_future.result(),
+                ::testing::Optional(tensorstore::MakeArray({4, 5})));
+  }
+  EXPECT_TRUE(mock_store->read_requests.empty());
+}
+
+// Tests that sequential prefetching stops at the valid data bounds.
+TEST_F(ChunkCacheTest, SequentialPrefetchClipsToValidBounds) {
+  // Dimension 0 is chunked with a size of 2, and has 3 chunks.
+  grid = ChunkGridSpecification({ChunkGridSpecification::Component{
+      AsyncWriteArray::Spec{MakeSequentialArray<int>(BoxView<>{{0}, {10}}),
+                            Box<>({0}, {6})},
+      /*chunk_shape=*/{2}}});
+  CachePool::Limits limits;
+  limits.total_bytes_limit = 10000000;
+  limits.prefetch_chunk_rows = 2;
+  auto cache = MakeChunkCache({}, CachePool::Make(limits));
+  auto read_chunk = [&](Index cell) {
+    return tensorstore::Read(
+        GetTensorStore(cache, absl::InfinitePast()) |
+        tensorstore::Dims(0).TranslateSizedInterval(cell * 2, 2));
+  };
+  const auto pop_keys = [&](size_t n) {
+    std::vector<std::vector<Index>> read_requests;
+    for (size_t i = 0; i < n; ++i) {
+      auto r = mock_store->read_requests.pop();
+      read_requests.emplace_back(ParseKey(r.key));
+      r(memory_store);
+    }
+    return read_requests;
+  };
+
+  {
+    auto read_future = read_chunk(0);
+    EXPECT_THAT(pop_keys(1), ElementsAre(ElementsAre(0)));
+    TENSORSTORE_EXPECT_OK(read_future.result());
+  }
+
+  // Only the last chunk, and not the following one, is prefetched.
+  {
+    auto read_future = read_chunk(1);
+    EXPECT_THAT(pop_keys(2), ::testing::UnorderedElementsAre(ElementsAre(1),
+                                                             ElementsAre(2)));
+    TENSORSTORE_EXPECT_OK(read_future.result());
+  }
+
+  {
+    auto read_future = read_chunk(2);
+    TENSORSTORE_EXPECT_OK(read_future.result());
+  }
+  EXPECT_TRUE(mock_store->read_requests.empty());
+}
+
+// Tests that outstanding prefetches count against `prefetch_fraction`.
+TEST_F(ChunkCacheTest, SequentialPrefetchLimitsOutstandingBytes) {
+  grid = GetSimple1DGrid();
+  // Completes reads, and therefore releases the prefetch budget, as soon as
+  // the requests are answered.
+  thread_pool = InlineExecutor{};
+  CachePool::Limits limits;
+  limits.total_bytes_limit = 1024 * 1024;
+  limits.prefetch_chunk_rows = 4;
+  // Each chunk is 8 bytes, so at most 2 chunks may be prefetched at once.
+  limits.prefetch_fraction = 16.0 / limits.total_bytes_limit;
+  auto cache = MakeChunkCache({}, CachePool::Make(limits));
+  auto read_chunk = [&](Index cell) {
+    return tensorstore::Read(
+        GetTensorStore(cache, absl::InfinitePast()) |
+        tensorstore::Dims(0).TranslateSizedInterval(cell * 2, 2));
+  };
+
+  {
+    auto read_future = read_chunk(0);
+    mock_store->read_requests.pop()(memory_store);
+    TENSORSTORE_EXPECT_OK(read_future.result());
+  }
+
+  // Prefetches chunks 2 and 3, which are not completed yet.
+  std::vector<std::vector<Index>> prefetch_keys;
+  std::vector<MockKeyValueStore::ReadRequest> prefetch_requests;
+  {
+    auto read_future = read_chunk(1);
+    for (size_t i = 0; i < 3; ++i) {
+      auto r = mock_store->read_requests.pop();
+      if (ParseKey(r.key) == std::vector<Index>{1}) {
+        r(memory_store);
+        continue;
+      }
+      prefetch_keys.emplace_back(ParseKey(r.key));
+      prefetch_requests.push_back(std::move(r));
+    }
+    EXPECT_THAT(prefetch_keys, ::testing::UnorderedElementsAre(
+                                   ElementsAre(2), ElementsAre(3)));
+    TENSORSTORE_EXPECT_OK(read_future.result());
+  }
+
+  // The budget is exhausted by the outstanding prefetches.
+  auto read_future = read_chunk(2);
+  EXPECT_TRUE(mock_store->read_requests.empty());
+  for (auto& r : prefetch_requests) r(memory_store);
+  TENSORSTORE_EXPECT_OK(read_future.result());
+
+  // Once they complete, prefetching resumes.
+  {
+    auto read_future = read_chunk(3);
+    std::vector<std::vector<Index>> keys;
+    for (size_t i = 0; i < 2; ++i) {
+      auto r = mock_store->read_requests.pop();
+      keys.emplace_back(ParseKey(r.key));
+      r(memory_store);
+    }
+    EXPECT_THAT(keys, ::testing::UnorderedElementsAre(ElementsAre(4),
+                                                      ElementsAre(5)));
+    TENSORSTORE_EXPECT_OK(read_future.result());
+  }
+  EXPECT_TRUE(mock_store->read_requests.empty());
+}
+
 // Tests cancelling a read request.
 TEST_F(ChunkCacheTest, CancelRead) {
   // Dimension 0 is chunked with a size of 2.
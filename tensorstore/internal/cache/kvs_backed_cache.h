@@ -24,6 +24,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 
@@ -34,6 +35,9 @@
 #include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "tensorstore/internal/cache/async_cache.h"
+#include "tensorstore/internal/tracing/operation_trace_span.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/internal/tracing/trace_future.h"
 #include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/operations.h"
@@ -193,8 +197,17 @@ class KvsBackedCache : public Parent {
           std::move(read_state.stamp.generation);
       kvstore_options.batch = request.batch;
       auto& cache = GetOwningCache(*this);
-      auto future = cache.kvstore_driver_->Read(this->GetKeyValueStoreKey(),
-                                                std::move(kvstore_options));
+      std::string key = this->GetKeyValueStoreKey();
+      internal_tracing::OperationTraceSpan span(
+          "kvstore.Read", {{"key", std::string_view(key)}});
+      Future<kvstore::ReadResult> future;
+      {
+        internal_tracing::ScopedTraceContext trace_scope(span.context());
+        future = cache.kvstore_driver_->Read(std::move(key),
+                                             std::move(kvstore_options));
+      }
+      future = internal_tracing::EndSpanWhenReady(std::move(span),
+                                                  std::move(future));
       execution::submit(
           std::move(future),
           ReadReceiverImpl<Entry>{this, std::move(read_state.data)});
@@ -275,6 +288,11 @@ class KvsBackedCache : public Parent {
       target_ = &target;
     }
 
+    /// Returns the target to which this node is bound.  Derived classes may
+    /// use this to read byte ranges of the existing value directly, rather
+    /// than reading the full value via `DoRead`.
+    ReadModifyWriteTarget& kvs_target() { return *target_; }
+
     void KvsInvalidateReadState() override {
       if (this->target_->KvsReadsCommitted()) {
         this->SetReadsCommitted();
@@ -34,6 +34,7 @@
 #include "tensorstore/internal/cache/cache.h"
 #include "tensorstore/internal/cache/chunk_cache.h"
 #include "tensorstore/internal/cache/kvs_backed_cache.h"
+#include "tensorstore/internal/compression/codec_thread_budget.h"
 #include "tensorstore/internal/log/verbose_flag.h"
 #include "tensorstore/internal/memory.h"
 #include "tensorstore/internal/tracing/logged_trace_span.h"
@@ -120,6 +121,10 @@ void KvsBackedChunkCache::Entry::DoEncode(EncodeOptions options,
           component_spec.array_spec.GetFillValueForDomain(domain);
     }
   }
+  // Encoding may occur outside of a task run by the data copy executor, e.g.
+  // when writeback is initiated by the thread committing a transaction.
+  ScopedCodecThreadBudget codec_thread_budget(
+      GetCodecThreadBudget(cache.executor()));
   auto encoded_result = cache.EncodeChunk(cell_indices, component_arrays);
   if (!encoded_result.ok()) {
     execution::set_error(
@@ -0,0 +1,140 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/cache/sequential_access_detector.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/box.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_interval.h"
+
+namespace tensorstore {
+namespace internal {
+
+namespace {
+
+// Returns the dimension and direction (`1` or `-1`) along which `cells`
+// immediately follows `last_cells`, or `{-1, 0}` if it does not.
+std::pair<DimensionIndex, Index> GetSequentialDimension(BoxView<> last_cells,
+                                                        BoxView<> cells) {
+  const DimensionIndex rank = cells.rank();
+  if (last_cells.rank() != rank) return {-1, 0};
+  DimensionIndex dim = -1;
+  Index direction = 0;
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    const IndexInterval last = last_cells[i];
+    const IndexInterval cur = cells[i];
+    if (cur == last) continue;
+    if (dim != -1) return {-1, 0};
+    if (cur.inclusive_min() == last.exclusive_max()) {
+      direction = 1;
+    } else if (cur.exclusive_max() == last.inclusive_min()) {
+      direction = -1;
+    } else {
+      return {-1, 0};
+    }
+    dim = i;
+  }
+  return {dim, direction};
+}
+
+}  // namespace
+
+bool SequentialAccessDetector::Continues(BoxView<> cells) const {
+  return last_cells_ == cells ||
+         GetSequentialDimension(last_cells_, cells).first != -1;
+}
+
+std::optional<Box<>> SequentialAccessDetector::Observe(BoxView<> cells,
+                                                       Index max_rows,
+                                                       Index max_cells) {
+  const DimensionIndex rank = cells.rank();
+  if (last_cells_ == cells) return std::nullopt;
+
+  // Determine the dimension and direction, if any, along which `cells` follows
+  // `last_cells_`.
+  const auto [dim, direction] = GetSequentialDimension(last_cells_, cells);
+  last_cells_ = cells;
+  if (dim == -1) {
+    dim_ = -1;
+    direction_ = 0;
+    return std::nullopt;
+  }
+  const IndexInterval cur = cells[dim];
+  if (dim != dim_ || direction != direction_) {
+    dim_ = dim;
+    direction_ = direction;
+    prefetched_bound_ =
+        direction == 1 ? cur.exclusive_max() : cur.inclusive_min();
+  }
+
+  // Limit the number of rows by `max_cells`.
+  Index row_cells = 1;
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    if (i == dim) continue;
+    row_cells *= cells.shape()[i];
+    if (row_cells > max_cells) return std::nullopt;
+  }
+  const Index num_rows =
+      std::min(max_rows, row_cells == 0 ? Index(0) : max_cells / row_cells);
+
+  Index begin, end;
+  if (direction == 1) {
+    begin = std::max(prefetched_bound_, cur.exclusive_max());
+    end = cur.exclusive_max() + num_rows;
+    if (begin >= end) return std::nullopt;
+    prefetched_bound_ = end;
+  } else {
+    begin = cur.inclusive_min() - num_rows;
+    end = std::min(prefetched_bound_, cur.inclusive_min());
+    if (begin >= end) return std::nullopt;
+    prefetched_bound_ = begin;
+  }
+  Box<> prefetch(cells);
+  prefetch[dim] = IndexInterval::UncheckedHalfOpen(begin, end);
+  return prefetch;
+}
+
+std::optional<Box<>> SequentialAccessDetectorSet::Observe(BoxView<> cells,
+                                                          Index max_rows,
+                                                          Index max_cells) {
+  absl::MutexLock lock(mutex_);
+  // Assign the read to the stream that it continues, or else replace the
+  // least recently used stream.
+  Stream* stream = nullptr;
+  Stream* least_recently_used = &streams_[0];
+  for (auto& s : streams_) {
+    if (s.last_use != 0 && s.detector.Continues(cells)) {
+      stream = &s;
+      break;
+    }
+    if (s.last_use < least_recently_used->last_use) least_recently_used = &s;
+  }
+  if (!stream) {
+    stream = least_recently_used;
+    stream->detector = SequentialAccessDetector();
+  }
+  stream->last_use = ++num_observed_;
+  return stream->detector.Observe(cells, max_rows, max_cells);
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,109 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_CACHE_SEQUENTIAL_ACCESS_DETECTOR_H_
+#define TENSORSTORE_INTERNAL_CACHE_SEQUENTIAL_ACCESS_DETECTOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/box.h"
+#include "tensorstore/index.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Detects reads of a chunk grid that traverse it sequentially along a single
+/// grid dimension, and determines the grid cells to prefetch ahead of them.
+///
+/// Each read is described by the bounding box of the grid cells it touches.
+/// A read is sequential if its bounding box is adjacent to that of the
+/// previous read along exactly one dimension, in the same direction as any
+/// previous sequential read, and equal along all other dimensions.  Repeated
+/// reads of the same grid cells, e.g. reading a chunked array one slice at a
+/// time, do not interrupt a sequence.
+///
+/// Each "row" is the set of grid cells with a single index along the
+/// traversed dimension.  Rows that have already been returned for
+/// prefetching are not returned again.
+///
+/// A detector tracks a single stream of reads, and is not thread-safe; see
+/// `SequentialAccessDetectorSet`.
+class SequentialAccessDetector {
+ public:
+  /// Returns `true` if a read of `cells` repeats or is adjacent to the
+  /// previous read, such that it belongs to the same stream of reads.
+  bool Continues(BoxView<> cells) const;
+
+  /// Records a read, and returns the grid cells to prefetch, if any.
+  ///
+  /// \param cells Bounding box of the grid cells touched by the read.
+  /// \param max_rows Maximum number of rows to prefetch beyond `cells`.
+  /// \param max_cells Maximum number of grid cells to prefetch.
+  /// \returns The box of grid cells to prefetch, or `std::nullopt` if the
+  ///     read is not sequential or the rows have already been prefetched.
+  std::optional<Box<>> Observe(BoxView<> cells, Index max_rows,
+                               Index max_cells);
+
+ private:
+  Box<> last_cells_;
+
+  // Dimension and direction (`1` or `-1`) of the current sequence, or `-1`
+  // and `0` if there is no current sequence.
+  DimensionIndex dim_ = -1;
+  Index direction_ = 0;
+
+  // Bound along `dim_` of the rows already prefetched: exclusive upper bound
+  // if `direction_ == 1`, inclusive lower bound if `direction_ == -1`.
+  Index prefetched_bound_ = 0;
+};
+
+/// Thread-safe collection of `SequentialAccessDetector`s, one per concurrent
+/// stream of reads of the same chunk grid.
+///
+/// Each read is assigned to the stream that it continues, if any, so that
+/// e.g. several threads each traversing a different region of an array do
+/// not interrupt each other's sequences.  A read that continues no stream
+/// starts a new one, replacing the least recently used stream.
+class SequentialAccessDetectorSet {
+ public:
+  /// Maximum number of streams tracked.
+  static constexpr size_t kMaxStreams = 8;
+
+  /// Records a read by the stream that it continues, and returns the grid
+  /// cells to prefetch, if any.
+  ///
+  /// Equivalent to `SequentialAccessDetector::Observe`.
+  std::optional<Box<>> Observe(BoxView<> cells, Index max_rows,
+                               Index max_cells);
+
+ private:
+  struct Stream {
+    SequentialAccessDetector detector;
+    uint64_t last_use = 0;
+  };
+
+  absl::Mutex mutex_;
+  uint64_t num_observed_ ABSL_GUARDED_BY(mutex_) = 0;
+  Stream streams_[kMaxStreams] ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_CACHE_SEQUENTIAL_ACCESS_DETECTOR_H_
@@ -0,0 +1,104 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/cache/sequential_access_detector.h"
+
+#include <optional>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tensorstore/box.h"
+
+namespace {
+
+using ::tensorstore::Box;
+using ::tensorstore::Index;
+using ::tensorstore::internal::SequentialAccessDetector;
+using ::tensorstore::internal::SequentialAccessDetectorSet;
+
+TEST(SequentialAccessDetectorTest, Forward) {
+  SequentialAccessDetector detector;
+  EXPECT_EQ(std::nullopt, detector.Observe(Box({0, 0}, {1, 4}), 2, 100));
+  EXPECT_EQ(Box({2, 0}, {2, 4}),
+            detector.Observe(Box({1, 0}, {1, 4}), 2, 100));
+  // Repeated reads of the same cells do not prefetch again.
+  EXPECT_EQ(std::nullopt, detector.Observe(Box({1, 0}, {1, 4}), 2, 100));
+  // Only rows not already prefetched are returned.
+  EXPECT_EQ(Box({4, 0}, {1, 4}),
+            detector.Observe(Box({2, 0}, {1, 4}), 2, 100));
+  EXPECT_EQ(Box({5, 0}, {2, 4}),
+            detector.Observe(Box({3, 0}, {2, 4}), 2, 100));
+}
+
+TEST(SequentialAccessDetectorTest, Backward) {
+  SequentialAccessDetector detector;
+  EXPECT_EQ(std::nullopt, detector.Observe(Box({0, 5}, {4, 1}), 2, 100));
+  EXPECT_EQ(Box({0, 2}, {4, 2}),
+            detector.Observe(Box({0, 4}, {4, 1}), 2, 100));
+  EXPECT_EQ(Box({0, 1}, {4, 1}),
+            detector.Observe(Box({0, 3}, {4, 1}), 2, 100));
+}
+
+TEST(SequentialAccessDetectorTest, MaxCells) {
+  SequentialAccessDetector detector;
+  EXPECT_EQ(std::nullopt, detector.Observe(Box({0, 0}, {1, 4}), 3, 9));
+  EXPECT_EQ(Box({2, 0}, {2, 4}), detector.Observe(Box({1, 0}, {1, 4}), 3, 9));
+  EXPECT_EQ(std::nullopt, detector.Observe(Box({2, 0}, {1, 8}), 3, 100));
+  // A single row exceeds the limit.
+  EXPECT_EQ(std::nullopt, detector.Observe(Box({3, 0}, {1, 8}), 3, 7));
+}
+
+TEST(SequentialAccessDetectorTest, NotSequential) {
+  SequentialAccessDetector detector;
+  EXPECT_EQ(std::nullopt, detector.Observe(Box({0, 0}, {1, 4}), 2, 100));
+  // Not adjacent.
+  EXPECT_EQ(std::nullopt, detector.Observe(Box({5, 0}, {1, 4}), 2, 100));
+  // Different extent along the other dimension.
+  EXPECT_EQ(std::nullopt, detector.Observe(Box({6, 0}, {1, 3}), 2, 100));
+  // Adjacent along more than one dimension.
+  EXPECT_EQ(std::nullopt, detector.Observe(Box({7, 3}, {1, 3}), 2, 100));
+  EXPECT_EQ(Box({9, 3}, {2, 3}),
+            detector.Observe(Box({8, 3}, {1, 3}), 2, 100));
+  // Reversing the direction starts a new sequence.
+  EXPECT_EQ(Box({5, 3}, {2, 3}),
+            detector.Observe(Box({7, 3}, {1, 3}), 2, 100));
+}
+
+TEST(SequentialAccessDetectorSetTest, InterleavedStreams) {
+  SequentialAccessDetectorSet detector;
+  EXPECT_EQ(std::nullopt, detector.Observe(Box({0, 0}, {1, 4}), 2, 100));
+  EXPECT_EQ(std::nullopt, detector.Observe(Box({0, 8}, {1, 4}), 2, 100));
+  // Each read continues its own stream.
+  EXPECT_EQ(Box({2, 0}, {2, 4}),
+            detector.Observe(Box({1, 0}, {1, 4}), 2, 100));
+  EXPECT_EQ(Box({2, 8}, {2, 4}),
+            detector.Observe(Box({1, 8}, {1, 4}), 2, 100));
+  EXPECT_EQ(Box({4, 0}, {1, 4}),
+            detector.Observe(Box({2, 0}, {1, 4}), 2, 100));
+}
+
+TEST(SequentialAccessDetectorSetTest, ReplacesLeastRecentlyUsedStream) {
+  SequentialAccessDetectorSet detector;
+  constexpr Index kNumStreams = SequentialAccessDetectorSet::kMaxStreams;
+  for (Index i = 0; i < kNumStreams; ++i) {
+    EXPECT_EQ(std::nullopt, detector.Observe(Box({0, 2 * i}, {1, 1}), 2, 100));
+  }
+  EXPECT_EQ(Box({2, 0}, {2, 1}), detector.Observe(Box({1, 0}, {1, 1}), 2, 100));
+  // Replaces the stream at column 2, which is now the least recently used.
+  EXPECT_EQ(std::nullopt, detector.Observe(Box({0, 100}, {1, 1}), 2, 100));
+  EXPECT_EQ(Box({2, 4}, {2, 1}), detector.Observe(Box({1, 4}, {1, 1}), 2, 100));
+  EXPECT_EQ(std::nullopt, detector.Observe(Box({1, 2}, {1, 1}), 2, 100));
+}
+
+}  // namespace
@@ -30,6 +30,7 @@
 #include "riegeli/bytes/read_all.h"
 #include "riegeli/bytes/reader.h"
 #include "riegeli/bytes/writer.h"
+#include "tensorstore/internal/compression/codec_thread_budget.h"
 #include "tensorstore/util/result.h"
 
 namespace tensorstore {
@@ -62,10 +63,11 @@ Result<size_t> EncodeWithCallback(
   if (shuffle == -1) {
     shuffle = options.element_size == 1 ? BLOSC_BITSHUFFLE : BLOSC_SHUFFLE;
   }
+  internal::CodecThreads threads(input.size());
   const int n = blosc_compress_ctx(
       options.clevel, shuffle, options.element_size, input.size(), input.data(),
       output_buffer, output_buffer_size, options.compressor, options.blocksize,
-      /*numinternalthreads=*/1);
+      /*numinternalthreads=*/static_cast<int>(threads.count()));
   if (n < 0) {
     return absl::InternalError(absl::StrFormat("Internal blosc error: %d", n));
   }
@@ -89,8 +91,10 @@ Result<size_t> DecodeWithCallback(
   char* output_buffer = get_output_buffer(nbytes);
   if (!output_buffer) return 0;
   if (nbytes > 0) {
-    const int n = blosc_decompress_ctx(input.data(), output_buffer, nbytes,
-                                       /*numinternalthreads=*/1);
+    internal::CodecThreads threads(nbytes);
+    const int n = blosc_decompress_ctx(
+        input.data(), output_buffer, nbytes,
+        /*numinternalthreads=*/static_cast<int>(threads.count()));
     if (n <= 0) {
       return absl::InvalidArgumentError(absl::StrFormat("Blosc error: %d", n));
     }
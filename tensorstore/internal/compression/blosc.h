@@ -69,6 +69,9 @@ struct Options {
 
 /// Compresses `input`.
 ///
+/// Large inputs are compressed using multiple threads acquired from the current
+/// `internal::CodecThreadBudget`, if any.
+///
 /// \param input The input data to compress.
 /// \param options Specifies compression options.
 /// \error `absl::StatusCode::kInvalidArgument` if `input.size()` exceeds
@@ -86,6 +89,8 @@ Result<size_t> EncodeWithCallback(
 
 /// Decompresses `input`.
 ///
+/// Like `Encode`, may use multiple threads for large outputs.
+///
 /// \param input The input data to decompress.
 /// \error `absl::StatusCode::kInvalidArgument` if `input` is corrupt.
 Result<std::string> Decode(std::string_view input);
@@ -25,11 +25,14 @@
 #include <gtest/gtest.h>
 #include "absl/status/status.h"
 #include <blosc.h>
+#include "tensorstore/internal/compression/codec_thread_budget.h"
 #include "tensorstore/util/status_testutil.h"
 
 namespace {
 
 using ::tensorstore::StatusIs;
+using ::tensorstore::internal::CodecThreadBudget;
+using ::tensorstore::internal::ScopedCodecThreadBudget;
 
 namespace blosc = tensorstore::blosc;
 
@@ -88,6 +91,27 @@ TEST(BloscTest, EncodeDecode) {
   }
 }
 
+// Tests encoding and decoding large inputs using multiple threads from the
+// current codec thread budget.
+TEST(BloscTest, EncodeDecodeParallel) {
+  std::string array(16 << 20, '\0');
+  unsigned char v = 0;
+  for (auto& x : array) {
+    x = (v += 7) & 0x3f;
+  }
+  blosc::Options options{/*.compressor==*/"lz4", /*.clevel=*/5,
+                         /*.shuffle=*/-1, /*.blocksize=*/0,
+                         /*.element_size=*/4};
+  CodecThreadBudget budget(3);
+  ScopedCodecThreadBudget scope(&budget);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded,
+                                   blosc::Encode(array, options));
+  EXPECT_LT(encoded.size(), array.size());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto decoded, blosc::Decode(encoded));
+  EXPECT_EQ(array, decoded);
+  EXPECT_EQ(3, budget.available());
+}
+
 // Tests that the compressed data has the expected blosc complib.
 TEST(BloscTest, CheckComplib) {
   const std::string_view array =
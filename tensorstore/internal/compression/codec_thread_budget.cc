@@ -0,0 +1,135 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/compression/codec_thread_budget.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/util/executor.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+thread_local CodecThreadBudget* current_budget = nullptr;
+
+struct CodecThreadBudgetExecutor {
+  Executor executor;
+  std::shared_ptr<CodecThreadBudget> budget;
+
+  void operator()(ExecutorTask task) const {
+    budget->Schedule(executor, [budget = budget,
+                                task = std::move(task)]() mutable {
+      {
+        ScopedCodecThreadBudget scope(budget.get());
+        std::move(task)();
+      }
+      budget->Release(1);
+    });
+  }
+};
+
+}  // namespace
+
+// `available_` and `num_deferred_` use sequentially consistent operations:
+// `Schedule` increments `num_deferred_` before checking `available_`, while
+// `Release` increments `available_` before checking `num_deferred_`, so that
+// at least one of them observes the other and schedules the deferred task.
+
+size_t CodecThreadBudget::TryAcquire(size_t desired) {
+  size_t available = available_.load();
+  while (true) {
+    const size_t n = std::min(desired, available);
+    if (n == 0) return 0;
+    if (available_.compare_exchange_weak(available, available - n)) {
+      return n;
+    }
+  }
+}
+
+void CodecThreadBudget::Release(size_t count) {
+  if (count == 0) return;
+  available_.fetch_add(count);
+  if (num_deferred_.load() != 0) ScheduleDeferred();
+}
+
+void CodecThreadBudget::Schedule(const Executor& executor,
+                                 ExecutorTask task) {
+  if (num_deferred_.load() == 0 && TryAcquire(1) == 1) {
+    executor(std::move(task));
+    return;
+  }
+  {
+    absl::MutexLock lock(&mutex_);
+    deferred_.emplace_back(executor, std::move(task));
+    num_deferred_.fetch_add(1);
+  }
+  ScheduleDeferred();
+}
+
+void CodecThreadBudget::ScheduleDeferred() {
+  std::vector<std::pair<Executor, ExecutorTask>> ready;
+  {
+    absl::MutexLock lock(&mutex_);
+    while (!deferred_.empty() && TryAcquire(1) == 1) {
+      ready.push_back(std::move(deferred_.front()));
+      deferred_.pop_front();
+      num_deferred_.fetch_sub(1);
+    }
+  }
+  for (auto& [executor, task] : ready) {
+    executor(std::move(task));
+  }
+}
+
+CodecThreadBudget* GetCurrentCodecThreadBudget() { return current_budget; }
+
+ScopedCodecThreadBudget::ScopedCodecThreadBudget(CodecThreadBudget* budget)
+    : prev_(current_budget) {
+  if (budget) current_budget = budget;
+}
+
+ScopedCodecThreadBudget::~ScopedCodecThreadBudget() { current_budget = prev_; }
+
+CodecThreads::CodecThreads(CodecThreadBudget* budget, size_t input_size)
+    : budget_(budget), acquired_(0) {
+  if (!budget_ || input_size < kMinParallelCodecInputSize) return;
+  const size_t desired = input_size / kParallelCodecBytesPerThread - 1;
+  acquired_ = budget_->TryAcquire(desired);
+}
+
+CodecThreads::~CodecThreads() {
+  if (budget_) budget_->Release(acquired_);
+}
+
+Executor WithCodecThreadBudget(Executor executor,
+                               std::shared_ptr<CodecThreadBudget> budget) {
+  if (!budget) return executor;
+  return CodecThreadBudgetExecutor{std::move(executor), std::move(budget)};
+}
+
+CodecThreadBudget* GetCodecThreadBudget(const Executor& executor) {
+  const auto* wrapper = executor.target<CodecThreadBudgetExecutor>();
+  return wrapper ? wrapper->budget.get() : nullptr;
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,169 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_COMPRESSION_CODEC_THREAD_BUDGET_H_
+#define TENSORSTORE_INTERNAL_COMPRESSION_CODEC_THREAD_BUDGET_H_
+
+/// \file
+///
+/// Bounds the number of threads used by codecs that compress or decompress a
+/// single buffer in parallel (blosc, zstd).
+///
+/// The blosc and zstd libraries create their own worker threads for parallel
+/// operation.  To keep the total number of threads bounded by the
+/// `data_copy_concurrency` limit, each `data_copy_concurrency` resource owns a
+/// `CodecThreadBudget` of `limit` threads, which is shared by the tasks of the
+/// resource executor and the additional threads of codecs.  The budget is
+/// attached to the resource executor (see `WithCodecThreadBudget`), which
+/// charges each running task one thread and defers tasks while no thread is
+/// available.  The budget is made available to codecs through a thread-local
+/// "current" budget while tasks submitted to that executor run.
+///
+/// Codecs acquire threads using `CodecThreads`, which never blocks: if the
+/// budget is exhausted because other tasks or codecs are using all of its
+/// threads, the codec simply runs on the calling thread.
+
+#include <stddef.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/util/executor.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Inputs smaller than this are always (de)compressed on the calling thread.
+constexpr size_t kMinParallelCodecInputSize = size_t(4) << 20;
+
+/// Minimum number of input bytes assigned to each codec thread.
+constexpr size_t kParallelCodecBytesPerThread = size_t(2) << 20;
+
+/// Pool of threads shared by executor tasks and parallel codecs.
+class CodecThreadBudget {
+ public:
+  /// Constructs a budget of `max_threads` threads.
+  explicit CodecThreadBudget(size_t max_threads)
+      : max_threads_(max_threads), available_(max_threads) {}
+
+  CodecThreadBudget(const CodecThreadBudget&) = delete;
+  CodecThreadBudget& operator=(const CodecThreadBudget&) = delete;
+
+  /// Acquires up to `desired` threads without blocking.
+  ///
+  /// \returns The number of threads acquired, in the range `[0, desired]`.
+  size_t TryAcquire(size_t desired);
+
+  /// Returns `count` threads previously acquired by `TryAcquire` or
+  /// `Schedule`, and schedules any deferred tasks that can now run.
+  void Release(size_t count);
+
+  /// Submits `task` to `executor` once a thread has been acquired for it.
+  /// Tasks are deferred, in submission order, while no thread is available.
+  ///
+  /// `task` must call `Release(1)` when it finishes.
+  void Schedule(const Executor& executor, ExecutorTask task);
+
+  size_t max_threads() const { return max_threads_; }
+
+  /// Returns the number of threads not currently acquired.
+  size_t available() const {
+    return available_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Submits deferred tasks while threads are available.
+  void ScheduleDeferred();
+
+  size_t max_threads_;
+  std::atomic<size_t> available_;
+
+  // Number of elements of `deferred_`, which allows `Release` to skip
+  // acquiring `mutex_` when no tasks are deferred.
+  std::atomic<size_t> num_deferred_{0};
+  absl::Mutex mutex_;
+  std::deque<std::pair<Executor, ExecutorTask>> deferred_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+/// Returns the budget made current on this thread by `ScopedCodecThreadBudget`,
+/// or `nullptr`.
+CodecThreadBudget* GetCurrentCodecThreadBudget();
+
+/// Makes `budget` the current budget of this thread for the lifetime of this
+/// object.  If `budget` is `nullptr`, the current budget is left unchanged.
+class ScopedCodecThreadBudget {
+ public:
+  explicit ScopedCodecThreadBudget(CodecThreadBudget* budget);
+  ~ScopedCodecThreadBudget();
+
+  ScopedCodecThreadBudget(const ScopedCodecThreadBudget&) = delete;
+  ScopedCodecThreadBudget& operator=(const ScopedCodecThreadBudget&) = delete;
+
+ private:
+  CodecThreadBudget* prev_;
+};
+
+/// Threads acquired from the current budget for (de)compressing a single
+/// buffer.  The threads are returned to the budget on destruction.
+class CodecThreads {
+ public:
+  /// Acquires threads for (de)compressing `input_size` bytes from the current
+  /// budget of this thread.
+  ///
+  /// No threads are acquired if `input_size < kMinParallelCodecInputSize`, or
+  /// if there is no current budget.
+  explicit CodecThreads(size_t input_size)
+      : CodecThreads(GetCurrentCodecThreadBudget(), input_size) {}
+
+  /// Acquires threads from `budget`, which may be `nullptr`.
+  CodecThreads(CodecThreadBudget* budget, size_t input_size);
+
+  ~CodecThreads();
+
+  CodecThreads(const CodecThreads&) = delete;
+  CodecThreads& operator=(const CodecThreads&) = delete;
+
+  /// Returns the total number of threads to use, including the calling
+  /// thread.  Always at least 1.
+  size_t count() const { return acquired_ + 1; }
+
+ private:
+  CodecThreadBudget* budget_;
+  size_t acquired_;
+};
+
+/// Returns an executor that runs tasks using `executor` with `budget` as the
+/// current codec thread budget.  Each task holds one thread of `budget` while
+/// it runs, so that tasks and the additional threads acquired by codecs
+/// together use at most `budget->max_threads()` threads.
+Executor WithCodecThreadBudget(Executor executor,
+                               std::shared_ptr<CodecThreadBudget> budget);
+
+/// Returns the budget attached to `executor` by `WithCodecThreadBudget`, or
+/// `nullptr`.
+///
+/// This allows code that runs outside of executor tasks but has access to the
+/// `data_copy_concurrency` executor, such as chunk encoding during writeback,
+/// to use the same budget via `ScopedCodecThreadBudget`.
+CodecThreadBudget* GetCodecThreadBudget(const Executor& executor);
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_COMPRESSION_CODEC_THREAD_BUDGET_H_
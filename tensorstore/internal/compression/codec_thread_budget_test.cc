@@ -0,0 +1,125 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/compression/codec_thread_budget.h"
+
+#include <stddef.h>
+
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "tensorstore/util/executor.h"
+
+namespace {
+
+using ::tensorstore::InlineExecutor;
+using ::tensorstore::internal::CodecThreadBudget;
+using ::tensorstore::internal::CodecThreads;
+using ::tensorstore::internal::GetCodecThreadBudget;
+using ::tensorstore::internal::GetCurrentCodecThreadBudget;
+using ::tensorstore::internal::kMinParallelCodecInputSize;
+using ::tensorstore::internal::kParallelCodecBytesPerThread;
+using ::tensorstore::internal::ScopedCodecThreadBudget;
+using ::tensorstore::internal::WithCodecThreadBudget;
+
+TEST(CodecThreadBudgetTest, TryAcquire) {
+  CodecThreadBudget budget(3);
+  EXPECT_EQ(3, budget.max_threads());
+  EXPECT_EQ(2, budget.TryAcquire(2));
+  EXPECT_EQ(1, budget.TryAcquire(2));
+  EXPECT_EQ(0, budget.TryAcquire(1));
+  budget.Release(3);
+  EXPECT_EQ(3, budget.available());
+}
+
+TEST(CodecThreadBudgetTest, CodecThreads) {
+  CodecThreadBudget budget(3);
+  {
+    CodecThreads threads(&budget, kMinParallelCodecInputSize - 1);
+    EXPECT_EQ(1, threads.count());
+  }
+  {
+    // Limited by the input size.
+    CodecThreads threads(&budget, kMinParallelCodecInputSize +
+                                      kParallelCodecBytesPerThread);
+    EXPECT_EQ(3, threads.count());
+    // Limited by the remaining budget.
+    CodecThreads threads2(&budget, 100 * kParallelCodecBytesPerThread);
+    EXPECT_EQ(2, threads2.count());
+    EXPECT_EQ(0, budget.available());
+  }
+  EXPECT_EQ(3, budget.available());
+  CodecThreads threads(nullptr, 100 * kParallelCodecBytesPerThread);
+  EXPECT_EQ(1, threads.count());
+}
+
+TEST(CodecThreadBudgetTest, Scoped) {
+  CodecThreadBudget a(1), b(1);
+  EXPECT_EQ(nullptr, GetCurrentCodecThreadBudget());
+  {
+    ScopedCodecThreadBudget scope_a(&a);
+    EXPECT_EQ(&a, GetCurrentCodecThreadBudget());
+    {
+      ScopedCodecThreadBudget scope_b(&b);
+      EXPECT_EQ(&b, GetCurrentCodecThreadBudget());
+      CodecThreads threads(kMinParallelCodecInputSize);
+      EXPECT_EQ(2, threads.count());
+      EXPECT_EQ(0, b.available());
+      EXPECT_EQ(1, a.available());
+    }
+    EXPECT_EQ(&a, GetCurrentCodecThreadBudget());
+    {
+      ScopedCodecThreadBudget scope_null(nullptr);
+      EXPECT_EQ(&a, GetCurrentCodecThreadBudget());
+    }
+  }
+  EXPECT_EQ(nullptr, GetCurrentCodecThreadBudget());
+}
+
+TEST(CodecThreadBudgetTest, Executor) {
+  auto budget = std::make_shared<CodecThreadBudget>(2);
+  auto executor = WithCodecThreadBudget(InlineExecutor{}, budget);
+  EXPECT_EQ(budget.get(), GetCodecThreadBudget(executor));
+  EXPECT_EQ(nullptr, GetCodecThreadBudget(InlineExecutor{}));
+
+  CodecThreadBudget* current = nullptr;
+  executor([&] { current = GetCurrentCodecThreadBudget(); });
+  EXPECT_EQ(budget.get(), current);
+  EXPECT_EQ(nullptr, GetCurrentCodecThreadBudget());
+}
+
+TEST(CodecThreadBudgetTest, ExecutorTasksShareBudget) {
+  auto budget = std::make_shared<CodecThreadBudget>(2);
+  auto executor = WithCodecThreadBudget(InlineExecutor{}, budget);
+
+  // A running task holds one thread of the budget.
+  size_t available = 0;
+  executor([&] { available = budget->available(); });
+  EXPECT_EQ(1, available);
+  EXPECT_EQ(2, budget->available());
+
+  // Tasks are deferred while codecs hold all threads.
+  EXPECT_EQ(2, budget->TryAcquire(2));
+  int runs = 0;
+  executor([&] { ++runs; });
+  executor([&] { ++runs; });
+  EXPECT_EQ(0, runs);
+  budget->Release(1);
+  EXPECT_EQ(2, runs);
+  EXPECT_EQ(1, budget->available());
+  budget->Release(1);
+  EXPECT_EQ(2, budget->available());
+}
+
+}  // namespace
@@ -21,9 +21,9 @@
 #include <cassert>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
-#include "absl/container/flat_hash_map.h"
 #include "tensorstore/util/endian.h"
 
 namespace tensorstore {
@@ -39,12 +39,140 @@ void WriteBlockHeader(size_t encoded_value_base_offset,
                          encoded_value_base_offset);
 }
 
+namespace {
+
+/// Open-addressing hash table that assigns a dense id to each distinct label
+/// of a block, in order of first insertion.
+///
+/// This is much cheaper to reset between blocks than `absl::flat_hash_map`,
+/// since the storage is retained and blocks contain at most a few thousand
+/// distinct labels in practice.
 template <typename Label>
-void EncodeBlock(const Label* input, const ptrdiff_t input_shape[3],
-                 const ptrdiff_t input_byte_strides[3],
-                 const ptrdiff_t block_shape[3], size_t base_offset,
-                 size_t* encoded_bits_output, size_t* table_offset_output,
-                 EncodedValueCache<Label>* cache, std::string* output) {
+class LabelIdTable {
+ public:
+  /// Removes all labels, and sizes the table for `expected_size` labels.
+  void Clear(size_t expected_size) {
+    size_t capacity = 16;
+    while (capacity < 2 * expected_size) capacity *= 2;
+    if (capacity != ids_.size()) {
+      labels_.resize(capacity);
+      ids_.assign(capacity, kEmpty);
+      shift_ = 64;
+      for (size_t c = capacity; c > 1; c /= 2) --shift_;
+    } else {
+      std::fill(ids_.begin(), ids_.end(), kEmpty);
+    }
+    size_ = 0;
+  }
+
+  /// Returns the id of `label`, inserting it with the next unused id if it is
+  /// not already present.
+  uint32_t Insert(Label label) {
+    size_t slot = FindSlot(label);
+    if (ids_[slot] != kEmpty) return ids_[slot];
+    const uint32_t id = static_cast<uint32_t>(size_++);
+    labels_[slot] = label;
+    ids_[slot] = id;
+    if (2 * size_ > ids_.size()) Grow();
+    return id;
+  }
+
+  /// Returns the id of `label`, which must have been inserted.
+  uint32_t Find(Label label) const { return ids_[FindSlot(label)]; }
+
+  size_t size() const { return size_; }
+
+ private:
+  constexpr static uint32_t kEmpty = ~uint32_t(0);
+
+  size_t FindSlot(Label label) const {
+    const size_t mask = ids_.size() - 1;
+    size_t slot = (static_cast<uint64_t>(label) * 0x9e3779b97f4a7c15) >> shift_;
+    while (ids_[slot] != kEmpty && labels_[slot] != label) {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  void Grow() {
+    std::vector<Label> old_labels;
+    std::vector<uint32_t> old_ids;
+    old_labels.swap(labels_);
+    old_ids.swap(ids_);
+    labels_.resize(old_ids.size() * 2);
+    ids_.assign(old_ids.size() * 2, kEmpty);
+    --shift_;
+    for (size_t i = 0; i < old_ids.size(); ++i) {
+      if (old_ids[i] == kEmpty) continue;
+      const size_t slot = FindSlot(old_labels[i]);
+      labels_[slot] = old_labels[i];
+      ids_[slot] = old_ids[i];
+    }
+  }
+
+  std::vector<Label> labels_;
+  std::vector<uint32_t> ids_;
+  size_t size_ = 0;
+  int shift_ = 64;
+};
+
+/// Scratch storage used by `EncodeBlockImpl`, which may be reused across
+/// blocks to avoid repeated allocation.
+template <typename Label>
+struct EncodeBuffers {
+  LabelIdTable<Label> id_table;
+  // Distinct labels, in order of first occurrence and then sorted.
+  std::vector<Label> labels;
+  // Maps the id assigned by `id_table` to the index into the sorted table.
+  std::vector<uint32_t> id_to_index;
+  // Per-position ids, and then table indices, in block order.
+  std::vector<uint32_t> indices;
+};
+
+/// Packs `num_words * (32 / Bits)` indices, each of which must be less than
+/// `2**Bits`, into `num_words` little endian 32-bit words.
+///
+/// The fixed trip count of the inner loop allows the compiler to fully unroll
+/// and vectorize it.
+template <size_t Bits>
+void PackIndices(const uint32_t* indices, size_t num_words, char* output) {
+  constexpr size_t kIndicesPerWord = 32 / Bits;
+  for (size_t word_i = 0; word_i < num_words; ++word_i) {
+    uint32_t word = 0;
+    for (size_t j = 0; j < kIndicesPerWord; ++j) {
+      word |= indices[j] << (j * Bits);
+    }
+    little_endian::Store32(output + word_i * 4, word);
+    indices += kIndicesPerWord;
+  }
+}
+
+void PackIndices(size_t encoded_bits, const uint32_t* indices,
+                 size_t num_words, char* output) {
+  switch (encoded_bits) {
+    case 1:
+      return PackIndices<1>(indices, num_words, output);
+    case 2:
+      return PackIndices<2>(indices, num_words, output);
+    case 4:
+      return PackIndices<4>(indices, num_words, output);
+    case 8:
+      return PackIndices<8>(indices, num_words, output);
+    case 16:
+      return PackIndices<16>(indices, num_words, output);
+    case 32:
+      return PackIndices<32>(indices, num_words, output);
+  }
+  assert(false);
+}
+
+template <typename Label>
+void EncodeBlockImpl(const Label* input, const ptrdiff_t input_shape[3],
+                     const ptrdiff_t input_byte_strides[3],
+                     const ptrdiff_t block_shape[3], size_t base_offset,
+                     size_t* encoded_bits_output, size_t* table_offset_output,
+                     EncodedValueCache<Label>* cache, std::string* output,
+                     EncodeBuffers<Label>& buffers) {
   if (input_shape[0] == 0 && input_shape[1] == 0 && input_shape[2] == 0) {
     *encoded_bits_output = 0;
     *table_offset_output = 0;
@@ -53,62 +181,88 @@ void EncodeBlock(const Label* input, const ptrdiff_t input_shape[3],
 
   constexpr size_t num_32bit_words_per_label = sizeof(Label) / 4;
 
-  // TODO(jbms): allow the memory allocated for these to be shared across
-  // multiple calls to EncodeBlock.
-  absl::flat_hash_map<Label, uint32_t> seen_values;
-  std::vector<Label> seen_values_inv;
-
-  // Calls `func(z, y, x, label)` for each `label` value within the block, in C
-  // order.
-  const auto ForEachElement = [&](auto func) {
+  const size_t num_positions = block_shape[0] * block_shape[1] * block_shape[2];
+  auto& id_table = buffers.id_table;
+  auto& labels = buffers.labels;
+  auto& indices = buffers.indices;
+
+  // Size the table based on the number of distinct labels in the previous
+  // block, since neighboring blocks tend to be similar.
+  id_table.Clear(labels.size());
+  labels.clear();
+
+  // Positions not covered by `input` (if `input_shape` is smaller than
+  // `block_shape`) retain an index of 0, corresponding to the lowest label.
+  // The size is rounded up to a multiple of 32 such that `PackIndices` may
+  // read whole words for any value of `encoded_bits`.
+  indices.assign((num_positions + 31) / 32 * 32, 0);
+
+  // Invokes `func(row_indices, input_row)` for each row of the input along the
+  // last dimension, where `row_indices` points to the index for the first
+  // position of the row.
+  const auto for_each_row = [&](auto func) {
     auto* input_z = reinterpret_cast<const char*>(input);
     for (ptrdiff_t z = 0; z < input_shape[0]; ++z) {
       auto* input_y = input_z;
       for (ptrdiff_t y = 0; y < input_shape[1]; ++y) {
-        auto* input_x = input_y;
-        for (ptrdiff_t x = 0; x < input_shape[2]; ++x) {
-          func(z, y, x, *reinterpret_cast<const Label*>(input_x));
-          input_x += input_byte_strides[2];
-        }
+        func(indices.data() + block_shape[2] * (y + block_shape[1] * z),
+             input_y);
         input_y += input_byte_strides[1];
       }
       input_z += input_byte_strides[0];
     }
   };
 
-  // First determine the distinct values.
-
-  // Initialize previous_value such that it is guaranteed not to equal to the
-  // first value.
-  Label previous_value = input[0] + 1;
-  ForEachElement([&](size_t z, size_t y, size_t x, Label value) {
-    // If this value matches the previous value, we can skip the more
-    // expensive hash table lookup.
-    if (value != previous_value) {
-      previous_value = value;
-      if (seen_values.emplace(value, 0).second) {
-        seen_values_inv.push_back(value);
+  // First determine the distinct values, and record the id assigned to each
+  // position.
+  {
+    // Initialize previous_value such that it is guaranteed not to equal to
+    // the first value.
+    Label previous_value = input[0] + 1;
+    uint32_t previous_id = 0;
+    const ptrdiff_t x_stride = input_byte_strides[2];
+    for_each_row([&](uint32_t* row_indices, const char* input_row) {
+      for (ptrdiff_t x = 0; x < input_shape[2]; ++x) {
+        const Label value =
+            *reinterpret_cast<const Label*>(input_row + x * x_stride);
+        // If this value matches the previous value, we can skip the more
+        // expensive hash table lookup.
+        if (value != previous_value) {
+          previous_value = value;
+          previous_id = id_table.Insert(value);
+          if (previous_id == labels.size()) labels.push_back(value);
+        }
+        row_indices[x] = previous_id;
       }
-    }
-  });
+    });
+  }
 
-  std::sort(seen_values_inv.begin(), seen_values_inv.end());
-  for (size_t i = 0; i < seen_values_inv.size(); ++i) {
-    seen_values[seen_values_inv[i]] = static_cast<uint32_t>(i);
+  // Only the distinct values need to be sorted.  If they were already
+  // encountered in sorted order, the ids are equal to the table indices.
+  if (!std::is_sorted(labels.begin(), labels.end())) {
+    std::sort(labels.begin(), labels.end());
+    auto& id_to_index = buffers.id_to_index;
+    id_to_index.resize(labels.size());
+    for (size_t i = 0; i < labels.size(); ++i) {
+      id_to_index[id_table.Find(labels[i])] = static_cast<uint32_t>(i);
+    }
+    for_each_row([&](uint32_t* row_indices, const char* input_row) {
+      for (ptrdiff_t x = 0; x < input_shape[2]; ++x) {
+        row_indices[x] = id_to_index[row_indices[x]];
+      }
+    });
   }
 
   // Determine number of bits with which to encode each index.
   size_t encoded_bits = 0;
-  if (seen_values.size() != 1) {
+  if (labels.size() != 1) {
     encoded_bits = 1;
-    while ((size_t(1) << encoded_bits) < seen_values.size()) {
+    while ((size_t(1) << encoded_bits) < labels.size()) {
       encoded_bits *= 2;
     }
   }
   *encoded_bits_output = encoded_bits;
-  const size_t encoded_size_32bits =
-      (encoded_bits * block_shape[0] * block_shape[1] * block_shape[2] + 31) /
-      32;
+  const size_t encoded_size_32bits = (encoded_bits * num_positions + 31) / 32;
 
   const size_t encoded_value_base_offset = output->size();
   assert((encoded_value_base_offset - base_offset) % 4 == 0);
@@ -116,10 +270,10 @@ void EncodeBlock(const Label* input, const ptrdiff_t input_shape[3],
 
   bool write_table;
   {
-    auto it = cache->find(seen_values_inv);
+    auto it = cache->find(labels);
     if (it == cache->end()) {
       write_table = true;
-      elements_to_write += seen_values.size() * num_32bit_words_per_label;
+      elements_to_write += labels.size() * num_32bit_words_per_label;
       *table_offset_output =
           (encoded_value_base_offset - base_offset) / 4 + encoded_size_32bits;
     } else {
@@ -131,36 +285,44 @@ void EncodeBlock(const Label* input, const ptrdiff_t input_shape[3],
   output->resize(encoded_value_base_offset + elements_to_write * 4);
   char* output_ptr = output->data() + encoded_value_base_offset;
   // Write encoded representation.
-  ForEachElement([&](size_t z, size_t y, size_t x, Label value) {
-    uint32_t index = seen_values.at(value);
-    size_t output_offset = x + block_shape[2] * (y + block_shape[1] * z);
-    void* cur_ptr = output_ptr + output_offset * encoded_bits / 32 * 4;
-    little_endian::Store32(cur_ptr,
-                           little_endian::Load32(cur_ptr) |
-                               (index << (output_offset * encoded_bits % 32)));
-  });
+  if (encoded_bits != 0) {
+    PackIndices(encoded_bits, indices.data(), encoded_size_32bits, output_ptr);
+  }
 
   // Write table
   if (write_table) {
-    output_ptr =
-        output->data() + encoded_value_base_offset + encoded_size_32bits * 4;
-    for (auto value : seen_values_inv) {
+    output_ptr += encoded_size_32bits * 4;
+    for (auto value : labels) {
       for (size_t word_i = 0; word_i < num_32bit_words_per_label; ++word_i) {
         little_endian::Store32(output_ptr + word_i * 4,
                                static_cast<uint32_t>(value >> (32 * word_i)));
       }
       output_ptr += num_32bit_words_per_label * 4;
     }
-    cache->emplace(seen_values_inv,
-                   static_cast<uint32_t>(*table_offset_output));
+    cache->emplace(labels, static_cast<uint32_t>(*table_offset_output));
   }
 }
 
+}  // namespace
+
+template <typename Label>
+void EncodeBlock(const Label* input, const ptrdiff_t input_shape[3],
+                 const ptrdiff_t input_byte_strides[3],
+                 const ptrdiff_t block_shape[3], size_t base_offset,
+                 size_t* encoded_bits_output, size_t* table_offset_output,
+                 EncodedValueCache<Label>* cache, std::string* output) {
+  EncodeBuffers<Label> buffers;
+  EncodeBlockImpl(input, input_shape, input_byte_strides, block_shape,
+                  base_offset, encoded_bits_output, table_offset_output, cache,
+                  output, buffers);
+}
+
 template <class Label>
 void EncodeChannel(const Label* input, const ptrdiff_t input_shape[3],
                    const ptrdiff_t input_byte_strides[3],
                    const ptrdiff_t block_shape[3], std::string* output) {
   EncodedValueCache<Label> cache;
+  EncodeBuffers<Label> buffers;
   const size_t base_offset = output->size();
   ptrdiff_t grid_shape[3];
   size_t block_index_size = kBlockHeaderSize;
@@ -185,10 +347,11 @@ void EncodeChannel(const Label* input, const ptrdiff_t input_shape[3],
         const size_t encoded_value_base_offset =
             (output->size() - base_offset) / 4;
         size_t encoded_bits, table_offset;
-        EncodeBlock(reinterpret_cast<const Label*>(
-                        reinterpret_cast<const char*>(input) + input_offset),
-                    input_block_shape, input_byte_strides, block_shape,
-                    base_offset, &encoded_bits, &table_offset, &cache, output);
+        const auto* block_input = reinterpret_cast<const Label*>(
+            reinterpret_cast<const char*>(input) + input_offset);
+        EncodeBlockImpl(block_input, input_block_shape, input_byte_strides,
+                        block_shape, base_offset, &encoded_bits, &table_offset,
+                        &cache, output, buffers);
         WriteBlockHeader(
             encoded_value_base_offset, table_offset, encoded_bits,
             output->data() + base_offset + block_offset * kBlockHeaderSize * 4);
@@ -221,71 +384,218 @@ void ReadBlockHeader(const void* header, size_t* encoded_value_base_offset,
   *encoded_value_base_offset = (h >> 32) & 0xffffff;
 }
 
+namespace {
+
+/// Returns the label at the specified table index.
 template <typename Label>
-bool DecodeBlock(size_t encoded_bits, const char* encoded_input,
-                 const char* table_input, size_t table_size,
-                 const ptrdiff_t block_shape[3],
-                 const ptrdiff_t output_shape[3],
-                 const ptrdiff_t output_byte_strides[3], Label* output) {
-  // TODO(jbms): Consider specializing this function for the value of
-  // `encoded_bits` and whether `table_size` is `< 2**encoded_bits`.  If
-  // `table_size >= 2**encoded_bits`, there is no need to check below that
-  // `index <= table_size`.
-
-  // Invokes `callback(label, z, y, x)` for each block position in C order.  If
-  // `callback` returns `false`, stops iterating and returns `false`.  Otherwise
-  // returns `true` when done.
-  const auto for_each_position = [&](auto callback) {
-    auto* output_z = reinterpret_cast<char*>(output);
-    for (ptrdiff_t z = 0; z < output_shape[0]; ++z) {
-      auto* output_y = output_z;
-      for (ptrdiff_t y = 0; y < output_shape[1]; ++y) {
-        auto* output_x = output_y;
-        for (ptrdiff_t x = 0; x < output_shape[2]; ++x) {
-          auto& label = *reinterpret_cast<Label*>(output_x);
-          if (!callback(label, z, y, x)) return false;
-          output_x += output_byte_strides[2];
-        }
-        output_y += output_byte_strides[1];
+Label ReadLabel(const char* table_input, size_t index) {
+  if constexpr (sizeof(Label) == 4) {
+    return little_endian::Load32(table_input + index * sizeof(Label));
+  } else {
+    return little_endian::Load64(table_input + index * sizeof(Label));
+  }
+}
+
+/// Invokes `callback(output_row, row_offset)` for each row of the output along
+/// the last dimension, where `output_row` points to the first element of the
+/// row and `row_offset` is the position of that element within the block.  If
+/// `callback` returns `false`, stops iterating and returns `false`.  Otherwise
+/// returns `true` when done.
+template <typename Label, typename Callback>
+bool ForEachOutputRow(const ptrdiff_t block_shape[3],
+                      const ptrdiff_t output_shape[3],
+                      const ptrdiff_t output_byte_strides[3], Label* output,
+                      Callback callback) {
+  auto* output_z = reinterpret_cast<char*>(output);
+  for (ptrdiff_t z = 0; z < output_shape[0]; ++z) {
+    auto* output_y = output_z;
+    for (ptrdiff_t y = 0; y < output_shape[1]; ++y) {
+      if (!callback(output_y, block_shape[2] * (y + block_shape[1] * z))) {
+        return false;
       }
-      output_z += output_byte_strides[0];
+      output_y += output_byte_strides[1];
     }
+    output_z += output_byte_strides[0];
+  }
+  return true;
+}
+
+/// Decodes `row_size` consecutive encoded indices starting at index `offset`
+/// with a fixed `encoded_bits` value of `Bits`, and invokes `store(x, label)`
+/// with the corresponding labels.  Returns `false` if `CheckBounds` is `true`
+/// and an index is out of bounds.
+///
+/// Each 32-bit word of encoded indices is loaded once, and the indices it
+/// contains are extracted with shifts that are constant for complete words.
+template <size_t Bits, bool CheckBounds, typename Label, typename Store>
+bool DecodeRow(const char* encoded_input, size_t offset, ptrdiff_t row_size,
+               const char* table_input, size_t table_size, Store store) {
+  constexpr size_t kIndicesPerWord = 32 / Bits;
+  constexpr uint32_t kMask = static_cast<uint32_t>((uint64_t(1) << Bits) - 1);
+  const auto emit = [&](ptrdiff_t x, uint32_t index) {
+    if (CheckBounds && index >= table_size) return false;
+    store(x, ReadLabel<Label>(table_input, index));
     return true;
   };
-
-  // Returns the label at the specified table index.
-  const auto read_label = [&](size_t index) -> Label {
-    if constexpr (sizeof(Label) == 4) {
-      return little_endian::Load32(table_input + index * sizeof(Label));
-    } else {
-      return little_endian::Load64(table_input + index * sizeof(Label));
+  if constexpr (Bits == 32) {
+    for (ptrdiff_t x = 0; x < row_size; ++x) {
+      if (!emit(x, little_endian::Load32(encoded_input + (offset + x) * 4))) {
+        return false;
+      }
     }
-  };
+    return true;
+  } else {
+    // Returns the word containing the index at `i`, shifted so that index `i`
+    // is in the low bits.
+    const auto load_word = [&](size_t i) {
+      return little_endian::Load32(encoded_input + i / kIndicesPerWord * 4) >>
+             (i % kIndicesPerWord * Bits);
+    };
+    // Common case of a short row contained in a single word.
+    if (static_cast<size_t>(row_size) <=
+        kIndicesPerWord - offset % kIndicesPerWord) {
+      const uint32_t word = load_word(offset);
+      for (ptrdiff_t x = 0; x < row_size; ++x) {
+        if (!emit(x, (word >> (x * Bits)) & kMask)) return false;
+      }
+      return true;
+    }
+    // Otherwise, decode a partial word at the start of the row, followed by
+    // complete words and a partial word at the end.
+    const auto emit_partial = [&](ptrdiff_t x, ptrdiff_t n) {
+      if (n == 0) return true;
+      const uint32_t word = load_word(offset + x);
+      for (ptrdiff_t j = 0; j < n; ++j) {
+        if (!emit(x + j, (word >> (j * Bits)) & kMask)) return false;
+      }
+      return true;
+    };
+    ptrdiff_t x = (kIndicesPerWord - offset % kIndicesPerWord) %
+                  kIndicesPerWord;
+    if (!emit_partial(0, x)) return false;
+    for (; x + static_cast<ptrdiff_t>(kIndicesPerWord) <= row_size;
+         x += kIndicesPerWord) {
+      const uint32_t word = little_endian::Load32(
+          encoded_input + (offset + x) / kIndicesPerWord * 4);
+      for (size_t j = 0; j < kIndicesPerWord; ++j) {
+        if (!emit(x + j, (word >> (j * Bits)) & kMask)) return false;
+      }
+    }
+    return emit_partial(x, row_size - x);
+  }
+}
 
-  if (encoded_bits == 0) {
+/// Decodes a single block with a fixed `encoded_bits` value of `Bits`.
+///
+/// Specializing on `Bits` turns the index extraction into constant shifts and
+/// masks, and allows bounds checks to be skipped entirely when every possible
+/// encoded index is valid.
+template <size_t Bits, typename Label>
+bool DecodeBlockImpl(const char* encoded_input, const char* table_input,
+                     size_t table_size, const ptrdiff_t block_shape[3],
+                     const ptrdiff_t output_shape[3],
+                     const ptrdiff_t output_byte_strides[3], Label* output) {
+  const ptrdiff_t row_size = output_shape[2];
+  const ptrdiff_t stride = output_byte_strides[2];
+
+  if constexpr (Bits == 0) {
     // There are no encoded indices to read.
     if (table_size == 0) return false;
-    const Label label = read_label(0);
-    return for_each_position(
-        [&](Label& output_label, ptrdiff_t z, ptrdiff_t y, ptrdiff_t x) {
-          output_label = label;
+    const Label label = ReadLabel<Label>(table_input, 0);
+    return ForEachOutputRow(
+        block_shape, output_shape, output_byte_strides, output,
+        [&](char* output_row, size_t row_offset) {
+          for (ptrdiff_t x = 0; x < row_size; ++x) {
+            *reinterpret_cast<Label*>(output_row + x * stride) = label;
+          }
           return true;
         });
+  } else {
+    const auto lookup = [&](auto check_bounds) {
+      constexpr bool kCheckBounds = decltype(check_bounds)::value;
+      if (stride == sizeof(Label)) {
+        return ForEachOutputRow(
+            block_shape, output_shape, output_byte_strides, output,
+            [&](char* output_row, size_t row_offset) {
+              auto* row = reinterpret_cast<Label*>(output_row);
+              return DecodeRow<Bits, kCheckBounds, Label>(
+                  encoded_input, row_offset, row_size, table_input,
+                  table_size, [row](ptrdiff_t x, Label label) {
+                    row[x] = label;
+                  });
+            });
+      }
+      return ForEachOutputRow(
+          block_shape, output_shape, output_byte_strides, output,
+          [&](char* output_row, size_t row_offset) {
+            return DecodeRow<Bits, kCheckBounds, Label>(
+                encoded_input, row_offset, row_size, table_input, table_size,
+                [output_row, stride](ptrdiff_t x, Label label) {
+                  *reinterpret_cast<Label*>(output_row + x * stride) = label;
+                });
+          });
+    };
+
+    // Bounds checks are only needed if not all encoded indices are valid.
+    if (table_size < (uint64_t(1) << Bits)) {
+      return lookup(std::true_type{});
+    }
+    return lookup(std::false_type{});
   }
+}
 
-  const uint32_t encoded_value_mask = (1U << encoded_bits) - 1;
-  return for_each_position([&](Label& output_label, ptrdiff_t z, ptrdiff_t y,
-                               ptrdiff_t x) {
-    size_t encoded_offset = x + block_shape[2] * (y + block_shape[1] * z);
-    auto index = little_endian::Load32(
-                     encoded_input + encoded_offset * encoded_bits / 32 * 4) >>
-                     (encoded_offset * encoded_bits % 32) &
-                 encoded_value_mask;
-    if (index >= table_size) return false;
-    output_label = read_label(index);
-    return true;
-  });
-  return true;
+template <typename Label>
+bool DecodeBlockImpl(size_t encoded_bits, const char* encoded_input,
+                     const char* table_input, size_t table_size,
+                     const ptrdiff_t block_shape[3],
+                     const ptrdiff_t output_shape[3],
+                     const ptrdiff_t output_byte_strides[3], Label* output) {
+  switch (encoded_bits) {
+    case 0:
+      return DecodeBlockImpl<0>(encoded_input, table_input, table_size,
+                                block_shape, output_shape, output_byte_strides,
+                                output);
+    case 1:
+      return DecodeBlockImpl<1>(encoded_input, table_input, table_size,
+                                block_shape, output_shape, output_byte_strides,
+                                output);
+    case 2:
+      return DecodeBlockImpl<2>(encoded_input, table_input, table_size,
+                                block_shape, output_shape, output_byte_strides,
+                                output);
+    case 4:
+      return DecodeBlockImpl<4>(encoded_input, table_input, table_size,
+                                block_shape, output_shape, output_byte_strides,
+                                output);
+    case 8:
+      return DecodeBlockImpl<8>(encoded_input, table_input, table_size,
+                                block_shape, output_shape, output_byte_strides,
+                                output);
+    case 16:
+      return DecodeBlockImpl<16>(encoded_input, table_input, table_size,
+                                 block_shape, output_shape, output_byte_strides,
+                                 output);
+    case 32:
+      return DecodeBlockImpl<32>(encoded_input, table_input, table_size,
+                                 block_shape, output_shape, output_byte_strides,
+                                 output);
+    default:
+      // encoded bits is not a power of 2 <= 32.
+      return false;
+  }
+}
+
+}  // namespace
+
+template <typename Label>
+bool DecodeBlock(size_t encoded_bits, const char* encoded_input,
+                 const char* table_input, size_t table_size,
+                 const ptrdiff_t block_shape[3],
+                 const ptrdiff_t output_shape[3],
+                 const ptrdiff_t output_byte_strides[3], Label* output) {
+  return DecodeBlockImpl(encoded_bits, encoded_input, table_input, table_size,
+                         block_shape, output_shape, output_byte_strides,
+                         output);
 }
 
 template <typename Label>
@@ -345,9 +655,9 @@ bool DecodeChannel(std::string_view input, const ptrdiff_t block_shape[3],
         const char* table_input = input.data() + table_offset * 4;
         const size_t table_size =
             (input.size() - table_offset * 4) / sizeof(Label);
-        if (!DecodeBlock(encoded_bits, encoded_input, table_input, table_size,
-                         block_shape, output_block_shape, output_byte_strides,
-                         block_output)) {
+        if (!DecodeBlockImpl(encoded_bits, encoded_input, table_input,
+                             table_size, block_shape, output_block_shape,
+                             output_byte_strides, block_output)) {
           return false;
         }
       }
@@ -0,0 +1,138 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "absl/log/absl_check.h"
+#include "absl/random/random.h"
+#include "absl/strings/str_cat.h"
+#include "tensorstore/internal/compression/neuroglancer_compressed_segmentation.h"
+#include "tensorstore/internal/global_initializer.h"
+
+namespace {
+
+using ::tensorstore::neuroglancer_compressed_segmentation::DecodeChannel;
+using ::tensorstore::neuroglancer_compressed_segmentation::EncodeChannel;
+
+constexpr ptrdiff_t kVolumeSize = 64;
+
+// Returns a `kVolumeSize`^3 volume of labels drawn from `num_labels` random
+// label values.  Each label is repeated `run_length` times along the
+// innermost dimension, which approximates the spatial coherence of real
+// segmentations.
+template <typename Label>
+std::vector<Label> MakeLabels(size_t num_labels, size_t run_length) {
+  absl::BitGen gen;
+  std::vector<Label> labels(num_labels);
+  for (auto& label : labels) {
+    label = absl::Uniform<Label>(absl::IntervalClosedClosed, gen, 0,
+                                 ~Label(0));
+  }
+  std::vector<Label> volume(kVolumeSize * kVolumeSize * kVolumeSize);
+  for (size_t i = 0; i < volume.size(); i += run_length) {
+    const Label label = labels[absl::Uniform<size_t>(gen, 0, num_labels)];
+    for (size_t j = i; j < std::min(volume.size(), i + run_length); ++j) {
+      volume[j] = label;
+    }
+  }
+  return volume;
+}
+
+struct Params {
+  size_t num_labels;
+  size_t run_length;
+  ptrdiff_t block_size;
+};
+
+template <typename Label>
+void BenchmarkEncode(::benchmark::State& state, Params params) {
+  const auto volume = MakeLabels<Label>(params.num_labels, params.run_length);
+  const ptrdiff_t shape[3] = {kVolumeSize, kVolumeSize, kVolumeSize};
+  const ptrdiff_t byte_strides[3] = {kVolumeSize * kVolumeSize * sizeof(Label),
+                                     kVolumeSize * sizeof(Label),
+                                     sizeof(Label)};
+  const ptrdiff_t block_shape[3] = {params.block_size, params.block_size,
+                                    params.block_size};
+  std::string output;
+  for (auto s : state) {
+    output.clear();
+    EncodeChannel(volume.data(), shape, byte_strides, block_shape, &output);
+    ::benchmark::DoNotOptimize(output);
+  }
+  state.SetItemsProcessed(state.iterations() * volume.size());
+  state.SetBytesProcessed(state.iterations() * volume.size() * sizeof(Label));
+}
+
+template <typename Label>
+void BenchmarkDecode(::benchmark::State& state, Params params) {
+  const auto volume = MakeLabels<Label>(params.num_labels, params.run_length);
+  const ptrdiff_t shape[3] = {kVolumeSize, kVolumeSize, kVolumeSize};
+  const ptrdiff_t byte_strides[3] = {kVolumeSize * kVolumeSize * sizeof(Label),
+                                     kVolumeSize * sizeof(Label),
+                                     sizeof(Label)};
+  const ptrdiff_t block_shape[3] = {params.block_size, params.block_size,
+                                    params.block_size};
+  std::string encoded;
+  EncodeChannel(volume.data(), shape, byte_strides, block_shape, &encoded);
+  std::vector<Label> output(volume.size());
+  for (auto s : state) {
+    ABSL_CHECK(DecodeChannel(encoded, block_shape, shape, byte_strides,
+                             output.data()));
+    ::benchmark::DoNotOptimize(output);
+  }
+  ABSL_CHECK(output == volume);
+  state.SetItemsProcessed(state.iterations() * volume.size());
+  state.SetBytesProcessed(state.iterations() * volume.size() * sizeof(Label));
+}
+
+template <typename Label>
+void RegisterBenchmarks(const char* label_type) {
+  // With 8x8x8 blocks, the number of distinct labels per block determines the
+  // encoded bit width: 1 label -> 0 bits, 2 -> 1, 4 -> 2, 16 -> 4,
+  // 256 -> 8, and up to 512 -> 16.  Blocks of 64x64x64 with many distinct
+  // labels use 32 bits.
+  for (const Params params : {
+           Params{1, 1, 8},
+           Params{2, 1, 8},
+           Params{4, 1, 8},
+           Params{16, 1, 8},
+           Params{256, 1, 8},
+           Params{1 << 20, 1, 8},
+           Params{1 << 20, 1, 64},
+           Params{1 << 20, 16, 8},
+       }) {
+    const std::string suffix =
+        absl::StrCat(label_type, "_Labels", params.num_labels, "_Run",
+                     params.run_length, "_Block", params.block_size);
+    ::benchmark::RegisterBenchmark(
+        absl::StrCat("Encode_", suffix).c_str(),
+        [=](auto& state) { BenchmarkEncode<Label>(state, params); });
+    ::benchmark::RegisterBenchmark(
+        absl::StrCat("Decode_", suffix).c_str(),
+        [=](auto& state) { BenchmarkDecode<Label>(state, params); });
+  }
+}
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  RegisterBenchmarks<uint32_t>("uint32");
+  RegisterBenchmarks<uint64_t>("uint64");
+}
+
+}  // namespace
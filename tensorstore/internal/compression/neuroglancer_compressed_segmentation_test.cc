@@ -397,6 +397,70 @@ TEST(DecodeChannelTest, MissingEncodedValues) {
       /*input_shape=*/{2, 2, 2});
 }
 
+// Tests decoding of 32-bit encoded indices, which must not be masked off.
+TEST(DecodeBlockTest, Basic32) {
+  const std::string input = FromVec({1, 0, 5, 0, 7, 0});
+  const ptrdiff_t block_shape[3] = {1, 1, 2};
+  const ptrdiff_t output_byte_strides[3] = {16, 16, 8};
+  std::vector<uint64_t> output(2);
+  EXPECT_TRUE(DecodeBlock<uint64_t>(
+      /*encoded_bits=*/32, input.data(), input.data() + 8, /*table_size=*/2,
+      block_shape, block_shape, output_byte_strides, output.data()));
+  EXPECT_THAT(output, ::testing::ElementsAre(7, 5));
+}
+
+TEST(DecodeBlockTest, Basic32OutOfRange) {
+  const std::string input = FromVec({2, 0, 5, 0, 7, 0});
+  const ptrdiff_t block_shape[3] = {1, 1, 2};
+  const ptrdiff_t output_byte_strides[3] = {16, 16, 8};
+  std::vector<uint64_t> output(2);
+  EXPECT_FALSE(DecodeBlock<uint64_t>(
+      /*encoded_bits=*/32, input.data(), input.data() + 8, /*table_size=*/2,
+      block_shape, block_shape, output_byte_strides, output.data()));
+}
+
+// Tests a block with more than 2**16 distinct labels, which requires 32-bit
+// encoding.
+TEST(RoundTripTest, Encoded32Bits) {
+  const ptrdiff_t shape[3] = {1, 256, 257};
+  const ptrdiff_t byte_strides[3] = {256 * 257 * 4, 257 * 4, 4};
+  std::vector<uint32_t> input(256 * 257);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<uint32_t>((input.size() - i) * 7);
+  }
+  std::string output;
+  EncodeChannel(input.data(), shape, byte_strides, shape, &output);
+  ASSERT_GE(output.size(), 8);
+  EXPECT_EQ(32, AsVec(output.substr(0, 4))[0] >> 24);
+  std::vector<uint32_t> decoded_output(input.size());
+  EXPECT_TRUE(DecodeChannel(output, shape, shape, byte_strides,
+                            decoded_output.data()));
+  EXPECT_EQ(input, decoded_output);
+}
+
+// Tests decoding to an output array whose innermost dimension is not
+// contiguous, with rows that start and end partway through encoded words.
+TEST(RoundTripTest, StridedOutput) {
+  for (const size_t num_distinct_ids : {2, 3, 16, 200, 1000}) {
+    const ptrdiff_t shape[3] = {2, 5, 41};
+    const ptrdiff_t block_shape[3] = {2, 3, 13};
+    const ptrdiff_t byte_strides[3] = {5 * 41 * 4, 41 * 4, 4};
+    std::vector<uint32_t> input(2 * 5 * 41);
+    for (size_t i = 0; i < input.size(); ++i) {
+      input[i] = static_cast<uint32_t>((i * 7919) % num_distinct_ids);
+    }
+    std::string output;
+    EncodeChannel(input.data(), shape, byte_strides, block_shape, &output);
+    const ptrdiff_t strided_byte_strides[3] = {5 * 41 * 8, 41 * 8, 8};
+    std::vector<uint32_t> decoded_output(input.size() * 2);
+    ASSERT_TRUE(DecodeChannel(output, block_shape, shape, strided_byte_strides,
+                              decoded_output.data()));
+    for (size_t i = 0; i < input.size(); ++i) {
+      EXPECT_EQ(input[i], decoded_output[i * 2]) << i;
+    }
+  }
+}
+
 template <typename T>
 void RandomRoundTrip(size_t max_block_size, size_t max_input_size,
                      size_t max_channels, size_t max_distinct_ids,
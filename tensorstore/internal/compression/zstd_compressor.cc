@@ -17,29 +17,158 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <memory>
+#include <string_view>
 
 #include "absl/log/absl_check.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "riegeli/bytes/cord_writer.h"
 #include "riegeli/bytes/writer.h"
 #include "riegeli/zstd/zstd_reader.h"
 #include "riegeli/zstd/zstd_writer.h"
+#include "tensorstore/internal/compression/codec_thread_budget.h"
+#include <zstd.h>
 
 namespace tensorstore {
 namespace internal {
+namespace {
 
-std::unique_ptr<riegeli::Writer> ZstdCompressor::GetWriter(
-    riegeli::Writer& base_writer, size_t element_bytes,
-    int64_t pledged_size) const {
+// Upper bound on `ZSTD_c_jobSize`, which is `int` and limited by zstd to
+// 512 MiB for 32-bit builds.
+constexpr size_t kMaxZstdJobSize = size_t(512) << 20;
+
+struct ZstdCCtxDeleter {
+  void operator()(ZSTD_CCtx* cctx) const { ZSTD_freeCCtx(cctx); }
+};
+
+// Writes zstd-compressed data to an underlying writer, using multiple zstd
+// worker threads acquired from the current `CodecThreadBudget`.
+//
+// Because the worker threads are acquired only once the size of the input is
+// known, this buffers the entire decoded value.
+class ParallelZstdWriter : public riegeli::CordWriter<absl::Cord> {
+ public:
+  explicit ParallelZstdWriter(riegeli::Writer& base_writer, int level,
+                              bool store_checksum)
+      : CordWriter(riegeli::CordWriterBase::Options()),
+        base_writer_(base_writer),
+        level_(level),
+        store_checksum_(store_checksum) {}
+
+  void Done() override;
+
+ private:
+  // Calls `ZSTD_compressStream2` until `input` is consumed or, if
+  // `end_op == ZSTD_e_end`, until the frame is complete.
+  bool Compress(ZSTD_CCtx* cctx, ZSTD_inBuffer& input,
+                ZSTD_EndDirective end_op);
+
+  bool FailWithZstdError(std::string_view operation, size_t code) {
+    return Fail(absl::InternalError(
+        absl::StrCat(operation, " failed: ", ZSTD_getErrorName(code))));
+  }
+
+  riegeli::Writer& base_writer_;
+  int level_;
+  bool store_checksum_;
+};
+
+void ParallelZstdWriter::Done() {
+  CordWriter::Done();
+  if (!ok()) return;
+  const absl::Cord& data = dest();
+  std::unique_ptr<ZSTD_CCtx, ZstdCCtxDeleter> cctx(ZSTD_createCCtx());
+  if (!cctx) {
+    Fail(absl::ResourceExhaustedError("ZSTD_createCCtx() failed"));
+    return;
+  }
+  size_t result =
+      ZSTD_CCtx_setParameter(cctx.get(), ZSTD_c_compressionLevel, level_);
+  if (ZSTD_isError(result)) {
+    FailWithZstdError("ZSTD_CCtx_setParameter(ZSTD_c_compressionLevel)",
+                      result);
+    return;
+  }
+  ZSTD_CCtx_setParameter(cctx.get(), ZSTD_c_checksumFlag,
+                         store_checksum_ ? 1 : 0);
+  CodecThreads threads(data.size());
+  if (threads.count() > 1) {
+    // Setting `ZSTD_c_nbWorkers` fails if zstd was built without
+    // multithreading support, in which case the data is compressed on the
+    // calling thread.
+    const size_t num_workers = threads.count();
+    if (!ZSTD_isError(ZSTD_CCtx_setParameter(
+            cctx.get(), ZSTD_c_nbWorkers, static_cast<int>(num_workers)))) {
+      // By default, the job size is a multiple of the window size, which for
+      // chunk-sized inputs may result in fewer jobs than workers.
+      const size_t job_size = std::clamp(
+          (data.size() + num_workers - 1) / num_workers,
+          kParallelCodecBytesPerThread, kMaxZstdJobSize);
+      ZSTD_CCtx_setParameter(cctx.get(), ZSTD_c_jobSize,
+                             static_cast<int>(job_size));
+    }
+  }
+  ZSTD_CCtx_setPledgedSrcSize(cctx.get(), data.size());
+  for (std::string_view fragment : data.Chunks()) {
+    ZSTD_inBuffer input{fragment.data(), fragment.size(), 0};
+    if (!Compress(cctx.get(), input, ZSTD_e_continue)) return;
+  }
+  ZSTD_inBuffer input{nullptr, 0, 0};
+  Compress(cctx.get(), input, ZSTD_e_end);
+}
+
+bool ParallelZstdWriter::Compress(ZSTD_CCtx* cctx, ZSTD_inBuffer& input,
+                                  ZSTD_EndDirective end_op) {
+  while (true) {
+    if (!base_writer_.Push(1, ZSTD_CStreamOutSize())) {
+      return Fail(base_writer_.status());
+    }
+    ZSTD_outBuffer output{base_writer_.cursor(), base_writer_.available(), 0};
+    const size_t remaining =
+        ZSTD_compressStream2(cctx, &output, &input, end_op);
+    base_writer_.move_cursor(output.pos);
+    if (ZSTD_isError(remaining)) {
+      return FailWithZstdError("ZSTD_compressStream2()", remaining);
+    }
+    if (end_op == ZSTD_e_end ? remaining == 0 : input.pos == input.size) {
+      return true;
+    }
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<riegeli::Writer> GetZstdWriter(riegeli::Writer& base_writer,
+                                               int level, bool store_checksum,
+                                               int64_t pledged_size) {
+  ABSL_DCHECK_GE(pledged_size, -1);
+  if (pledged_size >= static_cast<int64_t>(kMinParallelCodecInputSize)) {
+    if (auto* budget = GetCurrentCodecThreadBudget();
+        budget && budget->max_threads() > 0) {
+      return std::make_unique<ParallelZstdWriter>(base_writer, level,
+                                                  store_checksum);
+    }
+  }
   using Writer = riegeli::ZstdWriter<riegeli::Writer*>;
   Writer::Options options;
   options.set_compression_level(level);
-  ABSL_DCHECK_GE(pledged_size, -1);
+  options.set_store_checksum(store_checksum);
   if (pledged_size >= 0) {
     options.set_pledged_size(static_cast<uint64_t>(pledged_size));
   }
   return std::make_unique<Writer>(&base_writer, options);
 }
 
+std::unique_ptr<riegeli::Writer> ZstdCompressor::GetWriter(
+    riegeli::Writer& base_writer, size_t element_bytes,
+    int64_t pledged_size) const {
+  return GetZstdWriter(base_writer, level, /*store_checksum=*/false,
+                       pledged_size);
+}
+
 std::unique_ptr<riegeli::Reader> ZstdCompressor::GetReader(
     riegeli::Reader& base_reader, size_t element_bytes) const {
   using Reader = riegeli::ZstdReader<riegeli::Reader*>;
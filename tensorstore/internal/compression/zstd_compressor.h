@@ -33,6 +33,21 @@ struct ZstdOptions {
   int level = 0;
 };
 
+/// Returns a writer that zstd-compresses data to `base_writer`.
+///
+/// If `pledged_size` is at least `kMinParallelCodecInputSize` and a
+/// `CodecThreadBudget` is current on this thread, the data is buffered and
+/// then compressed by multiple zstd worker threads acquired from the budget
+/// (`ZSTD_c_nbWorkers`).  The result is still a single zstd frame.  Otherwise,
+/// the data is compressed as it is written.
+///
+/// \param level Compression level, where `0` indicates the default level.
+/// \param store_checksum Whether to store a checksum in the frame.
+/// \param pledged_size Exact uncompressed size in bytes, or `-1` if unknown.
+std::unique_ptr<riegeli::Writer> GetZstdWriter(riegeli::Writer& base_writer,
+                                               int level, bool store_checksum,
+                                               int64_t pledged_size);
+
 class ZstdCompressor : public JsonSpecifiedCompressor, public ZstdOptions {
  public:
   std::unique_ptr<riegeli::Writer> GetWriter(
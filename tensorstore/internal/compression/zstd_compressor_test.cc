@@ -0,0 +1,100 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/compression/zstd_compressor.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include "absl/log/absl_check.h"
+#include "absl/strings/cord.h"
+#include "riegeli/bytes/cord_reader.h"
+#include "riegeli/bytes/cord_writer.h"
+#include "riegeli/bytes/read_all.h"
+#include "riegeli/bytes/write.h"
+#include "riegeli/zstd/zstd_reader.h"
+#include "tensorstore/internal/compression/codec_thread_budget.h"
+#include "tensorstore/util/status.h"
+#include <zstd.h>
+
+namespace {
+
+using ::tensorstore::internal::CodecThreadBudget;
+using ::tensorstore::internal::GetZstdWriter;
+using ::tensorstore::internal::ScopedCodecThreadBudget;
+
+std::string MakeInput(size_t size) {
+  std::string input(size, '\0');
+  unsigned char v = 0;
+  for (size_t i = 0; i < size; ++i) {
+    input[i] = (i % 1000 < 500) ? 'a' : static_cast<char>(v += 13);
+  }
+  return input;
+}
+
+absl::Cord Encode(const std::string& input, bool store_checksum) {
+  absl::Cord encoded;
+  riegeli::CordWriter<absl::Cord*> base_writer(&encoded);
+  auto writer = GetZstdWriter(base_writer, /*level=*/3, store_checksum,
+                              static_cast<int64_t>(input.size()));
+  TENSORSTORE_CHECK_OK(riegeli::Write(input, std::move(writer)));
+  ABSL_CHECK(base_writer.Close());
+  return encoded;
+}
+
+std::string Decode(const absl::Cord& encoded) {
+  std::string decoded;
+  TENSORSTORE_CHECK_OK(riegeli::ReadAll(
+      riegeli::ZstdReader<riegeli::CordReader<>>(
+          riegeli::CordReader<>(&encoded)),
+      decoded));
+  return decoded;
+}
+
+TEST(GetZstdWriterTest, ParallelRoundtrip) {
+  const std::string input = MakeInput(24 << 20);
+  CodecThreadBudget budget(3);
+  ScopedCodecThreadBudget scope(&budget);
+  for (bool store_checksum : {false, true}) {
+    SCOPED_TRACE(store_checksum);
+    const absl::Cord encoded = Encode(input, store_checksum);
+    EXPECT_EQ(3, budget.available());
+    EXPECT_EQ(input, Decode(encoded));
+
+    // The output is a single frame that records the decoded size.
+    const std::string flat(encoded);
+    EXPECT_EQ(flat.size(), ZSTD_findFrameCompressedSize(flat.data(),
+                                                        flat.size()));
+    EXPECT_EQ(input.size(),
+              ZSTD_getFrameContentSize(flat.data(), flat.size()));
+  }
+}
+
+TEST(GetZstdWriterTest, SmallInputWithBudget) {
+  const std::string input = MakeInput(1000);
+  CodecThreadBudget budget(3);
+  ScopedCodecThreadBudget scope(&budget);
+  EXPECT_EQ(input, Decode(Encode(input, /*store_checksum=*/false)));
+}
+
+TEST(GetZstdWriterTest, LargeInputWithoutBudget) {
+  const std::string input = MakeInput(8 << 20);
+  EXPECT_EQ(input, Decode(Encode(input, /*store_checksum=*/true)));
+}
+
+}  // namespace
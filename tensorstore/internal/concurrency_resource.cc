@@ -19,11 +19,14 @@
 
 #include <stddef.h>
 
+#include <string_view>
+
 #include "absl/base/call_once.h"
 #include "tensorstore/context.h"
 #include "tensorstore/context_resource_provider.h"
 #include "tensorstore/internal/concurrency_resource_provider.h"
 #include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/enum.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/json_binding/std_optional.h"
 #include "tensorstore/internal/thread/thread_pool.h"
@@ -36,25 +39,42 @@ namespace internal {
 AnyContextResourceJsonBinder<ConcurrencyResource::Spec>
 ConcurrencyResourceTraits::JsonBinder() {
   namespace jb = tensorstore::internal_json_binding;
+  using ThreadPool = ConcurrencyResource::ThreadPool;
   return [](auto is_loading, const auto& options, auto* obj, auto* j) {
-    return jb::Object(jb::Member(
-        "limit", jb::DefaultInitializedValue(jb::Optional(
-                     jb::Integer<size_t>(1), [] { return "shared"; }))))(
-        is_loading, options, obj, j);
+    return jb::Object(
+        jb::Member("limit",
+                   jb::Projection<&Spec::limit>(
+                       jb::DefaultInitializedValue(jb::Optional(
+                           jb::Integer<size_t>(1), [] { return "shared"; })))),
+        jb::Member(
+            "thread_pool",
+            jb::Projection<&Spec::thread_pool>(
+                jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                    [](auto* v) { *v = ThreadPool::kDefault; },
+                    jb::Enum<ThreadPool, std::string_view>({
+                        {ThreadPool::kDefault, "default"},
+                        {ThreadPool::kWorkStealing, "work_stealing"},
+                    })))))(is_loading, options, obj, j);
   };
 }
 
 Result<ConcurrencyResource::Resource> ConcurrencyResourceTraits::Create(
     const Spec& spec, ContextResourceCreationContext context) const {
+  const auto make_executor = [&](size_t limit) {
+    return spec.thread_pool == ConcurrencyResource::ThreadPool::kWorkStealing
+               ? WorkStealingThreadPool(limit)
+               : DetachedThreadPool(limit);
+  };
   Resource value;
   value.spec = spec;
-  if (spec) {
-    value.executor = DetachedThreadPool(*spec);
+  if (spec.limit) {
+    value.executor = make_executor(*spec.limit);
   } else {
-    absl::call_once(shared_executor_once_, [&] {
-      shared_executor_ = DetachedThreadPool(shared_limit_);
+    const size_t i = static_cast<size_t>(spec.thread_pool);
+    absl::call_once(shared_executor_once_[i], [&] {
+      shared_executor_[i] = make_executor(shared_limit_);
     });
-    value.executor = shared_executor_;
+    value.executor = shared_executor_[i];
   }
   return value;
 }
@@ -37,6 +37,9 @@ namespace internal {
 /// specifying an explicit limit in the resource specification rather than
 /// relying on the default.
 ///
+/// The thread pool implementation may be selected with the `"thread_pool"`
+/// member; a separate shared thread pool is used for each implementation.
+///
 /// To define a derived concurrency resource type:
 ///
 /// 1. Define a class that inherits from `ConcurrencyResource` with an `id`
@@ -50,9 +53,24 @@ namespace internal {
 ///
 /// 3. Register the `Traits` type using a `ContextResourceRegistration` object.
 struct ConcurrencyResource {
-  using Spec = std::optional<size_t>;
-  struct Resource {
+  /// Thread pool implementation used by the resource.
+  enum class ThreadPool {
+    /// `DetachedThreadPool`.
+    kDefault,
+    /// `WorkStealingThreadPool`.
+    kWorkStealing,
+  };
+
+  struct Spec {
     // If equal to `nullopt`, indicates that the shared executor is used.
+    std::optional<size_t> limit;
+    ThreadPool thread_pool = ThreadPool::kDefault;
+
+    constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+      return f(x.limit, x.thread_pool);
+    };
+  };
+  struct Resource {
     Spec spec;
     Executor executor;
   };
@@ -0,0 +1,84 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/concurrency_resource.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "absl/status/status.h"
+#include "absl/synchronization/notification.h"
+#include "tensorstore/context.h"
+#include "tensorstore/internal/data_copy_concurrency_resource.h"
+#include "tensorstore/internal/file_io_concurrency_resource.h"
+#include "tensorstore/internal/testing/json_gtest.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Context;
+using ::tensorstore::IsOkAndHolds;
+using ::tensorstore::MatchesJson;
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal::ConcurrencyResource;
+using ::tensorstore::internal::DataCopyConcurrencyResource;
+using ::tensorstore::internal::FileIoConcurrencyResource;
+
+TEST(ConcurrencyResourceTest, Default) {
+  auto resource_spec =
+      Context::Resource<DataCopyConcurrencyResource>::DefaultSpec();
+  auto resource = Context::Default().GetResource(resource_spec).value();
+  EXPECT_FALSE(resource->spec.limit);
+  EXPECT_EQ(ConcurrencyResource::ThreadPool::kDefault,
+            resource->spec.thread_pool);
+  absl::Notification notification;
+  resource->executor([&] { notification.Notify(); });
+  notification.WaitForNotification();
+}
+
+TEST(ConcurrencyResourceTest, Limit) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto resource_spec,
+      Context::Resource<FileIoConcurrencyResource>::FromJson({{"limit", 2}}));
+  auto resource = Context::Default().GetResource(resource_spec).value();
+  EXPECT_EQ(2u, resource->spec.limit);
+  EXPECT_THAT(resource_spec.ToJson(),
+              IsOkAndHolds(MatchesJson({{"limit", 2}})));
+}
+
+TEST(ConcurrencyResourceTest, WorkStealing) {
+  for (const ::nlohmann::json& json : {
+           ::nlohmann::json{{"thread_pool", "work_stealing"}},
+           ::nlohmann::json{{"limit", 2}, {"thread_pool", "work_stealing"}},
+       }) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto resource_spec,
+        Context::Resource<DataCopyConcurrencyResource>::FromJson(json));
+    auto resource = Context::Default().GetResource(resource_spec).value();
+    EXPECT_EQ(ConcurrencyResource::ThreadPool::kWorkStealing,
+              resource->spec.thread_pool);
+    EXPECT_THAT(resource_spec.ToJson(), IsOkAndHolds(MatchesJson(json)));
+    absl::Notification notification;
+    resource->executor([&] { notification.Notify(); });
+    notification.WaitForNotification();
+  }
+}
+
+TEST(ConcurrencyResourceTest, InvalidThreadPool) {
+  EXPECT_THAT(Context::Resource<DataCopyConcurrencyResource>::FromJson(
+                  {{"thread_pool", "fifo"}}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
@@ -182,7 +182,12 @@ struct CurlRequestState {
     handle_.SetOption(CURLOPT_HEADERFUNCTION,
                       &CurlRequestState::CurlHeaderCallback);
 
-    // Consider: CURLOPT_XFERINFOFUNCTION for increased logging.
+    // The progress callback is invoked periodically, even while waiting for
+    // the response, and aborts requests whose response is no longer needed.
+    handle_.SetOption(CURLOPT_XFERINFODATA, this);
+    handle_.SetOption(CURLOPT_XFERINFOFUNCTION,
+                      &CurlRequestState::CurlXferInfoCallback);
+    handle_.SetOption(CURLOPT_NOPROGRESS, 0L);
   }
 
   ~CurlRequestState() {
@@ -194,6 +199,8 @@ struct CurlRequestState {
     handle_.SetOption(CURLOPT_SEEKFUNCTION, nullptr);
     handle_.SetOption(CURLOPT_HEADERDATA, nullptr);
     handle_.SetOption(CURLOPT_HEADERFUNCTION, nullptr);
+    handle_.SetOption(CURLOPT_XFERINFODATA, nullptr);
+    handle_.SetOption(CURLOPT_XFERINFOFUNCTION, nullptr);
     handle_.SetOption(CURLOPT_ERRORBUFFER, nullptr);
     CurlHandle::Cleanup(*factory_, std::move(handle_));
   }
@@ -331,6 +338,10 @@ struct CurlRequestState {
     auto* self = static_cast<CurlRequestState*>(userdata);
     auto data =
         std::string_view(static_cast<char const*>(contents), size * nmemb);
+    if (self->response_handler_->IsCancelled()) {
+      // Returning a different size aborts the transfer.
+      return 0;
+    }
     if (self->MaybeSetStatusAndProcess()) {
       self->response_payload_size_ += data.size();
       self->response_handler_->OnResponseBody(data);
@@ -338,6 +349,14 @@ struct CurlRequestState {
     return data.size();
   }
 
+  static int CurlXferInfoCallback(void* userdata, curl_off_t dltotal,
+                                  curl_off_t dlnow, curl_off_t ultotal,
+                                  curl_off_t ulnow) {
+    auto* self = static_cast<CurlRequestState*>(userdata);
+    // Returning a non-zero value aborts the transfer.
+    return self->response_handler_ && self->response_handler_->IsCancelled();
+  }
+
   static size_t CurlReadCallback(void* contents, size_t size, size_t nmemb,
                                  void* userdata) {
     auto* self = static_cast<CurlRequestState*>(userdata);
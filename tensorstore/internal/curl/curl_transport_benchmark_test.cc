@@ -0,0 +1,187 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// Benchmarks receiving HTTP response bodies.
+///
+/// `BM_ReceiveBody` compares accumulating curl-sized chunks with
+/// `riegeli::CordWriter`, as previously done by `HttpTransport::IssueRequest`,
+/// to `CordReceiveBuffer`.  `BM_CurlGet` measures end-to-end reads from
+/// `test_httpserver` through `CurlTransport`.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+#include "absl/base/call_once.h"
+#include "absl/base/no_destructor.h"
+#include "absl/log/absl_check.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/time/time.h"
+#include "riegeli/bytes/cord_writer.h"
+#include "tensorstore/internal/curl/curl_transport.h"
+#include "tensorstore/internal/curl/default_factory.h"
+#include "tensorstore/internal/http/http_request.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/http/receive_buffer.h"
+#include "tensorstore/internal/http/test_httpserver.h"
+
+namespace {
+
+using ::tensorstore::internal_http::CordReceiveBuffer;
+using ::tensorstore::internal_http::CurlTransport;
+using ::tensorstore::internal_http::DefaultCurlHandleFactory;
+using ::tensorstore::internal_http::GetReceiveBlockPoolStats;
+using ::tensorstore::internal_http::HttpRequestBuilder;
+using ::tensorstore::internal_http::HttpTransport;
+using ::tensorstore::internal_http::IssueRequestOptions;
+using ::tensorstore::internal_http::TestHttpServer;
+
+// Size of the chunks passed to the curl write callback.
+constexpr size_t kCurlChunkSize = 16 * 1024;
+
+size_t NumChunks(const absl::Cord& cord) {
+  size_t n = 0;
+  for (auto chunk : cord.Chunks()) {
+    (void)chunk;
+    ++n;
+  }
+  return n;
+}
+
+template <typename Receive>
+void BenchmarkReceive(benchmark::State& state, Receive receive) {
+  const size_t size = state.range(0);
+  const bool size_known = state.range(1);
+  std::string data(size, 'x');
+  size_t chunks = 0;
+  for (auto s : state) {
+    absl::Cord cord = receive(std::string_view(data), size_known);
+    chunks += NumChunks(cord);
+    benchmark::DoNotOptimize(cord);
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+  state.counters["chunks"] = benchmark::Counter(
+      static_cast<double>(chunks), benchmark::Counter::kAvgIterations);
+}
+
+void BM_ReceiveBody_CordWriter(benchmark::State& state) {
+  BenchmarkReceive(state, [](std::string_view data, bool size_known) {
+    absl::Cord cord;
+    riegeli::CordWriter<absl::Cord*> writer(&cord);
+    if (size_known) writer.SetWriteSizeHint(data.size());
+    for (size_t i = 0; i < data.size(); i += kCurlChunkSize) {
+      writer.Write(data.substr(i, kCurlChunkSize));
+    }
+    writer.Close();
+    return cord;
+  });
+}
+
+void BM_ReceiveBody_CordReceiveBuffer(benchmark::State& state) {
+  const auto before = GetReceiveBlockPoolStats();
+  BenchmarkReceive(state, [](std::string_view data, bool size_known) {
+    CordReceiveBuffer buffer;
+    if (size_known) buffer.SetSizeHint(data.size());
+    for (size_t i = 0; i < data.size(); i += kCurlChunkSize) {
+      buffer.Append(data.substr(i, kCurlChunkSize));
+    }
+    return std::move(buffer).Finish();
+  });
+  const auto after = GetReceiveBlockPoolStats();
+  state.counters["block_allocations"] = benchmark::Counter(
+      static_cast<double>(after.allocated - before.allocated),
+      benchmark::Counter::kAvgIterations);
+}
+
+void ReceiveBodyArgs(benchmark::internal::Benchmark* b) {
+  b->ArgsProduct({{64 * 1024, 4 << 20, 64 << 20}, {0, 1}})
+      ->ArgNames({"size", "size_known"});
+}
+
+BENCHMARK(BM_ReceiveBody_CordWriter)->Apply(ReceiveBodyArgs);
+BENCHMARK(BM_ReceiveBody_CordReceiveBuffer)->Apply(ReceiveBodyArgs);
+
+TestHttpServer& GetHttpServer() {
+  static absl::NoDestructor<TestHttpServer> testserver;
+  static absl::once_flag init_once;
+  absl::call_once(init_once, [&]() { testserver->SpawnProcess(); });
+  return *testserver;
+}
+
+std::shared_ptr<HttpTransport> GetTransport() {
+  auto config = DefaultCurlHandleFactory::Config();
+  config.ca_bundle = GetHttpServer().GetCertPath();
+  config.verify_host = false;
+  return std::make_shared<CurlTransport>(
+      std::make_shared<DefaultCurlHandleFactory>(std::move(config)));
+}
+
+void BM_CurlGet(benchmark::State& state) {
+  const size_t size = state.range(0);
+  auto transport = GetTransport();
+  auto url = absl::StrFormat("https://%s/benchmark_%d",
+                             GetHttpServer().http_address(), size);
+  auto options = [] {
+    return IssueRequestOptions()
+        .SetConnectTimeout(absl::Seconds(10))
+        .SetRequestTimeout(absl::Seconds(60));
+  };
+
+  auto put = transport
+                 ->IssueRequest(HttpRequestBuilder("PUT", url).BuildRequest(),
+                                options().SetPayload(
+                                    absl::Cord(std::string(size, 'x'))))
+                 .result();
+  ABSL_CHECK(put.ok() && put->status_code == 200) << put.status();
+
+  const auto before = GetReceiveBlockPoolStats();
+  size_t chunks = 0;
+  for (auto s : state) {
+    auto response =
+        transport
+            ->IssueRequest(HttpRequestBuilder("GET", url).BuildRequest(),
+                           options())
+            .result();
+    ABSL_CHECK(response.ok() && response->payload.size() == size)
+        << response.status();
+    chunks += NumChunks(response->payload);
+  }
+  const auto after = GetReceiveBlockPoolStats();
+  state.SetBytesProcessed(state.iterations() * size);
+  state.counters["chunks"] = benchmark::Counter(
+      static_cast<double>(chunks), benchmark::Counter::kAvgIterations);
+  state.counters["block_allocations"] = benchmark::Counter(
+      static_cast<double>(after.allocated - before.allocated),
+      benchmark::Counter::kAvgIterations);
+  state.counters["block_reuses"] = benchmark::Counter(
+      static_cast<double>(after.reused - before.reused),
+      benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_CurlGet)
+    ->Arg(64 * 1024)
+    ->Arg(4 << 20)
+    ->Arg(64 << 20)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -14,28 +14,68 @@
 
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
 
+#include <stddef.h>
+
 #include <algorithm>
+#include <memory>
 #include <thread>  // NOLINT
+#include <utility>
 
+#include "absl/base/call_once.h"
+#include "tensorstore/context.h"
 #include "tensorstore/context_resource_provider.h"
+#include "tensorstore/internal/compression/codec_thread_budget.h"
 #include "tensorstore/internal/concurrency_resource_provider.h"
+#include "tensorstore/util/result.h"
 
 namespace tensorstore {
 namespace internal {
 
 namespace {
+
+// This resource is for CPU-bound tasks.  Therefore, there is no advantage in
+// oversubscribing the number of available CPU cores.
+//
+// Always use at least 1 thread in case `std::thread::hardware_concurrency()`
+// returns 0 (due to being unable to determine number of cpu cores).
+size_t GetSharedLimit() {
+  return std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+}
+
 struct DataCopyConcurrencyResourceTraits
     : public ConcurrencyResourceTraits,
       public ContextResourceTraits<DataCopyConcurrencyResource> {
   DataCopyConcurrencyResourceTraits()
-      : ConcurrencyResourceTraits(
-            // This resource is for CPU-bound tasks.  Therefore, there is no
-            // advantage in oversubscribing the number of available CPU cores.
-            //
-            // Always use at least 1 thread in case
-            // `std::thread::hardware_concurrency()` returns 0 (due to being
-            // unable to determine number of cpu cores).
-            std::max(size_t(1), size_t(std::thread::hardware_concurrency()))) {}
+      : ConcurrencyResourceTraits(GetSharedLimit()) {}
+
+  // Attaches a `CodecThreadBudget` of `limit` threads to the executor.  Each
+  // running task holds one thread of the budget, and codecs that support
+  // multiple threads (blosc, zstd) may use the remaining threads in addition
+  // to the calling thread, so that tasks and codec threads together use at
+  // most `limit` threads.  As with the shared thread pools, a single budget
+  // is shared by all resources without an explicit limit.
+  Result<Resource> Create(const Spec& spec,
+                          ContextResourceCreationContext context) const {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto value, ConcurrencyResourceTraits::Create(spec, context));
+    std::shared_ptr<CodecThreadBudget> budget;
+    if (spec.limit) {
+      budget = std::make_shared<CodecThreadBudget>(*spec.limit);
+    } else {
+      absl::call_once(shared_budget_once_, [&] {
+        shared_budget_ =
+            std::make_shared<CodecThreadBudget>(GetSharedLimit());
+      });
+      budget = shared_budget_;
+    }
+    value.executor =
+        WithCodecThreadBudget(std::move(value.executor), std::move(budget));
+    return value;
+  }
+
+ private:
+  mutable absl::once_flag shared_budget_once_;
+  mutable std::shared_ptr<CodecThreadBudget> shared_budget_;
 };
 
 const ContextResourceRegistration<DataCopyConcurrencyResourceTraits>
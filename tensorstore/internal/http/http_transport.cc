@@ -27,11 +27,12 @@
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
-#include "riegeli/bytes/cord_writer.h"
 #include "tensorstore/internal/http/http_header.h"
 #include "tensorstore/internal/http/http_request.h"
 #include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/internal/http/receive_buffer.h"
 #include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/internal/tracing/operation_trace_span.h"
 #include "tensorstore/util/future.h"
 
 namespace tensorstore {
@@ -43,7 +44,8 @@ ABSL_CONST_INIT internal_log::VerboseFlag verbose("http_transport");
 // Adapts the IssueRequestWithHandler api to IssueRequest.
 class LegacyHttpResponseHandler : public HttpResponseHandler {
  public:
-  LegacyHttpResponseHandler(Promise<HttpResponse> p);
+  LegacyHttpResponseHandler(Promise<HttpResponse> p, const HttpRequest& request,
+                            bool cancel_when_not_needed);
 
   ~LegacyHttpResponseHandler() override = default;
 
@@ -55,20 +57,32 @@ class LegacyHttpResponseHandler : public HttpResponseHandler {
   void OnHeaderBlockDone() override;
   void OnResponseBody(std::string_view data) override;
   void OnComplete() override;
+  bool IsCancelled() override;
 
  private:
   Promise<HttpResponse> promise_;
-  absl::Cord data_;
-  riegeli::CordWriter<absl::Cord*> writer_;
+  // Ended when the handler is deleted, upon completion or failure.
+  internal_tracing::OperationTraceSpan span_;
+  CordReceiveBuffer body_;
+  // Responses to HEAD requests have a `Content-Length` but no body.
+  const bool is_head_request_;
+  const bool cancel_when_not_needed_;
   int32_t status_code_ = 0;
   HeaderMap headers_;
 };
 
-LegacyHttpResponseHandler::LegacyHttpResponseHandler(Promise<HttpResponse> p)
-    : promise_(std::move(p)), writer_(&data_) {}
+LegacyHttpResponseHandler::LegacyHttpResponseHandler(
+    Promise<HttpResponse> p, const HttpRequest& request,
+    bool cancel_when_not_needed)
+    : promise_(std::move(p)),
+      span_("http.Request",
+            {{"method", request.method}, {"url", request.url}}),
+      is_head_request_(request.method == "HEAD"),
+      cancel_when_not_needed_(cancel_when_not_needed) {}
 
 void LegacyHttpResponseHandler::OnStatus(int32_t status_code) {
   status_code_ = status_code;
+  span_.AddAttribute({"status_code", status_code});
 }
 
 void LegacyHttpResponseHandler::OnResponseHeader(std::string_view field_name,
@@ -77,25 +91,36 @@ void LegacyHttpResponseHandler::OnResponseHeader(std::string_view field_name,
 }
 
 void LegacyHttpResponseHandler::OnHeaderBlockDone() {
+  // Informational (1xx), 204 No Content and 304 Not Modified responses never
+  // have a body, regardless of `Content-Length`.
+  if (is_head_request_ || (status_code_ >= 100 && status_code_ < 200) ||
+      status_code_ == 204 || status_code_ == 304) {
+    return;
+  }
   auto content_length = TryGetContentLength(headers_);
   if (content_length) {
-    writer_.SetWriteSizeHint(*content_length);
+    body_.SetSizeHint(*content_length);
   }
 }
 
 void LegacyHttpResponseHandler::OnResponseBody(std::string_view data) {
-  writer_.Write(data);
+  body_.Append(data);
 }
 
 void LegacyHttpResponseHandler::OnFailure(absl::Status status) {
   ABSL_LOG_IF(INFO, verbose.Level(1)) << status;
+  span_.AddAttribute({"status", status.ToString()});
   promise_.SetResult(std::move(status));
   delete this;
 }
 
+bool LegacyHttpResponseHandler::IsCancelled() {
+  return cancel_when_not_needed_ && !promise_.result_needed();
+}
+
 void LegacyHttpResponseHandler::OnComplete() {
-  writer_.Close();
-  HttpResponse response{status_code_, std::move(data_), std::move(headers_)};
+  HttpResponse response{status_code_, std::move(body_).Finish(),
+                        std::move(headers_)};
   ABSL_LOG_IF(INFO, verbose.Level(1)) << response;
   promise_.SetResult(std::move(response));
   delete this;
@@ -107,9 +132,9 @@ Future<HttpResponse> HttpTransport::IssueRequest(const HttpRequest& request,
                                                  IssueRequestOptions options) {
   auto pair = PromiseFuturePair<HttpResponse>::Make();
   ABSL_LOG_IF(INFO, verbose.Level(1)) << request;
-  IssueRequestWithHandler(
-      request, std::move(options),
-      new LegacyHttpResponseHandler(std::move(pair.promise)));
+  auto* handler = new LegacyHttpResponseHandler(
+      std::move(pair.promise), request, options.cancel_when_not_needed);
+  IssueRequestWithHandler(request, std::move(options), handler);
   return std::move(pair.future);
 }
 
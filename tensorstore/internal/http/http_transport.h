@@ -59,11 +59,19 @@ struct IssueRequestOptions {
     this->connect_timeout = connect_timeout;
     return std::move(*this);
   }
+  IssueRequestOptions&& SetCancelWhenNotNeeded(bool cancel_when_not_needed) && {
+    this->cancel_when_not_needed = cancel_when_not_needed;
+    return std::move(*this);
+  }
 
   absl::Cord payload;
   absl::Duration request_timeout = absl::ZeroDuration();
   absl::Duration connect_timeout = absl::ZeroDuration();
   HttpVersion http_version = HttpVersion::kDefault;
+  // When set, `IssueRequest` allows the transport to abort the request once
+  // the returned future is no longer needed.  Only appropriate for idempotent
+  // requests, such as hedged reads; other requests always run to completion.
+  bool cancel_when_not_needed = false;
 };
 
 /// Interface used by the HTTP transport to signal data to caller.
@@ -86,7 +94,9 @@ class HttpResponseHandler {
   virtual void OnResponseBody(std::string_view data) = 0;
   // Request has completed with the provided http status code.
   virtual void OnComplete() = 0;
-  // TODO: GetStopToken()
+  // Returns true if the response is no longer needed. Transports may then
+  // abort the request, in which case OnFailure is invoked.
+  virtual bool IsCancelled() { return false; }
 };
 
 /// HttpTransport is an interface class for making http requests.
@@ -0,0 +1,173 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/http/receive_buffer.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/no_destructor.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+
+namespace tensorstore {
+namespace internal_http {
+namespace {
+
+// Maximum number of unused blocks retained by the pool.
+constexpr size_t kMaxPooledBlocks = 64;
+
+// Blocks smaller than a page are not page-aligned, which would otherwise
+// inflate the allocation of small exact-size blocks.
+std::align_val_t BlockAlignment(size_t size) {
+  return std::align_val_t(size < kReceiveBlockAlignment
+                              ? alignof(std::max_align_t)
+                              : kReceiveBlockAlignment);
+}
+
+char* AllocateBlock(size_t size) {
+  return static_cast<char*>(::operator new(size, BlockAlignment(size)));
+}
+
+void FreeBlock(char* block, size_t size) {
+  ::operator delete(block, size, BlockAlignment(size));
+}
+
+class ReceiveBlockPool {
+ public:
+  char* Acquire() {
+    {
+      absl::MutexLock lock(&mutex_);
+      if (!free_blocks_.empty()) {
+        char* block = free_blocks_.back();
+        free_blocks_.pop_back();
+        reused_.fetch_add(1, std::memory_order_relaxed);
+        return block;
+      }
+    }
+    allocated_.fetch_add(1, std::memory_order_relaxed);
+    return AllocateBlock(kReceiveBlockSize);
+  }
+
+  void Release(char* block) {
+    {
+      absl::MutexLock lock(&mutex_);
+      if (free_blocks_.size() < kMaxPooledBlocks) {
+        free_blocks_.push_back(block);
+        return;
+      }
+    }
+    FreeBlock(block, kReceiveBlockSize);
+  }
+
+  std::atomic<int64_t> allocated_{0};
+  std::atomic<int64_t> reused_{0};
+
+ private:
+  absl::Mutex mutex_;
+  std::vector<char*> free_blocks_ ABSL_GUARDED_BY(mutex_);
+};
+
+ReceiveBlockPool& GetReceiveBlockPool() {
+  static absl::NoDestructor<ReceiveBlockPool> pool;
+  return *pool;
+}
+
+void ReleaseBlock(char* block, size_t size, bool pooled) {
+  if (pooled) {
+    GetReceiveBlockPool().Release(block);
+  } else {
+    FreeBlock(block, size);
+  }
+}
+
+}  // namespace
+
+ReceiveBlockPoolStats GetReceiveBlockPoolStats() {
+  auto& pool = GetReceiveBlockPool();
+  return {pool.allocated_.load(std::memory_order_relaxed),
+          pool.reused_.load(std::memory_order_relaxed)};
+}
+
+CordReceiveBuffer::~CordReceiveBuffer() {
+  if (block_) ReleaseBlock(block_, block_size_, block_pooled_);
+}
+
+void CordReceiveBuffer::SetSizeHint(size_t size) {
+  if (block_ || !cord_.empty()) return;
+  size_hint_ = size <= kMaxExactReceiveBlockSize ? size : 0;
+}
+
+void CordReceiveBuffer::Append(std::string_view data) {
+  if (size_hint_ != 0 && !data.empty()) {
+    // A block of exactly the expected size is filled completely, so it is
+    // adopted without retaining any unused memory.  It is only allocated once
+    // data arrives, since e.g. a HEAD response has a `Content-Length` but no
+    // body.
+    GetReceiveBlockPool().allocated_.fetch_add(1, std::memory_order_relaxed);
+    block_size_ = std::exchange(size_hint_, 0);
+    block_ = AllocateBlock(block_size_);
+    block_pooled_ = false;
+  }
+  while (!data.empty()) {
+    if (!block_) {
+      block_ = GetReceiveBlockPool().Acquire();
+      block_size_ = kReceiveBlockSize;
+      block_pooled_ = true;
+    }
+    const size_t n = std::min(data.size(), block_size_ - block_inuse_);
+    std::memcpy(block_ + block_inuse_, data.data(), n);
+    block_inuse_ += n;
+    data.remove_prefix(n);
+    if (block_inuse_ == block_size_) FlushBlock();
+  }
+}
+
+void CordReceiveBuffer::FlushBlock() {
+  if (!block_) return;
+  char* block = std::exchange(block_, nullptr);
+  const size_t size = block_size_;
+  const size_t inuse = std::exchange(block_inuse_, 0);
+  const bool pooled = block_pooled_;
+  if (inuse < size) {
+    // Adopting a partially filled block would retain all of it for as long as
+    // the Cord references the data, so the data is copied instead.
+    cord_.Append(std::string_view(block, inuse));
+    ReleaseBlock(block, size, pooled);
+    return;
+  }
+  cord_.Append(absl::MakeCordFromExternal(
+      std::string_view(block, inuse),
+      [block, size, pooled](std::string_view) {
+        ReleaseBlock(block, size, pooled);
+      }));
+}
+
+absl::Cord CordReceiveBuffer::Finish() && {
+  FlushBlock();
+  return std::move(cord_);
+}
+
+}  // namespace internal_http
+}  // namespace tensorstore
@@ -0,0 +1,100 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_HTTP_RECEIVE_BUFFER_H_
+#define TENSORSTORE_INTERNAL_HTTP_RECEIVE_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string_view>
+
+#include "absl/strings/cord.h"
+
+namespace tensorstore {
+namespace internal_http {
+
+/// Size of the pooled blocks used to receive response bodies.
+inline constexpr size_t kReceiveBlockSize = 256 * 1024;
+
+/// Alignment of the receive blocks.
+inline constexpr size_t kReceiveBlockAlignment = 4096;
+
+/// Largest size hint for which a single exact-size block is used.  Larger
+/// bodies are received into pooled blocks, so that a large or bogus
+/// `Content-Length` cannot cause an arbitrarily large allocation.
+inline constexpr size_t kMaxExactReceiveBlockSize = 4 * 1024 * 1024;
+
+/// Statistics of the process-wide receive block pool.
+struct ReceiveBlockPoolStats {
+  /// Number of blocks allocated from the heap.
+  int64_t allocated;
+  /// Number of blocks reused from the pool.
+  int64_t reused;
+};
+
+ReceiveBlockPoolStats GetReceiveBlockPoolStats();
+
+/// Accumulates a response body into an `absl::Cord` with a single copy.
+///
+/// Data is copied directly into page-aligned blocks which, once full, are
+/// adopted into the resulting Cord as external memory, rather than being copied
+/// again into Cord flat nodes.  The transport (e.g. curl) still delivers data
+/// from its own receive buffer, so the body is not received without copying.
+///
+/// Blocks of `kReceiveBlockSize` bytes are taken from a process-wide pool and
+/// returned to it once the Cord releases them, which avoids repeated large
+/// heap allocations for successive responses.  When the body size is known in
+/// advance and does not exceed `kMaxExactReceiveBlockSize`, a single block of
+/// exactly that size is used so that the resulting Cord is flat.  A block that
+/// is only partially filled is copied into the Cord and released immediately,
+/// so that the Cord never retains unused block memory.
+class CordReceiveBuffer {
+ public:
+  CordReceiveBuffer() = default;
+  ~CordReceiveBuffer();
+
+  CordReceiveBuffer(const CordReceiveBuffer&) = delete;
+  CordReceiveBuffer& operator=(const CordReceiveBuffer&) = delete;
+
+  /// Indicates the expected total size of the body; must be called before any
+  /// data is appended.  Larger or smaller bodies are still handled correctly.
+  ///
+  /// No memory is allocated until data is appended, and hints larger than
+  /// `kMaxExactReceiveBlockSize` are ignored.
+  void SetSizeHint(size_t size);
+
+  /// Appends `data` to the body.
+  void Append(std::string_view data);
+
+  /// Returns the accumulated body.
+  absl::Cord Finish() &&;
+
+ private:
+  void FlushBlock();
+
+  absl::Cord cord_;
+  char* block_ = nullptr;
+  size_t block_size_ = 0;
+  size_t block_inuse_ = 0;
+  bool block_pooled_ = false;
+  // Size of the exact-size block to allocate for the first data appended, or
+  // `0` to use pooled blocks.
+  size_t size_hint_ = 0;
+};
+
+}  // namespace internal_http
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_HTTP_RECEIVE_BUFFER_H_
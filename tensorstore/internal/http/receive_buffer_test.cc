@@ -0,0 +1,152 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/http/receive_buffer.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/cord.h"
+
+namespace {
+
+using ::tensorstore::internal_http::CordReceiveBuffer;
+using ::tensorstore::internal_http::GetReceiveBlockPoolStats;
+using ::tensorstore::internal_http::kReceiveBlockAlignment;
+using ::tensorstore::internal_http::kMaxExactReceiveBlockSize;
+using ::tensorstore::internal_http::kReceiveBlockSize;
+
+std::string MakeData(size_t size) {
+  std::string data(size, '\0');
+  for (size_t i = 0; i < size; ++i) data[i] = static_cast<char>(i * 7);
+  return data;
+}
+
+absl::Cord Receive(std::string_view data, std::optional<size_t> size_hint,
+                   size_t chunk_size = 1000) {
+  CordReceiveBuffer buffer;
+  if (size_hint) buffer.SetSizeHint(*size_hint);
+  for (size_t i = 0; i < data.size(); i += chunk_size) {
+    buffer.Append(data.substr(i, chunk_size));
+  }
+  return std::move(buffer).Finish();
+}
+
+size_t NumChunks(const absl::Cord& cord) {
+  size_t n = 0;
+  for (auto chunk : cord.Chunks()) {
+    (void)chunk;
+    ++n;
+  }
+  return n;
+}
+
+TEST(CordReceiveBufferTest, Empty) {
+  EXPECT_TRUE(Receive("", std::nullopt).empty());
+  EXPECT_TRUE(Receive("", 0).empty());
+}
+
+TEST(CordReceiveBufferTest, Small) {
+  auto data = MakeData(100);
+  EXPECT_EQ(data, Receive(data, std::nullopt));
+  EXPECT_EQ(data, Receive(data, 100));
+}
+
+TEST(CordReceiveBufferTest, UnknownSize) {
+  auto data = MakeData(3 * kReceiveBlockSize + 17);
+  auto cord = Receive(data, std::nullopt);
+  EXPECT_EQ(data, cord);
+  // The full blocks are adopted without copying; the remainder is copied.
+  size_t num_blocks = 0;
+  for (auto chunk : cord.Chunks()) {
+    if (chunk.size() != kReceiveBlockSize) continue;
+    ++num_blocks;
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(chunk.data()) %
+                     kReceiveBlockAlignment);
+  }
+  EXPECT_EQ(3, num_blocks);
+}
+
+TEST(CordReceiveBufferTest, KnownSizeIsFlat) {
+  auto data = MakeData(3 * kReceiveBlockSize + 17);
+  auto cord = Receive(data, data.size(), 4096);
+  EXPECT_EQ(data, cord);
+  EXPECT_EQ(1, NumChunks(cord));
+  EXPECT_TRUE(cord.TryFlat());
+}
+
+TEST(CordReceiveBufferTest, SmallKnownSizeUsesExactBlock) {
+  auto data = MakeData(1000);
+  auto before = GetReceiveBlockPoolStats();
+  auto cord = Receive(data, data.size(), 100);
+  auto after = GetReceiveBlockPoolStats();
+  EXPECT_EQ(data, cord);
+  EXPECT_EQ(1, NumChunks(cord));
+  // A single exact-size block is allocated instead of a pooled block.
+  EXPECT_EQ(before.allocated + 1, after.allocated);
+  EXPECT_EQ(before.reused, after.reused);
+}
+
+TEST(CordReceiveBufferTest, SizeHintTooSmall) {
+  auto data = MakeData(3 * kReceiveBlockSize);
+  EXPECT_EQ(data, Receive(data, 2 * kReceiveBlockSize));
+}
+
+TEST(CordReceiveBufferTest, SizeHintTooLarge) {
+  auto data = MakeData(2 * kReceiveBlockSize);
+  EXPECT_EQ(data, Receive(data, 3 * kReceiveBlockSize));
+}
+
+TEST(CordReceiveBufferTest, SizeHintWithoutBody) {
+  auto before = GetReceiveBlockPoolStats();
+  EXPECT_TRUE(Receive("", 1024 * 1024).empty());
+  auto after = GetReceiveBlockPoolStats();
+  // No block is allocated for a body that never arrives.
+  EXPECT_EQ(before.allocated, after.allocated);
+  EXPECT_EQ(before.reused, after.reused);
+}
+
+TEST(CordReceiveBufferTest, LargeSizeHintUsesPooledBlocks) {
+  auto data = MakeData(2 * kReceiveBlockSize);
+  auto cord = Receive(data, 2 * kMaxExactReceiveBlockSize);
+  EXPECT_EQ(data, cord);
+  // The hint exceeds the limit, so pooled blocks are used instead.
+  EXPECT_EQ(2, NumChunks(cord));
+}
+
+TEST(CordReceiveBufferTest, BlocksAreReused) {
+  auto data = MakeData(2 * kReceiveBlockSize);
+  // Ensure that the pool contains free blocks.
+  Receive(data, std::nullopt);
+  auto before = GetReceiveBlockPoolStats();
+  Receive(data, std::nullopt);
+  auto after = GetReceiveBlockPoolStats();
+  EXPECT_EQ(before.allocated, after.allocated);
+  EXPECT_EQ(before.reused + 2, after.reused);
+}
+
+TEST(CordReceiveBufferTest, Abandoned) {
+  CordReceiveBuffer buffer;
+  buffer.SetSizeHint(4 * kReceiveBlockSize);
+  buffer.Append(MakeData(100));
+}
+
+}  // namespace
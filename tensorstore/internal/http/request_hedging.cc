@@ -0,0 +1,271 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/http/request_hedging.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/http/http_request.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/thread/schedule_at.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/stop_token.h"
+
+namespace tensorstore {
+namespace internal_http {
+namespace {
+
+constexpr double kMinBucketMicroseconds = 100;
+constexpr double kBucketGrowthFactor = 1.25;
+
+}  // namespace
+
+size_t LatencyHistogram::GetBucket(absl::Duration latency) {
+  const double us = absl::ToDoubleMicroseconds(latency);
+  if (!(us > kMinBucketMicroseconds)) return 0;
+  const double i = std::ceil(std::log(us / kMinBucketMicroseconds) /
+                             std::log(kBucketGrowthFactor));
+  return static_cast<size_t>(
+      std::min<double>(i, static_cast<double>(kNumBuckets - 1)));
+}
+
+absl::Duration LatencyHistogram::GetBucketUpperBound(size_t i) {
+  if (i + 1 >= kNumBuckets) return absl::InfiniteDuration();
+  return absl::Microseconds(kMinBucketMicroseconds *
+                            std::pow(kBucketGrowthFactor, i));
+}
+
+void LatencyHistogram::Observe(absl::Duration latency) {
+  buckets_[GetBucket(latency)].fetch_add(1, std::memory_order_relaxed);
+  if (count_.fetch_add(1, std::memory_order_relaxed) + 1 >= kDecayCount) {
+    Decay();
+  }
+}
+
+void LatencyHistogram::Decay() {
+  absl::MutexLock lock(&decay_mutex_);
+  if (count_.load(std::memory_order_relaxed) < kDecayCount) return;
+  // Concurrent observations may be lost; the histogram is approximate.
+  int64_t count = 0;
+  for (auto& bucket : buckets_) {
+    const int64_t n = bucket.load(std::memory_order_relaxed) / 2;
+    bucket.store(n, std::memory_order_relaxed);
+    count += n;
+  }
+  count_.store(count, std::memory_order_relaxed);
+}
+
+std::optional<absl::Duration> LatencyHistogram::Quantile(double q) const {
+  int64_t counts[kNumBuckets];
+  int64_t total = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0) return std::nullopt;
+  const int64_t target = std::max<int64_t>(
+      1, static_cast<int64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * total)));
+  int64_t cumulative = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    cumulative += counts[i];
+    if (cumulative >= target) return GetBucketUpperBound(i);
+  }
+  return GetBucketUpperBound(kNumBuckets - 1);
+}
+
+std::optional<absl::Duration> RequestHedger::GetHedgeDelay() const {
+  if (histogram_.count() < options_.min_samples) return std::nullopt;
+  auto delay = histogram_.Quantile(options_.quantile);
+  if (!delay || *delay == absl::InfiniteDuration()) return std::nullopt;
+  return std::max(*delay, options_.min_delay);
+}
+
+bool RequestHedger::TryStartHedge() {
+  const int64_t num_requests = num_requests_.load(std::memory_order_relaxed);
+  int64_t num_hedges = num_hedges_.load(std::memory_order_relaxed);
+  do {
+    if (num_hedges + 1 > options_.max_hedged_fraction * num_requests) {
+      return false;
+    }
+  } while (!num_hedges_.compare_exchange_weak(num_hedges, num_hedges + 1,
+                                              std::memory_order_relaxed));
+  return true;
+}
+
+namespace {
+
+// Shared state of a request that may be hedged.
+//
+// Holds one reference for the timer that issues the backup request, and one
+// for each outstanding request.
+class HedgedRequestState
+    : public internal::AtomicReferenceCount<HedgedRequestState> {
+ public:
+  HedgedRequestState(std::shared_ptr<RequestHedger> hedger,
+                     std::shared_ptr<HttpTransport> transport,
+                     const HttpRequest& request, IssueRequestOptions options,
+                     RequestHedgingMetrics* metrics,
+                     Promise<HttpResponse> promise)
+      : hedger_(std::move(hedger)),
+        transport_(std::move(transport)),
+        request_(request),
+        options_(std::move(options)),
+        metrics_(metrics),
+        promise_(std::move(promise)) {}
+
+  // Issues attempt `i`: 0 for the original request and 1 for the backup.
+  void IssueAttempt(size_t i) {
+    {
+      absl::MutexLock lock(&mutex_);
+      if (done_) return;
+    }
+    start_time_[i] = absl::Now();
+    auto future = transport_->IssueRequest(request_, options_);
+    auto registration = future.ExecuteWhenReady(
+        [self = internal::IntrusivePtr<HedgedRequestState>(this),
+         i](ReadyFuture<HttpResponse> future) {
+          self->OnAttemptReady(i, future.result());
+        });
+    bool done;
+    {
+      absl::MutexLock lock(&mutex_);
+      done = done_;
+      if (!done) registration_[i] = std::move(registration);
+    }
+    if (done) registration.Unregister();
+  }
+
+  void MaybeIssueBackup() {
+    {
+      absl::MutexLock lock(&mutex_);
+      if (done_ || !promise_.result_needed()) return;
+      if (!hedger_->TryStartHedge()) return;
+      ++pending_;
+    }
+    if (metrics_) metrics_->hedged.Increment();
+    IssueAttempt(1);
+  }
+
+  void OnAttemptReady(size_t i, const Result<HttpResponse>& result) {
+    const absl::Time now = absl::Now();
+    if (result.ok()) {
+      hedger_->ObserveLatency(now - start_time_[i]);
+    }
+    FutureCallbackRegistration other;
+    bool cancel_original;
+    {
+      absl::MutexLock lock(&mutex_);
+      --pending_;
+      if (done_) return;
+      // Wait for the other request if this one failed.
+      if (!result.ok() && pending_ > 0) return;
+      done_ = true;
+      cancel_original = (i == 1 && pending_ > 0);
+      other = std::move(registration_[1 - i]);
+    }
+    // The latency of a cancelled original request is unknown, but is at least
+    // the time elapsed so far.  Recording that lower bound keeps the slowest
+    // requests, which are exactly those that are hedged, from being omitted
+    // from the histogram, which would otherwise bias the hedge delay low.  A
+    // cancelled backup request is not recorded, since its elapsed time is
+    // shorter than that of the original request.
+    if (cancel_original) {
+      hedger_->ObserveLatency(now - start_time_[0]);
+    }
+    // Cancels the pending backup timer and the other request, if any.
+    stop_source_.request_stop();
+    other.Unregister();
+    if (i == 1 && result.ok() && metrics_) metrics_->hedge_won.Increment();
+    promise_.SetResult(result);
+  }
+
+  // Cancels all requests once the result is no longer needed.
+  void Cancel() {
+    FutureCallbackRegistration registrations[2];
+    {
+      absl::MutexLock lock(&mutex_);
+      if (done_) return;
+      done_ = true;
+      registrations[0] = std::move(registration_[0]);
+      registrations[1] = std::move(registration_[1]);
+    }
+    stop_source_.request_stop();
+    registrations[0].Unregister();
+    registrations[1].Unregister();
+  }
+
+  Promise<HttpResponse>& promise() { return promise_; }
+  StopToken stop_token() const { return stop_source_.get_token(); }
+
+ private:
+  std::shared_ptr<RequestHedger> hedger_;
+  std::shared_ptr<HttpTransport> transport_;
+  HttpRequest request_;
+  IssueRequestOptions options_;
+  RequestHedgingMetrics* metrics_;
+  Promise<HttpResponse> promise_;
+  StopSource stop_source_;
+  absl::Time start_time_[2];
+
+  absl::Mutex mutex_;
+  bool done_ ABSL_GUARDED_BY(mutex_) = false;
+  int pending_ ABSL_GUARDED_BY(mutex_) = 1;
+  FutureCallbackRegistration registration_[2] ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace
+
+Future<HttpResponse> IssueHedgedRequest(
+    std::shared_ptr<RequestHedger> hedger,
+    std::shared_ptr<HttpTransport> transport, const HttpRequest& request,
+    IssueRequestOptions options, RequestHedgingMetrics* metrics) {
+  if (!hedger) return transport->IssueRequest(request, std::move(options));
+  hedger->StartRequest();
+  // No backup request is issued until enough latencies have been observed.
+  auto delay = hedger->GetHedgeDelay();
+  // Hedged requests are idempotent, so the losing request may be aborted.
+  options.cancel_when_not_needed = true;
+  auto [promise, future] = PromiseFuturePair<HttpResponse>::Make();
+  auto state = internal::MakeIntrusivePtr<HedgedRequestState>(
+      std::move(hedger), std::move(transport), request, std::move(options),
+      metrics, std::move(promise));
+  state->promise().ExecuteWhenNotNeeded(
+      [state = state] { state->Cancel(); });
+  state->IssueAttempt(0);
+  if (delay) {
+    auto stop_token = state->stop_token();
+    internal::ScheduleAt(
+        absl::Now() + *delay,
+        [state = std::move(state)]() mutable { state->MaybeIssueBackup(); },
+        stop_token);
+  }
+  return std::move(future);
+}
+
+}  // namespace internal_http
+}  // namespace tensorstore
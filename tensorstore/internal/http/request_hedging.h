@@ -0,0 +1,163 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_HTTP_REQUEST_HEDGING_H_
+#define TENSORSTORE_INTERNAL_HTTP_REQUEST_HEDGING_H_
+
+/// \file
+/// Request hedging reduces tail latency of idempotent HTTP requests: when a
+/// request has not completed after a delay corresponding to a high percentile
+/// of previously observed latencies, an identical backup request is issued.
+/// The first successful response is used, and the other request is cancelled.
+///
+/// See "The Tail at Scale", Dean and Barroso, CACM 2013.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
+
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/http/http_request.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_http {
+
+/// Approximate, thread-safe histogram of request latencies.
+///
+/// Buckets are spaced exponentially, from 100us to about 2 minutes, with a
+/// relative bucket width of 25%.  To track changes in the latency
+/// distribution, all counts are halved once `kDecayCount` observations have
+/// been recorded.
+class LatencyHistogram {
+ public:
+  static constexpr size_t kNumBuckets = 64;
+  static constexpr int64_t kDecayCount = 16384;
+
+  /// Records a single observation.
+  void Observe(absl::Duration latency);
+
+  /// Returns the (decayed) number of observations.
+  int64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+  /// Returns an upper bound on the latency at quantile `q`, in `[0, 1]`, or
+  /// `std::nullopt` if there are no observations.
+  std::optional<absl::Duration> Quantile(double q) const;
+
+  /// Returns the index of the bucket containing `latency`.
+  static size_t GetBucket(absl::Duration latency);
+
+  /// Returns the (inclusive) upper bound of bucket `i`.
+  static absl::Duration GetBucketUpperBound(size_t i);
+
+ private:
+  void Decay();
+
+  std::array<std::atomic<int64_t>, kNumBuckets> buckets_{};
+  std::atomic<int64_t> count_{0};
+  absl::Mutex decay_mutex_;
+};
+
+/// Parameters controlling request hedging.
+struct RequestHedgingOptions {
+  /// Latency quantile, in `(0, 1)`, after which a backup request is issued.
+  double quantile = 0.95;
+
+  /// Lower bound on the delay before a backup request is issued.
+  absl::Duration min_delay = absl::Milliseconds(10);
+
+  /// Upper bound on the fraction of requests that issue a backup request.
+  /// Limits the additional load when latencies increase across the board.
+  double max_hedged_fraction = 0.05;
+
+  /// Number of latency observations required before hedging starts.
+  int64_t min_samples = 100;
+};
+
+/// Counters updated by `IssueHedgedRequest`; each kvstore driver registers its
+/// own instance.
+struct RequestHedgingMetrics {
+  /// Number of backup requests issued.
+  internal_metrics::Counter<int64_t> hedged;
+  /// Number of backup requests that completed before the original request.
+  internal_metrics::Counter<int64_t> hedge_won;
+};
+
+/// Shared hedging state for a kvstore driver: the latency histogram and the
+/// hedging budget.
+class RequestHedger {
+ public:
+  explicit RequestHedger(const RequestHedgingOptions& options)
+      : options_(options) {}
+
+  const RequestHedgingOptions& options() const { return options_; }
+  LatencyHistogram& histogram() { return histogram_; }
+
+  /// Returns the delay after which a backup request should be issued for a
+  /// new request, or `std::nullopt` if not enough latencies have been
+  /// observed.
+  std::optional<absl::Duration> GetHedgeDelay() const;
+
+  /// Records that a new request has started.
+  void StartRequest() { num_requests_.fetch_add(1, std::memory_order_relaxed); }
+
+  /// Acquires budget for a backup request.  Returns `false` if issuing another
+  /// backup request would exceed `max_hedged_fraction`.
+  bool TryStartHedge();
+
+  /// Records the latency of a successful request.
+  void ObserveLatency(absl::Duration latency) { histogram_.Observe(latency); }
+
+ private:
+  RequestHedgingOptions options_;
+  LatencyHistogram histogram_;
+  std::atomic<int64_t> num_requests_{0};
+  std::atomic<int64_t> num_hedges_{0};
+};
+
+/// Issues `request`, which must be idempotent, with hedging.
+///
+/// If `hedger` is null, this is equivalent to `transport->IssueRequest`.
+///
+/// An error from one of the requests is returned only if no other request is
+/// outstanding; retries remain the responsibility of the caller.
+///
+/// When hedging is enabled, requests are issued with
+/// `IssueRequestOptions::cancel_when_not_needed`, so that the transport may
+/// abort the losing request.  The latency of a losing original request is
+/// recorded as the time elapsed until it was cancelled, which is a lower
+/// bound.
+///
+/// \param hedger Hedging state shared by requests to the same service.
+/// \param transport Transport used to issue the requests.
+/// \param request Request to issue.
+/// \param options Request options; the payload should be empty.
+/// \param metrics Optional, counters to update.
+Future<HttpResponse> IssueHedgedRequest(
+    std::shared_ptr<RequestHedger> hedger,
+    std::shared_ptr<HttpTransport> transport, const HttpRequest& request,
+    IssueRequestOptions options, RequestHedgingMetrics* metrics = nullptr);
+
+}  // namespace internal_http
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_HTTP_REQUEST_HEDGING_H_
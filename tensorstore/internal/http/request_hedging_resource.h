@@ -0,0 +1,132 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_HTTP_REQUEST_HEDGING_RESOURCE_H_
+#define TENSORSTORE_INTERNAL_HTTP_REQUEST_HEDGING_RESOURCE_H_
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "absl/status/status.h"
+#include "absl/time/time.h"
+#include "tensorstore/context.h"
+#include "tensorstore/context_resource_provider.h"
+#include "tensorstore/internal/cache_key/absl_time.h"  // IWYU pragma: keep
+#include "tensorstore/internal/http/request_hedging.h"
+#include "tensorstore/internal/json_binding/absl_time.h"  // IWYU pragma: keep
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_http {
+
+/// Specifies request hedging parameters as a context resource.
+///
+/// All kvstores that share the resource also share the latency histogram
+/// from which the hedging delay is computed, and the hedging budget.
+template <typename Derived>
+struct RequestHedgingResource
+    : public internal::ContextResourceTraits<Derived> {
+  struct Spec {
+    bool enabled = false;
+    double quantile = 0.95;
+    absl::Duration min_delay = absl::Milliseconds(10);
+    double max_hedged_fraction = 0.05;
+    int64_t min_samples = 100;
+
+    constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+      return f(x.enabled, x.quantile, x.min_delay, x.max_hedged_fraction,
+               x.min_samples);
+    };
+  };
+  struct Resource {
+    Spec spec;
+    // Null if hedging is disabled.
+    std::shared_ptr<RequestHedger> hedger;
+  };
+
+  static Spec Default() { return {}; }
+
+  static constexpr auto JsonBinder() {
+    namespace jb = ::tensorstore::internal_json_binding;
+    return jb::Validate(
+        [](const auto& options, const Spec* x) -> absl::Status {
+          if (!(x->quantile > 0 && x->quantile < 1)) {
+            return absl::InvalidArgumentError(
+                "\"quantile\" must be greater than 0 and less than 1");
+          }
+          if (!(x->max_hedged_fraction >= 0 && x->max_hedged_fraction <= 1)) {
+            return absl::InvalidArgumentError(
+                "\"max_hedged_fraction\" must be in the range [0, 1]");
+          }
+          return absl::OkStatus();
+        },
+        jb::Object(
+            jb::Member("enabled",
+                       jb::Projection(&Spec::enabled,
+                                      jb::DefaultValue([](auto* v) {
+                                        *v = Derived::Default().enabled;
+                                      }))),
+            jb::Member("quantile",
+                       jb::Projection(&Spec::quantile,
+                                      jb::DefaultValue([](auto* v) {
+                                        *v = Derived::Default().quantile;
+                                      }))),
+            jb::Member("min_delay",
+                       jb::Projection(&Spec::min_delay,
+                                      jb::DefaultValue([](auto* v) {
+                                        *v = Derived::Default().min_delay;
+                                      }))),
+            jb::Member(
+                "max_hedged_fraction",
+                jb::Projection(&Spec::max_hedged_fraction,
+                               jb::DefaultValue([](auto* v) {
+                                 *v = Derived::Default().max_hedged_fraction;
+                               }))),
+            jb::Member("min_samples",
+                       jb::Projection(&Spec::min_samples,
+                                      jb::DefaultValue(
+                                          [](auto* v) {
+                                            *v = Derived::Default().min_samples;
+                                          },
+                                          jb::Integer<int64_t>(1))))));
+  }
+
+  static Result<Resource> Create(
+      const Spec& spec, internal::ContextResourceCreationContext context) {
+    Resource resource;
+    resource.spec = spec;
+    if (spec.enabled) {
+      RequestHedgingOptions options;
+      options.quantile = spec.quantile;
+      options.min_delay = spec.min_delay;
+      options.max_hedged_fraction = spec.max_hedged_fraction;
+      options.min_samples = spec.min_samples;
+      resource.hedger = std::make_shared<RequestHedger>(options);
+    }
+    return resource;
+  }
+
+  static Spec GetSpec(const Resource& resource,
+                      const internal::ContextSpecBuilder& builder) {
+    return resource.spec;
+  }
+};
+
+}  // namespace internal_http
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_HTTP_REQUEST_HEDGING_RESOURCE_H_
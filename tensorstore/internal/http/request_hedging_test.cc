@@ -0,0 +1,258 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/http/request_hedging.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/http/http_request.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/http/mock_http_transport.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::internal_http::ApplyResponseToHandler;
+using ::tensorstore::internal_http::HttpRequest;
+using ::tensorstore::internal_http::HttpResponse;
+using ::tensorstore::internal_http::HttpResponseHandler;
+using ::tensorstore::internal_http::HttpTransport;
+using ::tensorstore::internal_http::IssueHedgedRequest;
+using ::tensorstore::internal_http::IssueRequestOptions;
+using ::tensorstore::internal_http::LatencyHistogram;
+using ::tensorstore::internal_http::RequestHedger;
+using ::tensorstore::internal_http::RequestHedgingMetrics;
+using ::tensorstore::internal_http::RequestHedgingOptions;
+
+/// Transport that holds on to the response handlers, so that each test can
+/// complete the requests in a chosen order.
+class PendingHttpTransport : public HttpTransport {
+ public:
+  void IssueRequestWithHandler(const HttpRequest& request,
+                               IssueRequestOptions options,
+                               HttpResponseHandler* response_handler) override {
+    absl::MutexLock lock(&mutex_);
+    handlers_.push_back(response_handler);
+  }
+
+  // Waits until `n` requests have been issued.
+  bool WaitForRequests(size_t n, absl::Duration timeout) {
+    absl::MutexLock lock(&mutex_);
+    auto cond = [&] {
+      mutex_.AssertHeld();
+      return handlers_.size() >= n;
+    };
+    return mutex_.AwaitWithTimeout(absl::Condition(&cond), timeout);
+  }
+
+  HttpResponseHandler* handler(size_t i) {
+    absl::MutexLock lock(&mutex_);
+    return handlers_[i];
+  }
+
+  size_t num_requests() {
+    absl::MutexLock lock(&mutex_);
+    return handlers_.size();
+  }
+
+ private:
+  absl::Mutex mutex_;
+  std::vector<HttpResponseHandler*> handlers_;
+};
+
+HttpRequest MakeRequest() {
+  HttpRequest request;
+  request.method = "GET";
+  request.url = "https://example.com/object";
+  return request;
+}
+
+TEST(LatencyHistogramTest, Buckets) {
+  EXPECT_EQ(0, LatencyHistogram::GetBucket(absl::ZeroDuration()));
+  EXPECT_EQ(0, LatencyHistogram::GetBucket(absl::Microseconds(100)));
+  EXPECT_EQ(1, LatencyHistogram::GetBucket(absl::Microseconds(101)));
+  EXPECT_EQ(1, LatencyHistogram::GetBucket(absl::Microseconds(125)));
+  EXPECT_EQ(LatencyHistogram::kNumBuckets - 1,
+            LatencyHistogram::GetBucket(absl::Hours(1)));
+  EXPECT_EQ(absl::InfiniteDuration(), LatencyHistogram::GetBucketUpperBound(
+                                          LatencyHistogram::kNumBuckets - 1));
+  EXPECT_EQ(absl::Microseconds(125), LatencyHistogram::GetBucketUpperBound(1));
+}
+
+TEST(LatencyHistogramTest, Quantile) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(std::nullopt, histogram.Quantile(0.5));
+  for (int i = 0; i < 90; ++i) histogram.Observe(absl::Milliseconds(1));
+  for (int i = 0; i < 10; ++i) histogram.Observe(absl::Milliseconds(100));
+  EXPECT_EQ(100, histogram.count());
+
+  auto p50 = histogram.Quantile(0.5);
+  ASSERT_TRUE(p50);
+  EXPECT_GE(*p50, absl::Milliseconds(1));
+  EXPECT_LT(*p50, absl::Microseconds(1250));
+
+  auto p95 = histogram.Quantile(0.95);
+  ASSERT_TRUE(p95);
+  EXPECT_GE(*p95, absl::Milliseconds(100));
+  EXPECT_LT(*p95, absl::Milliseconds(125));
+}
+
+TEST(LatencyHistogramTest, Decay) {
+  LatencyHistogram histogram;
+  for (int64_t i = 0; i < LatencyHistogram::kDecayCount; ++i) {
+    histogram.Observe(absl::Milliseconds(1));
+  }
+  EXPECT_EQ(LatencyHistogram::kDecayCount / 2, histogram.count());
+}
+
+TEST(RequestHedgerTest, HedgeDelay) {
+  RequestHedgingOptions options;
+  options.min_samples = 10;
+  options.min_delay = absl::Milliseconds(50);
+  RequestHedger hedger(options);
+  for (int i = 0; i < 9; ++i) hedger.ObserveLatency(absl::Milliseconds(1));
+  EXPECT_EQ(std::nullopt, hedger.GetHedgeDelay());
+  hedger.ObserveLatency(absl::Milliseconds(1));
+  EXPECT_EQ(absl::Milliseconds(50), hedger.GetHedgeDelay());
+}
+
+TEST(RequestHedgerTest, Budget) {
+  RequestHedgingOptions options;
+  options.max_hedged_fraction = 0.1;
+  RequestHedger hedger(options);
+  for (int i = 0; i < 9; ++i) hedger.StartRequest();
+  EXPECT_FALSE(hedger.TryStartHedge());
+  hedger.StartRequest();
+  EXPECT_TRUE(hedger.TryStartHedge());
+  EXPECT_FALSE(hedger.TryStartHedge());
+  for (int i = 0; i < 10; ++i) hedger.StartRequest();
+  EXPECT_TRUE(hedger.TryStartHedge());
+}
+
+TEST(IssueHedgedRequestTest, NoHedger) {
+  auto transport = std::make_shared<PendingHttpTransport>();
+  auto future = IssueHedgedRequest(nullptr, transport, MakeRequest(),
+                                   IssueRequestOptions());
+  ASSERT_EQ(1, transport->num_requests());
+  ApplyResponseToHandler(HttpResponse{200, absl::Cord("abc")},
+                         transport->handler(0));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto response, future.result());
+  EXPECT_EQ(200, response.status_code);
+  EXPECT_EQ("abc", response.payload);
+}
+
+TEST(IssueHedgedRequestTest, NotEnoughSamples) {
+  auto hedger = std::make_shared<RequestHedger>(RequestHedgingOptions{});
+  auto transport = std::make_shared<PendingHttpTransport>();
+  auto future = IssueHedgedRequest(hedger, transport, MakeRequest(),
+                                   IssueRequestOptions());
+  EXPECT_FALSE(transport->WaitForRequests(2, absl::Milliseconds(50)));
+  ApplyResponseToHandler(HttpResponse{200, absl::Cord("abc")},
+                         transport->handler(0));
+  TENSORSTORE_ASSERT_OK(future.result());
+  EXPECT_EQ(1, hedger->histogram().count());
+}
+
+TEST(IssueHedgedRequestTest, BackupWins) {
+  RequestHedgingOptions options;
+  options.min_samples = 1;
+  options.min_delay = absl::Milliseconds(1);
+  options.max_hedged_fraction = 1;
+  auto hedger = std::make_shared<RequestHedger>(options);
+  hedger->ObserveLatency(absl::Milliseconds(1));
+
+  RequestHedgingMetrics metrics;
+  auto transport = std::make_shared<PendingHttpTransport>();
+  auto future = IssueHedgedRequest(hedger, transport, MakeRequest(),
+                                   IssueRequestOptions(), &metrics);
+  ASSERT_TRUE(transport->WaitForRequests(2, absl::Seconds(10)));
+  EXPECT_FALSE(future.ready());
+
+  ApplyResponseToHandler(HttpResponse{200, absl::Cord("backup")},
+                         transport->handler(1));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto response, future.result());
+  EXPECT_EQ("backup", response.payload);
+  EXPECT_EQ(1, metrics.hedged.Get());
+  EXPECT_EQ(1, metrics.hedge_won.Get());
+  // Both the backup and, as a lower bound, the cancelled original request are
+  // recorded.
+  EXPECT_EQ(3, hedger->histogram().count());
+
+  // The original request is no longer needed.
+  EXPECT_TRUE(transport->handler(0)->IsCancelled());
+  ApplyResponseToHandler(absl::CancelledError(), transport->handler(0));
+}
+
+TEST(IssueHedgedRequestTest, FailureWaitsForOtherRequest) {
+  RequestHedgingOptions options;
+  options.min_samples = 1;
+  options.min_delay = absl::Milliseconds(1);
+  options.max_hedged_fraction = 1;
+  auto hedger = std::make_shared<RequestHedger>(options);
+  hedger->ObserveLatency(absl::Milliseconds(1));
+
+  RequestHedgingMetrics metrics;
+  auto transport = std::make_shared<PendingHttpTransport>();
+  auto future = IssueHedgedRequest(hedger, transport, MakeRequest(),
+                                   IssueRequestOptions(), &metrics);
+  ASSERT_TRUE(transport->WaitForRequests(2, absl::Seconds(10)));
+
+  ApplyResponseToHandler(absl::UnavailableError("backup failed"),
+                         transport->handler(1));
+  EXPECT_FALSE(future.ready());
+  ApplyResponseToHandler(HttpResponse{200, absl::Cord("original")},
+                         transport->handler(0));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto response, future.result());
+  EXPECT_EQ("original", response.payload);
+  EXPECT_EQ(1, metrics.hedged.Get());
+  EXPECT_EQ(0, metrics.hedge_won.Get());
+}
+
+TEST(IssueHedgedRequestTest, CancelWhenNotNeeded) {
+  auto hedger = std::make_shared<RequestHedger>(RequestHedgingOptions{});
+  auto transport = std::make_shared<PendingHttpTransport>();
+  auto future = IssueHedgedRequest(hedger, transport, MakeRequest(),
+                                   IssueRequestOptions());
+  ASSERT_EQ(1, transport->num_requests());
+  EXPECT_FALSE(transport->handler(0)->IsCancelled());
+  future = {};
+  EXPECT_TRUE(transport->handler(0)->IsCancelled());
+  ApplyResponseToHandler(absl::CancelledError(), transport->handler(0));
+}
+
+TEST(IssueHedgedRequestTest, NotCancelledWithoutHedging) {
+  auto transport = std::make_shared<PendingHttpTransport>();
+  auto future = IssueHedgedRequest(nullptr, transport, MakeRequest(),
+                                   IssueRequestOptions());
+  ASSERT_EQ(1, transport->num_requests());
+  future = {};
+  EXPECT_FALSE(transport->handler(0)->IsCancelled());
+  ApplyResponseToHandler(HttpResponse{200, absl::Cord("original")},
+                         transport->handler(0));
+}
+
+}  // namespace
@@ -26,6 +26,7 @@
 #include <optional>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "absl/base/attributes.h"
 #include "absl/log/absl_check.h"
@@ -57,7 +58,8 @@ struct TiffReader::Context : public LibTiffErrorBase {
   absl::Status ExtractErrors(absl::Status in);
 
   absl::Status Open();
-  absl::Status DefaultDecode(tensorstore::span<unsigned char> data);
+  absl::Status DefaultDecode(tensorstore::span<unsigned char> data,
+                             const TiffReaderOptions& options);
 };
 
 namespace {
@@ -259,26 +261,96 @@ absl::Status GetTIFFImageInfo(TIFF* tiff, TiffImageInfo& info) {
   return absl::OkStatus();
 }
 
-absl::Status ReadStripImpl(TIFF* tiff, TiffImageInfo& info,
-                           tensorstore::span<unsigned char> data) {
-  ImageView dest_view(info, data);
+// A rectangle of the current frame, in pixels.
+struct DecodeRegion {
+  size_t x;
+  size_t y;
+  size_t width;
+  size_t height;
+};
 
-  // Translate 1,2,4 bits per sample to 8-bpp images.
-  const unsigned char* mapping = nullptr;
-  ptrdiff_t trstride = 1;
-  if (info.bits_per_sample_ == 1) {
-    mapping = TranslateBits<1>(trstride);
-  } else if (info.bits_per_sample_ == 2) {
-    mapping = TranslateBits<2>(trstride);
-  } else if (info.bits_per_sample_ == 4) {
-    mapping = TranslateBits<4>(trstride);
+// Copies the part of each decoded source row that lies within a region into
+// the destination buffer, expanding 1, 2 and 4 bits per sample to 8-bpp.
+class RegionRowCopier {
+ public:
+  RegionRowCopier(const TiffImageInfo& info, const DecodeRegion& region,
+                  tensorstore::span<unsigned char> data)
+      : region_(region),
+        dest_view_(ImageInfo{/*.height=*/static_cast<int32_t>(region.height),
+                             /*.width=*/static_cast<int32_t>(region.width),
+                             /*.num_components=*/info.num_components,
+                             /*.dtype=*/info.dtype},
+                   data),
+        pixel_bytes_(info.num_components * info.dtype.size()) {
+    // Translate 1,2,4 bits per sample to 8-bpp images.
+    if (info.bits_per_sample_ == 1) {
+      mapping_ = TranslateBits<1>(trstride_);
+    } else if (info.bits_per_sample_ == 2) {
+      mapping_ = TranslateBits<2>(trstride_);
+    } else if (info.bits_per_sample_ == 4) {
+      mapping_ = TranslateBits<4>(trstride_);
+    }
+  }
+
+  bool has_mapping() const { return mapping_ != nullptr; }
+
+  const ImageView& dest_view() const { return dest_view_; }
+
+  // Copies source row `y`, which holds `width` pixels starting at image
+  // column `x`, into the destination.  Row `y` must be within the region.
+  void Copy(const unsigned char* source, size_t y, size_t x, size_t width) {
+    const size_t x_begin = std::max(x, region_.x);
+    const size_t x_end = std::min(x + width, region_.x + region_.width);
+    if (x_begin >= x_end) return;
+    if (mapping_) {
+      const size_t unpacked_bytes = width * pixel_bytes_;
+      const size_t packed_bytes = (unpacked_bytes + trstride_ - 1) / trstride_;
+      if (scratch_size_ < packed_bytes * trstride_) {
+        scratch_size_ = packed_bytes * trstride_;
+        scratch_.reset(new unsigned char[scratch_size_]);
+      }
+      unsigned char* unpacked = scratch_.get();
+      for (size_t i = 0; i < packed_bytes; ++i) {
+        memcpy(unpacked + i * trstride_, mapping_ + (source[i] * trstride_),
+               trstride_);
+      }
+      source = unpacked;
+    }
+    memcpy(dest_view_.data_row(y - region_.y, (x_begin - region_.x) *
+                                                  pixel_bytes_)
+               .data(),
+           source + (x_begin - x) * pixel_bytes_,
+           (x_end - x_begin) * pixel_bytes_);
   }
 
+ private:
+  DecodeRegion region_;
+  ImageView dest_view_;
+  size_t pixel_bytes_;
+  const unsigned char* mapping_ = nullptr;
+  ptrdiff_t trstride_ = 1;
+  std::unique_ptr<unsigned char[]> scratch_;
+  size_t scratch_size_ = 0;
+};
+
+absl::Status ReadStripImpl(TIFF* tiff, TiffImageInfo& info,
+                           const DecodeRegion& region,
+                           tensorstore::span<unsigned char> data) {
+  RegionRowCopier copier(info, region, data);
+  const auto& dest_view = copier.dest_view();
+
   const int strip_bytes = TIFFStripSize(tiff);
   uint32_t rows_per_strip = 1;
   TIFFGetFieldDefaulted(tiff, TIFFTAG_ROWSPERSTRIP, &rows_per_strip);
+  rows_per_strip = std::min<uint32_t>(rows_per_strip, info.height);
 
-  if (!mapping &&
+  // Only the strips which intersect the region are read.
+  const size_t y_begin = region.y - region.y % rows_per_strip;
+  const size_t y_end = region.y + region.height;
+
+  if (!copier.has_mapping() && region.x == 0 && region.y == 0 &&
+      region.width == static_cast<size_t>(info.width) &&
+      region.height == static_cast<size_t>(info.height) &&
       strip_bytes == rows_per_strip * dest_view.row_stride_bytes()) {
     /// No extra data && no mapping means that the TIFF can be read directly
     /// into the output buffer.
@@ -294,86 +366,53 @@ absl::Status ReadStripImpl(TIFF* tiff, TiffImageInfo& info,
   }
 
   std::unique_ptr<unsigned char[]> buffer(new unsigned char[strip_bytes]);
-  uint32_t line_bytes =
-      info.width * (info.bits_per_sample_ / 8) * info.num_components;
+  const tmsize_t line_bytes = TIFFScanlineSize(tiff);
 
-  for (size_t y = 0; y < info.height; y += rows_per_strip) {
+  for (size_t y = y_begin; y < y_end; y += rows_per_strip) {
     // Read the strip.
     if (TIFFReadEncodedStrip(tiff, TIFFComputeStrip(tiff, y, 0), buffer.get(),
                              strip_bytes) == -1) {
       return absl::DataLossError("TIFF read strip failed");
     }
 
-    unsigned char* source_row = buffer.get();
-    for (size_t r = 0; r < rows_per_strip; r++) {
-      if (y + r >= info.height) break;
-      auto target_row = dest_view.data_row(y + r);
-
-      if (info.bits_per_sample_ >= 8) {
-        assert(line_bytes == dest_view.row_stride_bytes());
-        memcpy(target_row.data(), source_row, line_bytes);
-        source_row += line_bytes;
-      } else {
-        while (!target_row.empty()) {
-          size_t n = std::min(trstride, target_row.size());
-          memcpy(target_row.data(), mapping + (*source_row * trstride), n);
-          target_row = target_row.subspan(n);
-          source_row++;
-        }
-      }
+    const unsigned char* source_row = buffer.get();
+    for (size_t r = 0; r < rows_per_strip; r++, source_row += line_bytes) {
+      if (y + r >= y_end) break;
+      if (y + r < region.y) continue;
+      copier.Copy(source_row, y + r, 0, info.width);
     }
   }
   return absl::OkStatus();
 }
 
 absl::Status ReadTiledImpl(TIFF* tiff, TiffImageInfo& info,
+                           const DecodeRegion& region,
                            tensorstore::span<unsigned char> data) {
-  ImageView dest_view(info, data);
-
-  // Translate 1,2,4 bits per sample to 8-bpp images.
-  const unsigned char* mapping = nullptr;
-  ptrdiff_t trstride = 1;
-  if (info.bits_per_sample_ == 1) {
-    mapping = TranslateBits<1>(trstride);
-  } else if (info.bits_per_sample_ == 2) {
-    mapping = TranslateBits<2>(trstride);
-  } else if (info.bits_per_sample_ == 4) {
-    mapping = TranslateBits<4>(trstride);
-  }
+  RegionRowCopier copier(info, region, data);
 
   uint32_t tile_width, tile_height;
   TIFFGetField(tiff, TIFFTAG_TILEWIDTH, &tile_width);
   TIFFGetField(tiff, TIFFTAG_TILELENGTH, &tile_height);
 
   const int tile_bytes = TIFFTileSize(tiff);
+  const tmsize_t tile_row_bytes = TIFFTileRowSize(tiff);
   std::unique_ptr<unsigned char[]> tile_buffer(new unsigned char[tile_bytes]);
-  ImageView tile_view(ImageInfo{/*.height=*/static_cast<int32_t>(tile_height),
-                                /*.width=*/static_cast<int32_t>(tile_width),
-                                /*.num_components=*/info.num_components},
-                      {tile_buffer.get(), tile_bytes});
 
-  for (size_t y = 0; y < info.height; y += tile_height) {
-    for (size_t x = 0; x < info.width; x += tile_width) {
+  // Only the tiles which intersect the region are read.
+  const size_t y_end = region.y + region.height;
+  const size_t x_end = region.x + region.width;
+  for (size_t y = region.y - region.y % tile_height; y < y_end;
+       y += tile_height) {
+    for (size_t x = region.x - region.x % tile_width; x < x_end;
+         x += tile_width) {
       if (TIFFReadTile(tiff, tile_buffer.get(), x, y, 0, 0) == -1) {
         return absl::DataLossError("TIFF read tile failed");
       }
+      const size_t width = std::min<size_t>(tile_width, info.width - x);
       for (size_t y1 = 0; y1 < tile_height; y1++) {
-        if ((y + y1) >= info.height) break;
-        auto target_row = dest_view.data_row(y + y1, x);
-        auto tile_row = tile_view.data_row(y1);
-        if (info.bits_per_sample_ >= 8) {
-          memcpy(target_row.data(), tile_row.data(),
-                 std::min(target_row.size(), tile_row.size()));
-        } else {
-          unsigned char* packed = tile_row.data();
-          while (!target_row.empty()) {
-            size_t n = std::min(trstride, target_row.size());
-            memcpy(target_row.data(), mapping + (*packed * trstride), n);
-            target_row = target_row.subspan(n);
-            packed++;
-          }
-          assert(packed <= tile_row.data() + tile_row.size());
-        }
+        if ((y + y1) >= y_end) break;
+        if ((y + y1) < region.y) continue;
+        copier.Copy(tile_buffer.get() + y1 * tile_row_bytes, y + y1, x, width);
       }
     }
   }
@@ -425,10 +464,31 @@ absl::Status TiffReader::Context::Open() {
 }
 
 absl::Status TiffReader::Context::DefaultDecode(
-    tensorstore::span<unsigned char> data) {
+    tensorstore::span<unsigned char> data, const TiffReaderOptions& options) {
   TiffImageInfo info;
   TENSORSTORE_RETURN_IF_ERROR(GetTIFFImageInfo(tiff_, info));
-  ABSL_CHECK_EQ(data.size(), ImageRequiredBytes(info));
+
+  DecodeRegion region{0, 0, static_cast<size_t>(info.width),
+                      static_cast<size_t>(info.height)};
+  if (options.region) {
+    const auto& r = *options.region;
+    if (r.x < 0 || r.y < 0 || r.width <= 0 || r.height <= 0 ||
+        r.x > info.width - r.width || r.y > info.height - r.height) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "TIFF read failed: region {x=%d, y=%d, width=%d, height=%d} is "
+          "not within the %dx%d image",
+          r.x, r.y, r.width, r.height, info.width, info.height));
+    }
+    region = DecodeRegion{static_cast<size_t>(r.x), static_cast<size_t>(r.y),
+                          static_cast<size_t>(r.width),
+                          static_cast<size_t>(r.height)};
+  }
+  {
+    ImageInfo region_info = info;
+    region_info.width = region.width;
+    region_info.height = region.height;
+    ABSL_CHECK_EQ(data.size(), ImageRequiredBytes(region_info));
+  }
 
   // Additional fields checks (beyond the info)
   uint32_t compress_tag = 0;
@@ -477,9 +537,9 @@ absl::Status TiffReader::Context::DefaultDecode(
 
   absl::Status status;
   if (TIFFIsTiled(tiff_)) {
-    status = ReadTiledImpl(tiff_, info, data);
+    status = ReadTiledImpl(tiff_, info, region, data);
   } else {
-    status = ReadStripImpl(tiff_, info, data);
+    status = ReadStripImpl(tiff_, info, region, data);
   }
 
   return ExtractErrors(status);
@@ -519,6 +579,36 @@ absl::Status TiffReader::SeekFrame(int frame_number) {
   return context_->ExtractErrors(absl::OkStatus());
 }
 
+Result<std::vector<uint64_t>> TiffReader::GetFrameOffsets() {
+  if (!context_) {
+    return absl::UnknownError("No TIFF file opened.");
+  }
+  context_->error_ = absl::OkStatus();
+  TIFF* tiff = context_->tiff_;
+  if (TIFFSetDirectory(tiff, 0) != 1) {
+    return context_->ExtractErrors(absl::InvalidArgumentError(
+        "TIFF Initialize failed: failed to set directory"));
+  }
+  std::vector<uint64_t> offsets;
+  do {
+    offsets.push_back(TIFFCurrentDirOffset(tiff));
+  } while (TIFFReadDirectory(tiff) == 1);
+  TENSORSTORE_RETURN_IF_ERROR(context_->ExtractErrors(absl::OkStatus()));
+  return offsets;
+}
+
+absl::Status TiffReader::SeekFrameOffset(uint64_t offset) {
+  if (!context_) {
+    return absl::UnknownError("No TIFF file opened.");
+  }
+  context_->error_ = absl::OkStatus();
+  if (TIFFSetSubDirectory(context_->tiff_, offset) != 1) {
+    return context_->ExtractErrors(absl::InvalidArgumentError(
+        "TIFF Initialize failed: failed to set directory"));
+  }
+  return context_->ExtractErrors(absl::OkStatus());
+}
+
 ImageInfo TiffReader::GetImageInfo() {
   if (!context_) {
     return {};
@@ -530,12 +620,40 @@ ImageInfo TiffReader::GetImageInfo() {
   return info;
 }
 
+Result<TiffTileLayout> TiffReader::GetTileLayout() {
+  if (!context_) {
+    return absl::InternalError("No TIFF file opened");
+  }
+  TIFF* tiff = context_->tiff_;
+  TiffImageInfo info;
+  TENSORSTORE_RETURN_IF_ERROR(GetTIFFImageInfo(tiff, info));
+  TiffTileLayout layout;
+  if (TIFFIsTiled(tiff)) {
+    uint32_t tile_width = 0, tile_height = 0;
+    if (!TIFFGetField(tiff, TIFFTAG_TILEWIDTH, &tile_width) ||
+        !TIFFGetField(tiff, TIFFTAG_TILELENGTH, &tile_height) ||
+        tile_width == 0 || tile_height == 0) {
+      return absl::InvalidArgumentError("TIFF read failed: invalid tile size");
+    }
+    layout.tiled = true;
+    layout.tile_width = tile_width;
+    layout.tile_height = tile_height;
+  } else {
+    uint32_t rows_per_strip = 1;
+    TIFFGetFieldDefaulted(tiff, TIFFTAG_ROWSPERSTRIP, &rows_per_strip);
+    layout.tile_width = info.width;
+    layout.tile_height = static_cast<int32_t>(
+        std::clamp<uint32_t>(rows_per_strip, 1, std::max(info.height, 1)));
+  }
+  return layout;
+}
+
 absl::Status TiffReader::DecodeImpl(tensorstore::span<unsigned char> dest,
                                     const TiffReaderOptions& options) {
   if (!context_) {
     return absl::InternalError("No TIFF file to decode");
   }
-  return context_->DefaultDecode(dest);
+  return context_->DefaultDecode(dest, options);
 }
 
 bool TiffReader::CheckSignature(std::string_view signature) {
@@ -15,18 +15,48 @@
 #ifndef TENSORSTORE_INTERNAL_IMAGE_TIFF_READER_H_
 #define TENSORSTORE_INTERNAL_IMAGE_TIFF_READER_H_
 
+#include <stdint.h>
+
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "riegeli/bytes/reader.h"
 #include "tensorstore/internal/image/image_info.h"
 #include "tensorstore/internal/image/image_reader.h"
+#include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
 
 namespace tensorstore {
 namespace internal_image {
 
-struct TiffReaderOptions {};
+struct TiffReaderOptions {
+  // A rectangular region of the current frame, in pixels.
+  struct Region {
+    int32_t x = 0;
+    int32_t y = 0;
+    int32_t width = 0;
+    int32_t height = 0;
+  };
+
+  // When set, only the pixels of the current frame within `region` are
+  // decoded, and only the tiles or strips which intersect it are read. The
+  // destination buffer must then be sized for a `region.height` x
+  // `region.width` image.
+  std::optional<Region> region;
+};
+
+// Layout of the independently-decodable blocks of a TIFF frame.
+struct TiffTileLayout {
+  // Whether the frame is stored as tiles rather than strips.
+  bool tiled = false;
+
+  // Block shape, in pixels. For strips, `tile_width` is the image width and
+  // `tile_height` is the number of rows per strip (at most the image height).
+  int32_t tile_width = 0;
+  int32_t tile_height = 0;
+};
 
 class TiffReader : public ImageReader {
  public:
@@ -52,9 +82,23 @@ class TiffReader : public ImageReader {
   // GetFrameCount().
   absl::Status SeekFrame(int frame_number);
 
+  // Returns the file offsets of all TIFF directories (or pages), in order.
+  // The directory chain is read once; afterwards the current frame is
+  // unspecified.
+  Result<std::vector<uint64_t>> GetFrameOffsets();
+
+  // Sets the state of the decoder so that the frame whose directory is at
+  // file offset 'offset', as returned by GetFrameOffsets(), will be the next
+  // to be returned through a call to Decode(). Unlike SeekFrame(), this does
+  // not read the directories preceding the requested frame.
+  absl::Status SeekFrameOffset(uint64_t offset);
+
   // Returns the current ImageInfo.
   ImageInfo GetImageInfo() override;
 
+  // Returns the tile or strip layout of the current frame.
+  Result<TiffTileLayout> GetTileLayout();
+
   // Decodes the next available image into 'dest'.
   absl::Status Decode(tensorstore::span<unsigned char> dest) override {
     return DecodeImpl(dest, {});
@@ -15,6 +15,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -34,6 +35,7 @@
 #include "tensorstore/internal/image/tiff_writer.h"
 #include "tensorstore/internal/path.h"
 #include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
 #include "tensorstore/util/status_testutil.h"
 
 ABSL_FLAG(std::string, tensorstore_test_data_dir, ".",
@@ -45,6 +47,7 @@ using ::tensorstore::IsOk;
 using ::tensorstore::StatusIs;
 using ::tensorstore::internal_image::ImageInfo;
 using ::tensorstore::internal_image::TiffReader;
+using ::tensorstore::internal_image::TiffReaderOptions;
 using ::tensorstore::internal_image::TiffWriter;
 using ::tensorstore::internal_image::TiffWriterOptions;
 
@@ -196,6 +199,134 @@ TEST_F(TiffTest, ReadMultiPage) {
   }
 }
 
+absl::Cord ReadTestFile(std::string_view name) {
+  absl::Cord file_data;
+  std::string filename = tensorstore::internal::JoinPath(
+      absl::GetFlag(FLAGS_tensorstore_test_data_dir), "tiff", name);
+  TENSORSTORE_CHECK_OK(
+      riegeli::ReadAll(riegeli::FdReader(filename), file_data));
+  return file_data;
+}
+
+class TiffRegionTest : public ::testing::TestWithParam<std::string> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    TiffRegionTests, TiffRegionTest,
+    ::testing::Values("D75_08b.tiff", "D75_08b_scanline.tiff",
+                      "D75_08b_tiled.tiff", "D75_08b_lzw.tiff",
+                      "D75_08b_zip.tiff", "D75_01b.tiff", "D75_16b.tiff"));
+
+TEST_P(TiffRegionTest, DecodeRegionMatchesFullDecode) {
+  absl::Cord file_data = ReadTestFile(GetParam());
+  riegeli::CordReader cord_reader(&file_data);
+  TiffReader decoder;
+  ASSERT_THAT(decoder.Initialize(&cord_reader), IsOk());
+
+  const ImageInfo info = decoder.GetImageInfo();
+  const size_t pixel_bytes = info.num_components * info.dtype.size();
+  std::unique_ptr<unsigned char[]> image(
+      new unsigned char[ImageRequiredBytes(info)]);
+  ASSERT_THAT(decoder.Decode(tensorstore::span(image.get(),
+                                               ImageRequiredBytes(info))),
+              IsOk());
+
+  for (const auto& region : {
+           TiffReaderOptions::Region{0, 0, info.width, info.height},
+           TiffReaderOptions::Region{37, 19, 101, 67},
+           TiffReaderOptions::Region{info.width - 5, info.height - 3, 5, 3},
+           TiffReaderOptions::Region{1, 0, 1, 1},
+       }) {
+    SCOPED_TRACE(::testing::Message() << region.x << "," << region.y << " "
+                                      << region.width << "x" << region.height);
+    ImageInfo region_info = info;
+    region_info.width = region.width;
+    region_info.height = region.height;
+    const size_t region_bytes = ImageRequiredBytes(region_info);
+    std::unique_ptr<unsigned char[]> decoded(new unsigned char[region_bytes]);
+    TiffReaderOptions options;
+    options.region = region;
+    ASSERT_THAT(
+        decoder.Decode(tensorstore::span(decoded.get(), region_bytes), options),
+        IsOk());
+    for (int32_t y = 0; y < region.height; ++y) {
+      const unsigned char* expected =
+          image.get() +
+          ((region.y + y) * info.width + region.x) * pixel_bytes;
+      ASSERT_EQ(0, std::memcmp(expected,
+                               decoded.get() + y * region.width * pixel_bytes,
+                               region.width * pixel_bytes))
+          << "row " << y;
+    }
+  }
+}
+
+TEST_F(TiffTest, DecodeRegionOutOfBounds) {
+  absl::Cord file_data = ReadTestFile("D75_08b.tiff");
+  riegeli::CordReader cord_reader(&file_data);
+  TiffReader decoder;
+  ASSERT_THAT(decoder.Initialize(&cord_reader), IsOk());
+  const ImageInfo info = decoder.GetImageInfo();
+
+  unsigned char pixels[3 * 4] = {};
+  TiffReaderOptions options;
+  options.region = TiffReaderOptions::Region{info.width - 1, 0, 2, 2};
+  EXPECT_THAT(decoder.Decode(pixels, options),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(TiffTest, GetTileLayout) {
+  {
+    absl::Cord file_data = ReadTestFile("D75_08b_tiled.tiff");
+    riegeli::CordReader cord_reader(&file_data);
+    TiffReader decoder;
+    ASSERT_THAT(decoder.Initialize(&cord_reader), IsOk());
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto layout, decoder.GetTileLayout());
+    EXPECT_TRUE(layout.tiled);
+    EXPECT_GT(layout.tile_width, 0);
+    EXPECT_GT(layout.tile_height, 0);
+  }
+  {
+    absl::Cord file_data = ReadTestFile("D75_08b_scanline.tiff");
+    riegeli::CordReader cord_reader(&file_data);
+    TiffReader decoder;
+    ASSERT_THAT(decoder.Initialize(&cord_reader), IsOk());
+    const ImageInfo info = decoder.GetImageInfo();
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto layout, decoder.GetTileLayout());
+    EXPECT_FALSE(layout.tiled);
+    EXPECT_EQ(info.width, layout.tile_width);
+    EXPECT_LE(layout.tile_height, info.height);
+  }
+}
+
+TEST_F(TiffTest, SeekFrameOffset) {
+  absl::Cord file_data = ReadTestFile("D75_08b_3page.tiff");
+  riegeli::CordReader cord_reader(&file_data);
+  TiffReader decoder;
+  ASSERT_THAT(decoder.Initialize(&cord_reader), IsOk());
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto offsets, decoder.GetFrameOffsets());
+  ASSERT_EQ(3, offsets.size());
+
+  const ImageInfo info = decoder.GetImageInfo();
+  const size_t image_bytes = ImageRequiredBytes(info);
+  std::unique_ptr<unsigned char[]> expected(new unsigned char[image_bytes]);
+  std::unique_ptr<unsigned char[]> actual(new unsigned char[image_bytes]);
+
+  // Visit the frames in reverse order, which would require walking the
+  // directory chain from the start for each frame with SeekFrame.
+  for (int i = 2; i >= 0; --i) {
+    ASSERT_THAT(decoder.SeekFrame(i), IsOk());
+    ASSERT_THAT(decoder.Decode(tensorstore::span(expected.get(), image_bytes)),
+                IsOk());
+    ASSERT_THAT(decoder.SeekFrameOffset(offsets[i]), IsOk());
+    EXPECT_EQ(info, decoder.GetImageInfo());
+    ASSERT_THAT(decoder.Decode(tensorstore::span(actual.get(), image_bytes)),
+                IsOk());
+    EXPECT_EQ(0, std::memcmp(expected.get(), actual.get(), image_bytes))
+        << "frame " << i;
+  }
+}
+
 TEST_F(TiffTest, CorruptData) {
   static constexpr unsigned char data[] = {
       0x49, 0x49, 0x2a, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0b, 0x00,
@@ -0,0 +1,89 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_OS_IO_URING_H_
+#define TENSORSTORE_INTERNAL_OS_IO_URING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "tensorstore/internal/os/file_descriptor.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_os {
+
+/// Asynchronous file I/O queue.
+///
+/// On Linux this is backed by an io_uring submission/completion ring pair
+/// that is serviced by a single completion thread; the number of outstanding
+/// operations is bounded only by the ring size, not by the number of threads.
+/// The ring is only used if the kernel supports the read, write and fsync
+/// operations (Linux 5.6 or later).
+///
+/// Operations are submitted from any thread.  When the ring is full,
+/// submissions are queued and issued as earlier operations complete.  The
+/// completion callback is invoked exactly once, on the completion thread, and
+/// must not block; callers should hand off any substantial work to an
+/// executor.
+///
+/// On other platforms, `GetIoUring` returns an `absl::UnimplementedError`.
+class IoUring {
+ public:
+  /// Invoked with the number of bytes transferred, or an error status.
+  using Callback = absl::AnyInvocable<void(Result<int64_t>) &&>;
+
+  virtual ~IoUring() = default;
+
+  /// Reads up to `size` bytes at `offset` from `fd` into `buffer`.
+  ///
+  /// The `fd` and `buffer` must remain valid until `callback` is invoked.
+  virtual void Read(FileDescriptor fd, void* buffer, size_t size,
+                    int64_t offset, Callback callback) = 0;
+
+  /// Writes up to `size` bytes from `buffer` to `fd` at `offset`.
+  ///
+  /// The `fd` and `buffer` must remain valid until `callback` is invoked.
+  virtual void Write(FileDescriptor fd, const void* buffer, size_t size,
+                     int64_t offset, Callback callback) = 0;
+
+  /// Flushes the data and metadata of `fd`, which may be a directory, to
+  /// stable storage, as by `fsync`.
+  ///
+  /// The `fd` must remain valid until `callback` is invoked.
+  virtual void Fsync(FileDescriptor fd, Callback callback) = 0;
+
+  /// Renames `old_path` to `new_path`, as by `rename`.
+  ///
+  /// If the kernel does not support asynchronous renames (before Linux 5.11),
+  /// the rename is performed on the calling thread before returning.
+  virtual void Rename(std::string old_path, std::string new_path,
+                      Callback callback) = 0;
+};
+
+/// Returns the process-wide `IoUring` instance, creating it on first use.
+///
+/// Returns an error if io_uring is not supported by the platform or kernel,
+/// or if creation is not permitted (e.g. by a seccomp filter).  The error is
+/// cached, so subsequent calls are inexpensive.
+Result<IoUring*> GetIoUring();
+
+}  // namespace internal_os
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_OS_IO_URING_H_
@@ -0,0 +1,387 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __linux__
+#error "Use io_uring_unsupported.cc instead."
+#endif
+
+#include "tensorstore/internal/os/io_uring.h"
+//
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/base/no_destructor.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/internal/os/error_code.h"
+#include "tensorstore/internal/os/file_descriptor.h"
+#include "tensorstore/internal/thread/thread.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_os {
+namespace {
+
+using ::tensorstore::internal::StatusFromOsError;
+
+ABSL_CONST_INIT internal_log::VerboseFlag io_uring_logging("io_uring");
+
+// Number of submission queue entries requested from the kernel.  The
+// completion queue is sized at twice this by default.
+constexpr unsigned kQueueDepth = 256;
+
+// Interval at which the completion thread retries submitting entries after
+// `io_uring_enter` failed with EAGAIN or EBUSY while nothing was in flight.
+constexpr absl::Duration kSubmitRetryInterval = absl::Milliseconds(1);
+
+int IoUringSetup(unsigned entries, io_uring_params* p) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+int IoUringEnter(int fd, unsigned to_submit, unsigned min_complete,
+                 unsigned flags) {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit,
+                                    min_complete, flags, nullptr, 0));
+}
+
+int IoUringRegister(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+struct Operation {
+  uint8_t opcode;
+  FileDescriptor fd;
+  const void* buffer;
+  size_t size;
+  int64_t offset;
+  IoUring::Callback callback;
+  // Paths for IORING_OP_RENAMEAT.
+  std::string old_path;
+  std::string new_path;
+};
+
+class LinuxIoUring : public IoUring {
+ public:
+  ~LinuxIoUring() override = default;
+
+  absl::Status Init() {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    int fd = IoUringSetup(kQueueDepth, &params);
+    if (fd < 0) {
+      return StatusFromOsError(errno).Format("io_uring_setup failed");
+    }
+    ring_fd_ = UniqueFileDescriptor(fd);
+    if (auto status = ProbeOpcodes(); !status.ok()) return status;
+    sq_entries_ = params.sq_entries;
+    cq_entries_ = params.cq_entries;
+
+    size_t sq_size = params.sq_off.array + params.sq_entries * sizeof(__u32);
+    size_t cq_size =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) sq_size = cq_size = std::max(sq_size, cq_size);
+
+    void* sq_ptr = ::mmap(nullptr, sq_size, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (sq_ptr == MAP_FAILED) {
+      return StatusFromOsError(errno).Format("io_uring mmap failed");
+    }
+    void* cq_ptr = sq_ptr;
+    if (!single_mmap) {
+      cq_ptr = ::mmap(nullptr, cq_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+      if (cq_ptr == MAP_FAILED) {
+        return StatusFromOsError(errno).Format("io_uring mmap failed");
+      }
+    }
+    void* sqes = ::mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe),
+                        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                        IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      return StatusFromOsError(errno).Format("io_uring mmap failed");
+    }
+
+    auto* sq = static_cast<char*>(sq_ptr);
+    sq_tail_ = reinterpret_cast<std::atomic<__u32>*>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<__u32*>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<__u32*>(sq + params.sq_off.array);
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    auto* cq = static_cast<char*>(cq_ptr);
+    cq_head_ = reinterpret_cast<std::atomic<__u32>*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<std::atomic<__u32>*>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<__u32*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    internal::Thread::StartDetached({"tensorstore_io_uring"},
+                                    [this] { CompletionLoop(); });
+    return absl::OkStatus();
+  }
+
+  void Read(FileDescriptor fd, void* buffer, size_t size, int64_t offset,
+            Callback callback) override {
+    Submit(std::unique_ptr<Operation>(new Operation{
+        IORING_OP_READ, fd, buffer, size, offset, std::move(callback)}));
+  }
+
+  void Write(FileDescriptor fd, const void* buffer, size_t size,
+             int64_t offset, Callback callback) override {
+    Submit(std::unique_ptr<Operation>(new Operation{
+        IORING_OP_WRITE, fd, buffer, size, offset, std::move(callback)}));
+  }
+
+  void Fsync(FileDescriptor fd, Callback callback) override {
+    Submit(std::unique_ptr<Operation>(new Operation{
+        IORING_OP_FSYNC, fd, nullptr, 0, 0, std::move(callback)}));
+  }
+
+  void Rename(std::string old_path, std::string new_path,
+              Callback callback) override {
+    if (!rename_supported_) {
+      Result<int64_t> result = 0;
+      if (::rename(old_path.c_str(), new_path.c_str()) != 0) {
+        result = StatusFromOsError(errno).Format("rename failed");
+      }
+      std::move(callback)(std::move(result));
+      return;
+    }
+    Submit(std::unique_ptr<Operation>(new Operation{
+        IORING_OP_RENAMEAT, AT_FDCWD, nullptr, 0, 0, std::move(callback),
+        std::move(old_path), std::move(new_path)}));
+  }
+
+ private:
+  // Checks that the kernel supports the operations used.  Kernels 5.1 to 5.5
+  // create rings, but fail IORING_OP_READ and IORING_OP_WRITE with EINVAL;
+  // they also do not support IORING_REGISTER_PROBE, which was added in 5.6.
+  absl::Status ProbeOpcodes() {
+    constexpr unsigned kNumProbeOps = 256;
+    auto storage = std::make_unique<char[]>(
+        sizeof(io_uring_probe) + kNumProbeOps * sizeof(io_uring_probe_op));
+    auto* probe = reinterpret_cast<io_uring_probe*>(storage.get());
+    if (IoUringRegister(ring_fd_.get(), IORING_REGISTER_PROBE, probe,
+                        kNumProbeOps) < 0) {
+      return absl::UnimplementedError(
+          "io_uring opcode probing is not supported by the kernel");
+    }
+    auto supported = [&](unsigned opcode) {
+      return opcode <= probe->last_op &&
+             (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED);
+    };
+    if (!supported(IORING_OP_READ) || !supported(IORING_OP_WRITE) ||
+        !supported(IORING_OP_FSYNC)) {
+      return absl::UnimplementedError(
+          "io_uring read, write or fsync is not supported by the kernel");
+    }
+    rename_supported_ = supported(IORING_OP_RENAMEAT);
+    return absl::OkStatus();
+  }
+
+  void Submit(std::unique_ptr<Operation> op) {
+    absl::MutexLock lock(&mutex_);
+    if (in_flight_ >= std::min(sq_entries_, cq_entries_)) {
+      // The kernel may drop completions if more operations are outstanding
+      // than the completion queue can hold; defer until some complete.
+      pending_.push_back(std::move(op));
+      return;
+    }
+    PushSqeLocked(std::move(op));
+    FlushLocked();
+  }
+
+  void PushSqeLocked(std::unique_ptr<Operation> op)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    const __u32 tail = sq_tail_->load(std::memory_order_relaxed);
+    const __u32 index = tail & sq_mask_;
+    io_uring_sqe* sqe = &sqes_[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = op->opcode;
+    sqe->fd = op->fd;
+    switch (op->opcode) {
+      case IORING_OP_READ:
+      case IORING_OP_WRITE:
+        sqe->addr = reinterpret_cast<uintptr_t>(op->buffer);
+        // A single transfer is limited to 2^31 bytes; short reads and writes
+        // are handled by the caller.
+        sqe->len = static_cast<__u32>(
+            std::min<size_t>(op->size, std::numeric_limits<int32_t>::max()));
+        sqe->off = static_cast<__u64>(op->offset);
+        break;
+      case IORING_OP_RENAMEAT:
+        sqe->addr = reinterpret_cast<uintptr_t>(op->old_path.c_str());
+        sqe->len = static_cast<__u32>(AT_FDCWD);
+        sqe->addr2 = reinterpret_cast<uintptr_t>(op->new_path.c_str());
+        break;
+      default:
+        break;
+    }
+    sqe->user_data = reinterpret_cast<uintptr_t>(op.release());
+    sq_array_[index] = index;
+    sq_tail_->store(tail + 1, std::memory_order_release);
+    ++in_flight_;
+    ++to_submit_;
+  }
+
+  void FlushLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    while (to_submit_ > 0) {
+      int n = IoUringEnter(ring_fd_.get(), to_submit_, 0, 0);
+      if (n < 0) {
+        if (errno == EINTR) continue;
+        // EAGAIN/EBUSY indicate transient resource shortage; the entries
+        // remain in the submission queue and are retried by the completion
+        // thread.
+        ABSL_LOG_IF(INFO, io_uring_logging)
+            << "io_uring_enter: "
+            << StatusFromOsError(errno).Format("submit failed");
+        return;
+      }
+      if (n == 0) return;
+      to_submit_ -= n;
+    }
+  }
+
+  // Returns `true` if there are operations which have not completed.
+  bool HasOperationsLocked() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return in_flight_ > 0;
+  }
+
+  // Returns `true` if the kernel has accepted operations which have not
+  // completed, so that waiting for a completion will not block indefinitely.
+  bool HasSubmittedLocked() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return in_flight_ > to_submit_;
+  }
+
+  // Blocks until at least one operation has been submitted to the kernel,
+  // retrying entries whose submission previously failed.
+  void AwaitSubmitted() {
+    absl::MutexLock lock(&mutex_);
+    while (true) {
+      FlushLocked();
+      if (HasSubmittedLocked()) return;
+      if (to_submit_ == 0) {
+        mutex_.Await(
+            absl::Condition(this, &LinuxIoUring::HasOperationsLocked));
+      } else {
+        mutex_.AwaitWithTimeout(
+            absl::Condition(this, &LinuxIoUring::HasSubmittedLocked),
+            kSubmitRetryInterval);
+      }
+    }
+  }
+
+  void CompletionLoop() {
+    std::vector<std::pair<std::unique_ptr<Operation>, int32_t>> completed;
+    while (true) {
+      AwaitSubmitted();
+      int n = IoUringEnter(ring_fd_.get(), 0, 1, IORING_ENTER_GETEVENTS);
+      if (n < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+        ABSL_LOG(FATAL) << StatusFromOsError(errno).Format(
+            "io_uring_enter failed waiting for completions");
+      }
+      __u32 head = cq_head_->load(std::memory_order_relaxed);
+      const __u32 tail = cq_tail_->load(std::memory_order_acquire);
+      for (; head != tail; ++head) {
+        const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+        completed.emplace_back(
+            reinterpret_cast<Operation*>(static_cast<uintptr_t>(cqe.user_data)),
+            cqe.res);
+      }
+      cq_head_->store(head, std::memory_order_release);
+      if (completed.empty()) continue;
+
+      {
+        absl::MutexLock lock(&mutex_);
+        in_flight_ -= completed.size();
+        while (!pending_.empty() &&
+               in_flight_ < std::min(sq_entries_, cq_entries_)) {
+          PushSqeLocked(std::move(pending_.front()));
+          pending_.pop_front();
+        }
+        FlushLocked();
+      }
+
+      for (auto& [op, res] : completed) {
+        Result<int64_t> result = res;
+        if (res < 0) {
+          result = StatusFromOsError(-res).Format("io_uring operation failed");
+        }
+        std::move(op->callback)(std::move(result));
+      }
+      completed.clear();
+    }
+  }
+
+  UniqueFileDescriptor ring_fd_;
+  bool rename_supported_ = false;
+  unsigned sq_entries_ = 0;
+  unsigned cq_entries_ = 0;
+
+  std::atomic<__u32>* sq_tail_ = nullptr;
+  __u32 sq_mask_ = 0;
+  __u32* sq_array_ = nullptr;
+  io_uring_sqe* sqes_ = nullptr;
+
+  std::atomic<__u32>* cq_head_ = nullptr;
+  std::atomic<__u32>* cq_tail_ = nullptr;
+  __u32 cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+
+  absl::Mutex mutex_;
+  size_t in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
+  unsigned to_submit_ ABSL_GUARDED_BY(mutex_) = 0;
+  std::deque<std::unique_ptr<Operation>> pending_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace
+
+Result<IoUring*> GetIoUring() {
+  // The ring and its completion thread live for the duration of the process.
+  static absl::NoDestructor<Result<IoUring*>> ring([]() -> Result<IoUring*> {
+    auto ring = std::make_unique<LinuxIoUring>();
+    if (auto status = ring->Init(); !status.ok()) {
+      ABSL_LOG_IF(INFO, io_uring_logging) << status;
+      return status;
+    }
+    return ring.release();
+  }());
+  return *ring;
+}
+
+}  // namespace internal_os
+}  // namespace tensorstore
@@ -0,0 +1,162 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/os/io_uring.h"
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/synchronization/notification.h"
+#include "tensorstore/internal/os/file_util.h"
+#include "tensorstore/internal/testing/scoped_directory.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::IsOk;
+using ::tensorstore::IsOkAndHolds;
+using ::tensorstore::Result;
+using ::tensorstore::internal_os::GetIoUring;
+using ::tensorstore::internal_os::OpenFileWrapper;
+using ::tensorstore::internal_os::OpenFlags;
+using ::tensorstore::internal_os::PReadFromFile;
+using ::tensorstore::internal_os::WriteToFile;
+using ::tensorstore::internal_testing::ScopedTemporaryDirectory;
+using ::testing::Not;
+
+// Runs `issue` with a callback and waits for its result.
+template <typename Issue>
+Result<int64_t> Await(Issue issue) {
+  absl::Notification done;
+  Result<int64_t> result;
+  issue([&](Result<int64_t> n) {
+    result = std::move(n);
+    done.Notify();
+  });
+  done.WaitForNotification();
+  return result;
+}
+
+TEST(IoUringTest, Read) {
+  auto ring = GetIoUring();
+  if (!ring.ok()) {
+    GTEST_SKIP() << "io_uring not available: " << ring.status();
+  }
+
+  ScopedTemporaryDirectory tempdir;
+  std::string path = tempdir.path() + "/data";
+  {
+    auto f = OpenFileWrapper(path, OpenFlags::DefaultWrite);
+    ASSERT_THAT(f, IsOk());
+    EXPECT_THAT(WriteToFile(f->get(), "0123456789", 10), IsOkAndHolds(10));
+  }
+
+  auto f = OpenFileWrapper(path, OpenFlags::DefaultRead);
+  ASSERT_THAT(f, IsOk());
+
+  // Issue many concurrent reads to exercise queueing beyond the ring size.
+  constexpr int kNumReads = 1000;
+  std::vector<char> buffers(kNumReads * 4);
+  std::vector<Result<int64_t>> results(kNumReads);
+  std::vector<absl::Notification> done(kNumReads);
+  for (int i = 0; i < kNumReads; ++i) {
+    (*ring)->Read(f->get(), &buffers[i * 4], 4, i % 7,
+                  [&, i](Result<int64_t> n) {
+                    results[i] = std::move(n);
+                    done[i].Notify();
+                  });
+  }
+  for (int i = 0; i < kNumReads; ++i) {
+    done[i].WaitForNotification();
+    EXPECT_THAT(results[i], IsOkAndHolds(4));
+    EXPECT_EQ(std::string(&buffers[i * 4], 4),
+              std::string("0123456789").substr(i % 7, 4));
+  }
+}
+
+TEST(IoUringTest, ReadInvalidFileDescriptor) {
+  auto ring = GetIoUring();
+  if (!ring.ok()) {
+    GTEST_SKIP() << "io_uring not available: " << ring.status();
+  }
+  char buffer[4];
+  absl::Notification done;
+  Result<int64_t> result;
+  (*ring)->Read(-1, buffer, sizeof(buffer), 0, [&](Result<int64_t> n) {
+    result = std::move(n);
+    done.Notify();
+  });
+  done.WaitForNotification();
+  EXPECT_THAT(result, Not(IsOk()));
+}
+
+TEST(IoUringTest, WriteFsyncRename) {
+  auto ring = GetIoUring();
+  if (!ring.ok()) {
+    GTEST_SKIP() << "io_uring not available: " << ring.status();
+  }
+
+  ScopedTemporaryDirectory tempdir;
+  std::string path = tempdir.path() + "/data";
+  std::string new_path = tempdir.path() + "/renamed";
+  {
+    auto f = OpenFileWrapper(path, OpenFlags::DefaultWrite);
+    ASSERT_THAT(f, IsOk());
+    EXPECT_THAT(Await([&](auto callback) {
+                  (*ring)->Write(f->get(), "abcd", 4, 0, std::move(callback));
+                }),
+                IsOkAndHolds(4));
+    EXPECT_THAT(Await([&](auto callback) {
+                  (*ring)->Write(f->get(), "ef", 2, 4, std::move(callback));
+                }),
+                IsOkAndHolds(2));
+    EXPECT_THAT(Await([&](auto callback) {
+                  (*ring)->Fsync(f->get(), std::move(callback));
+                }),
+                IsOk());
+  }
+  EXPECT_THAT(Await([&](auto callback) {
+                (*ring)->Rename(path, new_path, std::move(callback));
+              }),
+              IsOk());
+
+  auto f = OpenFileWrapper(new_path, OpenFlags::DefaultRead);
+  ASSERT_THAT(f, IsOk());
+  char buffer[8];
+  EXPECT_THAT(PReadFromFile(f->get(), buffer, 0), IsOkAndHolds(6));
+  EXPECT_EQ(std::string(buffer, 6), "abcdef");
+  EXPECT_THAT(OpenFileWrapper(path, OpenFlags::DefaultRead), Not(IsOk()));
+}
+
+TEST(IoUringTest, RenameMissingFile) {
+  auto ring = GetIoUring();
+  if (!ring.ok()) {
+    GTEST_SKIP() << "io_uring not available: " << ring.status();
+  }
+  ScopedTemporaryDirectory tempdir;
+  EXPECT_THAT(Await([&](auto callback) {
+                (*ring)->Rename(tempdir.path() + "/missing",
+                                tempdir.path() + "/other",
+                                std::move(callback));
+              }),
+              Not(IsOk()));
+}
+
+}  // namespace
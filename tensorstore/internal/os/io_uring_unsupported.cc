@@ -0,0 +1,33 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(__linux__)
+#error "Use io_uring_linux.cc instead."
+#endif
+
+#include "tensorstore/internal/os/io_uring.h"
+//
+
+#include "absl/status/status.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_os {
+
+Result<IoUring*> GetIoUring() {
+  return absl::UnimplementedError("io_uring is not supported on this platform");
+}
+
+}  // namespace internal_os
+}  // namespace tensorstore
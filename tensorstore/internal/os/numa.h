@@ -0,0 +1,42 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_OS_NUMA_H_
+#define TENSORSTORE_INTERNAL_OS_NUMA_H_
+
+#include <vector>
+
+#include "absl/status/status.h"
+
+namespace tensorstore {
+namespace internal_os {
+
+/// Returns the CPUs belonging to each online NUMA node, indexed by node.
+///
+/// The topology is read once and cached.  Returns an empty vector if the
+/// topology is unavailable, including on platforms other than Linux.
+const std::vector<std::vector<int>>& GetNumaNodeCpus();
+
+/// Returns the index into `GetNumaNodeCpus()` of the node of the CPU on
+/// which the calling thread is currently running, or `-1` if unknown.
+int GetCurrentNumaNode();
+
+/// Restricts the calling thread to run only on the CPUs of `node`, an index
+/// into `GetNumaNodeCpus()`.
+absl::Status SetCurrentThreadNumaNode(int node);
+
+}  // namespace internal_os
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_OS_NUMA_H_
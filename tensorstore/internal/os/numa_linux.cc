@@ -0,0 +1,150 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __linux__
+#error "Use numa_unsupported.cc instead."
+#endif
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "tensorstore/internal/os/numa.h"
+//
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/base/no_destructor.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/internal/os/error_code.h"
+#include "tensorstore/internal/os/file_util.h"
+
+namespace tensorstore {
+namespace internal_os {
+namespace {
+
+using ::tensorstore::internal::StatusFromOsError;
+
+ABSL_CONST_INIT internal_log::VerboseFlag numa_logging("numa");
+
+// Parses a kernel cpu/node list such as "0-3,8,10-11".  Returns false on a
+// malformed list.
+bool ParseList(std::string_view list, std::vector<int>& values) {
+  list = absl::StripAsciiWhitespace(list);
+  if (list.empty()) return true;
+  for (std::string_view range : absl::StrSplit(list, ',')) {
+    std::pair<std::string_view, std::string_view> bounds =
+        absl::StrSplit(range, absl::MaxSplits('-', 1));
+    int first, last;
+    if (!absl::SimpleAtoi(bounds.first, &first)) return false;
+    if (bounds.second.empty()) {
+      last = first;
+    } else if (!absl::SimpleAtoi(bounds.second, &last) || last < first) {
+      return false;
+    }
+    for (int i = first; i <= last; ++i) values.push_back(i);
+  }
+  return true;
+}
+
+struct NumaTopology {
+  std::vector<std::vector<int>> node_cpus;
+  // Maps each cpu to its index in `node_cpus`.
+  std::vector<int> cpu_node;
+};
+
+NumaTopology ReadNumaTopology() {
+  NumaTopology topology;
+  auto online = ReadAllToString("/sys/devices/system/node/online");
+  std::vector<int> nodes;
+  if (!online.ok() || !ParseList(*online, nodes)) {
+    ABSL_LOG_IF(INFO, numa_logging) << "NUMA topology unavailable";
+    return topology;
+  }
+  for (int node : nodes) {
+    auto cpulist = ReadAllToString(
+        absl::StrCat("/sys/devices/system/node/node", node, "/cpulist"));
+    std::vector<int> cpus;
+    if (!cpulist.ok() || !ParseList(*cpulist, cpus)) {
+      return NumaTopology{};
+    }
+    // Memory-only nodes have no cpus.
+    if (cpus.empty()) continue;
+    for (int cpu : cpus) {
+      if (cpu >= static_cast<int>(topology.cpu_node.size())) {
+        topology.cpu_node.resize(cpu + 1, -1);
+      }
+      topology.cpu_node[cpu] = static_cast<int>(topology.node_cpus.size());
+    }
+    topology.node_cpus.push_back(std::move(cpus));
+  }
+  ABSL_LOG_IF(INFO, numa_logging)
+      << "NUMA nodes with cpus: " << topology.node_cpus.size();
+  return topology;
+}
+
+const NumaTopology& GetNumaTopology() {
+  static absl::NoDestructor<NumaTopology> topology(ReadNumaTopology());
+  return *topology;
+}
+
+}  // namespace
+
+const std::vector<std::vector<int>>& GetNumaNodeCpus() {
+  return GetNumaTopology().node_cpus;
+}
+
+int GetCurrentNumaNode() {
+  const auto& topology = GetNumaTopology();
+  int cpu = ::sched_getcpu();
+  if (cpu < 0 || cpu >= static_cast<int>(topology.cpu_node.size())) {
+    return -1;
+  }
+  return topology.cpu_node[cpu];
+}
+
+absl::Status SetCurrentThreadNumaNode(int node) {
+  const auto& node_cpus = GetNumaTopology().node_cpus;
+  if (node < 0 || node >= static_cast<int>(node_cpus.size())) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Invalid NUMA node: ", node));
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu : node_cpus[node]) {
+    if (cpu < CPU_SETSIZE) CPU_SET(cpu, &cpu_set);
+  }
+  if (int error =
+          ::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set), &cpu_set);
+      error != 0) {
+    return StatusFromOsError(error).Format("pthread_setaffinity_np failed");
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace internal_os
+}  // namespace tensorstore
@@ -0,0 +1,57 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/os/numa.h"
+
+#include <thread>  // NOLINT
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::IsOk;
+using ::tensorstore::internal_os::GetCurrentNumaNode;
+using ::tensorstore::internal_os::GetNumaNodeCpus;
+using ::tensorstore::internal_os::SetCurrentThreadNumaNode;
+using ::testing::Not;
+
+TEST(NumaTest, Topology) {
+  const auto& node_cpus = GetNumaNodeCpus();
+  for (const auto& cpus : node_cpus) {
+    EXPECT_FALSE(cpus.empty());
+  }
+  EXPECT_LT(GetCurrentNumaNode(), static_cast<int>(node_cpus.size()));
+}
+
+TEST(NumaTest, SetCurrentThreadNumaNode) {
+  const auto& node_cpus = GetNumaNodeCpus();
+  if (node_cpus.empty()) {
+    GTEST_SKIP() << "NUMA topology unavailable";
+  }
+  const int node = static_cast<int>(node_cpus.size()) - 1;
+  // Use a separate thread to avoid restricting the test thread.
+  std::thread thread([&] {
+    TENSORSTORE_EXPECT_OK(SetCurrentThreadNumaNode(node));
+    EXPECT_EQ(node, GetCurrentNumaNode());
+  });
+  thread.join();
+}
+
+TEST(NumaTest, InvalidNode) {
+  EXPECT_THAT(SetCurrentThreadNumaNode(-1), Not(IsOk()));
+}
+
+}  // namespace
@@ -0,0 +1,42 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __linux__
+#error "Use numa_linux.cc instead."
+#endif
+
+#include "tensorstore/internal/os/numa.h"
+//
+
+#include <vector>
+
+#include "absl/base/no_destructor.h"
+#include "absl/status/status.h"
+
+namespace tensorstore {
+namespace internal_os {
+
+const std::vector<std::vector<int>>& GetNumaNodeCpus() {
+  static absl::NoDestructor<std::vector<std::vector<int>>> node_cpus;
+  return *node_cpus;
+}
+
+int GetCurrentNumaNode() { return -1; }
+
+absl::Status SetCurrentThreadNumaNode(int node) {
+  return absl::UnimplementedError("NUMA affinity is not supported");
+}
+
+}  // namespace internal_os
+}  // namespace tensorstore
@@ -0,0 +1,171 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/rate_limiter/adaptive_admission_queue.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <utility>
+
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/container/intrusive_linked_list.h"
+#include "tensorstore/internal/rate_limiter/rate_limiter.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+// Number of successful responses over which the baseline latency is computed.
+constexpr size_t kLatencyWindow = 256;
+
+// Returns the size class of a response of `bytes`: 0 below 64 KiB, and one
+// more for each factor of 4 above that, up to `num_size_classes - 1`.
+size_t GetSizeClass(size_t bytes, size_t num_size_classes) {
+  size_t size_class = 0;
+  for (size_t b = bytes >> 16; b != 0 && size_class + 1 < num_size_classes;
+       b >>= 2) {
+    ++size_class;
+  }
+  return size_class;
+}
+
+}  // namespace
+
+AdaptiveAdmissionQueue::AdaptiveAdmissionQueue(const Options& options)
+    : AdaptiveAdmissionQueue(options, [] { return absl::Now(); }) {}
+
+AdaptiveAdmissionQueue::AdaptiveAdmissionQueue(
+    const Options& options, std::function<absl::Time()> clock)
+    : options_(options), clock_(std::move(clock)) {
+  assert(options_.min_limit >= 1);
+  assert(options_.min_limit <= options_.max_limit);
+  internal::intrusive_linked_list::Initialize(RateLimiterNodeAccessor{},
+                                              &head_);
+  absl::MutexLock lock(&mutex_);
+  SetLimit(static_cast<double>(options_.initial_limit));
+}
+
+AdaptiveAdmissionQueue::~AdaptiveAdmissionQueue() {
+  absl::MutexLock l(&mutex_);
+  assert(head_.next_ == &head_);
+  if (options_.limit_gauge) {
+    options_.limit_gauge->Set(0, options_.limit_gauge_label);
+  }
+}
+
+size_t AdaptiveAdmissionQueue::limit() const {
+  absl::MutexLock l(&mutex_);
+  return limit_locked();
+}
+
+size_t AdaptiveAdmissionQueue::limit_locked() const {
+  return static_cast<size_t>(limit_);
+}
+
+void AdaptiveAdmissionQueue::SetLimit(double limit) {
+  limit_ = std::clamp(limit, static_cast<double>(options_.min_limit),
+                      static_cast<double>(options_.max_limit));
+  if (options_.limit_gauge) {
+    options_.limit_gauge->Set(static_cast<int64_t>(limit_),
+                              options_.limit_gauge_label);
+  }
+}
+
+void AdaptiveAdmissionQueue::Admit(RateLimiterNode* node,
+                                   RateLimiterNode::StartFn fn) {
+  assert(node->next_ == nullptr);
+  assert(node->prev_ == nullptr);
+  assert(node->start_fn_ == nullptr);
+  node->start_fn_ = fn;
+  node->trace_context_ = internal_tracing::TaskTraceContext(
+      internal_tracing::TraceContext::kThread);
+
+  {
+    absl::MutexLock lock(&mutex_);
+    if (in_flight_ + 1 > limit_locked()) {
+      internal::intrusive_linked_list::InsertBefore(RateLimiterNodeAccessor{},
+                                                    &head_, node);
+      return;
+    }
+    in_flight_++;
+  }
+
+  RunStartFunction(node);
+}
+
+void AdaptiveAdmissionQueue::Finish(RateLimiterNode* node) {
+  assert(node->next_ == nullptr);
+
+  absl::MutexLock lock(&mutex_);
+  in_flight_--;
+  AdmitQueued();
+}
+
+void AdaptiveAdmissionQueue::AdmitQueued() {
+  while (true) {
+    RateLimiterNode* next_node = head_.next_;
+    if (next_node == &head_) return;
+    if (in_flight_ + 1 > limit_locked()) return;
+    in_flight_++;
+    internal::intrusive_linked_list::Remove(RateLimiterNodeAccessor{},
+                                            next_node);
+
+    // Next node gets a chance to run after clearing admission queue state.
+    mutex_.unlock();
+    RunStartFunction(next_node);
+    mutex_.lock();
+  }
+}
+
+void AdaptiveAdmissionQueue::ObserveResponse(absl::Duration latency,
+                                             size_t bytes, bool throttled) {
+  const absl::Time now = clock_();
+  absl::MutexLock lock(&mutex_);
+  if (throttled) {
+    // Requests issued before the last decrease do not reflect it.
+    if (now - latency < last_decrease_) return;
+    last_decrease_ = now;
+    SetLimit(limit_ * options_.backoff_ratio);
+    return;
+  }
+
+  auto& stats = latency_baselines_[GetSizeClass(bytes, kNumSizeClasses)];
+  stats.window_min = std::min(stats.window_min, latency);
+  if (++stats.window_count >= kLatencyWindow) {
+    stats.baseline = stats.window_min;
+    stats.window_min = absl::InfiniteDuration();
+    stats.window_count = 0;
+  } else if (stats.baseline == absl::InfiniteDuration()) {
+    // Until the first window completes, use the current window.
+    stats.baseline = stats.window_min;
+  }
+
+  // Only increase the limit while it is being used; otherwise the limit
+  // would grow without bound while the load is below it.
+  if (2 * in_flight_ < limit_locked()) return;
+  if (latency > stats.baseline * options_.latency_tolerance) return;
+  const size_t old_limit = limit_locked();
+  SetLimit(limit_ + 1.0 / limit_);
+  if (limit_locked() > old_limit) AdmitQueued();
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,131 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_RATE_LIMITER_ADAPTIVE_ADMISSION_QUEUE_H_
+#define TENSORSTORE_INTERNAL_RATE_LIMITER_ADAPTIVE_ADMISSION_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/metrics/gauge.h"
+#include "tensorstore/internal/rate_limiter/rate_limiter.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// AdaptiveAdmissionQueue is an `AdmissionQueue` whose concurrency limit is
+/// adjusted from the responses reported via `ObserveResponse`, using additive
+/// increase / multiplicative decrease (AIMD):
+///
+/// - Each throttled response (e.g. HTTP 429 or 503) multiplies the limit by
+///   `backoff_ratio`.  Throttled responses to requests that were already in
+///   flight at the previous decrease are ignored, so that a single burst of
+///   throttling reduces the limit only once.
+///
+/// - Each successful response increases the limit by `1 / limit`, i.e. by
+///   about one per "round trip" of `limit` requests, provided that the limit
+///   is actually in use and the latency does not exceed `latency_tolerance`
+///   times the baseline (minimum recently observed) latency.  Increased
+///   latency indicates queueing, so the limit is held rather than increased.
+///   Since latency also grows with the number of bytes transferred, separate
+///   baselines are kept for responses of different size classes.
+class AdaptiveAdmissionQueue : public RateLimiter {
+ public:
+  struct Options {
+    /// Initial concurrency limit.
+    size_t initial_limit = 32;
+    /// Bounds on the concurrency limit.
+    size_t min_limit = 1;
+    size_t max_limit = 256;
+    /// Multiplicative decrease applied on throttling.
+    double backoff_ratio = 0.5;
+    /// Latency, relative to the baseline latency, above which the limit is
+    /// not increased.
+    double latency_tolerance = 2.0;
+    /// Optional gauge set to the current limit whenever it changes, and to 0
+    /// when the queue is destroyed.  Each queue sets the cell identified by
+    /// `limit_gauge_label`, which should be unique among the queues that
+    /// share the gauge.
+    internal_metrics::Gauge<int64_t, std::string>* limit_gauge = nullptr;
+    std::string limit_gauge_label;
+  };
+
+  explicit AdaptiveAdmissionQueue(const Options& options);
+
+  // Test constructor.
+  AdaptiveAdmissionQueue(const Options& options,
+                         std::function<absl::Time()> clock);
+
+  ~AdaptiveAdmissionQueue() override;
+
+  /// Returns the current concurrency limit.
+  size_t limit() const;
+
+  size_t in_flight() const {
+    absl::MutexLock l(&mutex_);
+    return in_flight_;
+  }
+
+  /// Admit a task node to the queue. Admit ensures that at most `limit()`
+  /// operations are running concurrently.
+  void Admit(RateLimiterNode* node, RateLimiterNode::StartFn fn) override;
+
+  /// Mark a task node for completion, admitting queued nodes if possible.
+  void Finish(RateLimiterNode* node) override;
+
+  /// Adjusts the limit based on the outcome of a request.
+  void ObserveResponse(absl::Duration latency, size_t bytes,
+                       bool throttled) override;
+
+ private:
+  size_t limit_locked() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void SetLimit(double limit) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  /// Admits queued nodes while below the limit; releases `mutex_` while
+  /// running start functions.
+  void AdmitQueued() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const Options options_;
+  const std::function<absl::Time()> clock_;
+
+  mutable absl::Mutex mutex_;
+  RateLimiterNode head_ ABSL_GUARDED_BY(mutex_);
+  size_t in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
+  double limit_ ABSL_GUARDED_BY(mutex_);
+  absl::Time last_decrease_ ABSL_GUARDED_BY(mutex_) = absl::InfinitePast();
+
+  // The baseline latency of a size class is the minimum latency over the
+  // previous window of `kLatencyWindow` successful responses in that class,
+  // or over the current window until the first window is complete.
+  struct LatencyBaseline {
+    absl::Duration baseline = absl::InfiniteDuration();
+    absl::Duration window_min = absl::InfiniteDuration();
+    size_t window_count = 0;
+  };
+
+  // Size classes are powers of 4, starting with responses below 64 KiB.
+  static constexpr size_t kNumSizeClasses = 6;
+  LatencyBaseline latency_baselines_[kNumSizeClasses] ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_RATE_LIMITER_ADAPTIVE_ADMISSION_QUEUE_H_
@@ -0,0 +1,239 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/rate_limiter/adaptive_admission_queue.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/metrics/gauge.h"
+#include "tensorstore/internal/rate_limiter/rate_limiter.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/util/executor.h"
+
+namespace {
+
+using ::tensorstore::ExecutorTask;
+using ::tensorstore::internal::AdaptiveAdmissionQueue;
+using ::tensorstore::internal::AtomicReferenceCount;
+using ::tensorstore::internal::IntrusivePtr;
+using ::tensorstore::internal::MakeIntrusivePtr;
+using ::tensorstore::internal::RateLimiter;
+using ::tensorstore::internal::RateLimiterNode;
+using ::tensorstore::internal_metrics::Gauge;
+using ::tensorstore::internal_tracing::ScopedTraceContext;
+using ::tensorstore::internal_tracing::TraceContext;
+
+/// This class holds a reference count on itself while held by a RateLimiter,
+/// and upon start will call the `task_` function.
+struct Task : public RateLimiterNode, public AtomicReferenceCount<Task> {
+  RateLimiter* rate_limiter_;
+  ExecutorTask task_;
+
+  Task(RateLimiter* rate_limiter, ExecutorTask task)
+      : rate_limiter_(rate_limiter), task_(std::move(task)) {}
+
+  ~Task() { rate_limiter_->Finish(this); }
+
+  void Admit() {
+    intrusive_ptr_increment(this);  // adopted by RateLimiterTask::Start.
+    rate_limiter_->Admit(this, &Task::Start);
+  }
+
+  static void Start(RateLimiterNode* task) {
+    IntrusivePtr<Task> self(static_cast<Task*>(task),
+                            tensorstore::internal::adopt_object_ref);
+    std::move(self->task_)();
+  }
+};
+
+/// Test fixture with a manually advanced clock.
+class AdaptiveAdmissionQueueTest : public ::testing::Test {
+ protected:
+  AdaptiveAdmissionQueue::Options options(size_t initial_limit) {
+    AdaptiveAdmissionQueue::Options options;
+    options.initial_limit = initial_limit;
+    options.min_limit = 2;
+    options.max_limit = 16;
+    options.limit_gauge = &gauge_;
+    options.limit_gauge_label = "q";
+    return options;
+  }
+
+  auto clock() {
+    return [this] { return now_; };
+  }
+
+  /// Admits `n` tasks which remain in flight until `tasks_` is cleared.
+  void AdmitHeld(RateLimiter& queue, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      auto task = MakeIntrusivePtr<Task>(&queue, [this] { started_++; });
+      task->Admit();
+      tasks_.push_back(std::move(task));
+    }
+  }
+
+  absl::Time now_ = absl::UnixEpoch();
+  Gauge<int64_t, std::string> gauge_;
+  std::atomic<size_t> started_{0};
+  std::vector<IntrusivePtr<Task>> tasks_;
+};
+
+TEST_F(AdaptiveAdmissionQueueTest, Basic) {
+  {
+    AdaptiveAdmissionQueue queue(options(4), clock());
+    EXPECT_EQ(4, queue.limit());
+    EXPECT_EQ(4, gauge_.Get("q"));
+
+    AdmitHeld(queue, 10);
+    EXPECT_EQ(4, started_);
+    EXPECT_EQ(4, queue.in_flight());
+    tasks_.clear();
+    EXPECT_EQ(10, started_);
+    EXPECT_EQ(0, queue.in_flight());
+  }
+  EXPECT_EQ(0, gauge_.Get("q"));
+}
+
+TEST_F(AdaptiveAdmissionQueueTest, QueuedTaskRunsInAdmittingTraceContext) {
+  AdaptiveAdmissionQueue queue(options(2), clock());
+  AdmitHeld(queue, 2);
+
+  TraceContext started_context(0, 0);
+  {
+    ScopedTraceContext trace_scope(TraceContext(1, 2));
+    auto task = MakeIntrusivePtr<Task>(&queue, [&] {
+      started_context = TraceContext(TraceContext::kThread);
+    });
+    task->Admit();
+  }
+  EXPECT_EQ(0, started_context.trace_id);
+
+  // The queued task is started by `Finish`, in the context of the thread that
+  // admitted it rather than the one that finished the held tasks.
+  {
+    ScopedTraceContext trace_scope(TraceContext(3, 4));
+    tasks_.clear();
+  }
+  EXPECT_EQ(1, started_context.trace_id);
+  EXPECT_EQ(2, started_context.span_id);
+}
+
+TEST_F(AdaptiveAdmissionQueueTest, ThrottleDecreasesLimitOnce) {
+  AdaptiveAdmissionQueue queue(options(16), clock());
+  now_ += absl::Seconds(10);
+  queue.ObserveResponse(absl::Seconds(1), /*bytes=*/0, /*throttled=*/true);
+  EXPECT_EQ(8, queue.limit());
+  EXPECT_EQ(8, gauge_.Get("q"));
+
+  // Requests issued before the decrease are ignored.
+  now_ += absl::Milliseconds(500);
+  queue.ObserveResponse(absl::Seconds(1), /*bytes=*/0, /*throttled=*/true);
+  EXPECT_EQ(8, queue.limit());
+
+  // Requests issued after the decrease apply.
+  now_ += absl::Seconds(1);
+  queue.ObserveResponse(absl::Seconds(1), /*bytes=*/0, /*throttled=*/true);
+  EXPECT_EQ(4, queue.limit());
+
+  // The limit does not decrease below min_limit.
+  for (int i = 0; i < 4; ++i) {
+    now_ += absl::Seconds(2);
+    queue.ObserveResponse(absl::Seconds(1), /*bytes=*/0, /*throttled=*/true);
+  }
+  EXPECT_EQ(2, queue.limit());
+  EXPECT_EQ(2, gauge_.Get("q"));
+}
+
+TEST_F(AdaptiveAdmissionQueueTest, SuccessIncreasesLimit) {
+  AdaptiveAdmissionQueue queue(options(4), clock());
+  AdmitHeld(queue, 20);
+  EXPECT_EQ(4, started_);
+
+  // About `limit` successful responses increase the limit by one, and
+  // admit a queued task.
+  for (int i = 0; i < 5; ++i) {
+    queue.ObserveResponse(absl::Milliseconds(10), /*bytes=*/0,
+                          /*throttled=*/false);
+  }
+  EXPECT_EQ(5, queue.limit());
+  EXPECT_EQ(5, started_);
+  EXPECT_EQ(5, gauge_.Get("q"));
+
+  // The limit does not increase above max_limit.
+  for (int i = 0; i < 1000; ++i) {
+    queue.ObserveResponse(absl::Milliseconds(10), /*bytes=*/0,
+                          /*throttled=*/false);
+  }
+  EXPECT_EQ(16, queue.limit());
+  EXPECT_EQ(16, started_);
+  tasks_.clear();
+}
+
+TEST_F(AdaptiveAdmissionQueueTest, HighLatencyHoldsLimit) {
+  AdaptiveAdmissionQueue queue(options(4), clock());
+  AdmitHeld(queue, 4);
+  queue.ObserveResponse(absl::Milliseconds(10), /*bytes=*/0,
+                        /*throttled=*/false);
+  for (int i = 0; i < 100; ++i) {
+    queue.ObserveResponse(absl::Milliseconds(100), /*bytes=*/0,
+                          /*throttled=*/false);
+  }
+  EXPECT_EQ(4, queue.limit());
+  tasks_.clear();
+}
+
+TEST_F(AdaptiveAdmissionQueueTest, SizeClassesHaveSeparateBaselines) {
+  AdaptiveAdmissionQueue queue(options(4), clock());
+  AdmitHeld(queue, 20);
+  queue.ObserveResponse(absl::Milliseconds(10), /*bytes=*/1024,
+                        /*throttled=*/false);
+  EXPECT_EQ(4, queue.limit());
+
+  // Large responses take longer without indicating queueing.
+  for (int i = 0; i < 5; ++i) {
+    queue.ObserveResponse(absl::Milliseconds(100), /*bytes=*/8 << 20,
+                          /*throttled=*/false);
+  }
+  EXPECT_EQ(5, queue.limit());
+
+  // Small responses are still compared to their own baseline.
+  for (int i = 0; i < 100; ++i) {
+    queue.ObserveResponse(absl::Milliseconds(100), /*bytes=*/1024,
+                          /*throttled=*/false);
+  }
+  EXPECT_EQ(5, queue.limit());
+  tasks_.clear();
+}
+
+TEST_F(AdaptiveAdmissionQueueTest, UnusedLimitHeld) {
+  AdaptiveAdmissionQueue queue(options(8), clock());
+  AdmitHeld(queue, 1);
+  for (int i = 0; i < 100; ++i) {
+    queue.ObserveResponse(absl::Milliseconds(10), /*bytes=*/0,
+                          /*throttled=*/false);
+  }
+  EXPECT_EQ(8, queue.limit());
+  tasks_.clear();
+}
+
+}  // namespace
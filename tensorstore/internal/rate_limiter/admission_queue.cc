@@ -22,6 +22,7 @@
 #include "absl/synchronization/mutex.h"
 #include "tensorstore/internal/container/intrusive_linked_list.h"
 #include "tensorstore/internal/rate_limiter/rate_limiter.h"
+#include "tensorstore/internal/tracing/trace_context.h"
 
 namespace tensorstore {
 namespace internal {
@@ -42,6 +43,8 @@ void AdmissionQueue::Admit(RateLimiterNode* node, RateLimiterNode::StartFn fn) {
   assert(node->prev_ == nullptr);
   assert(node->start_fn_ == nullptr);
   node->start_fn_ = fn;
+  node->trace_context_ = internal_tracing::TaskTraceContext(
+      internal_tracing::TraceContext::kThread);
 
   {
     absl::MutexLock lock(mutex_);
@@ -16,6 +16,8 @@
 
 #include <cassert>
 
+#include "tensorstore/internal/tracing/trace_context.h"
+
 namespace tensorstore {
 namespace internal {
 
@@ -26,7 +28,11 @@ void RateLimiter::RunStartFunction(RateLimiterNode* node) {
   node->next_ = nullptr;
   node->prev_ = nullptr;
   node->start_fn_ = nullptr;
+  // `fn` may destroy `node`, so its context is installed from a copy.
+  internal_tracing::TaskTraceContext trace_context = node->trace_context_;
+  internal_tracing::SwapCurrentTraceContext(&trace_context);
   fn(node);
+  internal_tracing::SwapCurrentTraceContext(&trace_context);
 }
 
 void NoRateLimiter::Admit(RateLimiterNode* node, RateLimiterNode::StartFn fn) {
@@ -34,6 +40,8 @@ void NoRateLimiter::Admit(RateLimiterNode* node, RateLimiterNode::StartFn fn) {
   assert(node->prev_ == nullptr);
   assert(node->start_fn_ == nullptr);
   node->start_fn_ = fn;
+  node->trace_context_ = internal_tracing::TaskTraceContext(
+      internal_tracing::TraceContext::kThread);
   RunStartFunction(node);
 }
 
@@ -15,7 +15,12 @@
 #ifndef TENSORSTORE_INTERNAL_RATE_LIMITER_RATE_LIMITER_H_
 #define TENSORSTORE_INTERNAL_RATE_LIMITER_RATE_LIMITER_H_
 
+#include <stddef.h>
+
+#include "absl/base/attributes.h"
+#include "absl/time/time.h"
 #include "tensorstore/internal/container/intrusive_linked_list.h"
+#include "tensorstore/internal/tracing/trace_context.h"
 
 namespace tensorstore {
 namespace internal {
@@ -33,6 +38,11 @@ struct RateLimiterNode {
   RateLimiterNode* next_ = nullptr;
   RateLimiterNode* prev_ = nullptr;
   StartFn start_fn_ = nullptr;
+
+  // Trace context of the thread that called `Admit`, which is installed while
+  // the start function runs, possibly on another thread.
+  ABSL_ATTRIBUTE_NO_UNIQUE_ADDRESS internal_tracing::TaskTraceContext
+      trace_context_{0, 0};
 };
 
 using RateLimiterNodeAccessor = internal::intrusive_linked_list::MemberAccessor<
@@ -50,6 +60,17 @@ class RateLimiter {
   /// Cleanup a task from the rate limiter.
   virtual void Finish(RateLimiterNode* node) = 0;
 
+  /// Reports the outcome of a single request issued by an admitted task.
+  /// Adaptive rate limiters use this to adjust their limits; the default
+  /// implementation ignores it.
+  ///
+  /// \param latency Time from issuing the request to receiving the response.
+  /// \param bytes Number of payload bytes sent and received by the request.
+  /// \param throttled Whether the server indicated that it is overloaded, for
+  ///     example with an HTTP 429 or 503 response.
+  virtual void ObserveResponse(absl::Duration latency, size_t bytes,
+                               bool throttled) {}
+
  protected:
   static void RunStartFunction(RateLimiterNode* node);
 };
@@ -28,6 +28,7 @@
 #include "tensorstore/internal/log/verbose_flag.h"
 #include "tensorstore/internal/rate_limiter/rate_limiter.h"
 #include "tensorstore/internal/thread/schedule_at.h"
+#include "tensorstore/internal/tracing/trace_context.h"
 
 using ::tensorstore::internal::intrusive_linked_list::OnlyContainsNode;
 
@@ -75,6 +76,8 @@ void TokenBucketRateLimiter::Admit(RateLimiterNode* node,
   assert(node->prev_ == nullptr);
   assert(node->start_fn_ == nullptr);
   node->start_fn_ = fn;
+  node->trace_context_ = internal_tracing::TaskTraceContext(
+      internal_tracing::TraceContext::kThread);
 
   // Admit to the queue.
   {
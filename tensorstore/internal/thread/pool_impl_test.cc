@@ -39,7 +39,7 @@ using ::tensorstore::internal::MakeIntrusivePtr;
 using ::tensorstore::internal_thread_impl::InFlightTask;
 using ::tensorstore::internal_thread_impl::SharedThreadPool;
 using ::tensorstore::internal_thread_impl::TaskProvider;
-using TC = ::tensorstore::internal_tracing::TraceContext;
+using TC = ::tensorstore::internal_tracing::TaskTraceContext;
 
 struct SingleTaskProvider : public TaskProvider {
   struct private_t {};
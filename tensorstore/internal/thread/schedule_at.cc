@@ -93,7 +93,8 @@ struct DeadlineTaskNode : public DeadlineTaskTree::NodeBase {
 
   absl::Time deadline;
   ScheduleAtTask task;
-  ABSL_ATTRIBUTE_NO_UNIQUE_ADDRESS internal_tracing::TraceContext trace_context;
+  ABSL_ATTRIBUTE_NO_UNIQUE_ADDRESS internal_tracing::TaskTraceContext
+      trace_context;
 
   // The raw `DeadlineTaskQueue` pointer is non-null once the task has been
   // added to the tree.  The tag bit is 1 if cancellation of the task has been
@@ -250,8 +251,9 @@ void DeadlineTaskQueue::Run() {
 
     // Execute functions without lock
 
-    internal_tracing::TraceContext base =
-        internal_tracing::TraceContext(internal_tracing::TraceContext::kThread);
+    internal_tracing::TaskTraceContext base =
+        internal_tracing::TaskTraceContext(
+            internal_tracing::TraceContext::kThread);
 
     // First run any tasks in `run_immediately` list.
     while (run_immediately) {
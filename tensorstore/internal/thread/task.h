@@ -30,7 +30,7 @@ namespace internal_thread_impl {
 /// An in-flight task. Implementation detail of thread_pool.
 struct InFlightTask {
   InFlightTask(absl::AnyInvocable<void() &&> callback,
-               internal_tracing::TraceContext tc)
+               internal_tracing::TaskTraceContext tc)
       : callback_(std::move(callback)),
         tc_(std::move(tc)),
         start_nanos(absl::GetCurrentTimeNanos()) {}
@@ -43,7 +43,7 @@ struct InFlightTask {
   }
 
   absl::AnyInvocable<void() &&> callback_;
-  ABSL_ATTRIBUTE_NO_UNIQUE_ADDRESS internal_tracing::TraceContext tc_;
+  ABSL_ATTRIBUTE_NO_UNIQUE_ADDRESS internal_tracing::TaskTraceContext tc_;
   int64_t start_nanos;
 };
 
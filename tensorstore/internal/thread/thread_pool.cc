@@ -28,6 +28,7 @@
 #include "tensorstore/internal/thread/pool_impl.h"
 #include "tensorstore/internal/thread/task.h"
 #include "tensorstore/internal/thread/task_group_impl.h"
+#include "tensorstore/internal/thread/work_stealing_pool.h"
 #include "tensorstore/internal/tracing/trace_context.h"
 #include "tensorstore/util/executor.h"
 
@@ -38,27 +39,57 @@ namespace {
 struct DetachedPoolImpl {
   internal::IntrusivePtr<internal_thread_impl::TaskGroup> task_group;
 
-  void operator()(ExecutorTask task, internal_tracing::TraceContext tc) const {
+  void operator()(ExecutorTask task,
+                  internal_tracing::TaskTraceContext tc) const {
     task_group->AddTask(std::make_unique<internal_thread_impl::InFlightTask>(
         std::move(task), std::move(tc)));
   }
   void operator()(ExecutorTask task) const {
-    operator()(std::move(task), internal_tracing::TraceContext(
+    operator()(std::move(task), internal_tracing::TaskTraceContext(
                                     internal_tracing::TraceContext::kThread));
   }
 };
 
-Executor DefaultThreadPool(size_t num_threads) {
-  static absl::NoDestructor<internal_thread_impl::SharedThreadPool> pool_;
-  intrusive_ptr_increment(pool_.get());
+// Shuts down the pool once the last executor referencing it is destroyed.
+struct WorkStealingPoolHandle
+    : public internal::AtomicReferenceCount<WorkStealingPoolHandle> {
+  explicit WorkStealingPoolHandle(size_t num_threads)
+      : pool(internal::MakeIntrusivePtr<internal_thread_impl::WorkStealingPool>(
+            num_threads)) {}
+  ~WorkStealingPoolHandle() { pool->Shutdown(); }
+
+  internal::IntrusivePtr<internal_thread_impl::WorkStealingPool> pool;
+};
+
+struct WorkStealingPoolImpl {
+  internal::IntrusivePtr<WorkStealingPoolHandle> handle;
+
+  void operator()(ExecutorTask task,
+                  internal_tracing::TaskTraceContext tc) const {
+    handle->pool->AddTask(std::make_unique<internal_thread_impl::InFlightTask>(
+        std::move(task), std::move(tc)));
+  }
+  void operator()(ExecutorTask task) const {
+    operator()(std::move(task), internal_tracing::TaskTraceContext(
+                                    internal_tracing::TraceContext::kThread));
+  }
+};
+
+size_t BoundNumThreads(size_t num_threads) {
   if (num_threads == 0 || num_threads == std::numeric_limits<size_t>::max()) {
     // Threads are "unbounded"; that doesn't work so well, so put a bound on it.
     num_threads = std::thread::hardware_concurrency() * 16;
     if (num_threads == 0) num_threads = 1024;
     ABSL_LOG_FIRST_N(INFO, 1)
-        << "DetachedThreadPool should specify num_threads; using "
-        << num_threads;
+        << "Thread pool should specify num_threads; using " << num_threads;
   }
+  return num_threads;
+}
+
+Executor DefaultThreadPool(size_t num_threads) {
+  static absl::NoDestructor<internal_thread_impl::SharedThreadPool> pool_;
+  intrusive_ptr_increment(pool_.get());
+  num_threads = BoundNumThreads(num_threads);
 
   return DetachedPoolImpl{internal_thread_impl::TaskGroup::Make(
       internal::IntrusivePtr<internal_thread_impl::SharedThreadPool>(
@@ -72,5 +103,11 @@ Executor DetachedThreadPool(size_t num_threads) {
   return DefaultThreadPool(num_threads);
 }
 
+Executor WorkStealingThreadPool(size_t num_threads) {
+  return WorkStealingPoolImpl{
+      internal::MakeIntrusivePtr<WorkStealingPoolHandle>(
+          BoundNumThreads(num_threads))};
+}
+
 }  // namespace internal
 }  // namespace tensorstore
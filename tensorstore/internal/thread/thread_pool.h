@@ -30,6 +30,20 @@ namespace internal {
 /// \param num_threads Maximum number of threads to use.
 Executor DetachedThreadPool(size_t num_threads);
 
+/// Returns a detached work-stealing thread pool executor.
+///
+/// Unlike `DetachedThreadPool`, whose threads are shared by all pools and
+/// which queues tasks under a per-pool mutex, the returned executor owns up
+/// to `num_threads` worker threads, each with its own task queue; idle workers
+/// steal tasks from busy ones.  This is better suited to large numbers of
+/// fine-grained tasks.
+///
+/// The thread pool remains alive until the last copy of the returned executor
+/// is destroyed and all queued work has finished.
+///
+/// \param num_threads Maximum number of threads to use.
+Executor WorkStealingThreadPool(size_t num_threads);
+
 }  // namespace internal
 }  // namespace tensorstore
 
@@ -0,0 +1,376 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/thread/work_stealing_pool.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <utility>
+
+#include "absl/base/attributes.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/container/circular_queue.h"
+#include "tensorstore/internal/container/single_producer_queue.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/internal/metrics/gauge.h"
+#include "tensorstore/internal/metrics/metadata.h"
+#include "tensorstore/internal/metrics/registration.h"
+#include "tensorstore/internal/os/fork_detection.h"
+#include "tensorstore/internal/os/numa.h"
+#include "tensorstore/internal/thread/task.h"
+#include "tensorstore/internal/thread/thread.h"
+
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    work_stealing_pool_started, Counter<int64_t>,
+    MetricMetadata("/tensorstore/thread_pool/work_stealing/started",
+                   "Threads started by WorkStealingPool"));
+
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    work_stealing_pool_active, Gauge<int64_t>,
+    MetricMetadata("/tensorstore/thread_pool/work_stealing/active",
+                   "Active threads managed by WorkStealingPool"));
+
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    work_stealing_pool_steal_count, Counter<int64_t>,
+    MetricMetadata("/tensorstore/thread_pool/work_stealing/steal_count",
+                   "Tasks stolen from another WorkStealingPool worker"));
+
+namespace tensorstore {
+namespace internal_thread_impl {
+namespace {
+
+constexpr absl::Duration kThreadIdleBeforeExit = absl::Seconds(20);
+
+// Capacity of each worker's lock-free local queue.  When full, tasks added by
+// the worker overflow to its inbox.
+constexpr int64_t kLocalQueueSize = 256;
+
+// Maximum number of tasks moved from the inbox to the local queue at once,
+// which allows subsequent tasks to be dequeued or stolen without locking.
+constexpr size_t kInboxBatchSize = 16;
+
+ABSL_CONST_INIT internal_log::VerboseFlag thread_pool_logging("thread_pool");
+
+using LocalTaskQueue =
+    internal_container::SingleProducerQueue<InFlightTask*, false>;
+
+}  // namespace
+
+struct ABSL_CACHELINE_ALIGNED WorkStealingPool::Worker {
+  // Tasks added by the worker thread itself.  Only the worker thread pushes
+  // and pops; other workers steal from the opposite end.
+  LocalTaskQueue local{kLocalQueueSize};
+
+  // Size of `inbox`, readable without holding `mutex`.
+  std::atomic<size_t> inbox_size{0};
+
+  // Indicates that the worker is (likely) parked; used to avoid locking every
+  // worker when looking for one to wake.
+  std::atomic<bool> maybe_idle{false};
+
+  absl::Mutex mutex;
+  // Tasks added by threads other than the worker thread.
+  internal_container::CircularQueue<std::unique_ptr<InFlightTask>> inbox
+      ABSL_GUARDED_BY(mutex){64};
+  absl::CondVar wakeup;
+
+  // Indicates that a thread is assigned to this worker.  A worker never exits
+  // while its inbox is non-empty, so every queued task has a running owner.
+  bool running ABSL_GUARDED_BY(mutex) = false;
+  bool idle ABSL_GUARDED_BY(mutex) = false;
+  bool notified ABSL_GUARDED_BY(mutex) = false;
+
+  // NUMA node to which the worker thread is restricted, or -1.
+  int numa_node = -1;
+
+  // Position at which the next steal attempt starts.  Accessed only by the
+  // worker thread.
+  size_t steal_index = 0;
+};
+
+namespace {
+
+// Identifies the pool and worker of the current thread, if it is a worker
+// thread.
+thread_local WorkStealingPool* current_pool = nullptr;
+thread_local void* current_worker = nullptr;
+
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(size_t num_threads)
+    : num_workers_(std::max<size_t>(1, num_threads)),
+      workers_(new Worker[num_workers_]) {
+  const size_t num_nodes = internal_os::GetNumaNodeCpus().size();
+  for (size_t i = 0; i < num_workers_; ++i) {
+    auto& worker = workers_[i];
+    if (num_nodes > 1) worker.numa_node = static_cast<int>(i % num_nodes);
+    worker.steal_index = i + 1;
+  }
+  ABSL_LOG_IF(INFO, thread_pool_logging)
+      << "WorkStealingPool: " << this << " with " << num_workers_
+      << " workers on " << num_nodes << " NUMA nodes";
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  assert(num_running_.load(std::memory_order_relaxed) == 0);
+  assert(!HasQueuedTasks());
+}
+
+void WorkStealingPool::AddTask(std::unique_ptr<InFlightTask> task) {
+  if (current_pool == this) {
+    auto& worker = *static_cast<Worker*>(current_worker);
+    if (worker.local.push(task.get())) {
+      task.release();
+    } else {
+      // The local queue is full; overflow to the inbox.  The worker is
+      // running, so there is no need to start it.
+      absl::MutexLock lock(worker.mutex);
+      worker.inbox.push_back(std::move(task));
+      worker.inbox_size.store(worker.inbox.size(), std::memory_order_relaxed);
+    }
+    WakeWorker(nullptr);
+    return;
+  }
+
+  // This is not from a worker thread, so do fork detection.
+  internal_os::AbortIfForkDetected();
+
+  Worker& worker = SelectWorker();
+  bool start = false;
+  {
+    absl::MutexLock lock(worker.mutex);
+    worker.inbox.push_back(std::move(task));
+    worker.inbox_size.store(worker.inbox.size(), std::memory_order_relaxed);
+    if (!worker.running) {
+      worker.running = true;
+      start = true;
+    } else if (worker.idle) {
+      if (!worker.notified) {
+        worker.notified = true;
+        worker.wakeup.Signal();
+      }
+      return;
+    }
+  }
+  if (start) {
+    StartWorker(worker);
+  } else {
+    // The selected worker is busy; wake another worker to steal the task.
+    WakeWorker(&worker);
+  }
+}
+
+WorkStealingPool::Worker& WorkStealingPool::SelectWorker() {
+  const size_t n = next_worker_.fetch_add(1, std::memory_order_relaxed);
+  const size_t num_nodes = internal_os::GetNumaNodeCpus().size();
+  if (num_nodes <= 1 || num_workers_ < num_nodes) {
+    return workers_[n % num_workers_];
+  }
+  // Workers are assigned to nodes round-robin; select among those on the
+  // node of the current cpu.
+  const int node = internal_os::GetCurrentNumaNode();
+  if (node < 0) return workers_[n % num_workers_];
+  const size_t workers_on_node =
+      (num_workers_ - node + num_nodes - 1) / num_nodes;
+  return workers_[node + (n % workers_on_node) * num_nodes];
+}
+
+void WorkStealingPool::StartWorker(Worker& worker) {
+  num_running_.fetch_add(1, std::memory_order_relaxed);
+  work_stealing_pool_started.Increment();
+  internal::Thread::StartDetached(
+      {"ts_pool_ws_worker"},
+      [self = internal::IntrusivePtr<WorkStealingPool>(this), &worker] {
+        self->RunWorker(worker);
+      });
+}
+
+void WorkStealingPool::WakeWorker(Worker* preferred) {
+  // Pairs with the fence in `Park`: either the parking worker observes the
+  // newly queued task, or this thread observes the parked worker.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_idle_.load(std::memory_order_acquire) == 0) {
+    if (num_running_.load(std::memory_order_relaxed) >= num_workers_) return;
+    // All running workers are busy; start another one.
+    const size_t start = next_worker_.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i < num_workers_; ++i) {
+      Worker& worker = workers_[(start + i) % num_workers_];
+      {
+        absl::MutexLock lock(worker.mutex);
+        if (worker.running) continue;
+        worker.running = true;
+      }
+      StartWorker(worker);
+      return;
+    }
+    return;
+  }
+  const size_t start =
+      preferred ? (preferred - workers_.get()) + 1
+                : next_worker_.fetch_add(1, std::memory_order_relaxed);
+  for (size_t i = 0; i < num_workers_; ++i) {
+    Worker& worker = workers_[(start + i) % num_workers_];
+    if (!worker.maybe_idle.load(std::memory_order_relaxed)) continue;
+    absl::MutexLock lock(worker.mutex);
+    if (worker.idle && !worker.notified) {
+      worker.notified = true;
+      worker.wakeup.Signal();
+      return;
+    }
+  }
+}
+
+void WorkStealingPool::Shutdown() {
+  shutdown_.store(true, std::memory_order_seq_cst);
+  for (size_t i = 0; i < num_workers_; ++i) {
+    Worker& worker = workers_[i];
+    absl::MutexLock lock(worker.mutex);
+    if (worker.idle) worker.wakeup.Signal();
+  }
+}
+
+void WorkStealingPool::RunWorker(Worker& worker) {
+  assert(current_pool == nullptr);
+  current_pool = this;
+  current_worker = &worker;
+  work_stealing_pool_active.Increment();
+  if (worker.numa_node >= 0) {
+    if (auto status = internal_os::SetCurrentThreadNumaNode(worker.numa_node);
+        !status.ok()) {
+      ABSL_LOG_IF(INFO, thread_pool_logging) << status;
+    }
+  }
+  do {
+    while (auto task = AcquireTask(worker)) {
+      task->Run();
+    }
+  } while (Park(worker));
+  work_stealing_pool_active.Decrement();
+  current_pool = nullptr;
+  current_worker = nullptr;
+}
+
+std::unique_ptr<InFlightTask> WorkStealingPool::AcquireTask(Worker& worker) {
+  // First, attempt to acquire a task from the local queue.
+  if (auto* t = worker.local.try_pop(); t != nullptr) {
+    return std::unique_ptr<InFlightTask>(t);
+  }
+
+  // Second, attempt to acquire a task from the inbox.
+  if (worker.inbox_size.load(std::memory_order_relaxed) != 0) {
+    absl::MutexLock lock(worker.mutex);
+    if (!worker.inbox.empty()) {
+      auto task = std::move(worker.inbox.front());
+      worker.inbox.pop_front();
+      for (size_t n = std::min(kInboxBatchSize, worker.inbox.size()); n > 0;
+           --n) {
+        if (!worker.local.push(worker.inbox.front().get())) break;
+        worker.inbox.front().release();
+        worker.inbox.pop_front();
+      }
+      worker.inbox_size.store(worker.inbox.size(), std::memory_order_relaxed);
+      return task;
+    }
+  }
+
+  // Third, steal from other workers.
+  return StealTask(worker);
+}
+
+std::unique_ptr<InFlightTask> WorkStealingPool::StealTask(Worker& worker) {
+  if (num_workers_ == 1) return nullptr;
+  const size_t start = worker.steal_index++;
+  // Prefer workers on the same NUMA node, as their tasks likely reference
+  // memory local to this node.
+  for (const bool same_node : {true, false}) {
+    for (size_t i = 0; i < num_workers_; ++i) {
+      Worker& victim = workers_[(start + i) % num_workers_];
+      if (&victim == &worker ||
+          (victim.numa_node == worker.numa_node) != same_node) {
+        continue;
+      }
+      if (auto* t = victim.local.try_steal(); t != nullptr) {
+        work_stealing_pool_steal_count.Increment();
+        return std::unique_ptr<InFlightTask>(t);
+      }
+      if (victim.inbox_size.load(std::memory_order_relaxed) == 0) continue;
+      absl::MutexLock lock(victim.mutex);
+      if (victim.inbox.empty()) continue;
+      auto task = std::move(victim.inbox.front());
+      victim.inbox.pop_front();
+      victim.inbox_size.store(victim.inbox.size(), std::memory_order_relaxed);
+      work_stealing_pool_steal_count.Increment();
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+bool WorkStealingPool::HasQueuedTasks() const {
+  for (size_t i = 0; i < num_workers_; ++i) {
+    const Worker& worker = workers_[i];
+    if (!worker.local.empty() ||
+        worker.inbox_size.load(std::memory_order_relaxed) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WorkStealingPool::Park(Worker& worker) {
+  absl::MutexLock lock(worker.mutex);
+  worker.idle = true;
+  worker.maybe_idle.store(true, std::memory_order_relaxed);
+  num_idle_.fetch_add(1, std::memory_order_release);
+  const absl::Time deadline = absl::Now() + kThreadIdleBeforeExit;
+  bool exit = false;
+  while (!worker.notified && worker.inbox.empty()) {
+    // Pairs with the fence in `WakeWorker`.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (HasQueuedTasks()) break;
+    if (shutdown_.load(std::memory_order_relaxed)) {
+      exit = true;
+      break;
+    }
+    if (worker.wakeup.WaitWithDeadline(&worker.mutex, deadline)) {
+      // Timed out.
+      exit = !worker.notified && worker.inbox.empty();
+      break;
+    }
+  }
+  worker.notified = false;
+  worker.idle = false;
+  worker.maybe_idle.store(false, std::memory_order_relaxed);
+  num_idle_.fetch_sub(1, std::memory_order_relaxed);
+  if (exit) {
+    worker.running = false;
+    num_running_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  return !exit;
+}
+
+}  // namespace internal_thread_impl
+}  // namespace tensorstore
@@ -0,0 +1,96 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_THREAD_WORK_STEALING_POOL_H_
+#define TENSORSTORE_INTERNAL_THREAD_WORK_STEALING_POOL_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/thread/task.h"
+
+namespace tensorstore {
+namespace internal_thread_impl {
+
+/// Thread pool with a fixed number of worker slots, each of which owns its
+/// task queues, so that enqueuing and dequeuing tasks does not contend on a
+/// pool-wide mutex.
+///
+/// Each worker has a lock-free local queue, to which tasks submitted from
+/// that worker are added, and a mutex-protected inbox for tasks submitted
+/// from other threads; external submissions are spread over the inboxes,
+/// preferring workers on the NUMA node of the submitting thread.  A worker
+/// without work steals from the other workers, trying those on its own NUMA
+/// node first.  When the system has more than one NUMA node, each worker is
+/// restricted to the cpus of a single node.
+///
+/// Worker threads are started on demand, up to the number of slots, and exit
+/// after being idle for a while, or as soon as they are idle once `Shutdown`
+/// has been called.
+class WorkStealingPool
+    : public internal::AtomicReferenceCount<WorkStealingPool> {
+ public:
+  explicit WorkStealingPool(size_t num_threads);
+  ~WorkStealingPool();
+
+  /// Enqueues a task.
+  ///
+  /// Thread safety: safe to call concurrently from multiple threads.
+  void AddTask(std::unique_ptr<InFlightTask> task);
+
+  /// Indicates that no further tasks will be added except by tasks that are
+  /// already queued or running.  Idle worker threads exit promptly once all
+  /// queues are empty.
+  void Shutdown();
+
+ private:
+  struct Worker;
+
+  void StartWorker(Worker& worker);
+  void RunWorker(Worker& worker);
+
+  // Returns a task from `worker`'s queues or stolen from another worker.
+  std::unique_ptr<InFlightTask> AcquireTask(Worker& worker);
+  std::unique_ptr<InFlightTask> StealTask(Worker& worker);
+
+  // Returns `true` if any worker has a queued task.
+  bool HasQueuedTasks() const;
+
+  // Blocks until `worker` is woken or times out.  Returns `false` if the
+  // worker thread should exit.
+  bool Park(Worker& worker);
+
+  // Wakes an idle worker, or starts a new worker, to help with newly queued
+  // tasks.
+  void WakeWorker(Worker* preferred);
+
+  // Returns the worker to which a task submitted from the current thread
+  // (which is not a worker of this pool) should be assigned.
+  Worker& SelectWorker();
+
+  const size_t num_workers_;
+  std::unique_ptr<Worker[]> workers_;
+  std::atomic<size_t> next_worker_{0};
+  std::atomic<size_t> num_idle_{0};
+  std::atomic<size_t> num_running_{0};
+  std::atomic<bool> shutdown_{false};
+};
+
+}  // namespace internal_thread_impl
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_THREAD_WORK_STEALING_POOL_H_
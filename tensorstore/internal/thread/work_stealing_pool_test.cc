@@ -0,0 +1,121 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/thread/thread_pool.h"
+#include "tensorstore/util/executor.h"
+
+namespace {
+
+using ::tensorstore::internal::WorkStealingThreadPool;
+
+TEST(WorkStealingThreadPoolTest, Basic) {
+  auto executor = WorkStealingThreadPool(1);
+  absl::Notification notification;
+  executor([&] { notification.Notify(); });
+  notification.WaitForNotification();
+}
+
+// Tests that the thread pool runs two tasks concurrently, even when both are
+// submitted from within a task.
+TEST(WorkStealingThreadPoolTest, ConcurrentFromWorker) {
+  auto executor = WorkStealingThreadPool(2);
+  absl::Notification notification1, notification2, notification3;
+  executor([&] {
+    executor([&] {
+      notification1.Notify();
+      notification2.WaitForNotification();
+      notification3.Notify();
+    });
+    executor([&] {
+      notification1.WaitForNotification();
+      notification2.Notify();
+    });
+  });
+  notification3.WaitForNotification();
+}
+
+// Tests that the thread pool does not run more than the maximum number of tasks
+// concurrently.
+TEST(WorkStealingThreadPoolTest, ThreadLimit) {
+  constexpr static size_t kThreadLimit = 3;
+  auto executor = WorkStealingThreadPool(kThreadLimit);
+  std::atomic<size_t> num_running_tasks{0};
+  absl::BlockingCounter done(10);
+  for (size_t i = 0; i < 10; ++i) {
+    executor([&] {
+      EXPECT_LE(++num_running_tasks, kThreadLimit);
+      absl::SleepFor(absl::Milliseconds(100));
+      --num_running_tasks;
+      done.DecrementCount();
+    });
+  }
+  done.Wait();
+}
+
+// Tests that tasks queued by one worker are run by the other workers.
+TEST(WorkStealingThreadPoolTest, Fanout) {
+  constexpr size_t kN = 64, kM = 1024;
+  auto executor = WorkStealingThreadPool(4);
+  std::vector<std::atomic<size_t>> counts(kN);
+  absl::BlockingCounter done(kN * kM);
+  for (size_t i = 0; i < kN; ++i) {
+    executor([&, i] {
+      for (size_t j = 0; j < kM; ++j) {
+        executor([&, i] {
+          ++counts[i];
+          done.DecrementCount();
+        });
+      }
+    });
+  }
+  done.Wait();
+  for (size_t i = 0; i < kN; ++i) {
+    EXPECT_EQ(kM, counts[i]);
+  }
+}
+
+// Tests that queued tasks still run after the last executor reference is
+// released.
+TEST(WorkStealingThreadPoolTest, ReleaseExecutor) {
+  absl::Notification start, done;
+  {
+    auto executor = WorkStealingThreadPool(1);
+    executor([&] { start.WaitForNotification(); });
+    executor([&] { done.Notify(); });
+  }
+  start.Notify();
+  done.WaitForNotification();
+}
+
+// Tests that the pool is usable again after its workers exit.
+TEST(WorkStealingThreadPoolTest, Reuse) {
+  auto executor = WorkStealingThreadPool(2);
+  for (int i = 0; i < 100; ++i) {
+    absl::Notification notification;
+    executor([&] { notification.Notify(); });
+    notification.WaitForNotification();
+  }
+}
+
+}  // namespace
@@ -0,0 +1,173 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/tracing/chrome_trace_exporter.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <variant>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/internal/tracing/trace_exporter.h"
+#include "tensorstore/util/quote_string.h"
+
+namespace tensorstore {
+namespace internal_tracing {
+namespace {
+
+constexpr int kProcessId = 1;
+
+std::string FormatId(uint64_t id) { return absl::StrFormat("%016x", id); }
+
+double ToTraceTimestamp(absl::Time time) {
+  return absl::ToDoubleMicroseconds(time - absl::UnixEpoch());
+}
+
+}  // namespace
+
+ChromeTraceExporter::ChromeTraceExporter(std::string path, size_t max_spans)
+    : path_(std::move(path)), max_spans_(max_spans) {}
+
+ChromeTraceExporter::~ChromeTraceExporter() = default;
+
+void ChromeTraceExporter::ExportSpan(SpanData span) {
+  absl::MutexLock lock(&mutex_);
+  if (spans_.size() >= max_spans_) {
+    ++dropped_spans_;
+    return;
+  }
+  spans_.push_back(std::move(span));
+}
+
+::nlohmann::json ChromeTraceExporter::ToJson() const {
+  absl::MutexLock lock(&mutex_);
+  absl::flat_hash_map<uint64_t, uint32_t> span_threads;
+  for (const auto& span : spans_) {
+    span_threads[span.context.span_id] = span.thread_id;
+  }
+  auto events = ::nlohmann::json::array_t();
+  events.reserve(spans_.size());
+  for (const auto& span : spans_) {
+    const double start = ToTraceTimestamp(span.start_time);
+    ::nlohmann::json::object_t args{
+        {"trace_id", FormatId(span.context.trace_id)},
+        {"span_id", FormatId(span.context.span_id)},
+        {"source", absl::StrCat(span.file_name, ":", span.line)},
+    };
+    if (span.parent.span_id) {
+      args.emplace("parent_span_id", FormatId(span.parent.span_id));
+    }
+    for (const auto& [name, value] : span.attributes) {
+      args.emplace(name,
+                   std::visit([](const auto& v) { return ::nlohmann::json(v); },
+                              value));
+    }
+    if (span.async) {
+      // Operation spans may outlive, or end on a different thread than, the
+      // synchronous spans of the thread on which they started, so they are
+      // written as async begin/end pairs rather than as complete events,
+      // which must nest properly on a single thread.
+      const std::string async_id = FormatId(span.context.span_id);
+      events.push_back(::nlohmann::json::object_t{
+          {"name", span.name},
+          {"cat", "tensorstore"},
+          {"ph", "b"},
+          {"id", async_id},
+          {"ts", start},
+          {"pid", kProcessId},
+          {"tid", span.thread_id},
+          {"args", std::move(args)},
+      });
+      events.push_back(::nlohmann::json::object_t{
+          {"name", span.name},
+          {"cat", "tensorstore"},
+          {"ph", "e"},
+          {"id", async_id},
+          {"ts", ToTraceTimestamp(span.end_time)},
+          {"pid", kProcessId},
+          {"tid", span.thread_id},
+      });
+    } else {
+      events.push_back(::nlohmann::json::object_t{
+          {"name", span.name},
+          {"cat", "tensorstore"},
+          {"ph", "X"},
+          {"ts", start},
+          {"dur",
+           absl::ToDoubleMicroseconds(span.end_time - span.start_time)},
+          {"pid", kProcessId},
+          {"tid", span.thread_id},
+          {"args", std::move(args)},
+      });
+    }
+
+    // Link spans to parents started on a different thread, e.g. across an
+    // executor hop or future callback.
+    auto it = span_threads.find(span.parent.span_id);
+    if (it == span_threads.end() || it->second == span.thread_id) continue;
+    const std::string flow_id = FormatId(span.context.span_id);
+    events.push_back(::nlohmann::json::object_t{
+        {"name", "async"},
+        {"cat", "tensorstore"},
+        {"ph", "s"},
+        {"id", flow_id},
+        {"ts", start},
+        {"pid", kProcessId},
+        {"tid", it->second},
+    });
+    events.push_back(::nlohmann::json::object_t{
+        {"name", "async"},
+        {"cat", "tensorstore"},
+        {"ph", "f"},
+        {"bp", "e"},
+        {"id", flow_id},
+        {"ts", start},
+        {"pid", kProcessId},
+        {"tid", span.thread_id},
+    });
+  }
+  return ::nlohmann::json::object_t{
+      {"traceEvents", std::move(events)},
+      {"displayTimeUnit", "ms"},
+      {"otherData", {{"dropped_spans", dropped_spans_}}},
+  };
+}
+
+absl::Status ChromeTraceExporter::Flush() const {
+  // Span names and attributes, such as keys, may contain invalid UTF-8, which
+  // would otherwise cause `dump` to throw.
+  const std::string data = ToJson().dump(
+      -1, ' ', false, ::nlohmann::json::error_handler_t::replace);
+  std::ofstream file(path_, std::ios::out | std::ios::trunc);
+  file << data;
+  file.close();
+  if (!file) {
+    return absl::UnavailableError(
+        absl::StrCat("Failed to write trace to ", QuoteString(path_)));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace internal_tracing
+}  // namespace tensorstore
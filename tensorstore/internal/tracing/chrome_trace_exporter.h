@@ -0,0 +1,72 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_TRACING_CHROME_TRACE_EXPORTER_H_
+#define TENSORSTORE_INTERNAL_TRACING_CHROME_TRACE_EXPORTER_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include <nlohmann/json_fwd.hpp>
+#include "tensorstore/internal/tracing/trace_exporter.h"
+
+namespace tensorstore {
+namespace internal_tracing {
+
+/// Exporter that writes spans in the Chrome trace event JSON format, which
+/// may be viewed with `chrome://tracing` or https://ui.perfetto.dev.
+///
+/// Spans are buffered in memory, and written to `path` by `Flush`.  Each
+/// `LocalTraceSpan` is written as a complete ("X") event on the thread that
+/// started it, and each `OperationTraceSpan`, which need not nest within the
+/// spans of that thread, as a pair of async ("b"/"e") events identified by
+/// the span identifier.  The trace and span identifiers are included as
+/// arguments.  Spans whose parent was started on a different thread are
+/// additionally linked to the parent by a flow event.
+class ChromeTraceExporter : public TraceExporter {
+ public:
+  /// Constructs an exporter that writes to `path`.
+  ///
+  /// \param max_spans Maximum number of spans to buffer.  Additional spans
+  ///     are dropped.
+  explicit ChromeTraceExporter(std::string path, size_t max_spans = 1000000);
+
+  ~ChromeTraceExporter() override;
+
+  void ExportSpan(SpanData span) override;
+
+  /// Returns the JSON trace for the spans exported so far.
+  ::nlohmann::json ToJson() const;
+
+  /// Writes all spans exported so far to the output file, replacing any
+  /// existing content.
+  absl::Status Flush() const;
+
+ private:
+  std::string path_;
+  size_t max_spans_;
+  mutable absl::Mutex mutex_;
+  std::vector<SpanData> spans_ ABSL_GUARDED_BY(mutex_);
+  size_t dropped_spans_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace internal_tracing
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_TRACING_CHROME_TRACE_EXPORTER_H_
@@ -0,0 +1,171 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/tracing/chrome_trace_exporter.h"
+
+#include <stdint.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/internal/testing/json_gtest.h"
+#include "tensorstore/internal/testing/scoped_directory.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/internal/tracing/trace_exporter.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::JsonSubValuesMatch;
+using ::tensorstore::internal_testing::ScopedTemporaryDirectory;
+using ::tensorstore::internal_tracing::ChromeTraceExporter;
+using ::tensorstore::internal_tracing::SpanData;
+using ::tensorstore::internal_tracing::TraceContext;
+
+SpanData MakeSpan(std::string name, TraceContext context, TraceContext parent,
+                  uint32_t thread_id, int64_t start_us, int64_t end_us) {
+  SpanData span;
+  span.name = std::move(name);
+  span.context = context;
+  span.parent = parent;
+  span.thread_id = thread_id;
+  span.start_time = absl::FromUnixMicros(start_us);
+  span.end_time = absl::FromUnixMicros(end_us);
+  span.file_name = "file.cc";
+  span.line = 10;
+  return span;
+}
+
+TEST(ChromeTraceExporterTest, ToJson) {
+  ChromeTraceExporter exporter("unused");
+  exporter.ExportSpan(MakeSpan("parent", TraceContext(1, 2),
+                               TraceContext(0, 0), 1, 100, 300));
+  auto child = MakeSpan("child", TraceContext(1, 3), TraceContext(1, 2), 2,
+                        150, 200);
+  child.AddAttribute({"key", "a"});
+  child.AddAttribute({"size", 5});
+  exporter.ExportSpan(std::move(child));
+
+  auto json = exporter.ToJson();
+  EXPECT_THAT(
+      json,
+      JsonSubValuesMatch({
+          {"/displayTimeUnit", "ms"},
+          {"/otherData/dropped_spans", 0},
+          {"/traceEvents/0/name", "parent"},
+          {"/traceEvents/0/ph", "X"},
+          {"/traceEvents/0/ts", 100.0},
+          {"/traceEvents/0/dur", 200.0},
+          {"/traceEvents/0/tid", 1},
+          {"/traceEvents/0/args/trace_id", "0000000000000001"},
+          {"/traceEvents/0/args/span_id", "0000000000000002"},
+          {"/traceEvents/0/args/source", "file.cc:10"},
+          {"/traceEvents/1/name", "child"},
+          {"/traceEvents/1/ph", "X"},
+          {"/traceEvents/1/tid", 2},
+          {"/traceEvents/1/args/parent_span_id", "0000000000000002"},
+          {"/traceEvents/1/args/key", "a"},
+          {"/traceEvents/1/args/size", 5},
+          // The child was started on a different thread than its parent.
+          {"/traceEvents/2/ph", "s"},
+          {"/traceEvents/2/tid", 1},
+          {"/traceEvents/2/id", "0000000000000003"},
+          {"/traceEvents/3/ph", "f"},
+          {"/traceEvents/3/tid", 2},
+          {"/traceEvents/3/id", "0000000000000003"},
+      }));
+  EXPECT_EQ(4, json["traceEvents"].size());
+  EXPECT_FALSE(json["traceEvents"][0]["args"].contains("parent_span_id"));
+}
+
+TEST(ChromeTraceExporterTest, AsyncSpan) {
+  ChromeTraceExporter exporter("unused");
+  auto span = MakeSpan("operation", TraceContext(1, 2), TraceContext(0, 0), 1,
+                       100, 300);
+  span.async = true;
+  exporter.ExportSpan(std::move(span));
+
+  auto json = exporter.ToJson();
+  EXPECT_THAT(json, JsonSubValuesMatch({
+                        {"/traceEvents/0/name", "operation"},
+                        {"/traceEvents/0/ph", "b"},
+                        {"/traceEvents/0/id", "0000000000000002"},
+                        {"/traceEvents/0/ts", 100.0},
+                        {"/traceEvents/0/tid", 1},
+                        {"/traceEvents/0/args/span_id", "0000000000000002"},
+                        {"/traceEvents/1/name", "operation"},
+                        {"/traceEvents/1/ph", "e"},
+                        {"/traceEvents/1/id", "0000000000000002"},
+                        {"/traceEvents/1/ts", 300.0},
+                        {"/traceEvents/1/tid", 1},
+                    }));
+  EXPECT_EQ(2, json["traceEvents"].size());
+}
+
+TEST(ChromeTraceExporterTest, MaxSpans) {
+  ChromeTraceExporter exporter("unused", /*max_spans=*/1);
+  for (int i = 0; i < 3; ++i) {
+    exporter.ExportSpan(
+        MakeSpan("span", TraceContext(1, i + 1), TraceContext(0, 0), 1, 0, 1));
+  }
+  auto json = exporter.ToJson();
+  EXPECT_EQ(1, json["traceEvents"].size());
+  EXPECT_EQ(2, json["otherData"]["dropped_spans"]);
+}
+
+TEST(ChromeTraceExporterTest, Flush) {
+  ScopedTemporaryDirectory tempdir;
+  const std::string path = tempdir.path() + "/trace.json";
+  ChromeTraceExporter exporter(path);
+  exporter.ExportSpan(
+      MakeSpan("span", TraceContext(1, 2), TraceContext(0, 0), 1, 0, 1));
+  TENSORSTORE_ASSERT_OK(exporter.Flush());
+
+  std::ifstream file(path);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  EXPECT_EQ(exporter.ToJson(), ::nlohmann::json::parse(contents.str()));
+}
+
+TEST(ChromeTraceExporterTest, FlushInvalidUtf8) {
+  ScopedTemporaryDirectory tempdir;
+  const std::string path = tempdir.path() + "/trace.json";
+  ChromeTraceExporter exporter(path);
+  auto span =
+      MakeSpan("span", TraceContext(1, 2), TraceContext(0, 0), 1, 0, 1);
+  span.AddAttribute({"key", "a\xff"});
+  exporter.ExportSpan(std::move(span));
+  TENSORSTORE_ASSERT_OK(exporter.Flush());
+
+  std::ifstream file(path);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  auto json = ::nlohmann::json::parse(contents.str());
+  // Replaced by U+FFFD.
+  EXPECT_EQ("a\xef\xbf\xbd", json["traceEvents"][0]["args"]["key"]);
+}
+
+TEST(ChromeTraceExporterTest, FlushError) {
+  ScopedTemporaryDirectory tempdir;
+  ChromeTraceExporter exporter(tempdir.path() + "/missing/trace.json");
+  EXPECT_FALSE(exporter.Flush().ok());
+}
+
+}  // namespace
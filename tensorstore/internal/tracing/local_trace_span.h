@@ -19,10 +19,14 @@
 #include <stdint.h>
 
 #include <initializer_list>
+#include <memory>
 #include <string_view>
+#include <utility>
 
 #include "tensorstore/internal/source_location.h"
 #include "tensorstore/internal/tracing/span_attribute.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/internal/tracing/trace_exporter.h"
 #include "tensorstore/util/span.h"
 
 namespace tensorstore {
@@ -33,16 +37,22 @@ namespace internal_tracing {
 ///
 /// A LocalTraceSpan should be allocated on the stack within a single thread,
 /// and not on the heap. Use `OperationTraceSpan` for asynchronous operations.
+///
+/// While tracing is enabled (see `SetTraceExporter`), the span is installed as
+/// the current trace context of the thread for its lifetime, such that any
+/// spans and asynchronous tasks started within its scope are attributed to it.
 class LocalTraceSpan {
  public:
   LocalTraceSpan(std::string_view method,
-                 const SourceLocation& location = SourceLocation::current())
-  {}
+                 const SourceLocation& location = SourceLocation::current()) {
+    if (IsTracingEnabled()) Begin(method, {}, location);
+  }
 
   LocalTraceSpan(std::string_view method,
                  tensorstore::span<const SpanAttribute> attributes,
-                 const SourceLocation& location = SourceLocation::current())
-  {}
+                 const SourceLocation& location = SourceLocation::current()) {
+    if (IsTracingEnabled()) Begin(method, attributes, location);
+  }
 
   LocalTraceSpan(std::string_view method,
                  std::initializer_list<SpanAttribute> attributes,
@@ -52,9 +62,34 @@ class LocalTraceSpan {
                            attributes.begin(), attributes.end()),
                        location) {}
 
-  ~LocalTraceSpan() = default;
+  LocalTraceSpan(const LocalTraceSpan&) = delete;
+  LocalTraceSpan& operator=(const LocalTraceSpan&) = delete;
+
+  ~LocalTraceSpan() {
+    if (span_) End();
+  }
+
+  /// Adds an attribute to the span, if it is being recorded.
+  void AddAttribute(const SpanAttribute& attribute) {
+    if (span_) span_->AddAttribute(attribute);
+  }
 
  private:
+  void Begin(std::string_view method,
+             tensorstore::span<const SpanAttribute> attributes,
+             const SourceLocation& location) {
+    span_ = StartSpan(method, attributes, location);
+    TraceContext context = span_->context;
+    SwapCurrentTraceContext(&context);
+  }
+
+  void End() {
+    TraceContext context = span_->parent;
+    SwapCurrentTraceContext(&context);
+    EndSpan(std::move(span_));
+  }
+
+  std::unique_ptr<SpanData> span_;
 };
 
 }  // namespace internal_tracing
@@ -92,6 +92,7 @@ class LoggedTraceSpan : public LocalTraceSpan {
   absl::Status EndWithStatus(
       absl::Status&& status,
       const SourceLocation& location = SourceLocation::current()) && {
+    if (!status.ok()) AddAttribute({"status", status.ToString()});
     if (id_) {
       EndLog(
           absl::LogInfoStreamer(location.file_name(), location.line()).stream())
@@ -18,24 +18,74 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <initializer_list>
+#include <memory>
 #include <string_view>
+#include <utility>
 
 #include "tensorstore/internal/source_location.h"
+#include "tensorstore/internal/tracing/span_attribute.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/internal/tracing/trace_exporter.h"
+#include "tensorstore/util/span.h"
 
 namespace tensorstore {
 namespace internal_tracing {
 
 /// An OperationTraceSpan is an operation trace annotation used to tag
 /// asynchronous operations which may be long running.
+///
+/// Unlike `LocalTraceSpan`, an OperationTraceSpan may be stored as part of the
+/// state of an asynchronous operation and destroyed on a different thread, and
+/// therefore does not change the current trace context of the thread.  To
+/// attribute work initiated by the operation to the span, install `context()`
+/// using `ScopedTraceContext` while initiating the operation.
 class OperationTraceSpan {
  public:
   OperationTraceSpan(std::string_view method,
                      const SourceLocation& location = SourceLocation::current())
-  {}
+  {
+    if (IsTracingEnabled()) {
+      span_ = StartSpan(method, {}, location);
+      span_->async = true;
+    }
+  }
 
-  ~OperationTraceSpan() = default;
+  OperationTraceSpan(std::string_view method,
+                     std::initializer_list<SpanAttribute> attributes,
+                     const SourceLocation& location = SourceLocation::current())
+  {
+    if (IsTracingEnabled()) {
+      span_ = StartSpan(method,
+                        tensorstore::span<const SpanAttribute>(
+                            attributes.begin(), attributes.end()),
+                        location);
+      span_->async = true;
+    }
+  }
+
+  OperationTraceSpan(OperationTraceSpan&&) = default;
+
+  ~OperationTraceSpan() {
+    if (span_) EndSpan(std::move(span_));
+  }
+
+  /// Returns `true` if the span is being recorded.
+  bool recording() const { return span_ != nullptr; }
+
+  /// Returns the context identifying this span, or the current context of the
+  /// thread if the span is not being recorded.
+  TraceContext context() const {
+    return span_ ? span_->context : TraceContext(TraceContext::kThread);
+  }
+
+  /// Adds an attribute to the span, if it is being recorded.
+  void AddAttribute(const SpanAttribute& attribute) {
+    if (span_) span_->AddAttribute(attribute);
+  }
 
  private:
+  std::unique_ptr<SpanData> span_;
 };
 
 }  // namespace internal_tracing
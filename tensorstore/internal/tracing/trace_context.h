@@ -15,25 +15,90 @@
 #ifndef TENSORSTORE_INTERNAL_TRACING_TRACE_CONTEXT_H_
 #define TENSORSTORE_INTERNAL_TRACING_TRACE_CONTEXT_H_
 
+#include <stdint.h>
+
 #include <utility>
 
 namespace tensorstore {
 namespace internal_tracing {
 
+/// Identifies the active span of a trace.
+///
+/// Each thread has a current `TraceContext`.  Asynchronous tasks, such as
+/// executor tasks and future callbacks, capture the current context of the
+/// thread on which they are created (using `TraceContext::kThread`), and
+/// install it with `SwapCurrentTraceContext` while they run, so that spans
+/// started by the task are attributed to the originating operation.
 struct TraceContext {
   struct ThreadInitType {};
   inline static constexpr ThreadInitType kThread{};
 
   TraceContext() = delete;
-  explicit TraceContext(ThreadInitType) {}
+
+  /// Copies the current context of the calling thread.
+  explicit TraceContext(ThreadInitType);
+
+  /// Constructs a context referring to the specified span.
+  ///
+  /// A `trace_id` of `0` indicates that there is no active trace.
+  constexpr TraceContext(uint64_t trace_id, uint64_t span_id)
+      : trace_id(trace_id), span_id(span_id) {}
 
   TraceContext(TraceContext&&) = default;
   TraceContext& operator=(TraceContext&&) = default;
   TraceContext(const TraceContext&) = default;
   TraceContext& operator=(const TraceContext&) = default;
+
+  /// Identifies the trace, i.e. the top-level operation.
+  uint64_t trace_id;
+
+  /// Identifies the active span within the trace.
+  uint64_t span_id;
+};
+
+/// Exchanges the current context of the calling thread with `*context`.
+void SwapCurrentTraceContext(TraceContext* context);
+
+#ifndef TENSORSTORE_TRACING_DISABLED
+
+/// Trace context captured by asynchronous tasks, such as executor tasks and
+/// future callbacks, when they are created (using `TraceContext::kThread`),
+/// and installed with `SwapCurrentTraceContext` while they run.
+using TaskTraceContext = TraceContext;
+
+#else
+
+/// When tracing is compiled out, contexts are not propagated to asynchronous
+/// tasks, and `TaskTraceContext` is an empty type so that tasks do not store a
+/// context or access the thread-local current context.
+struct TaskTraceContext {
+  explicit TaskTraceContext(TraceContext::ThreadInitType) {}
+  constexpr TaskTraceContext(uint64_t trace_id, uint64_t span_id) {}
 };
 
-inline void SwapCurrentTraceContext(TraceContext* context) {}
+inline void SwapCurrentTraceContext(TaskTraceContext* context) {}
+
+#endif  // TENSORSTORE_TRACING_DISABLED
+
+/// Returns a new random non-zero trace or span identifier.
+uint64_t NewTraceId();
+
+/// Installs a trace context as the current context of the calling thread for
+/// the duration of a scope.
+class ScopedTraceContext {
+ public:
+  explicit ScopedTraceContext(TraceContext context) : context_(context) {
+    SwapCurrentTraceContext(&context_);
+  }
+
+  ScopedTraceContext(const ScopedTraceContext&) = delete;
+  ScopedTraceContext& operator=(const ScopedTraceContext&) = delete;
+
+  ~ScopedTraceContext() { SwapCurrentTraceContext(&context_); }
+
+ private:
+  TraceContext context_;
+};
 
 }  // namespace internal_tracing
 }  // namespace tensorstore
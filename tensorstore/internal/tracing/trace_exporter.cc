@@ -0,0 +1,153 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/tracing/trace_exporter.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "absl/base/attributes.h"
+#include "absl/base/const_init.h"
+#include "absl/base/no_destructor.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/log/absl_log.h"
+#include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "tensorstore/internal/env.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/internal/source_location.h"
+#include "tensorstore/internal/tracing/chrome_trace_exporter.h"
+#include "tensorstore/internal/tracing/span_attribute.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_tracing {
+namespace internal_tracing_detail {
+
+ABSL_CONST_INIT std::atomic<bool> tracing_enabled{false};
+
+}  // namespace internal_tracing_detail
+
+namespace {
+
+ABSL_CONST_INIT absl::Mutex exporter_mutex(absl::kConstInit);
+
+std::shared_ptr<TraceExporter>& CurrentExporter()
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(exporter_mutex) {
+  static absl::NoDestructor<std::shared_ptr<TraceExporter>> exporter;
+  return *exporter;
+}
+
+// Returns a small integer identifying the calling thread.
+uint32_t CurrentThreadId() {
+  static std::atomic<uint32_t> next_thread_id{1};
+  thread_local uint32_t thread_id =
+      next_thread_id.fetch_add(1, std::memory_order_relaxed);
+  return thread_id;
+}
+
+// Exporter installed based on the `TENSORSTORE_TRACE_FILE` environment
+// variable, which is flushed at exit.
+std::shared_ptr<ChromeTraceExporter>& EnvironmentExporter() {
+  static absl::NoDestructor<std::shared_ptr<ChromeTraceExporter>> exporter;
+  return *exporter;
+}
+
+void FlushEnvironmentExporter() {
+  if (auto& exporter = EnvironmentExporter()) {
+    if (auto status = exporter->Flush(); !status.ok()) {
+      ABSL_LOG(WARNING) << "Failed to write trace: " << status;
+    }
+  }
+}
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  auto path = internal::GetEnv("TENSORSTORE_TRACE_FILE");
+  if (!path || path->empty()) return;
+  EnvironmentExporter() = std::make_shared<ChromeTraceExporter>(*path);
+  SetTraceExporter(EnvironmentExporter());
+  std::atexit(&FlushEnvironmentExporter);
+}
+
+}  // namespace
+
+void SpanData::AddAttribute(const SpanAttribute& attribute) {
+  attributes.emplace_back(
+      std::string(attribute.name),
+      std::visit(
+          [](auto value) -> AttributeValue {
+            using T = decltype(value);
+            if constexpr (std::is_same_v<T, std::string_view>) {
+              return std::string(value);
+            } else if constexpr (std::is_same_v<T, void*>) {
+              return absl::StrFormat("%p", value);
+            } else {
+              return value;
+            }
+          },
+          attribute.value));
+}
+
+TraceExporter::~TraceExporter() = default;
+
+void SetTraceExporter(std::shared_ptr<TraceExporter> exporter) {
+  absl::MutexLock lock(&exporter_mutex);
+  internal_tracing_detail::tracing_enabled.store(exporter != nullptr,
+                                                 std::memory_order_relaxed);
+  CurrentExporter() = std::move(exporter);
+}
+
+std::shared_ptr<TraceExporter> GetTraceExporter() {
+  absl::MutexLock lock(&exporter_mutex);
+  return CurrentExporter();
+}
+
+std::unique_ptr<SpanData> StartSpan(std::string_view name,
+                                    span<const SpanAttribute> attributes,
+                                    const SourceLocation& location) {
+  auto span = std::make_unique<SpanData>();
+  span->name = std::string(name);
+  span->parent = TraceContext(TraceContext::kThread);
+  span->context = TraceContext(
+      span->parent.trace_id ? span->parent.trace_id : NewTraceId(),
+      NewTraceId());
+  span->thread_id = CurrentThreadId();
+  span->file_name = location.file_name();
+  span->line = location.line();
+  for (const auto& attribute : attributes) {
+    span->AddAttribute(attribute);
+  }
+  span->start_time = absl::Now();
+  return span;
+}
+
+void EndSpan(std::unique_ptr<SpanData> span) {
+  span->end_time = absl::Now();
+  if (auto exporter = GetTraceExporter()) {
+    exporter->ExportSpan(std::move(*span));
+  }
+}
+
+}  // namespace internal_tracing
+}  // namespace tensorstore
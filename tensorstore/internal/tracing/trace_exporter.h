@@ -0,0 +1,122 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_TRACING_TRACE_EXPORTER_H_
+#define TENSORSTORE_INTERNAL_TRACING_TRACE_EXPORTER_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "absl/base/optimization.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/source_location.h"
+#include "tensorstore/internal/tracing/span_attribute.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_tracing {
+
+/// A completed span, as passed to a `TraceExporter`.
+struct SpanData {
+  using AttributeValue =
+      std::variant<bool, int64_t, uint64_t, double, std::string>;
+
+  /// Name of the span, e.g. `"tensorstore.Read"`.
+  std::string name;
+
+  /// Context identifying this span.
+  TraceContext context{0, 0};
+
+  /// Context that was current when the span was started.
+  TraceContext parent{0, 0};
+
+  absl::Time start_time;
+  absl::Time end_time;
+
+  /// Small integer identifying the thread on which the span was started.
+  uint32_t thread_id = 0;
+
+  /// Whether the span tags an asynchronous operation (`OperationTraceSpan`),
+  /// and may therefore end on a different thread, and overlap other spans of
+  /// the thread on which it started without being nested within them.
+  bool async = false;
+
+  /// Source location at which the span was started.
+  std::string_view file_name;
+  uint32_t line = 0;
+
+  std::vector<std::pair<std::string, AttributeValue>> attributes;
+
+  void AddAttribute(const SpanAttribute& attribute);
+};
+
+/// Receives completed spans.
+///
+/// `ExportSpan` may be called concurrently from any thread.
+class TraceExporter {
+ public:
+  virtual ~TraceExporter();
+  virtual void ExportSpan(SpanData span) = 0;
+};
+
+/// Installs the exporter to which all completed spans are sent.
+///
+/// Spans are only recorded while an exporter is installed; specifying `nullptr`
+/// disables tracing.  Spans that are active when the exporter is changed are
+/// sent to the new exporter.
+///
+/// If the `TENSORSTORE_TRACE_FILE` environment variable is set, a
+/// `ChromeTraceExporter` writing to the specified path is installed initially.
+void SetTraceExporter(std::shared_ptr<TraceExporter> exporter);
+
+/// Returns the current exporter, or `nullptr` if tracing is disabled.
+std::shared_ptr<TraceExporter> GetTraceExporter();
+
+namespace internal_tracing_detail {
+extern std::atomic<bool> tracing_enabled;
+}  // namespace internal_tracing_detail
+
+/// Returns `true` if spans should be recorded.
+///
+/// Always `false` when tracing is compiled out.
+inline bool IsTracingEnabled() {
+#ifdef TENSORSTORE_TRACING_DISABLED
+  return false;
+#else
+  return ABSL_PREDICT_FALSE(
+      internal_tracing_detail::tracing_enabled.load(std::memory_order_relaxed));
+#endif
+}
+
+/// Starts a new span as a child of the current trace context of the calling
+/// thread.  Used by `LocalTraceSpan` and `OperationTraceSpan`.
+std::unique_ptr<SpanData> StartSpan(std::string_view name,
+                                    span<const SpanAttribute> attributes,
+                                    const SourceLocation& location);
+
+/// Records the end time of `span` and sends it to the current exporter.
+void EndSpan(std::unique_ptr<SpanData> span);
+
+}  // namespace internal_tracing
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_TRACING_TRACE_EXPORTER_H_
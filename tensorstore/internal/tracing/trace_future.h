@@ -0,0 +1,47 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_TRACING_TRACE_FUTURE_H_
+#define TENSORSTORE_INTERNAL_TRACING_TRACE_FUTURE_H_
+
+#include <utility>
+
+#include "tensorstore/internal/tracing/operation_trace_span.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_tracing {
+
+/// Returns a future that becomes ready with the result of `future`, and which
+/// ends `span` once it does.
+///
+/// If `span` is not being recorded, `future` is returned unchanged.  Dropping
+/// the returned future still allows the operation to be cancelled.
+template <typename T>
+Future<T> EndSpanWhenReady(OperationTraceSpan span, Future<T> future) {
+  if (!span.recording() || future.ready()) return future;
+  return MapFuture(
+      InlineExecutor{},
+      [span = std::move(span)](Result<T>& result) mutable -> Result<T> {
+        return std::move(result);
+      },
+      std::move(future));
+}
+
+}  // namespace internal_tracing
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_TRACING_TRACE_FUTURE_H_
@@ -14,27 +14,70 @@
 
 #include <stdint.h>
 
+#include <memory>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/base/log_severity.h"
 #include "absl/log/scoped_mock_log.h"
 #include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
 #include "tensorstore/internal/tracing/local_trace_span.h"
 #include "tensorstore/internal/tracing/logged_trace_span.h"
 #include "tensorstore/internal/tracing/operation_trace_span.h"
 #include "tensorstore/internal/tracing/span_attribute.h"
 #include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/internal/tracing/trace_exporter.h"
+#include "tensorstore/util/future.h"
 
 namespace {
 
 using ::tensorstore::internal_tracing::LocalTraceSpan;
 using ::tensorstore::internal_tracing::LoggedTraceSpan;
+using ::tensorstore::internal_tracing::OperationTraceSpan;
+using ::tensorstore::internal_tracing::ScopedTraceContext;
 using ::tensorstore::internal_tracing::SpanAttribute;
+using ::tensorstore::internal_tracing::SpanData;
+using ::tensorstore::internal_tracing::TraceContext;
+using ::tensorstore::internal_tracing::TraceExporter;
 using ::testing::_;
+using ::testing::ElementsAre;
 using ::testing::HasSubstr;
+using ::testing::Pair;
+using ::testing::VariantWith;
+
+class CollectingExporter : public TraceExporter {
+ public:
+  void ExportSpan(SpanData span) override {
+    absl::MutexLock lock(&mutex_);
+    spans_.push_back(std::move(span));
+  }
+
+  std::vector<SpanData> spans() {
+    absl::MutexLock lock(&mutex_);
+    return spans_;
+  }
+
+ private:
+  absl::Mutex mutex_;
+  std::vector<SpanData> spans_;
+};
+
+// Installs a `CollectingExporter` for the duration of a test.
+class TracingTest : public ::testing::Test {
+ public:
+  TracingTest() : exporter_(std::make_shared<CollectingExporter>()) {
+    tensorstore::internal_tracing::SetTraceExporter(exporter_);
+  }
+  ~TracingTest() override {
+    tensorstore::internal_tracing::SetTraceExporter(nullptr);
+  }
+
+  std::shared_ptr<CollectingExporter> exporter_;
+};
 
 TEST(TraceTest, SwapContext) {
   tensorstore::internal_tracing::TraceContext tc(
@@ -43,6 +86,17 @@ TEST(TraceTest, SwapContext) {
   tensorstore::internal_tracing::SwapCurrentTraceContext(&tc);
 }
 
+TEST(TraceTest, ScopedTraceContext) {
+  EXPECT_EQ(0, TraceContext(TraceContext::kThread).trace_id);
+  {
+    ScopedTraceContext scope(TraceContext(1, 2));
+    TraceContext tc(TraceContext::kThread);
+    EXPECT_EQ(1, tc.trace_id);
+    EXPECT_EQ(2, tc.span_id);
+  }
+  EXPECT_EQ(0, TraceContext(TraceContext::kThread).trace_id);
+}
+
 TEST(TraceTest, LocalTraceSpan) {
   LocalTraceSpan span(
       "TraceSpan", {
@@ -95,4 +149,81 @@ TEST(TraceTest, OperationTraceSpan) {
   EXPECT_NE(&span, nullptr);
 }
 
+TEST_F(TracingTest, NestedLocalTraceSpans) {
+  {
+    LocalTraceSpan outer("outer", {{"int", 1}, {"string", "hello"}});
+    LocalTraceSpan inner("inner");
+    LoggedTraceSpan logged("logged", false);
+    std::move(logged)
+        .EndWithStatus(absl::UnknownError("failed"))
+        .IgnoreError();
+  }
+  EXPECT_EQ(0, TraceContext(TraceContext::kThread).trace_id);
+
+  auto spans = exporter_->spans();
+  ASSERT_EQ(3, spans.size());
+  const auto& logged = spans[0];
+  const auto& inner = spans[1];
+  const auto& outer = spans[2];
+  EXPECT_EQ("outer", outer.name);
+  EXPECT_EQ("inner", inner.name);
+  EXPECT_EQ("logged", logged.name);
+  EXPECT_EQ(0, outer.parent.trace_id);
+  EXPECT_NE(0, outer.context.trace_id);
+  EXPECT_EQ(outer.context.trace_id, inner.context.trace_id);
+  EXPECT_EQ(outer.context.span_id, inner.parent.span_id);
+  EXPECT_EQ(inner.context.span_id, logged.parent.span_id);
+  EXPECT_LE(outer.start_time, inner.start_time);
+  EXPECT_GE(outer.end_time, inner.end_time);
+  EXPECT_THAT(outer.attributes,
+              ElementsAre(Pair("int", VariantWith<int64_t>(1)),
+                          Pair("string", VariantWith<std::string>("hello"))));
+  EXPECT_THAT(logged.attributes,
+              ElementsAre(Pair("status", VariantWith<std::string>(
+                                             HasSubstr("failed")))));
+}
+
+TEST_F(TracingTest, OperationTraceSpan) {
+  TraceContext context(0, 0);
+  {
+    OperationTraceSpan span("operation");
+    EXPECT_TRUE(span.recording());
+    context = span.context();
+    // The current context is not changed.
+    EXPECT_EQ(0, TraceContext(TraceContext::kThread).trace_id);
+    ScopedTraceContext scope(span.context());
+    LocalTraceSpan child("child");
+  }
+  auto spans = exporter_->spans();
+  ASSERT_EQ(2, spans.size());
+  EXPECT_EQ("child", spans[0].name);
+  EXPECT_EQ(context.span_id, spans[0].parent.span_id);
+  EXPECT_EQ("operation", spans[1].name);
+  EXPECT_EQ(context.span_id, spans[1].context.span_id);
+}
+
+TEST_F(TracingTest, FutureCallbackPropagation) {
+  auto [promise, future] =
+      tensorstore::PromiseFuturePair<int>::Make(absl::UnknownError(""));
+  TraceContext callback_context(0, 0);
+  TraceContext span_context(0, 0);
+  {
+    LocalTraceSpan span("span");
+    span_context = TraceContext(TraceContext::kThread);
+    future.ExecuteWhenReady([&](tensorstore::ReadyFuture<int> f) {
+      callback_context = TraceContext(TraceContext::kThread);
+    });
+  }
+  // The callback runs with the context in which it was registered.
+  promise.SetResult(5);
+  EXPECT_EQ(span_context.trace_id, callback_context.trace_id);
+  EXPECT_EQ(span_context.span_id, callback_context.span_id);
+  EXPECT_EQ(0, TraceContext(TraceContext::kThread).trace_id);
+}
+
+TEST(TraceTest, DisabledSpansAreNotRecorded) {
+  OperationTraceSpan span("operation");
+  EXPECT_FALSE(span.recording());
+}
+
 }  // namespace
@@ -0,0 +1,90 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_BATCH_READ_COALESCING_RESOURCE_H_
+#define TENSORSTORE_KVSTORE_BATCH_READ_COALESCING_RESOURCE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tensorstore/context.h"
+#include "tensorstore/context_resource_provider.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/kvstore/batch_util.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_kvstore_batch {
+
+/// Specifies the `CoalescingOptions` used by a kvstore driver for batch reads.
+///
+/// `Derived` must define `id`, and may define `Default()` to return the
+/// driver-specific defaults; members omitted from the JSON representation
+/// take their value from `Derived::Default()`.
+template <typename Derived>
+struct BatchReadCoalescingResource
+    : public internal::ContextResourceTraits<Derived> {
+  constexpr static bool config_only = true;
+
+  using Spec = CoalescingOptions;
+  using Resource = Spec;
+
+  static Spec Default() { return kDefaultRemoteStorageCoalescingOptions; }
+
+  static constexpr auto JsonBinder() {
+    namespace jb = ::tensorstore::internal_json_binding;
+    return jb::Object(
+        jb::Member("max_extra_read_bytes",
+                   jb::Projection(
+                       &Spec::max_extra_read_bytes,
+                       jb::DefaultValue(
+                           [](auto* v) {
+                             *v = Derived::Default().max_extra_read_bytes;
+                           },
+                           jb::Integer<int64_t>(0)))),
+        jb::Member("target_coalesced_size",
+                   jb::Projection(
+                       &Spec::target_coalesced_size,
+                       jb::DefaultValue(
+                           [](auto* v) {
+                             *v = Derived::Default().target_coalesced_size;
+                           },
+                           jb::Integer<int64_t>(1)))),
+        jb::Member("max_concurrent_reads",
+                   jb::Projection(
+                       &Spec::max_concurrent_reads,
+                       jb::DefaultValue(
+                           [](auto* v) {
+                             *v = Derived::Default().max_concurrent_reads;
+                           },
+                           jb::Integer<size_t>(1)))) /**/
+    );
+  }
+
+  static Result<Resource> Create(
+      const Spec& spec, internal::ContextResourceCreationContext context) {
+    return spec;
+  }
+
+  static Spec GetSpec(const Resource& resource,
+                      const internal::ContextSpecBuilder& builder) {
+    return resource;
+  }
+};
+
+}  // namespace internal_kvstore_batch
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_BATCH_READ_COALESCING_RESOURCE_H_
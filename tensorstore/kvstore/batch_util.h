@@ -461,6 +461,9 @@ void ValidateGenerationsAndByteRanges(Requests& requests,
 // Specifies constraints on coalescing.
 //
 // This may be used as a preciate for `ForEachCoalescedRequest`.
+//
+// The constants below are the per-driver defaults; drivers allow them to be
+// overridden by a `BatchReadCoalescingResource` context resource.
 struct CoalescingOptions {
   // Maximum number of additional bytes to read per request. For example, if it
   // is estimated that the cost of an additional request is equivalent to the
@@ -475,6 +478,16 @@ struct CoalescingOptions {
   // that may be obtained from a greater number of requests.
   int64_t target_coalesced_size = std::numeric_limits<int64_t>::max();
 
+  // Maximum number of coalesced reads that a driver may have outstanding at
+  // once.  This is not used by the predicate; it is used to construct the
+  // driver's `CoalescedReadScheduler`.
+  size_t max_concurrent_reads = std::numeric_limits<size_t>::max();
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.max_extra_read_bytes, x.target_coalesced_size,
+             x.max_concurrent_reads);
+  };
+
   // Checks if a new byte range starting at `next_inclusive_min` should be
   // coalesced with the existing `coalesced_byte_range`, subject to the
   // specified options.
@@ -488,6 +501,35 @@ struct CoalescingOptions {
 constexpr CoalescingOptions kDefaultRemoteStorageCoalescingOptions = {
     /*.max_extra_read_bytes=*/4095,
     /*.target_coalesced_size=*/128 * 1024 * 10248,
+    /*.max_concurrent_reads=*/32,
+};
+
+// GCS has a high per-request latency, but high per-stream throughput, so
+// reading a gap of up to 64KiB is cheaper than issuing an additional request.
+// Coalesced reads are capped at 16MiB so that large batches are still spread
+// over multiple concurrent streams.
+constexpr CoalescingOptions kGcsCoalescingOptions = {
+    /*.max_extra_read_bytes=*/64 * 1024 - 1,
+    /*.target_coalesced_size=*/16 * 1024 * 1024,
+    /*.max_concurrent_reads=*/64,
+};
+
+// S3 uses the same coalescing limits as other remote storage, but per-prefix
+// request rates are lower than those of GCS, so fewer reads are kept in flight.
+constexpr CoalescingOptions kS3CoalescingOptions = {
+    /*.max_extra_read_bytes=*/4095,
+    /*.target_coalesced_size=*/128 * 1024 * 1024,
+    /*.max_concurrent_reads=*/32,
+};
+
+// Local file reads are inexpensive; coalesce within a page, and cap the size
+// so that large batches are spread across `file_io_concurrency` threads.  The
+// number of outstanding reads is bounded so that a single large batch does not
+// monopolize the `file_io_concurrency` executor or the io_uring queue.
+constexpr CoalescingOptions kLocalFileCoalescingOptions = {
+    /*.max_extra_read_bytes=*/4095,
+    /*.target_coalesced_size=*/4 * 1024 * 1024,
+    /*.max_concurrent_reads=*/64,
 };
 
 }  // namespace internal_kvstore_batch
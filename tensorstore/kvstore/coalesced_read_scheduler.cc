@@ -0,0 +1,138 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/coalesced_read_scheduler.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/internal/metrics/metadata.h"
+#include "tensorstore/internal/metrics/registration.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_kvstore_batch {
+
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    batch_read_requests, (Counter<int64_t, std::string>),
+    MetricMetadata("/tensorstore/kvstore/batch_read/requests",
+                   "Individual batch read requests before coalescing"),
+    "driver");
+
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    batch_read_coalesced_reads, (Counter<int64_t, std::string>),
+    MetricMetadata("/tensorstore/kvstore/batch_read/coalesced_reads",
+                   "Coalesced reads issued for batch read requests"),
+    "driver");
+
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    batch_read_queued, (Counter<int64_t, std::string>),
+    MetricMetadata("/tensorstore/kvstore/batch_read/queued",
+                   "Coalesced reads delayed by the in-flight limit"),
+    "driver");
+
+namespace {
+struct LaterDeadline {
+  template <typename T>
+  bool operator()(const T& a, const T& b) const {
+    if (a.deadline != b.deadline) return a.deadline > b.deadline;
+    return a.sequence > b.sequence;
+  }
+};
+}  // namespace
+
+CoalescedReadScheduler::CoalescedReadScheduler(std::string_view driver_name,
+                                               size_t max_in_flight)
+    : driver_name_(driver_name),
+      max_in_flight_(std::max<size_t>(1, max_in_flight)) {}
+
+size_t CoalescedReadScheduler::in_flight() const {
+  absl::MutexLock lock(mutex_);
+  return in_flight_;
+}
+
+size_t CoalescedReadScheduler::queued() const {
+  absl::MutexLock lock(mutex_);
+  return queue_.size();
+}
+
+void CoalescedReadScheduler::Schedule(Executor executor, absl::Time deadline,
+                                      size_t num_requests,
+                                      Operation operation) {
+  batch_read_requests.IncrementBy(num_requests, driver_name_);
+  batch_read_coalesced_reads.Increment(driver_name_);
+  {
+    absl::MutexLock lock(mutex_);
+    if (in_flight_ >= max_in_flight_) {
+      queue_.push_back(PendingOperation{deadline, next_sequence_++,
+                                        std::move(executor),
+                                        std::move(operation)});
+      std::push_heap(queue_.begin(), queue_.end(), LaterDeadline{});
+      batch_read_queued.Increment(driver_name_);
+      return;
+    }
+    ++in_flight_;
+  }
+  Run(std::move(operation));
+}
+
+void CoalescedReadScheduler::Run(Operation operation) {
+  AnyFuture future = std::move(operation)();
+  if (future.ready()) {
+    OnComplete();
+    return;
+  }
+  future.UntypedExecuteWhenReady(
+      [self = internal::IntrusivePtr<CoalescedReadScheduler>(this)](
+          AnyFuture future) { self->OnComplete(); });
+}
+
+void CoalescedReadScheduler::OnComplete() {
+  PendingOperation pending;
+  {
+    absl::MutexLock lock(mutex_);
+    if (!PopLocked(pending)) return;
+  }
+  // The completing thread may be, e.g., an HTTP transport or io_uring
+  // completion thread, which must not be used to issue further reads.
+  pending.executor(
+      [self = internal::IntrusivePtr<CoalescedReadScheduler>(this),
+       operation = std::move(pending.operation)]() mutable {
+        self->Run(std::move(operation));
+      });
+}
+
+bool CoalescedReadScheduler::PopLocked(PendingOperation& pending) {
+  if (queue_.empty()) {
+    --in_flight_;
+    return false;
+  }
+  std::pop_heap(queue_.begin(), queue_.end(), LaterDeadline{});
+  pending = std::move(queue_.back());
+  queue_.pop_back();
+  return true;
+}
+
+}  // namespace internal_kvstore_batch
+}  // namespace tensorstore
@@ -0,0 +1,123 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_COALESCED_READ_SCHEDULER_H_
+#define TENSORSTORE_KVSTORE_COALESCED_READ_SCHEDULER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_kvstore_batch {
+
+/// Bounds the number of concurrent coalesced batch reads issued by a kvstore
+/// driver.
+///
+/// Coalesced reads from all batches, and therefore from all keys, share a
+/// single limit.  Reads that cannot be started immediately are queued and
+/// started in order of increasing deadline as earlier reads complete; reads
+/// with equal deadlines are started in the order in which they were scheduled.
+/// Queued reads are started on the executor specified when they were
+/// scheduled, rather than on the thread that completed the earlier read.
+///
+/// Since `kvstore::ReadOptions` does not specify a deadline, drivers pass the
+/// time at which the batch was submitted as the deadline; queued reads are
+/// therefore started in first-in, first-out order of their batches.
+///
+/// The scheduler also records the number of individual requests and the number
+/// of coalesced reads that satisfied them, per driver, under the
+/// `/tensorstore/kvstore/batch_read/` metrics; the ratio of the two is the
+/// achieved coalescing ratio.
+///
+/// A driver typically owns a single scheduler, see
+/// `GenericCoalescingBatchReadEntry`.
+class CoalescedReadScheduler
+    : public internal::AtomicReferenceCount<CoalescedReadScheduler> {
+ public:
+  /// Starts a single coalesced read, returning a future that becomes ready
+  /// when the read completes.
+  using Operation = absl::AnyInvocable<AnyFuture() &&>;
+
+  /// Constructs a scheduler.
+  ///
+  /// \param driver_name Driver identifier used as the metric field value.
+  /// \param max_in_flight Maximum number of concurrent reads.  A value of `0`
+  ///     is treated as `1`.
+  CoalescedReadScheduler(std::string_view driver_name, size_t max_in_flight);
+
+  /// Schedules a coalesced read that satisfies `num_requests` individual
+  /// requests.
+  ///
+  /// If fewer than `max_in_flight()` reads are outstanding, `operation` is
+  /// invoked immediately from the current thread.  Otherwise it is submitted
+  /// to `executor` once an earlier read completes.
+  void Schedule(Executor executor, absl::Time deadline, size_t num_requests,
+                Operation operation);
+
+  size_t max_in_flight() const { return max_in_flight_; }
+
+  /// Returns the number of reads that are currently outstanding.
+  size_t in_flight() const;
+
+  /// Returns the number of reads that are waiting to be started.
+  size_t queued() const;
+
+ private:
+  struct PendingOperation {
+    absl::Time deadline;
+    uint64_t sequence;
+    Executor executor;
+    Operation operation;
+  };
+
+  // Runs `operation`, which holds an in-flight slot.
+  void Run(Operation operation);
+
+  // Called when an outstanding read completes.  Transfers its in-flight slot
+  // to the next queued operation, if any, which is submitted to its executor.
+  void OnComplete();
+
+  // Removes the earliest-deadline queued operation.
+  //
+  // Returns `false`, and releases the in-flight slot held by the caller, if
+  // there are no queued operations.
+  bool PopLocked(PendingOperation& pending)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const std::string driver_name_;
+  const size_t max_in_flight_;
+
+  mutable absl::Mutex mutex_;
+  size_t in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
+  uint64_t next_sequence_ ABSL_GUARDED_BY(mutex_) = 0;
+  // Min-heap ordered by `(deadline, sequence)`.
+  std::vector<PendingOperation> queue_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace internal_kvstore_batch
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_COALESCED_READ_SCHEDULER_H_
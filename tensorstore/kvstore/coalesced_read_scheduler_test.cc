@@ -0,0 +1,187 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/coalesced_read_scheduler.h"
+
+#include <stdint.h>
+
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/metrics/collect.h"
+#include "tensorstore/internal/metrics/registry.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+
+namespace {
+
+using ::tensorstore::AnyFuture;
+using ::tensorstore::ExecutorTask;
+using ::tensorstore::InlineExecutor;
+using ::tensorstore::MakeReadyFuture;
+using ::tensorstore::Promise;
+using ::tensorstore::PromiseFuturePair;
+using ::tensorstore::internal::MakeIntrusivePtr;
+using ::tensorstore::internal_kvstore_batch::CoalescedReadScheduler;
+using ::tensorstore::internal_metrics::GetMetricRegistry;
+
+std::optional<int64_t> GetCounter(std::string_view name,
+                                  std::string_view driver) {
+  auto metric = GetMetricRegistry().Collect(name);
+  if (!metric) return std::nullopt;
+  for (const auto& value : metric->values) {
+    if (value.fields.size() == 1 && value.fields[0] == driver) {
+      return std::get<int64_t>(value.value);
+    }
+  }
+  return std::nullopt;
+}
+
+TEST(CoalescedReadSchedulerTest, LimitsInFlight) {
+  auto scheduler = MakeIntrusivePtr<CoalescedReadScheduler>("limit", 2);
+  // Reserved so that completing a promise does not invalidate it.
+  std::vector<Promise<void>> promises;
+  promises.reserve(4);
+  for (int i = 0; i < 4; ++i) {
+    scheduler->Schedule(InlineExecutor{}, absl::Now(), 1, [&]() -> AnyFuture {
+      auto pair = PromiseFuturePair<void>::Make();
+      promises.push_back(std::move(pair.promise));
+      return std::move(pair.future);
+    });
+  }
+  EXPECT_EQ(2, promises.size());
+  EXPECT_EQ(2, scheduler->in_flight());
+  EXPECT_EQ(2, scheduler->queued());
+
+  promises[0].SetResult(absl::OkStatus());
+  EXPECT_EQ(3, promises.size());
+  EXPECT_EQ(2, scheduler->in_flight());
+  EXPECT_EQ(1, scheduler->queued());
+
+  promises[1].SetResult(absl::OkStatus());
+  promises[2].SetResult(absl::OkStatus());
+  EXPECT_EQ(4, promises.size());
+  EXPECT_EQ(1, scheduler->in_flight());
+  EXPECT_EQ(0, scheduler->queued());
+
+  promises[3].SetResult(absl::UnknownError("failed"));
+  EXPECT_EQ(0, scheduler->in_flight());
+}
+
+TEST(CoalescedReadSchedulerTest, StartsQueuedReadsInDeadlineOrder) {
+  auto scheduler = MakeIntrusivePtr<CoalescedReadScheduler>("deadline", 1);
+  const absl::Time now = absl::Now();
+  std::vector<int> order;
+  std::vector<Promise<void>> promises;
+  promises.reserve(5);
+  const auto schedule = [&](int id, absl::Time deadline) {
+    scheduler->Schedule(InlineExecutor{}, deadline, 1, [&, id]() -> AnyFuture {
+      order.push_back(id);
+      auto pair = PromiseFuturePair<void>::Make();
+      promises.push_back(std::move(pair.promise));
+      return std::move(pair.future);
+    });
+  };
+  schedule(0, now + absl::Seconds(10));
+  schedule(1, now + absl::Seconds(3));
+  schedule(2, now + absl::Seconds(1));
+  schedule(3, now + absl::Seconds(3));
+  schedule(4, now + absl::Seconds(2));
+
+  for (size_t i = 0; i < promises.size(); ++i) {
+    promises[i].SetResult(absl::OkStatus());
+  }
+  EXPECT_THAT(order, ::testing::ElementsAre(0, 2, 4, 1, 3));
+  EXPECT_EQ(0, scheduler->in_flight());
+}
+
+TEST(CoalescedReadSchedulerTest, SynchronousCompletion) {
+  auto scheduler = MakeIntrusivePtr<CoalescedReadScheduler>("sync", 1);
+  int count = 0;
+  for (int i = 0; i < 1000; ++i) {
+    scheduler->Schedule(InlineExecutor{}, absl::Now(), 1, [&]() -> AnyFuture {
+      ++count;
+      return MakeReadyFuture();
+    });
+  }
+  EXPECT_EQ(1000, count);
+  EXPECT_EQ(0, scheduler->in_flight());
+  EXPECT_EQ(0, scheduler->queued());
+}
+
+TEST(CoalescedReadSchedulerTest, QueuedReadsStartOnExecutor) {
+  auto scheduler = MakeIntrusivePtr<CoalescedReadScheduler>("executor", 1);
+  std::vector<ExecutorTask> tasks;
+  auto executor = [&](ExecutorTask task) { tasks.push_back(std::move(task)); };
+  Promise<void> promise;
+  int started = 0;
+  for (int i = 0; i < 2; ++i) {
+    scheduler->Schedule(executor, absl::Now(), 1, [&]() -> AnyFuture {
+      ++started;
+      auto pair = PromiseFuturePair<void>::Make();
+      promise = std::move(pair.promise);
+      return std::move(pair.future);
+    });
+  }
+  EXPECT_EQ(1, started);
+  EXPECT_TRUE(tasks.empty());
+
+  // Completing the first read submits the second to the executor rather than
+  // starting it on the completing thread.
+  promise.SetResult(absl::OkStatus());
+  EXPECT_EQ(1, started);
+  ASSERT_EQ(1, tasks.size());
+  EXPECT_EQ(1, scheduler->in_flight());
+  std::move(tasks[0])();
+  EXPECT_EQ(2, started);
+
+  promise.SetResult(absl::OkStatus());
+  EXPECT_EQ(0, scheduler->in_flight());
+}
+
+TEST(CoalescedReadSchedulerTest, ZeroLimitIsTreatedAsOne) {
+  auto scheduler = MakeIntrusivePtr<CoalescedReadScheduler>("zero", 0);
+  EXPECT_EQ(1, scheduler->max_in_flight());
+}
+
+TEST(CoalescedReadSchedulerTest, Metrics) {
+  auto scheduler = MakeIntrusivePtr<CoalescedReadScheduler>("metrics", 1);
+  Promise<void> promise;
+  scheduler->Schedule(InlineExecutor{}, absl::Now(), 3, [&]() -> AnyFuture {
+    auto pair = PromiseFuturePair<void>::Make();
+    promise = std::move(pair.promise);
+    return std::move(pair.future);
+  });
+  scheduler->Schedule(InlineExecutor{}, absl::Now(), 2,
+                      [&]() -> AnyFuture { return MakeReadyFuture(); });
+  promise.SetResult(absl::OkStatus());
+
+  EXPECT_EQ(5, GetCounter("/tensorstore/kvstore/batch_read/requests",
+                          "metrics"));
+  EXPECT_EQ(2, GetCounter("/tensorstore/kvstore/batch_read/coalesced_reads",
+                          "metrics"));
+  EXPECT_EQ(1, GetCounter("/tensorstore/kvstore/batch_read/queued",
+                          "metrics"));
+}
+
+}  // namespace
@@ -88,6 +88,7 @@
 #include <atomic>
 #include <cassert>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -111,6 +112,7 @@
 #include "tensorstore/batch.h"
 #include "tensorstore/context.h"
 #include "tensorstore/internal/file_io_concurrency_resource.h"
+#include "tensorstore/internal/flat_cord_builder.h"
 #include "tensorstore/internal/global_initializer.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
@@ -121,6 +123,8 @@
 #include "tensorstore/internal/os/error_code.h"
 #include "tensorstore/internal/os/file_descriptor.h"
 #include "tensorstore/internal/os/file_info.h"
+#include "tensorstore/internal/os/hugepages.h"
+#include "tensorstore/internal/os/io_uring.h"
 #include "tensorstore/internal/os/memory_region.h"
 #include "tensorstore/internal/os/open_flags.h"
 #include "tensorstore/internal/path.h"
@@ -128,6 +132,7 @@
 #include "tensorstore/internal/uri/path.h"
 #include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/coalesced_read_scheduler.h"
 #include "tensorstore/kvstore/common_metrics.h"
 #include "tensorstore/kvstore/file/file_resource.h"
 #include "tensorstore/kvstore/file/util.h"
@@ -228,10 +233,11 @@ struct FileKeyValueStoreSpecData {
   Context::Resource<FileIoSyncResource> file_io_sync;
   Context::Resource<FileIoLockingResource> file_io_locking;
   Context::Resource<FileIoModeResource> file_io_mode;
+  Context::Resource<FileIoBatchReadCoalescing> file_io_batch_read_coalescing;
 
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
     return f(x.file_io_concurrency, x.file_io_sync, x.file_io_locking,
-             x.file_io_mode);
+             x.file_io_mode, x.file_io_batch_read_coalescing);
   };
 
   // TODO(jbms): Storing a UNIX path as a JSON string presents a challenge
@@ -258,7 +264,10 @@ struct FileKeyValueStoreSpecData {
       jb::Member(FileIoLockingResource::id,
                  jb::Projection<&FileKeyValueStoreSpecData::file_io_locking>()),
       jb::Member(FileIoModeResource::id,
-                 jb::Projection<&FileKeyValueStoreSpecData::file_io_mode>())
+                 jb::Projection<&FileKeyValueStoreSpecData::file_io_mode>()),
+      jb::Member(FileIoBatchReadCoalescing::id,
+                 jb::Projection<&FileKeyValueStoreSpecData::
+                                    file_io_batch_read_coalescing>())
       //
   );
 };
@@ -301,6 +310,10 @@ class FileKeyValueStore
 
   const Executor& executor() { return spec_.file_io_concurrency->executor; }
 
+  internal_kvstore_batch::CoalescedReadScheduler& batch_read_scheduler() {
+    return *batch_read_scheduler_;
+  }
+
   std::string DescribeKey(std::string_view key) override {
     return absl::StrCat("local file ", QuoteString(key));
   }
@@ -325,7 +338,13 @@ class FileKeyValueStore
     return *spec_.file_io_locking;
   }
 
+  internal_kvstore_batch::CoalescingOptions batch_read_coalescing() const {
+    return *spec_.file_io_batch_read_coalescing;
+  }
+
   FileKeyValueStoreSpecData spec_;
+  internal::IntrusivePtr<internal_kvstore_batch::CoalescedReadScheduler>
+      batch_read_scheduler_;
 };
 
 absl::Status ValidateKey(std::string_view key) {
@@ -402,7 +421,17 @@ class BatchReadTask final
     driver().executor()(
         [self = internal::IntrusivePtr<BatchReadTask>(
              // Acquire initial reference count.
-             this, internal::adopt_object_ref)] { self->ProcessBatch(); });
+             this, internal::adopt_object_ref),
+         submit_time = absl::Now()] { self->ProcessBatch(submit_time); });
+  }
+
+  // Returns `true` if any of `requests` still requires a result.  Requests may
+  // be cancelled while their read is queued by the `CoalescedReadScheduler`.
+  static bool AnyResultNeeded(tensorstore::span<Request> requests) {
+    return std::any_of(requests.begin(), requests.end(),
+                       [](const Request& request) {
+                         return request.promise.result_needed();
+                       });
   }
 
   Result<kvstore::ReadResult> DoByteRangeRead(ByteRange byte_range) {
@@ -424,7 +453,7 @@ class BatchReadTask final
     return kvstore::ReadResult::Value(*std::move(read_result), stamp_);
   }
 
-  void ProcessBatch() {
+  void ProcessBatch(absl::Time submit_time) {
     ABSL_LOG_IF(INFO, verbose_logging)
         << "BatchReadTask " << std::get<std::string>(batch_entry_key);
 
@@ -455,31 +484,55 @@ class BatchReadTask final
       case FileIoModeResource::IoMode::kDirect:
         PrepareDirectIoRead(requests);
         break;
+      case FileIoModeResource::IoMode::kIoUring:
+        if (HandleIoUringRead(requests, submit_time)) return;
+        break;
       case FileIoModeResource::IoMode::kDefault:
         break;
     }
 
+    // All reads are bounded by the driver's `CoalescedReadScheduler`.
+    auto& scheduler = driver().batch_read_scheduler();
+    const auto& executor = driver().executor();
+
     if (requests.size() == 1) {
-      // Perform single read immediately.
-      requests[0].promise.SetResult(
-          DoByteRangeRead(requests[0].byte_range.AsByteRange()));
+      // Perform single read immediately, if the scheduler permits.
+      scheduler.Schedule(
+          executor, submit_time, 1,
+          [self = internal::IntrusivePtr<BatchReadTask>(this),
+           request = tensorstore::span<Request>(requests)]() -> AnyFuture {
+            if (AnyResultNeeded(request)) {
+              request[0].promise.SetResult(
+                  self->DoByteRangeRead(request[0].byte_range.AsByteRange()));
+            }
+            return MakeReadyFuture();
+          });
       return;
     }
 
-    const auto& executor = driver().executor();
-
-    internal_kvstore_batch::CoalescingOptions coalescing_options;
-    coalescing_options.max_extra_read_bytes = 255;
     internal_kvstore_batch::ForEachCoalescedRequest<Request>(
-        requests, coalescing_options,
+        requests, driver().batch_read_coalescing(),
         [&](OptionalByteRangeRequest coalesced_byte_range,
             tensorstore::span<Request> coalesced_requests) {
-          auto self = internal::IntrusivePtr<BatchReadTask>(this);
-          executor([self = std::move(self), coalesced_byte_range,
-                    coalesced_requests] {
-            self->ProcessCoalescedRead(coalesced_byte_range.AsByteRange(),
-                                       coalesced_requests);
-          });
+          scheduler.Schedule(
+              executor, submit_time, coalesced_requests.size(),
+              [self = internal::IntrusivePtr<BatchReadTask>(this),
+               byte_range = coalesced_byte_range.AsByteRange(),
+               coalesced_requests]() -> AnyFuture {
+                if (!AnyResultNeeded(coalesced_requests)) {
+                  return MakeReadyFuture();
+                }
+                // The future becomes ready, releasing the scheduler slot, once
+                // the task holding `promise` has performed the read.
+                auto [promise, future] =
+                    PromiseFuturePair<void>::Make(absl::OkStatus());
+                self->driver().executor()([self, byte_range,
+                                           coalesced_requests,
+                                           promise = std::move(promise)] {
+                  self->ProcessCoalescedRead(byte_range, coalesced_requests);
+                });
+                return std::move(future);
+              });
         });
   }
 
@@ -551,6 +604,112 @@ class BatchReadTask final
     ABSL_LOG_FIRST_N(WARNING, 1) << "Failed to set Direct IO: " << status;
   }
 
+  // State of a single coalesced read submitted via io_uring.  Short reads are
+  // resubmitted until the buffer is full or EOF is reached.
+  struct IoUringRead {
+    internal::IntrusivePtr<BatchReadTask> self;
+    internal_os::IoUring* ring;
+    ByteRange byte_range;
+    tensorstore::span<Request> requests;
+    internal::FlatCordBuilder buffer;
+    absl::Time start_time;
+    // Released once the read completes, which allows the
+    // `CoalescedReadScheduler` to start the next queued read.
+    Promise<void> promise;
+  };
+
+  // Submits all reads to the shared io_uring instance, so that no
+  // `file_io_concurrency` thread is held while the reads are outstanding.
+  // Returns `false` if io_uring is unavailable.
+  bool HandleIoUringRead(tensorstore::span<Request> requests,
+                         absl::Time submit_time) {
+    auto ring = internal_os::GetIoUring();
+    if (!ring.ok()) {
+      ABSL_LOG_FIRST_N(WARNING, 1)
+          << "io_uring unavailable, using default file io: " << ring.status();
+      return false;
+    }
+    internal_kvstore_batch::ForEachCoalescedRequest<Request>(
+        requests, driver().batch_read_coalescing(),
+        [&](OptionalByteRangeRequest coalesced_byte_range,
+            tensorstore::span<Request> coalesced_requests) {
+          driver().batch_read_scheduler().Schedule(
+              driver().executor(), submit_time, coalesced_requests.size(),
+              [self = internal::IntrusivePtr<BatchReadTask>(this),
+               ring = *ring, byte_range = coalesced_byte_range.AsByteRange(),
+               coalesced_requests]() mutable -> AnyFuture {
+                if (!AnyResultNeeded(coalesced_requests)) {
+                  return MakeReadyFuture();
+                }
+                auto [promise, future] =
+                    PromiseFuturePair<void>::Make(absl::OkStatus());
+                file_metrics.batch_read.Increment();
+                IssueIoUringRead(std::unique_ptr<IoUringRead>(new IoUringRead{
+                    std::move(self), ring, byte_range, coalesced_requests,
+                    internal::FlatCordBuilder(
+                        internal_os::AllocateHugePageRegionWithFallback(
+                            0, byte_range.size()),
+                        0),
+                    absl::Now(), std::move(promise)}));
+                return std::move(future);
+              });
+        });
+    return true;
+  }
+
+  static void IssueIoUringRead(std::unique_ptr<IoUringRead> state) {
+    auto* s = state.get();
+    if (s->buffer.available() == 0) {
+      CompleteIoUringRead(std::move(state), absl::OkStatus());
+      return;
+    }
+    const int64_t offset = s->byte_range.inclusive_min +
+                           (s->buffer.size() - s->buffer.available());
+    auto span = s->buffer.available_span();
+    s->ring->Read(
+        s->self->fd_.get(), span.data(), span.size(), offset,
+        [state = std::move(state)](Result<int64_t> n) mutable {
+          if (n.ok() && *n > 0) {
+            state->buffer.set_inuse(state->buffer.size() -
+                                    state->buffer.available() + *n);
+            if (state->buffer.available() > 0) {
+              IssueIoUringRead(std::move(state));
+              return;
+            }
+          } else if (n.ok()) {
+            n = absl::UnavailableError(
+                "Unexpected EOF encountered reading from file.");
+          }
+          // Resolving the promises may run arbitrary continuations, which
+          // must not run on the io_uring completion thread.
+          const auto& executor = state->self->driver().executor();
+          executor([state = std::move(state),
+                    status = n.status()]() mutable {
+            CompleteIoUringRead(std::move(state), std::move(status));
+          });
+        });
+  }
+
+  static void CompleteIoUringRead(std::unique_ptr<IoUringRead> state,
+                                  absl::Status status) {
+    auto& self = *state->self;
+    file_metrics.read_latency_ms.Observe(
+        absl::ToInt64Milliseconds(absl::Now() - state->start_time));
+    if (!status.ok()) {
+      internal_kvstore_batch::SetCommonResult(
+          state->requests,
+          StatusBuilder(std::move(status))
+              .Format("Error reading from open file %s",
+                      std::get<std::string>(self.batch_entry_key)));
+      return;
+    }
+    file_metrics.bytes_read.IncrementBy(state->byte_range.size());
+    internal_kvstore_batch::ResolveCoalescedRequests(
+        state->byte_range, state->requests,
+        kvstore::ReadResult::Value(std::move(state->buffer).Build(),
+                                   self.stamp_));
+  }
+
   void ProcessCoalescedRead(ByteRange coalesced_byte_range,
                             tensorstore::span<Request> coalesced_requests) {
     TENSORSTORE_ASSIGN_OR_RETURN(auto read_result,
@@ -595,6 +754,101 @@ absl::Status WriteWithSync(FileDescriptor fd, const std::string& fd_path,
   return absl::OkStatus();
 }
 
+/// Returns the generation of the current value of `full_path`.
+Result<StorageGeneration> GetValueGeneration(const std::string& full_path) {
+  StorageGeneration generation;
+  TENSORSTORE_ASSIGN_OR_RETURN(UniqueFileDescriptor value_fd,
+                               OpenValueFile(full_path, &generation));
+  TENSORSTORE_RETURN_IF_ERROR(std::move(value_fd).Close());
+  return generation;
+}
+
+/// Parent directory and lock held while a value is written.
+struct PreparedWrite {
+  UniqueFileDescriptor dir_fd;
+  internal_os::FileLock lock_helper;
+};
+
+/// Releases the lock and parent directory acquired by `PrepareWrite`, and
+/// returns `status` updated with any error closing them.
+absl::Status FinishWrite(PreparedWrite prepared, bool delete_lock_file,
+                         absl::Status status) {
+  if (delete_lock_file) {
+    // Delete the lock file, allowing another writer to acquire it.
+    // This is somewhat best-effort; the lock file may already be deleted
+    // if the directory was concurrently removed, for example.
+    // The delete status is *not* returned as an error because the primary
+    // operation (writing to the lock file) succeeded.
+    auto delete_status = std::move(prepared.lock_helper).Delete();
+    ABSL_LOG_IF(INFO, !delete_status.ok() && verbose_logging)
+        << "Delete: " << delete_status;
+  } else {
+    // Close the lock file.
+    status.Update(std::move(prepared.lock_helper).Close());
+  }
+  status.Update(std::move(prepared.dir_fd).Close());
+  return status;
+}
+
+/// Opens the parent directory of `full_path`, acquires the lock for writing
+/// it, and checks the generation condition.  Returns `std::nullopt` if the
+/// condition is not satisfied.
+Result<std::optional<PreparedWrite>> PrepareWrite(
+    const std::string& full_path, const kvstore::WriteOptions& options,
+    const FileIoLockingResource::Spec& file_io_locking) {
+  TENSORSTORE_ASSIGN_OR_RETURN(auto dir_fd, OpenParentDirectory(full_path));
+
+  const bool is_non_atomic_mode =
+      file_io_locking.mode == FileIoLockingResource::LockingMode::non_atomic;
+  if (is_non_atomic_mode &&
+      !StorageGeneration::IsUnknown(options.generation_conditions.if_equal)) {
+    TENSORSTORE_ASSIGN_OR_RETURN(auto generation,
+                                 GetValueGeneration(full_path));
+    if (generation != options.generation_conditions.if_equal) {
+      return std::nullopt;
+    }
+  }
+
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto lock_helper, [&]() -> Result<internal_os::FileLock> {
+        switch (file_io_locking.mode) {
+          case FileIoLockingResource::LockingMode::non_atomic: {
+            return TruncateAndOverwrite(full_path);
+          }
+          case FileIoLockingResource::LockingMode::none: {
+            // This will generate a unique "lock" file without waiting or
+            // attempting to cleanup.
+            absl::InsecureBitGen rng;
+            uint64_t x = absl::Uniform<uint64_t>(rng);
+            return AcquireExclusiveFile(
+                absl::StrCat(full_path, "_", absl::Hex(x), kLockSuffix),
+                absl::ZeroDuration());
+          }
+          case FileIoLockingResource::LockingMode::os:
+            return AcquireFileLock(absl::StrCat(full_path, kLockSuffix));
+          case FileIoLockingResource::LockingMode::lockfile:
+            return AcquireExclusiveFile(absl::StrCat(full_path, kLockSuffix),
+                                        file_io_locking.acquire_timeout);
+        }
+        ABSL_UNREACHABLE();
+      }());
+  PreparedWrite prepared{std::move(dir_fd), std::move(lock_helper)};
+
+  // Check condition.
+  if (!is_non_atomic_mode &&
+      !StorageGeneration::IsUnknown(options.generation_conditions.if_equal)) {
+    auto generation = GetValueGeneration(full_path);
+    if (!generation.ok() ||
+        *generation != options.generation_conditions.if_equal) {
+      TENSORSTORE_RETURN_IF_ERROR(FinishWrite(std::move(prepared),
+                                              /*delete_lock_file=*/true,
+                                              generation.status()));
+      return std::nullopt;
+    }
+  }
+  return prepared;
+}
+
 /// Implements `FileKeyValueStore::Write`.
 struct WriteTask {
   std::string full_path;
@@ -607,62 +861,17 @@ struct WriteTask {
     ABSL_LOG_IF(INFO, verbose_logging) << "WriteTask " << full_path;
     TimestampedStorageGeneration r;
     r.time = absl::Now();
-    TENSORSTORE_ASSIGN_OR_RETURN(auto dir_fd, OpenParentDirectory(full_path));
-
-    const bool is_non_atomic_mode =
-        file_io_locking.mode == FileIoLockingResource::LockingMode::non_atomic;
-    if (is_non_atomic_mode &&
-        !StorageGeneration::IsUnknown(options.generation_conditions.if_equal)) {
-      StorageGeneration generation;
-      TENSORSTORE_ASSIGN_OR_RETURN(UniqueFileDescriptor value_fd,
-                                   OpenValueFile(full_path, &generation));
-      TENSORSTORE_RETURN_IF_ERROR(std::move(value_fd).Close());
-      if (generation != options.generation_conditions.if_equal) {
-        r.generation = StorageGeneration::Unknown();
-        return r;
-      }
-    }
-
     TENSORSTORE_ASSIGN_OR_RETURN(
-        auto lock_helper, [&]() -> Result<internal_os::FileLock> {
-          switch (file_io_locking.mode) {
-            case FileIoLockingResource::LockingMode::non_atomic: {
-              return TruncateAndOverwrite(full_path);
-            }
-            case FileIoLockingResource::LockingMode::none: {
-              // This will generate a unique "lock" file without waiting or
-              // attempting to cleanup.
-              absl::InsecureBitGen rng;
-              uint64_t x = absl::Uniform<uint64_t>(rng);
-              return AcquireExclusiveFile(
-                  absl::StrCat(full_path, "_", absl::Hex(x), kLockSuffix),
-                  absl::ZeroDuration());
-            }
-            case FileIoLockingResource::LockingMode::os:
-              return AcquireFileLock(absl::StrCat(full_path, kLockSuffix));
-            case FileIoLockingResource::LockingMode::lockfile:
-              return AcquireExclusiveFile(absl::StrCat(full_path, kLockSuffix),
-                                          file_io_locking.acquire_timeout);
-          }
-          ABSL_UNREACHABLE();
-        }());
+        auto prepared, PrepareWrite(full_path, options, file_io_locking));
+    if (!prepared) {
+      r.generation = StorageGeneration::Unknown();
+      return r;
+    }
+    const auto& lock_helper = prepared->lock_helper;
 
     bool delete_lock_file = true;
 
     absl::Status status = [&]() -> absl::Status {
-      // Check condition.
-      if (!is_non_atomic_mode && !StorageGeneration::IsUnknown(
-                                     options.generation_conditions.if_equal)) {
-        StorageGeneration generation;
-        TENSORSTORE_ASSIGN_OR_RETURN(UniqueFileDescriptor value_fd,
-                                     OpenValueFile(full_path, &generation));
-        TENSORSTORE_RETURN_IF_ERROR(std::move(value_fd).Close());
-        if (generation != options.generation_conditions.if_equal) {
-          r.generation = StorageGeneration::Unknown();
-          return absl::OkStatus();
-        }
-      }
-
       TENSORSTORE_RETURN_IF_ERROR(WriteWithSync(
           lock_helper.fd(), lock_helper.lock_path(), value, sync));
       // Stat and Rename
@@ -679,33 +888,172 @@ struct WriteTask {
       r.generation = GetFileGeneration(info);
       if (sync) {
         // fsync the parent directory to ensure the `rename` is durable.
-        TENSORSTORE_RETURN_IF_ERROR(internal_os::FsyncDirectory(dir_fd.get()))
+        TENSORSTORE_RETURN_IF_ERROR(
+            internal_os::FsyncDirectory(prepared->dir_fd.get()))
             .Format("Error calling fsync on parent directory of: %s",
                     full_path);
       }
       return absl::OkStatus();
     }();
 
-    if (delete_lock_file) {
-      // Delete the lock file, allowing another writer to acquire it.
-      // This is somewhat best-effort; the lock file may already be deleted
-      // if the directory was concurrently removed, for example.
-      // The delete status is *not* returned as an error because the primary
-      // operation (writing to the lock file) succeeded.
-      auto delete_status = std::move(lock_helper).Delete();
-      ABSL_LOG_IF(INFO, !delete_status.ok() && verbose_logging)
-          << "Delete: " << delete_status;
-    } else {
-      // Close the lock file.
-      status.Update(std::move(lock_helper).Close());
-    }
-    status.Update(std::move(dir_fd).Close());
+    // If status is absl::NotFound error, that likely means that the rename
+    // failed.
+    TENSORSTORE_RETURN_IF_ERROR(
+        FinishWrite(*std::move(prepared), delete_lock_file, std::move(status)));
+    return r;
+  }
+};
+
+/// Implements `FileKeyValueStore::Write` in `io_uring` mode.
+///
+/// The lock is acquired and the condition checked on the executor, as by
+/// `WriteTask`.  The value is then written and synced, renamed into place, and
+/// the parent directory synced by io_uring operations, so that no
+/// `file_io_concurrency` thread is held while they are outstanding.
+struct IoUringWriteTask {
+  WriteTask task;
+  internal_os::IoUring* ring;
+  Executor executor;
+  Promise<TimestampedStorageGeneration> promise;
+  std::optional<PreparedWrite> prepared;
+  // Portion of the value not yet written, and its offset in the lock file.
+  absl::Cord remaining;
+  int64_t offset = 0;
+  absl::Time start_write;
+  FileInfo info;
+  bool delete_lock_file = true;
+  TimestampedStorageGeneration r;
+
+  using Step = void (*)(std::unique_ptr<IoUringWriteTask>, absl::Status);
+
+  // Runs `step` on the executor; blocking calls and promise continuations
+  // must not run on the io_uring completion thread.
+  static void Continue(std::unique_ptr<IoUringWriteTask> state,
+                       absl::Status status, Step step) {
+    Executor executor = state->executor;
+    executor([state = std::move(state), status = std::move(status),
+              step]() mutable { step(std::move(state), std::move(status)); });
+  }
+
+  // Acquires the lock.  Runs on the executor.
+  static void Start(std::unique_ptr<IoUringWriteTask> state) {
+    const auto& task = state->task;
+    ABSL_LOG_IF(INFO, verbose_logging) << "IoUringWriteTask " << task.full_path;
+    state->r.time = absl::Now();
+    auto prepared =
+        PrepareWrite(task.full_path, task.options, task.file_io_locking);
+    if (!prepared.ok()) {
+      state->promise.SetResult(std::move(prepared).status());
+      return;
+    }
+    if (!*prepared) {
+      state->r.generation = StorageGeneration::Unknown();
+      state->promise.SetResult(std::move(state->r));
+      return;
+    }
+    state->prepared = **std::move(prepared);
+    state->remaining = task.value;
+    state->start_write = absl::Now();
+    WriteValue(std::move(state));
+  }
+
+  // Writes the remaining value to the lock file, then syncs it.
+  static void WriteValue(std::unique_ptr<IoUringWriteTask> state) {
+    auto* s = state.get();
+    const FileDescriptor fd = s->prepared->lock_helper.fd();
+    if (s->remaining.empty()) {
+      if (!s->task.sync) {
+        Continue(std::move(state), absl::OkStatus(), &RenameValue);
+        return;
+      }
+      s->ring->Fsync(fd, [state = std::move(state)](Result<int64_t> n) mutable {
+        Continue(std::move(state), n.status(), &RenameValue);
+      });
+      return;
+    }
+    std::string_view chunk = *s->remaining.chunk_begin();
+    s->ring->Write(
+        fd, chunk.data(), chunk.size(), s->offset,
+        [state = std::move(state)](Result<int64_t> n) mutable {
+          if (!n.ok()) {
+            absl::Status status = StatusBuilder(n.status()).Format(
+                "Failed writing: %v",
+                QuoteString(state->prepared->lock_helper.lock_path()));
+            Continue(std::move(state), std::move(status), &Finish);
+            return;
+          }
+          file_metrics.bytes_written.IncrementBy(*n);
+          state->remaining.RemovePrefix(*n);
+          state->offset += *n;
+          WriteValue(std::move(state));
+        });
+  }
+
+  // Renames the lock file into place.  Runs on the executor.
+  static void RenameValue(std::unique_ptr<IoUringWriteTask> state,
+                          absl::Status status) {
     if (!status.ok()) {
-      // If status is absl::NotFound error, that likely means that the rename
-      // failed.
-      return status;
+      Finish(std::move(state), std::move(status));
+      return;
     }
-    return r;
+    file_metrics.write_latency_ms.Observe(
+        absl::ToInt64Milliseconds(absl::Now() - state->start_write));
+    const auto& lock_helper = state->prepared->lock_helper;
+    status = internal_os::GetFileInfo(lock_helper.fd(), &state->info);
+    if (!status.ok()) {
+      Finish(std::move(state), std::move(status));
+      return;
+    }
+    if (lock_helper.lock_path() == state->task.full_path) {
+      Renamed(std::move(state));
+      return;
+    }
+    auto* s = state.get();
+    s->ring->Rename(
+        lock_helper.lock_path(), s->task.full_path,
+        [state = std::move(state)](Result<int64_t> n) mutable {
+          if (!n.ok()) {
+            absl::Status status = StatusBuilder(n.status()).Format(
+                "Failed to rename: %v to: %v",
+                QuoteString(state->prepared->lock_helper.lock_path()),
+                QuoteString(state->task.full_path));
+            Continue(std::move(state), std::move(status), &Finish);
+            return;
+          }
+          Renamed(std::move(state));
+        });
+  }
+
+  // Syncs the parent directory to ensure the `rename` is durable.
+  static void Renamed(std::unique_ptr<IoUringWriteTask> state) {
+    state->delete_lock_file = false;
+    state->r.generation = GetFileGeneration(state->info);
+    if (!state->task.sync) {
+      Continue(std::move(state), absl::OkStatus(), &Finish);
+      return;
+    }
+    auto* s = state.get();
+    s->ring->Fsync(
+        s->prepared->dir_fd.get(),
+        [state = std::move(state)](Result<int64_t> n) mutable {
+          absl::Status status =
+              StatusBuilder(n.status())
+                  .Format("Error calling fsync on parent directory of: %s",
+                          state->task.full_path);
+          Continue(std::move(state), std::move(status), &Finish);
+        });
+  }
+
+  // Releases the lock and resolves the promise.  Runs on the executor.
+  static void Finish(std::unique_ptr<IoUringWriteTask> state,
+                     absl::Status status) {
+    status = FinishWrite(*std::move(state->prepared), state->delete_lock_file,
+                         std::move(status));
+    if (!status.ok()) {
+      state->promise.SetResult(std::move(status));
+      return;
+    }
+    state->promise.SetResult(std::move(state->r));
   }
 };
 
@@ -781,9 +1129,21 @@ Future<TimestampedStorageGeneration> FileKeyValueStore::Write(
   file_metrics.write.Increment();
   TENSORSTORE_RETURN_IF_ERROR(ValidateKey(key));
   if (value) {
-    return MapFuture(executor(),
-                     WriteTask{std::move(key), std::move(*value),
-                               std::move(options), sync(), file_io_locking()});
+    WriteTask task{std::move(key), std::move(*value), std::move(options),
+                   sync(), file_io_locking()};
+    if (file_io_mode() == FileIoModeResource::IoMode::kIoUring) {
+      if (auto ring = internal_os::GetIoUring(); ring.ok()) {
+        auto [promise, future] =
+            PromiseFuturePair<TimestampedStorageGeneration>::Make();
+        auto state = std::unique_ptr<IoUringWriteTask>(new IoUringWriteTask{
+            std::move(task), *ring, executor(), std::move(promise)});
+        executor()([state = std::move(state)]() mutable {
+          IoUringWriteTask::Start(std::move(state));
+        });
+        return std::move(future);
+      }
+    }
+    return MapFuture(executor(), std::move(task));
   } else {
     return MapFuture(executor(), DeleteTask{std::move(key), std::move(options),
                                             sync(), file_io_locking()});
@@ -907,6 +1267,10 @@ void FileKeyValueStore::ListImpl(ListOptions options, ListReceiver receiver) {
 Future<kvstore::DriverPtr> FileKeyValueStoreSpec::DoOpen() const {
   auto driver_ptr = internal::MakeIntrusivePtr<FileKeyValueStore>();
   driver_ptr->spec_ = data_;
+  driver_ptr->batch_read_scheduler_ = internal::MakeIntrusivePtr<
+      internal_kvstore_batch::CoalescedReadScheduler>(
+      FileKeyValueStoreSpec::id,
+      data_.file_io_batch_read_coalescing->max_concurrent_reads);
   return driver_ptr;
 }
 
@@ -922,6 +1286,8 @@ Result<kvstore::Spec> ParseFileUrl(std::string_view url) {
       Context::Resource<FileIoLockingResource>::DefaultSpec();
   driver_spec->data_.file_io_mode =
       Context::Resource<FileIoModeResource>::DefaultSpec();
+  driver_spec->data_.file_io_batch_read_coalescing =
+      Context::Resource<FileIoBatchReadCoalescing>::DefaultSpec();
 
   return {std::in_place, std::move(driver_spec), std::move(path)};
 }
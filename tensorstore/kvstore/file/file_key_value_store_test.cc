@@ -193,6 +193,29 @@ TENSORSTORE_GLOBAL_INITIALIZER {
           };
         },
         params);
+#endif
+#ifdef __linux__
+    register_with_spec(
+        "IoUring",
+        [](std::string path) -> ::nlohmann::json {
+          return {
+              {"driver", "file"},
+              {"path", path},
+              {"file_io_mode", {{"mode", "io_uring"}}},
+          };
+        },
+        params);
+    register_with_spec(
+        "IoUringNoRename",
+        [](std::string path) -> ::nlohmann::json {
+          return {
+              {"driver", "file"},
+              {"path", path},
+              {"file_io_mode", {{"mode", "io_uring"}}},
+              {"file_io_locking", {{"mode", "non_atomic"}}},
+          };
+        },
+        params);
 #endif
     {
       auto p = params;
@@ -480,6 +503,7 @@ TEST(FileKeyValueStoreTest, SpecRoundtripSync) {
       {"file_io_sync", false},
       {"context",
        {
+           {"file_io_batch_read_coalescing", ::nlohmann::json::object_t()},
            {"file_io_concurrency", ::nlohmann::json::object_t()},
            {"file_io_mode", ::nlohmann::json::object_t()},
            {"file_io_locking", {{"mode", "lockfile"}}},
@@ -594,8 +618,28 @@ TEST(FileKeyValueStoreTest, BatchRead) {
   ScopedTemporaryDirectory tempdir;
   auto store = GetStore(tempdir.path());
 
+  tensorstore::internal::BatchReadGenericCoalescingTestOptions options;
+  options.coalescing_options =
+      tensorstore::internal_kvstore_batch::kLocalFileCoalescingOptions;
+  options.metric_prefix = "/tensorstore/kvstore/file/";
+  options.has_file_open_metric = true;
+  tensorstore::internal::TestBatchReadGenericCoalescing(store, options);
+}
+
+TEST(FileKeyValueStoreTest, BatchReadCoalescingResource) {
+  ScopedTemporaryDirectory tempdir;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "file"},
+                     {"path", tempdir.path() + "/"},
+                     {"file_io_batch_read_coalescing",
+                      {{"max_extra_read_bytes", 255},
+                       {"target_coalesced_size", 4096}}}})
+          .result());
+
   tensorstore::internal::BatchReadGenericCoalescingTestOptions options;
   options.coalescing_options.max_extra_read_bytes = 255;
+  options.coalescing_options.target_coalesced_size = 4096;
   options.metric_prefix = "/tensorstore/kvstore/file/";
   options.has_file_open_metric = true;
   tensorstore::internal::TestBatchReadGenericCoalescing(store, options);
@@ -24,6 +24,8 @@
 #include "tensorstore/internal/json_binding/bindable.h"
 #include "tensorstore/internal/json_binding/enum.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/kvstore/batch_read_coalescing_resource.h"
+#include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/util/result.h"
 
 namespace tensorstore {
@@ -131,6 +133,9 @@ struct FileIoModeResource
 
     /// Use direct io.
     kDirect,
+
+    /// Use asynchronous io_uring reads and writes (Linux only).
+    kIoUring,
   };
 
   struct Spec {
@@ -154,6 +159,7 @@ struct FileIoModeResource
                 {IoMode::kDefault, "default"},
                 {IoMode::kMemmap, "memmap"},
                 {IoMode::kDirect, "direct"},
+                {IoMode::kIoUring, "io_uring"},
             }))))
                       /**/);
   }
@@ -168,6 +174,16 @@ struct FileIoModeResource
   }
 };
 
+/// Specifies how batch reads are coalesced by the "file" kvstore.
+struct FileIoBatchReadCoalescing
+    : public internal_kvstore_batch::BatchReadCoalescingResource<
+          FileIoBatchReadCoalescing> {
+  static constexpr char id[] = "file_io_batch_read_coalescing";
+  static Spec Default() {
+    return internal_kvstore_batch::kLocalFileCoalescingOptions;
+  }
+};
+
 }  // namespace internal_file_kvstore
 }  // namespace tensorstore
 
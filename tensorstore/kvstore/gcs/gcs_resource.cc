@@ -33,4 +33,8 @@ const tensorstore::internal::ContextResourceRegistration<
     tensorstore::internal_storage_gcs::GcsRequestRetries>
     gcs_request_retries_registration;
 
+const tensorstore::internal::ContextResourceRegistration<
+    tensorstore::internal_storage_gcs::GcsBatchReadCoalescing>
+    gcs_batch_read_coalescing_registration;
+
 }  // namespace
@@ -22,6 +22,8 @@
 #include "tensorstore/context_resource_provider.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/retries_context_resource.h"
+#include "tensorstore/kvstore/batch_read_coalescing_resource.h"
+#include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/util/result.h"
 
 namespace tensorstore {
@@ -65,6 +67,16 @@ struct GcsRequestRetries : public internal::RetriesResource<GcsRequestRetries> {
   static constexpr char id[] = "gcs_request_retries";
 };
 
+/// Specifies how batch reads are coalesced.
+struct GcsBatchReadCoalescing
+    : public internal_kvstore_batch::BatchReadCoalescingResource<
+          GcsBatchReadCoalescing> {
+  static constexpr char id[] = "gcs_batch_read_coalescing";
+  static Spec Default() {
+    return internal_kvstore_batch::kGcsCoalescingOptions;
+  }
+};
+
 }  // namespace internal_storage_gcs
 }  // namespace tensorstore
 
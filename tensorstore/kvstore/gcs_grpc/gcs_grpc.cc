@@ -52,6 +52,7 @@
 #include "tensorstore/internal/thread/schedule_at.h"
 #include "tensorstore/internal/uri/parse.h"
 #include "tensorstore/internal/uri/percent_coder.h"
+#include "tensorstore/kvstore/coalesced_read_scheduler.h"
 #include "tensorstore/kvstore/common_metrics.h"
 #include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/gcs/exp_credentials_resource.h"
@@ -164,6 +165,9 @@ TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
             jb::Projection<&GcsGrpcKeyValueStoreSpecData::user_project>()),
         jb::Member(internal_storage_gcs::GcsRequestRetries::id,
                    jb::Projection<&GcsGrpcKeyValueStoreSpecData::retries>()),
+        jb::Member(GcsBatchReadCoalescing::id,
+                   jb::Projection<
+                       &GcsGrpcKeyValueStoreSpecData::batch_read_coalescing>()),
         jb::Member(DataCopyConcurrencyResource::id,
                    jb::Projection<
                        &GcsGrpcKeyValueStoreSpecData::data_copy_concurrency>()),
@@ -343,6 +347,10 @@ Future<kvstore::DriverPtr> GcsGrpcKeyValueStoreSpec::DoOpen() const {
   auto driver = internal::MakeIntrusivePtr<GcsGrpcKeyValueStore>();
   driver->spec_ = data_;
   driver->bucket_ = absl::StrFormat("projects/_/buckets/%s", data_.bucket);
+  driver->batch_read_scheduler_ = internal::MakeIntrusivePtr<
+      internal_kvstore_batch::CoalescedReadScheduler>(
+      GcsGrpcKeyValueStoreSpec::id,
+      data_.batch_read_coalescing->max_concurrent_reads);
 
   // Use direct path endpoint by default when running on a GCP machine.
   // https://github.com/googleapis/google-cloud-cpp/google/cloud/storage/internal/grpc/default_options.cc
@@ -394,6 +402,8 @@ Result<kvstore::Spec> ParseGcsGrpcUrl(std::string_view url) {
       Context::Resource<GcsUserProjectResource>::DefaultSpec();
   driver_spec->data_.retries =
       Context::Resource<internal_storage_gcs::GcsRequestRetries>::DefaultSpec();
+  driver_spec->data_.batch_read_coalescing =
+      Context::Resource<GcsBatchReadCoalescing>::DefaultSpec();
   driver_spec->data_.data_copy_concurrency =
       Context::Resource<DataCopyConcurrencyResource>::DefaultSpec();
   driver_spec->data_.credentials =
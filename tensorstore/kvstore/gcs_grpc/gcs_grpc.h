@@ -34,6 +34,7 @@
 #include "tensorstore/context.h"
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
 #include "tensorstore/internal/grpc/clientauth/authentication_strategy.h"
+#include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/bindable.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/source_location.h"
@@ -41,6 +42,7 @@
 #include "tensorstore/json_serialization_options.h"
 #include "tensorstore/json_serialization_options_base.h"
 #include "tensorstore/kvstore/batch_util.h"
+#include "tensorstore/kvstore/coalesced_read_scheduler.h"
 #include "tensorstore/kvstore/gcs/exp_credentials_resource.h"
 #include "tensorstore/kvstore/gcs/gcs_resource.h"
 #include "tensorstore/kvstore/gcs/validate.h"
@@ -74,6 +76,7 @@ namespace internal_gcs_grpc {
 
 using GcsUserProjectResource = internal_storage_gcs::GcsUserProjectResource;
 using GcsRequestRetries = internal_storage_gcs::GcsRequestRetries;
+using GcsBatchReadCoalescing = internal_storage_gcs::GcsBatchReadCoalescing;
 using ExperimentalGcsGrpcCredentials =
     internal_storage_gcs::ExperimentalGcsGrpcCredentials;
 using DataCopyConcurrencyResource = internal::DataCopyConcurrencyResource;
@@ -88,13 +91,14 @@ struct GcsGrpcKeyValueStoreSpecData {
   absl::Duration wait_for_connection = absl::ZeroDuration();
   Context::Resource<GcsUserProjectResource> user_project;
   Context::Resource<GcsRequestRetries> retries;
+  Context::Resource<GcsBatchReadCoalescing> batch_read_coalescing;
   Context::Resource<DataCopyConcurrencyResource> data_copy_concurrency;
   Context::Resource<ExperimentalGcsGrpcCredentials> credentials;
 
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
     return f(x.bucket, x.endpoint, x.num_channels, x.timeout,
              x.wait_for_connection, x.user_project, x.retries,
-             x.data_copy_concurrency, x.credentials);
+             x.batch_read_coalescing, x.data_copy_concurrency, x.credentials);
   };
 
   TENSORSTORE_INTERNAL_DECLARE_JSON_BINDER_IMPL(
@@ -137,7 +141,11 @@ class GcsGrpcKeyValueStore
  public:
   internal_kvstore_batch::CoalescingOptions GetBatchReadCoalescingOptions()
       const {
-    return internal_kvstore_batch::kDefaultRemoteStorageCoalescingOptions;
+    return *spec_.batch_read_coalescing;
+  }
+
+  internal_kvstore_batch::CoalescedReadScheduler& batch_read_scheduler() {
+    return *batch_read_scheduler_;
   }
 
   /// Key value store operations.
@@ -190,6 +198,8 @@ class GcsGrpcKeyValueStore
   std::string bucket_;
   std::shared_ptr<internal_grpc::GrpcAuthenticationStrategy> auth_strategy_;
   std::shared_ptr<StorageStubPool> storage_stub_pool_;
+  internal::IntrusivePtr<internal_kvstore_batch::CoalescedReadScheduler>
+      batch_read_scheduler_;
 };
 
 }  // namespace internal_gcs_grpc
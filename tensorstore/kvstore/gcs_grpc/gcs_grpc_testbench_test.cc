@@ -267,8 +267,8 @@ TEST(GcsGrpcTestbenchTest, BatchRead) {
   // Note: With server-side retries the metrics may not match. :/
   auto store = OpenStore("batch_read/");
   tensorstore::internal::BatchReadGenericCoalescingTestOptions options;
-  options.coalescing_options = tensorstore::internal_kvstore_batch::
-      kDefaultRemoteStorageCoalescingOptions;
+  options.coalescing_options =
+      tensorstore::internal_kvstore_batch::kGcsCoalescingOptions;
 
   // Don't test `target_coalesced_size` because writing a large file is too
   // slow with the fake gcs stubby implementation.
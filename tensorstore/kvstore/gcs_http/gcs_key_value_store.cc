@@ -46,6 +46,7 @@
 #include "tensorstore/internal/http/http_request.h"
 #include "tensorstore/internal/http/http_response.h"
 #include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/http/request_hedging.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json/json.h"
 #include "tensorstore/internal/json_binding/bindable.h"
@@ -65,6 +66,7 @@
 #include "tensorstore/internal/uri/percent_coder.h"
 #include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/coalesced_read_scheduler.h"
 #include "tensorstore/kvstore/common_metrics.h"
 #include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/gcs/gcs_resource.h"
@@ -130,9 +132,11 @@ using ::tensorstore::internal_http::HttpTransport;
 using ::tensorstore::internal_http::IssueRequestOptions;
 using ::tensorstore::internal_kvstore_gcs_http::GcsConcurrencyResource;
 using ::tensorstore::internal_kvstore_gcs_http::GcsRateLimiterResource;
+using ::tensorstore::internal_kvstore_gcs_http::GcsRequestHedging;
 using ::tensorstore::internal_kvstore_gcs_http::GetSharedGoogleAuthProvider;
 using ::tensorstore::internal_kvstore_gcs_http::ObjectMetadata;
 using ::tensorstore::internal_kvstore_gcs_http::ParseObjectMetadata;
+using ::tensorstore::internal_storage_gcs::GcsBatchReadCoalescing;
 using ::tensorstore::internal_storage_gcs::GcsHttpResponseToStatus;
 using ::tensorstore::internal_storage_gcs::GcsRequestRetries;
 using ::tensorstore::internal_storage_gcs::GcsUserProjectResource;
@@ -156,6 +160,7 @@ namespace jb = tensorstore::internal_json_binding;
 
 struct GcsMetrics : public internal_kvstore::CommonMetrics {
   internal_metrics::Counter<int64_t> retries;
+  internal_http::RequestHedgingMetrics hedging;
 };
 ABSL_CONST_INIT static GcsMetrics gcs_metrics;
 
@@ -166,6 +171,14 @@ TENSORSTORE_GLOBAL_INITIALIZER {
              internal_metrics::MetricMetadata(
                  "/tensorstore/kvstore/gcs/retries",
                  "gcs count of all retried requests (read/write/delete)"));
+  r.Register(&gcs_metrics.hedging.hedged,
+             internal_metrics::MetricMetadata(
+                 "/tensorstore/kvstore/gcs/hedged_requests",
+                 "gcs count of hedged (backup) read requests"));
+  r.Register(&gcs_metrics.hedging.hedge_won,
+             internal_metrics::MetricMetadata(
+                 "/tensorstore/kvstore/gcs/hedged_requests_won",
+                 "gcs count of hedged read requests that completed first"));
 }
 
 ABSL_CONST_INIT internal_log::VerboseFlag gcs_http_logging("gcs_http");
@@ -179,6 +192,17 @@ inline bool IsRetriable(const absl::Status& status) {
           status.code() == absl::StatusCode::kUnavailable);
 }
 
+// Reports the latency and size of a request, and whether the server throttled
+// it, to the request concurrency queue, which may adapt its limit.
+void ObserveResponse(RateLimiter& queue, absl::Time start_time,
+                     const Result<HttpResponse>& response,
+                     size_t request_bytes = 0) {
+  if (!response.ok()) return;
+  queue.ObserveResponse(
+      absl::Now() - start_time, request_bytes + response->payload.size(),
+      response->status_code == 429 || response->status_code == 503);
+}
+
 std::string GetGcsBaseUrl() {
   return GetFlagOrEnvValue(FLAGS_tensorstore_gcs_http_url,
                            "TENSORSTORE_GCS_HTTP_URL")
@@ -266,11 +290,14 @@ struct GcsKeyValueStoreSpecData {
   std::optional<Context::Resource<GcsRateLimiterResource>> rate_limiter;
   Context::Resource<GcsUserProjectResource> user_project;
   Context::Resource<GcsRequestRetries> retries;
+  Context::Resource<GcsRequestHedging> request_hedging;
+  Context::Resource<GcsBatchReadCoalescing> batch_read_coalescing;
   Context::Resource<DataCopyConcurrencyResource> data_copy_concurrency;
 
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
     return f(x.bucket, x.request_concurrency, x.rate_limiter, x.user_project,
-             x.retries, x.data_copy_concurrency);
+             x.retries, x.request_hedging, x.batch_read_coalescing,
+             x.data_copy_concurrency);
   };
 
   constexpr static auto default_json_binder = jb::Object(
@@ -299,6 +326,11 @@ struct GcsKeyValueStoreSpecData {
                  jb::Projection<&GcsKeyValueStoreSpecData::user_project>()),
       jb::Member(GcsRequestRetries::id,
                  jb::Projection<&GcsKeyValueStoreSpecData::retries>()),
+      jb::Member(GcsRequestHedging::id,
+                 jb::Projection<&GcsKeyValueStoreSpecData::request_hedging>()),
+      jb::Member(GcsBatchReadCoalescing::id,
+                 jb::Projection<
+                     &GcsKeyValueStoreSpecData::batch_read_coalescing>()),
       jb::Member(DataCopyConcurrencyResource::id,
                  jb::Projection<
                      &GcsKeyValueStoreSpecData::data_copy_concurrency>()) /**/
@@ -350,7 +382,11 @@ class GcsKeyValueStore
 
   internal_kvstore_batch::CoalescingOptions GetBatchReadCoalescingOptions()
       const {
-    return internal_kvstore_batch::kDefaultRemoteStorageCoalescingOptions;
+    return *spec_.batch_read_coalescing;
+  }
+
+  internal_kvstore_batch::CoalescedReadScheduler& batch_read_scheduler() {
+    return *batch_read_scheduler_;
   }
 
   Future<ReadResult> Read(Key key, ReadOptions options) override;
@@ -450,6 +486,8 @@ class GcsKeyValueStore
   std::string upload_root_;    // bucket upload root.
   std::string encoded_user_project_;
   NoRateLimiter no_rate_limiter_;
+  internal::IntrusivePtr<internal_kvstore_batch::CoalescedReadScheduler>
+      batch_read_scheduler_;
 
   std::shared_ptr<HttpTransport> transport_;
   absl::Mutex auth_provider_mutex_;
@@ -464,6 +502,10 @@ Future<kvstore::DriverPtr> GcsKeyValueStoreSpec::DoOpen() const {
   driver->resource_root_ = BucketResourceRoot(data_.bucket);
   driver->upload_root_ = BucketUploadRoot(data_.bucket);
   driver->transport_ = internal_http::GetDefaultHttpTransport();
+  driver->batch_read_scheduler_ = internal::MakeIntrusivePtr<
+      internal_kvstore_batch::CoalescedReadScheduler>(
+      GcsKeyValueStoreSpec::id,
+      data_.batch_read_coalescing->max_concurrent_reads);
 
   // NOTE: Remove temporary logging use of experimental feature.
   if (data_.rate_limiter.has_value()) {
@@ -579,8 +621,10 @@ struct ReadTask : public RateLimiterNode,
     start_time_ = absl::Now();
 
     ABSL_LOG_IF(INFO, gcs_http_logging) << "ReadTask: " << request;
-    auto future = owner->transport_->IssueRequest(
-        request, IssueRequestOptions().SetHttpVersion(GetHttpVersion()));
+    auto future = internal_http::IssueHedgedRequest(
+        owner->spec_.request_hedging->hedger, owner->transport_, request,
+        IssueRequestOptions().SetHttpVersion(GetHttpVersion()),
+        &gcs_metrics.hedging);
     future.ExecuteWhenReady([self = IntrusivePtr<ReadTask>(this)](
                                 ReadyFuture<HttpResponse> response) {
       self->OnResponse(response.result());
@@ -588,6 +632,7 @@ struct ReadTask : public RateLimiterNode,
   }
 
   void OnResponse(const Result<HttpResponse>& response) {
+    ObserveResponse(owner->admission_queue(), start_time_, response);
     if (!promise.result_needed()) {
       return;
     }
@@ -788,6 +833,8 @@ struct WriteTask : public RateLimiterNode,
   }
 
   void OnResponse(const Result<HttpResponse>& response) {
+    ObserveResponse(owner->admission_queue(), start_time_, response,
+                    value.size());
     if (!promise.result_needed()) {
       return;
     }
@@ -941,6 +988,7 @@ struct DeleteTask : public RateLimiterNode,
   }
 
   void OnResponse(const Result<HttpResponse>& response) {
+    ObserveResponse(owner->admission_queue(), start_time_, response);
     if (!promise.result_needed()) {
       return;
     }
@@ -1300,6 +1348,10 @@ Result<kvstore::Spec> ParseGcsUrl(std::string_view url) {
       Context::Resource<GcsUserProjectResource>::DefaultSpec();
   driver_spec->data_.retries =
       Context::Resource<GcsRequestRetries>::DefaultSpec();
+  driver_spec->data_.request_hedging =
+      Context::Resource<GcsRequestHedging>::DefaultSpec();
+  driver_spec->data_.batch_read_coalescing =
+      Context::Resource<GcsBatchReadCoalescing>::DefaultSpec();
   driver_spec->data_.data_copy_concurrency =
       Context::Resource<DataCopyConcurrencyResource>::DefaultSpec();
 
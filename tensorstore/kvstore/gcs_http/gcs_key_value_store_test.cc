@@ -656,6 +656,39 @@ TEST(GcsKeyValueStoreTest, Concurrency) {
   EXPECT_EQ(3, mock_transport->reset());
 }
 
+TEST(GcsKeyValueStoreTest, AdaptiveConcurrency) {
+  auto mock_transport = std::make_shared<MyConcurrentMockTransport>();
+  DefaultHttpTransportSetter mock_transport_setter{mock_transport};
+
+  GCSMockStorageBucket bucket("my-bucket");
+  mock_transport->buckets_.push_back(&bucket);
+
+  auto context = DefaultTestContext();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open(
+          {
+              {"driver", kDriver},
+              {"bucket", "my-bucket"},
+              {"context",
+               {{"gcs_request_concurrency",
+                 {{"limit", 2}, {"adaptive", true}, {"max_limit", 4}}}}} /**/
+          },
+          context)
+          .result());
+
+  std::vector<tensorstore::Future<kvstore::ReadResult>> futures;
+  for (size_t i = 0; i < 100; ++i) {
+    futures.push_back(kvstore::Read(store, "abc"));
+  }
+  for (const auto& future : futures) {
+    TENSORSTORE_EXPECT_OK(future.result());
+  }
+  auto max_concurrency = mock_transport->reset();
+  EXPECT_GE(max_concurrency, 2);
+  EXPECT_LE(max_concurrency, 4);
+}
+
 class MyRateLimitedMockTransport : public MyMockTransport {
  public:
   std::tuple<absl::Time, absl::Time, size_t> reset() {
@@ -788,8 +821,8 @@ TEST(GcsKeyValueStoreTest, BatchRead) {
           .result());
 
   tensorstore::internal::BatchReadGenericCoalescingTestOptions options;
-  options.coalescing_options = tensorstore::internal_kvstore_batch::
-      kDefaultRemoteStorageCoalescingOptions;
+  options.coalescing_options =
+      tensorstore::internal_kvstore_batch::kGcsCoalescingOptions;
   options.metric_prefix = "/tensorstore/kvstore/gcs/";
   tensorstore::internal::TestBatchReadGenericCoalescing(store, options);
 }
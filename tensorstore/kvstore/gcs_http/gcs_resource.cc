@@ -15,7 +15,10 @@
 #include "tensorstore/kvstore/gcs_http/gcs_resource.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <string>
@@ -24,11 +27,16 @@
 #include "absl/base/call_once.h"
 #include "absl/flags/marshalling.h"
 #include "absl/log/absl_log.h"
+#include "absl/strings/str_cat.h"
 #include "absl/time/time.h"
 #include "tensorstore/context.h"
 #include "tensorstore/context_resource_provider.h"
 #include "tensorstore/internal/env.h"
 #include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/internal/metrics/gauge.h"
+#include "tensorstore/internal/metrics/metadata.h"
+#include "tensorstore/internal/metrics/registration.h"
+#include "tensorstore/internal/rate_limiter/adaptive_admission_queue.h"
 #include "tensorstore/internal/rate_limiter/admission_queue.h"
 #include "tensorstore/internal/rate_limiter/rate_limiter.h"
 #include "tensorstore/internal/rate_limiter/scaling_rate_limiter.h"
@@ -43,6 +51,7 @@
 #include "tensorstore/internal/json_binding/std_array.h"
 #include "tensorstore/internal/json_binding/std_optional.h"
 
+using ::tensorstore::internal::AdaptiveAdmissionQueue;
 using ::tensorstore::internal::AdmissionQueue;
 using ::tensorstore::internal::AnyContextResourceJsonBinder;
 using ::tensorstore::internal::ConstantRateLimiter;
@@ -50,6 +59,18 @@ using ::tensorstore::internal::ContextResourceCreationContext;
 using ::tensorstore::internal::DoublingRateLimiter;
 using ::tensorstore::internal::NoRateLimiter;
 
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    gcs_adaptive_concurrency_limit, (Gauge<int64_t, std::string>),
+    MetricMetadata("/tensorstore/kvstore/gcs/adaptive_concurrency_limit",
+                   "Current limit of adaptive gcs_request_concurrency "
+                   "queues"),
+    "queue");
+
+namespace {
+// Identifies each adaptive queue in `gcs_adaptive_concurrency_limit`.
+ABSL_CONST_INIT std::atomic<int64_t> gcs_adaptive_queue_id{0};
+}  // namespace
+
 namespace tensorstore {
 namespace internal_kvstore_gcs_http {
 namespace {
@@ -60,6 +81,9 @@ const internal::ContextResourceRegistration<GcsConcurrencyResource>
 const internal::ContextResourceRegistration<GcsRateLimiterResource>
     gcs_rate_limiter_registration;
 
+const internal::ContextResourceRegistration<GcsRequestHedging>
+    gcs_request_hedging_registration;
+
 ABSL_CONST_INIT internal_log::VerboseFlag gcs_logging("gcs");
 
 constexpr size_t kDefaultRequestConcurrency = 32;
@@ -102,6 +126,20 @@ GcsConcurrencyResource::GcsConcurrencyResource()
 
 Result<GcsConcurrencyResource::Resource> GcsConcurrencyResource::Create(
     const Spec& spec, ContextResourceCreationContext context) const {
+  if (spec.adaptive) {
+    AdaptiveAdmissionQueue::Options options;
+    options.initial_limit = spec.limit.value_or(shared_limit_);
+    options.max_limit =
+        std::max(options.initial_limit,
+                 spec.max_limit.value_or(options.max_limit));
+    options.limit_gauge = &gcs_adaptive_concurrency_limit;
+    options.limit_gauge_label = absl::StrCat(gcs_adaptive_queue_id++);
+    Resource value;
+    value.spec = spec;
+    value.queue = std::make_shared<AdaptiveAdmissionQueue>(options);
+    return value;
+  }
+
   if (spec.limit) {
     Resource value;
     value.spec = spec;
@@ -24,6 +24,7 @@
 #include "absl/time/time.h"
 #include "tensorstore/context.h"
 #include "tensorstore/context_resource_provider.h"
+#include "tensorstore/internal/http/request_hedging_resource.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/rate_limiter/admission_queue.h"
 #include "tensorstore/internal/rate_limiter/rate_limiter.h"
@@ -52,24 +53,35 @@ struct GcsConcurrencyResource
   struct Spec {
     // If equal to `nullopt`, indicates that the shared executor is used.
     std::optional<size_t> limit;
+    // If `true`, the limit is adjusted based on request latency and
+    // throttling responses, starting from `limit`.
+    bool adaptive = false;
+    // Upper bound on the adaptive limit.
+    std::optional<size_t> max_limit;
 
     constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-      return f(x.limit);
+      return f(x.limit, x.adaptive, x.max_limit);
     };
   };
   struct Resource {
     Spec spec;
-    std::shared_ptr<internal::AdmissionQueue> queue;
+    std::shared_ptr<internal::RateLimiter> queue;
   };
 
   static Spec Default() { return Spec{std::nullopt}; }
 
   static constexpr auto JsonBinder() {
     namespace jb = tensorstore::internal_json_binding;
-    return jb::Object(jb::Member(
-        "limit",
-        jb::Projection<&Spec::limit>(jb::DefaultInitializedValue(
-            jb::Optional(jb::Integer<size_t>(1), [] { return "shared"; })))));
+    return jb::Object(
+        jb::Member("limit",
+                   jb::Projection<&Spec::limit>(jb::DefaultInitializedValue(
+                       jb::Optional(jb::Integer<size_t>(1),
+                                    [] { return "shared"; })))),
+        jb::Member("adaptive", jb::Projection<&Spec::adaptive>(
+                                   jb::DefaultInitializedValue())),
+        jb::Member("max_limit",
+                   jb::Projection<&Spec::max_limit>(
+                       jb::Optional(jb::Integer<size_t>(1)))));
   }
 
   Result<Resource> Create(
@@ -81,7 +93,8 @@ struct GcsConcurrencyResource
   }
 
  private:
-  /// Size of AdmissionQueue referenced by `shared_resource_`.
+  /// Size of AdmissionQueue referenced by `shared_resource_`, and the initial
+  /// limit of adaptive queues.
   size_t shared_limit_;
 
   /// Protects initialization of `shared_queue_`.
@@ -137,6 +150,12 @@ struct GcsRateLimiterResource
   }
 };
 
+/// Specifies hedging of GCS read requests.
+struct GcsRequestHedging
+    : public internal_http::RequestHedgingResource<GcsRequestHedging> {
+  static constexpr char id[] = "gcs_request_hedging";
+};
+
 }  // namespace internal_kvstore_gcs_http
 }  // namespace tensorstore
 
@@ -21,10 +21,13 @@
 #include <cassert>
 #include <utility>
 
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "tensorstore/batch.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/coalesced_read_scheduler.h"
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_result.h"
 #include "tensorstore/util/future.h"
@@ -42,7 +45,12 @@ using GenericCoalescingBatchReadEntryBase =
 
 // Generic batch read implementation that simply coalesces requests to the same
 // key with the same generation constraints, and then dispatches each coalesced
-// request independently to the driver.
+// request to the driver through the driver's `CoalescedReadScheduler`.
+//
+// The scheduler is shared by all keys and batches of a driver, such that the
+// total number of outstanding coalesced reads is bounded.  The batch submission
+// time is used as the scheduling deadline, so queued reads from earlier batches
+// are started before those from later batches.
 //
 // This may be used by drivers to implement batch read support when no specific
 // optimizations are possible.
@@ -54,7 +62,11 @@ using GenericCoalescingBatchReadEntryBase =
 //       non-batch read (`ReadOptions::batch` will always be `no_batch`).
 //
 //     - `CoalescingOptions GetBatchReadCoalescingOptions()` that returns the
-//       coalescing options to use.
+//       coalescing options to use, typically from a
+//       `BatchReadCoalescingResource`.
+//
+//     - `CoalescedReadScheduler& batch_read_scheduler()` that returns the
+//       scheduler used to bound concurrent coalesced reads.
 //
 //     - `Executor executor()` that returns an executor to use for handling
 //       batch read operations.
@@ -81,10 +93,11 @@ struct GenericCoalescingBatchReadEntry
   // Submit is responsible for destroying the entry when done.
   void Submit(Batch::View batch) final {
     if (request_batch.requests.empty()) return;
-    this->driver().executor()([this] { this->ProcessBatch(); });
+    this->driver().executor()(
+        [this, submit_time = absl::Now()] { this->ProcessBatch(submit_time); });
   }
 
-  void ProcessBatch() {
+  void ProcessBatch(absl::Time submit_time) {
     // Take ownership of the initial reference. A separate reference will be
     // held for each coalesced read such that the entry will be destroyed once
     // all individual coalesced reads complete.
@@ -97,27 +110,42 @@ struct GenericCoalescingBatchReadEntry
         [&](OptionalByteRangeRequest coalesced_byte_range,
             tensorstore::span<Request> coalesced_requests) {
           auto current_range = coalesced_byte_range.AsByteRange();
-          kvstore::ReadOptions options;
-          options.generation_conditions =
-              std::get<kvstore::ReadGenerationConditions>(batch_entry_key);
-          options.staleness_bound = request_batch.staleness_bound;
-          options.byte_range = current_range;
-          auto read_future = this->driver().ReadImpl(
-              kvstore::Key(std::get<kvstore::Key>(batch_entry_key)),
-              std::move(options));
-          read_future.Force();
-          std::move(read_future)
-              .ExecuteWhenReady(WithExecutor(
-                  this->driver().executor(),
-                  [self, current_range, coalesced_requests](
-                      ReadyFuture<kvstore::ReadResult> future) {
-                    TENSORSTORE_ASSIGN_OR_RETURN(
-                        auto&& read_result, future.result(),
-                        internal_kvstore_batch::SetCommonResult(
-                            coalesced_requests, _));
-                    ResolveCoalescedRequests(current_range, coalesced_requests,
-                                             std::move(read_result));
-                  }));
+          this->driver().batch_read_scheduler().Schedule(
+              this->driver().executor(), submit_time, coalesced_requests.size(),
+              [self, current_range,
+               coalesced_requests]() -> AnyFuture {
+                // Requests may have been cancelled while queued.
+                if (std::none_of(coalesced_requests.begin(),
+                                 coalesced_requests.end(),
+                                 [](const Request& request) {
+                                   return request.promise.result_needed();
+                                 })) {
+                  return MakeReadyFuture();
+                }
+                kvstore::ReadOptions options;
+                options.generation_conditions =
+                    std::get<kvstore::ReadGenerationConditions>(
+                        self->batch_entry_key);
+                options.staleness_bound = self->request_batch.staleness_bound;
+                options.byte_range = current_range;
+                auto read_future = self->driver().ReadImpl(
+                    kvstore::Key(std::get<kvstore::Key>(self->batch_entry_key)),
+                    std::move(options));
+                read_future.Force();
+                read_future.ExecuteWhenReady(WithExecutor(
+                    self->driver().executor(),
+                    [self, current_range, coalesced_requests](
+                        ReadyFuture<kvstore::ReadResult> future) {
+                      TENSORSTORE_ASSIGN_OR_RETURN(
+                          auto&& read_result, future.result(),
+                          internal_kvstore_batch::SetCommonResult(
+                              coalesced_requests, _));
+                      ResolveCoalescedRequests(current_range,
+                                               coalesced_requests,
+                                               std::move(read_result));
+                    }));
+                return read_future;
+              });
         });
   }
 };
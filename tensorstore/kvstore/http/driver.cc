@@ -35,25 +35,31 @@
 #include "tensorstore/context_resource_provider.h"
 #include "tensorstore/internal/concurrency_resource.h"
 #include "tensorstore/internal/concurrency_resource_provider.h"
+#include "tensorstore/internal/global_initializer.h"
 #include "tensorstore/internal/http/default_transport.h"
 #include "tensorstore/internal/http/http_header.h"
 #include "tensorstore/internal/http/http_request.h"
 #include "tensorstore/internal/http/http_response.h"
 #include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/http/request_hedging.h"
+#include "tensorstore/internal/http/request_hedging_resource.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/log/verbose_flag.h"
 #include "tensorstore/internal/metrics/counter.h"
 #include "tensorstore/internal/metrics/metadata.h"
 #include "tensorstore/internal/metrics/registration.h"
+#include "tensorstore/internal/metrics/registry.h"
 #include "tensorstore/internal/path.h"
 #include "tensorstore/internal/retries_context_resource.h"
 #include "tensorstore/internal/retry.h"
 #include "tensorstore/internal/uri/ascii_set.h"
 #include "tensorstore/internal/uri/parse.h"
 #include "tensorstore/internal/uri/percent_coder.h"
+#include "tensorstore/kvstore/batch_read_coalescing_resource.h"
 #include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/coalesced_read_scheduler.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/generic_coalescing_batch_util.h"
 #include "tensorstore/kvstore/http/byte_range_util.h"
@@ -100,6 +106,20 @@ namespace {
 
 namespace jb = tensorstore::internal_json_binding;
 
+ABSL_CONST_INIT internal_http::RequestHedgingMetrics http_hedging_metrics;
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  auto& r = internal_metrics::GetMetricRegistry();
+  r.Register(&http_hedging_metrics.hedged,
+             internal_metrics::MetricMetadata(
+                 "/tensorstore/kvstore/http/hedged_requests",
+                 "http driver count of hedged (backup) read requests"));
+  r.Register(&http_hedging_metrics.hedge_won,
+             internal_metrics::MetricMetadata(
+                 "/tensorstore/kvstore/http/hedged_requests_won",
+                 "http driver count of hedged reads that completed first"));
+}
+
 ABSL_CONST_INIT internal_log::VerboseFlag http_logging("http_kvstore");
 
 struct HttpRequestConcurrencyResource : public internal::ConcurrencyResource {
@@ -112,6 +132,19 @@ struct HttpRequestRetries
   static constexpr char id[] = "http_request_retries";
 };
 
+/// Specifies hedging of read requests.
+struct HttpRequestHedging
+    : public internal_http::RequestHedgingResource<HttpRequestHedging> {
+  static constexpr char id[] = "http_request_hedging";
+};
+
+/// Specifies how batch reads are coalesced.
+struct HttpBatchReadCoalescing
+    : public internal_kvstore_batch::BatchReadCoalescingResource<
+          HttpBatchReadCoalescing> {
+  static constexpr char id[] = "http_batch_read_coalescing";
+};
+
 struct HttpRequestConcurrencyResourceTraits
     : public internal::ConcurrencyResourceTraits,
       public internal::ContextResourceTraits<HttpRequestConcurrencyResource> {
@@ -124,6 +157,12 @@ const internal::ContextResourceRegistration<
 const internal::ContextResourceRegistration<HttpRequestRetries>
     http_request_retries_registration;
 
+const internal::ContextResourceRegistration<HttpRequestHedging>
+    http_request_hedging_registration;
+
+const internal::ContextResourceRegistration<HttpBatchReadCoalescing>
+    http_batch_read_coalescing_registration;
+
 /// Returns whether the absl::Status is a retriable request.
 bool IsRetriable(const absl::Status& status) {
   return (status.code() == absl::StatusCode::kDeadlineExceeded ||
@@ -147,10 +186,13 @@ struct HttpKeyValueStoreSpecData {
   std::string base_url;
   Context::Resource<HttpRequestConcurrencyResource> request_concurrency;
   Context::Resource<HttpRequestRetries> retries;
+  Context::Resource<HttpRequestHedging> request_hedging;
+  Context::Resource<HttpBatchReadCoalescing> batch_read_coalescing;
   std::vector<std::string> headers;
 
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
-    return f(x.base_url, x.request_concurrency, x.retries, x.headers);
+    return f(x.base_url, x.request_concurrency, x.retries, x.request_hedging,
+             x.batch_read_coalescing, x.headers);
   };
 
   constexpr static auto default_json_binder = jb::Object(
@@ -173,7 +215,13 @@ struct HttpKeyValueStoreSpecData {
           HttpRequestConcurrencyResource::id,
           jb::Projection<&HttpKeyValueStoreSpecData::request_concurrency>()),
       jb::Member(HttpRequestRetries::id,
-                 jb::Projection<&HttpKeyValueStoreSpecData::retries>())
+                 jb::Projection<&HttpKeyValueStoreSpecData::retries>()),
+      jb::Member(
+          HttpRequestHedging::id,
+          jb::Projection<&HttpKeyValueStoreSpecData::request_hedging>()),
+      jb::Member(
+          HttpBatchReadCoalescing::id,
+          jb::Projection<&HttpKeyValueStoreSpecData::batch_read_coalescing>())
       /**/
   );
 
@@ -246,7 +294,11 @@ class HttpKeyValueStore
  public:
   internal_kvstore_batch::CoalescingOptions GetBatchReadCoalescingOptions()
       const {
-    return internal_kvstore_batch::kDefaultRemoteStorageCoalescingOptions;
+    return *spec_.batch_read_coalescing;
+  }
+
+  internal_kvstore_batch::CoalescedReadScheduler& batch_read_scheduler() {
+    return *batch_read_scheduler_;
   }
 
   Future<ReadResult> Read(Key key, ReadOptions options) override;
@@ -268,12 +320,19 @@ class HttpKeyValueStore
   HttpKeyValueStoreSpecData spec_;
 
   std::shared_ptr<HttpTransport> transport_;
+
+  internal::IntrusivePtr<internal_kvstore_batch::CoalescedReadScheduler>
+      batch_read_scheduler_;
 };
 
 Future<kvstore::DriverPtr> HttpKeyValueStoreSpec::DoOpen() const {
   auto driver = internal::MakeIntrusivePtr<HttpKeyValueStore>();
   driver->spec_ = data_;
   driver->transport_ = internal_http::GetDefaultHttpTransport();
+  driver->batch_read_scheduler_ = internal::MakeIntrusivePtr<
+      internal_kvstore_batch::CoalescedReadScheduler>(
+      HttpKeyValueStoreSpec::id,
+      data_.batch_read_coalescing->max_concurrent_reads);
   return driver;
 }
 
@@ -320,7 +379,11 @@ struct ReadTask {
 
     ABSL_LOG_IF(INFO, http_logging) << "[http] Read: " << request;
 
-    auto response = owner->transport_->IssueRequest(request, {}).result();
+    auto response =
+        internal_http::IssueHedgedRequest(
+            owner->spec_.request_hedging->hedger, owner->transport_, request,
+            {}, &http_hedging_metrics)
+            .result();
     if (!response.ok()) return response.status();
     httpresponse = *std::move(response);
     http_bytes_read.IncrementBy(httpresponse.payload.size());
@@ -473,6 +536,10 @@ Result<kvstore::Spec> ParseHttpUrl(std::string_view url) {
       Context::Resource<HttpRequestConcurrencyResource>::DefaultSpec();
   driver_spec->data_.retries =
       Context::Resource<HttpRequestRetries>::DefaultSpec();
+  driver_spec->data_.request_hedging =
+      Context::Resource<HttpRequestHedging>::DefaultSpec();
+  driver_spec->data_.batch_read_coalescing =
+      Context::Resource<HttpBatchReadCoalescing>::DefaultSpec();
 
   std::string path;
   return {std::in_place, std::move(driver_spec), std::move(path)};
@@ -0,0 +1,603 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+///
+/// Key-value store adapter which caches values read from a base key-value
+/// store in a second, typically local, key-value store.
+///
+/// Each cached value is stored as a single entry of the cache key-value store,
+/// named by the SHA256 digest of the base URL and key, together with the
+/// identity of the base key, the generation and the time at which the value
+/// was read.  Cached entries are used without a request to the base key-value
+/// store only if they satisfy the `staleness_bound` of the read; otherwise they
+/// are validated by a read conditioned on the cached generation, which
+/// transfers the value only if it has changed.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/strip.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/batch.h"
+#include "tensorstore/context.h"
+#include "tensorstore/internal/digest/sha256.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/internal/metrics/metadata.h"
+#include "tensorstore/internal/metrics/registration.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/local_cache/lru_index.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/registry.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/kvstore/supported_features.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/garbage_collection/fwd.h"
+#include "tensorstore/util/result.h"
+
+// specializations
+#include "tensorstore/internal/cache_key/cache_key.h"  // IWYU pragma: keep
+#include "tensorstore/serialization/serialization.h"  // IWYU pragma: keep
+#include "tensorstore/util/apply_members/apply_members.h"  // IWYU pragma: keep
+
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    local_cache_hit, Counter<int64_t>,
+    MetricMetadata("/tensorstore/kvstore/local_cache/hit",
+                   "Reads served from the local cache without validation"));
+
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    local_cache_validated, Counter<int64_t>,
+    MetricMetadata("/tensorstore/kvstore/local_cache/validated",
+                   "Reads served from the local cache after validating the "
+                   "generation with the base kvstore"));
+
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    local_cache_miss, Counter<int64_t>,
+    MetricMetadata("/tensorstore/kvstore/local_cache/miss",
+                   "Reads which required a value from the base kvstore"));
+
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    local_cache_evicted, Counter<int64_t>,
+    MetricMetadata("/tensorstore/kvstore/local_cache/evicted",
+                   "Entries evicted from the local cache"));
+
+namespace tensorstore {
+namespace internal_local_cache_kvstore {
+namespace {
+
+namespace jb = tensorstore::internal_json_binding;
+
+using ::tensorstore::internal::IntrusivePtr;
+using ::tensorstore::kvstore::ListEntry;
+using ::tensorstore::kvstore::ListOptions;
+using ::tensorstore::kvstore::ListReceiver;
+using ::tensorstore::kvstore::ReadResult;
+using ::tensorstore::kvstore::SupportedFeatures;
+
+ABSL_CONST_INIT internal_log::VerboseFlag local_cache_logging("local_cache");
+
+// Identifies the format of cache entries.
+constexpr std::string_view kEntryMagic = "TSLCACHE";
+
+// Entry names are the hex-encoded SHA256 digest of the identity.
+constexpr size_t kEntryNameLength = 64;
+
+// -----------------------------------------------------------------------------
+// Cache entry encoding:
+//
+//   magic                  8 bytes, "TSLCACHE"
+//   identity_length        uint64 little endian
+//   identity               identity_length bytes
+//   generation_length      uint64 little endian
+//   generation             generation_length bytes
+//   time                   int64 little endian, nanoseconds since the epoch
+//   value                  remaining bytes
+
+struct CacheEntry {
+  TimestampedStorageGeneration stamp;
+  absl::Cord value;
+};
+
+void AppendUint64(std::string& out, uint64_t x) {
+  for (int i = 0; i < 8; ++i) {
+    out.push_back(static_cast<char>((x >> (8 * i)) & 0xff));
+  }
+}
+
+bool ConsumeUint64(std::string_view& in, uint64_t& x) {
+  if (in.size() < 8) return false;
+  x = 0;
+  for (int i = 0; i < 8; ++i) {
+    x |= static_cast<uint64_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+  }
+  in.remove_prefix(8);
+  return true;
+}
+
+bool ConsumeString(std::string_view& in, std::string_view& s) {
+  uint64_t length;
+  if (!ConsumeUint64(in, length) || in.size() < length) return false;
+  s = in.substr(0, length);
+  in.remove_prefix(length);
+  return true;
+}
+
+absl::Cord EncodeEntry(std::string_view identity,
+                       const TimestampedStorageGeneration& stamp,
+                       const absl::Cord& value) {
+  std::string header(kEntryMagic);
+  AppendUint64(header, identity.size());
+  header.append(identity);
+  AppendUint64(header, stamp.generation.value.size());
+  header.append(stamp.generation.value);
+  AppendUint64(header, static_cast<uint64_t>(absl::ToUnixNanos(stamp.time)));
+  absl::Cord encoded(std::move(header));
+  encoded.Append(value);
+  return encoded;
+}
+
+/// Decodes an entry, returning `std::nullopt` if it is invalid or does not
+/// belong to `identity`.
+std::optional<CacheEntry> DecodeEntry(const absl::Cord& encoded,
+                                      std::string_view identity) {
+  // The header is small relative to the values, so copy just the prefix that
+  // may contain it.
+  const size_t max_header_size =
+      kEntryMagic.size() + 8 + identity.size() + 8 + 1024 + 8;
+  std::string header(encoded.Subcord(0, max_header_size));
+  std::string_view in(header);
+  std::string_view stored_identity;
+  std::string_view generation;
+  uint64_t time_nanos;
+  if (!absl::ConsumePrefix(&in, kEntryMagic) ||
+      !ConsumeString(in, stored_identity) || stored_identity != identity ||
+      !ConsumeString(in, generation) || !ConsumeUint64(in, time_nanos)) {
+    return std::nullopt;
+  }
+  CacheEntry entry;
+  entry.stamp.generation = StorageGeneration{std::string(generation)};
+  entry.stamp.time = absl::FromUnixNanos(static_cast<int64_t>(time_nanos));
+  if (StorageGeneration::IsUnknown(entry.stamp.generation) ||
+      StorageGeneration::IsNoValue(entry.stamp.generation)) {
+    return std::nullopt;
+  }
+  const size_t header_size = header.size() - in.size();
+  entry.value = encoded.Subcord(header_size, encoded.size() - header_size);
+  return entry;
+}
+
+std::string GetEntryName(std::string_view identity) {
+  internal::SHA256Digester digester;
+  digester.Write(identity);
+  auto digest = digester.Digest();
+  return absl::BytesToHexString(std::string_view(
+      reinterpret_cast<const char*>(digest.data()), digest.size()));
+}
+
+bool IsEntryName(std::string_view name) {
+  if (name.size() != kEntryNameLength) return false;
+  for (char c : name) {
+    if (!absl::ascii_isxdigit(c)) return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+struct LocalCacheSpecData {
+  kvstore::Spec base;
+  kvstore::Spec cache;
+  int64_t max_bytes;
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.base, x.cache, x.max_bytes);
+  };
+
+  constexpr static auto default_json_binder = jb::Object(
+      jb::Member("base", jb::Projection<&LocalCacheSpecData::base>()),
+      jb::Member("cache", jb::Projection<&LocalCacheSpecData::cache>()),
+      jb::Member("max_bytes", jb::Projection<&LocalCacheSpecData::max_bytes>(
+                                  jb::Integer<int64_t>(0))) /**/
+  );
+};
+
+class LocalCacheSpec
+    : public internal_kvstore::RegisteredDriverSpec<LocalCacheSpec,
+                                                    LocalCacheSpecData> {
+ public:
+  static constexpr char id[] = "local_cache";
+
+  Future<kvstore::DriverPtr> DoOpen() const override;
+
+  absl::Status ApplyOptions(kvstore::DriverSpecOptions&& options) override {
+    return data_.base.driver.Set(std::move(options));
+  }
+
+  Result<kvstore::Spec> GetBase(std::string_view path) const override {
+    auto base = data_.base;
+    base.AppendSuffix(path);
+    return base;
+  }
+};
+
+/// Defines the "local_cache" key value store adapter.
+class LocalCacheKvStore
+    : public internal_kvstore::RegisteredDriver<LocalCacheKvStore,
+                                                LocalCacheSpec> {
+ public:
+  explicit LocalCacheKvStore(int64_t max_bytes) : index_(max_bytes) {}
+
+  Future<ReadResult> Read(Key key, ReadOptions options) override;
+
+  Future<TimestampedStorageGeneration> Write(Key key,
+                                             std::optional<Value> value,
+                                             WriteOptions options) override;
+
+  Future<const void> DeleteRange(KeyRange range) override;
+
+  void ListImpl(ListOptions options, ListReceiver receiver) override;
+
+  std::string DescribeKey(std::string_view key) override {
+    return base_.driver->DescribeKey(absl::StrCat(base_.path, key));
+  }
+
+  absl::Status GetBoundSpecData(LocalCacheSpecData& spec) const {
+    spec = spec_data_;
+    return absl::OkStatus();
+  }
+
+  SupportedFeatures GetSupportedFeatures(
+      const KeyRange& key_range) const final {
+    return base_.driver->GetSupportedFeatures(
+        KeyRange::AddPrefix(base_.path, key_range));
+  }
+
+  Result<KvStore> GetBase(std::string_view path,
+                          const Transaction& transaction) const override {
+    return KvStore(base_.driver, absl::StrCat(base_.path, path), transaction);
+  }
+
+  /// Returns the string which identifies `key` of the base kvstore in cache
+  /// entries.
+  std::string GetIdentity(std::string_view key) const {
+    return absl::StrCat(identity_prefix_, key);
+  }
+
+  /// Cached entries read before this time must be validated.
+  absl::Time min_valid_time() const {
+    absl::MutexLock lock(&mutex_);
+    return min_valid_time_;
+  }
+
+  /// Adds the entries listed from the cache kvstore to the index.
+  void InitializeIndex(std::vector<ListEntry> entries);
+
+  /// Writes an entry to the cache kvstore, and adds it to the index once
+  /// written.
+  void StoreEntry(std::string identity, std::string name,
+                  const TimestampedStorageGeneration& stamp,
+                  const absl::Cord& value);
+
+  /// Removes an entry from the index and from the cache kvstore.
+  void RemoveEntry(std::string name);
+
+  void EvictEntries(std::vector<std::string> names);
+
+  LocalCacheSpecData spec_data_;
+  kvstore::KvStore base_;
+  kvstore::KvStore cache_;
+  std::string identity_prefix_;
+  LruIndex index_;
+
+  mutable absl::Mutex mutex_;
+  absl::Time min_valid_time_ ABSL_GUARDED_BY(mutex_) = absl::InfinitePast();
+};
+
+Future<kvstore::DriverPtr> LocalCacheSpec::DoOpen() const {
+  return PromiseFuturePair<kvstore::DriverPtr>::LinkValue(
+             [spec = IntrusivePtr<const LocalCacheSpec>(this)](
+                 Promise<kvstore::DriverPtr> promise,
+                 ReadyFuture<kvstore::KvStore> base_future,
+                 ReadyFuture<kvstore::KvStore> cache_future) {
+               auto driver = internal::MakeIntrusivePtr<LocalCacheKvStore>(
+                   spec->data_.max_bytes);
+               driver->spec_data_ = spec->data_;
+               driver->base_ = std::move(base_future.value());
+               driver->cache_ = std::move(cache_future.value());
+               if (auto url = driver->base_.ToUrl(); url.ok()) {
+                 driver->identity_prefix_ = *std::move(url);
+               } else {
+                 driver->identity_prefix_ =
+                     driver->base_.driver->DescribeKey(driver->base_.path);
+               }
+               // The index is rebuilt from the entries already present in the
+               // cache kvstore, which persist across processes.
+               LinkValue(
+                   [driver](Promise<kvstore::DriverPtr> promise,
+                            ReadyFuture<std::vector<ListEntry>> entries) {
+                     driver->InitializeIndex(std::move(entries.value()));
+                     promise.SetResult(driver);
+                   },
+                   std::move(promise), kvstore::ListFuture(driver->cache_));
+             },
+             kvstore::Open(data_.base), kvstore::Open(data_.cache))
+      .future;
+}
+
+void LocalCacheKvStore::InitializeIndex(std::vector<ListEntry> entries) {
+  // The access order of existing entries is unknown; they are all treated as
+  // less recently used than entries accessed by this process.
+  std::vector<std::string> evicted;
+  for (auto& entry : entries) {
+    if (!IsEntryName(entry.key) || !entry.has_size()) continue;
+    auto e = index_.Insert(std::move(entry.key), entry.size);
+    evicted.insert(evicted.end(), e.begin(), e.end());
+  }
+  ABSL_LOG_IF(INFO, local_cache_logging)
+      << "local_cache: " << index_.size() << " entries, "
+      << index_.total_bytes() << " bytes in " << DescribeKey("")
+      << " cache";
+  EvictEntries(std::move(evicted));
+}
+
+void LocalCacheKvStore::StoreEntry(std::string identity, std::string name,
+                                   const TimestampedStorageGeneration& stamp,
+                                   const absl::Cord& value) {
+  // The index entry is only added once the write completes, so that
+  // concurrent reads do not observe a previous value of the entry.
+  index_.Remove(name);
+  auto encoded = EncodeEntry(identity, stamp, value);
+  const int64_t size = encoded.size();
+  if (size > index_.max_bytes()) {
+    kvstore::Delete(cache_, name);
+    return;
+  }
+  kvstore::Write(cache_, name, std::move(encoded))
+      .ExecuteWhenReady(
+          [self = IntrusivePtr<LocalCacheKvStore>(this), name = std::move(name),
+           size](ReadyFuture<TimestampedStorageGeneration> future) mutable {
+            auto& r = future.result();
+            if (!r.ok()) {
+              ABSL_LOG_IF(INFO, local_cache_logging)
+                  << "local_cache: failed to write " << name << ": "
+                  << r.status();
+              return;
+            }
+            self->EvictEntries(self->index_.Insert(std::move(name), size));
+          });
+}
+
+void LocalCacheKvStore::RemoveEntry(std::string name) {
+  index_.Remove(name);
+  kvstore::Delete(cache_, std::move(name));
+}
+
+void LocalCacheKvStore::EvictEntries(std::vector<std::string> names) {
+  for (auto& name : names) {
+    local_cache_evicted.Increment();
+    kvstore::Delete(cache_, std::move(name));
+  }
+}
+
+// Implements LocalCacheKvStore::Read
+struct ReadState : public internal::AtomicReferenceCount<ReadState> {
+  IntrusivePtr<LocalCacheKvStore> owner_;
+  kvstore::Key key_;
+  kvstore::ReadOptions options_;
+  std::string identity_;
+  std::string name_;
+
+  void Start(Promise<ReadResult> promise) {
+    if (!owner_->index_.Touch(name_)) {
+      Fetch(std::move(promise));
+      return;
+    }
+    Link(
+        [self = IntrusivePtr<ReadState>(this)](
+            Promise<ReadResult> promise, ReadyFuture<ReadResult> future) {
+          self->OnCacheRead(std::move(promise), future.result());
+        },
+        std::move(promise), kvstore::Read(owner_->cache_, name_));
+  }
+
+  void OnCacheRead(Promise<ReadResult> promise,
+                   const Result<ReadResult>& result) {
+    std::optional<CacheEntry> entry;
+    if (result.ok() && result->has_value()) {
+      entry = DecodeEntry(result->value, identity_);
+    }
+    if (!entry) {
+      // Evicted by another process, or invalid.
+      owner_->RemoveEntry(name_);
+      Fetch(std::move(promise));
+      return;
+    }
+    if (entry->stamp.time >= options_.staleness_bound &&
+        entry->stamp.time >= owner_->min_valid_time()) {
+      local_cache_hit.Increment();
+      promise.SetResult(Serve(entry->value, std::move(entry->stamp)));
+      return;
+    }
+    Validate(std::move(promise), *std::move(entry));
+  }
+
+  /// Reads from the base kvstore conditioned on the cached generation.
+  void Validate(Promise<ReadResult> promise, CacheEntry entry) {
+    kvstore::ReadOptions options;
+    options.generation_conditions.if_not_equal = entry.stamp.generation;
+    options.staleness_bound = options_.staleness_bound;
+    Link(
+        [self = IntrusivePtr<ReadState>(this), entry = std::move(entry)](
+            Promise<ReadResult> promise,
+            ReadyFuture<ReadResult> future) mutable {
+          auto& r = future.result();
+          if (!r.ok()) {
+            promise.SetResult(r.status());
+            return;
+          }
+          if (r->aborted()) {
+            // Not modified.
+            local_cache_validated.Increment();
+            entry.stamp.time = r->stamp.time;
+            promise.SetResult(
+                self->Serve(entry.value, std::move(entry.stamp)));
+            return;
+          }
+          local_cache_miss.Increment();
+          promise.SetResult(self->OnBaseRead(*r));
+        },
+        std::move(promise),
+        kvstore::Read(owner_->base_, key_, std::move(options)));
+  }
+
+  /// Reads from the base kvstore without a cached entry.
+  void Fetch(Promise<ReadResult> promise) {
+    local_cache_miss.Increment();
+    if (!options_.byte_range.IsFull()) {
+      // Only complete values are cached.
+      LinkResult(std::move(promise),
+                 kvstore::Read(owner_->base_, key_, std::move(options_)));
+      return;
+    }
+    Link(
+        [self = IntrusivePtr<ReadState>(this)](
+            Promise<ReadResult> promise, ReadyFuture<ReadResult> future) {
+          auto& r = future.result();
+          if (!r.ok()) {
+            promise.SetResult(r.status());
+            return;
+          }
+          promise.SetResult(self->OnBaseRead(*r));
+        },
+        std::move(promise), kvstore::Read(owner_->base_, key_, options_));
+  }
+
+  /// Updates the cache entry from a non-aborted read of the complete value.
+  Result<ReadResult> OnBaseRead(const ReadResult& r) {
+    if (r.has_value()) {
+      owner_->StoreEntry(identity_, name_, r.stamp, r.value);
+      return Serve(r.value, r.stamp);
+    }
+    if (r.not_found()) {
+      owner_->RemoveEntry(name_);
+    }
+    return r;
+  }
+
+  /// Applies the read options to a complete value.
+  Result<ReadResult> Serve(const absl::Cord& value,
+                           TimestampedStorageGeneration stamp) {
+    if (!options_.generation_conditions.Matches(stamp.generation)) {
+      return ReadResult::Unspecified(std::move(stamp));
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(auto byte_range,
+                                 options_.byte_range.Validate(value.size()));
+    return ReadResult::Value(internal::GetSubCord(value, byte_range),
+                             std::move(stamp));
+  }
+};
+
+Future<ReadResult> LocalCacheKvStore::Read(Key key, ReadOptions options) {
+  auto state = internal::MakeIntrusivePtr<ReadState>();
+  state->owner_ = IntrusivePtr<LocalCacheKvStore>(this);
+  state->identity_ = GetIdentity(key);
+  state->name_ = GetEntryName(state->identity_);
+  state->key_ = std::move(key);
+  state->options_ = std::move(options);
+  // Batching is not supported, since reads of the base kvstore may be
+  // issued after the batch is submitted.
+  state->options_.batch = no_batch;
+  auto [promise, future] = PromiseFuturePair<ReadResult>::Make();
+  state->Start(std::move(promise));
+  return std::move(future);
+}
+
+Future<TimestampedStorageGeneration> LocalCacheKvStore::Write(
+    Key key, std::optional<Value> value, WriteOptions options) {
+  auto identity = GetIdentity(key);
+  auto name = GetEntryName(identity);
+  // Prevent reads from using the existing entry while the write is pending.
+  index_.Remove(name);
+  auto future = kvstore::Write(base_, key, value, std::move(options));
+  return MapFuture(
+      InlineExecutor{},
+      [self = IntrusivePtr<LocalCacheKvStore>(this),
+       identity = std::move(identity), name = std::move(name),
+       value = std::move(value)](
+          const Result<TimestampedStorageGeneration>& result) mutable
+          -> Result<TimestampedStorageGeneration> {
+        if (result.ok() && value &&
+            !StorageGeneration::IsUnknown(result->generation)) {
+          self->StoreEntry(std::move(identity), std::move(name), *result,
+                           *value);
+        } else {
+          self->RemoveEntry(std::move(name));
+        }
+        return result;
+      },
+      std::move(future));
+}
+
+Future<const void> LocalCacheKvStore::DeleteRange(KeyRange range) {
+  // Cache entries are named by digest, so those within `range` cannot be
+  // located directly; instead, all entries are validated before use.
+  {
+    absl::MutexLock lock(&mutex_);
+    min_valid_time_ = absl::Now();
+  }
+  return kvstore::DeleteRange(base_, std::move(range));
+}
+
+void LocalCacheKvStore::ListImpl(ListOptions options, ListReceiver receiver) {
+  kvstore::List(base_, std::move(options), std::move(receiver));
+}
+
+}  // namespace
+}  // namespace internal_local_cache_kvstore
+}  // namespace tensorstore
+
+TENSORSTORE_DECLARE_GARBAGE_COLLECTION_NOT_REQUIRED(
+    tensorstore::internal_local_cache_kvstore::LocalCacheKvStore)
+
+// Registers the driver.
+namespace {
+const tensorstore::internal_kvstore::DriverRegistration<
+    tensorstore::internal_local_cache_kvstore::LocalCacheSpec>
+    registration;
+}  // namespace
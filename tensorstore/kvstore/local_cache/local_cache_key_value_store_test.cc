@@ -0,0 +1,199 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/cord.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+namespace kvstore = ::tensorstore::kvstore;
+
+using ::tensorstore::Context;
+using ::tensorstore::OptionalByteRangeRequest;
+using ::tensorstore::Result;
+using ::tensorstore::internal::KeyValueStoreOpsTestParameters;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MatchesKvsReadResultNotFound;
+using ::tensorstore::internal::MatchesListEntry;
+using ::tensorstore::kvstore::KvStore;
+
+Result<KvStore> OpenLocalCache(Context context = Context::Default(),
+                               int64_t max_bytes = 1 << 20) {
+  return kvstore::Open({{"driver", "local_cache"},
+                        {"base", "memory://base/"},
+                        {"cache", "memory://cache/"},
+                        {"max_bytes", max_bytes}},
+                       context)
+      .result();
+}
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  KeyValueStoreOpsTestParameters params;
+  params.test_name = "Basic";
+  params.get_store = [](auto callback) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenLocalCache());
+    callback(store);
+  };
+  RegisterKeyValueStoreOpsTests(params);
+}
+
+class LocalCacheTest : public ::testing::Test {
+ public:
+  LocalCacheTest() : context_(Context::Default()) {}
+
+  KvStore Open(const char* url) {
+    return kvstore::Open(url, context_).value();
+  }
+
+  Context context_;
+};
+
+TEST_F(LocalCacheTest, ServesCachedValue) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenLocalCache(context_));
+  auto base = Open("memory://base/");
+  auto cache = Open("memory://cache/");
+
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("abc")));
+  EXPECT_THAT(kvstore::ListFuture(cache).result(),
+              ::testing::Optional(::testing::SizeIs(1)));
+
+  // Modify the base kvstore directly.
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base, "a", absl::Cord("xyz")));
+
+  // With an unbounded staleness bound, the cached value is used.
+  kvstore::ReadOptions options;
+  options.staleness_bound = absl::InfinitePast();
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResult(absl::Cord("abc")));
+
+  // Otherwise the cached value is validated.
+  EXPECT_THAT(kvstore::Read(store, "a").result(),
+              MatchesKvsReadResult(absl::Cord("xyz")));
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResult(absl::Cord("xyz")));
+
+  // Byte ranges are served from the cached value.
+  options.byte_range = OptionalByteRangeRequest::Range(1, 2);
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResult(absl::Cord("y")));
+}
+
+TEST_F(LocalCacheTest, BaseDeleted) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenLocalCache(context_));
+  auto base = Open("memory://base/");
+  auto cache = Open("memory://cache/");
+
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("abc")));
+  TENSORSTORE_ASSERT_OK(kvstore::Delete(base, "a"));
+  EXPECT_THAT(kvstore::Read(store, "a").result(),
+              MatchesKvsReadResultNotFound());
+  EXPECT_THAT(kvstore::ListFuture(cache).result(),
+              ::testing::Optional(::testing::IsEmpty()));
+}
+
+TEST_F(LocalCacheTest, DeleteRangeInvalidates) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenLocalCache(context_));
+
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("abc")));
+  absl::SleepFor(absl::Milliseconds(1));
+  TENSORSTORE_ASSERT_OK(kvstore::DeleteRange(store, {}));
+
+  kvstore::ReadOptions options;
+  options.staleness_bound = absl::InfinitePast();
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResultNotFound());
+}
+
+TEST_F(LocalCacheTest, Eviction) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store,
+                                   OpenLocalCache(context_, 1000));
+  auto cache = Open("memory://cache/");
+
+  const absl::Cord value(std::string(400, 'x'));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", value));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "b", value));
+  EXPECT_THAT(kvstore::ListFuture(cache).result(),
+              ::testing::Optional(::testing::SizeIs(2)));
+
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "c", value));
+  EXPECT_THAT(kvstore::ListFuture(cache).result(),
+              ::testing::Optional(::testing::SizeIs(2)));
+
+  // Values larger than `max_bytes` are not cached.
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Write(store, "d", absl::Cord(std::string(2000, 'x'))));
+  EXPECT_THAT(kvstore::ListFuture(cache).result(),
+              ::testing::Optional(::testing::SizeIs(2)));
+
+  // All values remain readable from the base kvstore.
+  for (const char* key : {"a", "b", "c"}) {
+    EXPECT_THAT(kvstore::Read(store, key).result(),
+                MatchesKvsReadResult(value));
+  }
+}
+
+TEST_F(LocalCacheTest, Reopen) {
+  auto base = Open("memory://base/");
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenLocalCache(context_));
+    TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("abc")));
+  }
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base, "a", absl::Cord("xyz")));
+
+  // A newly opened store uses the existing entries of the cache kvstore.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store,
+                                   OpenLocalCache(context_, 1 << 19));
+  kvstore::ReadOptions options;
+  options.staleness_bound = absl::InfinitePast();
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResult(absl::Cord("abc")));
+}
+
+TEST_F(LocalCacheTest, List) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenLocalCache(context_));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("abc")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "b", absl::Cord("de")));
+  EXPECT_THAT(kvstore::ListFuture(store).result(),
+              ::testing::Optional(::testing::UnorderedElementsAre(
+                  MatchesListEntry("a", 3), MatchesListEntry("b", 2))));
+}
+
+TEST_F(LocalCacheTest, SpecRoundtrip) {
+  tensorstore::internal::KeyValueStoreSpecRoundtripOptions options;
+  options.full_spec = {{"driver", "local_cache"},
+                       {"base", {{"driver", "memory"}, {"path", "base/"}}},
+                       {"cache", {{"driver", "memory"}, {"path", "cache/"}}},
+                       {"max_bytes", 1000}};
+  options.full_base_spec = {{"driver", "memory"}, {"path", "base/"}};
+  options.check_data_after_serialization = false;
+  tensorstore::internal::TestKeyValueStoreSpecRoundtrip(options);
+}
+
+}  // namespace
@@ -0,0 +1,84 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/local_cache/lru_index.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+
+namespace tensorstore {
+namespace internal_local_cache_kvstore {
+
+bool LruIndex::Touch(std::string_view name) {
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(name);
+  if (it == entries_.end()) return false;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return true;
+}
+
+std::vector<std::string> LruIndex::Insert(std::string name, int64_t size) {
+  std::vector<std::string> evicted;
+  absl::MutexLock lock(&mutex_);
+  if (auto it = entries_.find(name); it != entries_.end()) {
+    RemoveLocked(it->second);
+  }
+  if (size > max_bytes_) {
+    evicted.push_back(std::move(name));
+    return evicted;
+  }
+  lru_.emplace_front(std::move(name), size);
+  entries_.emplace(lru_.front().first, lru_.begin());
+  total_bytes_ += size;
+  while (total_bytes_ > max_bytes_) {
+    auto last = std::prev(lru_.end());
+    evicted.push_back(last->first);
+    RemoveLocked(last);
+  }
+  return evicted;
+}
+
+void LruIndex::Remove(std::string_view name) {
+  absl::MutexLock lock(&mutex_);
+  if (auto it = entries_.find(name); it != entries_.end()) {
+    RemoveLocked(it->second);
+  }
+}
+
+void LruIndex::RemoveLocked(List::iterator it) {
+  total_bytes_ -= it->second;
+  entries_.erase(it->first);
+  lru_.erase(it);
+}
+
+int64_t LruIndex::total_bytes() const {
+  absl::MutexLock lock(&mutex_);
+  return total_bytes_;
+}
+
+size_t LruIndex::size() const {
+  absl::MutexLock lock(&mutex_);
+  return lru_.size();
+}
+
+}  // namespace internal_local_cache_kvstore
+}  // namespace tensorstore
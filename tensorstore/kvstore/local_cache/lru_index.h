@@ -0,0 +1,82 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_LOCAL_CACHE_LRU_INDEX_H_
+#define TENSORSTORE_KVSTORE_LOCAL_CACHE_LRU_INDEX_H_
+
+#include <stdint.h>
+
+#include <list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace tensorstore {
+namespace internal_local_cache_kvstore {
+
+/// Tracks the entries stored in the local cache tier, in least-recently-used
+/// order, and determines which entries to evict to stay within a byte limit.
+///
+/// The index does not access storage itself; the caller is responsible for
+/// deleting the entries returned by `Insert`.
+class LruIndex {
+ public:
+  explicit LruIndex(int64_t max_bytes) : max_bytes_(max_bytes) {}
+
+  /// Marks `name` as most recently used.
+  ///
+  /// \returns `true` if `name` is present.
+  bool Touch(std::string_view name);
+
+  /// Adds or replaces the entry `name` as the most recently used entry.
+  ///
+  /// \returns The names of the least recently used entries which must be
+  ///     evicted to bring the total size within the limit.  Entries whose
+  ///     size alone exceeds the limit are not added, and are returned.
+  std::vector<std::string> Insert(std::string name, int64_t size);
+
+  /// Removes `name`, if present.
+  void Remove(std::string_view name);
+
+  /// Returns the total size of all entries.
+  int64_t total_bytes() const;
+
+  /// Returns the number of entries.
+  size_t size() const;
+
+  int64_t max_bytes() const { return max_bytes_; }
+
+ private:
+  using List = std::list<std::pair<std::string, int64_t>>;
+
+  void RemoveLocked(List::iterator it) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const int64_t max_bytes_;
+  mutable absl::Mutex mutex_;
+  // Ordered from most recently to least recently used.
+  List lru_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<std::string_view, List::iterator> entries_
+      ABSL_GUARDED_BY(mutex_);
+  int64_t total_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace internal_local_cache_kvstore
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_LOCAL_CACHE_LRU_INDEX_H_
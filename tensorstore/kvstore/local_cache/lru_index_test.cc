@@ -0,0 +1,75 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/local_cache/lru_index.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+using ::tensorstore::internal_local_cache_kvstore::LruIndex;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(LruIndexTest, Basic) {
+  LruIndex index(100);
+  EXPECT_FALSE(index.Touch("a"));
+  EXPECT_THAT(index.Insert("a", 40), IsEmpty());
+  EXPECT_THAT(index.Insert("b", 40), IsEmpty());
+  EXPECT_TRUE(index.Touch("a"));
+  EXPECT_EQ(80, index.total_bytes());
+  EXPECT_EQ(2, index.size());
+
+  // "b" is the least recently used entry.
+  EXPECT_THAT(index.Insert("c", 40), ElementsAre("b"));
+  EXPECT_FALSE(index.Touch("b"));
+  EXPECT_EQ(80, index.total_bytes());
+
+  index.Remove("a");
+  index.Remove("a");
+  EXPECT_FALSE(index.Touch("a"));
+  EXPECT_EQ(40, index.total_bytes());
+  EXPECT_EQ(1, index.size());
+}
+
+TEST(LruIndexTest, Replace) {
+  LruIndex index(100);
+  EXPECT_THAT(index.Insert("a", 40), IsEmpty());
+  EXPECT_THAT(index.Insert("b", 40), IsEmpty());
+  EXPECT_THAT(index.Insert("a", 60), IsEmpty());
+  EXPECT_EQ(100, index.total_bytes());
+  EXPECT_THAT(index.Insert("c", 10), ElementsAre("b"));
+  EXPECT_EQ(70, index.total_bytes());
+}
+
+TEST(LruIndexTest, EvictMultiple) {
+  LruIndex index(100);
+  EXPECT_THAT(index.Insert("a", 30), IsEmpty());
+  EXPECT_THAT(index.Insert("b", 30), IsEmpty());
+  EXPECT_THAT(index.Insert("c", 30), IsEmpty());
+  EXPECT_THAT(index.Insert("d", 100), ElementsAre("a", "b", "c"));
+  EXPECT_EQ(100, index.total_bytes());
+  EXPECT_EQ(1, index.size());
+}
+
+TEST(LruIndexTest, TooLarge) {
+  LruIndex index(100);
+  EXPECT_THAT(index.Insert("a", 30), IsEmpty());
+  EXPECT_THAT(index.Insert("a", 101), ElementsAre("a"));
+  EXPECT_FALSE(index.Touch("a"));
+  EXPECT_EQ(0, index.total_bytes());
+}
+
+}  // namespace
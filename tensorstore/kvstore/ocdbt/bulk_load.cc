@@ -0,0 +1,161 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/bulk_load.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include "absl/time/clock.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/driver.h"
+#include "tensorstore/kvstore/ocdbt/format/manifest.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/btree_bulk_loader.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/create_new_manifest.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+OcdbtBulkLoader::OcdbtBulkLoader(IoHandle::Ptr io_handle, std::string path,
+                                 std::shared_ptr<const Manifest> manifest,
+                                 const BulkLoadOptions& options)
+    : io_handle_(io_handle),
+      path_(std::move(path)),
+      manifest_(std::move(manifest)),
+      btree_loader_(std::move(io_handle), manifest_->config, flush_promise_,
+                    options.max_pending_data_files) {}
+
+Result<std::unique_ptr<OcdbtBulkLoader>> OcdbtBulkLoader::Make(
+    const kvstore::KvStore& store, const BulkLoadOptions& options) {
+  auto* driver = dynamic_cast<OcdbtDriver*>(store.driver.get());
+  if (!driver) {
+    return absl::InvalidArgumentError("Bulk load requires an OCDBT kvstore");
+  }
+  if (store.transaction != no_transaction) {
+    return absl::UnimplementedError("Bulk load does not support transactions");
+  }
+  if (driver->version_spec_) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Writing is not supported with version=%s specified",
+                        FormatVersionSpecForUrl(*driver->version_spec_)));
+  }
+  if (driver->coordinator_->address) {
+    return absl::UnimplementedError(
+        "Bulk load is not supported with a coordinator");
+  }
+  auto& io_handle = driver->io_handle_;
+  TENSORSTORE_ASSIGN_OR_RETURN(auto time,
+                               EnsureExistingManifest(io_handle).result());
+  TENSORSTORE_ASSIGN_OR_RETURN(auto manifest_with_time,
+                               io_handle->GetManifest(time).result());
+  auto& manifest = manifest_with_time.manifest;
+  if (!manifest) {
+    return absl::FailedPreconditionError("OCDBT manifest not found");
+  }
+  if (!manifest->latest_version().root.location.IsMissing()) {
+    return absl::FailedPreconditionError(absl::StrFormat(
+        "Bulk load requires an empty database, but generation %d of %s is "
+        "not empty",
+        manifest->latest_generation(), io_handle->DescribeLocation()));
+  }
+  return std::unique_ptr<OcdbtBulkLoader>(
+      new OcdbtBulkLoader(io_handle, store.path, manifest, options));
+}
+
+absl::Status OcdbtBulkLoader::Add(std::string_view key, absl::Cord value) {
+  key_buffer_.assign(path_);
+  key_buffer_.append(key);
+  return btree_loader_.Add(key_buffer_, std::move(value));
+}
+
+Result<GenerationNumber> OcdbtBulkLoader::Commit() {
+  TENSORSTORE_ASSIGN_OR_RETURN(auto new_generation, btree_loader_.Finish());
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto create_result,
+      CreateNewManifest(io_handle_, manifest_, new_generation).result());
+  auto& [new_manifest, version_tree_flush_future] = create_result;
+  if (!version_tree_flush_future.null()) {
+    flush_promise_.Link(std::move(version_tree_flush_future));
+  }
+  if (auto flush_future = std::move(flush_promise_).future();
+      !flush_future.null()) {
+    TENSORSTORE_RETURN_IF_ERROR(flush_future.status());
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto update_result,
+      io_handle_->TryUpdateManifest(manifest_, new_manifest, absl::Now())
+          .result());
+  if (!update_result.success) {
+    return absl::AbortedError(
+        "OCDBT database was modified concurrently with bulk load");
+  }
+  return new_manifest->latest_generation();
+}
+
+absl::Status BulkLoadFromKvStore(const kvstore::KvStore& source,
+                                 const kvstore::KvStore& store,
+                                 const BulkLoadOptions& options) {
+  TENSORSTORE_ASSIGN_OR_RETURN(auto loader,
+                               OcdbtBulkLoader::Make(store, options));
+  TENSORSTORE_ASSIGN_OR_RETURN(auto list_entries,
+                               kvstore::ListFuture(source).result());
+  std::vector<std::string> keys;
+  keys.reserve(list_entries.size());
+  for (auto& entry : list_entries) {
+    keys.push_back(std::move(entry.key));
+  }
+  list_entries.clear();
+  std::sort(keys.begin(), keys.end());
+
+  // Read the values in key order, keeping up to `read_concurrency` reads in
+  // flight.
+  const size_t read_concurrency = std::max<size_t>(1, options.read_concurrency);
+  std::deque<Future<kvstore::ReadResult>> reads;
+  size_t next_read = 0;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    for (; next_read < keys.size() && next_read < i + read_concurrency;
+         ++next_read) {
+      reads.push_back(kvstore::Read(source, keys[next_read]));
+    }
+    auto read_future = std::move(reads.front());
+    reads.pop_front();
+    TENSORSTORE_ASSIGN_OR_RETURN(auto read_result, read_future.result());
+    // Skip keys deleted after being listed.
+    if (!read_result.has_value()) continue;
+    TENSORSTORE_RETURN_IF_ERROR(
+        loader->Add(keys[i], std::move(read_result.value)));
+  }
+  return loader->Commit().status();
+}
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
@@ -0,0 +1,126 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_BULK_LOAD_H_
+#define TENSORSTORE_KVSTORE_OCDBT_BULK_LOAD_H_
+
+/// \file
+///
+/// Bulk loading of sorted key/value pairs into an empty OCDBT database.
+///
+/// Writing through the OCDBT kvstore stages mutations and merges them into the
+/// existing b+tree, which requires reading and re-encoding interior nodes on
+/// every commit.  For initial ingestion, the bulk loader instead builds the
+/// b+tree bottom-up from sorted input, writing each node exactly once, and
+/// commits the entire load as a single new version.
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/format/manifest.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/btree_bulk_loader.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+struct BulkLoadOptions {
+  /// Limit on concurrent reads from the source kvstore, used by
+  /// `BulkLoadFromKvStore`.
+  size_t read_concurrency = 64;
+
+  /// Maximum number of data files that may be in the process of being written
+  /// before `OcdbtBulkLoader::Add` waits.  Each data file is buffered in
+  /// memory, up to the `target_data_file_size` of the OCDBT kvstore.
+  size_t max_pending_data_files = 2;
+};
+
+/// Loads key/value pairs, supplied in strictly increasing key order, into an
+/// empty OCDBT database.
+///
+/// Values are written to data files of the `target_data_file_size` specified
+/// for the OCDBT kvstore, and b+tree nodes are packed up to
+/// `max_decoded_node_bytes`.  All keys are committed together, as a single new
+/// version, by `Commit`.
+///
+/// This class is not thread safe.
+class OcdbtBulkLoader {
+ public:
+  /// Prepares to load into the OCDBT database `store`.
+  ///
+  /// Creates the manifest if it does not already exist.
+  ///
+  /// \param store Writable, non-transactional OCDBT kvstore.  Keys passed to
+  ///     `Add` are relative to `store.path`.
+  /// \error `absl::StatusCode::kFailedPrecondition` if the latest version of
+  ///     the database is not empty.
+  static Result<std::unique_ptr<OcdbtBulkLoader>> Make(
+      const kvstore::KvStore& store, const BulkLoadOptions& options = {});
+
+  /// Adds a key/value pair.
+  ///
+  /// \error `absl::StatusCode::kInvalidArgument` if `key` is not greater than
+  ///     the previously added key.
+  absl::Status Add(std::string_view key, absl::Cord value);
+
+  /// Writes the remaining b+tree nodes, waits for all data to be written, and
+  /// commits a new manifest.
+  ///
+  /// Must be called at most once.
+  ///
+  /// \returns The generation number of the new version.
+  /// \error `absl::StatusCode::kAborted` if the database was modified
+  ///     concurrently.
+  Result<GenerationNumber> Commit();
+
+  /// Number of keys added.
+  size_t num_keys() const { return btree_loader_.num_keys(); }
+
+ private:
+  OcdbtBulkLoader(IoHandle::Ptr io_handle, std::string path,
+                  std::shared_ptr<const Manifest> manifest,
+                  const BulkLoadOptions& options);
+
+  IoHandle::Ptr io_handle_;
+  std::string path_;
+  std::string key_buffer_;
+  std::shared_ptr<const Manifest> manifest_;
+  FlushPromise flush_promise_;
+  BtreeBulkLoader btree_loader_;
+};
+
+/// Copies all keys of `source` into the empty OCDBT database `store`.
+///
+/// The keys of `source` are listed and sorted in memory, and the values are
+/// then read in key order with up to `options.read_concurrency` reads in
+/// flight.  Keys deleted from `source` after being listed are skipped.
+///
+/// \error `absl::StatusCode::kFailedPrecondition` if the latest version of
+///     `store` is not empty.
+absl::Status BulkLoadFromKvStore(const kvstore::KvStore& source,
+                                 const kvstore::KvStore& store,
+                                 const BulkLoadOptions& options = {});
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_BULK_LOAD_H_
@@ -0,0 +1,176 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/bulk_load.h"
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/log/absl_check.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/driver.h"
+#include "tensorstore/kvstore/ocdbt/test_util.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MatchesKvsReadResultNotFound;
+using ::tensorstore::internal_ocdbt::BulkLoadFromKvStore;
+using ::tensorstore::internal_ocdbt::OcdbtBulkLoader;
+using ::tensorstore::internal_ocdbt::OcdbtDriver;
+using ::tensorstore::internal_ocdbt::ReadManifest;
+using ::testing::SizeIs;
+
+std::string GetKey(int i) { return absl::StrFormat("key%06d", i); }
+
+// Alternates between values that are stored inline and values that are
+// written to data files.
+absl::Cord GetValue(int i) {
+  return absl::Cord(i % 2 ? absl::StrFormat("long_value_%d", i)
+                          : absl::StrFormat("%d", i % 100));
+}
+
+class BulkLoadTest : public ::testing::Test {
+ protected:
+  kvstore::KvStore OpenStore(std::string path = "") {
+    auto store = kvstore::Open({{"driver", "ocdbt"},
+                                {"base", "memory://bulk/"},
+                                {"path", path},
+                                {"config",
+                                 {{"max_decoded_node_bytes", 256},
+                                  {"max_inline_value_bytes", 4}}}},
+                               context_)
+                     .result();
+    ABSL_CHECK_OK(store.status());
+    return *store;
+  }
+
+  tensorstore::Context context_ = tensorstore::Context::Default();
+};
+
+TEST_F(BulkLoadTest, MultiLevel) {
+  constexpr int kNumKeys = 2000;
+  auto store = OpenStore();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto loader, OcdbtBulkLoader::Make(store));
+  for (int i = 0; i < kNumKeys; ++i) {
+    TENSORSTORE_ASSERT_OK(loader->Add(GetKey(i), GetValue(i)));
+  }
+  EXPECT_EQ(kNumKeys, loader->num_keys());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto generation, loader->Commit());
+  // Generation 1 is the empty version created by `Make`.
+  EXPECT_EQ(2, generation);
+
+  auto& driver = static_cast<OcdbtDriver&>(*store.driver);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto manifest, ReadManifest(driver));
+  ASSERT_TRUE(manifest);
+  EXPECT_EQ(2, manifest->latest_generation());
+  EXPECT_GE(manifest->latest_version().root_height, 2);
+
+  EXPECT_THAT(kvstore::ListFuture(store).result(),
+              ::testing::Optional(SizeIs(kNumKeys)));
+  for (int i = 0; i < kNumKeys; i += 37) {
+    EXPECT_THAT(kvstore::Read(store, GetKey(i)).result(),
+                MatchesKvsReadResult(GetValue(i)))
+        << i;
+  }
+  EXPECT_THAT(kvstore::Read(store, GetKey(kNumKeys - 1)).result(),
+              MatchesKvsReadResult(GetValue(kNumKeys - 1)));
+  EXPECT_THAT(kvstore::Read(store, "key").result(),
+              MatchesKvsReadResultNotFound());
+
+  // The loaded tree can be modified normally.
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Write(store, GetKey(kNumKeys), absl::Cord("x")).result());
+  EXPECT_THAT(kvstore::ListFuture(store).result(),
+              ::testing::Optional(SizeIs(kNumKeys + 1)));
+  EXPECT_THAT(kvstore::Read(store, GetKey(1)).result(),
+              MatchesKvsReadResult(GetValue(1)));
+}
+
+TEST_F(BulkLoadTest, Path) {
+  auto store = OpenStore("prefix/");
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto loader, OcdbtBulkLoader::Make(store));
+  TENSORSTORE_ASSERT_OK(loader->Add("a", absl::Cord("value_a")));
+  TENSORSTORE_ASSERT_OK(loader->Commit());
+  EXPECT_THAT(kvstore::Read(OpenStore(), "prefix/a").result(),
+              MatchesKvsReadResult(absl::Cord("value_a")));
+}
+
+TEST_F(BulkLoadTest, Empty) {
+  auto store = OpenStore();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto loader, OcdbtBulkLoader::Make(store));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto generation, loader->Commit());
+  EXPECT_EQ(2, generation);
+  EXPECT_THAT(kvstore::ListFuture(store).result(),
+              ::testing::Optional(SizeIs(0)));
+}
+
+TEST_F(BulkLoadTest, KeysNotIncreasing) {
+  auto store = OpenStore();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto loader, OcdbtBulkLoader::Make(store));
+  TENSORSTORE_ASSERT_OK(loader->Add("b", absl::Cord("b")));
+  EXPECT_THAT(loader->Add("a", absl::Cord("a")),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(loader->Add("b", absl::Cord("b")),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(BulkLoadTest, NonEmptyDatabase) {
+  auto store = OpenStore();
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("a")).result());
+  EXPECT_THAT(OcdbtBulkLoader::Make(store),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+}
+
+TEST_F(BulkLoadTest, NotOcdbt) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open("memory://", context_).result());
+  EXPECT_THAT(OcdbtBulkLoader::Make(store),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(BulkLoadTest, FromKvStore) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto source, kvstore::Open("memory://source/", context_).result());
+  constexpr int kNumKeys = 300;
+  // Write in reverse order to check that keys are sorted.
+  for (int i = kNumKeys - 1; i >= 0; --i) {
+    TENSORSTORE_ASSERT_OK(
+        kvstore::Write(source, GetKey(i), GetValue(i)).result());
+  }
+  auto store = OpenStore();
+  tensorstore::internal_ocdbt::BulkLoadOptions options;
+  options.read_concurrency = 7;
+  TENSORSTORE_ASSERT_OK(BulkLoadFromKvStore(source, store, options));
+  EXPECT_THAT(kvstore::ListFuture(store).result(),
+              ::testing::Optional(SizeIs(kNumKeys)));
+  for (int i = 0; i < kNumKeys; ++i) {
+    EXPECT_THAT(kvstore::Read(store, GetKey(i)).result(),
+                MatchesKvsReadResult(GetValue(i)))
+        << i;
+  }
+}
+
+}  // namespace
@@ -0,0 +1,206 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/non_distributed/btree_bulk_loader.h"
+
+#include <stddef.h>
+
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/btree_codec.h"
+#include "tensorstore/kvstore/ocdbt/format/btree_node_encoder.h"
+#include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/write_nodes.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/quote_string.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+namespace {
+
+ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
+
+// Number of nodes encoded together.  `BtreeNodeEncoder` balances the sizes of
+// the nodes it produces, so encoding several nodes at once avoids leaving an
+// underfull node at the end of each batch.
+constexpr size_t kNodesPerBatch = 16;
+
+}  // namespace
+
+BtreeBulkLoader::BtreeBulkLoader(IoHandle::Ptr io_handle, const Config& config,
+                                 FlushPromise& flush_promise,
+                                 size_t max_pending_data_files)
+    : io_handle_(std::move(io_handle)),
+      config_(config),
+      flush_promise_(flush_promise),
+      max_pending_data_files_(max_pending_data_files) {}
+
+bool BtreeBulkLoader::BatchFull(size_t num_entries,
+                                size_t estimated_size) const {
+  if (num_entries >= kMaxNodeArity) return true;
+  return config_.max_decoded_node_bytes != 0 &&
+         estimated_size >= kNodesPerBatch * config_.max_decoded_node_bytes;
+}
+
+absl::Status BtreeBulkLoader::Add(std::string_view key, absl::Cord value) {
+  if (num_keys_ != 0 && key <= last_key_) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Bulk load keys must be strictly increasing, but %s follows %s",
+        tensorstore::QuoteString(key), tensorstore::QuoteString(last_key_)));
+  }
+  last_key_ = key;
+  ++num_keys_;
+
+  LeafNodeValueReference value_reference;
+  if (value.size() <= config_.max_inline_value_bytes) {
+    value_reference = std::move(value);
+  } else {
+    auto& ref = value_reference.emplace<IndirectDataReference>();
+    TENSORSTORE_RETURN_IF_ERROR(TrackDataWrite(io_handle_->WriteData(
+        IndirectDataKind::kValue, std::move(value), ref)));
+  }
+  leaf_estimated_size_ +=
+      key.size() +
+      EstimateDecodedEntrySizeExcludingKey(LeafNodeEntry{key, value_reference});
+  leaf_entries_.push_back(
+      PendingLeafEntry{std::string(key), std::move(value_reference)});
+
+  if (!BatchFull(leaf_entries_.size(), leaf_estimated_size_)) {
+    return absl::OkStatus();
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto new_entries,
+                               EncodeLeafNodes(/*may_be_root=*/false));
+  return AddNodes(0, std::move(new_entries));
+}
+
+absl::Status BtreeBulkLoader::TrackDataWrite(Future<const void> future) {
+  if (future.null() || future.ready()) {
+    return future.null() ? absl::OkStatus() : future.status();
+  }
+  // `IndirectDataWriter` returns the same future for all writes to a given
+  // data file.
+  const bool new_file = pending_data_files_.empty() ||
+                        !HaveSameSharedState(future, pending_data_files_.back());
+  flush_promise_.Link(future);
+  if (!new_file) return absl::OkStatus();
+  pending_data_files_.push_back(std::move(future));
+  while (pending_data_files_.size() > max_pending_data_files_) {
+    // Data files other than the most recent one are already being written.
+    auto oldest = std::move(pending_data_files_.front());
+    pending_data_files_.pop_front();
+    TENSORSTORE_RETURN_IF_ERROR(oldest.status());
+  }
+  return absl::OkStatus();
+}
+
+Result<BtreeBulkLoader::EntryVector> BtreeBulkLoader::EncodeLeafNodes(
+    bool may_be_root) {
+  if (leaf_entries_.empty()) return EntryVector{};
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "Bulk load: encoding " << leaf_entries_.size() << " leaf entries";
+  BtreeLeafNodeEncoder encoder(config_, /*height=*/0,
+                               /*existing_prefix=*/{});
+  for (auto& entry : leaf_entries_) {
+    encoder.AddEntry(/*existing=*/false,
+                     LeafNodeEntry{entry.key, std::move(entry.value_reference)});
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto encoded_nodes,
+                               encoder.Finalize(may_be_root));
+  leaf_entries_.clear();
+  leaf_estimated_size_ = 0;
+  return WriteNodes(*io_handle_, flush_promise_, std::move(encoded_nodes));
+}
+
+Result<BtreeBulkLoader::EntryVector> BtreeBulkLoader::EncodeInteriorNodes(
+    size_t level, bool may_be_root) {
+  auto& pending = interior_levels_[level];
+  if (pending.entries.empty()) return EntryVector{};
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "Bulk load: encoding " << pending.entries.size()
+      << " interior entries at height " << (level + 1);
+  BtreeInteriorNodeEncoder encoder(config_,
+                                   static_cast<BtreeNodeHeight>(level + 1),
+                                   /*existing_prefix=*/{});
+  for (const auto& entry : pending.entries) {
+    AddNewInteriorEntry(encoder, entry);
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto encoded_nodes,
+                               encoder.Finalize(may_be_root));
+  pending.entries.clear();
+  pending.estimated_size = 0;
+  return WriteNodes(*io_handle_, flush_promise_, std::move(encoded_nodes));
+}
+
+absl::Status BtreeBulkLoader::AddNodes(size_t level, EntryVector new_entries) {
+  if (level + 1 >= std::numeric_limits<BtreeNodeHeight>::max()) {
+    return absl::DataLossError("Maximum B+tree height exceeded");
+  }
+  if (interior_levels_.size() <= level) interior_levels_.resize(level + 1);
+  auto& pending = interior_levels_[level];
+  for (auto& entry : new_entries) {
+    pending.estimated_size += entry.key.size() + kInteriorNodeFixedSize +
+                              entry.node.location.file_id.size();
+    pending.entries.push_back(std::move(entry));
+  }
+  if (!BatchFull(pending.entries.size(), pending.estimated_size)) {
+    return absl::OkStatus();
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto parent_entries,
+      EncodeInteriorNodes(level, /*may_be_root=*/false));
+  return AddNodes(level + 1, std::move(parent_entries));
+}
+
+Result<BtreeGenerationReference> BtreeBulkLoader::Finish() {
+  // Encode the remaining entries bottom-up.  Levels are only added when the
+  // level below is full, so the highest level always has pending entries and
+  // contains the entries of the root node.
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto entries,
+      EncodeLeafNodes(/*may_be_root=*/interior_levels_.empty()));
+  BtreeNodeHeight height = 0;
+  for (size_t level = 0; level < interior_levels_.size(); ++level) {
+    auto& pending = interior_levels_[level].entries;
+    pending.insert(pending.end(), std::make_move_iterator(entries.begin()),
+                   std::make_move_iterator(entries.end()));
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        entries,
+        EncodeInteriorNodes(
+            level, /*may_be_root=*/level + 1 == interior_levels_.size()));
+    height = static_cast<BtreeNodeHeight>(level + 1);
+  }
+  interior_levels_.clear();
+  pending_data_files_.clear();
+  return WriteRootNode(*io_handle_, flush_promise_, height,
+                       std::move(entries));
+}
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
@@ -0,0 +1,124 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_BTREE_BULK_LOADER_H_
+#define TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_BTREE_BULK_LOADER_H_
+
+#include <stddef.h>
+
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+/// Builds a new b+tree bottom-up from key/value pairs supplied in strictly
+/// increasing key order.
+///
+/// Unlike `BtreeWriter`, no existing nodes are read: leaf nodes are packed up
+/// to `Config::max_decoded_node_bytes` as entries arrive, and each completed
+/// batch of nodes is written immediately and added to the level above.  Only a
+/// bounded number of entries per tree level is kept in memory.
+///
+/// Values larger than `Config::max_inline_value_bytes` are written using
+/// `IoHandle::WriteData`, which packs them into data files of the target size
+/// configured for `io_handle`.  To bound memory usage, `Add` waits for the
+/// oldest data file writes to complete if more than `max_pending_data_files`
+/// are in progress.
+///
+/// This class is not thread safe.
+class BtreeBulkLoader {
+ public:
+  /// Constructs a bulk loader.
+  ///
+  /// \param io_handle I/O handle used to write nodes and values.
+  /// \param config Configuration of the database.
+  /// \param flush_promise Linked to all writes issued by this loader.  Must
+  ///     remain valid until `Finish` returns.
+  /// \param max_pending_data_files Maximum number of data files that may be in
+  ///     the process of being written.
+  BtreeBulkLoader(IoHandle::Ptr io_handle, const Config& config,
+                  FlushPromise& flush_promise,
+                  size_t max_pending_data_files = 2);
+
+  /// Adds a key/value pair.
+  ///
+  /// \error `absl::StatusCode::kInvalidArgument` if `key` is not greater than
+  ///     the previously added key.
+  absl::Status Add(std::string_view key, absl::Cord value);
+
+  /// Writes the remaining nodes and returns the root of the new tree.
+  ///
+  /// Only the `root` and `root_height` members of the returned reference are
+  /// set.  The writes are not complete until `flush_promise` is forced and
+  /// becomes ready.
+  Result<BtreeGenerationReference> Finish();
+
+  /// Number of keys added.
+  size_t num_keys() const { return num_keys_; }
+
+ private:
+  using EntryVector = std::vector<InteriorNodeEntryData<std::string>>;
+
+  struct PendingLeafEntry {
+    std::string key;
+    LeafNodeValueReference value_reference;
+  };
+
+  /// Entries, with absolute keys, of the nodes of a single height that have
+  /// not yet been encoded.
+  struct PendingLevel {
+    EntryVector entries;
+    size_t estimated_size = 0;
+  };
+
+  bool BatchFull(size_t num_entries, size_t estimated_size) const;
+  Result<EntryVector> EncodeLeafNodes(bool may_be_root);
+  Result<EntryVector> EncodeInteriorNodes(size_t level, bool may_be_root);
+  absl::Status AddNodes(size_t level, EntryVector new_entries);
+  absl::Status TrackDataWrite(Future<const void> future);
+
+  IoHandle::Ptr io_handle_;
+  Config config_;
+  FlushPromise& flush_promise_;
+  size_t max_pending_data_files_;
+
+  std::string last_key_;
+  size_t num_keys_ = 0;
+
+  std::vector<PendingLeafEntry> leaf_entries_;
+  size_t leaf_estimated_size_ = 0;
+
+  /// `interior_levels_[i]` holds the entries of the nodes of height `i + 1`.
+  std::vector<PendingLevel> interior_levels_;
+
+  /// Futures of the data files being written, oldest first.
+  std::deque<Future<const void>> pending_data_files_;
+};
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_BTREE_BULK_LOADER_H_
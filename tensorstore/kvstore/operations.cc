@@ -27,6 +27,9 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/time/clock.h"
+#include "tensorstore/internal/tracing/operation_trace_span.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/internal/tracing/trace_future.h"
 #include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/key_range.h"
@@ -80,7 +83,12 @@ Future<ReadResult> Read(const KvStore& store, std::string_view key,
   auto full_key = absl::StrCat(store.path, key);
   if (store.transaction == no_transaction) {
     // Regular non-transactional read.
-    return store.driver->Read(std::move(full_key), std::move(options));
+    internal_tracing::OperationTraceSpan span(
+        "kvstore.Read", {{"key", std::string_view(full_key)}});
+    internal_tracing::ScopedTraceContext trace_scope(span.context());
+    return internal_tracing::EndSpanWhenReady(
+        std::move(span),
+        store.driver->Read(std::move(full_key), std::move(options)));
   }
   TENSORSTORE_ASSIGN_OR_RETURN(
       auto open_transaction,
@@ -99,8 +107,13 @@ Future<TimestampedStorageGeneration> Write(const KvStore& store,
   auto full_key = absl::StrCat(store.path, key);
   if (store.transaction == no_transaction) {
     // Regular non-transactional write.
-    return store.driver->Write(std::move(full_key), std::move(value),
-                               std::move(options));
+    internal_tracing::OperationTraceSpan span(
+        "kvstore.Write", {{"key", std::string_view(full_key)}});
+    internal_tracing::ScopedTraceContext trace_scope(span.context());
+    return internal_tracing::EndSpanWhenReady(
+        std::move(span), store.driver->Write(std::move(full_key),
+                                             std::move(value),
+                                             std::move(options)));
   }
   TENSORSTORE_ASSIGN_OR_RETURN(
       auto open_transaction,
@@ -396,8 +396,8 @@ TEST_F(LocalStackFixture, BatchRead) {
                                    OpenStore(context, "batch_read/"));
 
   tensorstore::internal::BatchReadGenericCoalescingTestOptions options;
-  options.coalescing_options = tensorstore::internal_kvstore_batch::
-      kDefaultRemoteStorageCoalescingOptions;
+  options.coalescing_options =
+      tensorstore::internal_kvstore_batch::kS3CoalescingOptions;
   options.metric_prefix = "/tensorstore/kvstore/s3/";
   tensorstore::internal::TestBatchReadGenericCoalescing(store, options);
 }
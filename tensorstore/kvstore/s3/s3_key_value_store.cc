@@ -46,6 +46,7 @@
 #include "tensorstore/internal/http/http_request.h"
 #include "tensorstore/internal/http/http_response.h"
 #include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/http/request_hedging.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/log/verbose_flag.h"
@@ -60,6 +61,7 @@
 #include "tensorstore/internal/uri/percent_coder.h"
 #include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/coalesced_read_scheduler.h"
 #include "tensorstore/kvstore/common_metrics.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/generic_coalescing_batch_util.h"
@@ -117,10 +119,12 @@ using ::tensorstore::internal_kvstore_s3::IsValidBucketName;
 using ::tensorstore::internal_kvstore_s3::IsValidObjectName;
 using ::tensorstore::internal_kvstore_s3::IsValidStorageGeneration;
 using ::tensorstore::internal_kvstore_s3::MakeAwsCredentialsProvider;
+using ::tensorstore::internal_kvstore_s3::S3BatchReadCoalescing;
 using ::tensorstore::internal_kvstore_s3::S3ConcurrencyResource;
 using ::tensorstore::internal_kvstore_s3::S3EndpointRegion;
 using ::tensorstore::internal_kvstore_s3::S3RateLimiterResource;
 using ::tensorstore::internal_kvstore_s3::S3RequestBuilder;
+using ::tensorstore::internal_kvstore_s3::S3RequestHedging;
 using ::tensorstore::internal_kvstore_s3::S3RequestRetries;
 using ::tensorstore::internal_kvstore_s3::StorageGenerationFromHeaders;
 using ::tensorstore::kvstore::Key;
@@ -135,6 +139,7 @@ namespace jb = tensorstore::internal_json_binding;
 
 struct S3Metrics : public internal_kvstore::CommonMetrics {
   internal_metrics::Counter<int64_t> retries;
+  internal_http::RequestHedgingMetrics hedging;
 };
 ABSL_CONST_INIT static S3Metrics s3_metrics;
 
@@ -145,6 +150,14 @@ TENSORSTORE_GLOBAL_INITIALIZER {
              internal_metrics::MetricMetadata(
                  "/tensorstore/kvstore/s3/retries",
                  "s3 count of all retried requests (read/write/delete)"));
+  r.Register(&s3_metrics.hedging.hedged,
+             internal_metrics::MetricMetadata(
+                 "/tensorstore/kvstore/s3/hedged_requests",
+                 "s3 count of hedged (backup) read requests"));
+  r.Register(&s3_metrics.hedging.hedge_won,
+             internal_metrics::MetricMetadata(
+                 "/tensorstore/kvstore/s3/hedged_requests_won",
+                 "s3 count of hedged read requests that completed first"));
 }
 
 ABSL_CONST_INIT internal_log::VerboseFlag s3_logging("s3");
@@ -204,6 +217,17 @@ bool DefaultIsRetryableCode(absl::StatusCode code) {
          code == absl::StatusCode::kAborted;
 }
 
+// Reports the latency and size of a request, and whether the server throttled
+// it, to the request concurrency queue, which may adapt its limit.
+void ObserveResponse(RateLimiter& queue, absl::Time start_time,
+                     const Result<HttpResponse>& response,
+                     size_t request_bytes = 0) {
+  if (!response.ok()) return;
+  queue.ObserveResponse(
+      absl::Now() - start_time, request_bytes + response->payload.size(),
+      response->status_code == 429 || response->status_code == 503);
+}
+
 struct S3KeyValueStoreSpecData {
   std::string bucket;
   bool requester_pays;
@@ -216,12 +240,15 @@ struct S3KeyValueStoreSpecData {
   Context::Resource<S3ConcurrencyResource> request_concurrency;
   std::optional<Context::Resource<S3RateLimiterResource>> rate_limiter;
   Context::Resource<S3RequestRetries> retries;
+  Context::Resource<S3RequestHedging> request_hedging;
+  Context::Resource<S3BatchReadCoalescing> batch_read_coalescing;
   Context::Resource<DataCopyConcurrencyResource> data_copy_concurrency;
 
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
     return f(x.bucket, x.requester_pays, x.endpoint, x.host_header,
              x.aws_region, x.use_conditional_write, x.aws_credentials,
              x.request_concurrency, x.rate_limiter, x.retries,
+             x.request_hedging, x.batch_read_coalescing,
              x.data_copy_concurrency);
   };
 
@@ -270,6 +297,12 @@ struct S3KeyValueStoreSpecData {
                      jb::Projection<&S3KeyValueStoreSpecData::rate_limiter>()),
           jb::Member(S3RequestRetries::id,
                      jb::Projection<&S3KeyValueStoreSpecData::retries>()),
+          jb::Member(
+              S3RequestHedging::id,
+              jb::Projection<&S3KeyValueStoreSpecData::request_hedging>()),
+          jb::Member(S3BatchReadCoalescing::id,
+                     jb::Projection<
+                         &S3KeyValueStoreSpecData::batch_read_coalescing>()),
           jb::Member(
               DataCopyConcurrencyResource::id,
               jb::Projection<
@@ -308,14 +341,20 @@ class S3KeyValueStore
       : transport_(std::move(transport)),
         spec_(std::move(spec)),
         host_header_(spec_.host_header.value_or(std::string())),
-        provider_(std::move(provider)) {}
+        provider_(std::move(provider)),
+        batch_read_scheduler_(
+            internal::MakeIntrusivePtr<
+                internal_kvstore_batch::CoalescedReadScheduler>(
+                S3KeyValueStoreSpec::id,
+                spec_.batch_read_coalescing->max_concurrent_reads)) {}
 
   internal_kvstore_batch::CoalescingOptions GetBatchReadCoalescingOptions()
       const {
-    internal_kvstore_batch::CoalescingOptions options;
-    options.max_extra_read_bytes = 4095;
-    options.target_coalesced_size = 128 * 1024 * 1024;
-    return options;
+    return *spec_.batch_read_coalescing;
+  }
+
+  internal_kvstore_batch::CoalescedReadScheduler& batch_read_scheduler() {
+    return *batch_read_scheduler_;
   }
 
   Future<ReadResult> Read(Key key, ReadOptions options) override;
@@ -390,6 +429,8 @@ class S3KeyValueStore
   S3KeyValueStoreSpecData spec_;
   std::string host_header_;
   AwsCredentialsProvider provider_;
+  internal::IntrusivePtr<internal_kvstore_batch::CoalescedReadScheduler>
+      batch_read_scheduler_;
 
   absl::Mutex mutex_;  // Guards resolve_ehr_ creation.
   Future<const S3EndpointRegion> resolve_ehr_;
@@ -468,7 +509,9 @@ struct ReadTask : public RateLimiterNode,
                                      ehr.aws_region, kEmptySha256, start_time_);
 
     ABSL_LOG_IF(INFO, s3_logging) << "ReadTask: " << request;
-    auto future = owner->transport_->IssueRequest(request, {});
+    auto future = internal_http::IssueHedgedRequest(
+        owner->spec_.request_hedging->hedger, owner->transport_, request, {},
+        &s3_metrics.hedging);
     future.ExecuteWhenReady([self = IntrusivePtr<ReadTask>(this)](
                                 ReadyFuture<HttpResponse> response) {
       self->OnResponse(response.result());
@@ -476,6 +519,7 @@ struct ReadTask : public RateLimiterNode,
   }
 
   void OnResponse(const Result<HttpResponse>& response) {
+    ObserveResponse(owner->admission_queue(), start_time_, response);
     if (!promise.result_needed()) {
       return;
     }
@@ -699,6 +743,7 @@ struct WriteTask : public RateLimiterNode,
   }
 
   void OnHeadResponse(const Result<HttpResponse>& response) {
+    ObserveResponse(owner->admission_queue(), start_time_, response);
     if (IsCancelled()) {
       return;
     }
@@ -774,6 +819,8 @@ struct WriteTask : public RateLimiterNode,
   }
 
   void OnResponse(const Result<HttpResponse>& response) {
+    ObserveResponse(owner->admission_queue(), start_time_, response,
+                    value_.size());
     if (!promise.result_needed()) {
       return;
     }
@@ -916,6 +963,7 @@ struct DeleteTask : public RateLimiterNode,
   }
 
   void OnHeadResponse(const Result<HttpResponse>& response) {
+    ObserveResponse(owner->admission_queue(), start_time_, response);
     if (IsCancelled()) {
       return;
     }
@@ -977,6 +1025,7 @@ struct DeleteTask : public RateLimiterNode,
   }
 
   void OnResponse(const Result<HttpResponse>& response) {
+    ObserveResponse(owner->admission_queue(), start_time_, response);
     if (!promise.result_needed()) {
       return;
     }
@@ -1164,6 +1213,7 @@ struct ListTask : public RateLimiterNode,
   }
 
   void OnResponse(const Result<HttpResponse>& response) {
+    ObserveResponse(owner_->admission_queue(), start_time_, response);
     auto status = OnResponseImpl(response);
     // OkStatus are handled by OnResponseImpl
     if (absl::IsCancelled(status)) {
@@ -1436,6 +1486,10 @@ Result<kvstore::Spec> ParseS3Url(std::string_view url) {
       Context::Resource<S3ConcurrencyResource>::DefaultSpec();
   driver_spec->data_.retries =
       Context::Resource<S3RequestRetries>::DefaultSpec();
+  driver_spec->data_.request_hedging =
+      Context::Resource<S3RequestHedging>::DefaultSpec();
+  driver_spec->data_.batch_read_coalescing =
+      Context::Resource<S3BatchReadCoalescing>::DefaultSpec();
   driver_spec->data_.data_copy_concurrency =
       Context::Resource<DataCopyConcurrencyResource>::DefaultSpec();
 
@@ -15,19 +15,28 @@
 #include "tensorstore/kvstore/s3/s3_resource.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <optional>
+#include <string>
 
 #include "absl/base/attributes.h"
 #include "absl/base/call_once.h"
 #include "absl/flags/flag.h"
 #include "absl/log/absl_log.h"
+#include "absl/strings/str_cat.h"
 #include "absl/time/time.h"
 #include "tensorstore/context.h"
 #include "tensorstore/context_resource_provider.h"
 #include "tensorstore/internal/env.h"
 #include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/internal/metrics/gauge.h"
+#include "tensorstore/internal/metrics/metadata.h"
+#include "tensorstore/internal/metrics/registration.h"
+#include "tensorstore/internal/rate_limiter/adaptive_admission_queue.h"
 #include "tensorstore/internal/rate_limiter/admission_queue.h"
 #include "tensorstore/internal/rate_limiter/rate_limiter.h"
 #include "tensorstore/internal/rate_limiter/scaling_rate_limiter.h"
@@ -52,6 +61,7 @@ ABSL_FLAG(std::optional<absl::Duration>,
           "S3 Rate Limiter Doubling Time. "
           "Overrides TENSORSTORE_S3_RATE_LIMITER_DOUBLING_TIME");
 
+using ::tensorstore::internal::AdaptiveAdmissionQueue;
 using ::tensorstore::internal::AdmissionQueue;
 using ::tensorstore::internal::AnyContextResourceJsonBinder;
 using ::tensorstore::internal::ConstantRateLimiter;
@@ -60,6 +70,18 @@ using ::tensorstore::internal::DoublingRateLimiter;
 using ::tensorstore::internal::GetFlagOrEnvValue;
 using ::tensorstore::internal::NoRateLimiter;
 
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    s3_adaptive_concurrency_limit, (Gauge<int64_t, std::string>),
+    MetricMetadata("/tensorstore/kvstore/s3/adaptive_concurrency_limit",
+                   "Current limit of adaptive s3_request_concurrency "
+                   "queues"),
+    "queue");
+
+namespace {
+// Identifies each adaptive queue in `s3_adaptive_concurrency_limit`.
+ABSL_CONST_INIT std::atomic<int64_t> s3_adaptive_queue_id{0};
+}  // namespace
+
 namespace tensorstore {
 namespace internal_kvstore_s3 {
 namespace {
@@ -67,6 +89,12 @@ namespace {
 const internal::ContextResourceRegistration<S3RequestRetries>
     s3_request_retries_registration;
 
+const internal::ContextResourceRegistration<S3RequestHedging>
+    s3_request_hedging_registration;
+
+const internal::ContextResourceRegistration<S3BatchReadCoalescing>
+    s3_batch_read_coalescing_registration;
+
 const internal::ContextResourceRegistration<S3ConcurrencyResource>
     s3_concurrency_registration;
 
@@ -99,6 +127,20 @@ S3ConcurrencyResource::S3ConcurrencyResource()
 
 Result<S3ConcurrencyResource::Resource> S3ConcurrencyResource::Create(
     const Spec& spec, ContextResourceCreationContext context) const {
+  if (spec.adaptive) {
+    AdaptiveAdmissionQueue::Options options;
+    options.initial_limit = spec.limit.value_or(shared_limit_);
+    options.max_limit =
+        std::max(options.initial_limit,
+                 spec.max_limit.value_or(options.max_limit));
+    options.limit_gauge = &s3_adaptive_concurrency_limit;
+    options.limit_gauge_label = absl::StrCat(s3_adaptive_queue_id++);
+    Resource value;
+    value.spec = spec;
+    value.queue = std::make_shared<AdaptiveAdmissionQueue>(options);
+    return value;
+  }
+
   if (spec.limit) {
     Resource value;
     value.spec = spec;
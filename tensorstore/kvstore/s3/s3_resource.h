@@ -24,11 +24,14 @@
 #include "absl/time/time.h"
 #include "tensorstore/context.h"
 #include "tensorstore/context_resource_provider.h"
+#include "tensorstore/internal/http/request_hedging_resource.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/json_binding/std_optional.h"
 #include "tensorstore/internal/rate_limiter/admission_queue.h"
 #include "tensorstore/internal/rate_limiter/rate_limiter.h"
 #include "tensorstore/internal/retries_context_resource.h"
+#include "tensorstore/kvstore/batch_read_coalescing_resource.h"
+#include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/util/result.h"
 
 /// specializations
@@ -44,6 +47,23 @@ struct S3RequestRetries : public internal::RetriesResource<S3RequestRetries> {
   static constexpr bool config_only = true;
 };
 
+/// Specifies hedging of S3 read requests.
+struct S3RequestHedging
+    : public internal_http::RequestHedgingResource<S3RequestHedging> {
+  static constexpr char id[] = "s3_request_hedging";
+  static constexpr bool config_only = true;
+};
+
+/// Specifies how batch reads are coalesced.
+struct S3BatchReadCoalescing
+    : public internal_kvstore_batch::BatchReadCoalescingResource<
+          S3BatchReadCoalescing> {
+  static constexpr char id[] = "s3_batch_read_coalescing";
+  static Spec Default() {
+    return internal_kvstore_batch::kS3CoalescingOptions;
+  }
+};
+
 /// Specifies an admission queue as a context object.
 ///
 /// This provides a way to limit the concurrency across multiple tensorstores
@@ -59,24 +79,35 @@ struct S3ConcurrencyResource
   struct Spec {
     // If equal to `nullopt`, indicates that the shared executor is used.
     std::optional<size_t> limit;
+    // If `true`, the limit is adjusted based on request latency and
+    // throttling responses, starting from `limit`.
+    bool adaptive = false;
+    // Upper bound on the adaptive limit.
+    std::optional<size_t> max_limit;
 
     constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-      return f(x.limit);
+      return f(x.limit, x.adaptive, x.max_limit);
     };
   };
   struct Resource {
     Spec spec;
-    std::shared_ptr<internal::AdmissionQueue> queue;
+    std::shared_ptr<internal::RateLimiter> queue;
   };
 
   static Spec Default() { return Spec{std::nullopt}; }
 
   static constexpr auto JsonBinder() {
     namespace jb = tensorstore::internal_json_binding;
-    return jb::Object(jb::Member(
-        "limit",
-        jb::Projection<&Spec::limit>(jb::DefaultInitializedValue(
-            jb::Optional(jb::Integer<size_t>(1), [] { return "shared"; })))));
+    return jb::Object(
+        jb::Member("limit",
+                   jb::Projection<&Spec::limit>(jb::DefaultInitializedValue(
+                       jb::Optional(jb::Integer<size_t>(1),
+                                    [] { return "shared"; })))),
+        jb::Member("adaptive", jb::Projection<&Spec::adaptive>(
+                                   jb::DefaultInitializedValue())),
+        jb::Member("max_limit",
+                   jb::Projection<&Spec::max_limit>(
+                       jb::Optional(jb::Integer<size_t>(1)))));
   }
 
   Result<Resource> Create(
@@ -88,7 +119,8 @@ struct S3ConcurrencyResource
   }
 
  private:
-  /// Size of AdmissionQueue referenced by `shared_resource_`.
+  /// Size of AdmissionQueue referenced by `shared_resource_`, and the initial
+  /// limit of adaptive queues.
   size_t shared_limit_;
 
   /// Protects initialization of `shared_queue_`.
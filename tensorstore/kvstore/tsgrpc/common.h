@@ -46,6 +46,9 @@ DecodeGenerationAndTimestamp(const T& t) {
 
 /// Returns an absl::Status when given a tensorstore_gpc::StatuMessage
 absl::Status GetMessageStatus(const StatusMessage& t);
+
+/// Encodes an absl::Status as a tensorstore_grpc::StatusMessage
+void EncodeMessageStatus(const absl::Status& status, StatusMessage* t);
 template <typename T>
 
 absl::Status GetMessageStatus(const T& t) {
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <string>
@@ -38,6 +39,7 @@
 #include "grpcpp/server_context.h"  // third_party
 #include "grpcpp/support/server_callback.h"  // third_party
 #include "grpcpp/support/status.h"  // third_party
+#include "tensorstore/batch.h"
 #include "tensorstore/context.h"
 #include "tensorstore/internal/grpc/server_credentials.h"
 #include "tensorstore/internal/intrusive_ptr.h"
@@ -73,9 +75,12 @@
 using ::grpc::CallbackServerContext;
 using ::tensorstore::kvstore::ListEntry;
 using ::tensorstore_grpc::EncodeGenerationAndTimestamp;
+using ::tensorstore_grpc::EncodeMessageStatus;
 using ::tensorstore_grpc::Handler;
 using ::tensorstore_grpc::StreamClientRequestHandler;
 using ::tensorstore_grpc::StreamServerResponseHandler;
+using ::tensorstore_grpc::kvstore::BatchReadRequest;
+using ::tensorstore_grpc::kvstore::BatchReadResponse;
 using ::tensorstore_grpc::kvstore::DeleteRequest;
 using ::tensorstore_grpc::kvstore::DeleteResponse;
 using ::tensorstore_grpc::kvstore::ListRequest;
@@ -91,6 +96,11 @@ TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
     MetricMetadata("/tensorstore/kvstore/tsgrpc_server/read",
                    "KvStoreService::Read calls"));
 
+TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
+    batch_read_metric, Counter<int64_t>,
+    MetricMetadata("/tensorstore/kvstore/tsgrpc_server/batch_read",
+                   "KvStoreService::BatchRead calls"));
+
 TENSORSTORE_DECLARE_AND_REGISTER_METRIC(
     write_metric, Counter<int64_t>,
     MetricMetadata("/tensorstore/kvstore/tsgrpc_server/write",
@@ -116,6 +126,27 @@ ABSL_CONST_INIT internal_log::VerboseFlag verbose_logging("tsgrpc_kvstore");
 
 constexpr size_t kMaxReadChunkSize = 1 << 20;
 
+Result<kvstore::ReadOptions> GetReadOptions(const ReadRequest& request) {
+  kvstore::ReadOptions options{};
+  options.generation_conditions.if_equal.value = request.generation_if_equal();
+  options.generation_conditions.if_not_equal.value =
+      request.generation_if_not_equal();
+
+  if (request.has_byte_range()) {
+    options.byte_range.inclusive_min = request.byte_range().inclusive_min();
+    options.byte_range.exclusive_max = request.byte_range().exclusive_max();
+    if (!options.byte_range.SatisfiesInvariants()) {
+      return absl::InvalidArgumentError("Invalid byte range");
+    }
+  }
+  if (request.has_staleness_bound()) {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        options.staleness_bound,
+        internal::ProtoToAbslTime(request.staleness_bound()));
+  }
+  return options;
+}
+
 class ReadHandler final
     : public StreamServerResponseHandler<ReadRequest, ReadResponse> {
   using Base = StreamServerResponseHandler<ReadRequest, ReadResponse>;
@@ -128,27 +159,8 @@ class ReadHandler final
   void Run() {
     ABSL_LOG_IF(INFO, verbose_logging)
         << "ReadHandler " << ConciseDebugString(*request());
-    kvstore::ReadOptions options{};
-    options.generation_conditions.if_equal.value =
-        request()->generation_if_equal();
-    options.generation_conditions.if_not_equal.value =
-        request()->generation_if_not_equal();
-
-    if (request()->has_byte_range()) {
-      options.byte_range.inclusive_min =
-          request()->byte_range().inclusive_min();
-      options.byte_range.exclusive_max =
-          request()->byte_range().exclusive_max();
-      if (!options.byte_range.SatisfiesInvariants()) {
-        Finish(absl::InvalidArgumentError("Invalid byte range"));
-        return;
-      }
-    }
-    if (request()->has_staleness_bound()) {
-      TENSORSTORE_ASSIGN_OR_RETURN(
-          options.staleness_bound,
-          internal::ProtoToAbslTime(request()->staleness_bound()), Finish(_));
-    }
+    TENSORSTORE_ASSIGN_OR_RETURN(auto options, GetReadOptions(*request()),
+                                 Finish(_));
 
     internal::IntrusivePtr<ReadHandler> self{this};
     future_ = tensorstore::kvstore::Read(kvstore_, request()->key(), options);
@@ -213,6 +225,147 @@ class ReadHandler final
   size_t value_offset_ = 0;
 };
 
+class BatchReadHandler final
+    : public StreamServerResponseHandler<BatchReadRequest, BatchReadResponse> {
+  using Base = StreamServerResponseHandler<BatchReadRequest, BatchReadResponse>;
+
+ public:
+  BatchReadHandler(CallbackServerContext* grpc_context, const Request* request,
+                   KvStore kvstore)
+      : Base(grpc_context, request), kvstore_(std::move(kvstore)) {}
+
+  void Run() {
+    ABSL_LOG_IF(INFO, verbose_logging)
+        << "BatchReadHandler " << ConciseDebugString(*request());
+    const auto& requests = request()->requests();
+    std::vector<kvstore::ReadOptions> options(requests.size());
+    for (int i = 0; i < requests.size(); ++i) {
+      TENSORSTORE_ASSIGN_OR_RETURN(options[i], GetReadOptions(requests[i]),
+                                   Finish(_));
+    }
+    if (requests.empty()) {
+      Finish(::grpc::Status::OK);
+      return;
+    }
+
+    // Issue all reads using a single batch, such that the underlying kvstore
+    // may coalesce them.  The batch is submitted when `batch` is destroyed.
+    std::vector<Future<kvstore::ReadResult>> futures;
+    futures.reserve(requests.size());
+    {
+      auto batch = Batch::New();
+      for (int i = 0; i < requests.size(); ++i) {
+        options[i].batch = batch;
+        futures.push_back(tensorstore::kvstore::Read(
+            kvstore_, requests[i].key(), std::move(options[i])));
+      }
+    }
+    {
+      absl::MutexLock lock(mu_);
+      remaining_ = futures.size();
+      futures_ = futures;
+    }
+    // Callbacks may run inline, so they must be registered without holding
+    // `mu_`.
+    for (uint32_t i = 0; i < futures.size(); ++i) {
+      futures[i].ExecuteWhenReady(
+          [self = internal::IntrusivePtr<BatchReadHandler>(this),
+           i](ReadyFuture<kvstore::ReadResult> ready) {
+            self->HandleResult(i, std::move(ready).result());
+          });
+    }
+  }
+
+  void HandleResult(uint32_t index, Result<kvstore::ReadResult> result) {
+    absl::MutexLock lock(mu_);
+    pending_.emplace_back(index, std::move(result));
+    MaybeWrite();
+  }
+
+  void OnCancel() final {
+    std::vector<Future<kvstore::ReadResult>> futures;
+    absl::MutexLock lock(mu_);
+    std::swap(futures, futures_);
+    if (finished_) return;
+    finished_ = true;
+    Finish(::grpc::Status(::grpc::StatusCode::CANCELLED, ""));
+  }
+
+  void OnWriteDone(bool ok) final {
+    absl::MutexLock lock(mu_);
+    write_in_flight_ = false;
+    if (!ok) {
+      // OnDone is going to be called after we return from this method.
+      if (!finished_) {
+        finished_ = true;
+        Finish(::grpc::Status(::grpc::StatusCode::UNKNOWN, "Write failed"));
+      }
+      return;
+    }
+    MaybeWrite();
+  }
+
+ private:
+  /// Starts writing the next message, if no write is in flight.
+  ///
+  /// The value of each result is split into multiple messages, which are
+  /// written consecutively, as for `ReadHandler`.
+  void MaybeWrite() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    if (write_in_flight_ || finished_) return;
+    response_.Clear();
+    if (value_offset_ < value_.size()) {
+      // Continue writing the value of the current result.
+      response_.set_request_index(current_index_);
+    } else {
+      if (pending_.empty()) {
+        if (remaining_ == 0) {
+          finished_ = true;
+          Finish(::grpc::Status::OK);
+        }
+        return;
+      }
+      auto& [index, result] = pending_.front();
+      --remaining_;
+      current_index_ = index;
+      response_.set_request_index(index);
+      auto& r = *response_.mutable_response();
+      if (!result.ok()) {
+        EncodeMessageStatus(result.status(), r.mutable_status());
+        value_.Clear();
+      } else {
+        r.set_state(static_cast<ReadResponse::State>(result->state));
+        EncodeGenerationAndTimestamp(result->stamp, &r);
+        value_ = std::move(result->value);
+      }
+      value_offset_ = 0;
+      pending_.pop_front();
+    }
+    auto next_part = value_.Subcord(value_offset_, kMaxReadChunkSize);
+    value_offset_ = std::min(value_.size(), value_offset_ + next_part.size());
+    response_.mutable_response()->set_value_part(std::move(next_part));
+    write_in_flight_ = true;
+    StartWrite(&response_);
+  }
+
+  KvStore kvstore_;
+
+  absl::Mutex mu_;
+  std::vector<Future<kvstore::ReadResult>> futures_ ABSL_GUARDED_BY(mu_);
+
+  // Results that have not yet been written, in order of completion.
+  std::deque<std::pair<uint32_t, Result<kvstore::ReadResult>>> pending_
+      ABSL_GUARDED_BY(mu_);
+  // Number of results that have not yet started to be written.
+  size_t remaining_ ABSL_GUARDED_BY(mu_) = 0;
+  bool write_in_flight_ ABSL_GUARDED_BY(mu_) = false;
+  bool finished_ ABSL_GUARDED_BY(mu_) = false;
+
+  BatchReadResponse response_ ABSL_GUARDED_BY(mu_);
+  uint32_t current_index_ ABSL_GUARDED_BY(mu_) = 0;
+  absl::Cord value_ ABSL_GUARDED_BY(mu_);
+  size_t value_offset_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
 class WriteHandler final
     : public StreamClientRequestHandler<WriteRequest, WriteResponse> {
   using Base = StreamClientRequestHandler<WriteRequest, WriteResponse>;
@@ -531,6 +684,19 @@ class KvStoreServer::Impl final : public KvStoreService::CallbackService {
     return handler.get();
   }
 
+  ::grpc::ServerWriteReactor<::tensorstore_grpc::kvstore::BatchReadResponse>*
+  BatchRead(::grpc::CallbackServerContext* context,
+            const BatchReadRequest* request) override {
+    batch_read_metric.Increment();
+    internal::IntrusivePtr<BatchReadHandler> handler(
+        new BatchReadHandler(context, request, kvstore_));
+    assert(handler->use_count() == 2);
+    handler->Run();
+    assert(handler->use_count() > 0);
+    if (handler->use_count() == 1) return nullptr;
+    return handler.get();
+  }
+
   ::grpc::ServerReadReactor<::tensorstore_grpc::kvstore::WriteRequest>* Write(
       ::grpc::CallbackServerContext* context,
       WriteResponse* response) override {
@@ -25,8 +25,10 @@
 #include "absl/synchronization/notification.h"
 #include "absl/time/clock.h"
 #include <nlohmann/json.hpp>
+#include "tensorstore/batch.h"
 #include "tensorstore/context.h"
 #include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/operations.h"
@@ -47,6 +49,7 @@ using ::tensorstore::KeyRange;
 using ::tensorstore::grpc_kvstore::KvStoreServer;
 using ::tensorstore::internal::IsRegularStorageGeneration;
 using ::tensorstore::internal::KeyValueStoreOpsTestParameters;
+using ::tensorstore::internal::MatchesKvsReadResult;
 using ::tensorstore::internal::MatchesKvsReadResultNotFound;
 using ::tensorstore::internal::MatchesTimestampedStorageGeneration;
 
@@ -258,4 +261,45 @@ TEST_F(KvStoreTest, MultiPartReadWrite) {
                                 generation.generation, testing::Ge(now)));
 }
 
+
+TEST_F(KvStoreTest, BatchRead) {
+  absl::Cord value;
+  char x = ' ';
+  while (value.size() < (2 << 20)) {
+    value.Append(std::string(1 << 12, x));
+    x++;
+    if (static_cast<int>(x) > 126) x = ' ';
+  }
+
+  auto context = tensorstore::Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, tensorstore::kvstore::Open({{"driver", "tsgrpc_kvstore"},
+                                              {"address", address()},
+                                              {"path", "batch_read/"}},
+                                             context)
+                      .result());
+
+  TENSORSTORE_EXPECT_OK(kvstore::Write(store, "large", value));
+  TENSORSTORE_EXPECT_OK(kvstore::Write(store, "small", absl::Cord("abcdef")));
+
+  // Multi-part responses for different requests must not be interleaved.
+  std::vector<tensorstore::Future<kvstore::ReadResult>> futures;
+  {
+    auto batch = tensorstore::Batch::New();
+    kvstore::ReadOptions options;
+    options.batch = batch;
+    futures.push_back(kvstore::Read(store, "large", options));
+    futures.push_back(kvstore::Read(store, "missing", options));
+    options.byte_range = tensorstore::OptionalByteRangeRequest{1, 3};
+    futures.push_back(kvstore::Read(store, "small", options));
+    options.byte_range = tensorstore::OptionalByteRangeRequest{};
+    futures.push_back(kvstore::Read(store, "large", options));
+  }
+
+  EXPECT_THAT(futures[0].result(), MatchesKvsReadResult(value));
+  EXPECT_THAT(futures[1].result(), MatchesKvsReadResultNotFound());
+  EXPECT_THAT(futures[2].result(), MatchesKvsReadResult(absl::Cord("bc")));
+  EXPECT_THAT(futures[3].result(), MatchesKvsReadResult(value));
+}
+
 }  // namespace
@@ -37,6 +37,9 @@ class MockKvStoreService : public kvstore::grpc_gen::KvStoreService::Service {
   TENSORSTORE_GRPC_SERVER_STREAMING_MOCK(
       Read, ::tensorstore_grpc::kvstore::ReadRequest,
       ::tensorstore_grpc::kvstore::ReadResponse);
+  TENSORSTORE_GRPC_SERVER_STREAMING_MOCK(
+      BatchRead, ::tensorstore_grpc::kvstore::BatchReadRequest,
+      ::tensorstore_grpc::kvstore::BatchReadResponse);
   TENSORSTORE_GRPC_CLIENT_STREAMING_MOCK(
       Write, ::tensorstore_grpc::kvstore::WriteRequest,
       ::tensorstore_grpc::kvstore::WriteResponse);
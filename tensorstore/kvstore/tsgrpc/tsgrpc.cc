@@ -24,11 +24,14 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/attributes.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "grpcpp/channel.h"  // third_party
@@ -38,6 +41,7 @@
 #include "grpcpp/support/client_callback.h"  // third_party
 #include "grpcpp/support/status.h"  // third_party
 #include "grpcpp/support/sync_stream.h"  // third_party
+#include "tensorstore/batch.h"
 #include "tensorstore/context.h"
 #include "tensorstore/internal/concurrency_resource.h"
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
@@ -52,6 +56,7 @@
 #include "tensorstore/internal/metrics/counter.h"
 #include "tensorstore/internal/metrics/metadata.h"
 #include "tensorstore/internal/metrics/registry.h"
+#include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/common_metrics.h"
 #include "tensorstore/kvstore/driver.h"
@@ -91,6 +96,8 @@ using ::tensorstore::kvstore::ListEntry;
 using ::tensorstore::kvstore::ListReceiver;
 using ::tensorstore_grpc::DecodeGenerationAndTimestamp;
 using ::tensorstore_grpc::GetMessageStatus;
+using ::tensorstore_grpc::kvstore::BatchReadRequest;
+using ::tensorstore_grpc::kvstore::BatchReadResponse;
 using ::tensorstore_grpc::kvstore::DeleteRequest;
 using ::tensorstore_grpc::kvstore::DeleteResponse;
 using ::tensorstore_grpc::kvstore::ListRequest;
@@ -109,6 +116,7 @@ namespace jb = tensorstore::internal_json_binding;
 struct TsGrpcMetrics : public internal_kvstore::CommonReadMetrics,
                        public internal_kvstore::CommonWriteMetrics {
   internal_metrics::Counter<int64_t> delete_calls;
+  internal_metrics::Counter<int64_t> batch_read;
 };
 ABSL_CONST_INIT static TsGrpcMetrics tsgrpc_metrics;
 
@@ -120,6 +128,10 @@ TENSORSTORE_GLOBAL_INITIALIZER {
              internal_metrics::MetricMetadata(
                  "/tensorstore/kvstore/tsgrpc/delete_calls",
                  "tsgrpc kvstore::Write calls deleting a key"));
+  r.Register(&tsgrpc_metrics.batch_read,
+             internal_metrics::MetricMetadata(
+                 "/tensorstore/kvstore/tsgrpc/batch_read",
+                 "tsgrpc BatchRead calls issued for batched kvstore::Read"));
 }
 
 ABSL_CONST_INIT internal_log::VerboseFlag verbose_logging("tsgrpc_kvstore");
@@ -181,6 +193,9 @@ class TsGrpcKeyValueStore
 
   Future<ReadResult> Read(Key key, ReadOptions options) override;
 
+  /// Issues a single (non-batched) Read RPC.
+  void StartReadTask(Promise<ReadResult> promise, ReadRequest request);
+
   Future<TimestampedStorageGeneration> Write(Key key,
                                              std::optional<Value> value,
                                              WriteOptions options) override;
@@ -201,6 +216,24 @@ void MaybeSetDeadline(grpc::ClientContext& context, absl::Duration timeout) {
   }
 }
 
+ReadRequest MakeReadRequest(
+    kvstore::Key key, OptionalByteRangeRequest byte_range,
+    const kvstore::ReadGenerationConditions& generation_conditions,
+    absl::Time staleness_bound) {
+  ReadRequest request;
+  request.set_key(std::move(key));
+  request.set_generation_if_equal(generation_conditions.if_equal.value);
+  request.set_generation_if_not_equal(generation_conditions.if_not_equal.value);
+  if (!byte_range.IsFull()) {
+    request.mutable_byte_range()->set_inclusive_min(byte_range.inclusive_min);
+    request.mutable_byte_range()->set_exclusive_max(byte_range.exclusive_max);
+  }
+  if (staleness_bound != absl::InfiniteFuture()) {
+    AbslTimeToProto(staleness_bound, request.mutable_staleness_bound());
+  }
+  return request;
+}
+
 ////////////////////////////////////////////////////
 
 // Implements TsGrpcKeyValueStore::Read
@@ -303,31 +336,241 @@ struct ReadTask : public internal::AtomicReferenceCount<ReadTask>,
   }
 };
 
+void TsGrpcKeyValueStore::StartReadTask(Promise<ReadResult> promise,
+                                        ReadRequest request) {
+  auto task =
+      internal::MakeIntrusivePtr<ReadTask>(executor(), std::move(promise));
+  task->request_ = std::move(request);
+  task->Start(*auth_strategy_, spec_.timeout, stub_.get());
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+// Batched read request.  Unlike most drivers, the key is a request member
+// rather than part of the batch entry key, since a single BatchRead RPC may
+// read any number of keys.
+struct BatchReadKeyRequest {
+  Promise<kvstore::ReadResult> promise;
+  OptionalByteRangeRequest byte_range;
+  kvstore::Key key;
+  kvstore::ReadGenerationConditions generation_conditions;
+};
+
+using BatchReadEntryBase =
+    internal_kvstore_batch::BatchReadEntry<TsGrpcKeyValueStore,
+                                           BatchReadKeyRequest>;
+
+// Implements batched TsGrpcKeyValueStore::Read using the BatchRead RPC.
+//
+// Responses for each request are streamed by the server in completion order;
+// the messages for a single request are always consecutive.
+// TODO: Add retries.
+struct BatchReadTask : public internal::AtomicReferenceCount<BatchReadTask>,
+                       public grpc::ClientReadReactor<BatchReadResponse> {
+  using Request = BatchReadEntryBase::Request;
+
+  internal::IntrusivePtr<TsGrpcKeyValueStore> driver_;
+  absl::InlinedVector<Request, 1> requests_;
+  absl::Time staleness_bound_;
+
+  // working state.
+  std::shared_ptr<grpc::ClientContext> context_;
+  BatchReadRequest request_;
+  BatchReadResponse response_;
+  bool received_any_ = false;
+  std::vector<bool> resolved_;
+  std::optional<uint32_t> current_index_;
+  Result<kvstore::ReadResult> current_result_;
+  absl::Status protocol_error_;
+
+  BatchReadTask(internal::IntrusivePtr<TsGrpcKeyValueStore> driver,
+                absl::InlinedVector<Request, 1> requests,
+                absl::Time staleness_bound)
+      : driver_(std::move(driver)),
+        requests_(std::move(requests)),
+        staleness_bound_(staleness_bound),
+        resolved_(requests_.size(), false) {
+    for (const auto& r : requests_) {
+      *request_.add_requests() =
+          MakeReadRequest(r.key, r.byte_range, r.generation_conditions,
+                          staleness_bound_);
+    }
+  }
+
+  void TryCancel() { context_->TryCancel(); }
+
+  void Start() {
+    context_ = std::make_shared<grpc::ClientContext>();
+    MaybeSetDeadline(*context_, driver_->spec_.timeout);
+    auto context_future = driver_->auth_strategy_->ConfigureContext(context_);
+
+    context_future.ExecuteWhenReady(
+        [self = internal::IntrusivePtr<BatchReadTask>(this)](
+            ReadyFuture<std::shared_ptr<grpc::ClientContext>> f) {
+          self->StartImpl();
+        });
+  }
+
+  void StartImpl() {
+    // The call is cancelled once none of the results are needed.
+    for (auto& r : requests_) {
+      r.promise.ExecuteWhenNotNeeded(
+          [self = internal::IntrusivePtr<BatchReadTask>(this)] {
+            for (const auto& request : self->requests_) {
+              if (request.promise.result_needed()) return;
+            }
+            self->TryCancel();
+          });
+    }
+
+    intrusive_ptr_increment(this);  // adopted in OnDone.
+    driver_->stub()->async()->BatchRead(context_.get(), &request_, this);
+
+    StartRead(&response_);
+    StartCall();
+  }
+
+  void OnReadDone(bool ok) override {
+    if (!ok) return;
+    received_any_ = true;
+    protocol_error_ = HandleResponse();
+    if (!protocol_error_.ok()) {
+      TryCancel();
+      return;
+    }
+    StartRead(&response_);
+  }
+
+  absl::Status HandleResponse() {
+    const uint32_t index = response_.request_index();
+    if (index >= requests_.size()) {
+      return absl::DataLossError(
+          absl::StrCat("Invalid BatchRead request_index: ", index));
+    }
+    const auto& response = response_.response();
+    if (current_index_ != index) {
+      // First message for a new request.
+      if (resolved_[index]) {
+        return absl::DataLossError(
+            absl::StrCat("Duplicate BatchRead response for index: ", index));
+      }
+      ResolveCurrent();
+      current_index_ = index;
+      if (auto status = GetMessageStatus(response); !status.ok()) {
+        current_result_ = std::move(status);
+        return absl::OkStatus();
+      }
+      TENSORSTORE_ASSIGN_OR_RETURN(auto stamp,
+                                   DecodeGenerationAndTimestamp(response));
+      kvstore::ReadResult result;
+      result.stamp = std::move(stamp);
+      result.state = static_cast<kvstore::ReadResult::State>(response.state());
+      current_result_ = std::move(result);
+    }
+    if (current_result_.ok()) {
+      current_result_->value.Append(response.value_part());
+    }
+    return absl::OkStatus();
+  }
+
+  // Resolves the request for which a response was most recently received.
+  void ResolveCurrent() {
+    if (!current_index_) return;
+    const uint32_t index = *std::exchange(current_index_, std::nullopt);
+    resolved_[index] = true;
+    driver_->executor()([promise = requests_[index].promise,
+                         result = std::move(current_result_)]() mutable {
+      if (!promise.result_needed()) return;
+      promise.SetResult(std::move(result));
+    });
+  }
+
+  void OnDone(const grpc::Status& s) override {
+    internal::IntrusivePtr<BatchReadTask> self(this,
+                                               internal::adopt_object_ref);
+    driver_->executor()([self = std::move(self), status = s]() {
+      self->ReadFinished(GrpcStatusToAbslStatus(status));
+    });
+  }
+
+  void ReadFinished(absl::Status status) {
+    ABSL_LOG_IF(INFO, verbose_logging)
+        << "BatchReadTask::ReadFinished " << requests_.size() << " "
+        << status;
+    if (!protocol_error_.ok()) status = protocol_error_;
+
+    if (absl::IsUnimplemented(status) && !received_any_) {
+      // The server does not support BatchRead; fall back to individual Read
+      // calls.  The promises are copied rather than moved since the
+      // `ExecuteWhenNotNeeded` callbacks may still access them.
+      for (auto& r : requests_) {
+        if (!r.promise.result_needed()) continue;
+        driver_->StartReadTask(
+            r.promise, MakeReadRequest(std::move(r.key), r.byte_range,
+                                       r.generation_conditions,
+                                       staleness_bound_));
+      }
+      return;
+    }
+
+    if (status.ok()) {
+      ResolveCurrent();
+      status = absl::DataLossError("Missing BatchRead response");
+    }
+    for (size_t i = 0; i < requests_.size(); ++i) {
+      if (resolved_[i] || !requests_[i].promise.result_needed()) continue;
+      requests_[i].promise.SetResult(status);
+    }
+  }
+};
+
+class BatchReadEntry final : public BatchReadEntryBase {
+ public:
+  using BatchReadEntryBase::BatchReadEntryBase;
+
+  void Submit(Batch::View batch) final {
+    std::unique_ptr<BatchReadEntry> self{this};
+    auto& requests = request_batch.requests;
+    if (requests.empty()) return;
+    auto& driver = this->driver();
+    if (requests.size() == 1) {
+      // A single request does not benefit from batching, and is also
+      // supported by servers that do not implement BatchRead.
+      auto& r = requests[0];
+      driver.StartReadTask(
+          std::move(r.promise),
+          MakeReadRequest(std::move(r.key), r.byte_range,
+                          r.generation_conditions,
+                          request_batch.staleness_bound));
+      return;
+    }
+    tsgrpc_metrics.batch_read.Increment();
+    internal::MakeIntrusivePtr<BatchReadTask>(
+        internal::IntrusivePtr<TsGrpcKeyValueStore>(&driver),
+        std::move(requests), request_batch.staleness_bound)
+        ->Start();
+  }
+};
+
 /// Key value store operations.
 Future<kvstore::ReadResult> TsGrpcKeyValueStore::Read(Key key,
                                                       ReadOptions options) {
   tsgrpc_metrics.read.Increment();
 
   auto pair = PromiseFuturePair<kvstore::ReadResult>::Make();
-
-  auto task =
-      internal::MakeIntrusivePtr<ReadTask>(executor(), std::move(pair.promise));
-  auto& request = task->request_;
-  request.set_key(std::move(key));
-  request.set_generation_if_equal(options.generation_conditions.if_equal.value);
-  request.set_generation_if_not_equal(
-      options.generation_conditions.if_not_equal.value);
-  if (!options.byte_range.IsFull()) {
-    request.mutable_byte_range()->set_inclusive_min(
-        options.byte_range.inclusive_min);
-    request.mutable_byte_range()->set_exclusive_max(
-        options.byte_range.exclusive_max);
+  if (options.batch) {
+    // Requests within a batch are combined into a single BatchRead RPC.
+    BatchReadEntry::MakeRequest<BatchReadEntry>(
+        *this, options.batch, options.staleness_bound,
+        BatchReadEntry::Request{std::move(pair.promise), options.byte_range,
+                                std::move(key),
+                                std::move(options.generation_conditions)});
+  } else {
+    StartReadTask(std::move(pair.promise),
+                  MakeReadRequest(std::move(key), options.byte_range,
+                                  options.generation_conditions,
+                                  options.staleness_bound));
   }
-  if (options.staleness_bound != absl::InfiniteFuture()) {
-    AbslTimeToProto(options.staleness_bound, request.mutable_staleness_bound());
-  }
-
-  task->Start(*auth_strategy_, spec_.timeout, stub_.get());
   return std::move(pair.future);
 }
 
@@ -20,12 +20,14 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/synchronization/notification.h"
 #include "absl/time/time.h"
 #include "grpcpp/grpcpp.h"  // third_party
 #include "grpcpp/support/status.h"  // third_party
 #include "grpcpp/support/sync_stream.h"  // third_party
+#include "tensorstore/batch.h"
 #include "tensorstore/internal/grpc/grpc_mock.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/generation.h"
@@ -33,6 +35,7 @@
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/test_matchers.h"
 #include "tensorstore/kvstore/tsgrpc/mock_kvstore_service.h"
 #include "tensorstore/proto/parse_text_proto_or_die.h"
 #include "tensorstore/proto/protobuf_matchers.h"
@@ -50,15 +53,19 @@ namespace kvstore = ::tensorstore::kvstore;
 
 using ::protobuf_matchers::EqualsProto;
 using ::tensorstore::KeyRange;
+using ::tensorstore::MatchesStatus;
 using ::tensorstore::OptionalByteRangeRequest;
 using ::tensorstore::ParseTextProtoOrDie;
 using ::tensorstore::StorageGeneration;
+using ::tensorstore::internal::MatchesKvsReadResult;
 using ::testing::_;
 using ::testing::DoAll;
 using ::testing::Return;
 using ::testing::SetArgPointee;
 
 using ::tensorstore_grpc::MockKvStoreService;
+using ::tensorstore_grpc::kvstore::BatchReadRequest;
+using ::tensorstore_grpc::kvstore::BatchReadResponse;
 using ::tensorstore_grpc::kvstore::DeleteRequest;
 using ::tensorstore_grpc::kvstore::DeleteResponse;
 using ::tensorstore_grpc::kvstore::ListRequest;
@@ -74,6 +81,7 @@ class TsGrpcMockTest : public testing::Test {
   TsGrpcMockTest() {
     /// Unmatched calls all return CANCELLED.
     ON_CALL(mock(), Read).WillByDefault(Return(grpc::Status::CANCELLED));
+    ON_CALL(mock(), BatchRead).WillByDefault(Return(grpc::Status::CANCELLED));
     ON_CALL(mock(), Write).WillByDefault(Return(grpc::Status::CANCELLED));
     ON_CALL(mock(), Delete).WillByDefault(Return(grpc::Status::CANCELLED));
     ON_CALL(mock(), List).WillByDefault(Return(grpc::Status::CANCELLED));
@@ -202,6 +210,102 @@ TEST_F(TsGrpcMockTest, ReadMultipart) {
   EXPECT_EQ(result.stamp.generation, StorageGeneration::FromString("1"));
 }
 
+TEST_F(TsGrpcMockTest, BatchRead) {
+  BatchReadRequest expected_request = ParseTextProtoOrDie(R"pb(
+    requests { key: 'abc' }
+    requests {
+      key: 'def'
+      generation_if_not_equal: "\x00xyz"
+      byte_range { inclusive_min: 1 exclusive_max: 10 }
+    }
+  )pb");
+
+  // Responses are streamed in completion order.
+  std::vector<BatchReadResponse> responses{
+      ParseTextProtoOrDie(R"pb(
+        request_index: 1
+        response {
+          state: 2
+          value_part: '1234'
+          generation_and_timestamp {
+            generation: '\x001'
+            timestamp { seconds: 1634327736 nanos: 123456 }
+          }
+        }
+      )pb"),
+      ParseTextProtoOrDie(R"pb(
+        request_index: 1
+        response { value_part: '5678' }
+      )pb"),
+      ParseTextProtoOrDie(R"pb(
+        request_index: 0
+        response { status { code: 5 message: 'not found' } }
+      )pb"),
+  };
+
+  EXPECT_CALL(mock(), BatchRead(_, EqualsProto(expected_request), _))
+      .WillOnce([=](auto*, auto*, grpc::ServerWriter<BatchReadResponse>* resp)
+                    -> ::grpc::Status {
+        for (const auto& response : responses) {
+          resp->Write(response);
+        }
+        return grpc::Status::OK;
+      });
+
+  auto store = OpenStore();
+  tensorstore::Future<kvstore::ReadResult> future0, future1;
+  {
+    auto batch = tensorstore::Batch::New();
+    kvstore::ReadOptions options;
+    options.batch = batch;
+    future0 = kvstore::Read(store, "abc", options);
+    options.generation_conditions.if_not_equal =
+        StorageGeneration::FromString("xyz");
+    options.byte_range = OptionalByteRangeRequest{1, 10};
+    future1 = kvstore::Read(store, "def", options);
+  }
+
+  EXPECT_THAT(future0.result(),
+              MatchesStatus(absl::StatusCode::kNotFound, "not found"));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto result, future1.result());
+  EXPECT_TRUE(result.has_value());
+  EXPECT_EQ(result.value, "12345678");
+  EXPECT_EQ(result.stamp.generation, StorageGeneration::FromString("1"));
+}
+
+TEST_F(TsGrpcMockTest, BatchReadUnimplemented) {
+  // Servers without BatchRead support are sent individual Read calls.
+  EXPECT_CALL(mock(), BatchRead)
+      .WillOnce(Return(grpc::Status(grpc::StatusCode::UNIMPLEMENTED, "")));
+
+  for (const char* key : {"abc", "def"}) {
+    ReadRequest expected_request;
+    expected_request.set_key(key);
+    EXPECT_CALL(mock(), Read(_, EqualsProto(expected_request), _))
+        .WillOnce([key](auto*, auto*, grpc::ServerWriter<ReadResponse>* resp)
+                      -> ::grpc::Status {
+          ReadResponse response;
+          response.set_state(ReadResponse::VALUE);
+          response.set_value_part(key);
+          resp->Write(response);
+          return grpc::Status::OK;
+        });
+  }
+
+  auto store = OpenStore();
+  tensorstore::Future<kvstore::ReadResult> future0, future1;
+  {
+    auto batch = tensorstore::Batch::New();
+    kvstore::ReadOptions options;
+    options.batch = batch;
+    future0 = kvstore::Read(store, "abc", options);
+    future1 = kvstore::Read(store, "def", options);
+  }
+
+  EXPECT_THAT(future0.result(), MatchesKvsReadResult(absl::Cord("abc")));
+  EXPECT_THAT(future1.result(), MatchesKvsReadResult(absl::Cord("def")));
+}
+
 TEST_F(TsGrpcMockTest, Write) {
   WriteRequest expected_request = ParseTextProtoOrDie(R"pb(
     key: 'abc'
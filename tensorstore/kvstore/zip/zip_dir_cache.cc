@@ -27,6 +27,7 @@
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "riegeli/bytes/cord_reader.h"
 #include "riegeli/bytes/cord_writer.h"
@@ -42,6 +43,7 @@
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_result.h"
 #include "tensorstore/kvstore/zip/cached_dir.h"
+#include "tensorstore/util/executor.h"
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/status.h"
@@ -58,21 +60,20 @@ ABSL_CONST_INIT internal_log::VerboseFlag zip_logging("zip");
 
 struct ReadDirectoryOp
     : public internal::AtomicReferenceCount<ReadDirectoryOp> {
-  ZipDirectoryCache::Entry* entry_;
+  ZipArchiveReadFunction read_;
+  Executor executor_;
+  Promise<ZipDirectoryReadResult> promise_;
 
   kvstore::ReadOptions options_;
   internal_zip::ZipEOCD eocd_;
+  StorageGeneration eocd_generation_;
   std::shared_ptr<const CachedDir> existing_read_data_;
 
-  explicit ReadDirectoryOp(ZipDirectoryCache::Entry* entry) : entry_(entry) {}
-
   void StartEOCDBlockRead() {
-    auto& cache = internal::GetOwningCache(*entry_);
     ABSL_LOG_IF(INFO, zip_logging)
-        << "StartEOCDBlockRead " << entry_->key() << " " << options_.byte_range;
+        << "StartEOCDBlockRead " << options_.byte_range;
 
-    auto future =
-        cache.kvstore_driver_->Read(std::string(entry_->key()), options_);
+    auto future = read_(options_);
 
     future.Force();
     future.ExecuteWhenReady(
@@ -93,7 +94,7 @@ struct ReadDirectoryOp
         StartEOCDBlockRead();
         return;
       }
-      entry_->ReadError(
+      promise_.SetResult(
           StatusBuilder(std::move(r).status())
               .With(internal::ConvertInvalidArgumentToFailedPrecondition));
       return;
@@ -103,22 +104,21 @@ struct ReadDirectoryOp
     if (read_result.aborted()) {
       // The generation matched `if_not_equal`, indicating the cached data is
       // still valid and unchanged. Re-publish it with the updated stamp.
-      entry_->ReadSuccess(ZipDirectoryCache::ReadState{
+      promise_.SetResult(ZipDirectoryReadResult{
           std::move(existing_read_data_), std::move(read_result.stamp)});
       return;
     }
     if (read_result.not_found()) {
       // The base file was not found. Return a missing entry.
-      entry_->ReadSuccess(
-          ZipDirectoryCache::ReadState{nullptr, std::move(read_result.stamp)});
+      promise_.SetResult(
+          ZipDirectoryReadResult{nullptr, std::move(read_result.stamp)});
       return;
     }
 
-    GetOwningCache(*entry_).executor()(
-        [self = internal::IntrusivePtr<ReadDirectoryOp>(this),
-         ready = std::move(ready)]() {
-          self->DoDecodeEOCDBlock(std::move(ready));
-        });
+    executor_([self = internal::IntrusivePtr<ReadDirectoryOp>(this),
+               ready = std::move(ready)]() {
+      self->DoDecodeEOCDBlock(std::move(ready));
+    });
   }
 
   void DoDecodeEOCDBlock(ReadyFuture<kvstore::ReadResult> ready) {
@@ -131,7 +131,7 @@ struct ReadDirectoryOp
     auto read_eocd_variant = TryReadFullEOCD(reader, eocd_, block_offset);
     if (auto* status = std::get_if<absl::Status>(&read_eocd_variant);
         status != nullptr && !status->ok()) {
-      entry_->ReadError(std::move(*status));
+      promise_.SetResult(std::move(*status));
       return;
     }
 
@@ -154,15 +154,13 @@ struct ReadDirectoryOp
     }
 
     // Central Directory is outside the EOCD block; read it separately.
+    eocd_generation_ = ready.value().stamp.generation;
     kvstore::ReadOptions other_options = options_;
-    other_options.generation_conditions.if_equal =
-        ready.value().stamp.generation;
+    other_options.generation_conditions.if_equal = eocd_generation_;
     other_options.byte_range = OptionalByteRangeRequest::Range(
         eocd_.cd_offset, eocd_.cd_offset + eocd_.cd_size);
 
-    auto& cache = internal::GetOwningCache(*entry_);
-    auto future =
-        cache.kvstore_driver_->Read(std::string(entry_->key()), other_options);
+    auto future = read_(std::move(other_options));
     future.Force();
     future.ExecuteWhenReady(
         [self = internal::IntrusivePtr<ReadDirectoryOp>(this)](
@@ -175,33 +173,37 @@ struct ReadDirectoryOp
     auto& r = ready.result();
     if (!r.ok()) {
       ABSL_LOG_IF(INFO, zip_logging) << r.status();
-      entry_->ReadError(
+      promise_.SetResult(
           StatusBuilder(std::move(r).status())
               .With(internal::ConvertInvalidArgumentToFailedPrecondition));
       return;
     }
 
     auto& read_result = *r;
-    if (read_result.aborted()) {
+    // The `if_equal` condition is not supported by all read functions (e.g.
+    // transactional reads), so the generation is also checked here.
+    if (read_result.aborted() ||
+        (read_result.has_value() &&
+         read_result.stamp.generation != eocd_generation_)) {
       // The `if_equal` condition was not satisfied, meaning that the file was
       // modified or replaced, so reading starts over from the EOCD block.
       options_.byte_range =
           OptionalByteRangeRequest::SuffixLength(internal_zip::kEOCDBlockSize);
+      options_.staleness_bound = absl::Now();
       StartEOCDBlockRead();
       return;
     }
     if (!read_result.has_value()) {
       // no_value and not_found are equivalent here.
-      entry_->ReadSuccess(
-          ZipDirectoryCache::ReadState{nullptr, std::move(read_result.stamp)});
+      promise_.SetResult(
+          ZipDirectoryReadResult{nullptr, std::move(read_result.stamp)});
       return;
     }
 
-    GetOwningCache(*entry_).executor()(
-        [self = internal::IntrusivePtr<ReadDirectoryOp>(this),
-         ready = std::move(ready)]() {
-          self->DoDecodeDirectory(std::move(ready), 0);
-        });
+    executor_([self = internal::IntrusivePtr<ReadDirectoryOp>(this),
+               ready = std::move(ready)]() {
+      self->DoDecodeDirectory(std::move(ready), 0);
+    });
   }
 
   void DoDecodeDirectory(ReadyFuture<kvstore::ReadResult> ready,
@@ -216,7 +218,7 @@ struct ReadDirectoryOp
         DecodeDirectoryEntries(reader, eocd_.num_entries, eocd_.cd_offset);
     if (!dir_result.ok()) {
       // Decoding the directory failed, which is a legitimate error.
-      entry_->ReadError(dir_result.status());
+      promise_.SetResult(dir_result.status());
       return;
     }
     CachedDir dir = std::move(*dir_result);
@@ -224,7 +226,7 @@ struct ReadDirectoryOp
 
     ABSL_LOG_IF(INFO, zip_logging) << dir;
 
-    entry_->ReadSuccess(ZipDirectoryCache::ReadState{
+    promise_.SetResult(ZipDirectoryReadResult{
         std::make_shared<const CachedDir>(std::move(dir)),
         std::move(ready.value().stamp)});
   }
@@ -232,35 +234,59 @@ struct ReadDirectoryOp
 
 }  // namespace
 
+Future<ZipDirectoryReadResult> ReadZipDirectory(
+    ZipArchiveReadFunction read, Executor executor,
+    kvstore::ReadOptions options, std::shared_ptr<const CachedDir> existing) {
+  auto [promise, future] = PromiseFuturePair<ZipDirectoryReadResult>::Make();
+  auto state = internal::MakeIntrusivePtr<ReadDirectoryOp>();
+  state->read_ = std::move(read);
+  state->executor_ = std::move(executor);
+  state->promise_ = std::move(promise);
+  state->options_ = std::move(options);
+  if (existing && existing->full_read) {
+    // The previous read required the full file (e.g., suffix was too small
+    // for the EOCD), so don't regress to a suffix read.
+    state->options_.byte_range = OptionalByteRangeRequest{};
+  } else {
+    state->options_.byte_range =
+        OptionalByteRangeRequest::SuffixLength(internal_zip::kEOCDBlockSize);
+  }
+  state->existing_read_data_ = std::move(existing);
+  state->StartEOCDBlockRead();
+  return std::move(future);
+}
+
 size_t ZipDirectoryCache::Entry::ComputeReadDataSizeInBytes(
     const void* read_data) {
   return internal::EstimateHeapUsage(*static_cast<const ReadData*>(read_data));
 }
 
 void ZipDirectoryCache::Entry::DoRead(AsyncCacheReadRequest request) {
-  bool do_full_read = false;
-  auto state = internal::MakeIntrusivePtr<ReadDirectoryOp>(this);
+  kvstore::ReadOptions options;
+  std::shared_ptr<const CachedDir> existing;
   {
     ZipDirectoryCache::ReadLock<ZipDirectoryCache::ReadData> lock(*this);
-    if (auto data = lock.shared_data()) {
-      do_full_read = data->full_read;
-    }
-    state->options_.generation_conditions.if_not_equal =
+    options.generation_conditions.if_not_equal =
         lock.read_state().stamp.generation;
-    state->existing_read_data_ = lock.shared_data();
-  }
-
-  state->options_.staleness_bound = request.staleness_bound;
-  if (do_full_read) {
-    // The previous read required the full file (e.g., suffix was too small
-    // for the EOCD), so don't regress to a suffix read.
-    state->options_.byte_range = OptionalByteRangeRequest{};
-  } else {
-    state->options_.byte_range =
-        OptionalByteRangeRequest::SuffixLength(internal_zip::kEOCDBlockSize);
+    existing = lock.shared_data();
   }
-
-  state->StartEOCDBlockRead();
+  options.staleness_bound = request.staleness_bound;
+
+  auto& cache = GetOwningCache(*this);
+  ReadZipDirectory(
+      [driver = cache.kvstore_driver_,
+       key = std::string(this->key())](kvstore::ReadOptions options) {
+        return driver->Read(key, std::move(options));
+      },
+      cache.executor(), std::move(options), std::move(existing))
+      .ExecuteWhenReady([this](ReadyFuture<ZipDirectoryReadResult> future) {
+        auto& r = future.result();
+        if (!r.ok()) {
+          ReadError(r.status());
+          return;
+        }
+        ReadSuccess(ReadState{std::move(r->dir), std::move(r->stamp)});
+      });
 }
 
 ZipDirectoryCache::Entry* ZipDirectoryCache::DoAllocateEntry() {
@@ -18,17 +18,45 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <functional>
+#include <memory>
 #include <utility>
 
 #include "absl/base/optimization.h"
 #include "tensorstore/internal/cache/async_cache.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
 #include "tensorstore/kvstore/spec.h"
 #include "tensorstore/kvstore/zip/cached_dir.h"
 #include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
 
 namespace tensorstore {
 namespace internal_zip_kvstore {
 
+// Result of `ReadZipDirectory`.
+struct ZipDirectoryReadResult {
+  // Directory of the archive, or `nullptr` if the archive does not exist.
+  std::shared_ptr<const CachedDir> dir;
+  TimestampedStorageGeneration stamp;
+};
+
+// Reads a byte range of the archive.
+using ZipArchiveReadFunction =
+    std::function<Future<kvstore::ReadResult>(kvstore::ReadOptions)>;
+
+// Reads the directory of a ZIP archive using `read`.
+//
+// The end of central directory record is located by reading a suffix of the
+// archive, and the central directory is then read separately if it is not
+// contained in that suffix.  If the archive generation matches
+// `options.generation_conditions.if_not_equal`, `existing` is returned with an
+// updated stamp.  The `if_equal` condition need not be supported by `read`.
+Future<ZipDirectoryReadResult> ReadZipDirectory(
+    ZipArchiveReadFunction read, Executor executor,
+    kvstore::ReadOptions options, std::shared_ptr<const CachedDir> existing);
+
 // Cache used for reading the ZIP directory.
 class ZipDirectoryCache : public internal::AsyncCache {
   using Base = internal::AsyncCache;
@@ -61,11 +61,15 @@
 #include "tensorstore/kvstore/registry.h"
 #include "tensorstore/kvstore/spec.h"
 #include "tensorstore/kvstore/supported_features.h"
+#include "tensorstore/kvstore/transaction.h"
 #include "tensorstore/kvstore/url_registry.h"
 #include "tensorstore/kvstore/zip/cached_dir.h"
 #include "tensorstore/kvstore/zip/zip_dir_cache.h"
+#include "tensorstore/kvstore/zip/zip_write_cache.h"
 #include "tensorstore/transaction.h"
 #include "tensorstore/util/execution/execution.h"
+#include "tensorstore/util/execution/sender.h"
+#include "tensorstore/util/execution/sender_util.h"
 #include "tensorstore/util/executor.h"
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/garbage_collection/fwd.h"
@@ -82,6 +86,7 @@
 #include "tensorstore/util/garbage_collection/std_vector.h"  // IWYU pragma: keep
 
 using ::tensorstore::internal_zip_kvstore::ZipDirectoryCache;
+using ::tensorstore::internal_zip_kvstore::ZipWriteCache;
 using ::tensorstore::kvstore::ListEntry;
 using ::tensorstore::kvstore::ListReceiver;
 
@@ -162,6 +167,27 @@ class ZipKvStore
 
   void ListImpl(ListOptions options, ListReceiver receiver) override;
 
+  Future<ReadResult> TransactionalRead(
+      const internal::OpenTransactionPtr& transaction, Key key,
+      ReadOptions options) override;
+
+  void TransactionalListImpl(const internal::OpenTransactionPtr& transaction,
+                             ListOptions options,
+                             ListReceiver receiver) override;
+
+  Future<TimestampedStorageGeneration> Write(Key key,
+                                             std::optional<Value> value,
+                                             WriteOptions options) override;
+
+  absl::Status ReadModifyWrite(internal::OpenTransactionPtr& transaction,
+                               size_t& phase, Key key,
+                               ReadModifyWriteSource& source) override;
+
+  absl::Status TransactionalDeleteRange(
+      const internal::OpenTransactionPtr& transaction, KeyRange range) override;
+
+  Future<const void> DeleteRange(KeyRange range) override;
+
   absl::Status GetBoundSpecData(ZipKvStoreSpecData& spec) const {
     spec = spec_data_;
     return absl::OkStatus();
@@ -190,6 +216,8 @@ class ZipKvStore
   ZipKvStoreSpecData spec_data_;
   kvstore::KvStore base_;
   internal::PinnedCacheEntry<ZipDirectoryCache> cache_entry_;
+  // Buffers writes; the entry key is `base_.path`.
+  internal::CachePtr<ZipWriteCache> write_cache_;
 };
 
 Future<kvstore::DriverPtr> ZipKvStoreSpec::DoOpen() const {
@@ -210,11 +238,19 @@ Future<kvstore::DriverPtr> ZipKvStoreSpec::DoOpen() const {
                   spec->data_.data_copy_concurrency->executor);
             });
 
+        auto write_cache = internal::GetCache<ZipWriteCache>(
+            cache_pool.get(), cache_key, [&] {
+              return std::make_unique<ZipWriteCache>(
+                  base_kvstore.driver,
+                  spec->data_.data_copy_concurrency->executor);
+            });
+
         auto driver = internal::MakeIntrusivePtr<ZipKvStore>();
         driver->base_ = std::move(base_kvstore);
         driver->spec_data_ = std::move(spec->data_);
         driver->cache_entry_ =
             GetCacheEntry(directory_cache, driver->base_.path);
+        driver->write_cache_ = std::move(write_cache);
         return driver;
       },
       kvstore::Open(data_.base));
@@ -635,6 +671,71 @@ void ZipKvStore::ListImpl(ListOptions options, ListReceiver receiver) {
             cache_entry_->Read({state_ptr->options_.staleness_bound}));
 }
 
+Future<kvstore::ReadResult> ZipKvStore::TransactionalRead(
+    const internal::OpenTransactionPtr& transaction, Key key,
+    ReadOptions options) {
+  auto entry = GetCacheEntry(write_cache_, base_.path);
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto node, GetWriteLockedTransactionNode(*entry, transaction));
+  internal_kvstore::MultiPhaseMutation* multi_phase_mutation = &*node;
+  return multi_phase_mutation->ReadImpl(
+      internal::OpenTransactionNodePtr<ZipWriteCache::TransactionNode>(&*node),
+      this, std::move(key), std::move(options), [&node] { node.unlock(); });
+}
+
+void ZipKvStore::TransactionalListImpl(
+    const internal::OpenTransactionPtr& transaction, ListOptions options,
+    ListReceiver receiver) {
+  auto entry = GetCacheEntry(write_cache_, base_.path);
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto node, GetWriteLockedTransactionNode(*entry, transaction),
+      execution::submit(FlowSingleSender{ErrorSender{std::move(_)}},
+                        std::move(receiver)));
+  auto* multi_phase_mutation = &*node;
+  multi_phase_mutation->ListImpl(node.unlock(), std::move(options),
+                                 std::move(receiver));
+}
+
+Future<TimestampedStorageGeneration> ZipKvStore::Write(
+    Key key, std::optional<Value> value, WriteOptions options) {
+  return internal_kvstore::WriteViaTransaction(
+      this, std::move(key), std::move(value), std::move(options));
+}
+
+absl::Status ZipKvStore::ReadModifyWrite(
+    internal::OpenTransactionPtr& transaction, size_t& phase, Key key,
+    ReadModifyWriteSource& source) {
+  TENSORSTORE_RETURN_IF_ERROR(ValidateMemberKey(key));
+  auto entry = GetCacheEntry(write_cache_, base_.path);
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto node, GetWriteLockedTransactionNode(*entry, transaction));
+  node->ReadModifyWrite(phase, std::move(key), source);
+  if (!transaction) {
+    // User did not specify a transaction.  Return the implicit transaction
+    // that was created.
+    transaction.reset(node.unlock()->transaction());
+  }
+  return absl::OkStatus();
+}
+
+absl::Status ZipKvStore::TransactionalDeleteRange(
+    const internal::OpenTransactionPtr& transaction, KeyRange range) {
+  auto entry = GetCacheEntry(write_cache_, base_.path);
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto node, GetWriteLockedTransactionNode(*entry, transaction));
+  node->DeleteRange(std::move(range));
+  return absl::OkStatus();
+}
+
+Future<const void> ZipKvStore::DeleteRange(KeyRange range) {
+  internal::OpenTransactionPtr transaction;
+  auto entry = GetCacheEntry(write_cache_, base_.path);
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto node, GetWriteLockedTransactionNode(*entry, transaction));
+  node->DeleteRange(std::move(range));
+  return node->transaction()->future();
+}
+
 Result<kvstore::Spec> ParseZipUrl(std::string_view url, kvstore::Spec base) {
   auto parsed = internal_uri::ParseGenericUri(url);
   if (parsed.scheme != ZipKvStoreSpec::id || parsed.has_authority_delimiter) {
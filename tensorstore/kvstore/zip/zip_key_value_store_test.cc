@@ -23,24 +23,31 @@
 #include "absl/log/absl_check.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/notification.h"
 #include <nlohmann/json.hpp>
+#include "riegeli/bytes/cord_reader.h"
 #include "riegeli/bytes/cord_writer.h"
 #include "riegeli/bytes/fd_reader.h"
 #include "riegeli/bytes/read_all.h"
 #include "tensorstore/context.h"
 #include "tensorstore/internal/compression/zip_details.h"
 #include "tensorstore/internal/compression/zip_easy.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/internal/testing/json_gtest.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/mock_kvstore.h"
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_result.h"
 #include "tensorstore/kvstore/spec.h"
 #include "tensorstore/kvstore/test_matchers.h"
 #include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/transaction.h"
 #include "tensorstore/util/execution/execution.h"
 #include "tensorstore/util/execution/sender_testutil.h"
+#include "tensorstore/util/result.h"
 #include "tensorstore/util/status.h"
 #include "tensorstore/util/status_testutil.h"
 
@@ -51,10 +58,45 @@ namespace {
 
 namespace kvstore = tensorstore::kvstore;
 using ::tensorstore::Context;
+using ::tensorstore::JsonSubValueMatches;
 using ::tensorstore::KvStore;
 using ::tensorstore::StatusIs;
+using ::tensorstore::Transaction;
+using ::tensorstore::internal::KeyValueStoreOpsTestParameters;
 using ::tensorstore::internal::MatchesKvsReadResult;
 using ::tensorstore::internal::MatchesKvsReadResultNotFound;
+using ::tensorstore::internal::MockKeyValueStore;
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  KeyValueStoreOpsTestParameters params;
+  params.test_name = "Zip";
+  params.get_store = [](auto callback) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto store,
+        kvstore::Open({{"driver", "zip"},
+                       {"base", {{"driver", "memory"}, {"path", "data.zip"}}}},
+                      Context::Default())
+            .result());
+    callback(store);
+  };
+  params.atomic_transaction = true;
+  // Names such as "../a" are not valid ZIP member names.
+  params.test_special_characters = false;
+  RegisterKeyValueStoreOpsTests(params);
+}
+
+// Returns the decompressed members of `zip_data`, as "name=value" strings.
+std::vector<std::string> GetMembers(absl::Cord zip_data) {
+  riegeli::CordReader reader(&zip_data);
+  tensorstore::internal_zip::EasyZipReader zip_reader(reader);
+  std::vector<std::string> members;
+  TENSORSTORE_CHECK_OK_AND_ASSIGN(auto entries, zip_reader.entries());
+  for (auto entry : entries) {
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(auto value, zip_reader.ReadEntry(entry));
+    members.push_back(absl::StrCat(entry.filename, "=", std::string(value)));
+  }
+  return members;
+}
 
 // "key" = "abcdefghijklmnop"
 absl::Cord GetReadOpZip() {
@@ -116,6 +158,16 @@ class ZipKeyValueStoreTest : public ::testing::Test {
         tensorstore::kvstore::Write(memory, "data.zip", value).result());
   }
 
+  absl::Cord ReadMemoryKvstore() {
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(
+        tensorstore::KvStore memory,
+        tensorstore::kvstore::Open({{"driver", "memory"}}, context_).result());
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(
+        auto read_result,
+        tensorstore::kvstore::Read(memory, "data.zip").result());
+    return read_result.value;
+  }
+
   tensorstore::Context context_;
 };
 
@@ -612,4 +664,147 @@ TEST_F(ZipKeyValueStoreTest, NestedZip) {
   EXPECT_EQ(read_result->value, "hello nested");
 }
 
+TEST_F(ZipKeyValueStoreTest, WriteCreatesArchive) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "zip"},
+                     {"base", {{"driver", "memory"}, {"path", "data.zip"}}}},
+                    context_)
+          .result());
+
+  auto transaction = Transaction(tensorstore::atomic_isolated);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto txn_store, store | transaction);
+  TENSORSTORE_ASSERT_OK(kvstore::Write(txn_store, "a", absl::Cord("1")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(txn_store, "b/c", absl::Cord("23")));
+  EXPECT_THAT(kvstore::Read(txn_store, "b/c").result(),
+              MatchesKvsReadResult(absl::Cord("23")));
+  TENSORSTORE_ASSERT_OK(transaction.CommitAsync().result());
+
+  EXPECT_THAT(GetMembers(ReadMemoryKvstore()),
+              ::testing::ElementsAre("a=1", "b/c=23"));
+  EXPECT_THAT(kvstore::Read(store, "b/c").result(),
+              MatchesKvsReadResult(absl::Cord("23")));
+}
+
+TEST_F(ZipKeyValueStoreTest, WritePreservesExistingMembers) {
+  absl::Cord zip_data;
+  {
+    riegeli::CordWriter writer(&zip_data);
+    tensorstore::internal_zip::EasyZipWriter zip_writer(writer);
+    TENSORSTORE_ASSERT_OK(zip_writer.WriteEntry(
+        "compressed", absl::Cord(std::string(1000, 'x')),
+        tensorstore::internal_zip::ZipCompression::kDeflate));
+    TENSORSTORE_ASSERT_OK(zip_writer.WriteEntry("key1", absl::Cord("value1")));
+    TENSORSTORE_ASSERT_OK(zip_writer.WriteEntry("key2", absl::Cord("value2")));
+    TENSORSTORE_ASSERT_OK(zip_writer.Finalize());
+    ASSERT_TRUE(writer.Close());
+  }
+  PrepareMemoryKvstore(zip_data);
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "zip"},
+                     {"base", {{"driver", "memory"}, {"path", "data.zip"}}}},
+                    context_)
+          .result());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "key0", absl::Cord("new")));
+  TENSORSTORE_ASSERT_OK(kvstore::Delete(store, "key2"));
+
+  // Existing members are retained in their existing order, followed by new
+  // members.
+  EXPECT_THAT(GetMembers(ReadMemoryKvstore()),
+              ::testing::ElementsAre(
+                  absl::StrCat("compressed=", std::string(1000, 'x')),
+                  "key1=value1", "key0=new"));
+
+  // The existing compressed member is copied without recompression.
+  absl::Cord new_zip_data = ReadMemoryKvstore();
+  riegeli::CordReader reader(&new_zip_data);
+  tensorstore::internal_zip::EasyZipReader zip_reader(reader);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto entries, zip_reader.entries());
+  ASSERT_EQ(3, entries.size());
+  EXPECT_EQ(tensorstore::internal_zip::ZipCompression::kDeflate,
+            entries[0].compression_method);
+}
+
+TEST_F(ZipKeyValueStoreTest, WriteReadsByteRanges) {
+  absl::Cord zip_data;
+  {
+    riegeli::CordWriter writer(&zip_data);
+    tensorstore::internal_zip::EasyZipWriter zip_writer(writer);
+    TENSORSTORE_ASSERT_OK(zip_writer.WriteEntry(
+        "large", absl::Cord(std::string(1024 * 1024, 'x'))));
+    TENSORSTORE_ASSERT_OK(zip_writer.WriteEntry("small", absl::Cord("value")));
+    TENSORSTORE_ASSERT_OK(zip_writer.Finalize());
+    ASSERT_TRUE(writer.Close());
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto memory,
+                                   kvstore::Open("memory://").result());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(memory, "data.zip", zip_data));
+
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto mock_key_value_store_resource,
+      context.GetResource<tensorstore::internal::MockKeyValueStoreResource>());
+  MockKeyValueStore* mock_key_value_store =
+      mock_key_value_store_resource->get();
+  mock_key_value_store->forward_to = memory.driver;
+  mock_key_value_store->log_requests = true;
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "zip"},
+                     {"base",
+                      {{"driver", "mock_key_value_store"},
+                       {"path", "data.zip"}}}},
+                    context)
+          .result());
+
+  // Every read of the existing archive is limited to a byte range: the
+  // directory, and the members that are read or retained.
+  const auto is_range_read = ::testing::AllOf(
+      JsonSubValueMatches("/type", "read"),
+      ::testing::AnyOf(
+          JsonSubValueMatches("/byte_range_inclusive_min", ::testing::_),
+          JsonSubValueMatches("/byte_range_exclusive_max", ::testing::_)));
+
+  {
+    auto transaction = Transaction(tensorstore::isolated);
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto txn_store, store | transaction);
+    EXPECT_THAT(kvstore::Read(txn_store, "small").result(),
+                MatchesKvsReadResult(absl::Cord("value")));
+    EXPECT_THAT(mock_key_value_store->request_log.pop_all(),
+                ::testing::AllOf(::testing::Not(::testing::IsEmpty()),
+                                 ::testing::Each(is_range_read)));
+  }
+
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "new", absl::Cord("1")));
+  EXPECT_THAT(
+      mock_key_value_store->request_log.pop_all(),
+      ::testing::Each(::testing::AnyOf(
+          is_range_read, JsonSubValueMatches("/type", "write"))));
+
+  absl::Cord new_zip_data =
+      kvstore::Read(memory, "data.zip").result().value().value;
+  EXPECT_THAT(GetMembers(new_zip_data),
+              ::testing::ElementsAre(
+                  absl::StrCat("large=", std::string(1024 * 1024, 'x')),
+                  "small=value", "new=1"));
+}
+
+TEST_F(ZipKeyValueStoreTest, WriteInvalidKey) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "zip"},
+                     {"base", {{"driver", "memory"}, {"path", "data.zip"}}}},
+                    context_)
+          .result());
+  EXPECT_THAT(kvstore::Write(store, "", absl::Cord("x")).result(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(kvstore::Write(store, "dir/", absl::Cord("x")).result(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(kvstore::Write(store, "a/../b", absl::Cord("x")).result(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 }  // namespace
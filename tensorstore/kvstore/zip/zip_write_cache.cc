@@ -0,0 +1,695 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/zip/zip_write_cache.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/optimization.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "riegeli/bytes/cord_reader.h"
+#include "riegeli/bytes/cord_writer.h"
+#include "riegeli/digests/crc32_digester.h"
+#include "tensorstore/batch.h"
+#include "tensorstore/internal/cache/async_cache.h"
+#include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/internal/compression/zip_details.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_modify_write.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/transaction.h"
+#include "tensorstore/kvstore/zip/cached_dir.h"
+#include "tensorstore/kvstore/zip/zip_dir_cache.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/execution/execution.h"
+#include "tensorstore/util/execution/sender.h"
+#include "tensorstore/util/execution/sender_util.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/quote_string.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+
+// IWYU: needed for `execution::submit` on a `Result`.
+#include "tensorstore/util/execution/result_sender.h"  // IWYU pragma: keep
+
+namespace tensorstore {
+namespace internal_zip_kvstore {
+namespace {
+
+using ::tensorstore::internal_zip::ZipEntry;
+
+struct CompareFilename {
+  bool operator()(const CachedDir::Entry& entry,
+                  std::string_view filename) const {
+    return entry.filename < filename;
+  }
+};
+
+const CachedDir::Entry* FindEntry(const CachedDir* dir,
+                                  std::string_view filename) {
+  if (!dir) return nullptr;
+  auto it = std::lower_bound(dir->entries.begin(), dir->entries.end(),
+                             filename, CompareFilename{});
+  if (it == dir->entries.end() || it->filename != filename) return nullptr;
+  return &*it;
+}
+
+void ListMembers(const CachedDir* dir, kvstore::ListOptions options,
+                 kvstore::ListReceiver receiver) {
+  std::atomic<bool> cancel{false};
+  execution::set_starting(
+      receiver, [&] { cancel.store(true, std::memory_order_relaxed); });
+  if (dir) {
+    auto it = std::lower_bound(dir->entries.begin(), dir->entries.end(),
+                               options.range.inclusive_min, CompareFilename{});
+    for (; it != dir->entries.end(); ++it) {
+      if (cancel.load(std::memory_order_relaxed)) break;
+      const auto& filename = it->filename;
+      if (KeyRange::CompareKeyAndExclusiveMax(
+              filename, options.range.exclusive_max) >= 0) {
+        break;
+      }
+      if (filename.size() < options.strip_prefix_length) continue;
+      execution::set_value(
+          receiver,
+          kvstore::ListEntry{
+              filename.substr(options.strip_prefix_length),
+              kvstore::ListEntry::checked_size(it->uncompressed_size)});
+    }
+  }
+  execution::set_done(receiver);
+  execution::set_stopping(receiver);
+}
+
+// Receiver for `ReadModifyWriteTarget::KvsRead` that resolves a promise.
+struct ReadPromiseReceiver {
+  Promise<kvstore::ReadResult> promise;
+  void set_value(kvstore::ReadResult read_result) {
+    promise.SetResult(std::move(read_result));
+  }
+  void set_error(absl::Status error) { promise.SetResult(std::move(error)); }
+  void set_cancel() { ABSL_UNREACHABLE(); }  // COV_NF_LINE
+};
+
+// Reads member `key` given the directory of the archive.
+void ReadMember(
+    ZipWriteCache::TransactionNode& node, std::string key,
+    kvstore::ReadModifyWriteTarget::ReadModifyWriteReadOptions options,
+    ZipDirectoryReadResult directory,
+    kvstore::ReadModifyWriteTarget::ReadReceiver receiver) {
+  TimestampedStorageGeneration stamp = directory.stamp;
+  if (StorageGeneration::IsDirty(stamp.generation)) {
+    // Add layer to generation in order to make it possible to distinguish:
+    //
+    // 1. the archive being modified by a predecessor `ReadModifyWrite`
+    //    operation on the underlying KeyValueStore.
+    //
+    // 2. the member being modified by a `ReadModifyWrite` operation attached
+    //    to this transaction node.
+    stamp.generation =
+        StorageGeneration::AddLayer(std::move(stamp.generation));
+  }
+  if (!StorageGeneration::IsUnknown(stamp.generation) &&
+      stamp.generation == options.generation_conditions.if_not_equal) {
+    execution::set_value(receiver,
+                         kvstore::ReadResult::Unspecified(std::move(stamp)));
+    return;
+  }
+  const auto* entry = FindEntry(directory.dir.get(), key);
+  if (!entry) {
+    execution::set_value(receiver,
+                         kvstore::ReadResult::Missing(std::move(stamp)));
+    return;
+  }
+
+  // Read just the local header and data of the member.  Data at least as
+  // recent as the directory is consistent with it, provided that the
+  // generation is unchanged.
+  kvstore::ReadOptions member_options;
+  member_options.staleness_bound = directory.stamp.time;
+  member_options.byte_range = OptionalByteRangeRequest::Range(
+      entry->local_header_offset,
+      entry->local_header_offset + entry->local_header_and_data_size);
+  member_options.batch = options.batch;
+  auto future = node.ReadArchive(std::move(member_options));
+  future.Force();
+  future.ExecuteWhenReady(WithExecutor(
+      GetOwningCache(node).executor(),
+      [&node, key = std::move(key), options = std::move(options),
+       entry = ZipEntry(*entry),
+       base_generation = std::move(directory.stamp.generation),
+       stamp = std::move(stamp), receiver = std::move(receiver)](
+          ReadyFuture<kvstore::ReadResult> future) mutable {
+        auto& r = future.result();
+        if (!r.ok()) {
+          execution::set_error(receiver, r.status());
+          return;
+        }
+        if (!r->has_value() || r->stamp.generation != base_generation) {
+          // The archive was modified after the directory was read.
+          options.staleness_bound = absl::Now();
+          node.Read(key, std::move(options), std::move(receiver));
+          return;
+        }
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto value, DecompressMember(entry, r->value),
+            static_cast<void>(execution::set_error(receiver, _)));
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto byte_range, options.byte_range.Validate(value.size()),
+            static_cast<void>(execution::set_error(receiver, _)));
+        execution::set_value(
+            receiver,
+            kvstore::ReadResult::Value(internal::GetSubCord(value, byte_range),
+                                       std::move(stamp)));
+      }));
+}
+
+// Byte range of the existing archive containing one or more contiguous
+// retained members.
+struct RetainedRange {
+  uint64_t inclusive_min;
+  uint64_t exclusive_max;
+  Future<kvstore::ReadResult> future;
+};
+
+}  // namespace
+
+Result<absl::Cord> EncodeZipArchive(
+    tensorstore::span<const ZipArchiveMember> members) {
+  absl::Cord encoded;
+  riegeli::CordWriter writer(&encoded);
+
+  std::vector<ZipEntry> entries;
+  entries.reserve(members.size());
+  for (const auto& member : members) {
+    auto& entry = entries.emplace_back(member.entry);
+    entry.local_header_offset = writer.pos();
+    if (!member.has_local_header) {
+      TENSORSTORE_RETURN_IF_ERROR(internal_zip::WriteLocalEntry(writer, entry));
+    }
+    // The member data is appended by reference where possible, so that large
+    // members are not copied.
+    if (!writer.Write(member.data)) return writer.status();
+  }
+
+  internal_zip::ZipEOCD eocd;
+  eocd.num_entries = entries.size();
+  eocd.cd_offset = writer.pos();
+  for (auto& entry : entries) {
+    TENSORSTORE_RETURN_IF_ERROR(
+        internal_zip::WriteCentralDirectoryEntry(writer, entry));
+  }
+  eocd.cd_size = writer.pos() - eocd.cd_offset;
+  TENSORSTORE_RETURN_IF_ERROR(internal_zip::WriteEOCD(writer, eocd));
+  if (!writer.Close()) return writer.status();
+  return encoded;
+}
+
+ZipArchiveMember MakeStoredMember(std::string filename, absl::Cord value,
+                                  absl::Time mtime) {
+  ZipArchiveMember member;
+  member.entry.filename = std::move(filename);
+  member.entry.compression_method = internal_zip::ZipCompression::kStore;
+  member.entry.mtime = mtime;
+  member.entry.uncompressed_size = value.size();
+  member.entry.compressed_size = value.size();
+  riegeli::Crc32Digester digester;
+  for (auto chunk : value.Chunks()) {
+    digester.Write(chunk);
+  }
+  member.entry.crc = digester.Digest();
+  member.data = std::move(value);
+  return member;
+}
+
+Result<absl::Cord> DecompressMember(const ZipEntry& entry,
+                                    const absl::Cord& local_header_and_data) {
+  riegeli::CordReader reader(&local_header_and_data);
+  // Only the position of the member data is needed from the local header; the
+  // sizes and CRC in the central directory are authoritative, since the local
+  // header may defer them to a data descriptor.
+  ZipEntry local_header{};
+  TENSORSTORE_RETURN_IF_ERROR(
+      internal_zip::ReadLocalEntry(reader, local_header));
+  ZipEntry member_entry = entry;
+  TENSORSTORE_ASSIGN_OR_RETURN(auto entry_reader,
+                               internal_zip::GetReader(&reader, member_entry));
+  absl::Cord value;
+  if (!entry_reader->Read(member_entry.uncompressed_size, value)) {
+    if (entry_reader->status().ok()) {
+      return absl::DataLossError("Failed to read all expected data");
+    }
+    return entry_reader->status();
+  }
+  return value;
+}
+
+absl::Status ValidateMemberKey(std::string_view key) {
+  if (key.empty()) {
+    return absl::InvalidArgumentError("ZIP member name must not be empty");
+  }
+  if (key.size() > std::numeric_limits<uint16_t>::max()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("ZIP member name is too long: ", key.size(), " bytes"));
+  }
+  // Reject any name that could not subsequently be read back.
+  ZipEntry entry;
+  entry.filename = std::string(key);
+  return internal_zip::ValidateEntryIsSupported(entry);
+}
+
+size_t ZipWriteCache::Entry::ComputeReadDataSizeInBytes(const void* read_data) {
+  const auto& update = *static_cast<const ZipArchiveUpdate*>(read_data);
+  size_t total = sizeof(ZipArchiveUpdate) +
+                 update.retained.capacity() * sizeof(CachedDir::Entry) +
+                 update.added.capacity() * sizeof(ZipArchiveMember);
+  for (const auto& entry : update.retained) {
+    total += entry.filename.size() + entry.comment.size();
+  }
+  for (const auto& member : update.added) {
+    total += member.entry.filename.size() + member.entry.comment.size() +
+             member.data.size();
+  }
+  return total;
+}
+
+void ZipWriteCache::Entry::DoDecode(std::optional<absl::Cord> value,
+                                    DecodeReceiver receiver) {
+  execution::set_error(
+      receiver,
+      absl::UnimplementedError("ZIP archives are not read in their entirety"));
+}
+
+void ZipWriteCache::Entry::DoEncode(
+    EncodeOptions options, std::shared_ptr<const ZipArchiveUpdate> data,
+    EncodeReceiver receiver) {
+  if (options.encode_mode == EncodeOptions::kValueDiscarded) {
+    // Only the existence of the archive matters, and it is never deleted.
+    execution::set_value(receiver, absl::Cord());
+    return;
+  }
+
+  // Read the retained members from the existing archive, coalescing members
+  // that are contiguous.
+  auto ranges = std::make_shared<std::vector<RetainedRange>>();
+  std::vector<AnyFuture> futures;
+  {
+    auto batch = Batch::New();
+    for (const auto& entry : data->retained) {
+      const uint64_t start = entry.local_header_offset;
+      const uint64_t end = start + entry.local_header_and_data_size;
+      if (!ranges->empty() && ranges->back().exclusive_max == start) {
+        ranges->back().exclusive_max = end;
+      } else {
+        ranges->push_back({start, end, {}});
+      }
+    }
+    for (auto& range : *ranges) {
+      kvstore::ReadOptions read_options;
+      read_options.staleness_bound = data->existing_stamp.time;
+      read_options.byte_range = OptionalByteRangeRequest::Range(
+          range.inclusive_min, range.exclusive_max);
+      read_options.batch = batch;
+      range.future = data->node->ReadArchive(std::move(read_options));
+      futures.push_back(range.future);
+    }
+  }
+
+  WaitAllFuture(futures).ExecuteWhenReady(WithExecutor(
+      GetOwningCache(*this).executor(),
+      [data = std::move(data), ranges = std::move(ranges),
+       receiver = std::move(receiver)](ReadyFuture<void> future) mutable {
+        std::vector<ZipArchiveMember> members;
+        members.reserve(data->retained.size() + data->added.size());
+        auto entry_it = data->retained.begin();
+        for (auto& range : *ranges) {
+          auto& r = range.future.result();
+          if (!r.ok()) {
+            execution::set_error(receiver, r.status());
+            return;
+          }
+          if (!r->has_value() ||
+              r->stamp.generation != data->existing_stamp.generation) {
+            // The archive was modified since the directory was read.  The
+            // write would be rejected regardless, since it is conditioned on
+            // the original generation.
+            execution::set_error(
+                receiver, absl::AbortedError("Generation mismatch"));
+            return;
+          }
+          if (r->value.size() != range.exclusive_max - range.inclusive_min) {
+            execution::set_error(
+                receiver,
+                absl::DataLossError("Failed to read ZIP archive members"));
+            return;
+          }
+          for (; entry_it != data->retained.end() &&
+                 entry_it->local_header_offset < range.exclusive_max;
+               ++entry_it) {
+            auto& member = members.emplace_back();
+            member.entry = *entry_it;
+            member.has_local_header = true;
+            const uint64_t offset =
+                entry_it->local_header_offset - range.inclusive_min;
+            member.data = internal::GetSubCord(
+                r->value,
+                ByteRange{static_cast<int64_t>(offset),
+                          static_cast<int64_t>(
+                              offset + entry_it->local_header_and_data_size)});
+          }
+        }
+        members.insert(members.end(), data->added.begin(), data->added.end());
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto encoded, EncodeZipArchive(members),
+            static_cast<void>(execution::set_error(receiver, _)));
+        execution::set_value(receiver, std::move(encoded));
+      }));
+}
+
+std::string ZipWriteCache::TransactionNode::DescribeKey(std::string_view key) {
+  auto& cache = GetOwningCache(*this);
+  return absl::StrCat(QuoteString(key), " in ",
+                      cache.kvstore_driver()->DescribeKey(
+                          GetOwningEntry(*this).GetKeyValueStoreKey()));
+}
+
+Future<kvstore::ReadResult> ZipWriteCache::TransactionNode::ReadArchive(
+    kvstore::ReadOptions options) {
+  kvstore::ReadModifyWriteTarget::ReadModifyWriteReadOptions read_options;
+  read_options.generation_conditions.if_not_equal =
+      std::move(options.generation_conditions.if_not_equal);
+  read_options.staleness_bound = options.staleness_bound;
+  read_options.byte_range = options.byte_range;
+  read_options.batch = std::move(options.batch);
+  auto [promise, future] = PromiseFuturePair<kvstore::ReadResult>::Make();
+  kvs_target().KvsRead(std::move(read_options),
+                       ReadPromiseReceiver{std::move(promise)});
+  return std::move(future);
+}
+
+Future<ZipDirectoryReadResult> ZipWriteCache::TransactionNode::ReadDirectory(
+    absl::Time staleness_bound) {
+  kvstore::ReadOptions options;
+  std::shared_ptr<const CachedDir> existing;
+  {
+    absl::MutexLock lock(mutex_);
+    if (!StorageGeneration::IsUnknown(directory_stamp_.generation) &&
+        directory_stamp_.time >= staleness_bound) {
+      return MakeReadyFuture<ZipDirectoryReadResult>(
+          ZipDirectoryReadResult{directory_, directory_stamp_});
+    }
+    existing = directory_;
+    options.generation_conditions.if_not_equal = directory_stamp_.generation;
+  }
+  options.staleness_bound = staleness_bound;
+  auto future = ReadZipDirectory(
+      [this](kvstore::ReadOptions options) {
+        return this->ReadArchive(std::move(options));
+      },
+      GetOwningCache(*this).executor(), std::move(options),
+      std::move(existing));
+  future.Force();
+  future.ExecuteWhenReady([this](ReadyFuture<ZipDirectoryReadResult> future) {
+    auto& r = future.result();
+    if (!r.ok()) return;
+    absl::MutexLock lock(mutex_);
+    if (StorageGeneration::IsUnknown(directory_stamp_.generation) ||
+        r->stamp.time >= directory_stamp_.time) {
+      directory_ = r->dir;
+      directory_stamp_ = r->stamp;
+    }
+  });
+  return future;
+}
+
+void ZipWriteCache::TransactionNode::Read(
+    std::string_view key,
+    kvstore::ReadModifyWriteTarget::ReadModifyWriteReadOptions&& options,
+    kvstore::ReadModifyWriteTarget::ReadReceiver&& receiver) {
+  ReadDirectory(options.staleness_bound)
+      .ExecuteWhenReady(
+          [this, key = std::string(key), options = std::move(options),
+           receiver = std::move(receiver)](
+              ReadyFuture<ZipDirectoryReadResult> future) mutable {
+            auto& r = future.result();
+            if (!r.ok()) {
+              execution::set_error(receiver, r.status());
+              return;
+            }
+            ReadMember(*this, std::move(key), std::move(options),
+                       std::move(*r), std::move(receiver));
+          });
+}
+
+void ZipWriteCache::TransactionNode::ListUnderlying(
+    kvstore::ListOptions options, kvstore::ListReceiver receiver) {
+  ReadDirectory(options.staleness_bound)
+      .ExecuteWhenReady(WithExecutor(
+          GetOwningCache(*this).executor(),
+          [self = internal::OpenTransactionNodePtr<TransactionNode>(this),
+           options = std::move(options), receiver = std::move(receiver)](
+              ReadyFuture<ZipDirectoryReadResult> future) mutable {
+            if (!future.result().ok()) {
+              execution::submit(FlowSingleSender{ErrorSender{future.status()}},
+                                std::move(receiver));
+              return;
+            }
+            ListMembers(future.value().dir.get(), std::move(options),
+                        std::move(receiver));
+          }));
+}
+
+void ZipWriteCache::TransactionNode::InvalidateReadState() {
+  Base::TransactionNode::InvalidateReadState();
+  {
+    absl::MutexLock lock(mutex_);
+    directory_ = nullptr;
+    directory_stamp_ = TimestampedStorageGeneration{};
+  }
+  internal_kvstore::InvalidateReadState(phases_);
+}
+
+void ZipWriteCache::TransactionNode::DoApply(ApplyOptions options,
+                                             ApplyReceiver receiver) {
+  apply_receiver_ = std::move(receiver);
+  apply_options_ = options;
+  apply_status_ = absl::OkStatus();
+
+  GetOwningCache(*this).executor()([this] { this->StartApply(); });
+}
+
+void ZipWriteCache::TransactionNode::StartApply() {
+  RetryAtomicWriteback(apply_options_.staleness_bound);
+}
+
+void ZipWriteCache::TransactionNode::AllEntriesDone(
+    internal_kvstore::SinglePhaseMutation& single_phase_mutation) {
+  if (!apply_status_.ok()) {
+    execution::set_error(std::exchange(apply_receiver_, {}),
+                         std::exchange(apply_status_, {}));
+    return;
+  }
+  auto& self = *this;
+  GetOwningCache(*this).executor()([&self] {
+    StorageGeneration generation;
+    bool mismatch = false;
+
+    // Determine if all entries are conditioned on the same generation.
+    for (auto& entry : self.phases_.entries_) {
+      if (entry.entry_type() != kReadModifyWrite) continue;
+      auto& buffered_entry =
+          static_cast<AtomicMultiPhaseMutation::BufferedReadModifyWriteEntry&>(
+              entry);
+      auto& entry_stamp = buffered_entry.stamp();
+      if (StorageGeneration::IsConditional(entry_stamp.generation)) {
+        auto base_generation =
+            StorageGeneration::StripLayer(entry_stamp.generation);
+        if (!StorageGeneration::IsUnknown(generation) &&
+            generation != base_generation) {
+          mismatch = true;
+          break;
+        } else {
+          generation = base_generation;
+        }
+      }
+    }
+
+    if (mismatch) {
+      // Retry with newer staleness bound to try to obtain consistent
+      // conditions.
+      self.apply_options_.staleness_bound = absl::Now();
+      GetOwningCache(self).executor()([&self] { self.StartApply(); });
+      return;
+    }
+    // Unlike a shard with a fixed set of entries, the set of members in an
+    // archive is open-ended, so the existing directory is always required.
+    // Only the directory is read; retained members are read by `DoEncode`.
+    self.ReadDirectory(self.apply_options_.staleness_bound)
+        .ExecuteWhenReady(
+            [&self](ReadyFuture<ZipDirectoryReadResult> future) {
+              if (!future.result().ok()) {
+                execution::set_error(std::exchange(self.apply_receiver_, {}),
+                                     future.result().status());
+                return;
+              }
+              GetOwningCache(self).executor()(
+                  [&self, existing = future.value()] {
+                    self.MergeForWriteback(existing);
+                  });
+            });
+  });
+}
+
+void ZipWriteCache::TransactionNode::MergeForWriteback(
+    const ZipDirectoryReadResult& existing) {
+  static const CachedDir kEmptyDir;
+  const auto& existing_entries =
+      existing.dir ? existing.dir->entries : kEmptyDir.entries;
+
+  auto update = std::make_shared<ZipArchiveUpdate>();
+  update->node = this;
+  update->existing_stamp = existing.stamp;
+
+  // Both the existing entries and the mutations are ordered by key, so the new
+  // member list is computed by a single merge pass.
+  auto it = existing_entries.begin();
+  const auto retain_existing_before = [&](std::string_view key) {
+    for (; it != existing_entries.end() && it->filename < key; ++it) {
+      update->retained.push_back(*it);
+    }
+  };
+
+  const absl::Time mtime = absl::Now();
+  update->retained.reserve(existing_entries.size());
+  // Indicates that inconsistent conditional mutations were observed.
+  bool mismatch = false;
+  // Indicates that the new archive is not identical to the existing archive.
+  bool changed = false;
+  for (auto& entry : phases_.entries_) {
+    if (entry.entry_type() != kReadModifyWrite) {
+      auto& dr_entry = static_cast<DeleteRangeEntry&>(entry);
+      retain_existing_before(dr_entry.key_);
+      for (; it != existing_entries.end() &&
+             KeyRange::CompareKeyAndExclusiveMax(it->filename,
+                                                 dr_entry.exclusive_max_) < 0;
+           ++it) {
+        changed = true;
+      }
+      continue;
+    }
+
+    auto& buffered_entry =
+        static_cast<internal_kvstore::AtomicMultiPhaseMutation::
+                        BufferedReadModifyWriteEntry&>(entry);
+    auto& entry_stamp = buffered_entry.stamp();
+    if (StorageGeneration::IsConditional(entry_stamp.generation) &&
+        StorageGeneration::StripLayer(entry_stamp.generation) !=
+            existing.stamp.generation) {
+      // This mutation is conditional, and is inconsistent with a prior
+      // conditional mutation or with the existing archive.
+      mismatch = true;
+      break;
+    }
+    retain_existing_before(buffered_entry.key_);
+    const bool exists =
+        it != existing_entries.end() && it->filename == buffered_entry.key_;
+    if (buffered_entry.value_state_ == kvstore::ReadResult::kUnspecified ||
+        !StorageGeneration::IsInnerLayerDirty(entry_stamp.generation)) {
+      // This is a no-op mutation; retain the existing member, if present.
+      continue;
+    }
+    if (exists) ++it;
+    if (buffered_entry.value_state_ == kvstore::ReadResult::kValue) {
+      update->added.push_back(
+          MakeStoredMember(buffered_entry.key_, buffered_entry.value_, mtime));
+      changed = true;
+    } else if (exists) {
+      changed = true;
+    }
+  }
+  if (mismatch) {
+    // The existing archive and the conditional mutations are not all based on
+    // a consistent archive generation.  Retry, requesting that all mutations
+    // be based on a new up-to-date archive generation.
+    apply_options_.staleness_bound = absl::Now();
+    GetOwningCache(*this).executor()([this] { this->StartApply(); });
+    return;
+  }
+  update->retained.insert(update->retained.end(), it, existing_entries.end());
+  // Retained members are copied in their existing order, which allows
+  // contiguous members to be read together.
+  std::sort(update->retained.begin(), update->retained.end(),
+            [](const auto& a, const auto& b) {
+              return a.local_header_offset < b.local_header_offset;
+            });
+
+  internal::AsyncCache::ReadState read_state;
+  read_state.stamp = existing.stamp;
+  if (changed) {
+    read_state.stamp.generation.MarkDirty(mutation_id_);
+  }
+  read_state.data = std::move(update);
+  execution::set_value(std::exchange(apply_receiver_, {}),
+                       std::move(read_state));
+}
+
+void ZipWriteCache::TransactionNode::WritebackSuccess(ReadState&& read_state) {
+  for (auto& entry : phases_.entries_) {
+    if (entry.entry_type() != kReadModifyWrite) {
+      internal_kvstore::WritebackSuccess(static_cast<DeleteRangeEntry&>(entry));
+    } else {
+      auto& derived_entry =
+          static_cast<internal_kvstore::AtomicMultiPhaseMutationBase::
+                          ReadModifyWriteEntryWithStamp&>(entry);
+      internal_kvstore::WritebackSuccess(derived_entry, read_state.stamp,
+                                         derived_entry.stamp_.generation);
+    }
+  }
+  internal_kvstore::DestroyPhaseEntries(phases_);
+  // The update refers to this node, and the new members it holds need not be
+  // retained: subsequent transactions read the directory again.
+  read_state.data = nullptr;
+  read_state.stamp.generation = StorageGeneration::Unknown();
+  Base::TransactionNode::WritebackSuccess(std::move(read_state));
+}
+
+void ZipWriteCache::TransactionNode::WritebackError() {
+  internal_kvstore::WritebackError(phases_);
+  internal_kvstore::DestroyPhaseEntries(phases_);
+  Base::TransactionNode::WritebackError();
+}
+
+}  // namespace internal_zip_kvstore
+}  // namespace tensorstore
@@ -0,0 +1,271 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_ZIP_ZIP_WRITE_CACHE_H_
+#define TENSORSTORE_KVSTORE_ZIP_ZIP_WRITE_CACHE_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/cache/async_cache.h"
+#include "tensorstore/internal/cache/kvs_backed_cache.h"
+#include "tensorstore/internal/compression/zip_details.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_modify_write.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/transaction.h"
+#include "tensorstore/kvstore/zip/cached_dir.h"
+#include "tensorstore/kvstore/zip/zip_dir_cache.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_zip_kvstore {
+
+/// Member of a ZIP archive that is being encoded.
+struct ZipArchiveMember {
+  /// Central directory entry of the member.  The local header offset is
+  /// recomputed when the archive is encoded.
+  internal_zip::ZipEntry entry;
+
+  /// If `true`, `data` holds the local header, compressed data and data
+  /// descriptor (if any) of a member of an existing archive, which are copied
+  /// as is.  Otherwise, `data` holds just the compressed data, and the local
+  /// header is written by `EncodeZipArchive`.
+  bool has_local_header = false;
+
+  absl::Cord data;
+};
+
+/// Encodes a ZIP archive.
+///
+/// Members are written sequentially in the specified order, followed by the
+/// central directory.  ZIP64 extra fields, and the ZIP64 end of central
+/// directory record and locator, are written when required by the member
+/// sizes, offsets, or number of members.
+Result<absl::Cord> EncodeZipArchive(
+    tensorstore::span<const ZipArchiveMember> members);
+
+/// Returns an uncompressed (`ZipCompression::kStore`) member.
+ZipArchiveMember MakeStoredMember(std::string filename, absl::Cord value,
+                                  absl::Time mtime);
+
+/// Returns the decompressed value of the member described by `entry`, given
+/// its local header and compressed data.
+Result<absl::Cord> DecompressMember(const internal_zip::ZipEntry& entry,
+                                    const absl::Cord& local_header_and_data);
+
+/// Returns an error if `key` may not be written as a ZIP archive member.
+absl::Status ValidateMemberKey(std::string_view key);
+
+struct ZipArchiveUpdate;
+
+/// Cache used to buffer writes to a ZIP archive.
+///
+/// Each cache entry corresponds to a ZIP archive in the base kvstore, and the
+/// entry key is the path of the archive.
+///
+/// This cache is used only for writing and transactional reads.
+/// Non-transactional reads use `ZipDirectoryCache`.  Like `ZipDirectoryCache`,
+/// only the directory of the existing archive is read (by byte range) and
+/// retained, along with the new and modified members.  Members are read by
+/// byte range when they are read within the transaction, and unmodified members
+/// are read by byte range when the archive is rewritten at commit.  The base
+/// kvstore is only able to write the complete archive, so the data of all
+/// members is required at that point, but it is not retained afterwards.
+class ZipWriteCache
+    : public internal::KvsBackedCache<ZipWriteCache, internal::AsyncCache> {
+  using Base = internal::KvsBackedCache<ZipWriteCache, internal::AsyncCache>;
+
+ public:
+  using ReadData = ZipArchiveUpdate;
+
+  explicit ZipWriteCache(kvstore::DriverPtr kvstore_driver, Executor executor)
+      : Base(std::move(kvstore_driver)), executor_(std::move(executor)) {}
+
+  class Entry : public Base::Entry {
+   public:
+    using OwningCache = ZipWriteCache;
+
+    size_t ComputeReadDataSizeInBytes(const void* read_data) final;
+
+    // Not supported, since the full archive is never read: the directory is
+    // instead read by `TransactionNode::ReadDirectory`.
+    void DoDecode(std::optional<absl::Cord> value,
+                  DecodeReceiver receiver) final;
+
+    // Reads the members of the existing archive that are retained by `data`,
+    // and encodes the new archive.
+    void DoEncode(EncodeOptions options,
+                  std::shared_ptr<const ZipArchiveUpdate> data,
+                  EncodeReceiver receiver) final;
+  };
+
+  class TransactionNode : public Base::TransactionNode,
+                          public internal_kvstore::AtomicMultiPhaseMutation {
+   public:
+    using OwningCache = ZipWriteCache;
+    using Base::TransactionNode::TransactionNode;
+
+    absl::Mutex& mutex() override { return this->mutex_; }
+
+    void PhaseCommitDone(size_t next_phase) override {}
+
+    internal::TransactionState::Node& GetTransactionNode() override {
+      return *this;
+    }
+
+    void Abort() override {
+      this->AbortRemainingPhases();
+      Base::TransactionNode::Abort();
+    }
+
+    std::string DescribeKey(std::string_view key) override;
+
+    // Computes the new archive contents, taking into account all mutations
+    // requested by this transaction.
+    void DoApply(ApplyOptions options, ApplyReceiver receiver) override;
+
+    // Starts or retries applying.
+    void StartApply();
+
+    // Called by `AtomicMultiPhaseMutation` once all individual
+    // read-modify-write mutations have computed their conditional update.
+    //
+    // Checks that all conditional mutations depend on the same archive
+    // generation, retrying with a newer staleness bound otherwise, and then
+    // reads the existing directory and calls `MergeForWriteback`.
+    void AllEntriesDone(
+        internal_kvstore::SinglePhaseMutation& single_phase_mutation) override;
+
+    // Merges the mutations into the existing directory, completing the
+    // `DoApply` operation.
+    void MergeForWriteback(const ZipDirectoryReadResult& existing);
+
+    void RecordEntryWritebackError(
+        internal_kvstore::ReadModifyWriteEntry& entry,
+        absl::Status error) override {
+      absl::MutexLock lock(mutex_);
+      if (apply_status_.ok()) {
+        apply_status_ = std::move(error);
+      }
+    }
+
+    void Revoke() override {
+      Base::TransactionNode::Revoke();
+      {
+        lock();
+        unlock();
+      }
+      // At this point, no new entries may be added and we can safely traverse
+      // the list of entries without a lock.
+      this->RevokeAllEntries();
+    }
+
+    void WritebackSuccess(ReadState&& read_state) override;
+    void WritebackError() override;
+
+    void InvalidateReadState() override;
+
+    bool MultiPhaseReadsCommitted() override { return this->reads_committed_; }
+
+    /// Handles transactional reads of a single member.
+    ///
+    /// Reads the directory, and then the local header and data of the member,
+    /// by byte range.
+    void Read(
+        std::string_view key,
+        kvstore::ReadModifyWriteTarget::ReadModifyWriteReadOptions&& options,
+        kvstore::ReadModifyWriteTarget::ReadReceiver&& receiver) override;
+
+    void ListUnderlying(kvstore::ListOptions options,
+                        kvstore::ListReceiver receiver) override;
+
+    // Reads the directory of the existing archive, reflecting any prior
+    // modifications within the transaction.  The most recently read directory
+    // is retained and revalidated.
+    Future<ZipDirectoryReadResult> ReadDirectory(absl::Time staleness_bound);
+
+    // Reads a byte range of the existing archive, reflecting any prior
+    // modifications within the transaction.  The `if_equal` condition is not
+    // supported.
+    Future<kvstore::ReadResult> ReadArchive(kvstore::ReadOptions options);
+
+   private:
+    // Most recently read directory.
+    std::shared_ptr<const CachedDir> directory_ ABSL_GUARDED_BY(mutex_);
+    TimestampedStorageGeneration directory_stamp_ ABSL_GUARDED_BY(mutex_);
+
+    // The receiver argument for the current pending call to `DoApply`.
+    ApplyReceiver apply_receiver_;
+
+    // Options for the current pending call to `DoApply`.
+    ApplyOptions apply_options_;
+
+    // Error status for the current pending call to `DoApply`.
+    absl::Status apply_status_;
+  };
+
+  Entry* DoAllocateEntry() final { return new Entry; }
+  size_t DoGetSizeofEntry() final { return sizeof(Entry); }
+  TransactionNode* DoAllocateTransactionNode(AsyncCache::Entry& entry) final {
+    return new TransactionNode(static_cast<Entry&>(entry));
+  }
+
+  const Executor& executor() { return executor_; }
+
+  Executor executor_;
+};
+
+/// New contents of an archive, computed by `ZipWriteCache::TransactionNode`.
+///
+/// Only new and modified members hold their data; members retained from the
+/// existing archive are described by their directory entries, and are read by
+/// byte range when the new archive is encoded.
+struct ZipArchiveUpdate {
+  /// Node that computed the update, used to read the retained members.  Only
+  /// valid while writeback is in progress.
+  ZipWriteCache::TransactionNode* node = nullptr;
+
+  /// Generation of the existing archive.
+  TimestampedStorageGeneration existing_stamp;
+
+  /// Members retained from the existing archive, ordered by offset.
+  std::vector<CachedDir::Entry> retained;
+
+  /// New and modified members.
+  std::vector<ZipArchiveMember> added;
+};
+
+}  // namespace internal_zip_kvstore
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_ZIP_ZIP_WRITE_CACHE_H_
@@ -0,0 +1,188 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/zip/zip_write_cache.h"
+
+#include <stddef.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "riegeli/bytes/cord_reader.h"
+#include "riegeli/bytes/cord_writer.h"
+#include "tensorstore/internal/compression/zip_details.h"
+#include "tensorstore/internal/compression/zip_easy.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/zip/cached_dir.h"
+#include "tensorstore/kvstore/zip/zip_dir_cache.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::ByteRange;
+using ::tensorstore::InlineExecutor;
+using ::tensorstore::MakeReadyFuture;
+using ::tensorstore::Result;
+using ::tensorstore::StatusIs;
+using ::tensorstore::StorageGeneration;
+using ::tensorstore::internal::GetSubCord;
+using ::tensorstore::internal_zip::EasyZipReader;
+using ::tensorstore::internal_zip::EasyZipWriter;
+using ::tensorstore::internal_zip::ZipCompression;
+using ::tensorstore::internal_zip_kvstore::CachedDir;
+using ::tensorstore::internal_zip_kvstore::DecompressMember;
+using ::tensorstore::internal_zip_kvstore::EncodeZipArchive;
+using ::tensorstore::internal_zip_kvstore::MakeStoredMember;
+using ::tensorstore::internal_zip_kvstore::ReadZipDirectory;
+using ::tensorstore::internal_zip_kvstore::ValidateMemberKey;
+using ::tensorstore::internal_zip_kvstore::ZipArchiveMember;
+
+// Reads the directory of an in-memory archive.
+Result<CachedDir> ReadDirectory(const absl::Cord& archive) {
+  auto future = ReadZipDirectory(
+      [archive](tensorstore::kvstore::ReadOptions options) {
+        return MakeReadyFuture<tensorstore::kvstore::ReadResult>(
+            [&]() -> Result<tensorstore::kvstore::ReadResult> {
+              TENSORSTORE_ASSIGN_OR_RETURN(
+                  auto byte_range, options.byte_range.Validate(archive.size()));
+              return tensorstore::kvstore::ReadResult::Value(
+                  GetSubCord(archive, byte_range),
+                  {StorageGeneration::FromString("g"), absl::Now()});
+            }());
+      },
+      InlineExecutor{}, {}, nullptr);
+  TENSORSTORE_ASSIGN_OR_RETURN(auto result, future.result());
+  if (!result.dir) return absl::NotFoundError("");
+  return *result.dir;
+}
+
+// Returns the local header and data of `entry`.
+absl::Cord GetLocalHeaderAndData(const absl::Cord& archive,
+                                 const CachedDir::Entry& entry) {
+  return GetSubCord(
+      archive,
+      ByteRange{static_cast<int64_t>(entry.local_header_offset),
+                static_cast<int64_t>(entry.local_header_offset +
+                                     entry.local_header_and_data_size)});
+}
+
+TEST(ZipWriteCacheTest, EncodeDecodeRoundtrip) {
+  const absl::Time mtime = absl::FromUnixSeconds(1700000000);
+  std::vector<ZipArchiveMember> members;
+  members.push_back(MakeStoredMember("b/c", absl::Cord(""), mtime));
+  members.push_back(MakeStoredMember("a", absl::Cord("alpha"), mtime));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded, EncodeZipArchive(members));
+
+  // The encoded archive is readable by the generic ZIP reader.
+  riegeli::CordReader reader(&encoded);
+  EasyZipReader zip_reader(reader);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto value, zip_reader.ReadEntry("a"));
+  EXPECT_EQ("alpha", value);
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto dir, ReadDirectory(encoded));
+  ASSERT_EQ(2, dir.entries.size());
+  EXPECT_EQ("a", dir.entries[0].filename);
+  EXPECT_EQ("b/c", dir.entries[1].filename);
+  EXPECT_EQ(members[1].entry.crc, dir.entries[0].crc);
+  EXPECT_THAT(
+      DecompressMember(dir.entries[0],
+                       GetLocalHeaderAndData(encoded, dir.entries[0])),
+      ::tensorstore::IsOkAndHolds(absl::Cord("alpha")));
+}
+
+TEST(ZipWriteCacheTest, RetainedMembersCopiedVerbatim) {
+  absl::Cord zip_data;
+  {
+    riegeli::CordWriter writer(&zip_data);
+    EasyZipWriter zip_writer(writer);
+    TENSORSTORE_ASSERT_OK(zip_writer.WriteEntry(
+        "z", absl::Cord(std::string(4096, 'z')), ZipCompression::kDeflate));
+    TENSORSTORE_ASSERT_OK(zip_writer.Finalize());
+    ASSERT_TRUE(writer.Close());
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto dir, ReadDirectory(zip_data));
+  ASSERT_EQ(1, dir.entries.size());
+  const auto& entry = dir.entries[0];
+  EXPECT_EQ(ZipCompression::kDeflate, entry.compression_method);
+  EXPECT_LT(entry.compressed_size, 4096);
+
+  // Re-encoding copies the local header and compressed data as is, followed
+  // by a new member.
+  std::vector<ZipArchiveMember> members(1);
+  members[0].entry = entry;
+  members[0].has_local_header = true;
+  members[0].data = GetLocalHeaderAndData(zip_data, entry);
+  members.push_back(
+      MakeStoredMember("a", absl::Cord("alpha"), absl::UnixEpoch()));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded, EncodeZipArchive(members));
+  riegeli::CordReader reader(&encoded);
+  EasyZipReader zip_reader(reader);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto value, zip_reader.ReadEntry("z"));
+  EXPECT_EQ(std::string(4096, 'z'), value);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(value, zip_reader.ReadEntry("a"));
+  EXPECT_EQ("alpha", value);
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto new_dir, ReadDirectory(encoded));
+  ASSERT_EQ(2, new_dir.entries.size());
+  EXPECT_EQ(0, new_dir.entries[1].local_header_offset);
+  EXPECT_EQ(entry.compressed_size, new_dir.entries[1].compressed_size);
+}
+
+TEST(ZipWriteCacheTest, Zip64EndOfCentralDirectory) {
+  // More than 65534 members requires the ZIP64 end of central directory.
+  constexpr size_t kNumMembers = 70000;
+  std::vector<ZipArchiveMember> members;
+  members.reserve(kNumMembers);
+  for (size_t i = 0; i < kNumMembers; ++i) {
+    members.push_back(MakeStoredMember(absl::StrFormat("%06d", i),
+                                       absl::Cord("x"), absl::UnixEpoch()));
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded, EncodeZipArchive(members));
+
+  // ZIP64 end of central directory record signature.
+  EXPECT_NE(std::string::npos,
+            std::string(encoded).find(std::string_view("PK\x06\x06", 4)));
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto dir, ReadDirectory(encoded));
+  ASSERT_EQ(kNumMembers, dir.entries.size());
+  EXPECT_EQ("069999", dir.entries.back().filename);
+}
+
+TEST(ZipWriteCacheTest, ValidateMemberKey) {
+  TENSORSTORE_EXPECT_OK(ValidateMemberKey("a/b.txt"));
+  EXPECT_THAT(ValidateMemberKey(""),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(ValidateMemberKey("/a"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(ValidateMemberKey("a/"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(ValidateMemberKey("../a"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
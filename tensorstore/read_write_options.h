@@ -116,6 +116,28 @@ constexpr inline bool ReadIntoNewArrayOptions::IsOption<Batch> = true;
 template <>
 constexpr inline bool ReadIntoNewArrayOptions::IsOption<Batch::View> = true;
 
+/// Options for `tensorstore::Prefetch`.
+///
+/// \relates Prefetch
+struct PrefetchOptions {
+  template <typename T>
+  constexpr static inline bool IsOption = false;
+
+  absl::Status Set(Batch value) {
+    this->batch = std::move(value);
+    return absl::OkStatus();
+  }
+
+  /// Optional batch.
+  Batch batch{no_batch};
+};
+
+template <>
+constexpr inline bool PrefetchOptions::IsOption<Batch> = true;
+
+template <>
+constexpr inline bool PrefetchOptions::IsOption<Batch::View> = true;
+
 /// Specifies restrictions on how references to the source array/source
 /// TensorStore may be used by write operations.
 ///
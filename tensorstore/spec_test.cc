@@ -341,6 +341,8 @@ TEST(SpecTest, SetContextAndKvstoreIncludeDefaults) {
                {"context", ::nlohmann::json::object_t()},
                {"driver", "file"},
                {"path", "/tmp/"},
+               {"file_io_batch_read_coalescing",
+                {"file_io_batch_read_coalescing"}},
                {"file_io_concurrency", {"file_io_concurrency#a"}},
                {"file_io_sync", {"file_io_sync"}},
                {"file_io_locking", {"file_io_locking"}},
@@ -356,6 +358,10 @@ TEST(SpecTest, SetContextAndKvstoreIncludeDefaults) {
            {
                {"data_copy_concurrency", {{"limit", "shared"}}},
                {"cache_pool", {{"total_bytes_limit", 0}}},
+               {"file_io_batch_read_coalescing",
+                {{"max_extra_read_bytes", 4095},
+                 {"target_coalesced_size", 4 * 1024 * 1024},
+                 {"max_concurrent_reads", 64}}},
                {"file_io_concurrency#a", {{"limit", 5}}},
                {"file_io_locking", ::nlohmann::json::object_t()},
                {"file_io_sync", true},
@@ -391,6 +397,8 @@ TEST(SpecTest, SetContextAndKvstore) {
            {
                {"driver", "file"},
                {"path", "/tmp/"},
+               {"file_io_batch_read_coalescing",
+                {"file_io_batch_read_coalescing"}},
                {"file_io_concurrency", {"file_io_concurrency#a"}},
                {"file_io_sync", {"file_io_sync"}},
                {"file_io_locking", {"file_io_locking"}},
@@ -407,6 +415,7 @@ TEST(SpecTest, SetContextAndKvstore) {
            {
                {"data_copy_concurrency", ::nlohmann::json::object_t()},
                {"cache_pool", ::nlohmann::json::object_t()},
+               {"file_io_batch_read_coalescing", ::nlohmann::json::object_t()},
                {"file_io_concurrency#a", {{"limit", 5}}},
                {"file_io_locking", ::nlohmann::json::object_t()},
                {"file_io_sync", true},
@@ -791,6 +791,64 @@ Read(SourceTensorstore&& source, Option&&... option) {
                                        std::move(options));
 }
 
+/// Loads the data of a `source` TensorStore into the cache, without copying it
+/// to an array.
+///
+/// This may be used to warm the cache ahead of subsequent `Read` operations.
+/// The data is retained only to the extent permitted by the
+/// `Context.cache_pool` of the `source` TensorStore; with the default
+/// ``total_bytes_limit`` of ``0``, prefetching has no lasting effect.
+///
+/// Options compatible with `PrefetchOptions` are specified in any order after
+/// `source`.  The meaning of each option is determined by its type.
+///
+/// Supported option types are:
+///
+/// - `Batch`
+///
+/// Example::
+///
+///     TensorReader<int32_t, 3> store = ...;
+///     Prefetch(store | Dims(0).SizedInterval(100, 25)).value();
+///
+/// \param source Source TensorStore object that supports reading.  May be
+///     `Result`-wrapped.
+/// \param options Any option compatible with `PrefetchOptions`.
+/// \returns A future that becomes ready when the data has been loaded or an
+///     error occurs.
+/// \error `absl::StatusCode::kInvalidArgument` if the resolved domain of
+///     `source` is not finite.
+/// \relates TensorStore
+/// \membergroup I/O
+template <typename SourceTensorstore>
+std::enable_if_t<
+    internal::IsTensorStoreThatSupportsMode<UnwrapResultType<SourceTensorstore>,
+                                            ReadWriteMode::read>,
+    Future<void>>
+Prefetch(SourceTensorstore&& source, PrefetchOptions options) {
+  return MapResult(
+      [&](UnwrapQualifiedResultType<SourceTensorstore&&> unwrapped_source) {
+        return internal::DriverPrefetch(
+            internal::TensorStoreAccess::handle(
+                std::forward<decltype(unwrapped_source)>(unwrapped_source)),
+            std::move(options));
+      },
+      std::forward<SourceTensorstore>(source));
+}
+template <typename SourceTensorstore, typename... Option>
+std::enable_if_t<
+    (IsCompatibleOptionSequence<PrefetchOptions, Option...> &&
+     internal::IsTensorStoreThatSupportsMode<
+         UnwrapResultType<SourceTensorstore>, ReadWriteMode::read>),
+    Future<void>>
+Prefetch(SourceTensorstore&& source, Option&&... option) {
+  PrefetchOptions options;
+  TENSORSTORE_RETURN_IF_ERROR(
+      internal::SetAll(options, std::forward<Option>(option)...));
+  return tensorstore::Prefetch(std::forward<SourceTensorstore>(source),
+                               std::move(options));
+}
+
 /// Evaluates whether the constraints required for `tensorstore::Write` are
 /// satisfied.
 ///
@@ -19,10 +19,14 @@
 #include <string_view>
 
 #include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/time/time.h"
 #include "tensorstore/context.h"
 #include "tensorstore/kvstore/spec.h"
+#include "tensorstore/spec.h"
 #include "tensorstore/tscli/command.h"
 #include "tensorstore/tscli/lib/kvstore_copy.h"
+#include "tensorstore/tscli/lib/ts_copy.h"
 #include "tensorstore/util/json_absl_flag.h"
 
 /*
@@ -37,20 +41,42 @@ echo "World" > /tmp/source/b
 bazel run //tensorstore/tscli -- copy --source file:///tmp/source/
 --target file:///tmp/dest/ bazel run //tensorstore/tscli -- ls
 file:///tmp/dest/
+
+bazel run //tensorstore/tscli -- copy
+--source-spec '{"driver": "zarr3", "kvstore": "file:///tmp/a/"}'
+--target-spec '{"driver": "zarr3", "kvstore": "file:///tmp/b/"}'
+--checkpoint /tmp/copy.checkpoint --skip-not-stored
 */
 
 namespace tensorstore {
 namespace cli {
 namespace {
 
-static constexpr const char kCommand[] = R"(Copy a kvstore to another kvstore
-
-All values are copied from the --source to the --target kvstore.
+static constexpr const char kCommand[] = R"(Copy a kvstore or TensorStore
+
+With --source and --target, all values are copied from the source kvstore to
+the target kvstore.
+
+With --source-spec and --target-spec, the contents of the source TensorStore
+are copied to the target TensorStore.  The target domain is partitioned by the
+target write chunk grid, and each chunk is committed in its own transaction.
+At most --max-in-flight chunks are held in memory at once.  If --checkpoint is
+specified, the indices of completed chunks are recorded in that file, and a
+copy that is restarted with the same file skips them.  With --skip-not-stored,
+chunks for which the source has no stored data are skipped without being read,
+which is much faster for sparse sources.  Any data already stored in the target
+for the skipped chunks is left unchanged, so this should only be used with a
+new target.
 )";
 
-static constexpr const char kSource[] = R"(Source kvstore spec. Required.)";
+static constexpr const char kSource[] = R"(Source kvstore spec.)";
+
+static constexpr const char kTarget[] = R"(Target kvstore spec.)";
+
+static constexpr const char kSourceSpec[] = R"(Source TensorStore spec.)";
 
-static constexpr const char kTarget[] = R"(Target kvstore spec. Required.)";
+static constexpr const char kTargetSpec[] =
+    R"(Target TensorStore spec. May specify `"create": true`.)";
 
 }  // namespace
 
@@ -73,9 +99,74 @@ CopyCommand::CopyCommand() : Command("copy", kCommand) {
     target_ = spec.value;
     return absl::OkStatus();
   });
+  parser().AddLongOption(
+      "--source-spec", kSourceSpec, [this](std::string_view value) {
+        tensorstore::JsonAbslFlag<tensorstore::Spec> spec;
+        std::string error;
+        if (!AbslParseFlag(value, &spec, &error)) {
+          return absl::InvalidArgumentError(error);
+        }
+        source_spec_ = spec.value;
+        return absl::OkStatus();
+      });
+  parser().AddLongOption(
+      "--target-spec", kTargetSpec, [this](std::string_view value) {
+        tensorstore::JsonAbslFlag<tensorstore::Spec> spec;
+        std::string error;
+        if (!AbslParseFlag(value, &spec, &error)) {
+          return absl::InvalidArgumentError(error);
+        }
+        target_spec_ = spec.value;
+        return absl::OkStatus();
+      });
+  parser().AddLongOption(
+      "--max-in-flight",
+      "Maximum number of chunks copied concurrently. Defaults to 64.",
+      [this](std::string_view value) {
+        if (!absl::SimpleAtoi(value, &ts_copy_options_.max_in_flight) ||
+            ts_copy_options_.max_in_flight == 0) {
+          return absl::InvalidArgumentError("Invalid max-in-flight value");
+        }
+        return absl::OkStatus();
+      });
+  parser().AddLongOption(
+      "--checkpoint", "File recording the completed chunks.",
+      [this](std::string_view value) {
+        ts_copy_options_.checkpoint_path = std::string(value);
+        return absl::OkStatus();
+      });
+  parser().AddBoolOption(
+      "--skip-not-stored",
+      "Skip chunks with no data stored in the source; existing target data "
+      "in those chunks is left unchanged, so the target must be new.",
+      [this]() { ts_copy_options_.skip_not_stored = true; });
+  parser().AddLongOption(
+      "--progress-interval",
+      "Minimum interval between progress reports (e.g., `30s`).",
+      [this](std::string_view value) {
+        if (!absl::ParseDuration(value, &ts_copy_options_.progress_interval)) {
+          return absl::InvalidArgumentError("Invalid progress-interval value");
+        }
+        return absl::OkStatus();
+      });
 }
 
 absl::Status CopyCommand::Run(Context::Spec context_spec) {
+  if (source_spec_ || target_spec_) {
+    if (!source_spec_ || !target_spec_) {
+      return absl::InvalidArgumentError(
+          "Must specify both --source-spec and --target-spec");
+    }
+    if (source_.valid() || target_.valid()) {
+      return absl::InvalidArgumentError(
+          "Cannot combine --source-spec/--target-spec with --source/--target");
+    }
+    tensorstore::Context context(context_spec);
+    return TsCopy(context, *source_spec_, *target_spec_, ts_copy_options_,
+                  std::cout)
+        .status();
+  }
+
   if (!source_.valid()) {
     return absl::InvalidArgumentError("Must specify --source");
   }
@@ -15,10 +15,14 @@
 #ifndef TENSORSTORE_TSCLI_COPY_COMMAND_H_
 #define TENSORSTORE_TSCLI_COPY_COMMAND_H_
 
+#include <optional>
+
 #include "absl/status/status.h"
 #include "tensorstore/context.h"
 #include "tensorstore/kvstore/spec.h"
+#include "tensorstore/spec.h"
 #include "tensorstore/tscli/command.h"
+#include "tensorstore/tscli/lib/ts_copy.h"
 
 namespace tensorstore {
 namespace cli {
@@ -30,6 +34,11 @@ class CopyCommand : public Command {
 
   tensorstore::kvstore::Spec source_;
   tensorstore::kvstore::Spec target_;
+
+  // TensorStore copy.
+  std::optional<tensorstore::Spec> source_spec_;
+  std::optional<tensorstore::Spec> target_spec_;
+  TsCopyOptions ts_copy_options_;
 };
 
 }  // namespace cli
@@ -0,0 +1,779 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/lib/ocdbt_compact.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/context.h"
+#include "tensorstore/internal/cache/cache_pool_resource.h"
+#include "tensorstore/internal/data_copy_concurrency_resource.h"
+#include "tensorstore/internal/path.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/config.h"
+#include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/btree_node_encoder.h"
+#include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/manifest.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io/io_handle_impl.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/write_nodes.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/tscli/lib/ocdbt_check_reporter.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+
+namespace tensorstore {
+namespace cli {
+namespace {
+
+using ::tensorstore::internal_ocdbt::AddNewInteriorEntry;
+using ::tensorstore::internal_ocdbt::BtreeGenerationReference;
+using ::tensorstore::internal_ocdbt::BtreeInteriorNodeEncoder;
+using ::tensorstore::internal_ocdbt::BtreeLeafNodeEncoder;
+using ::tensorstore::internal_ocdbt::BtreeNode;
+using ::tensorstore::internal_ocdbt::BtreeNodeHeight;
+using ::tensorstore::internal_ocdbt::CommitTime;
+using ::tensorstore::internal_ocdbt::Config;
+using ::tensorstore::internal_ocdbt::ConfigState;
+using ::tensorstore::internal_ocdbt::DataFilePrefixes;
+using ::tensorstore::internal_ocdbt::FlushPromise;
+using ::tensorstore::internal_ocdbt::ForEachManifestVersionTreeNodeRef;
+using ::tensorstore::internal_ocdbt::GenerationNumber;
+using ::tensorstore::internal_ocdbt::GetVersionTreeLeafNodeRangeContainingGeneration;
+using ::tensorstore::internal_ocdbt::IndirectDataKind;
+using ::tensorstore::internal_ocdbt::IndirectDataReference;
+using ::tensorstore::internal_ocdbt::InteriorNodeEntry;
+using ::tensorstore::internal_ocdbt::InteriorNodeEntryData;
+using ::tensorstore::internal_ocdbt::IoHandle;
+using ::tensorstore::internal_ocdbt::LeafNodeEntry;
+using ::tensorstore::internal_ocdbt::LeafNodeValueReference;
+using ::tensorstore::internal_ocdbt::Manifest;
+using ::tensorstore::internal_ocdbt::ValidateBtreeNodeReference;
+using ::tensorstore::internal_ocdbt::ValidateVersionTreeNodeReference;
+using ::tensorstore::internal_ocdbt::VersionNodeReference;
+using ::tensorstore::internal_ocdbt::VersionTreeHeight;
+using ::tensorstore::internal_ocdbt::VersionTreeNode;
+
+using BtreeNodeFuture = Future<const std::shared_ptr<const BtreeNode>>;
+
+/// Replacement for a b+tree subtree that was rewritten.
+///
+/// The entries are relative to the root of the tree, and replace the single
+/// parent entry that referenced the original subtree.
+struct RewrittenSubtree {
+  std::vector<InteriorNodeEntryData<std::string>> entries;
+};
+
+/// `nullptr` indicates that the subtree is unchanged.
+using RewrittenSubtreePtr = std::shared_ptr<const RewrittenSubtree>;
+
+struct DataFileUsage {
+  /// Bytes referenced by the retained versions.
+  uint64_t live_bytes = 0;
+};
+
+class OcdbtCompactor {
+ public:
+  OcdbtCompactor(IoHandle::Ptr io_handle, kvstore::KvStore base_kvstore,
+                 const OcdbtCompactOptions& options, std::ostream& output)
+      : io_handle_(std::move(io_handle)),
+        base_kvstore_(std::move(base_kvstore)),
+        options_(options),
+        reporter_(output, /*detailed=*/false) {}
+
+  Result<OcdbtCompactResult> Run() {
+    TENSORSTORE_ASSIGN_OR_RETURN(auto manifest_with_time,
+                                 io_handle_->GetManifest(absl::Now()).result());
+    manifest_ = manifest_with_time.manifest;
+    if (!manifest_) {
+      return absl::NotFoundError("No OCDBT manifest found");
+    }
+    config_ = manifest_->config;
+    TENSORSTORE_RETURN_IF_ERROR(
+        io_handle_->config_state->ValidateNewConfig(config_));
+
+    // Collect all versions, in order of increasing generation number.
+    std::vector<BtreeGenerationReference> versions;
+    for (const auto& ref : manifest_->version_tree_nodes) {
+      TENSORSTORE_RETURN_IF_ERROR(CollectVersions(ref, versions));
+    }
+    versions.insert(versions.end(), manifest_->versions.begin(),
+                    manifest_->versions.end());
+
+    const size_t num_retained = GetNumRetainedVersions(versions);
+    std::vector<BtreeGenerationReference> retained(
+        versions.end() - num_retained, versions.end());
+    result_.num_versions_retained = num_retained;
+    result_.num_versions_pruned = versions.size() - num_retained;
+    reporter_.ReportInfo("Retaining %d of %d versions (generations %d to %d)",
+                         num_retained, versions.size(),
+                         retained.front().generation_number,
+                         retained.back().generation_number);
+
+    // Determine the bytes of each data file referenced by the retained
+    // versions.  Files referenced only by pruned versions are recorded with
+    // no live bytes.
+    TENSORSTORE_RETURN_IF_ERROR(VisitBtrees(retained, /*live=*/true));
+    TENSORSTORE_RETURN_IF_ERROR(VisitBtrees(
+        tensorstore::span(versions.data(), versions.size() - num_retained),
+        /*live=*/false));
+    TENSORSTORE_RETURN_IF_ERROR(DetermineSparseFiles());
+
+    if (result_.num_versions_pruned == 0 && sparse_files_.empty()) {
+      // The existing version tree remains referenced.
+      result_.obsolete_files.clear();
+      result_.bytes_reclaimed = 0;
+      reporter_.ReportInfo("Nothing to compact");
+      return std::move(result_);
+    }
+    if (options_.dry_run) {
+      reporter_.ReportInfo(
+          "Dry run: would rewrite %d data files and reclaim %d bytes",
+          sparse_files_.size(), result_.bytes_reclaimed);
+      return std::move(result_);
+    }
+
+    // Rewrite the retained versions, newest first, so that nodes shared with
+    // older versions are rewritten while they are most likely cached.
+    for (size_t i = retained.size(); i--;) {
+      TENSORSTORE_RETURN_IF_ERROR(RewriteVersion(retained[i]),
+                                  CleanupWrittenFiles(_));
+    }
+    result_.num_files_rewritten = sparse_files_.size();
+
+    TENSORSTORE_ASSIGN_OR_RETURN(auto new_manifest, BuildManifest(retained),
+                                 CleanupWrittenFiles(_));
+    TENSORSTORE_RETURN_IF_ERROR(Commit(std::move(new_manifest)));
+
+    if (options_.delete_obsolete_files) {
+      TENSORSTORE_RETURN_IF_ERROR(DeleteObsoleteFiles());
+    }
+    return std::move(result_);
+  }
+
+ private:
+  size_t GetNumRetainedVersions(
+      const std::vector<BtreeGenerationReference>& versions) {
+    if (!options_.retain_versions && !options_.retain_since) {
+      return versions.size();
+    }
+    size_t num_retained = 1;
+    if (options_.retain_versions) {
+      num_retained = std::max<uint64_t>(
+          num_retained, std::min<uint64_t>(*options_.retain_versions,
+                                           versions.size()));
+    }
+    if (options_.retain_since) {
+      size_t i = versions.size();
+      while (i > 0 && static_cast<absl::Time>(versions[i - 1].commit_time) >=
+                          *options_.retain_since) {
+        --i;
+      }
+      num_retained = std::max(num_retained, versions.size() - i);
+    }
+    return num_retained;
+  }
+
+  absl::Status CollectVersions(const VersionNodeReference& ref,
+                               std::vector<BtreeGenerationReference>& versions) {
+    AddFileReference(ref.location, /*live=*/false);
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto node, io_handle_->GetVersionTreeNode(ref.location).result(),
+        _.Format("Reading version tree node %v", ref.location));
+    TENSORSTORE_RETURN_IF_ERROR(ValidateVersionTreeNodeReference(
+        *node, config_, ref.generation_number, ref.height));
+    if (auto* entries =
+            std::get_if<VersionTreeNode::LeafNodeEntries>(&node->entries)) {
+      versions.insert(versions.end(), entries->begin(), entries->end());
+      return absl::OkStatus();
+    }
+    for (const auto& child :
+         std::get<VersionTreeNode::InteriorNodeEntries>(node->entries)) {
+      TENSORSTORE_RETURN_IF_ERROR(CollectVersions(child, versions));
+    }
+    return absl::OkStatus();
+  }
+
+  void AddFileReference(const IndirectDataReference& ref, bool live) {
+    auto& usage = file_usage_[ref.file_id.FullPath()];
+    if (live) usage.live_bytes += ref.length;
+  }
+
+  struct BtreeVisitTask {
+    IndirectDataReference location;
+    BtreeNodeHeight height;
+    std::string inclusive_min_key;
+  };
+
+  /// Visits all b+tree nodes reachable from `versions` that have not already
+  /// been visited, recording the data files they reference.
+  absl::Status VisitBtrees(tensorstore::span<const BtreeGenerationReference>
+                               versions,
+                           bool live) {
+    std::vector<BtreeVisitTask> tasks;
+    for (const auto& version : versions) {
+      if (version.root.location.IsMissing()) continue;
+      if (!visited_nodes_.insert(version.root.location).second) continue;
+      tasks.push_back({version.root.location, version.root_height, ""});
+    }
+    while (!tasks.empty()) {
+      std::vector<BtreeVisitTask> next_tasks;
+      for (size_t start = 0; start < tasks.size();
+           start += options_.concurrency) {
+        const size_t end = std::min(tasks.size(), start + options_.concurrency);
+        std::vector<BtreeNodeFuture> futures;
+        futures.reserve(end - start);
+        for (size_t i = start; i < end; ++i) {
+          futures.push_back(io_handle_->GetBtreeNode(tasks[i].location));
+        }
+        for (size_t i = start; i < end; ++i) {
+          const auto& task = tasks[i];
+          TENSORSTORE_ASSIGN_OR_RETURN(
+              auto node, futures[i - start].result(),
+              _.Format("Reading b+tree node %v", task.location));
+          TENSORSTORE_RETURN_IF_ERROR(ValidateBtreeNodeReference(
+              *node, task.height, task.inclusive_min_key));
+          AddFileReference(task.location, live);
+          if (auto* entries =
+                  std::get_if<BtreeNode::LeafNodeEntries>(&node->entries)) {
+            for (const auto& entry : *entries) {
+              auto* value_ref = std::get_if<IndirectDataReference>(
+                  &entry.value_reference);
+              if (!value_ref || value_ref->length == 0) continue;
+              // Values may be shared between versions; only count them once.
+              AddFileReference(*value_ref,
+                               live && visited_values_.insert(*value_ref).second);
+            }
+            continue;
+          }
+          for (const auto& entry :
+               std::get<BtreeNode::InteriorNodeEntries>(node->entries)) {
+            if (!visited_nodes_.insert(entry.node.location).second) continue;
+            next_tasks.push_back({entry.node.location,
+                                  static_cast<BtreeNodeHeight>(task.height - 1),
+                                  std::string(entry.key_suffix())});
+          }
+        }
+      }
+      tasks = std::move(next_tasks);
+    }
+    return absl::OkStatus();
+  }
+
+  /// Classifies each referenced data file as sparse or obsolete.
+  ///
+  /// Files that are sparse, or that are referenced only by version tree nodes
+  /// and pruned versions, are no longer referenced after compaction.
+  absl::Status DetermineSparseFiles() {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto list_result, kvstore::ListFuture(base_kvstore_).result(),
+        _.Format("Error listing data files"));
+    absl::flat_hash_map<std::string, int64_t> file_sizes;
+    for (const auto& entry : list_result) {
+      file_sizes[entry.key] = entry.size;
+    }
+    for (const auto& [path, usage] : file_usage_) {
+      int64_t size = -1;
+      if (auto it = file_sizes.find(path); it != file_sizes.end()) {
+        size = it->second;
+      }
+      bool obsolete = usage.live_bytes == 0;
+      if (!obsolete && size > 0 &&
+          usage.live_bytes < options_.min_live_fraction * size) {
+        sparse_files_.insert(path);
+        result_.bytes_rewritten += usage.live_bytes;
+        obsolete = true;
+      }
+      if (!obsolete) continue;
+      result_.obsolete_files.push_back(path);
+      if (size > 0) result_.bytes_reclaimed += size;
+    }
+    std::sort(result_.obsolete_files.begin(), result_.obsolete_files.end());
+    reporter_.ReportInfo(
+        "Found %d sparse and %d unreferenced data files",
+        sparse_files_.size(),
+        result_.obsolete_files.size() - sparse_files_.size());
+    return absl::OkStatus();
+  }
+
+  bool IsSparse(const IndirectDataReference& ref) const {
+    return sparse_files_.contains(ref.file_id.FullPath());
+  }
+
+  void WriteData(IndirectDataKind kind, absl::Cord data,
+                 IndirectDataReference& ref) {
+    flush_promise_.Link(io_handle_->WriteData(kind, std::move(data), ref));
+    written_files_.insert(ref.file_id.FullPath());
+  }
+
+  absl::Status RewriteVersion(BtreeGenerationReference& version) {
+    if (version.root.location.IsMissing()) return absl::OkStatus();
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto rewritten,
+        RewriteSubtree(version.root.location, version.root_height,
+                       /*subtree_key_prefix=*/"", /*inclusive_min_key=*/"",
+                       /*is_root=*/true,
+                       io_handle_->GetBtreeNode(version.root.location)));
+    if (!rewritten) return absl::OkStatus();
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto new_root,
+        internal_ocdbt::WriteRootNode(*io_handle_, flush_promise_,
+                                      version.root_height,
+                                      rewritten->entries));
+    version.root = new_root.root;
+    version.root_height = new_root.root_height;
+    return absl::OkStatus();
+  }
+
+  /// Rewrites the subtree rooted at `location` if it references any data
+  /// stored in a sparse file.
+  ///
+  /// \param subtree_key_prefix Key prefix implicitly prepended to the keys of
+  ///     the node.
+  /// \param inclusive_min_key Minimum key of the node, relative to
+  ///     `subtree_key_prefix`.
+  Result<RewrittenSubtreePtr> RewriteSubtree(
+      const IndirectDataReference& location, BtreeNodeHeight height,
+      std::string_view subtree_key_prefix, std::string_view inclusive_min_key,
+      bool is_root, BtreeNodeFuture node_future) {
+    auto memo_key = std::make_pair(location, is_root);
+    if (auto it = rewritten_subtrees_.find(memo_key);
+        it != rewritten_subtrees_.end()) {
+      return it->second;
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto node, node_future.result(),
+        _.Format("Reading b+tree node %v", location));
+    TENSORSTORE_RETURN_IF_ERROR(
+        ValidateBtreeNodeReference(*node, height, inclusive_min_key));
+    const std::string existing_prefix =
+        absl::StrCat(subtree_key_prefix, node->key_prefix);
+
+    RewrittenSubtreePtr rewritten;
+    if (auto* entries =
+            std::get_if<BtreeNode::LeafNodeEntries>(&node->entries)) {
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          rewritten, RewriteLeafNode(location, existing_prefix, *entries,
+                                     is_root));
+    } else {
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          rewritten,
+          RewriteInteriorNode(
+              location, height, existing_prefix,
+              std::get<BtreeNode::InteriorNodeEntries>(node->entries),
+              is_root));
+    }
+    rewritten_subtrees_.emplace(memo_key, rewritten);
+    return rewritten;
+  }
+
+  Result<RewrittenSubtreePtr> RewriteLeafNode(
+      const IndirectDataReference& location, std::string_view existing_prefix,
+      const BtreeNode::LeafNodeEntries& entries, bool is_root) {
+    bool changed = IsSparse(location);
+    std::vector<LeafNodeValueReference> values;
+    values.reserve(entries.size());
+    std::vector<std::pair<size_t, Future<kvstore::ReadResult>>> reads;
+    for (const auto& entry : entries) {
+      values.push_back(entry.value_reference);
+      auto* value_ref =
+          std::get_if<IndirectDataReference>(&entry.value_reference);
+      if (!value_ref || value_ref->length == 0 || !IsSparse(*value_ref)) {
+        continue;
+      }
+      changed = true;
+      if (auto it = rewritten_values_.find(*value_ref);
+          it != rewritten_values_.end()) {
+        values.back() = it->second;
+        continue;
+      }
+      reads.emplace_back(values.size() - 1,
+                         io_handle_->ReadIndirectData(*value_ref, {}));
+    }
+    if (!changed) return RewrittenSubtreePtr{};
+
+    for (auto& [i, future] : reads) {
+      const auto old_ref = std::get<IndirectDataReference>(values[i]);
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto read_result, future.result(),
+          _.Format("Reading value %v", old_ref));
+      if (!read_result.has_value()) {
+        return absl::DataLossError(
+            absl::StrFormat("Missing value %v", old_ref));
+      }
+      IndirectDataReference new_ref;
+      WriteData(IndirectDataKind::kValue, std::move(read_result.value),
+                new_ref);
+      rewritten_values_.emplace(old_ref, new_ref);
+      values[i] = new_ref;
+    }
+
+    BtreeLeafNodeEncoder encoder(config_, /*height=*/0, existing_prefix);
+    for (size_t i = 0; i < entries.size(); ++i) {
+      encoder.AddEntry(/*existing=*/true,
+                       LeafNodeEntry{entries[i].key, std::move(values[i])});
+    }
+    return FinalizeNode(encoder, is_root);
+  }
+
+  Result<RewrittenSubtreePtr> RewriteInteriorNode(
+      const IndirectDataReference& location, BtreeNodeHeight height,
+      std::string_view existing_prefix,
+      const BtreeNode::InteriorNodeEntries& entries, bool is_root) {
+    // Issue reads for all children concurrently.
+    std::vector<BtreeNodeFuture> child_futures;
+    child_futures.reserve(entries.size());
+    for (const auto& entry : entries) {
+      if (rewritten_subtrees_.contains(
+              std::make_pair(entry.node.location, false))) {
+        child_futures.emplace_back();
+      } else {
+        child_futures.push_back(io_handle_->GetBtreeNode(entry.node.location));
+      }
+    }
+
+    bool changed = IsSparse(location);
+    std::vector<RewrittenSubtreePtr> children(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+      const auto& entry = entries[i];
+      const std::string child_key_prefix = absl::StrCat(
+          existing_prefix,
+          std::string_view(entry.key).substr(
+              0, entry.subtree_common_prefix_length));
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          children[i],
+          RewriteSubtree(entry.node.location, height - 1, child_key_prefix,
+                         entry.key_suffix(), /*is_root=*/false,
+                         std::move(child_futures[i])));
+      if (children[i]) changed = true;
+    }
+    if (!changed) return RewrittenSubtreePtr{};
+
+    BtreeInteriorNodeEncoder encoder(config_, height, existing_prefix);
+    for (size_t i = 0; i < entries.size(); ++i) {
+      if (!children[i]) {
+        InteriorNodeEntry entry = entries[i];
+        encoder.AddEntry(/*existing=*/true, std::move(entry));
+        continue;
+      }
+      for (const auto& new_entry : children[i]->entries) {
+        AddNewInteriorEntry(encoder, new_entry);
+      }
+    }
+    return FinalizeNode(encoder, is_root);
+  }
+
+  template <typename Entry>
+  Result<RewrittenSubtreePtr> FinalizeNode(
+      internal_ocdbt::BtreeNodeEncoder<Entry>& encoder, bool is_root) {
+    TENSORSTORE_ASSIGN_OR_RETURN(auto encoded_nodes,
+                                 encoder.Finalize(/*may_be_root=*/is_root));
+    auto rewritten = std::make_shared<RewrittenSubtree>();
+    rewritten->entries = internal_ocdbt::WriteNodes(
+        *io_handle_, flush_promise_, std::move(encoded_nodes));
+    for (const auto& entry : rewritten->entries) {
+      written_files_.insert(entry.node.location.file_id.FullPath());
+    }
+    return rewritten;
+  }
+
+  Result<VersionNodeReference> WriteVersionTreeNode(VersionTreeNode node) {
+    VersionNodeReference ref;
+    ref.height = node.height;
+    ref.generation_number = node.generation_number();
+    if (auto* entries =
+            std::get_if<VersionTreeNode::LeafNodeEntries>(&node.entries)) {
+      ref.num_generations = entries->size();
+      ref.commit_time = entries->front().commit_time;
+    } else {
+      auto& children = std::get<VersionTreeNode::InteriorNodeEntries>(
+          node.entries);
+      ref.num_generations = 0;
+      for (const auto& child : children) {
+        ref.num_generations += child.num_generations;
+      }
+      ref.commit_time = children.front().commit_time;
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(auto encoded,
+                                 EncodeVersionTreeNode(config_, node));
+    WriteData(IndirectDataKind::kVersionNode, std::move(encoded),
+              ref.location);
+    return ref;
+  }
+
+  /// Builds a new manifest containing `retained`, followed by a new version
+  /// equivalent to the latest retained version.
+  ///
+  /// The new version ensures that the manifest has a new generation number,
+  /// as required by the numbered manifest format, and that readers with a
+  /// cached manifest observe the change.
+  Result<std::shared_ptr<Manifest>> BuildManifest(
+      std::vector<BtreeGenerationReference> versions) {
+    const auto& latest = versions.back();
+    if (latest.generation_number >=
+        std::numeric_limits<GenerationNumber>::max() - 1) {
+      return absl::FailedPreconditionError(
+          "Maximum generation number reached");
+    }
+    BtreeGenerationReference new_version = latest;
+    new_version.generation_number = latest.generation_number + 1;
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        new_version.commit_time,
+        CommitTime::FromAbslTime(std::max(
+            absl::Now(), static_cast<absl::Time>(latest.commit_time) +
+                             absl::Nanoseconds(1))));
+    versions.push_back(new_version);
+    result_.new_generation = new_version.generation_number;
+
+    const auto arity_log2 = config_.version_tree_arity_log2;
+    auto manifest = std::make_shared<Manifest>();
+    manifest->config = config_;
+
+    // Versions not in the leaf node range of the latest version are stored in
+    // separate leaf nodes.
+    const GenerationNumber inline_min_generation =
+        GetVersionTreeLeafNodeRangeContainingGeneration(
+            arity_log2, new_version.generation_number)
+            .first;
+    std::vector<VersionNodeReference> children;
+    size_t i = 0;
+    while (i < versions.size() &&
+           versions[i].generation_number < inline_min_generation) {
+      const GenerationNumber max_generation =
+          GetVersionTreeLeafNodeRangeContainingGeneration(
+              arity_log2, versions[i].generation_number)
+              .second;
+      size_t end = i + 1;
+      while (end < versions.size() &&
+             versions[end].generation_number <= max_generation) {
+        ++end;
+      }
+      VersionTreeNode node;
+      node.height = 0;
+      node.version_tree_arity_log2 = arity_log2;
+      node.entries.emplace<VersionTreeNode::LeafNodeEntries>(
+          versions.begin() + i, versions.begin() + end);
+      TENSORSTORE_ASSIGN_OR_RETURN(auto ref,
+                                   WriteVersionTreeNode(std::move(node)));
+      children.push_back(std::move(ref));
+      i = end;
+    }
+    manifest->versions.assign(versions.begin() + i, versions.end());
+
+    // Group the nodes of each height into parent nodes, where the parent node
+    // in the range referenced directly by the manifest is not written.
+    absl::Status status;
+    std::vector<VersionNodeReference> manifest_nodes;
+    ForEachManifestVersionTreeNodeRef(
+        new_version.generation_number, arity_log2,
+        [&](GenerationNumber min_generation_number,
+            GenerationNumber max_generation_number,
+            VersionTreeHeight height) {
+          if (!status.ok()) return;
+          const int shift = arity_log2 * (height + 1);
+          std::vector<VersionNodeReference> parents;
+          size_t j = 0;
+          while (j < children.size()) {
+            size_t end = j + 1;
+            if (children[j].generation_number >= min_generation_number) {
+              end = children.size();
+            } else {
+              const GenerationNumber parent_index =
+                  (children[j].generation_number - 1) >> shift;
+              while (end < children.size() &&
+                     ((children[end].generation_number - 1) >> shift) ==
+                         parent_index) {
+                ++end;
+              }
+            }
+            VersionTreeNode node;
+            node.height = height;
+            node.version_tree_arity_log2 = arity_log2;
+            node.entries.emplace<VersionTreeNode::InteriorNodeEntries>(
+                children.begin() + j, children.begin() + end);
+            auto ref_result = WriteVersionTreeNode(std::move(node));
+            if (!ref_result.ok()) {
+              status = ref_result.status();
+              return;
+            }
+            if (children[j].generation_number >= min_generation_number) {
+              manifest_nodes.push_back(*std::move(ref_result));
+            } else {
+              parents.push_back(*std::move(ref_result));
+            }
+            j = end;
+          }
+          children = std::move(parents);
+        });
+    TENSORSTORE_RETURN_IF_ERROR(status);
+    assert(children.empty());
+    manifest->version_tree_nodes.assign(manifest_nodes.rbegin(),
+                                        manifest_nodes.rend());
+    return manifest;
+  }
+
+  absl::Status Commit(std::shared_ptr<Manifest> new_manifest) {
+    reporter_.ReportInfo("Writing %d new data files", written_files_.size());
+    if (auto flush_future = std::move(flush_promise_).future();
+        !flush_future.null()) {
+      TENSORSTORE_RETURN_IF_ERROR(flush_future.status(),
+                                  CleanupWrittenFiles(_));
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto update_result,
+        io_handle_
+            ->TryUpdateManifest(manifest_, std::move(new_manifest),
+                                absl::Now())
+            .result(),
+        CleanupWrittenFiles(_));
+    if (!update_result.success) {
+      return CleanupWrittenFiles(absl::AbortedError(
+          "OCDBT manifest was modified concurrently with compaction"));
+    }
+    reporter_.ReportInfo(
+        "Committed generation %d; rewrote %d data files (%d bytes); %d bytes "
+        "in %d data files are no longer referenced",
+        result_.new_generation, result_.num_files_rewritten,
+        result_.bytes_rewritten, result_.bytes_reclaimed,
+        result_.obsolete_files.size());
+    return absl::OkStatus();
+  }
+
+  absl::Status DeleteObsoleteFiles() {
+    if (options_.grace_period > absl::ZeroDuration()) {
+      reporter_.ReportInfo("Waiting %s before deleting obsolete files",
+                           absl::FormatDuration(options_.grace_period));
+      absl::SleepFor(options_.grace_period);
+    }
+    TENSORSTORE_RETURN_IF_ERROR(DeleteFiles(result_.obsolete_files));
+    result_.obsolete_files_deleted = true;
+    reporter_.ReportInfo("Deleted %d obsolete data files",
+                         result_.obsolete_files.size());
+    return absl::OkStatus();
+  }
+
+  absl::Status DeleteFiles(tensorstore::span<const std::string> paths) {
+    std::vector<Future<TimestampedStorageGeneration>> futures;
+    futures.reserve(paths.size());
+    for (const auto& path : paths) {
+      futures.push_back(kvstore::Delete(base_kvstore_, path));
+    }
+    absl::Status status;
+    for (auto& future : futures) {
+      status.Update(future.status());
+    }
+    return status;
+  }
+
+  /// Deletes the files written by an unsuccessful compaction, and returns
+  /// `status`.
+  absl::Status CleanupWrittenFiles(absl::Status status) {
+    std::vector<std::string> paths(written_files_.begin(),
+                                   written_files_.end());
+    // Best effort: the files are unreferenced, and an error deleting them
+    // should not obscure the original error.
+    DeleteFiles(paths).IgnoreError();
+    return status;
+  }
+
+  IoHandle::Ptr io_handle_;
+  kvstore::KvStore base_kvstore_;
+  const OcdbtCompactOptions& options_;
+  OcdbtCheckReporter reporter_;
+  std::shared_ptr<const Manifest> manifest_;
+  Config config_;
+  OcdbtCompactResult result_;
+  FlushPromise flush_promise_;
+
+  absl::flat_hash_map<std::string, DataFileUsage> file_usage_;
+  absl::flat_hash_set<std::string> sparse_files_;
+  absl::flat_hash_set<std::string> written_files_;
+  absl::flat_hash_set<IndirectDataReference> visited_nodes_;
+  absl::flat_hash_set<IndirectDataReference> visited_values_;
+  absl::flat_hash_map<std::pair<IndirectDataReference, bool>,
+                      RewrittenSubtreePtr>
+      rewritten_subtrees_;
+  absl::flat_hash_map<IndirectDataReference, IndirectDataReference>
+      rewritten_values_;
+};
+
+}  // namespace
+
+Result<OcdbtCompactResult> OcdbtCompact(Context context,
+                                        tensorstore::kvstore::Spec source_spec,
+                                        std::ostream& output,
+                                        OcdbtCompactOptions options) {
+  if (!(options.min_live_fraction >= 0 && options.min_live_fraction <= 1)) {
+    return absl::InvalidArgumentError(
+        "min_live_fraction must be in the range [0, 1]");
+  }
+  if (options.concurrency == 0) options.concurrency = 1;
+
+  TENSORSTORE_ASSIGN_OR_RETURN(auto base,
+                               kvstore::Open(source_spec, context).result());
+  tensorstore::internal::EnsureDirectoryPath(base.path);
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto data_copy_concurrency_resource,
+      context
+          .GetResource<tensorstore::internal::DataCopyConcurrencyResource>());
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto cache_pool_resource,
+      context.GetResource<tensorstore::internal::CachePoolResource>());
+
+  DataFilePrefixes data_file_prefixes;
+  data_file_prefixes.value = options.data_file_prefix;
+  data_file_prefixes.btree_node = options.data_file_prefix;
+  data_file_prefixes.version_tree_node = options.data_file_prefix;
+  auto io_handle = tensorstore::internal_ocdbt::MakeIoHandle(
+      data_copy_concurrency_resource, cache_pool_resource->get(), base, base,
+      /*config_state=*/
+      ConfigState::Make().value(), data_file_prefixes,
+      options.target_data_file_size);
+
+  OcdbtCompactor compactor(std::move(io_handle), std::move(base), options,
+                           output);
+  return compactor.Run();
+}
+
+}  // namespace cli
+}  // namespace tensorstore
@@ -0,0 +1,145 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_TSCLI_LIB_OCDBT_COMPACT_H_
+#define TENSORSTORE_TSCLI_LIB_OCDBT_COMPACT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "absl/time/time.h"
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace cli {
+
+inline constexpr size_t kOcdbtCompactDefaultConcurrency = 256;
+inline constexpr absl::Duration kOcdbtCompactDefaultGracePeriod =
+    absl::Minutes(10);
+
+struct OcdbtCompactOptions {
+  /// Number of most recent versions to retain.
+  ///
+  /// A version is retained if it satisfies either `retain_versions` or
+  /// `retain_since`.  If neither is specified, all versions are retained and
+  /// only sparse data files are rewritten.  The latest version is always
+  /// retained.
+  std::optional<uint64_t> retain_versions;
+
+  /// Retain all versions committed at or after this time.
+  std::optional<absl::Time> retain_since;
+
+  /// Data files in which less than this fraction of the bytes is referenced by
+  /// the retained versions are rewritten.
+  double min_live_fraction = 0.5;
+
+  /// Target size of the newly written data files.
+  uint64_t target_data_file_size = uint64_t(2) << 30;
+
+  /// Prefix, relative to the database root, of the newly written data files.
+  std::string data_file_prefix = "d/";
+
+  /// If true, only reports what would be done.
+  bool dry_run = false;
+
+  /// If true, deletes the data files that are no longer referenced once the
+  /// compacted manifest has been committed.
+  ///
+  /// Readers that opened the database before compaction may still reference
+  /// the obsolete files; deletion should only be enabled if no such readers
+  /// remain after `grace_period`.
+  bool delete_obsolete_files = false;
+
+  /// Time to wait after committing the compacted manifest before deleting
+  /// obsolete files.
+  ///
+  /// Readers that read the previous manifest just before the commit may still
+  /// be reading the obsolete files; the default gives such reads time to
+  /// complete.  Readers that remain open for longer must re-read the manifest
+  /// (e.g. by specifying a staleness bound) or they will fail with
+  /// `NotFound` errors.  A zero duration deletes the files immediately.
+  absl::Duration grace_period = kOcdbtCompactDefaultGracePeriod;
+
+  /// Limit on concurrent node reads.
+  size_t concurrency = kOcdbtCompactDefaultConcurrency;
+};
+
+struct OcdbtCompactResult {
+  /// Number of versions in the retained version tree, excluding the new
+  /// version added by compaction.
+  uint64_t num_versions_retained = 0;
+
+  /// Number of versions removed from the version tree.
+  uint64_t num_versions_pruned = 0;
+
+  /// Number of data files rewritten because they were sparse.
+  uint64_t num_files_rewritten = 0;
+
+  /// Number of live bytes in the rewritten data files, which are copied to
+  /// new data files.
+  uint64_t bytes_rewritten = 0;
+
+  /// Total size of the data files no longer referenced by the new manifest.
+  uint64_t bytes_reclaimed = 0;
+
+  /// Generation number of the compacted manifest, or `0` if nothing was
+  /// committed.
+  uint64_t new_generation = 0;
+
+  /// Paths, relative to the database root, of the data files no longer
+  /// referenced by the new manifest.
+  std::vector<std::string> obsolete_files;
+
+  /// Indicates whether `obsolete_files` were deleted.
+  bool obsolete_files_deleted = false;
+};
+
+/// Compacts an OCDBT database.
+///
+/// Prunes the versions not selected by `options` from the version tree, and
+/// rewrites the retained versions such that the values and b+tree nodes stored
+/// in sparse data files are copied to new, densely packed, data files.
+/// B+tree nodes that reference rewritten data are rewritten as well; all other
+/// nodes are shared with the existing versions.
+///
+/// The compacted manifest is committed conditionally on the manifest being
+/// unchanged since compaction started, and includes a new version, with the
+/// same content as the latest version, that references the rewritten b+tree.
+/// Retained versions keep their generation numbers and commit times.
+///
+/// Existing data files are never modified.  Readers pinned to an older
+/// manifest continue to work until the obsolete files are deleted.
+///
+/// \param context Context to use for opening the kvstore.
+/// \param source_spec Spec of the base kvstore containing the OCDBT database.
+/// \param output Stream to write progress to.
+/// \param options Optional settings for the compaction.
+/// \error `absl::StatusCode::kAborted` if the manifest was concurrently
+///     modified.
+Result<OcdbtCompactResult> OcdbtCompact(Context context,
+                                        tensorstore::kvstore::Spec source_spec,
+                                        std::ostream& output,
+                                        OcdbtCompactOptions options = {});
+
+}  // namespace cli
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_TSCLI_LIB_OCDBT_COMPACT_H_
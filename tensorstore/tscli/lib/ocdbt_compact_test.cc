@@ -0,0 +1,320 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/lib/ocdbt_compact.h"
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/log/absl_check.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/mock_kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/tscli/lib/ocdbt_check.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+using ::tensorstore::StatusIs;
+using ::tensorstore::cli::OcdbtCompact;
+using ::tensorstore::cli::OcdbtCompactOptions;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MockKeyValueStore;
+using ::tensorstore::internal::MockKeyValueStoreResource;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::testing::Not;
+
+class OcdbtCompactTest : public ::testing::Test {
+ protected:
+  // Writes `num_versions` versions, each overwriting "a", where "b" is only
+  // written by the first half of the versions.
+  void WriteVersions(int num_versions) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        ocdbt_store_,
+        kvstore::Open({{"driver", "ocdbt"},
+                       {"config",
+                        {{"version_tree_arity_log2", 1},
+                         {"max_inline_value_bytes", 0}}},
+                       {"base", "memory://compact/"}},
+                      context_)
+            .result());
+    for (int i = 0; i < num_versions; ++i) {
+      tensorstore::Transaction transaction(tensorstore::atomic_isolated);
+      TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, ocdbt_store_ | transaction);
+      TENSORSTORE_ASSERT_OK(
+          kvstore::Write(store, "a", absl::Cord(absl::StrCat("a_", i))));
+      if (i < num_versions / 2) {
+        TENSORSTORE_ASSERT_OK(
+            kvstore::Write(store, "b", absl::Cord(absl::StrCat("b_", i))));
+      }
+      TENSORSTORE_ASSERT_OK(transaction.Commit());
+    }
+  }
+
+  kvstore::KvStore OpenVersion(int generation) {
+    auto store = kvstore::Open({{"driver", "ocdbt"},
+                                {"base", "memory://compact/"},
+                                {"version", generation}},
+                               context_)
+                     .result();
+    ABSL_CHECK_OK(store.status());
+    return *store;
+  }
+
+  kvstore::Spec BaseSpec() {
+    return kvstore::Spec::FromJson({{"driver", "memory"}, {"path", "compact/"}})
+        .value();
+  }
+
+  tensorstore::Context context_ = tensorstore::Context::Default();
+  kvstore::KvStore ocdbt_store_;
+};
+
+TEST_F(OcdbtCompactTest, PruneVersions) {
+  WriteVersions(10);
+
+  OcdbtCompactOptions options;
+  options.retain_versions = 3;
+  std::stringstream output;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result, OcdbtCompact(context_, BaseSpec(), output, options));
+  EXPECT_EQ(3, result.num_versions_retained);
+  EXPECT_EQ(7, result.num_versions_pruned);
+  EXPECT_EQ(11, result.new_generation);
+  EXPECT_THAT(result.obsolete_files, Not(IsEmpty()));
+  EXPECT_FALSE(result.obsolete_files_deleted);
+
+  EXPECT_THAT(kvstore::Read(ocdbt_store_, "a").result(),
+              MatchesKvsReadResult(absl::Cord("a_9")));
+  EXPECT_THAT(kvstore::Read(ocdbt_store_, "b").result(),
+              MatchesKvsReadResult(absl::Cord("b_4")));
+  EXPECT_THAT(kvstore::Read(OpenVersion(8), "a").result(),
+              MatchesKvsReadResult(absl::Cord("a_7")));
+  EXPECT_THAT(kvstore::Read(OpenVersion(2), "a").result(),
+              StatusIs(absl::StatusCode::kNotFound));
+
+  // Obsolete files are retained for readers of the previous manifest.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base, kvstore::Open(BaseSpec(), context_).result());
+  for (const auto& path : result.obsolete_files) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto read_result,
+                                     kvstore::Read(base, path).result());
+    EXPECT_TRUE(read_result.has_value()) << path;
+  }
+}
+
+TEST_F(OcdbtCompactTest, DeleteObsoleteFiles) {
+  WriteVersions(10);
+
+  OcdbtCompactOptions options;
+  options.retain_versions = 3;
+  options.delete_obsolete_files = true;
+  options.grace_period = absl::ZeroDuration();
+  std::stringstream output;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result, OcdbtCompact(context_, BaseSpec(), output, options));
+  EXPECT_TRUE(result.obsolete_files_deleted);
+  EXPECT_THAT(output.str(), HasSubstr("Deleted"));
+
+  EXPECT_THAT(kvstore::Read(ocdbt_store_, "a").result(),
+              MatchesKvsReadResult(absl::Cord("a_9")));
+  EXPECT_THAT(kvstore::Read(ocdbt_store_, "b").result(),
+              MatchesKvsReadResult(absl::Cord("b_4")));
+  for (int generation = 8; generation <= 11; ++generation) {
+    EXPECT_THAT(kvstore::Read(OpenVersion(generation), "a").result(),
+                MatchesKvsReadResult(absl::Cord(
+                    absl::StrCat("a_", std::min(generation, 10) - 1))))
+        << generation;
+  }
+
+  // The compacted database is valid and contains no orphaned files.
+  std::stringstream check_output;
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::cli::OcdbtCheck(context_, BaseSpec(), check_output));
+  EXPECT_THAT(check_output.str(), HasSubstr("Total errors found: 0"));
+  EXPECT_THAT(check_output.str(), Not(HasSubstr("orphaned")));
+}
+
+TEST_F(OcdbtCompactTest, ConcurrentModification) {
+  WriteVersions(10);
+
+  // Compacts through a mock kvstore that forwards to the memory kvstore, but
+  // rewrites the manifest just before the compacted manifest is written, as
+  // a concurrent writer would.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base, kvstore::Open(BaseSpec(), context_).result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto mock_resource, context_.GetResource<MockKeyValueStoreResource>());
+  MockKeyValueStore* mock = mock_resource->get();
+  mock->read_handler = [&](MockKeyValueStore::ReadRequest request) {
+    request(base.driver);
+  };
+  mock->list_handler = [&](MockKeyValueStore::ListRequest request) {
+    request(base.driver);
+  };
+  std::atomic<bool> modified{false};
+  mock->write_handler = [&](MockKeyValueStore::WriteRequest request) {
+    if (request.key == "compact/manifest.ocdbt" && !modified.exchange(true)) {
+      auto manifest = kvstore::Read(base, "manifest.ocdbt").result();
+      ABSL_CHECK_OK(manifest.status());
+      ABSL_CHECK_OK(
+          kvstore::Write(base, "manifest.ocdbt", manifest->value).result());
+    }
+    request(base.driver);
+  };
+
+  OcdbtCompactOptions options;
+  options.retain_versions = 3;
+  options.delete_obsolete_files = true;
+  options.grace_period = absl::ZeroDuration();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto mock_spec,
+      kvstore::Spec::FromJson(
+          {{"driver", "mock_key_value_store"}, {"path", "compact/"}}));
+  std::stringstream output;
+  EXPECT_THAT(OcdbtCompact(context_, mock_spec, output, options),
+              StatusIs(absl::StatusCode::kAborted));
+  EXPECT_TRUE(modified);
+
+  // The existing versions are unchanged, and the data files written by the
+  // failed compaction have been deleted.
+  EXPECT_THAT(kvstore::Read(OpenVersion(2), "a").result(),
+              MatchesKvsReadResult(absl::Cord("a_1")));
+  EXPECT_THAT(kvstore::Read(OpenVersion(10), "a").result(),
+              MatchesKvsReadResult(absl::Cord("a_9")));
+  std::stringstream check_output;
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::cli::OcdbtCheck(context_, BaseSpec(), check_output));
+  EXPECT_THAT(check_output.str(), HasSubstr("Total errors found: 0"));
+  EXPECT_THAT(check_output.str(), Not(HasSubstr("orphaned")));
+}
+
+TEST_F(OcdbtCompactTest, MultiLevelBtree) {
+  // Small nodes result in a b+tree with several levels of interior nodes.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      ocdbt_store_,
+      kvstore::Open({{"driver", "ocdbt"},
+                     {"config",
+                      {{"max_inline_value_bytes", 0},
+                       {"max_decoded_node_bytes", 128}}},
+                     {"base", "memory://compact/"}},
+                    context_)
+          .result());
+  constexpr int kNumKeys = 200;
+  auto key = [](int i) { return absl::StrFormat("k%03d", i); };
+  // The second version overwrites the even keys, such that the leaf nodes
+  // and values of the first version are partially live.
+  for (int version = 0; version < 2; ++version) {
+    tensorstore::Transaction transaction(tensorstore::atomic_isolated);
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, ocdbt_store_ | transaction);
+    for (int i = 0; i < kNumKeys; i += version + 1) {
+      TENSORSTORE_ASSERT_OK(kvstore::Write(
+          store, key(i), absl::Cord(absl::StrCat("v", version, "_", i))));
+    }
+    TENSORSTORE_ASSERT_OK(transaction.Commit());
+  }
+
+  OcdbtCompactOptions options;
+  options.retain_versions = 1;
+  options.min_live_fraction = 1;
+  options.delete_obsolete_files = true;
+  options.grace_period = absl::ZeroDuration();
+  std::stringstream output;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result, OcdbtCompact(context_, BaseSpec(), output, options));
+  EXPECT_EQ(1, result.num_versions_pruned);
+  EXPECT_LT(0, result.num_files_rewritten);
+  EXPECT_TRUE(result.obsolete_files_deleted);
+
+  // All keys are reachable through the rewritten interior nodes.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", "ocdbt"},
+                                 {"base", "memory://compact/"},
+                                 {"version", result.new_generation}},
+                                context_)
+                      .result());
+  for (int i = 0; i < kNumKeys; ++i) {
+    EXPECT_THAT(kvstore::Read(store, key(i)).result(),
+                MatchesKvsReadResult(
+                    absl::Cord(absl::StrCat("v", i % 2 == 0 ? 1 : 0, "_", i))))
+        << i;
+  }
+  std::stringstream check_output;
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::cli::OcdbtCheck(context_, BaseSpec(), check_output));
+  EXPECT_THAT(check_output.str(), HasSubstr("Total errors found: 0"));
+  EXPECT_THAT(check_output.str(), Not(HasSubstr("orphaned")));
+}
+
+TEST_F(OcdbtCompactTest, RetainSince) {
+  WriteVersions(4);
+  OcdbtCompactOptions options;
+  options.retain_since = absl::InfiniteFuture();
+  std::stringstream output;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result, OcdbtCompact(context_, BaseSpec(), output, options));
+  // The latest version is always retained.
+  EXPECT_EQ(1, result.num_versions_retained);
+  EXPECT_EQ(3, result.num_versions_pruned);
+  EXPECT_THAT(kvstore::Read(ocdbt_store_, "a").result(),
+              MatchesKvsReadResult(absl::Cord("a_3")));
+}
+
+TEST_F(OcdbtCompactTest, DryRun) {
+  WriteVersions(4);
+  OcdbtCompactOptions options;
+  options.retain_versions = 1;
+  options.dry_run = true;
+  std::stringstream output;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result, OcdbtCompact(context_, BaseSpec(), output, options));
+  EXPECT_EQ(3, result.num_versions_pruned);
+  EXPECT_EQ(0, result.new_generation);
+  EXPECT_THAT(output.str(), HasSubstr("Dry run"));
+  EXPECT_THAT(kvstore::Read(OpenVersion(1), "a").result(),
+              MatchesKvsReadResult(absl::Cord("a_0")));
+}
+
+TEST_F(OcdbtCompactTest, NothingToCompact) {
+  WriteVersions(1);
+  std::stringstream output;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto result,
+                                   OcdbtCompact(context_, BaseSpec(), output));
+  EXPECT_EQ(0, result.new_generation);
+  EXPECT_THAT(output.str(), HasSubstr("Nothing to compact"));
+}
+
+TEST_F(OcdbtCompactTest, MissingDatabase) {
+  std::stringstream output;
+  EXPECT_THAT(OcdbtCompact(context_, BaseSpec(), output),
+              StatusIs(absl::StatusCode::kNotFound));
+}
+
+}  // namespace
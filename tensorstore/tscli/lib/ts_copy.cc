@@ -0,0 +1,615 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/lib/ts_copy.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/array.h"
+#include "tensorstore/array_storage_statistics.h"
+#include "tensorstore/batch.h"
+#include "tensorstore/box.h"
+#include "tensorstore/chunk_layout.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/internal/integer_overflow.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/spec.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/division.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/iterate.h"
+#include "tensorstore/util/quote_string.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace cli {
+namespace {
+
+// Partition of a domain by a regular chunk grid.
+//
+// Chunks are identified by their row-major linear index within the grid cells
+// that intersect the domain.
+struct ChunkGrid {
+  Box<> domain;
+  std::vector<Index> chunk_shape;
+  std::vector<Index> grid_origin;
+  std::vector<Index> first_cell;
+  std::vector<Index> num_cells;
+  uint64_t num_chunks = 1;
+
+  // Returns the intersection of grid cell `first_cell + cell` and the domain.
+  Box<> GetChunk(tensorstore::span<const Index> cell) const {
+    return GetRegion(cell, std::vector<Index>(cell.size(), 1));
+  }
+
+  // Returns the intersection of the grid cells `first_cell + cell_origin +
+  // [0, cell_shape)` and the domain.
+  Box<> GetRegion(tensorstore::span<const Index> cell_origin,
+                  tensorstore::span<const Index> cell_shape) const {
+    const DimensionIndex rank = domain.rank();
+    Box<> box(rank);
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      const Index start =
+          grid_origin[i] + (first_cell[i] + cell_origin[i]) * chunk_shape[i];
+      const Index inclusive_min = std::max(start, domain.origin()[i]);
+      const Index exclusive_max =
+          std::min(start + cell_shape[i] * chunk_shape[i],
+                   domain.origin()[i] + domain.shape()[i]);
+      box.origin()[i] = inclusive_min;
+      box.shape()[i] = exclusive_max - inclusive_min;
+    }
+    return box;
+  }
+
+  // Returns the row-major linear index of grid cell `first_cell + cell`.
+  uint64_t GetIndex(tensorstore::span<const Index> cell) const {
+    uint64_t index = 0;
+    for (size_t i = 0; i < cell.size(); ++i) {
+      index = index * num_cells[i] + cell[i];
+    }
+    return index;
+  }
+};
+
+// Returns the partition of the domain of `store` by its write chunk grid.
+//
+// Dimensions without a chunk size are treated as a single chunk.
+Result<ChunkGrid> GetWriteChunkGrid(const TensorStore<>& store) {
+  TENSORSTORE_ASSIGN_OR_RETURN(auto layout, store.chunk_layout());
+  const DimensionIndex rank = store.rank();
+  ChunkGrid grid;
+  grid.domain = Box<>(store.domain().box());
+  grid.chunk_shape.resize(rank);
+  grid.grid_origin.resize(rank);
+  grid.first_cell.resize(rank);
+  grid.num_cells.resize(rank);
+  auto write_chunk_shape = layout.write_chunk_shape();
+  auto grid_origin = layout.grid_origin();
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    const Index origin = grid.domain.origin()[i];
+    const Index size = grid.domain.shape()[i];
+    if (!IsFinite(grid.domain[i])) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Cannot copy unbounded domain: ", store.domain()));
+    }
+    Index chunk_size = write_chunk_shape.valid() && write_chunk_shape[i] > 0
+                           ? write_chunk_shape[i]
+                           : 0;
+    Index chunk_origin = grid_origin.valid() && IsFiniteIndex(grid_origin[i])
+                             ? grid_origin[i]
+                             : origin;
+    if (chunk_size == 0) {
+      chunk_size = std::max(Index(1), size);
+      chunk_origin = origin;
+    }
+    grid.chunk_shape[i] = chunk_size;
+    grid.grid_origin[i] = chunk_origin;
+    grid.first_cell[i] = FloorOfRatio(origin - chunk_origin, chunk_size);
+    grid.num_cells[i] =
+        size == 0 ? 0
+                  : FloorOfRatio(origin + size - 1 - chunk_origin, chunk_size) -
+                        grid.first_cell[i] + 1;
+    if (internal::MulOverflow(grid.num_chunks,
+                              static_cast<uint64_t>(grid.num_cells[i]),
+                              &grid.num_chunks)) {
+      return absl::InvalidArgumentError("Too many chunks");
+    }
+  }
+  return grid;
+}
+
+// Returns the first line of a checkpoint file, which identifies the domain
+// and chunk grid that the recorded chunk indices refer to.
+std::string GetCheckpointHeader(const ChunkGrid& grid) {
+  return absl::StrCat(
+      "# domain_origin=", absl::StrJoin(grid.domain.origin(), ","),
+      " domain_shape=", absl::StrJoin(grid.domain.shape(), ","),
+      " chunk_shape=", absl::StrJoin(grid.chunk_shape, ","),
+      " grid_origin=", absl::StrJoin(grid.grid_origin, ","));
+}
+
+struct Checkpoint {
+  // Indicates that the file starts with a complete header line.
+  bool has_header = false;
+  absl::flat_hash_set<uint64_t> completed;
+};
+
+// Reads a checkpoint file, which contains a header line followed by one
+// decimal chunk index per line.  A missing file is treated as empty.
+//
+// Returns an error if the header does not match `header`, since the chunk
+// indices are meaningless for a different domain or chunk grid.
+Result<Checkpoint> ReadCheckpoint(const std::string& path,
+                                  std::string_view header) {
+  Checkpoint checkpoint;
+  std::ifstream file(path);
+  if (!file) return checkpoint;
+  std::string line;
+  while (std::getline(file, line)) {
+    // A final line without a newline may have been partially written, and is
+    // ignored.
+    if (file.eof()) break;
+    if (line.empty()) continue;
+    if (!checkpoint.has_header) {
+      if (line != header) {
+        return absl::FailedPreconditionError(absl::StrCat(
+            "Checkpoint ", QuoteString(path),
+            " was written for a different target domain or chunk grid: "
+            "expected ",
+            QuoteString(header), " but received ", QuoteString(line)));
+      }
+      checkpoint.has_header = true;
+      continue;
+    }
+    uint64_t index;
+    if (!absl::SimpleAtoi(line, &index)) {
+      return absl::DataLossError(absl::StrCat("Invalid checkpoint line in ",
+                                              QuoteString(path), ": ",
+                                              QuoteString(line)));
+    }
+    checkpoint.completed.insert(index);
+  }
+  return checkpoint;
+}
+
+std::string FormatBytesPerSecond(double bytes_per_second) {
+  static const char* const units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+  size_t unit = 0;
+  while (bytes_per_second >= 1024 && unit + 1 < std::size(units)) {
+    bytes_per_second /= 1024;
+    ++unit;
+  }
+  return absl::StrFormat("%.1f %s/s", bytes_per_second, units[unit]);
+}
+
+// Returns an error if chunks that are not stored in `source` cannot be
+// skipped because they would not read as the fill value of `target`.
+//
+// Fill values are compared identically, so that e.g. NaN fill values match
+// each other but `0.0` and `-0.0` do not.
+absl::Status ValidateSkipNotStored(const TensorStore<>& source,
+                                   const TensorStore<>& target) {
+  TENSORSTORE_ASSIGN_OR_RETURN(auto source_fill_value, source.fill_value());
+  TENSORSTORE_ASSIGN_OR_RETURN(auto target_fill_value, target.fill_value());
+  if (source_fill_value.valid() == target_fill_value.valid() &&
+      (!source_fill_value.valid() ||
+       AreArraysIdenticallyEqual(UnbroadcastArray(source_fill_value),
+                                 UnbroadcastArray(target_fill_value)))) {
+    return absl::OkStatus();
+  }
+  return absl::InvalidArgumentError(
+      "Skipping chunks that are not stored requires the source and target to "
+      "have the same fill value");
+}
+
+// Region of grid cells, relative to `ChunkGrid::first_cell`.
+struct CellRegion {
+  Box<> cells;
+  // Indicates that the source may have data stored within the region.  If
+  // `false`, the source has no data stored for any of the cells.
+  bool stored;
+};
+
+// Partitions the grid cells into regions for which the source either has no
+// data stored or must be read.
+//
+// The storage of the whole domain is queried first, which for a source that
+// is empty or fully stored amounts to listing its keys once.  Regions that
+// are only partially stored are split in half along their largest dimension
+// and queried again, down to single chunks, so that the number of queries
+// grows with the number of boundaries between stored and not stored chunks
+// rather than with the number of chunks.  The queries of each round are
+// issued as a single batch.
+Result<std::vector<CellRegion>> PartitionByStorage(const TensorStore<>& source,
+                                                   const ChunkGrid& grid) {
+  std::vector<CellRegion> regions;
+  std::vector<Box<>> pending;
+  pending.emplace_back(grid.num_cells);
+  while (!pending.empty()) {
+    std::vector<Future<ArrayStorageStatistics>> futures;
+    {
+      auto batch = Batch::New();
+      for (const auto& cells : pending) {
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto region,
+            source | tensorstore::AllDims().BoxSlice(
+                         grid.GetRegion(cells.origin(), cells.shape())));
+        futures.push_back(tensorstore::GetStorageStatistics(
+            region,
+            ArrayStorageStatistics::query_not_stored |
+                ArrayStorageStatistics::query_fully_stored,
+            batch));
+      }
+    }
+    std::vector<Box<>> next;
+    for (size_t i = 0; i < pending.size(); ++i) {
+      TENSORSTORE_ASSIGN_OR_RETURN(auto statistics, futures[i].result());
+      auto& cells = pending[i];
+      if (statistics.not_stored || statistics.fully_stored ||
+          cells.num_elements() == 1) {
+        regions.push_back({std::move(cells), !statistics.not_stored});
+        continue;
+      }
+      const auto shape = cells.shape();
+      const DimensionIndex dim =
+          std::max_element(shape.begin(), shape.end()) - shape.begin();
+      const Index half = shape[dim] / 2;
+      Box<> second = cells;
+      second.origin()[dim] += half;
+      second.shape()[dim] -= half;
+      cells.shape()[dim] = half;
+      next.push_back(std::move(cells));
+      next.push_back(std::move(second));
+    }
+    pending = std::move(next);
+  }
+  return regions;
+}
+
+// Shared state of a copy.
+//
+// Chunks are issued by `TsCopy` while fewer than `max_in_flight` chunks are
+// outstanding; each chunk is read from the source (as part of a batch), then
+// written to the target and committed in its own transaction.  Chunks that
+// are found by `PartitionByStorage` to have no data stored in the source are
+// recorded by `ChunkNotStored` without being read.
+class CopyState {
+ public:
+  CopyState(TensorStore<> source, TensorStore<> target,
+            const TsCopyOptions& options, uint64_t remaining_chunks,
+            std::ostream& output)
+      : source_(std::move(source)),
+        target_(std::move(target)),
+        options_(options),
+        max_in_flight_(std::max(size_t(1), options.max_in_flight)),
+        remaining_chunks_(remaining_chunks),
+        output_(output),
+        start_time_(absl::Now()),
+        last_report_time_(start_time_) {}
+
+  // Opens the checkpoint file for appending.  If it does not yet start with a
+  // complete header line, it is replaced by a file containing just `header`.
+  absl::Status OpenCheckpoint(std::string_view header, bool has_header) {
+    if (options_.checkpoint_path.empty()) return absl::OkStatus();
+    absl::MutexLock lock(mutex_);
+    if (has_header) {
+      checkpoint_.emplace(options_.checkpoint_path,
+                          std::ios::out | std::ios::app);
+      // Terminates any partially-written line left by an interrupted copy;
+      // empty lines are ignored by `ReadCheckpoint`.
+      *checkpoint_ << std::endl;
+    } else {
+      checkpoint_.emplace(options_.checkpoint_path,
+                          std::ios::out | std::ios::trunc);
+      *checkpoint_ << header << std::endl;
+    }
+    if (!*checkpoint_) {
+      return absl::UnavailableError(absl::StrCat(
+          "Failed to open checkpoint ", QuoteString(options_.checkpoint_path)));
+    }
+    return absl::OkStatus();
+  }
+
+  // Waits until the number of in-flight chunks drops to the low watermark, and
+  // returns the number of chunks that may be issued, or 0 if an error occurred.
+  //
+  // Waiting for more than a single free slot allows the source reads to be
+  // issued together in a single batch.
+  size_t WaitForCapacity() {
+    absl::MutexLock lock(mutex_);
+    mutex_.Await(absl::Condition(
+        +[](CopyState* self) ABSL_EXCLUSIVE_LOCKS_REQUIRED(self->mutex_) {
+          return self->in_flight_ <= self->max_in_flight_ / 2 ||
+                 !self->status_.ok();
+        },
+        this));
+    if (!status_.ok()) return 0;
+    return max_in_flight_ - in_flight_;
+  }
+
+  // Waits for all in-flight chunks and returns the overall status.
+  absl::Status Finish(TsCopyResult& result) {
+    absl::MutexLock lock(mutex_);
+    mutex_.Await(absl::Condition(
+        +[](CopyState* self) ABSL_EXCLUSIVE_LOCKS_REQUIRED(self->mutex_) {
+          return self->in_flight_ == 0;
+        },
+        this));
+    result.copied_chunks = copied_chunks_;
+    result.not_stored_chunks = not_stored_chunks_;
+    result.copied_bytes = copied_bytes_;
+    ReportProgressLocked();
+    return status_;
+  }
+
+  // Starts copying chunk `index`, reading it from the source as part of
+  // `batch`.
+  void StartChunk(Batch::View batch, uint64_t index, const Box<>& box) {
+    {
+      absl::MutexLock lock(mutex_);
+      ++in_flight_;
+    }
+    Transaction transaction(tensorstore::isolated);
+    auto chunks = [&]() -> Result<std::pair<TensorStore<>, TensorStore<>>> {
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto source_chunk, source_ | tensorstore::AllDims().BoxSlice(box));
+      TENSORSTORE_ASSIGN_OR_RETURN(auto target_chunk, target_ | transaction);
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          target_chunk, target_chunk | tensorstore::AllDims().BoxSlice(box));
+      return std::make_pair(std::move(source_chunk), std::move(target_chunk));
+    }();
+    if (!chunks.ok()) {
+      ChunkDone(index, 0, chunks.status());
+      return;
+    }
+    auto& [source_chunk, target_chunk] = *chunks;
+    tensorstore::Read(source_chunk, batch)
+        .ExecuteWhenReady(
+            [this, index, transaction = std::move(transaction),
+             target_chunk = std::move(target_chunk)](
+                ReadyFuture<SharedOffsetArray<void>> future) {
+              if (!future.status().ok()) {
+                ChunkDone(index, 0, future.status());
+                return;
+              }
+              const auto& array = future.value();
+              const uint64_t num_bytes =
+                  array.num_elements() * array.dtype().size();
+              WriteChunk(index, num_bytes, transaction,
+                         tensorstore::Write(array, target_chunk));
+            });
+  }
+
+  // Records that chunk `index` was skipped because the source has no data
+  // stored for it, and therefore reads as the fill value, which is what the
+  // target already contains.
+  void ChunkNotStored(uint64_t index) {
+    absl::MutexLock lock(mutex_);
+    ++not_stored_chunks_;
+    ChunkCompletedLocked(index);
+  }
+
+ private:
+  void WriteChunk(uint64_t index, uint64_t num_bytes, Transaction transaction,
+                  WriteFutures write) {
+    write.commit_future.ExecuteWhenReady(
+        [this, index, num_bytes,
+         transaction = std::move(transaction)](ReadyFuture<void> future) {
+          if (!future.status().ok()) {
+            transaction.Abort();
+            ChunkDone(index, 0, future.status());
+            return;
+          }
+          transaction.CommitAsync().ExecuteWhenReady(
+              [this, index, num_bytes](ReadyFuture<const void> future) {
+                ChunkDone(index, num_bytes, future.status());
+              });
+        });
+  }
+
+  void ChunkDone(uint64_t index, uint64_t num_bytes, absl::Status status) {
+    absl::MutexLock lock(mutex_);
+    --in_flight_;
+    if (!status.ok()) {
+      output_ << "Error copying chunk " << index << ": " << status
+              << std::endl;
+      status_.Update(std::move(status));
+      return;
+    }
+    ++copied_chunks_;
+    copied_bytes_ += num_bytes;
+    ChunkCompletedLocked(index);
+  }
+
+  void ChunkCompletedLocked(uint64_t index)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    if (checkpoint_) {
+      *checkpoint_ << index << "\n";
+      checkpoint_->flush();
+      if (!*checkpoint_) {
+        status_.Update(absl::UnavailableError(
+            absl::StrCat("Failed to write checkpoint ",
+                         QuoteString(options_.checkpoint_path))));
+      }
+    }
+    if (absl::Now() - last_report_time_ >= options_.progress_interval) {
+      ReportProgressLocked();
+    }
+  }
+
+  void ReportProgressLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    const absl::Time now = absl::Now();
+    last_report_time_ = now;
+    const double elapsed = absl::ToDoubleSeconds(now - start_time_);
+    const uint64_t done_chunks = copied_chunks_ + not_stored_chunks_;
+    output_ << "Copied " << done_chunks << "/" << remaining_chunks_
+            << " chunks";
+    if (not_stored_chunks_ > 0) {
+      output_ << " (" << not_stored_chunks_ << " not stored)";
+    }
+    if (elapsed > 0) {
+      output_ << ", " << FormatBytesPerSecond(copied_bytes_ / elapsed);
+    }
+    if (done_chunks > 0 && done_chunks < remaining_chunks_) {
+      const double eta =
+          elapsed / done_chunks * (remaining_chunks_ - done_chunks);
+      output_ << ", ETA "
+              << absl::FormatDuration(absl::Trunc(absl::Seconds(eta),
+                                                  absl::Seconds(1)));
+    }
+    output_ << std::endl;
+  }
+
+  TensorStore<> source_;
+  TensorStore<> target_;
+  const TsCopyOptions& options_;
+  const size_t max_in_flight_;
+  const uint64_t remaining_chunks_;
+  std::ostream& output_;
+  const absl::Time start_time_;
+
+  absl::Mutex mutex_;
+  size_t in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
+  absl::Status status_ ABSL_GUARDED_BY(mutex_);
+  uint64_t copied_chunks_ ABSL_GUARDED_BY(mutex_) = 0;
+  uint64_t not_stored_chunks_ ABSL_GUARDED_BY(mutex_) = 0;
+  uint64_t copied_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+  absl::Time last_report_time_ ABSL_GUARDED_BY(mutex_);
+  std::optional<std::ofstream> checkpoint_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace
+
+Result<TsCopyResult> TsCopy(Context context, tensorstore::Spec source_spec,
+                            tensorstore::Spec target_spec,
+                            const TsCopyOptions& options,
+                            std::ostream& output) {
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto source,
+      tensorstore::Open(source_spec, context, tensorstore::ReadWriteMode::read,
+                        tensorstore::OpenMode::open)
+          .result());
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto target,
+      tensorstore::Open(target_spec, context, tensorstore::ReadWriteMode::write)
+          .result());
+  if (options.skip_not_stored) {
+    TENSORSTORE_RETURN_IF_ERROR(ValidateSkipNotStored(source, target));
+    output << "Skipping chunks not stored in the source; any data already "
+              "stored in the target for those chunks is left unchanged"
+           << std::endl;
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto grid, GetWriteChunkGrid(target));
+
+  const std::string checkpoint_header = GetCheckpointHeader(grid);
+  Checkpoint checkpoint;
+  if (!options.checkpoint_path.empty()) {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        checkpoint, ReadCheckpoint(options.checkpoint_path, checkpoint_header));
+  }
+  const auto& completed = checkpoint.completed;
+
+  TsCopyResult result;
+  result.total_chunks = grid.num_chunks;
+  for (uint64_t index : completed) {
+    if (index < grid.num_chunks) ++result.skipped_chunks;
+  }
+  if (result.skipped_chunks) {
+    output << "Resuming from checkpoint: " << result.skipped_chunks << "/"
+           << result.total_chunks << " chunks already copied" << std::endl;
+  }
+  if (grid.num_chunks == 0) return result;
+
+  std::vector<CellRegion> regions;
+  if (options.skip_not_stored) {
+    TENSORSTORE_ASSIGN_OR_RETURN(regions, PartitionByStorage(source, grid));
+  } else {
+    regions.push_back({Box<>(grid.num_cells), true});
+  }
+
+  CopyState state(std::move(source), std::move(target), options,
+                  result.total_chunks - result.skipped_chunks, output);
+  TENSORSTORE_RETURN_IF_ERROR(
+      state.OpenCheckpoint(checkpoint_header, checkpoint.has_header));
+
+  // Reads issued together are submitted as a single batch, which allows the
+  // source driver to coalesce them.  The batch is submitted before waiting
+  // for capacity.
+  const DimensionIndex rank = grid.domain.rank();
+  std::vector<Index> offset(rank);
+  std::vector<Index> cell(rank);
+  Batch batch{Batch::no_batch};
+  size_t capacity = 0;
+  bool failed = false;
+  for (const auto& region : regions) {
+    std::fill(offset.begin(), offset.end(), 0);
+    do {
+      for (DimensionIndex i = 0; i < rank; ++i) {
+        cell[i] = region.cells.origin()[i] + offset[i];
+      }
+      const uint64_t index = grid.GetIndex(cell);
+      if (completed.contains(index)) continue;
+      if (!region.stored) {
+        state.ChunkNotStored(index);
+        continue;
+      }
+      if (capacity == 0) {
+        batch = Batch{Batch::no_batch};
+        capacity = state.WaitForCapacity();
+        if (capacity == 0) {
+          failed = true;
+          break;
+        }
+        batch = Batch::New();
+      }
+      state.StartChunk(batch, index, grid.GetChunk(cell));
+      --capacity;
+    } while (internal::AdvanceIndices(rank, offset.data(),
+                                      region.cells.shape().data()));
+    if (failed) break;
+  }
+  batch = Batch{Batch::no_batch};
+  TENSORSTORE_RETURN_IF_ERROR(state.Finish(result));
+  return result;
+}
+
+}  // namespace cli
+}  // namespace tensorstore
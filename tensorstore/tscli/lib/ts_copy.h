@@ -0,0 +1,91 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_TSCLI_LIB_TS_COPY_H_
+#define TENSORSTORE_TSCLI_LIB_TS_COPY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ostream>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/time/time.h"
+#include "tensorstore/context.h"
+#include "tensorstore/spec.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace cli {
+
+inline constexpr size_t kTsCopyDefaultMaxInFlight = 64;
+
+struct TsCopyOptions {
+  /// Maximum number of chunks that are being copied concurrently.
+  ///
+  /// Each in-flight chunk holds one write chunk of the target in memory, so
+  /// this bounds the memory used by the copy.
+  size_t max_in_flight = kTsCopyDefaultMaxInFlight;
+
+  /// Path of a file recording the indices of the chunks that have been
+  /// copied.  If the file already exists, those chunks are skipped, which
+  /// allows an interrupted copy to be resumed.  The first line of the file
+  /// records the target domain and write chunk grid, and resuming fails if
+  /// they do not match the target.
+  std::string checkpoint_path;
+
+  /// Skip chunks for which no data is stored in the source, without reading
+  /// them.  Such chunks are left unmodified in the target: any data already
+  /// stored there is not overwritten with the fill value and remains stale.
+  /// This is only correct if the target does not yet contain data for those
+  /// chunks (e.g. a newly-created target).  Requires the source and target to
+  /// have identical fill values.
+  bool skip_not_stored = false;
+
+  /// Minimum interval between progress reports.
+  absl::Duration progress_interval = absl::Seconds(10);
+};
+
+struct TsCopyResult {
+  /// Total number of chunks in the target domain.
+  uint64_t total_chunks = 0;
+
+  /// Number of chunks skipped because they were recorded in the checkpoint.
+  uint64_t skipped_chunks = 0;
+
+  /// Number of chunks copied by this invocation.
+  uint64_t copied_chunks = 0;
+
+  /// Number of chunks skipped because no data is stored in the source.
+  uint64_t not_stored_chunks = 0;
+
+  /// Number of bytes (of the decoded arrays) copied by this invocation.
+  uint64_t copied_bytes = 0;
+};
+
+/// Copies the contents of the `source_spec` TensorStore to the `target_spec`
+/// TensorStore.
+///
+/// The target domain is partitioned by the target write chunk grid, and each
+/// chunk is read from the source and written to the target using a separate
+/// transaction.  Progress and errors are reported to `output`.
+Result<TsCopyResult> TsCopy(Context context, tensorstore::Spec source_spec,
+                            tensorstore::Spec target_spec,
+                            const TsCopyOptions& options, std::ostream& output);
+
+}  // namespace cli
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_TSCLI_LIB_TS_COPY_H_
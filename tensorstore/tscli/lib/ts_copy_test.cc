@@ -0,0 +1,285 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/lib/ts_copy.h"
+
+#include <stdint.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "absl/status/status.h"
+#include "tensorstore/array.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/internal/testing/scoped_directory.h"
+#include "tensorstore/open.h"
+#include "tensorstore/spec.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Context;
+using ::tensorstore::MakeArray;
+using ::tensorstore::Spec;
+using ::tensorstore::StatusIs;
+using ::tensorstore::cli::TsCopy;
+using ::tensorstore::cli::TsCopyOptions;
+using ::tensorstore::internal_testing::ScopedTemporaryDirectory;
+
+::nlohmann::json ArraySpec(std::string path, bool create) {
+  ::nlohmann::json spec{
+      {"driver", "zarr3"},
+      {"kvstore", {{"driver", "memory"}, {"path", path}}},
+  };
+  if (create) {
+    spec["create"] = true;
+    spec["metadata"] = {
+        {"shape", {5, 4}},
+        {"chunk_grid",
+         {{"name", "regular"}, {"configuration", {{"chunk_shape", {2, 3}}}}}},
+        {"data_type", "int32"},
+    };
+  }
+  return spec;
+}
+
+// Checkpoint header for the 5x4 domain with 2x3 chunks of `ArraySpec`.
+constexpr const char kCheckpointHeader[] =
+    "# domain_origin=0,0 domain_shape=5,4 chunk_shape=2,3 grid_origin=0,0";
+
+class TsCopyTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto source,
+        tensorstore::Open(ArraySpec("source/", true), context_).result());
+    TENSORSTORE_ASSERT_OK(tensorstore::Write(expected_, source).result());
+  }
+
+  Spec GetSpec(std::string path, bool create) {
+    return Spec::FromJson(ArraySpec(path, create)).value();
+  }
+
+  Context context_ = Context::Default();
+  tensorstore::SharedArray<int32_t, 2> expected_ = MakeArray<int32_t>({
+      {1, 2, 3, 4},
+      {5, 6, 7, 8},
+      {9, 10, 11, 12},
+      {13, 14, 15, 16},
+      {17, 18, 19, 20},
+  });
+};
+
+TEST_F(TsCopyTest, Basic) {
+  std::ostringstream output;
+  TsCopyOptions options;
+  options.max_in_flight = 2;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result, TsCopy(context_, GetSpec("source/", false),
+                          GetSpec("target/", true), options, output));
+  // 3 x 2 grid of chunks.
+  EXPECT_EQ(6, result.total_chunks);
+  EXPECT_EQ(0, result.skipped_chunks);
+  EXPECT_EQ(6, result.copied_chunks);
+  EXPECT_EQ(20 * sizeof(int32_t), result.copied_bytes);
+  EXPECT_THAT(output.str(), ::testing::HasSubstr("Copied 6/6 chunks"));
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto target,
+      tensorstore::Open(GetSpec("target/", false), context_).result());
+  EXPECT_THAT(tensorstore::Read(target).result(),
+              ::testing::Optional(expected_));
+}
+
+TEST_F(TsCopyTest, Checkpoint) {
+  ScopedTemporaryDirectory tempdir;
+  TsCopyOptions options;
+  options.checkpoint_path = tempdir.path() + "/checkpoint";
+
+  // Chunks 0 and 5 were already copied; the last line was partially written.
+  {
+    std::ofstream file(options.checkpoint_path);
+    file << kCheckpointHeader << "\n0\n5\n1";
+  }
+
+  std::ostringstream output;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result, TsCopy(context_, GetSpec("source/", false),
+                          GetSpec("target/", true), options, output));
+  EXPECT_EQ(6, result.total_chunks);
+  EXPECT_EQ(2, result.skipped_chunks);
+  EXPECT_EQ(4, result.copied_chunks);
+
+  // Skipped chunks retain the fill value.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto target,
+      tensorstore::Open(GetSpec("target/", false), context_).result());
+  EXPECT_THAT(tensorstore::Read(target).result(),
+              ::testing::Optional(MakeArray<int32_t>({
+                  {0, 0, 0, 4},
+                  {0, 0, 0, 8},
+                  {9, 10, 11, 12},
+                  {13, 14, 15, 16},
+                  {17, 18, 19, 0},
+              })));
+
+  // Resuming with the updated checkpoint copies nothing.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      result, TsCopy(context_, GetSpec("source/", false),
+                     GetSpec("target/", false), options, output));
+  EXPECT_EQ(6, result.skipped_chunks);
+  EXPECT_EQ(0, result.copied_chunks);
+}
+
+TEST_F(TsCopyTest, CheckpointGridMismatch) {
+  ScopedTemporaryDirectory tempdir;
+  TsCopyOptions options;
+  options.checkpoint_path = tempdir.path() + "/checkpoint";
+
+  std::ostringstream output;
+  TENSORSTORE_ASSERT_OK(TsCopy(context_, GetSpec("source/", false),
+                               GetSpec("target/", true), options, output));
+
+  // The same checkpoint cannot be used for a target with a different chunk
+  // grid.
+  auto target_spec = ArraySpec("other_target/", true);
+  auto& chunk_grid = target_spec["metadata"]["chunk_grid"];
+  chunk_grid["configuration"]["chunk_shape"] = {3, 2};
+  EXPECT_THAT(TsCopy(context_, GetSpec("source/", false),
+                     Spec::FromJson(target_spec).value(), options, output),
+              StatusIs(absl::StatusCode::kFailedPrecondition,
+                       ::testing::HasSubstr("different target domain")));
+}
+
+TEST_F(TsCopyTest, CheckpointWithoutHeader) {
+  ScopedTemporaryDirectory tempdir;
+  TsCopyOptions options;
+  options.checkpoint_path = tempdir.path() + "/checkpoint";
+  {
+    std::ofstream file(options.checkpoint_path);
+    file << "0\n5\n";
+  }
+
+  std::ostringstream output;
+  EXPECT_THAT(TsCopy(context_, GetSpec("source/", false),
+                     GetSpec("target/", true), options, output),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+}
+
+TEST_F(TsCopyTest, SkipNotStored) {
+  // Only chunk 4, at grid cell {2, 0}, is stored.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto sparse,
+      tensorstore::Open(ArraySpec("sparse/", true), context_).result());
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(MakeArray<int32_t>({{1, 2, 3}}),
+                         sparse | tensorstore::Dims(0, 1).SizedInterval(
+                                      {4, 0}, {1, 3}))
+          .result());
+
+  std::ostringstream output;
+  TsCopyOptions options;
+  options.skip_not_stored = true;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result, TsCopy(context_, GetSpec("sparse/", false),
+                          GetSpec("target/", true), options, output));
+  EXPECT_EQ(6, result.total_chunks);
+  EXPECT_EQ(5, result.not_stored_chunks);
+  EXPECT_EQ(1, result.copied_chunks);
+  EXPECT_EQ(3 * sizeof(int32_t), result.copied_bytes);
+  EXPECT_THAT(output.str(),
+              ::testing::HasSubstr("Copied 6/6 chunks (5 not stored)"));
+  EXPECT_THAT(output.str(), ::testing::HasSubstr("left unchanged"));
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto target,
+      tensorstore::Open(GetSpec("target/", false), context_).result());
+  EXPECT_THAT(tensorstore::Read(target).result(),
+              ::testing::Optional(MakeArray<int32_t>({
+                  {0, 0, 0, 0},
+                  {0, 0, 0, 0},
+                  {0, 0, 0, 0},
+                  {0, 0, 0, 0},
+                  {1, 2, 3, 0},
+              })));
+}
+
+TEST_F(TsCopyTest, SkipNotStoredFullyStored) {
+  std::ostringstream output;
+  TsCopyOptions options;
+  options.skip_not_stored = true;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result, TsCopy(context_, GetSpec("source/", false),
+                          GetSpec("target/", true), options, output));
+  EXPECT_EQ(0, result.not_stored_chunks);
+  EXPECT_EQ(6, result.copied_chunks);
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto target,
+      tensorstore::Open(GetSpec("target/", false), context_).result());
+  EXPECT_THAT(tensorstore::Read(target).result(),
+              ::testing::Optional(expected_));
+}
+
+TEST_F(TsCopyTest, SkipNotStoredFillValueMismatch) {
+  std::ostringstream output;
+  TsCopyOptions options;
+  options.skip_not_stored = true;
+  auto target_spec = ArraySpec("target/", true);
+  target_spec["metadata"]["fill_value"] = 1;
+  EXPECT_THAT(TsCopy(context_, GetSpec("source/", false),
+                     Spec::FromJson(target_spec).value(), options, output),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST_F(TsCopyTest, SkipNotStoredNanFillValue) {
+  // NaN fill values match each other, even though NaN != NaN.
+  auto nan_spec = [](std::string path) {
+    auto spec = ArraySpec(path, true);
+    spec["metadata"]["data_type"] = "float32";
+    spec["metadata"]["fill_value"] = "NaN";
+    return Spec::FromJson(spec).value();
+  };
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Open(nan_spec("nan_source/"), context_).result());
+
+  std::ostringstream output;
+  TsCopyOptions options;
+  options.skip_not_stored = true;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result, TsCopy(context_, GetSpec("nan_source/", false),
+                          nan_spec("nan_target/"), options, output));
+  EXPECT_EQ(6, result.not_stored_chunks);
+  EXPECT_EQ(0, result.copied_chunks);
+}
+
+TEST_F(TsCopyTest, Error) {
+  std::ostringstream output;
+  TsCopyOptions options;
+  // The target domain is larger than the source domain.
+  auto target_spec = ArraySpec("target/", true);
+  target_spec["metadata"]["shape"] = {6, 4};
+  EXPECT_FALSE(TsCopy(context_, GetSpec("source/", false),
+                      Spec::FromJson(target_spec).value(), options, output)
+                   .ok());
+  EXPECT_THAT(output.str(), ::testing::HasSubstr("Error copying chunk"));
+}
+
+}  // namespace
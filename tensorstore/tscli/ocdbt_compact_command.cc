@@ -0,0 +1,185 @@
+// Copyright 2026 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/ocdbt_compact_command.h"
+
+#include <stdint.h>
+
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/tscli/command.h"
+#include "tensorstore/tscli/lib/ocdbt_compact.h"
+#include "tensorstore/util/json_absl_flag.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace cli {
+namespace {
+
+static constexpr const char kCommand[] =
+    R"(Compact an OCDBT database
+
+Prunes old versions from the version tree and rewrites data files in which
+most of the bytes are no longer referenced by the retained versions.  The
+compacted manifest adds a new version with the same content as the latest
+version, and is only committed if the database was not modified concurrently.
+
+Data files that are no longer referenced are only deleted if
+--delete-obsolete is specified, once --grace-period (10 minutes by default) has
+elapsed after the commit.  Readers that opened the database before compaction
+may still reference them.
+)";
+
+static constexpr const char kSource[] = R"(Source kvstore spec. Required.
+
+kvstore spec must refer to a prefix/directory containing an OCDBT database.
+)";
+
+static constexpr const char kRetainVersions[] =
+    R"(Number of most recent versions to retain.
+
+If neither --retain-versions nor --retain-since is specified, all versions
+are retained.
+)";
+
+static constexpr const char kRetainSince[] =
+    R"(Retain all versions committed at or after this time (e.g., `2023-01-01T00:00:00Z`).
+)";
+
+}  // namespace
+
+OcdbtCompactCommand::OcdbtCompactCommand()
+    : Command("ocdbt_compact", kCommand) {
+  parser().AddLongOption("--source", kSource, [this](std::string_view value) {
+    tensorstore::JsonAbslFlag<tensorstore::kvstore::Spec> spec;
+    std::string error;
+    if (!AbslParseFlag(value, &spec, &error)) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Invalid spec: ", value, " ", error));
+    }
+    specs_.push_back(spec.value);
+    return absl::OkStatus();
+  });
+
+  parser().AddLongOption(
+      "--retain-versions", kRetainVersions, [this](std::string_view value) {
+        uint64_t retain_versions;
+        if (!absl::SimpleAtoi(value, &retain_versions) ||
+            retain_versions == 0) {
+          return absl::InvalidArgumentError("Invalid retain-versions value");
+        }
+        options_.retain_versions = retain_versions;
+        return absl::OkStatus();
+      });
+
+  parser().AddLongOption(
+      "--retain-since", kRetainSince, [this](std::string_view value) {
+        absl::Time time;
+        std::string error;
+        if (!absl::ParseTime(absl::RFC3339_full, value, &time, &error)) {
+          return absl::InvalidArgumentError(
+              absl::StrCat("Invalid retain-since value: ", error));
+        }
+        options_.retain_since = time;
+        return absl::OkStatus();
+      });
+
+  parser().AddLongOption(
+      "--min-live-fraction",
+      "Rewrite data files in which less than this fraction of the bytes is "
+      "referenced by the retained versions. Defaults to 0.5.",
+      [this](std::string_view value) {
+        if (!absl::SimpleAtod(value, &options_.min_live_fraction) ||
+            !(options_.min_live_fraction >= 0 &&
+              options_.min_live_fraction <= 1)) {
+          return absl::InvalidArgumentError("Invalid min-live-fraction value");
+        }
+        return absl::OkStatus();
+      });
+
+  parser().AddLongOption(
+      "--target-data-file-size",
+      "Target size in bytes of the newly written data files.",
+      [this](std::string_view value) {
+        if (!absl::SimpleAtoi(value, &options_.target_data_file_size)) {
+          return absl::InvalidArgumentError(
+              "Invalid target-data-file-size value");
+        }
+        return absl::OkStatus();
+      });
+
+  parser().AddLongOption(
+      "--data-file-prefix",
+      "Prefix of the newly written data files. Defaults to `d/`.",
+      [this](std::string_view value) {
+        options_.data_file_prefix = std::string(value);
+        return absl::OkStatus();
+      });
+
+  parser().AddBoolOption("--dry-run",
+                         "Only report what would be rewritten and reclaimed.",
+                         [this]() { options_.dry_run = true; });
+
+  parser().AddBoolOption(
+      "--delete-obsolete",
+      "Delete data files that are no longer referenced after compaction.",
+      [this]() { options_.delete_obsolete_files = true; });
+
+  parser().AddLongOption(
+      "--grace-period",
+      "Time to wait before deleting obsolete files (e.g., `1h`). Defaults "
+      "to `10m`.",
+      [this](std::string_view value) {
+        if (!absl::ParseDuration(value, &options_.grace_period) ||
+            options_.grace_period < absl::ZeroDuration()) {
+          return absl::InvalidArgumentError("Invalid grace-period value");
+        }
+        return absl::OkStatus();
+      });
+
+  parser().AddLongOption(
+      "--read-concurrency", "Limit on concurrent node reads.",
+      [this](std::string_view value) {
+        if (!absl::SimpleAtoi(value, &options_.concurrency) ||
+            options_.concurrency == 0) {
+          return absl::InvalidArgumentError("Invalid concurrency value");
+        }
+        return absl::OkStatus();
+      });
+}
+
+absl::Status OcdbtCompactCommand::Run(Context::Spec context_spec) {
+  tensorstore::Context context(context_spec);
+
+  if (specs_.empty()) {
+    return absl::InvalidArgumentError("Must specify --source");
+  }
+
+  absl::Status status;
+  for (const auto& spec : specs_) {
+    status.Update(OcdbtCompact(context, spec, std::cout, options_).status());
+  }
+  return status;
+}
+
+}  // namespace cli
+}  // namespace tensorstore
@@ -104,7 +104,8 @@ class ExecutorBoundFunction {
   ABSL_ATTRIBUTE_NO_UNIQUE_ADDRESS Function function;
 
   // Trace context.
-  ABSL_ATTRIBUTE_NO_UNIQUE_ADDRESS mutable internal_tracing::TraceContext tc_;
+  ABSL_ATTRIBUTE_NO_UNIQUE_ADDRESS mutable internal_tracing::TaskTraceContext
+      tc_;
 };
 
 /// Returns an instance of `ExecutorBoundFunction` that invokes the given
@@ -121,7 +122,8 @@ std::enable_if_t<
 WithExecutor(Executor&& executor, Function&& function) {
   return {
       std::forward<Executor>(executor), std::forward<Function>(function),
-      internal_tracing::TraceContext(internal_tracing::TraceContext::kThread)};
+      internal_tracing::TaskTraceContext(
+          internal_tracing::TraceContext::kThread)};
 }
 template <typename Executor, typename Function>
 std::enable_if_t<std::is_same_v<absl::remove_cvref_t<Executor>, InlineExecutor>,
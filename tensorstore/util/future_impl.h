@@ -538,14 +538,14 @@ class CallbackBase : public CallbackListNode {
       kLinkCallback = 3;
 
   CallbackBase(SharedStatePointer shared_state,
-               internal_tracing::TraceContext trace_context)
+               internal_tracing::TaskTraceContext trace_context)
       : shared_state_(shared_state),
         reference_count_(2),
         trace_context_(std::move(trace_context)) {}
 
   explicit CallbackBase(SharedStatePointer shared_state)
       : CallbackBase(std::move(shared_state),
-                     internal_tracing::TraceContext(
+                     internal_tracing::TaskTraceContext(
                          internal_tracing::TraceContext::kThread)) {}
 
   virtual ~CallbackBase();
@@ -596,8 +596,8 @@ class CallbackBase : public CallbackListNode {
   std::atomic<size_t> reference_count_;
 
   /// Tracing context for the callback, initialized when the callback is
-  /// created.
-  ABSL_ATTRIBUTE_NO_UNIQUE_ADDRESS internal_tracing::TraceContext
+  /// created.  Empty when tracing is compiled out.
+  ABSL_ATTRIBUTE_NO_UNIQUE_ADDRESS internal_tracing::TaskTraceContext
       trace_context_;
 };
 